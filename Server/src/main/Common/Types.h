@@ -31,6 +31,7 @@ namespace Common_Types
     typedef boost::shared_ptr<ByteVector> ByteVectorPtr;
     
     typedef std::string ByteData;
+    typedef boost::shared_ptr<const ByteData> ByteDataPtr;
     const ByteData EMPTY_BYTE_DATA;
     
     typedef unsigned long TransferredDataAmount;
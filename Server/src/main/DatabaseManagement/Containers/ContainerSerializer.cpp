@@ -0,0 +1,627 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ContainerSerializer.h"
+
+#include <deque>
+#include <cstring>
+#include <boost/any.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "DeviceDataContainer.h"
+#include "LogDataContainer.h"
+#include "ScheduleDataContainer.h"
+#include "SessionDataContainer.h"
+#include "StatisticDataContainer.h"
+#include "SyncDataContainer.h"
+#include "SystemDataContainer.h"
+#include "UserDataContainer.h"
+#include "VectorDataContainer.h"
+
+using DatabaseManagement_Containers::DataContainerPtr;
+using DatabaseManagement_Types::DatabaseManagerOperationMode;
+
+namespace
+{
+    /** Timestamp markers. */
+    enum class TimestampMarker : std::uint8_t { NORMAL, NOT_A_DATE_TIME, NEG_INFINITY, POS_INFINITY };
+    
+    /** Types of values stored in statistic and system containers. */
+    enum class ValueType : std::uint8_t { NONE, BOOL, UNSIGNED_INT, UNSIGNED_LONG, STRING, TIMESTAMP, DB_OPERATION_MODE };
+    
+    const boost::posix_time::ptime EPOCH(boost::gregorian::date(1970, 1, 1));
+    const std::size_t HEADER_SIZE = 2 + 16;
+    
+    /** Class for appending encoded fields to a string. */
+    class ByteWriter
+    {
+        public:
+            explicit ByteWriter(std::string & outputData) : output(outputData) {}
+            
+            void writeByte(std::uint8_t value) { output.push_back(static_cast<char>(value)); }
+            
+            void writeUnsigned(std::uint64_t value)
+            {
+                while(value >= 0x80)
+                {
+                    output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                    value >>= 7;
+                }
+                
+                output.push_back(static_cast<char>(value));
+            }
+            
+            void writeSigned(std::int64_t value)
+            {
+                writeUnsigned((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+            }
+            
+            void writeBool(bool value) { writeByte(value ? 1 : 0); }
+            
+            template <typename TEnum>
+            void writeEnum(TEnum value) { writeUnsigned(static_cast<std::uint64_t>(static_cast<int>(value))); }
+            
+            void writeBytes(const void * data, std::size_t size)
+            {
+                writeUnsigned(size);
+                output.append(static_cast<const char*>(data), size);
+            }
+            
+            void writeString(const std::string & value) { writeBytes(value.data(), value.size()); }
+            
+            void writeID(const DBObjectID & value) { output.append(reinterpret_cast<const char*>(value.data), sizeof(value.data)); }
+            
+            void writeTimestamp(const boost::posix_time::ptime & value)
+            {
+                if(value.is_not_a_date_time())
+                    writeByte(static_cast<std::uint8_t>(TimestampMarker::NOT_A_DATE_TIME));
+                else if(value.is_neg_infinity())
+                    writeByte(static_cast<std::uint8_t>(TimestampMarker::NEG_INFINITY));
+                else if(value.is_pos_infinity())
+                    writeByte(static_cast<std::uint8_t>(TimestampMarker::POS_INFINITY));
+                else
+                {
+                    writeByte(static_cast<std::uint8_t>(TimestampMarker::NORMAL));
+                    writeSigned((value - EPOCH).total_microseconds());
+                }
+            }
+            
+            void writeValue(const boost::any & value)
+            {
+                if(value.empty())
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::NONE));
+                }
+                else if(value.type() == typeid(bool))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::BOOL));
+                    writeBool(boost::any_cast<bool>(value));
+                }
+                else if(value.type() == typeid(unsigned int))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::UNSIGNED_INT));
+                    writeUnsigned(boost::any_cast<unsigned int>(value));
+                }
+                else if(value.type() == typeid(unsigned long))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::UNSIGNED_LONG));
+                    writeUnsigned(boost::any_cast<unsigned long>(value));
+                }
+                else if(value.type() == typeid(std::string))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::STRING));
+                    writeString(boost::any_cast<std::string>(value));
+                }
+                else if(value.type() == typeid(const char *))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::STRING));
+                    writeString(boost::any_cast<const char *>(value));
+                }
+                else if(value.type() == typeid(boost::posix_time::ptime))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::TIMESTAMP));
+                    writeTimestamp(boost::any_cast<boost::posix_time::ptime>(value));
+                }
+                else if(value.type() == typeid(DatabaseManagerOperationMode))
+                {
+                    writeByte(static_cast<std::uint8_t>(ValueType::DB_OPERATION_MODE));
+                    writeEnum(boost::any_cast<DatabaseManagerOperationMode>(value));
+                }
+                else
+                {
+                    throw std::invalid_argument("ContainerSerializer::serialize() > Unsupported value type encountered <"
+                                                + std::string(value.type().name()) + ">.");
+                }
+            }
+        
+        private:
+            std::string & output;
+    };
+    
+    /** Class for reading encoded fields from a buffer. */
+    class ByteReader
+    {
+        public:
+            ByteReader(const char * inputData, std::size_t inputSize) : current(inputData), end(inputData + inputSize) {}
+            
+            std::uint8_t readByte()
+            {
+                require(1);
+                return static_cast<std::uint8_t>(*current++);
+            }
+            
+            std::uint64_t readUnsigned()
+            {
+                std::uint64_t result = 0;
+                for(unsigned int shift = 0; shift < 64; shift += 7)
+                {
+                    std::uint8_t currentByte = readByte();
+                    result |= static_cast<std::uint64_t>(currentByte & 0x7F) << shift;
+                    
+                    if((currentByte & 0x80) == 0)
+                        return result;
+                }
+                
+                throw std::runtime_error("ContainerSerializer::deserialize() > Malformed integer encountered.");
+            }
+            
+            std::int64_t readSigned()
+            {
+                std::uint64_t value = readUnsigned();
+                return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+            }
+            
+            bool readBool() { return (readByte() != 0); }
+            
+            template <typename TEnum>
+            TEnum readEnum() { return static_cast<TEnum>(static_cast<int>(readUnsigned())); }
+            
+            std::pair<const char *, std::size_t> readBytes()
+            {
+                std::uint64_t size = readUnsigned();
+                require(size);
+                std::pair<const char *, std::size_t> result(current, static_cast<std::size_t>(size));
+                current += size;
+                return result;
+            }
+            
+            std::string readString()
+            {
+                auto bytes = readBytes();
+                return std::string(bytes.first, bytes.second);
+            }
+            
+            PasswordData readPassword()
+            {
+                auto bytes = readBytes();
+                return PasswordData(reinterpret_cast<const unsigned char *>(bytes.first), bytes.second);
+            }
+            
+            DBObjectID readID()
+            {
+                DBObjectID result;
+                require(sizeof(result.data));
+                std::memcpy(result.data, current, sizeof(result.data));
+                current += sizeof(result.data);
+                return result;
+            }
+            
+            boost::posix_time::ptime readTimestamp()
+            {
+                switch(static_cast<TimestampMarker>(readByte()))
+                {
+                    case TimestampMarker::NORMAL: return EPOCH + boost::posix_time::microseconds(readSigned());
+                    case TimestampMarker::NOT_A_DATE_TIME: return boost::posix_time::ptime(boost::posix_time::not_a_date_time);
+                    case TimestampMarker::NEG_INFINITY: return boost::posix_time::ptime(boost::posix_time::neg_infin);
+                    case TimestampMarker::POS_INFINITY: return boost::posix_time::ptime(boost::posix_time::pos_infin);
+                    default: throw std::runtime_error("ContainerSerializer::deserialize() > Malformed timestamp encountered.");
+                }
+            }
+            
+            boost::any readValue()
+            {
+                switch(static_cast<ValueType>(readByte()))
+                {
+                    case ValueType::NONE: return boost::any();
+                    case ValueType::BOOL: return readBool();
+                    case ValueType::UNSIGNED_INT: return static_cast<unsigned int>(readUnsigned());
+                    case ValueType::UNSIGNED_LONG: return static_cast<unsigned long>(readUnsigned());
+                    case ValueType::STRING: return readString();
+                    case ValueType::TIMESTAMP: return readTimestamp();
+                    case ValueType::DB_OPERATION_MODE: return readEnum<DatabaseManagerOperationMode>();
+                    default: throw std::runtime_error("ContainerSerializer::deserialize() > Unexpected value type encountered.");
+                }
+            }
+            
+            bool isAtEnd() const { return (current == end); }
+        
+        private:
+            const char * current;
+            const char * end;
+            
+            void require(std::uint64_t size) const
+            {
+                if(size > static_cast<std::uint64_t>(end - current))
+                    throw std::runtime_error("ContainerSerializer::deserialize() > Unexpected end of data encountered.");
+            }
+    };
+    
+    void writeContainer(ByteWriter & writer, const DataContainerPtr container);
+    DataContainerPtr readContainer(ByteReader & reader);
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::DeviceDataContainer & container)
+    {
+        writer.writeString(container.getDeviceProvidedID());
+        writer.writeString(container.getDeviceName());
+        writer.writeBytes(container.getPasswordData().BytePtr(), container.getPasswordData().SizeInBytes());
+        writer.writeID(container.getDeviceOwner());
+        writer.writeString(container.getDeviceCommandAddress());
+        writer.writeUnsigned(container.getDeviceCommandPort());
+        writer.writeString(container.getDeviceDataAddress());
+        writer.writeUnsigned(container.getDeviceDataPort());
+        writer.writeString(container.getDeviceInitAddress());
+        writer.writeUnsigned(container.getDeviceInitPort());
+        writer.writeEnum(container.getTransferType());
+        writer.writeString(container.getDeviceInfo());
+        writer.writeBool(container.isDeviceLocked());
+        writer.writeTimestamp(container.getLastSuccessfulAuthenticationTimestamp());
+        writer.writeTimestamp(container.getLastFailedAuthenticationTimestamp());
+        writer.writeUnsigned(container.getFailedAuthenticationAttempts());
+        writer.writeString(container.getRawPublicKey());
+        writer.writeEnum(container.getExpectedKeyExhange());
+        writer.writeEnum(container.getDeviceType());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::LogDataContainer & container)
+    {
+        writer.writeEnum(container.getLogSeverity());
+        writer.writeString(container.getLogSourceName());
+        writer.writeTimestamp(container.getLogTimestamp());
+        writer.writeString(container.getLogMessage());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::ScheduleDataContainer & container)
+    {
+        writer.writeBool(container.isScheduleActive());
+        writer.writeTimestamp(container.getNextRun());
+        writer.writeSigned(container.getNumberOfRepetitions());
+        writer.writeEnum(container.getIntervalType());
+        writer.writeUnsigned(container.getIntervalLength());
+        writer.writeBool(container.runScheduleIfMissed());
+        writer.writeBool(container.deleteScheduleAfterCompletion());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::SessionDataContainer & container)
+    {
+        writer.writeTimestamp(container.getOpenTimestamp());
+        writer.writeTimestamp(container.getCloseTimestamp());
+        writer.writeTimestamp(container.getLastActivityTimestamp());
+        writer.writeEnum(container.getSessionType());
+        writer.writeID(container.getDevice());
+        writer.writeID(container.getUser());
+        writer.writeBool(container.isSessionPersistent());
+        writer.writeBool(container.isSessionActive());
+        writer.writeUnsigned(container.getDataSent());
+        writer.writeUnsigned(container.getDataReceived());
+        writer.writeUnsigned(container.getCommandsSent());
+        writer.writeUnsigned(container.getCommandsReceived());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::StatisticDataContainer & container)
+    {
+        writer.writeEnum(container.getStatisticType());
+        writer.writeValue(container.getStatisticValue());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::SyncDataContainer & container)
+    {
+        writer.writeString(container.getSyncName());
+        writer.writeString(container.getSyncDescription());
+        writer.writeString(container.getSourcePath());
+        writer.writeString(container.getDestinationPath());
+        writer.writeID(container.getSourceDevice());
+        writer.writeID(container.getDestinationDevice());
+        writer.writeBool(container.isSyncOneWay());
+        writer.writeBool(container.isSyncOneTime());
+        writer.writeEnum(container.getDirectoryConflictResolutionRule());
+        writer.writeEnum(container.getFileConflictResolutionRule());
+        writer.writeBool(container.isEncryptionEnabled());
+        writer.writeBool(container.isCompressionEnabled());
+        writer.writeID(container.getOwnerID());
+        writer.writeString(container.getDestinationPermissions());
+        writer.writeBool(container.isOfflineSyncEnabled());
+        writer.writeBool(container.isDifferentialSyncEnabled());
+        writer.writeUnsigned(container.getNumberOfSyncRetries());
+        writer.writeEnum(container.getFailureAction());
+        writer.writeTimestamp(container.getLastAttemptTimestamp());
+        writer.writeEnum(container.getLastResult());
+        writer.writeID(container.getLastSessionID());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::SystemDataContainer & container)
+    {
+        writer.writeEnum(container.getSystemParameterType());
+        writer.writeValue(container.getSystemParameterValue());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::UserDataContainer & container)
+    {
+        writer.writeString(container.getUsername());
+        writer.writeBytes(container.getPasswordData().BytePtr(), container.getPasswordData().SizeInBytes());
+        writer.writeEnum(container.getUserAccessLevel());
+        writer.writeBool(container.getForcePasswordReset());
+        writer.writeBool(container.isUserLocked());
+        writer.writeTimestamp(container.getCreationTimestamp());
+        writer.writeTimestamp(container.getLastSuccessfulAuthenticationTimestamp());
+        writer.writeTimestamp(container.getLastFailedAuthenticationTimestamp());
+        writer.writeUnsigned(container.getFailedAuthenticationAttempts());
+        
+        writer.writeUnsigned(container.getAccessRules().size());
+        for(const UserAuthorizationRule & currentRule : container.getAccessRules())
+            writer.writeEnum(currentRule.getSetType());
+    }
+    
+    void writeFields(ByteWriter & writer, const DatabaseManagement_Containers::VectorDataContainer & container)
+    {
+        std::vector<DataContainerPtr> children = container.getContainers();
+        writer.writeUnsigned(children.size());
+        
+        std::string childData;
+        for(const DataContainerPtr & currentChild : children)
+        {
+            childData.clear();
+            ByteWriter childWriter(childData);
+            writeContainer(childWriter, currentChild);
+            writer.writeString(childData);
+        }
+    }
+    
+    void writeContainer(ByteWriter & writer, const DataContainerPtr container)
+    {
+        if(!container)
+            throw std::invalid_argument("ContainerSerializer::serialize() > No container supplied.");
+        
+        writer.writeByte(DatabaseManagement_Containers::ContainerSerializer::FORMAT_VERSION);
+        writer.writeEnum(container->getDataType());
+        writer.writeID(container->getContainerID());
+        
+        switch(container->getDataType())
+        {
+            case DatabaseObjectType::DEVICE: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::DeviceDataContainer &>(*container)); break;
+            case DatabaseObjectType::LOG: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::LogDataContainer &>(*container)); break;
+            case DatabaseObjectType::SCHEDULE: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::ScheduleDataContainer &>(*container)); break;
+            case DatabaseObjectType::SESSION: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::SessionDataContainer &>(*container)); break;
+            case DatabaseObjectType::STATISTICS: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::StatisticDataContainer &>(*container)); break;
+            case DatabaseObjectType::SYNC_FILE: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::SyncDataContainer &>(*container)); break;
+            case DatabaseObjectType::SYSTEM_SETTINGS: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::SystemDataContainer &>(*container)); break;
+            case DatabaseObjectType::USER: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::UserDataContainer &>(*container)); break;
+            case DatabaseObjectType::VECTOR: writeFields(writer, dynamic_cast<const DatabaseManagement_Containers::VectorDataContainer &>(*container)); break;
+            default: throw std::invalid_argument("ContainerSerializer::serialize() > Unsupported container type encountered <"
+                                                 + Utilities::Strings::toString(container->getDataType()) + ">.");
+        }
+    }
+    
+    DataContainerPtr readDevice(ByteReader & reader, DBObjectID id)
+    {
+        std::string providedID = reader.readString();
+        std::string name = reader.readString();
+        PasswordData password = reader.readPassword();
+        UserID owner = reader.readID();
+        IPAddress commandAddress = reader.readString();
+        IPPort commandPort = static_cast<IPPort>(reader.readUnsigned());
+        IPAddress dataAddress = reader.readString();
+        IPPort dataPort = static_cast<IPPort>(reader.readUnsigned());
+        IPAddress initAddress = reader.readString();
+        IPPort initPort = static_cast<IPPort>(reader.readUnsigned());
+        DataTransferType transferType = reader.readEnum<DataTransferType>();
+        std::string info = reader.readString();
+        bool locked = reader.readBool();
+        Timestamp lastSuccessfulAuth = reader.readTimestamp();
+        Timestamp lastFailedAuth = reader.readTimestamp();
+        unsigned int failedAttempts = static_cast<unsigned int>(reader.readUnsigned());
+        std::string publicKey = reader.readString();
+        KeyExchangeType exchangeType = reader.readEnum<KeyExchangeType>();
+        PeerType deviceType = reader.readEnum<PeerType>();
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::DeviceDataContainer(id, providedID, name, password, owner,
+                                                                                       commandAddress, commandPort, dataAddress, dataPort, initAddress, initPort,
+                                                                                       transferType, info, locked, lastSuccessfulAuth, lastFailedAuth,
+                                                                                       failedAttempts, publicKey, exchangeType, deviceType));
+    }
+    
+    DataContainerPtr readLog(ByteReader & reader, DBObjectID id)
+    {
+        LogSeverity severity = reader.readEnum<LogSeverity>();
+        std::string source = reader.readString();
+        Timestamp timestamp = reader.readTimestamp();
+        std::string message = reader.readString();
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::LogDataContainer(id, severity, source, timestamp, message));
+    }
+    
+    DataContainerPtr readSchedule(ByteReader & reader, DBObjectID id)
+    {
+        bool isActive = reader.readBool();
+        boost::posix_time::ptime nextRun = reader.readTimestamp();
+        int repetitions = static_cast<int>(reader.readSigned());
+        ScheduleIntervalType intervalType = reader.readEnum<ScheduleIntervalType>();
+        unsigned long intervalLength = static_cast<unsigned long>(reader.readUnsigned());
+        bool runIfMissed = reader.readBool();
+        bool deleteAfterCompletion = reader.readBool();
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::ScheduleDataContainer(isActive, nextRun, repetitions, intervalType, intervalLength,
+                                                                                         runIfMissed, deleteAfterCompletion, id));
+    }
+    
+    DataContainerPtr readSession(ByteReader & reader, DBObjectID id)
+    {
+        Timestamp openTime = reader.readTimestamp();
+        Timestamp closeTime = reader.readTimestamp();
+        Timestamp lastActivityTime = reader.readTimestamp();
+        SessionType type = reader.readEnum<SessionType>();
+        DeviceID device = reader.readID();
+        UserID user = reader.readID();
+        bool isPersistent = reader.readBool();
+        bool isActive = reader.readBool();
+        TransferredDataAmount dataSent = static_cast<TransferredDataAmount>(reader.readUnsigned());
+        TransferredDataAmount dataReceived = static_cast<TransferredDataAmount>(reader.readUnsigned());
+        unsigned long commandsSent = static_cast<unsigned long>(reader.readUnsigned());
+        unsigned long commandsReceived = static_cast<unsigned long>(reader.readUnsigned());
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::SessionDataContainer(id, openTime, closeTime, lastActivityTime, type, device, user,
+                                                                                        isPersistent, isActive, dataSent, dataReceived, commandsSent, commandsReceived));
+    }
+    
+    DataContainerPtr readStatistic(ByteReader & reader, DBObjectID id)
+    {
+        StatisticType type = reader.readEnum<StatisticType>();
+        boost::any value = reader.readValue();
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::StatisticDataContainer(id, type, value));
+    }
+    
+    DataContainerPtr readSync(ByteReader & reader, DBObjectID id)
+    {
+        std::string name = reader.readString();
+        std::string description = reader.readString();
+        std::string sourcePath = reader.readString();
+        std::string destinationPath = reader.readString();
+        DeviceID sourceDevice = reader.readID();
+        DeviceID destinationDevice = reader.readID();
+        bool oneWay = reader.readBool();
+        bool oneTime = reader.readBool();
+        ConflictResolutionRule_Directory directoryRule = reader.readEnum<ConflictResolutionRule_Directory>();
+        ConflictResolutionRule_File fileRule = reader.readEnum<ConflictResolutionRule_File>();
+        bool encrypt = reader.readBool();
+        bool compress = reader.readBool();
+        UserID owner = reader.readID();
+        std::string permissions = reader.readString();
+        bool offline = reader.readBool();
+        bool differential = reader.readBool();
+        unsigned int retries = static_cast<unsigned int>(reader.readUnsigned());
+        SyncFailureAction failureAction = reader.readEnum<SyncFailureAction>();
+        Timestamp lastAttempt = reader.readTimestamp();
+        SyncResult lastResult = reader.readEnum<SyncResult>();
+        SessionID lastSession = reader.readID();
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::SyncDataContainer(name, description, sourcePath, destinationPath, sourceDevice,
+                                                                                     destinationDevice, oneWay, oneTime, directoryRule, fileRule, encrypt,
+                                                                                     compress, owner, permissions, offline, differential, retries, failureAction,
+                                                                                     lastAttempt, lastResult, lastSession, id));
+    }
+    
+    DataContainerPtr readSystem(ByteReader & reader, DBObjectID id)
+    {
+        SystemParameterType type = reader.readEnum<SystemParameterType>();
+        boost::any value = reader.readValue();
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::SystemDataContainer(id, type, value));
+    }
+    
+    DataContainerPtr readUser(ByteReader & reader, DBObjectID id)
+    {
+        std::string username = reader.readString();
+        PasswordData password = reader.readPassword();
+        UserAccessLevel accessLevel = reader.readEnum<UserAccessLevel>();
+        bool forcePasswordReset = reader.readBool();
+        bool locked = reader.readBool();
+        Timestamp creationTime = reader.readTimestamp();
+        Timestamp lastSuccessfulAuth = reader.readTimestamp();
+        Timestamp lastFailedAuth = reader.readTimestamp();
+        unsigned int failedAttempts = static_cast<unsigned int>(reader.readUnsigned());
+        
+        std::deque<UserAuthorizationRule> rules;
+        std::uint64_t rulesNumber = reader.readUnsigned();
+        for(std::uint64_t i = 0; i < rulesNumber; i++)
+            rules.push_back(UserAuthorizationRule(reader.readEnum<InstructionManagement_Types::InstructionSetType>()));
+        
+        return DataContainerPtr(new DatabaseManagement_Containers::UserDataContainer(id, username, password, accessLevel, forcePasswordReset, locked,
+                                                                                     creationTime, lastSuccessfulAuth, lastFailedAuth, failedAttempts, rules));
+    }
+    
+    DataContainerPtr readVector(ByteReader & reader)
+    {
+        DatabaseManagement_Containers::VectorDataContainerPtr result(new DatabaseManagement_Containers::VectorDataContainer());
+        
+        std::uint64_t childrenNumber = reader.readUnsigned();
+        for(std::uint64_t i = 0; i < childrenNumber; i++)
+        {
+            auto childData = reader.readBytes();
+            ByteReader childReader(childData.first, childData.second);
+            result->addDataContainer(readContainer(childReader));
+        }
+        
+        return result;
+    }
+    
+    DataContainerPtr readContainer(ByteReader & reader)
+    {
+        std::uint8_t version = reader.readByte();
+        if(version != DatabaseManagement_Containers::ContainerSerializer::FORMAT_VERSION)
+        {
+            throw std::runtime_error("ContainerSerializer::deserialize() > Unsupported format version encountered <"
+                                     + Utilities::Strings::toString(static_cast<unsigned int>(version)) + ">.");
+        }
+        
+        DatabaseObjectType type = reader.readEnum<DatabaseObjectType>();
+        DBObjectID id = reader.readID();
+        DataContainerPtr result;
+        
+        switch(type)
+        {
+            case DatabaseObjectType::DEVICE: result = readDevice(reader, id); break;
+            case DatabaseObjectType::LOG: result = readLog(reader, id); break;
+            case DatabaseObjectType::SCHEDULE: result = readSchedule(reader, id); break;
+            case DatabaseObjectType::SESSION: result = readSession(reader, id); break;
+            case DatabaseObjectType::STATISTICS: result = readStatistic(reader, id); break;
+            case DatabaseObjectType::SYNC_FILE: result = readSync(reader, id); break;
+            case DatabaseObjectType::SYSTEM_SETTINGS: result = readSystem(reader, id); break;
+            case DatabaseObjectType::USER: result = readUser(reader, id); break;
+            case DatabaseObjectType::VECTOR: result = readVector(reader); break;
+            default: throw std::runtime_error("ContainerSerializer::deserialize() > Unexpected container type encountered.");
+        }
+        
+        if(!reader.isAtEnd())
+            throw std::runtime_error("ContainerSerializer::deserialize() > Unexpected data found after container.");
+        
+        return result;
+    }
+}
+
+std::string DatabaseManagement_Containers::ContainerSerializer::serialize(const DataContainerPtr container)
+{
+    std::string result;
+    result.reserve(HEADER_SIZE + 64);
+    serialize(container, result);
+    return result;
+}
+
+void DatabaseManagement_Containers::ContainerSerializer::serialize(const DataContainerPtr container, std::string & output)
+{
+    ByteWriter writer(output);
+    writeContainer(writer, container);
+}
+
+DataContainerPtr DatabaseManagement_Containers::ContainerSerializer::deserialize(const std::string & data)
+{
+    return deserialize(data.data(), data.size());
+}
+
+DataContainerPtr DatabaseManagement_Containers::ContainerSerializer::deserialize(const char * data, std::size_t size)
+{
+    ByteReader reader(data, size);
+    return readContainer(reader);
+}
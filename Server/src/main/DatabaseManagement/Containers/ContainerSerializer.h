@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONTAINERSERIALIZER_H
+#define	CONTAINERSERIALIZER_H
+
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include "DataContainer.h"
+
+namespace DatabaseManagement_Containers
+{
+    /**
+     * Class for converting data containers to and from a compact binary representation.
+     *
+     * Format (version 1):
+     * - header -> format version (1 byte), container type (1 byte), container ID (16 bytes);
+     * - fields -> in the order of the full constructor of the container:
+     *   - unsigned integers and enumerations are stored as variable length integers (7 bits per byte);
+     *   - signed integers are zigzag encoded before being stored;
+     *   - strings and byte blocks are stored as a length followed by the raw data;
+     *   - timestamps are stored as a marker byte (normal/special value), followed by the
+     *     number of microseconds since the UNIX epoch (normal values only);
+     *   - statistic and system parameter values are stored as a value type byte, followed by the value;
+     *   - vector containers store the number of children, followed by each child (with its own header),
+     *     prefixed with its length.
+     *
+     * Note: Decoding fails for data written with a different format version.
+     */
+    class ContainerSerializer
+    {
+        public:
+            /** Current format version. */
+            static const std::uint8_t FORMAT_VERSION = 1;
+
+            /**
+             * Converts the specified container to its binary representation.
+             *
+             * @param container the container to be converted
+             * @throw invalid_argument if the container type is not supported
+             * @return the binary data
+             */
+            static std::string serialize(const DataContainerPtr container);
+
+            /**
+             * Appends the binary representation of the specified container to the supplied string.
+             *
+             * @param container the container to be converted
+             * @param output the string to append the data to
+             * @throw invalid_argument if the container type is not supported
+             */
+            static void serialize(const DataContainerPtr container, std::string & output);
+
+            /**
+             * Creates a new container from the specified binary data.
+             *
+             * @param data the binary data
+             * @throw runtime_error if the data is malformed or was written with a different format version
+             * @return the new container
+             */
+            static DataContainerPtr deserialize(const std::string & data);
+
+            /**
+             * Creates a new container from the specified binary data.
+             *
+             * @param data pointer to the binary data
+             * @param size the size of the data (in bytes)
+             * @throw runtime_error if the data is malformed or was written with a different format version
+             * @return the new container
+             */
+            static DataContainerPtr deserialize(const char * data, std::size_t size);
+
+        private:
+            ContainerSerializer();
+    };
+}
+
+#endif	/* CONTAINERSERIALIZER_H */
+
@@ -35,6 +35,9 @@ namespace DatabaseManagement_Containers
             StatisticDataContainer(StatisticType statType, boost::any statValue)
                 : DataContainer(boost::uuids::random_generator()(), DatabaseObjectType::STATISTICS), type(statType), value(statValue) {}
             
+            StatisticDataContainer(DBObjectID id, StatisticType statType, boost::any statValue)
+                : DataContainer(id, DatabaseObjectType::STATISTICS), type(statType), value(statValue) {}
+            
             StatisticDataContainer() = delete;                                          //No default constructor
             StatisticDataContainer(const StatisticDataContainer&) = default;            //Default copy constructor
             ~StatisticDataContainer() = default;                                        //Default destructor
@@ -34,6 +34,9 @@ namespace DatabaseManagement_Containers
             SystemDataContainer(SystemParameterType type, boost::any value)
                 : DataContainer(boost::uuids::random_generator()(), DatabaseObjectType::SYSTEM_SETTINGS), paramType(type), paramValue(value) {}
             
+            SystemDataContainer(DBObjectID id, SystemParameterType type, boost::any value)
+                : DataContainer(id, DatabaseObjectType::SYSTEM_SETTINGS), paramType(type), paramValue(value) {}
+            
             SystemDataContainer() = delete;                                         //No default constructor
             SystemDataContainer(const SystemDataContainer&) = default;              //Default copy constructor
             ~SystemDataContainer() = default;                                       //Default destructor
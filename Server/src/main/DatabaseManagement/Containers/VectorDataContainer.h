@@ -87,8 +87,32 @@ namespace DatabaseManagement_Containers
                 containers.push_back(container);
             }
             
+            /**
+             * Retrieves the position of the first stored container in the full list of matching objects.
+             * 
+             * Note: DALs that return a single page of a larger result set it to the offset they applied;
+             * it is 0 for results that start from the first matching object.
+             * 
+             * @return the offset of the stored containers
+             */
+            unsigned long getOffset() const
+            {
+                return offset;
+            }
+            
+            /**
+             * Sets the position of the first stored container in the full list of matching objects.
+             * 
+             * @param newOffset the offset of the stored containers
+             */
+            void setOffset(unsigned long newOffset)
+            {
+                offset = newOffset;
+            }
+            
         private:
             std::vector<DataContainerPtr> containers;
+            unsigned long offset = 0;
     };
     
     typedef boost::shared_ptr<DatabaseManagement_Containers::VectorDataContainer> VectorDataContainerPtr;
@@ -24,7 +24,7 @@ SyncServer_Core::DatabaseManagement::DALCache::DALCache(DALPtr childDAL, Utiliti
   minCommitUpdates(parameters.minimumCommitUpdates), debugLogger(parentLogger)
 {
     onSuccessConnection = dal->onSuccessEventAttach(boost::bind(&DatabaseManagement::DALCache::onSuccessHandler, this, _1, _2, _3));
-    onFailureConnection = dal->onFailureEventAttach(boost::bind(&DatabaseManagement::DALCache::onFailureHandler, this, _1, _2, _3));
+    onFailureConnection = dal->onFailureEventAttach(boost::bind(&DatabaseManagement::DALCache::onFailureHandler, this, _1, _2, _3, _4));
     
     requestsThreadObject = new boost::thread(&DatabaseManagement::DALCache::requestsThread, this);
     cacheThreadObject = new boost::thread(&DatabaseManagement::DALCache::cacheThread, this);
@@ -60,12 +60,8 @@ SyncServer_Core::DatabaseManagement::DALCache::~DALCache()
     {
         boost::lock_guard<boost::mutex> requestsLock(requestsThreadMutex);
         
-        for(std::pair<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*> currentRequestData : requestsData)
-            delete currentRequestData.second;
-        
-        requestsData.clear();
         pendingDALRequests.clear();
-        std::queue<DatabaseRequestID>().swap(pendingCacheRequests);
+        std::queue<std::pair<RequestType, DatabaseRequest>>().swap(pendingCacheRequests);
     }
     
     dal->disconnect();
@@ -77,7 +73,7 @@ bool SyncServer_Core::DatabaseManagement::DALCache::getObject(DatabaseRequestID
     if(stopCache)
         return false;
     
-    addRequest(requestID, RequestType::SELECT, constraintType, constraintValue);
+    addRequest(RequestType::SELECT, DatabaseRequest(requestID, constraintType, constraintValue));
     
     logMessage(LogSeverity::Debug, "(Get Object) Sending notification to main thread.");
     requestsThreadLockCondition.notify_all();
@@ -86,6 +82,21 @@ bool SyncServer_Core::DatabaseManagement::DALCache::getObject(DatabaseRequestID
     return true;
 }
 
+bool SyncServer_Core::DatabaseManagement::DALCache::getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                                                   unsigned long offset, unsigned long limit)
+{
+    if(stopCache)
+        return false;
+    
+    addRequest(RequestType::SELECT, DatabaseRequest(requestID, constraintType, constraintValue, offset, limit));
+    
+    logMessage(LogSeverity::Debug, "(Get Objects Page) Sending notification to main thread.");
+    requestsThreadLockCondition.notify_all();
+    logMessage(LogSeverity::Debug, "(Get Objects Page) Notification to main thread sent.");
+
+    return true;
+}
+
 bool SyncServer_Core::DatabaseManagement::DALCache::putObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
 {
     if(stopCache)
@@ -95,11 +106,11 @@ bool SyncServer_Core::DatabaseManagement::DALCache::putObject(DatabaseRequestID
     if(isObjectInCache(inputData->getContainerID()))
     {
         logMessage(LogSeverity::Error, "(putObject) [" + Convert::toString(requestID) + "]: Object with ID <" + Convert::toString(inputData->getContainerID()) + "already exists.");
-        addRequest(requestID, RequestType::SEND_FAILURE_EVENT, inputData, 0);
+        addRequest(RequestType::SEND_FAILURE_EVENT, DatabaseRequest(requestID, inputData->getContainerID()));
     }
     else
     {
-        addRequest(requestID, RequestType::INSERT, inputData, 0);
+        addRequest(RequestType::INSERT, DatabaseRequest(DatabaseRequestType::INSERT, requestID, inputData));
         result = true;
     }
     
@@ -117,13 +128,13 @@ bool SyncServer_Core::DatabaseManagement::DALCache::updateObject(DatabaseRequest
     bool result = false;
     if(isObjectInCache(inputData->getContainerID()))
     {
-        addRequest(requestID, RequestType::UPDATE, inputData, 0);
+        addRequest(RequestType::UPDATE, DatabaseRequest(DatabaseRequestType::UPDATE, requestID, inputData));
         result = true;
     }
     else
     {
         logMessage(LogSeverity::Error, "(updateObject) [" + Convert::toString(requestID) + "]: Object with ID <" + Convert::toString(inputData->getContainerID()) + "not found in cache.");
-        addRequest(requestID, RequestType::SEND_FAILURE_EVENT, inputData, 0);
+        addRequest(RequestType::SEND_FAILURE_EVENT, DatabaseRequest(requestID, inputData->getContainerID()));
     }
     
     logMessage(LogSeverity::Debug, "(updateObject) Sending notification to main thread.");
@@ -140,13 +151,13 @@ bool SyncServer_Core::DatabaseManagement::DALCache::removeObject(DatabaseRequest
     bool result = false;
     if(isObjectInCache(id))
     {
-        addRequest(requestID, RequestType::REMOVE, id, cacheType);
+        addRequest(RequestType::REMOVE, DatabaseRequest(requestID, id));
         result = true;
     }
     else
     {
         logMessage(LogSeverity::Error, "(removeObject) [" + Convert::toString(requestID) + "]: Object with ID <" + Convert::toString(id) + "not found in cache.");
-        addRequest(requestID, RequestType::SEND_FAILURE_EVENT, id, cacheType);
+        addRequest(RequestType::SEND_FAILURE_EVENT, DatabaseRequest(requestID, id));
     }
     
     logMessage(LogSeverity::Debug, "(removeObject) Sending notification to requests thread.");
@@ -155,6 +166,41 @@ bool SyncServer_Core::DatabaseManagement::DALCache::removeObject(DatabaseRequest
     return result;
 }
 
+unsigned long SyncServer_Core::DatabaseManagement::DALCache::dropLogsBefore(Timestamp time)
+{
+    if(stopCache)
+        return 0;
+    
+    if(cacheType == DatabaseObjectType::LOG)
+    {
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Entering cache critical section.");
+        boost::lock_guard<boost::mutex> cacheLock(cacheThreadMutex);
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Cache critical section entered.");
+        
+        unsigned long evictedObjectsNum = 0;
+        for(auto currentObject = cache.begin(); currentObject != cache.end();)
+        {
+            //uncommitted logs are kept; they will be dropped by the next retention run after they are committed
+            LogDataContainerPtr currentLog = boost::dynamic_pointer_cast<DatabaseManagement_Containers::LogDataContainer>(currentObject->second);
+            if(currentLog && currentLog->getLogTimestamp() < time && uncommittedObjects.find(currentObject->first) == uncommittedObjects.end())
+            {
+                if(clearObjectAge)
+                    objectAgeTable.erase(currentObject->first);
+                
+                currentObject = cache.erase(currentObject);
+                ++evictedObjectsNum;
+            }
+            else
+                ++currentObject;
+        }
+        
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Evicted <" + Convert::toString(evictedObjectsNum) + "> log(s).");
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Exiting cache critical section.");
+    }
+    
+    return dal->dropLogsBefore(time);
+}
+
 bool SyncServer_Core::DatabaseManagement::DALCache::commitCache()
 {
     if(stopCache)
@@ -358,47 +404,72 @@ void SyncServer_Core::DatabaseManagement::DALCache::cacheThread()
             {
                 logMessage(LogSeverity::Debug, "(cacheThread) Working on <"+Convert::toString(uncommittedObjects.size())+"uncommitted objects.");
                 unordered_map<DBObjectID, RequestType> failedCommits;
+                std::vector<DatabaseRequest> commitRequests;
+                commitRequests.reserve(uncommittedObjects.size());
                 
-                for(std::pair<DBObjectID, RequestType> currentObject : uncommittedObjects)
                 {
-                    bool commitSuccessful = false;
-                    currentCommitRequest++;
+                    boost::lock_guard<boost::mutex> pendingCommitRequestsLock(pendingCommitRequestsMutex);
                     
+                    for(std::pair<DBObjectID, RequestType> currentObject : uncommittedObjects)
                     {
-                        boost::lock_guard<boost::mutex> pendingCommitRequestsLock(pendingCommitRequestsMutex);
-                        pendingCommitRequests.insert(std::pair<DatabaseRequestID, DBObjectID>(currentCommitRequest, currentObject.first));
-                    }
-                    
-                    switch(currentObject.second)
-                    {
-                        case RequestType::INSERT: commitSuccessful = dal->putObject(currentCommitRequest, cache[currentObject.first]); break;
-                        case RequestType::UPDATE: commitSuccessful = dal->updateObject(currentCommitRequest, cache[currentObject.first]);  break;
-                        case RequestType::REMOVE:
+                        currentCommitRequest++;
+                        
+                        switch(currentObject.second)
                         {
-                            commitSuccessful = dal->removeObject(currentCommitRequest, currentObject.first);
-                            
-                            if(commitSuccessful)
+                            case RequestType::INSERT: commitRequests.push_back(DatabaseRequest(DatabaseRequestType::INSERT, currentCommitRequest, cache[currentObject.first])); break;
+                            case RequestType::UPDATE: commitRequests.push_back(DatabaseRequest(DatabaseRequestType::UPDATE, currentCommitRequest, cache[currentObject.first])); break;
+                            case RequestType::REMOVE: commitRequests.push_back(DatabaseRequest(currentCommitRequest, currentObject.first)); break;
+                            default:
                             {
-                                cache.erase(currentObject.first);
-                                
-                                if(clearObjectAge)
-                                    objectAgeTable.erase(currentObject.first);
+                                logMessage(LogSeverity::Debug, "(cacheThread) Invalid request type found during cache commit.");
+                                failedCommits.insert(currentObject);
+                                continue;
                             }
-                        } break;
+                        }
                         
-                        default: logMessage(LogSeverity::Debug, "(cacheThread) Invalid request type found during cache commit."); break;
+                        pendingCommitRequests.insert(std::pair<DatabaseRequestID, DBObjectID>(currentCommitRequest, currentObject.first));
                     }
+                }
+                
+                std::vector<const DatabaseRequest *> commitBatch;
+                commitBatch.reserve(commitRequests.size());
+                for(const DatabaseRequest & currentRequest : commitRequests)
+                    commitBatch.push_back(&currentRequest);
+                
+                //all objects are sent to the DAL as a single batch
+                std::vector<const DatabaseRequest *> rejectedBatch;
+                if(!commitBatch.empty() && !dal->processBatch(commitBatch, rejectedBatch))
+                {
+                    logMessage(LogSeverity::Debug, "(cacheThread) <" + Convert::toString(rejectedBatch.size()) + "> commit request(s) were not accepted by the DAL.");
                     
-                    if(!commitSuccessful)
+                    //only the rejected requests are retried; the accepted ones remain pending until their responses arrive
+                    boost::lock_guard<boost::mutex> pendingCommitRequestsLock(pendingCommitRequestsMutex);
+                    for(const DatabaseRequest * currentRequest : rejectedBatch)
                     {
-                        failedCommits.insert(currentObject);
+                        DBObjectID rejectedObject = (currentRequest->getType() == DatabaseRequestType::REMOVE)
+                                                    ? currentRequest->getObjectID()
+                                                    : currentRequest->getContainer()->getContainerID();
                         
-                        boost::lock_guard<boost::mutex> pendingCommitRequestsLock(pendingCommitRequestsMutex);
-                        pendingCommitRequests.erase(currentCommitRequest);
-                        logMessage(LogSeverity::Debug, "(cacheThread) Failed to commit object <" + Convert::toString(currentObject.first) + ">.");
+                        failedCommits.insert(std::pair<DBObjectID, RequestType>(rejectedObject, uncommittedObjects[rejectedObject]));
+                        pendingCommitRequests.erase(currentRequest->getID());
+                        logMessage(LogSeverity::Debug, "(cacheThread) Failed to commit object <" + Convert::toString(rejectedObject) + ">.");
                     }
                 }
+                
+                for(std::pair<DBObjectID, RequestType> currentObject : uncommittedObjects)
+                {
+                    if(failedCommits.find(currentObject.first) != failedCommits.end())
+                        continue;
+                    
+                    if(currentObject.second == RequestType::REMOVE)
+                    {
+                        cache.erase(currentObject.first);
 
+                        if(clearObjectAge)
+                            objectAgeTable.erase(currentObject.first);
+                    }
+                }
+                
                 uncommittedObjects.clear();
                 if(failedCommits.size() > 0)
                     uncommittedObjects.swap(failedCommits);
@@ -451,14 +522,16 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
         }
         else
         {
-            DatabaseRequestID currentRequest = pendingCacheRequests.front();
-            tuple<RequestType, boost::any, boost::any> * currentRequestData = requestsData[currentRequest];
+            RequestType currentRequestType = pendingCacheRequests.front().first;
+            DatabaseRequest currentRequestData = std::move(pendingCacheRequests.front().second);
+            DatabaseRequestID currentRequest = currentRequestData.getID();
+            pendingCacheRequests.pop();
             
-            switch(currentRequestData->get<0>())
+            switch(currentRequestType)
             {
                 case RequestType::SELECT:
                 {
-                    DBObjectID objectID = Tools::getIDFromConstraint(cacheType, currentRequestData->get<1>(), currentRequestData->get<2>());
+                    DBObjectID objectID = Tools::getIDFromConstraint(cacheType, currentRequestData.getConstraint().type, currentRequestData.getConstraint().value);
                     
                     if(objectID != Common_Types::INVALID_OBJECT_ID)
                     {
@@ -491,27 +564,33 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
                         {
                             cacheMisses++;
                             pendingDALRequests.insert(std::pair<DatabaseRequestID, bool>(currentRequest, true));
-                            dal->getObject(currentRequest, currentRequestData->get<1>(), currentRequestData->get<2>());
+                            dal->getObject(currentRequest, currentRequestData.getConstraint().type, currentRequestData.getConstraint().value);
                         }
                         else
                         {
                             cacheHits++;
                             logMessage(LogSeverity::Debug, "(requestsThread / SELECT) Requested object found in cache but is pending removal.");
-                            onFailure(dalID, currentRequest, objectID);
+                            onFailure(dalID, currentRequest, objectID, true);
                         }
                     }
                     else
                     {
+                        const DatabaseManagement_Types::SelectConstraint & constraint = currentRequestData.getConstraint();
+                        
                         cacheMisses++;
                         pendingDALRequests.insert(std::pair<DatabaseRequestID, bool>(currentRequest, true));
-                        dal->getObject(currentRequest, currentRequestData->get<1>(), currentRequestData->get<2>());
+                        
+                        if(constraint.limit > 0)
+                            dal->getObjectsPage(currentRequest, constraint.type, constraint.value, constraint.offset, constraint.limit);
+                        else
+                            dal->getObject(currentRequest, constraint.type, constraint.value);
                     }
                 } break;
                 
                 case RequestType::INSERT:
                 case RequestType::UPDATE:
                 {
-                    DataContainerPtr containerData = boost::any_cast<DataContainerPtr>(currentRequestData->get<1>());
+                    DataContainerPtr containerData = currentRequestData.getContainer();
                     bool successful = false;
                     
                     {
@@ -528,7 +607,7 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
                         }
                         else
                         {
-                            if(currentRequestData->get<0>() == RequestType::INSERT)
+                            if(currentRequestType == RequestType::INSERT)
                             {
                                 cache.insert(std::pair<DBObjectID, DataContainerPtr>(containerData->getContainerID(), containerData));
                                 if(objectAgeTable.find(containerData->getContainerID()) == objectAgeTable.end())
@@ -539,7 +618,7 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
                             else //UPDATE
                                 objectAgeTable[containerData->getContainerID()]++;
                             
-                            uncommittedObjects.insert(std::pair<DBObjectID, RequestType>(containerData->getContainerID(), currentRequestData->get<0>()));
+                            uncommittedObjects.insert(std::pair<DBObjectID, RequestType>(containerData->getContainerID(), currentRequestType));
                             if(uncommittedObjects.size() >= maxCommitUpdates)
                                 cacheThreadLockCondition.notify_all();
                             
@@ -552,12 +631,12 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
                     if(successful)
                         onSuccess(dalID, currentRequest, containerData);
                     else
-                        onFailure(dalID, currentRequest, containerData->getContainerID());
+                        onFailure(dalID, currentRequest, containerData->getContainerID(), false);
                 } break;
                 
                 case RequestType::REMOVE:
                 {
-                    DBObjectID objectID = boost::any_cast<DBObjectID>(currentRequestData->get<1>());
+                    DBObjectID objectID = currentRequestData.getObjectID();
                     bool successful = false;
                     DataContainerPtr container;
                     
@@ -604,12 +683,12 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
                     if(successful)
                         onSuccess(dalID, currentRequest, container);
                     else
-                        onFailure(dalID, currentRequest, objectID);
+                        onFailure(dalID, currentRequest, objectID, false);
                 } break;
                 
                 case RequestType::CACHE_OBJECT:
                 {
-                    DataContainerPtr containerData = boost::any_cast<DataContainerPtr>(currentRequestData->get<1>());
+                    DataContainerPtr containerData = currentRequestData.getContainer();
                     
                     logMessage(LogSeverity::Debug, "(requestsThread / CACHE_OBJECT) Acquiring cache lock.");
                     boost::lock_guard<boost::mutex> cacheLock(cacheThreadMutex);
@@ -639,24 +718,21 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
                 
                 case RequestType::SEND_FAILURE_EVENT:
                 {
-                    onFailure(dalID, currentRequest, boost::any_cast<DBObjectID>(currentRequestData->get<1>()));
+                    onFailure(dalID, currentRequest, currentRequestData.getObjectID(), false);
                 } break;
                 
                 case RequestType::SEND_SUCCESS_EVENT:
                 {
-                    onSuccess(dalID, currentRequest, boost::any_cast<DataContainerPtr>(currentRequestData->get<1>()));
+                    onSuccess(dalID, currentRequest, currentRequestData.getContainer());
                 } break;
                 
                 default:
                 {
                     logMessage(LogSeverity::Error, "(requestsThread) Unexpected request type encountered.");
-                    onFailure(dalID, currentRequest, DBObjectID());
+                    onFailure(dalID, currentRequest, DBObjectID(), false);
                 } break;
             }
             
-            pendingCacheRequests.pop();
-            requestsData.erase(currentRequest);
-            delete currentRequestData;
         }
         
         logMessage(LogSeverity::Debug, "(requestsThread) Data lock released.");
@@ -667,7 +743,7 @@ void SyncServer_Core::DatabaseManagement::DALCache::requestsThread()
     return;
 }
 
-void SyncServer_Core::DatabaseManagement::DALCache::onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id)
+void SyncServer_Core::DatabaseManagement::DALCache::onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id, bool notFound)
 {
     if(stopCache)
         return;
@@ -705,7 +781,7 @@ void SyncServer_Core::DatabaseManagement::DALCache::onFailureHandler(DatabaseAbs
     }
     
     logMessage(LogSeverity::Debug, "(onFailureHandler) Sending signal for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
-    onFailure(dalID, requestID, id);
+    onFailure(dalID, requestID, id, notFound);
     logMessage(LogSeverity::Debug, "(onFailureHandler) Signal sent for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
 }
 
@@ -742,7 +818,7 @@ void SyncServer_Core::DatabaseManagement::DALCache::onSuccessHandler(DatabaseAbs
             {
                 //TODO - this is expensive
                 requestsLock.unlock();
-                addRequest(requestID, RequestType::CACHE_OBJECT, data, 0);
+                addRequest(RequestType::CACHE_OBJECT, DatabaseRequest(DatabaseRequestType::INSERT, requestID, data));
                 requestsLock.lock();
             }
             else
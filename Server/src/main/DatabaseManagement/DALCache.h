@@ -30,6 +30,7 @@
 #include "../Utilities/Strings/Database.h"
 #include "../Utilities/FileLogger.h"
 #include "Containers/DataContainer.h"
+#include "Containers/LogDataContainer.h"
 #include "Containers/VectorDataContainer.h"
 #include "Interfaces/DatabaseAbstractionLayer.h"
 
@@ -47,11 +48,14 @@ using DatabaseManagement_Interfaces::DatabaseSettingsContainer;
 using DatabaseManagement_Interfaces::DatabaseInformationContainer;
 
 using DatabaseManagement_Types::DatabaseRequestID;
+using DatabaseManagement_Types::DatabaseRequestType;
+using DatabaseManagement_Types::DatabaseRequest;
 using DatabaseManagement_Types::DatabaseAbstractionLayerID;
 using DatabaseManagement_Types::ObjectCacheAge;
 
 using DatabaseManagement_Containers::DataContainerPtr;
 using DatabaseManagement_Containers::VectorDataContainerPtr;
+using DatabaseManagement_Containers::LogDataContainerPtr;
 
 namespace SyncServer_Core
 {
@@ -166,9 +170,20 @@ namespace SyncServer_Core
                 DALCache& operator=(const DALCache&) = delete;  //Copying not allowed (pass/access only by reference/pointer)
 
                 bool getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue) override;
+                bool getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                    unsigned long offset, unsigned long limit) override;
                 bool putObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
                 bool updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
                 bool removeObject(DatabaseRequestID requestID, DBObjectID id) override;
+                
+                /**
+                 * Drops the old logs from the child DAL and evicts the cached copies
+                 * of the committed logs that are older than the specified time.
+                 * 
+                 * @param time the retention limit
+                 * @return the number of logs dropped by the child DAL
+                 */
+                unsigned long dropLogsBefore(Timestamp time) override;
 
                 bool changeDatabaseSettings(const DatabaseSettingsContainer settings) override  { return dal->changeDatabaseSettings(settings); }
                 bool buildDatabase() override                                                   { return dal->buildDatabase(); }
@@ -249,8 +264,7 @@ namespace SyncServer_Core
                 DatabaseRequestID currentCommitRequest = DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
 
                 //Requests management
-                queue<DatabaseRequestID> pendingCacheRequests;              //pending SELECT/INSERT/REMOVE/UPDATE requests
-                unordered_map<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*> requestsData; //data associated with requests
+                queue<std::pair<RequestType, DatabaseRequest>> pendingCacheRequests; //pending SELECT/INSERT/REMOVE/UPDATE requests
                 unordered_map<DatabaseRequestID, bool> pendingDALRequests;  //pending requests sent to child DAL
 
                 //Configuration
@@ -312,8 +326,9 @@ namespace SyncServer_Core
                  * @param dalID the ID of the caller DAL
                  * @param requestID the associated request ID
                  * @param id the associated object ID (if any)
+                 * @param notFound denotes whether a SELECT request completed without finding any objects
                  */
-                void onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id);
+                void onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id, bool notFound);
 
                 /**
                  * Event handler for "onSuccess" signals coming from the child DAL.
@@ -329,20 +344,16 @@ namespace SyncServer_Core
                  * 
                  * Note: Thread-safe.
                  * 
-                 * @param requestID the ID of the request
                  * @param type the type of the request
-                 * @param requestParameter primary request parameter
-                 * @param additionalParameter secondary request parameter (optional)
+                 * @param request the request data
                  */
-                void addRequest(DatabaseRequestID requestID, RequestType type, boost::any requestParameter, boost::any additionalParameter = 0)
+                void addRequest(RequestType type, const DatabaseRequest & request)
                 {
-                    tuple<RequestType, boost::any, boost::any> * data = new tuple<RequestType, boost::any, boost::any>(type, requestParameter, additionalParameter);
                     logMessage(LogSeverity::Debug, "(addRequest) Entering critical section.");
                     boost::lock_guard<boost::mutex> requestsLock(requestsThreadMutex);
                     logMessage(LogSeverity::Debug, "(addRequest) Critical section entered.");
 
-                    pendingCacheRequests.push(requestID);
-                    requestsData.insert(std::pair<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*>(requestID, data));
+                    pendingCacheRequests.push(std::pair<RequestType, DatabaseRequest>(type, request));
 
                     logMessage(LogSeverity::Debug, "(addRequest) Sending notification to requests thread.");
                     requestsThreadLockCondition.notify_all();
@@ -16,3 +16,486 @@
  */
 
 #include "DALDistributedCache.h"
+
+#include <cstring>
+#include <boost/functional/hash.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include "../Utilities/Tools.h"
+
+SyncServer_Core::DatabaseManagement::DALDistributedCache::DALDistributedCache
+(DALPtr childDAL, Utilities::FileLoggerPtr parentLogger, DALDistributedCacheParameters parameters)
+: dal(childDAL), cacheType(childDAL->getType()), cacheParams(parameters),
+  fullSegmentName(parameters.segmentName + "_" + Convert::toString(cacheType)), debugLogger(parentLogger)
+{
+    if(cacheParams.maximumProbes == 0 || cacheParams.maximumProbes > cacheParams.slotsNumber)
+        cacheParams.maximumProbes = cacheParams.slotsNumber;
+    
+    cacheEnabled = attachSegment();
+    
+    onSuccessConnection = dal->onSuccessEventAttach(boost::bind(&DatabaseManagement::DALDistributedCache::onSuccessHandler, this, _1, _2, _3));
+    onFailureConnection = dal->onFailureEventAttach(boost::bind(&DatabaseManagement::DALDistributedCache::onFailureHandler, this, _1, _2, _3, _4));
+    
+    requestsThreadObject = new boost::thread(&DatabaseManagement::DALDistributedCache::requestsThread, this);
+}
+
+SyncServer_Core::DatabaseManagement::DALDistributedCache::~DALDistributedCache()
+{
+    logMessage(LogSeverity::Debug, "(~) Destruction initiated.");
+    
+    {
+        boost::lock_guard<boost::mutex> requestsLock(requestsThreadMutex);
+        stopCache = true;
+        requestsThreadLockCondition.notify_all();
+    }
+    
+    requestsThreadObject->join();
+    delete requestsThreadObject;
+    
+    onSuccessConnection.disconnect();
+    onFailureConnection.disconnect();
+    
+    {
+        boost::lock_guard<boost::mutex> pendingLock(pendingRequestsMutex);
+        pendingRequests.clear();
+    }
+    
+    dal->disconnect();
+    dal = nullptr;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue)
+{
+    return addRequest(DatabaseRequest(requestID, constraintType, constraintValue));
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                                                              unsigned long offset, unsigned long limit)
+{
+    return addRequest(DatabaseRequest(requestID, constraintType, constraintValue, offset, limit));
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::putObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
+{
+    return addRequest(DatabaseRequest(DatabaseRequestType::INSERT, requestID, inputData));
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
+{
+    return addRequest(DatabaseRequest(DatabaseRequestType::UPDATE, requestID, inputData));
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::removeObject(DatabaseRequestID requestID, DBObjectID id)
+{
+    return addRequest(DatabaseRequest(requestID, id));
+}
+
+void SyncServer_Core::DatabaseManagement::DALDistributedCache::invalidateObject(const DBObjectID id)
+{
+    if(!cacheEnabled)
+        return;
+    
+    getSlot(getHomeSlot(id))->bucketVersion.fetch_add(1, std::memory_order_acq_rel);
+    ++invalidations;
+}
+
+SyncServer_Core::DatabaseManagement::DALDistributedCache::DALDistributedCacheInformation
+SyncServer_Core::DatabaseManagement::DALDistributedCache::getCacheInformation() const
+{
+    return DALDistributedCacheInformation{fullSegmentName, cacheEnabled, cacheHits, cacheMisses, objectsStored, skippedFills, invalidations};
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::removeSegment(const std::string & segmentName, DatabaseObjectType type)
+{
+    return boost::interprocess::shared_memory_object::remove((segmentName + "_" + Convert::toString(type)).c_str());
+}
+
+void SyncServer_Core::DatabaseManagement::DALDistributedCache::requestsThread()
+{
+    logMessage(LogSeverity::Debug, "(requestsThread) Started.");
+    
+    while(!stopCache)
+    {
+        boost::unique_lock<boost::mutex> requestsLock(requestsThreadMutex);
+        
+        if(newRequests.empty())
+        {
+            requestsThreadLockCondition.wait(requestsLock);
+            continue;
+        }
+        
+        DatabaseRequest currentRequestData = std::move(newRequests.front());
+        DatabaseRequestID currentRequest = currentRequestData.getID();
+        newRequests.pop();
+        requestsLock.unlock();
+        
+        PendingRequest pending{currentRequestData.getType(), Common_Types::INVALID_OBJECT_ID, 0};
+        
+        switch(currentRequestData.getType())
+        {
+            case DatabaseRequestType::SELECT:
+            {
+                if(currentRequestData.getConstraint().limit == 0)
+                {
+                    pending.objectID = getCacheableID(currentRequestData.getConstraint().type, currentRequestData.getConstraint().value);
+                    
+                    if(pending.objectID != Common_Types::INVALID_OBJECT_ID)
+                    {
+                        //the version is taken before the lookup, so that a write completed after it prevents the object from being stored
+                        pending.version = getSlot(getHomeSlot(pending.objectID))->bucketVersion.load(std::memory_order_acquire);
+                        DataContainerPtr cachedObject = lookupObject(pending.objectID);
+                        
+                        if(cachedObject)
+                        {
+                            ++cacheHits;
+                            onSuccess(dalID, currentRequest, cachedObject);
+                            continue;
+                        }
+                        
+                        ++cacheMisses;
+                    }
+                }
+            } break;
+            
+            case DatabaseRequestType::INSERT:
+            case DatabaseRequestType::UPDATE: pending.objectID = currentRequestData.getContainer()->getContainerID(); break;
+            case DatabaseRequestType::REMOVE: pending.objectID = currentRequestData.getObjectID(); break;
+            
+            default:
+            {
+                logMessage(LogSeverity::Error, "(requestsThread) Unexpected request type encountered for request [" + Convert::toString(currentRequest) + "].");
+                onFailure(dalID, currentRequest, Common_Types::INVALID_OBJECT_ID, false);
+                continue;
+            }
+        }
+        
+        {
+            boost::lock_guard<boost::mutex> pendingLock(pendingRequestsMutex);
+            pendingRequests.insert({currentRequest, pending});
+        }
+        
+        bool requestSent = false;
+        switch(currentRequestData.getType())
+        {
+            case DatabaseRequestType::SELECT:
+            {
+                const DatabaseManagement_Types::SelectConstraint & constraint = currentRequestData.getConstraint();
+                
+                if(constraint.limit == 0)
+                    requestSent = dal->getObject(currentRequest, constraint.type, constraint.value);
+                else
+                    requestSent = dal->getObjectsPage(currentRequest, constraint.type, constraint.value, constraint.offset, constraint.limit);
+            } break;
+            
+            case DatabaseRequestType::INSERT: requestSent = dal->putObject(currentRequest, currentRequestData.getContainer()); break;
+            case DatabaseRequestType::UPDATE: requestSent = dal->updateObject(currentRequest, currentRequestData.getContainer()); break;
+            case DatabaseRequestType::REMOVE: requestSent = dal->removeObject(currentRequest, currentRequestData.getObjectID()); break;
+            default: break;
+        }
+        
+        if(!requestSent)
+        {
+            bool isPending = false;
+            
+            {
+                boost::lock_guard<boost::mutex> pendingLock(pendingRequestsMutex);
+                isPending = (pendingRequests.erase(currentRequest) > 0);
+            }
+            
+            if(isPending)
+            {
+                logMessage(LogSeverity::Error, "(requestsThread) Child DAL failed to accept request [" + Convert::toString(currentRequest) + "].");
+                onFailure(dalID, currentRequest, pending.objectID, false);
+            }
+        }
+    }
+    
+    logMessage(LogSeverity::Debug, "(requestsThread) Stopped.");
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::attachSegment()
+{
+    using namespace boost::interprocess;
+    
+    if(cacheParams.slotsNumber == 0 || cacheParams.slotDataSize == 0)
+    {
+        logMessage(LogSeverity::Error, "(attachSegment) Invalid cache parameters supplied; caching disabled.");
+        return false;
+    }
+    
+    std::size_t headerSize = ((sizeof(SegmentHeader) + 63) / 64) * 64;
+    slotSize = ((sizeof(SlotHeader) + cacheParams.slotDataSize + 7) / 8) * 8;
+    std::size_t segmentSize = headerSize + (slotSize * cacheParams.slotsNumber);
+    
+    try
+    {
+        shared_memory_object newSegment(open_or_create, fullSegmentName.c_str(), read_write);
+        
+        offset_t currentSize = 0;
+        if(!newSegment.get_size(currentSize))
+        {
+            logMessage(LogSeverity::Error, "(attachSegment) Failed to retrieve size of segment <" + fullSegmentName + ">; caching disabled.");
+            return false;
+        }
+        
+        if(currentSize == 0)
+        {
+            newSegment.truncate(segmentSize); //new segment; the memory is zero-filled
+        }
+        else if(static_cast<std::size_t>(currentSize) != segmentSize)
+        {
+            logMessage(LogSeverity::Error, "(attachSegment) Segment <" + fullSegmentName + "> was created with a different size; caching disabled.");
+            return false;
+        }
+        
+        mapped_region newRegion(newSegment, read_write);
+        segment.swap(newSegment);
+        region.swap(newRegion);
+    }
+    catch(const interprocess_exception & e)
+    {
+        logMessage(LogSeverity::Error, "(attachSegment) Failed to attach to segment <" + fullSegmentName + ">: [" + e.what() + "]; caching disabled.");
+        return false;
+    }
+    
+    header = static_cast<SegmentHeader*>(region.get_address());
+    slots = static_cast<char*>(region.get_address()) + headerSize;
+    
+    std::uint32_t expectedState = SEGMENT_STATE_NEW;
+    if(header->state.compare_exchange_strong(expectedState, SEGMENT_STATE_INITIALISING, std::memory_order_acq_rel))
+    {
+        header->magic = SEGMENT_MAGIC;
+        header->layoutVersion = SEGMENT_LAYOUT_VERSION;
+        header->slotsNumber = cacheParams.slotsNumber;
+        header->slotDataSize = cacheParams.slotDataSize;
+        header->state.store(SEGMENT_STATE_READY, std::memory_order_release);
+    }
+    else
+    {
+        //another process is initialising the segment
+        for(unsigned int i = 0; i < 1000 && header->state.load(std::memory_order_acquire) != SEGMENT_STATE_READY; i++)
+            boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+        
+        if(header->state.load(std::memory_order_acquire) != SEGMENT_STATE_READY)
+        {
+            logMessage(LogSeverity::Error, "(attachSegment) Segment <" + fullSegmentName + "> was not initialised in time; caching disabled.");
+            return false;
+        }
+    }
+    
+    if(header->magic != SEGMENT_MAGIC || header->layoutVersion != SEGMENT_LAYOUT_VERSION
+       || header->slotsNumber != cacheParams.slotsNumber || header->slotDataSize != cacheParams.slotDataSize)
+    {
+        logMessage(LogSeverity::Error, "(attachSegment) Segment <" + fullSegmentName + "> has an unexpected layout; caching disabled.");
+        return false;
+    }
+    
+    logMessage(LogSeverity::Debug, "(attachSegment) Attached to segment <" + fullSegmentName + ">.");
+    return true;
+}
+
+DBObjectID SyncServer_Core::DatabaseManagement::DALDistributedCache::getCacheableID(const boost::any & constraintType, const boost::any & constraintValue) const
+{
+    //statistics are selected with a StatisticType as the LIMIT_BY_TYPE value (not an object ID),
+    //so their lookups cannot be mapped to a cached object
+    if(!cacheEnabled || cacheType == DatabaseObjectType::STATISTICS)
+        return Common_Types::INVALID_OBJECT_ID;
+    
+    return Utilities::Tools::getIDFromConstraint(cacheType, constraintType, constraintValue);
+}
+
+std::uint32_t SyncServer_Core::DatabaseManagement::DALDistributedCache::getHomeSlot(const DBObjectID & id) const
+{
+    //boost::hash for UUIDs depends only on the ID bytes, so all processes select the same slot
+    return static_cast<std::uint32_t>(boost::hash<DBObjectID>()(id) % cacheParams.slotsNumber);
+}
+
+DataContainerPtr SyncServer_Core::DatabaseManagement::DALDistributedCache::lookupObject(const DBObjectID & id) const
+{
+    std::uint32_t homeIndex = getHomeSlot(id);
+    const SlotHeader * homeSlot = getSlot(homeIndex);
+    std::string entryData;
+    
+    for(std::uint32_t probe = 0; probe < cacheParams.maximumProbes; probe++)
+    {
+        const SlotHeader * currentSlot = getSlot((homeIndex + probe) % cacheParams.slotsNumber);
+        
+        for(unsigned int attempt = 0; attempt < 3; attempt++)
+        {
+            std::uint64_t sequenceBefore = currentSlot->sequence.load(std::memory_order_acquire);
+            if((sequenceBefore & 1) != 0)
+                continue; //slot is being written
+            
+            std::uint32_t dataSize = currentSlot->dataSize;
+            std::uint64_t entryVersion = currentSlot->entryVersion;
+            bool idMatches = (dataSize > 0 && dataSize <= cacheParams.slotDataSize
+                              && std::memcmp(currentSlot->objectID, id.data, sizeof(currentSlot->objectID)) == 0);
+            
+            if(idMatches)
+                entryData.assign(reinterpret_cast<const char*>(currentSlot + 1), dataSize);
+            
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(currentSlot->sequence.load(std::memory_order_relaxed) != sequenceBefore)
+                continue; //slot was modified during the read
+            
+            if(!idMatches)
+                break;
+            
+            if(entryVersion != homeSlot->bucketVersion.load(std::memory_order_acquire))
+                return DataContainerPtr(); //object was invalidated after the entry was stored
+            
+            try
+            {
+                return DatabaseManagement_Containers::ContainerSerializer::deserialize(entryData);
+            }
+            catch(const std::exception & e)
+            {
+                logMessage(LogSeverity::Error, "(lookupObject) Failed to decode cached object: [" + std::string(e.what()) + "].");
+                return DataContainerPtr();
+            }
+        }
+    }
+    
+    return DataContainerPtr();
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::storeObject(const DataContainerPtr object, std::uint64_t version)
+{
+    DBObjectID id = object->getContainerID();
+    std::string objectData;
+    try
+    {
+        objectData = DatabaseManagement_Containers::ContainerSerializer::serialize(object);
+    }
+    catch(const std::exception & e)
+    {
+        logMessage(LogSeverity::Error, "(storeObject) Failed to encode object: [" + std::string(e.what()) + "].");
+        return false;
+    }
+    
+    if(objectData.empty() || objectData.size() > cacheParams.slotDataSize)
+        return false;
+    
+    std::uint32_t homeIndex = getHomeSlot(id);
+    SlotHeader * homeSlot = getSlot(homeIndex);
+    
+    //prefers a slot holding the same object, followed by empty or invalidated slots
+    SlotHeader * targetSlot = nullptr;
+    unsigned int targetRank = 0;
+    for(std::uint32_t probe = 0; probe < cacheParams.maximumProbes && targetRank < 3; probe++)
+    {
+        SlotHeader * currentSlot = getSlot((homeIndex + probe) % cacheParams.slotsNumber);
+        
+        if((currentSlot->sequence.load(std::memory_order_acquire) & 1) != 0)
+            continue;
+        
+        unsigned int currentRank = 1;
+        if(std::memcmp(currentSlot->objectID, id.data, sizeof(currentSlot->objectID)) == 0)
+        {
+            currentRank = 3;
+        }
+        else if(currentSlot->dataSize == 0)
+        {
+            currentRank = 2;
+        }
+        else
+        {
+            DBObjectID currentID;
+            std::memcpy(currentID.data, currentSlot->objectID, sizeof(currentSlot->objectID));
+            if(currentSlot->entryVersion != getSlot(getHomeSlot(currentID))->bucketVersion.load(std::memory_order_acquire))
+                currentRank = 2;
+        }
+        
+        if(currentRank > targetRank)
+        {
+            targetSlot = currentSlot;
+            targetRank = currentRank;
+        }
+    }
+    
+    if(targetSlot == nullptr)
+        return false;
+    
+    std::uint64_t sequence = targetSlot->sequence.load(std::memory_order_acquire);
+    if((sequence & 1) != 0 || !targetSlot->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+        return false; //slot is being written by another thread/process
+    
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    bool stored = (homeSlot->bucketVersion.load(std::memory_order_acquire) == version);
+    if(stored)
+    {
+        targetSlot->dataSize = 0;
+        std::memcpy(targetSlot->objectID, id.data, sizeof(targetSlot->objectID));
+        std::memcpy(reinterpret_cast<char*>(targetSlot + 1), objectData.data(), objectData.size());
+        targetSlot->entryVersion = version;
+        targetSlot->dataSize = static_cast<std::uint32_t>(objectData.size());
+    }
+    
+    targetSlot->sequence.store(sequence + 2, std::memory_order_release);
+    return stored;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALDistributedCache::addRequest(const DatabaseRequest & request)
+{
+    if(stopCache)
+        return false;
+    
+    boost::lock_guard<boost::mutex> requestsLock(requestsThreadMutex);
+    newRequests.push(request);
+    requestsThreadLockCondition.notify_all();
+    return true;
+}
+
+void SyncServer_Core::DatabaseManagement::DALDistributedCache::onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id, bool notFound)
+{
+    {
+        boost::lock_guard<boost::mutex> pendingLock(pendingRequestsMutex);
+        
+        if(pendingRequests.erase(requestID) == 0)
+        {
+            logMessage(LogSeverity::Error, "(onFailureHandler) Unexpected response received for request [" + Convert::toString(requestID) + "].");
+            return;
+        }
+    }
+    
+    onFailure(this->dalID, requestID, id, notFound);
+}
+
+void SyncServer_Core::DatabaseManagement::DALDistributedCache::onSuccessHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DataContainerPtr data)
+{
+    PendingRequest request;
+    
+    {
+        boost::lock_guard<boost::mutex> pendingLock(pendingRequestsMutex);
+        
+        auto requestIterator = pendingRequests.find(requestID);
+        if(requestIterator == pendingRequests.end())
+        {
+            logMessage(LogSeverity::Error, "(onSuccessHandler) Unexpected response received for request [" + Convert::toString(requestID) + "].");
+            return;
+        }
+        
+        request = requestIterator->second;
+        pendingRequests.erase(requestIterator);
+    }
+    
+    if(request.objectID != Common_Types::INVALID_OBJECT_ID)
+    {
+        if(request.type == DatabaseRequestType::SELECT)
+        {
+            if(data && data->getDataType() != DatabaseObjectType::VECTOR && data->getContainerID() == request.objectID)
+            {
+                if(storeObject(data, request.version))
+                    ++objectsStored;
+                else
+                    ++skippedFills;
+            }
+        }
+        else
+        {
+            invalidateObject(request.objectID);
+        }
+    }
+    
+    onSuccess(this->dalID, requestID, data);
+}
@@ -19,16 +19,338 @@
 #ifndef DALDISTRIBUTEDCACHE_H
 #define	DALDISTRIBUTEDCACHE_H
 
+#include <atomic>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <boost/any.hpp>
+#include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "Types/Types.h"
+#include "Types/DatabaseRequest.h"
+#include "../Utilities/Strings/Common.h"
+#include "../Utilities/Strings/Database.h"
+#include "../Utilities/FileLogger.h"
+#include "Containers/DataContainer.h"
+#include "Containers/VectorDataContainer.h"
+#include "Interfaces/DatabaseAbstractionLayer.h"
+#include "Containers/ContainerSerializer.h"
+
+namespace Convert = Utilities::Strings;
+
+using boost::unordered::unordered_map;
+
+using std::queue;
+
+using Common_Types::DBObjectID;
+using DatabaseManagement_Interfaces::DALPtr;
+using DatabaseManagement_Interfaces::DatabaseSettingsContainer;
+using DatabaseManagement_Interfaces::DatabaseInformationContainer;
+
+using DatabaseManagement_Types::DatabaseRequestID;
+using DatabaseManagement_Types::DatabaseRequestType;
+using DatabaseManagement_Types::DatabaseRequest;
+using DatabaseManagement_Types::DatabaseAbstractionLayerID;
+
+using DatabaseManagement_Containers::DataContainerPtr;
+using DatabaseManagement_Containers::VectorDataContainerPtr;
+
 namespace SyncServer_Core
 {
     namespace DatabaseManagement
     {
-        class DALDistributedCache
+        /**
+         * DAL class for caching database objects in a shared memory segment,
+         * accessible by all server processes running on the same host.
+         *
+         * The segment (one per object type) holds a fixed size, open addressing hash table,
+         * keyed by object ID:
+         * - each slot has a sequence number, used as a sequence lock; readers never block
+         * and simply retry (or treat the lookup as a miss) when a slot is being written;
+         * - each slot has a bucket version, incremented every time an object whose home is
+         * the slot is written (INSERT/UPDATE/REMOVE) by any process;
+         * - each entry stores the bucket version of its home slot, taken before the object was
+         * retrieved from the child DAL; entries with an older version are never returned.
+         *
+         * All writes are sent to the child DAL and invalidate the affected objects once they are
+         * completed, so an entry filled with data retrieved before a write (by any process) can not
+         * be used after that write.
+         *
+         * Only SELECTs by object ID are served from the cache; all other requests (and all requests
+         * for statistics and system settings) are sent directly to the child DAL.
+         *
+         * Note: Objects are stored using the <code>ContainerSerializer</code> binary format; objects that do not fit
+         * in a single slot are not cached.
+         */
+        class DALDistributedCache : public DatabaseManagement_Interfaces::DatabaseAbstractionLayer
         {
+            public:
+                /** Parameters structure for holding <code>DALDistributedCache</code> configuration data. */
+                struct DALDistributedCacheParameters
+                {
+                    /** Shared memory segment name prefix (the object type of the child DAL is appended to it). */
+                    std::string segmentName;
+                    /** Number of slots in the shared table. */
+                    std::uint32_t slotsNumber;
+                    /** Maximum size of the serialized data for a single object (in bytes). */
+                    std::uint32_t slotDataSize;
+                    /** Maximum number of slots checked for a single object, starting from its home slot. */
+                    std::uint32_t maximumProbes;
+                };
+                
+                /** Information structure for holding <code>DALDistributedCache</code> data. */
+                struct DALDistributedCacheInformation
+                {
+                    std::string segmentName;        //full name of the shared memory segment
+                    bool cacheEnabled;              //denotes whether the shared segment is in use
+                    unsigned long cacheHits;        //objects found in the shared table
+                    unsigned long cacheMisses;      //objects that had to be retrieved from the child DAL
+                    unsigned long objectsStored;    //objects written to the shared table
+                    unsigned long skippedFills;     //objects not stored (too large, invalidated or contended slots)
+                    unsigned long invalidations;    //objects invalidated by writes
+                };
+                
+                /**
+                 * Initialises the cache and attaches it to the shared memory segment for
+                 * the type of the child DAL (the segment is created, if it does not exist).
+                 *
+                 * Note: If the segment cannot be created or was created with different parameters,
+                 * the cache is disabled and all requests are sent directly to the child DAL.
+                 *
+                 * @param childDAL the child DAL that will process all DB requests
+                 * @param parentLogger the file logger of the parent DatabaseManager
+                 * @param parameters the cache configuration parameters
+                 */
+                DALDistributedCache(DALPtr childDAL, Utilities::FileLoggerPtr parentLogger, DALDistributedCacheParameters parameters);
+                
+                /**
+                 * Cache destructor.
+                 *
+                 * Stops the requests thread and detaches from the shared memory segment (the segment itself is not removed).
+                 */
+                ~DALDistributedCache() override;
+                
+                DALDistributedCache() = delete;                                       //No default constructor
+                DALDistributedCache(const DALDistributedCache&) = delete;             //Copying not allowed (pass/access only by reference/pointer)
+                DALDistributedCache& operator=(const DALDistributedCache&) = delete;  //Copying not allowed (pass/access only by reference/pointer)
+                
+                bool getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue) override;
+                bool getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                    unsigned long offset, unsigned long limit) override;
+                bool putObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
+                bool updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
+                bool removeObject(DatabaseRequestID requestID, DBObjectID id) override;
+                
+                bool changeDatabaseSettings(const DatabaseSettingsContainer settings) override  { return dal->changeDatabaseSettings(settings); }
+                bool buildDatabase() override                                                   { return dal->buildDatabase(); }
+                bool rebuildDatabase() override                                                 { return dal->rebuildDatabase(); }
+                bool clearDatabase() override                                                   { return dal->clearDatabase(); }
+                unsigned long dropLogsBefore(Timestamp time) override                           { return dal->dropLogsBefore(time); }
+                bool connect() override                                                         { return dal->connect(); }
+                bool disconnect() override                                                      { return dal->disconnect(); }
+                const DatabaseInformationContainer* getDatabaseInfo() const override            { return dal->getDatabaseInfo(); }
+                void setID(DatabaseAbstractionLayerID id) override                              { dalID = id; dal->setID(dalID); }
+                DatabaseAbstractionLayerID getID() const override                               { return dalID; }
+                DatabaseObjectType getType() const override                                     { return cacheType; }
+                
+                /**
+                 * Invalidates the specified object in the shared table, for all processes.
+                 *
+                 * @param id the ID of the object to be invalidated
+                 */
+                void invalidateObject(const DBObjectID id);
+                
+                /**
+                 * Retrieves general information for the cache.
+                 *
+                 * @return the requested information
+                 */
+                DALDistributedCacheInformation getCacheInformation() const;
+                
+                /**
+                 * Removes the shared memory segment for the specified configuration and object type.
+                 *
+                 * Note: Processes already attached to the segment can continue using it.
+                 *
+                 * @param segmentName the segment name prefix
+                 * @param type the object type of the segment
+                 * @return <code>true</code>, if the segment was removed
+                 */
+                static bool removeSegment(const std::string & segmentName, DatabaseObjectType type);
             
+            private:
+                /** Shared segment header. */
+                struct SegmentHeader
+                {
+                    std::atomic<std::uint32_t> state;   //segment state (see SEGMENT_STATE_*)
+                    std::uint32_t magic;                //segment identifier
+                    std::uint32_t layoutVersion;        //version of the segment layout
+                    std::uint32_t slotsNumber;          //number of slots in the table
+                    std::uint32_t slotDataSize;         //maximum size of the data in a slot
+                };
+                
+                /** Shared slot header (the slot data follows the header). */
+                struct SlotHeader
+                {
+                    std::atomic<std::uint64_t> sequence;        //slot lock; odd while the slot is being written
+                    std::atomic<std::uint64_t> bucketVersion;   //incremented when an object with this home slot is written
+                    std::uint64_t entryVersion;                 //bucket version of the home slot of the entry, at retrieval time
+                    std::uint32_t dataSize;                     //size of the entry data (0 = empty slot)
+                    std::uint8_t objectID[16];                  //ID of the stored object
+                };
+                
+                /** Structure for holding a request sent to the child DAL. */
+                struct PendingRequest
+                {
+                    DatabaseRequestType type;   //request type
+                    DBObjectID objectID;        //the object to be stored or invalidated (if any)
+                    std::uint64_t version;      //bucket version of the home slot of the object, before the request was sent (SELECT only)
+                };
+                
+                static const std::uint32_t SEGMENT_MAGIC = 0x53594e43;
+                static const std::uint32_t SEGMENT_LAYOUT_VERSION = 1;
+                static const std::uint32_t SEGMENT_STATE_NEW = 0;
+                static const std::uint32_t SEGMENT_STATE_INITIALISING = 1;
+                static const std::uint32_t SEGMENT_STATE_READY = 2;
+                
+                //Cache management
+                DALPtr dal;                                                     //next DAL
+                DatabaseObjectType cacheType;                                   //type of stored containers
+                DALDistributedCacheParameters cacheParams;                      //cache configuration
+                std::string fullSegmentName;                                    //name of the shared segment
+                boost::interprocess::shared_memory_object segment;              //shared segment
+                boost::interprocess::mapped_region region;                      //mapping of the shared segment
+                SegmentHeader * header = nullptr;                               //segment header (in shared memory)
+                char * slots = nullptr;                                         //first slot (in shared memory)
+                std::size_t slotSize = 0;                                       //size of a slot, including its header
+                bool cacheEnabled = false;                                      //denotes whether the shared segment is in use
+                DatabaseAbstractionLayerID dalID = DatabaseManagement_Types::INVALID_DAL_ID;
+                boost::signals2::connection onSuccessConnection;                //Events connection (success)
+                boost::signals2::connection onFailureConnection;                //Events connection (failure)
+                
+                //Requests management
+                queue<DatabaseRequest> newRequests;                             //requests waiting to be processed
+                unordered_map<DatabaseRequestID, PendingRequest> pendingRequests; //requests sent to the child DAL
+                
+                //Stats
+                std::atomic<unsigned long> cacheHits {0};
+                std::atomic<unsigned long> cacheMisses {0};
+                std::atomic<unsigned long> objectsStored {0};
+                std::atomic<unsigned long> skippedFills {0};
+                std::atomic<unsigned long> invalidations {0};
+                
+                //Thread management
+                Utilities::FileLoggerPtr debugLogger;                   //parent file logger
+                boost::thread * requestsThreadObject = nullptr;         //main requests thread
+                boost::mutex requestsThreadMutex;                       //requests mutex
+                boost::mutex pendingRequestsMutex;                      //pending requests mutex
+                boost::condition_variable requestsThreadLockCondition;  //requests condition variable
+                std::atomic<bool> stopCache {false};                    //denotes whether the cache is being stopped
+                
+                /**
+                 * Main requests thread.
+                 *
+                 * Serves SELECTs from the shared table and sends all other requests to the child DAL.
+                 */
+                void requestsThread();
+                
+                /**
+                 * Creates or opens the shared segment and validates its header.
+                 *
+                 * @return <code>true</code>, if the segment can be used
+                 */
+                bool attachSegment();
+                
+                /**
+                 * Retrieves the ID of the object requested with the specified constraint.
+                 *
+                 * @param constraintType the constraint type
+                 * @param constraintValue the constraint value
+                 * @return the object ID or <code>INVALID_OBJECT_ID</code>, if the constraint is not cacheable
+                 */
+                DBObjectID getCacheableID(const boost::any & constraintType, const boost::any & constraintValue) const;
+                
+                /**
+                 * Retrieves the slot with the specified index.
+                 *
+                 * @param index the slot index
+                 * @return the requested slot
+                 */
+                SlotHeader * getSlot(std::uint32_t index) const
+                {
+                    return reinterpret_cast<SlotHeader*>(slots + (slotSize * index));
+                }
+                
+                /**
+                 * Retrieves the index of the home slot for the specified object.
+                 *
+                 * @param id the object ID
+                 * @return the slot index
+                 */
+                std::uint32_t getHomeSlot(const DBObjectID & id) const;
+                
+                /**
+                 * Attempts to retrieve the specified object from the shared table, without locking.
+                 *
+                 * @param id the object ID
+                 * @return the object or <code>nullptr</code>, if it was not found (or is not valid)
+                 */
+                DataContainerPtr lookupObject(const DBObjectID & id) const;
+                
+                /**
+                 * Attempts to store the specified object in the shared table.
+                 *
+                 * The object is not stored if its home slot was invalidated since the specified
+                 * version was taken or if none of the slots available to it can be locked.
+                 *
+                 * @param object the object to be stored
+                 * @param version the bucket version of the home slot, taken before the object was retrieved
+                 * @return <code>true</code>, if the object was stored
+                 */
+                bool storeObject(const DataContainerPtr object, std::uint64_t version);
+                
+                /**
+                 * Adds a new request for the requests thread.
+                 *
+                 * @param request the request to be added
+                 * @return <code>true</code>, if the request was added
+                 */
+                bool addRequest(const DatabaseRequest & request);
+                
+                /**
+                 * Event handler for "onFailure" signals coming from the child DAL.
+                 *
+                 * @param dalID the ID of the caller DAL
+                 * @param requestID the associated request ID
+                 * @param id the associated object ID (if any)
+                 * @param notFound denotes whether a SELECT request completed without finding any objects
+                 */
+                void onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id, bool notFound);
+                
+                /**
+                 * Event handler for "onSuccess" signals coming from the child DAL.
+                 *
+                 * @param dalID the ID of the caller DAL
+                 * @param requestID the associated request ID
+                 * @param data the associated request data
+                 */
+                void onSuccessHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DataContainerPtr data);
+                
+                /**
+                 * Logs the specified message, if the log handler is set.
+                 *
+                 * @param severity the severity associated with the message/event
+                 * @param message the message to be logged
+                 */
+                void logMessage(LogSeverity severity, const std::string & message) const
+                {
+                    if(debugLogger)
+                        debugLogger->logMessage(Utilities::FileLogSeverity::Debug, "DALDistributedCache / " + Convert::toString(cacheType) + " > " + message);
+                }
         };
     }
 }
 
 #endif	/* DALDISTRIBUTEDCACHE_H */
-
@@ -16,4 +16,642 @@
  */
 
 #include "DALMigrator.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 
+SyncServer_Core::DatabaseManagement::DALMigrator::DALMigrator
+(DatabaseManager & manager, Utilities::FileLoggerPtr parentLogger, DALMigratorParameters parameters)
+: databaseManager(manager), debugLogger(parentLogger), migratorParams(parameters)
+{
+    if(migratorParams.maximumPendingWrites == 0)
+        migratorParams.maximumPendingWrites = 1;
+    
+    loadCheckpoint();
+}
+
+SyncServer_Core::DatabaseManagement::DALMigrator::~DALMigrator()
+{
+    logMessage(LogSeverity::Debug, "(~) Destruction initiated.");
+    stopMigrations();
+    waitForMigrations();
+    
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    
+    for(auto currentMigration : migrations)
+        delete currentMigration.second;
+    
+    migrations.clear();
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::addMigration(DALPtr sourceDAL, DALPtr targetDAL)
+{
+    if(!sourceDAL || !targetDAL || sourceDAL == targetDAL)
+    {
+        logMessage(LogSeverity::Error, "(addMigration) > Invalid DALs supplied.");
+        return false;
+    }
+    
+    if(sourceDAL->getType() != targetDAL->getType())
+    {
+        logMessage(LogSeverity::Error, "(addMigration) > Source and target DAL types do not match <"
+                + Convert::toString(sourceDAL->getType()) + "/" + Convert::toString(targetDAL->getType()) + ">.");
+        return false;
+    }
+    
+    DALQueue * queue = databaseManager.getQueue(sourceDAL->getType());
+    if(queue == nullptr)
+    {
+        logMessage(LogSeverity::Error, "(addMigration) > Unexpected DAL type found <" + Convert::toString(sourceDAL->getType()) + ">.");
+        return false;
+    }
+    
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    
+    if(migrationsStarted)
+    {
+        logMessage(LogSeverity::Error, "(addMigration) > Migrations already started.");
+        return false;
+    }
+    
+    if(migrations.find(sourceDAL->getType()) != migrations.end())
+    {
+        logMessage(LogSeverity::Error, "(addMigration) > A migration already exists for type <" + Convert::toString(sourceDAL->getType()) + ">.");
+        return false;
+    }
+    
+    MigrationData * newMigration = new MigrationData(sourceDAL, targetDAL, queue);
+    
+    auto checkpointPhase = checkpointPhases.find(sourceDAL->getType());
+    if(checkpointPhase != checkpointPhases.end())
+    {
+        if(checkpointPhase->second == DALMigrationPhase::COMPLETED)
+        {
+            logMessage(LogSeverity::Info, "(addMigration) > Migration for type <" + Convert::toString(sourceDAL->getType())
+                    + "> was completed by an earlier run and will be skipped.");
+            newMigration->phase = DALMigrationPhase::COMPLETED;
+        }
+        else if(checkpointPhase->second != DALMigrationPhase::PENDING)
+            newMigration->isResumed = true;
+    }
+    
+    migrations.insert(std::pair<DatabaseObjectType, MigrationData*>(sourceDAL->getType(), newMigration));
+    
+    return true;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::startMigrations()
+{
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    
+    if(migrationsStarted || stopMigrator)
+    {
+        logMessage(LogSeverity::Error, "(startMigrations) > Migrations cannot be started.");
+        return false;
+    }
+    
+    migrationsStarted = true;
+    
+    for(auto currentMigration : migrations)
+    {
+        if(currentMigration.second->phase == DALMigrationPhase::COMPLETED)
+            continue;
+        
+        currentMigration.second->startTime = boost::posix_time::microsec_clock::universal_time();
+        currentMigration.second->thread = new boost::thread(&DatabaseManagement::DALMigrator::migrationThread, this, currentMigration.second);
+    }
+    
+    logMessage(LogSeverity::Debug, "(startMigrations) > <" + Convert::toString(migrations.size()) + "> migrations started.");
+    return true;
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::stopMigrations()
+{
+    stopMigrator = true;
+    
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    
+    for(auto currentMigration : migrations)
+    {
+        boost::lock_guard<boost::mutex> dataLock(currentMigration.second->dataMutex);
+        currentMigration.second->writesCondition.notify_all();
+    }
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::waitForMigrations()
+{
+    vector<boost::thread *> threads;
+    
+    {
+        boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+        for(auto currentMigration : migrations)
+        {
+            if(currentMigration.second->thread != nullptr)
+                threads.push_back(currentMigration.second->thread);
+        }
+    }
+    
+    for(boost::thread * currentThread : threads)
+        currentThread->join();
+    
+    bool result = true;
+    
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    for(auto currentMigration : migrations)
+    {
+        delete currentMigration.second->thread;
+        currentMigration.second->thread = nullptr;
+        
+        boost::lock_guard<boost::mutex> dataLock(currentMigration.second->dataMutex);
+        if(currentMigration.second->phase != DALMigrationPhase::COMPLETED)
+            result = false;
+    }
+    
+    return result;
+}
+
+vector<SyncServer_Core::DatabaseManagement::DALMigrator::MigrationProgress> SyncServer_Core::DatabaseManagement::DALMigrator::getProgress() const
+{
+    vector<MigrationProgress> result;
+    boost::posix_time::ptime currentTime = boost::posix_time::microsec_clock::universal_time();
+    
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    
+    for(auto currentMigration : migrations)
+    {
+        MigrationData * data = currentMigration.second;
+        boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+        
+        double writesPerSecond = 0.0;
+        if(!data->startTime.is_not_a_date_time())
+        {
+            double elapsedSeconds = (currentTime - data->startTime).total_milliseconds() / 1000.0;
+            if(elapsedSeconds > 0)
+                writesPerSecond = (data->objectsCopied + data->changesApplied) / elapsedSeconds;
+        }
+        
+        result.push_back(MigrationProgress{currentMigration.first, data->phase, data->objectsCopied,
+                data->changesCaptured, data->changesApplied, data->failedWrites, writesPerSecond});
+    }
+    
+    return result;
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::migrationThread(MigrationData * data)
+{
+    DatabaseObjectType migrationType = data->sourceDAL->getType();
+    logMessage(LogSeverity::Debug, "(migrationThread) > Started for type <" + Convert::toString(migrationType) + ">.");
+    
+    boost::signals2::connection onSuccessConnection, onFailureConnection, onWriteConnection, onWriteCompletedConnection;
+    onSuccessConnection = data->targetDAL->onSuccessEventAttach(
+        [this, data](DatabaseAbstractionLayerID, DatabaseRequestID requestID, DataContainerPtr)
+        {
+            onTargetSuccessHandler(data, requestID);
+        });
+    
+    onFailureConnection = data->targetDAL->onFailureEventAttach(
+        [this, data](DatabaseAbstractionLayerID, DatabaseRequestID requestID, DBObjectID, bool)
+        {
+            onTargetFailureHandler(data, requestID);
+        });
+    
+    data->targetDAL->connect();
+    
+    //captures all writes sent to the source from the start of the snapshot, so that no changes are missed
+    onWriteCompletedConnection = data->queue->onWriteCompletedEventAttach(
+        [this, data](DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, bool successful)
+        {
+            onSourceWriteCompletedHandler(data, dalID, requestID, successful);
+        });
+    
+    onWriteConnection = data->queue->onWriteDispatchedEventAttach(
+        [data](const DatabaseRequest & request, const vector<DatabaseAbstractionLayerID> & dals)
+        {
+            if(std::find(dals.begin(), dals.end(), data->sourceDAL->getID()) == dals.end())
+                return; //the source did not receive the write (for example, its breaker is open)
+            
+            boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+            data->capturedChanges.push_back(request);
+            data->unconfirmedChanges.insert(request.getID());
+            data->changesCaptured++;
+        });
+    
+    setPhase(data, DALMigrationPhase::SNAPSHOT);
+    
+    //objects that may have been copied by an earlier attempt are updated instead of inserted
+    DatabaseRequestType snapshotRequestType = (data->isResumed) ? DatabaseRequestType::UPDATE : DatabaseRequestType::INSERT;
+    
+    bool successful = databaseManager.streamAllObjects(migrationType, migratorParams.snapshotPageSize,
+        [&](const vector<DataContainerPtr> & objects)
+        {
+            for(const DataContainerPtr & currentObject : objects)
+            {
+                if(stopMigrator || !currentObject)
+                    return false;
+                
+                data->copiedObjects.insert(currentObject->getContainerID());
+                
+                if(!sendWrite(data, PendingWrite{DatabaseRequest(snapshotRequestType, DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, currentObject), false, 0}))
+                    return false;
+                
+                boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+                data->objectsCopied++;
+            }
+            
+            return true;
+        });
+    
+    successful = successful && !stopMigrator && waitForPendingWrites(data, 0);
+    
+    bool completed = false;
+    
+    if(successful)
+    {
+        setPhase(data, DALMigrationPhase::CATCH_UP);
+        unsigned int cutoverAttempts = 0;
+        
+        while(successful && !completed && !stopMigrator)
+        {
+            successful = applyCapturedChanges(data) && waitForPendingWrites(data, 0);
+            
+            std::size_t remainingChanges = 0;
+            {
+                boost::unique_lock<boost::mutex> dataLock(data->dataMutex);
+                remainingChanges = data->capturedChanges.size();
+                
+                //waits for the source to confirm more of the captured writes
+                if(successful && remainingChanges > migratorParams.maximumCutoverBacklog && !stopMigrator)
+                    data->writesCondition.timed_wait(dataLock, boost::posix_time::milliseconds(100));
+            }
+            
+            if(!successful || remainingChanges > migratorParams.maximumCutoverBacklog)
+                continue;
+            
+            setPhase(data, DALMigrationPhase::CUTOVER);
+            completed = performCutover(data);
+            
+            if(completed)
+                continue;
+            
+            if(++cutoverAttempts >= migratorParams.maximumCutoverAttempts)
+            {
+                logMessage(LogSeverity::Error, "(migrationThread) > Maximum number of cutover attempts reached for type <" + Convert::toString(migrationType) + ">.");
+                successful = false;
+            }
+            else
+                setPhase(data, DALMigrationPhase::CATCH_UP);
+        }
+    }
+    
+    onWriteConnection.disconnect();
+    onWriteCompletedConnection.disconnect();
+    onSuccessConnection.disconnect();
+    onFailureConnection.disconnect();
+    
+    if(completed)
+    {
+        setPhase(data, DALMigrationPhase::COMPLETED);
+        logMessage(LogSeverity::Debug, "(migrationThread) > Completed for type <" + Convert::toString(migrationType) + ">.");
+    }
+    else
+    {
+        data->targetDAL->disconnect();
+        setPhase(data, DALMigrationPhase::FAILED);
+        logMessage(LogSeverity::Error, "(migrationThread) > Failed or stopped for type <" + Convert::toString(migrationType) + ">; source DAL remains in use.");
+    }
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::sendWrite(MigrationData * data, PendingWrite write)
+{
+    DatabaseRequestID requestID = DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+    DBObjectID objectID = getWriteObjectID(write.request);
+    
+    {
+        boost::unique_lock<boost::mutex> dataLock(data->dataMutex);
+        
+        if(!write.isRetry)
+        {
+            write.sequence = data->nextWriteSequence++;
+            data->latestWrites[objectID] = write.sequence;
+        }
+        
+        //writes for the same object are not sent in parallel, so that they are completed in order
+        while((data->pendingWrites.size() >= migratorParams.maximumPendingWrites
+              || data->pendingObjects.find(objectID) != data->pendingObjects.end()) && !stopMigrator)
+        {
+            data->writesCondition.timed_wait(dataLock, boost::posix_time::milliseconds(100));
+        }
+        
+        if(stopMigrator)
+            return false;
+        
+        if(write.isRetry && data->latestWrites[objectID] != write.sequence)
+        {
+            logMessage(LogSeverity::Debug, "(sendWrite) > Retry for object <" + Convert::toString(objectID) + "> discarded; a newer write was sent.");
+            return true;
+        }
+        
+        requestID = data->nextRequestID++;
+        write.request.setID(requestID);
+        data->pendingWrites.insert(std::pair<DatabaseRequestID, PendingWrite>(requestID, write));
+        data->pendingObjects.insert(objectID);
+    }
+    
+    bool result = false;
+    switch(write.request.getType())
+    {
+        case DatabaseRequestType::INSERT: result = data->targetDAL->putObject(requestID, write.request.getContainer()); break;
+        case DatabaseRequestType::UPDATE: result = data->targetDAL->updateObject(requestID, write.request.getContainer()); break;
+        case DatabaseRequestType::REMOVE: result = data->targetDAL->removeObject(requestID, write.request.getObjectID()); break;
+        default: logMessage(LogSeverity::Error, "(sendWrite) > Unexpected request type encountered."); break;
+    }
+    
+    if(!result)
+    {
+        boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+        data->pendingWrites.erase(requestID);
+        data->pendingObjects.erase(objectID);
+        data->failedWrites++;
+        data->writesCondition.notify_all();
+        logMessage(LogSeverity::Error, "(sendWrite) > Request <" + Convert::toString(requestID) + "> could not be submitted to the target DAL.");
+    }
+    
+    return result;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::waitForPendingWrites(MigrationData * data, unsigned long maximumWrites)
+{
+    while(!stopMigrator)
+    {
+        PendingWrite retry{DatabaseRequest(), false, 0};
+        bool retryFound = false;
+        
+        {
+            boost::unique_lock<boost::mutex> dataLock(data->dataMutex);
+            
+            if(data->retryWrites.empty())
+            {
+                if(data->pendingWrites.size() <= maximumWrites)
+                    return true;
+                
+                data->writesCondition.timed_wait(dataLock, boost::posix_time::milliseconds(100));
+            }
+            
+            if(!data->retryWrites.empty())
+            {
+                retry = data->retryWrites.front();
+                data->retryWrites.pop_front();
+                retryFound = true;
+            }
+        }
+        
+        if(retryFound)
+            sendWrite(data, retry);
+    }
+    
+    return false;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::applyCapturedChanges(MigrationData * data)
+{
+    while(!stopMigrator)
+    {
+        DatabaseRequest currentChange;
+        
+        {
+            boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+            if(data->capturedChanges.empty())
+                return true;
+            
+            DatabaseRequestID changeID = data->capturedChanges.front().getID();
+            if(data->unconfirmedChanges.find(changeID) != data->unconfirmedChanges.end())
+                return true; //the source has not responded yet; later writes must wait, to preserve their order
+            
+            currentChange = data->capturedChanges.front();
+            data->capturedChanges.pop_front();
+            
+            if(data->failedChanges.erase(changeID) > 0)
+            {
+                logMessage(LogSeverity::Debug, "(applyCapturedChanges) > Write <" + Convert::toString(changeID) + "> failed on the source and was discarded.");
+                continue;
+            }
+        }
+        
+        switch(currentChange.getType())
+        {
+            case DatabaseRequestType::INSERT:
+            case DatabaseRequestType::UPDATE:
+            {
+                DBObjectID objectID = currentChange.getContainer()->getContainerID();
+                DatabaseRequestType requestType =
+                        (data->copiedObjects.insert(objectID).second) ? DatabaseRequestType::INSERT : DatabaseRequestType::UPDATE;
+                
+                if(!sendWrite(data, PendingWrite{DatabaseRequest(requestType, DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, currentChange.getContainer()), false, 0}))
+                    return false;
+            } break;
+            
+            case DatabaseRequestType::REMOVE:
+            {
+                if(data->copiedObjects.erase(currentChange.getObjectID()) > 0
+                   && !sendWrite(data, PendingWrite{DatabaseRequest(DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, currentChange.getObjectID()), false, 0}))
+                {
+                    return false;
+                }
+            } break;
+            
+            default: logMessage(LogSeverity::Error, "(applyCapturedChanges) > Unexpected request type encountered."); break;
+        }
+        
+        boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+        data->changesApplied++;
+    }
+    
+    return false;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALMigrator::performCutover(MigrationData * data)
+{
+    {
+        boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+        if(data->failedWrites > 0)
+        {
+            logMessage(LogSeverity::Error, "(performCutover) > <" + Convert::toString(data->failedWrites) 
+                    + "> writes failed for type <" + Convert::toString(data->sourceDAL->getType()) + ">; cutover aborted.");
+            return false;
+        }
+    }
+    
+    if(!data->queue->suspendDispatch(migratorParams.cutoverTimeout))
+    {
+        logMessage(LogSeverity::Error, "(performCutover) > Failed to suspend queue dispatching for type <" + Convert::toString(data->sourceDAL->getType()) + ">.");
+        return false;
+    }
+    
+    //no more writes are dispatched by the queue; the remaining captured changes are final
+    bool successful = applyCapturedChanges(data) && waitForPendingWrites(data, 0);
+    
+    {
+        boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+        successful = successful && (data->failedWrites == 0) && data->capturedChanges.empty();
+    }
+    
+    if(successful)
+        successful = data->queue->replaceDAL(data->sourceDAL, data->targetDAL);
+    else
+        logMessage(LogSeverity::Error, "(performCutover) > Target DAL is not consistent with the source for type <" + Convert::toString(data->sourceDAL->getType()) + ">.");
+    
+    data->queue->resumeDispatch();
+    return successful;
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::setPhase(MigrationData * data, DALMigrationPhase phase)
+{
+    boost::lock_guard<boost::mutex> migratorLock(migratorMutex);
+    
+    {
+        boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+        data->phase = phase;
+    }
+    
+    logMessage(LogSeverity::Debug, "(setPhase) > Migration for type <" + Convert::toString(data->sourceDAL->getType())
+            + "> moved to phase <" + Convert::toString(phase) + ">.");
+    
+    saveCheckpoint();
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::loadCheckpoint()
+{
+    if(migratorParams.checkpointFilePath.empty())
+        return;
+    
+    std::ifstream checkpointFile(migratorParams.checkpointFilePath);
+    if(!checkpointFile.is_open())
+        return;
+    
+    std::string currentLine;
+    while(std::getline(checkpointFile, currentLine))
+    {
+        std::istringstream lineStream(currentLine);
+        std::string typeString, phaseString;
+        
+        if(!(lineStream >> typeString >> phaseString))
+            continue;
+        
+        DatabaseObjectType objectType = Convert::toDatabaseObjectType(typeString);
+        DALMigrationPhase phase = Convert::toDALMigrationPhase(phaseString);
+        
+        if(objectType != DatabaseObjectType::INVALID && phase != DALMigrationPhase::INVALID)
+            checkpointPhases[objectType] = phase;
+    }
+    
+    logMessage(LogSeverity::Debug, "(loadCheckpoint) > <" + Convert::toString(checkpointPhases.size()) + "> entries loaded.");
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::saveCheckpoint() const
+{
+    if(migratorParams.checkpointFilePath.empty())
+        return;
+    
+    std::string temporaryFilePath = migratorParams.checkpointFilePath + ".tmp";
+    std::ofstream checkpointFile(temporaryFilePath, std::ios::trunc);
+    if(!checkpointFile.is_open())
+    {
+        logMessage(LogSeverity::Error, "(saveCheckpoint) > Failed to open temporary checkpoint file <" + temporaryFilePath + ">.");
+        return;
+    }
+    
+    for(auto currentMigration : migrations)
+    {
+        DALMigrationPhase phase;
+        unsigned long objectsCopied = 0;
+        
+        {
+            boost::lock_guard<boost::mutex> dataLock(currentMigration.second->dataMutex);
+            phase = currentMigration.second->phase;
+            objectsCopied = currentMigration.second->objectsCopied;
+        }
+        
+        checkpointFile << Convert::toString(currentMigration.first) << " " << Convert::toString(phase) << " " << objectsCopied << std::endl;
+    }
+    
+    checkpointFile.close();
+    if(checkpointFile.fail())
+    {
+        logMessage(LogSeverity::Error, "(saveCheckpoint) > Failed to write temporary checkpoint file <" + temporaryFilePath + ">.");
+        std::remove(temporaryFilePath.c_str());
+        return;
+    }
+    
+    if(std::rename(temporaryFilePath.c_str(), migratorParams.checkpointFilePath.c_str()) != 0)
+    {
+        logMessage(LogSeverity::Error, "(saveCheckpoint) > Failed to replace checkpoint file <" + migratorParams.checkpointFilePath + ">.");
+        std::remove(temporaryFilePath.c_str());
+    }
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::onSourceWriteCompletedHandler
+(MigrationData * data, DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, bool successful)
+{
+    if(dalID != data->sourceDAL->getID())
+        return;
+    
+    boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+    
+    if(data->unconfirmedChanges.erase(requestID) == 0)
+        return; //the write was dispatched before the capture started
+    
+    if(!successful)
+        data->failedChanges.insert(requestID);
+    
+    data->writesCondition.notify_all();
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::onTargetSuccessHandler(MigrationData * data, DatabaseRequestID requestID)
+{
+    boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+    
+    auto pendingWrite = data->pendingWrites.find(requestID);
+    if(pendingWrite == data->pendingWrites.end())
+    {
+        logMessage(LogSeverity::Error, "(onTargetSuccessHandler) > Unexpected response received for request <" + Convert::toString(requestID) + ">.");
+        return;
+    }
+    
+    data->pendingObjects.erase(getWriteObjectID(pendingWrite->second.request));
+    data->pendingWrites.erase(pendingWrite);
+    data->writesCondition.notify_all();
+}
+
+void SyncServer_Core::DatabaseManagement::DALMigrator::onTargetFailureHandler(MigrationData * data, DatabaseRequestID requestID)
+{
+    boost::lock_guard<boost::mutex> dataLock(data->dataMutex);
+    
+    auto pendingWrite = data->pendingWrites.find(requestID);
+    if(pendingWrite == data->pendingWrites.end())
+    {
+        logMessage(LogSeverity::Error, "(onTargetFailureHandler) > Unexpected response received for request <" + Convert::toString(requestID) + ">.");
+        return;
+    }
+    
+    const DatabaseRequest & failedRequest = pendingWrite->second.request;
+    unsigned long sequence = pendingWrite->second.sequence;
+    DBObjectID objectID = getWriteObjectID(failedRequest);
+    data->pendingObjects.erase(objectID);
+    
+    //the target may or may not hold the object already; the write is attempted once more with the alternate type
+    if(data->latestWrites[objectID] != sequence)
+        logMessage(LogSeverity::Debug, "(onTargetFailureHandler) > Write for request <" + Convert::toString(requestID) + "> was superseded by a newer write.");
+    else if(!pendingWrite->second.isRetry && failedRequest.getType() == DatabaseRequestType::INSERT)
+        data->retryWrites.push_back(PendingWrite{DatabaseRequest(DatabaseRequestType::UPDATE, requestID, failedRequest.getContainer()), true, sequence});
+    else if(!pendingWrite->second.isRetry && failedRequest.getType() == DatabaseRequestType::UPDATE)
+        data->retryWrites.push_back(PendingWrite{DatabaseRequest(DatabaseRequestType::INSERT, requestID, failedRequest.getContainer()), true, sequence});
+    else
+    {
+        data->failedWrites++;
+        logMessage(LogSeverity::Error, "(onTargetFailureHandler) > Write failed for request <" + Convert::toString(requestID) + ">.");
+    }
+    
+    data->pendingWrites.erase(pendingWrite);
+    data->writesCondition.notify_all();
+}
@@ -18,16 +18,342 @@
 #ifndef DALMIGRATOR_H
 #define	DALMIGRATOR_H
 
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "Types/Types.h"
+#include "Types/DatabaseRequest.h"
+#include "../Utilities/FileLogger.h"
+#include "../Utilities/Strings/Common.h"
+#include "../Utilities/Strings/Database.h"
+#include "Containers/DataContainer.h"
+#include "Interfaces/DatabaseAbstractionLayer.h"
+#include "DALQueue.h"
+#include "DatabaseManager.h"
+
+namespace Convert = Utilities::Strings;
+
+using boost::unordered::unordered_map;
+using boost::unordered::unordered_set;
+
+using std::deque;
+using std::vector;
+using DatabaseManagement_Interfaces::DALPtr;
+
+using Common_Types::DBObjectID;
+using DatabaseManagement_Types::DALMigrationPhase;
+using DatabaseManagement_Types::DatabaseObjectType;
+using DatabaseManagement_Types::DatabaseRequest;
+using DatabaseManagement_Types::DatabaseRequestID;
+using DatabaseManagement_Types::DatabaseRequestType;
+using DatabaseManagement_Types::DatabaseAbstractionLayerID;
+using DatabaseManagement_Containers::DataContainerPtr;
+
 namespace SyncServer_Core
 {
     namespace DatabaseManagement
     {
+        /**
+         * Class for moving data from one DAL to another, while the server is running.
+         *
+         * Each migration copies all objects of a single type from a DAL managed by a <code>DatabaseManager</code>
+         * (source) to a new DAL (target) and then replaces the source with the target. All migrations run in parallel,
+         * each in its own thread, and go through the following phases:
+         * - SNAPSHOT -> all objects are retrieved through the queue of the manager and are written to the target;
+         * writes sent to the source by the queue are captured from the start of the phase;
+         * - CATCH_UP -> captured writes are applied to the target, in dispatch order and only after the source
+         * has confirmed them (writes the source failed are discarded), until only a few of them are left;
+         * - CUTOVER -> the queue stops dispatching new requests, the remaining writes are applied and
+         * the source is replaced by the target.
+         *
+         * If a migration fails or is stopped, the source remains in use and the queue is not affected.
+         *
+         * Writes to the target are kept in order for each object: a write is not sent while an earlier write
+         * for the same object is still pending and a retry of a failed write is discarded once a newer write
+         * for the same object has been sent.
+         *
+         * Note: The snapshot is taken through the read path of the queue, so the source is expected to
+         * hold the same data as the DAL(s) serving reads for the queue (always the case in PRPW mode
+         * and with a single DAL per queue).
+         */
         class DALMigrator
         {
+            public:
+                /** Parameters structure for holding <code>DALMigrator</code> configuration data. */
+                struct DALMigratorParameters
+                {
+                    /** Maximum number of objects retrieved with a single snapshot request (0 = all objects are retrieved with one request). */
+                    unsigned long snapshotPageSize;
+                    /** Maximum number of writes sent to a target DAL that are still waiting for a response. */
+                    unsigned long maximumPendingWrites;
+                    /** Maximum number of captured writes still to be applied before a cutover is attempted. */
+                    unsigned long maximumCutoverBacklog;
+                    /** Maximum amount of time to wait for the pending requests of a queue to be completed during cutover (in ms). */
+                    unsigned long cutoverTimeout;
+                    /** Maximum number of cutover attempts before a migration is considered as failed. */
+                    unsigned int maximumCutoverAttempts;
+                    /** Path to the file used for saving the progress of all migrations (empty = progress is not saved). */
+                    std::string checkpointFilePath;
+                };
+                
+                /** Information structure for holding the progress of a single migration. */
+                struct MigrationProgress
+                {
+                    DatabaseObjectType objectType;
+                    DALMigrationPhase phase;
+                    unsigned long objectsCopied;        //number of objects written to the target during the snapshot
+                    unsigned long changesCaptured;      //number of writes captured from the queue
+                    unsigned long changesApplied;       //number of captured writes applied to the target
+                    unsigned long failedWrites;         //number of writes the target could not complete
+                    double writesPerSecond;             //average number of objects and changes written to the target per second
+                };
+                
+                /**
+                 * Creates a new migrator.
+                 *
+                 * Note: A checkpoint file left by a previous migrator is loaded, if one exists;
+                 * migrations for object types that were already completed are skipped.
+                 *
+                 * @param manager the database manager that owns the source DALs
+                 * @param parentLogger logger to be used for debugging
+                 * @param parameters migrator configuration
+                 */
+                DALMigrator(DatabaseManager & manager, Utilities::FileLoggerPtr parentLogger, DALMigratorParameters parameters);
+                
+                /**
+                 * Stops all running migrations and waits for their threads to terminate.
+                 */
+                ~DALMigrator();
+                
+                DALMigrator() = delete;                                 //No default constructor
+                DALMigrator(const DALMigrator&) = delete;               //Copy not allowed (pass/access only by reference/pointer)
+                DALMigrator& operator=(const DALMigrator&) = delete;    //Copy not allowed (pass/access only by reference/pointer)
+                
+                /**
+                 * Adds a new migration.
+                 *
+                 * Note: Only one migration per object type is allowed and migrations
+                 * cannot be added after they have been started.
+                 *
+                 * @param sourceDAL the DAL to be replaced (must be managed by the database manager)
+                 * @param targetDAL the DAL to receive the data (must not be connected or added to any queue)
+                 * @return <code>true</code>, if the migration was added
+                 */
+                bool addMigration(DALPtr sourceDAL, DALPtr targetDAL);
+                
+                /**
+                 * Starts all migrations.
+                 *
+                 * @return <code>true</code>, if the migrations were started
+                 */
+                bool startMigrations();
+                
+                /**
+                 * Requests all running migrations to stop.
+                 *
+                 * Note: Migrations that are already in the final stage of their cutover are completed.
+                 */
+                void stopMigrations();
+                
+                /**
+                 * Waits for all migrations to finish.
+                 *
+                 * @return <code>true</code>, if all migrations were completed successfully
+                 */
+                bool waitForMigrations();
+                
+                /**
+                 * Retrieves the current progress of all migrations.
+                 *
+                 * @return the requested data
+                 */
+                vector<MigrationProgress> getProgress() const;
             
+            private:
+                /** Structure for holding a write sent to a target DAL. */
+                struct PendingWrite
+                {
+                    DatabaseRequest request;    //the write request
+                    bool isRetry;               //denotes whether the request is a retry of a failed write
+                    unsigned long sequence;     //position of the write in the sequence of writes sent to the target (retries keep the original value)
+                };
+                
+                /** Structure for holding the data associated with a single migration. */
+                struct MigrationData
+                {
+                    MigrationData(DALPtr source, DALPtr target, DALQueue * dalQueue)
+                    : sourceDAL(source), targetDAL(target), queue(dalQueue)
+                    {}
+                    
+                    DALPtr sourceDAL;                                       //the DAL to be replaced
+                    DALPtr targetDAL;                                       //the DAL to receive the data
+                    DALQueue * queue;                                       //the queue holding the source DAL
+                    boost::thread * thread = nullptr;                       //the migration thread
+                    bool isResumed = false;                                 //denotes whether the target may hold data from an earlier attempt
+                    boost::posix_time::ptime startTime;                     //time at which the migration was started
+                    
+                    mutable boost::mutex dataMutex;                         //mutex for synchronising access to all fields below
+                    boost::condition_variable writesCondition;              //condition variable for waiting on target responses
+                    DALMigrationPhase phase = DALMigrationPhase::PENDING;   //current migration phase
+                    unsigned long objectsCopied = 0;                        //number of objects written to the target during the snapshot
+                    unsigned long changesCaptured = 0;                      //number of writes captured from the queue
+                    unsigned long changesApplied = 0;                       //number of captured writes applied to the target
+                    unsigned long failedWrites = 0;                         //number of writes the target could not complete
+                    deque<DatabaseRequest> capturedChanges;                 //writes captured from the queue, waiting to be applied
+                    unordered_set<DatabaseRequestID> unconfirmedChanges;    //captured writes still waiting for a response from the source
+                    unordered_set<DatabaseRequestID> failedChanges;         //captured writes that the source did not complete
+                    DatabaseRequestID nextRequestID = 1;                    //ID that will be assigned to the next target request
+                    unordered_map<DatabaseRequestID, PendingWrite> pendingWrites; //writes waiting for a response from the target
+                    deque<PendingWrite> retryWrites;                        //failed writes to be sent again with the alternate request type
+                    unsigned long nextWriteSequence = 1;                    //sequence number that will be assigned to the next write
+                    unordered_map<DBObjectID, unsigned long> latestWrites;  //object ID -> sequence number of the latest write for the object
+                    unordered_set<DBObjectID> pendingObjects;               //IDs of all objects with a write pending on the target
+                    
+                    unordered_set<DBObjectID> copiedObjects;                //IDs of all objects present in the target (migration thread only)
+                };
+                
+                DatabaseManager & databaseManager;                          //the manager holding the source DALs
+                Utilities::FileLoggerPtr debugLogger;                       //logger
+                DALMigratorParameters migratorParams;                       //migrator configuration
+                std::atomic<bool> stopMigrator {false};                     //denotes whether all migrations are to be stopped
+                bool migrationsStarted = false;                             //denotes whether the migrations were started
+                mutable boost::mutex migratorMutex;                         //mutex for synchronising access to the migrations table and the checkpoint file
+                unordered_map<DatabaseObjectType, MigrationData*> migrations; //object type -> migration data
+                unordered_map<DatabaseObjectType, DALMigrationPhase> checkpointPhases; //object type -> phase loaded from the checkpoint file
+                
+                /**
+                 * Migration thread.
+                 *
+                 * Takes a single migration through all of its phases.
+                 *
+                 * @param data the data associated with the migration
+                 */
+                void migrationThread(MigrationData * data);
+                
+                /**
+                 * Sends the specified write to the target DAL of a migration.
+                 *
+                 * Blocks while the maximum number of pending writes is reached or while
+                 * another write for the same object is pending.
+                 *
+                 * Note: Retries of writes that were superseded by a newer write for the same
+                 * object are discarded.
+                 *
+                 * @param data the data associated with the migration
+                 * @param write the write to be sent
+                 * @return <code>true</code>, if the request was submitted to the DAL (or discarded)
+                 */
+                bool sendWrite(MigrationData * data, PendingWrite write);
+                
+                /**
+                 * Waits until no more than the specified number of writes are pending on the target DAL
+                 * of a migration, while sending any retries requested in the meantime.
+                 *
+                 * @param data the data associated with the migration
+                 * @param maximumWrites the maximum number of pending writes to wait for
+                 * @return <code>true</code>, if the wait was successful; <code>false</code>, if the migrator was stopped
+                 */
+                bool waitForPendingWrites(MigrationData * data, unsigned long maximumWrites);
+                
+                /**
+                 * Applies the writes captured from the queue to the target DAL of a migration.
+                 *
+                 * Writes are applied in dispatch order and only once the source has confirmed them;
+                 * the function stops at the first write still waiting for a response from the source.
+                 * Writes that the source did not complete are discarded.
+                 *
+                 * INSERTs and UPDATEs are converted, based on the objects already present in the target,
+                 * and REMOVEs are discarded for objects that were never copied.
+                 *
+                 * @param data the data associated with the migration
+                 * @return <code>true</code>, if all writes were submitted to the DAL
+                 */
+                bool applyCapturedChanges(MigrationData * data);
+                
+                /**
+                 * Attempts to replace the source DAL of a migration with its target DAL.
+                 *
+                 * @param data the data associated with the migration
+                 * @return <code>true</code>, if the DALs were replaced
+                 */
+                bool performCutover(MigrationData * data);
+                
+                /**
+                 * Sets a new phase for the specified migration and updates the checkpoint file.
+                 *
+                 * @param data the data associated with the migration
+                 * @param phase the new phase
+                 */
+                void setPhase(MigrationData * data, DALMigrationPhase phase);
+                
+                /** Loads the phases of all migrations from the checkpoint file (if any). */
+                void loadCheckpoint();
+                
+                /**
+                 * Saves the phases of all migrations to the checkpoint file (if any).
+                 *
+                 * The data is written to a temporary file first, which then replaces the
+                 * checkpoint file, so that an interrupted save leaves the old file intact.
+                 *
+                 * Note: Expects the migrator lock to be held by the caller.
+                 */
+                void saveCheckpoint() const;
+                
+                /**
+                 * Event handler for "onWriteCompleted" signals coming from the queue holding the source DAL.
+                 *
+                 * @param data the data associated with the migration
+                 * @param dalID the ID of the DAL that completed the write
+                 * @param requestID the associated request ID
+                 * @param successful denotes whether the write was completed successfully
+                 */
+                void onSourceWriteCompletedHandler(MigrationData * data, DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, bool successful);
+                
+                /**
+                 * Retrieves the ID of the object affected by the specified write.
+                 *
+                 * @param request the write request
+                 * @return the requested ID
+                 */
+                static DBObjectID getWriteObjectID(const DatabaseRequest & request)
+                {
+                    return (request.getType() == DatabaseRequestType::REMOVE) ? request.getObjectID() : request.getContainer()->getContainerID();
+                }
+                
+                /**
+                 * Event handler for "onSuccess" signals coming from target DALs.
+                 *
+                 * @param data the data associated with the migration
+                 * @param requestID the associated request ID
+                 */
+                void onTargetSuccessHandler(MigrationData * data, DatabaseRequestID requestID);
+                
+                /**
+                 * Event handler for "onFailure" signals coming from target DALs.
+                 *
+                 * @param data the data associated with the migration
+                 * @param requestID the associated request ID
+                 */
+                void onTargetFailureHandler(MigrationData * data, DatabaseRequestID requestID);
+                
+                /**
+                 * Logs the specified message, if the log handler is set.
+                 *
+                 * @param severity the severity associated with the message/event
+                 * @param message the message to be logged
+                 */
+                void logMessage(LogSeverity severity, const std::string & message) const
+                {
+                    if(debugLogger)
+                        debugLogger->logMessage(Utilities::FileLogSeverity::Debug, "DALMigrator " + message);
+                }
         };
     }
 }
 
 #endif	/* DALMIGRATOR_H */
-
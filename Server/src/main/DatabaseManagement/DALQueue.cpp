@@ -20,7 +20,11 @@
 
 SyncServer_Core::DatabaseManagement::DALQueue::DALQueue(DatabaseObjectType type, Utilities::FileLoggerPtr parentLogger, DALQueueParameters parameters)
 : queueType(type), dbMode(parameters.dbMode), failureAction(parameters.failureAction),
-  maxConsecutiveReadFailures(parameters.maximumReadFailures), maxConsecutiveWriteFailures(parameters.maximumWriteFailures), debugLogger(parentLogger)
+  maxConsecutiveReadFailures(parameters.maximumReadFailures), maxConsecutiveWriteFailures(parameters.maximumWriteFailures), maxBatchSize(parameters.maximumBatchSize),
+  readRoutingPolicy(parameters.readRoutingPolicy), coalesceUpdates(parameters.coalesceUpdates),
+  minReconnectDelay(parameters.minimumReconnectDelay), maxReconnectDelay(parameters.maximumReconnectDelay),
+  maxSkippedWrites(parameters.maximumSkippedWrites), debugLogger(parentLogger),
+  requestsPool(REQUESTS_POOL_SIZE), newRequests(REQUESTS_QUEUE_CAPACITY)
 {
     stopQueue = false;
     mainThread = new boost::thread(&DatabaseManagement::DALQueue::mainQueueThread, this);
@@ -30,29 +34,32 @@ SyncServer_Core::DatabaseManagement::DALQueue::~DALQueue()
 {
     logMessage(LogSeverity::Debug, "(~) Destruction initiated.");
     stopQueue = true;
-    threadLockCondition.notify_all();
+    notifyMainThread();
+    notifyWaitingProducers();
     
     mainThread->join();
     delete mainThread;
     
     boost::lock_guard<boost::mutex> dataLock(threadMutex);
     
-    for(std::pair<unsigned int, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*> currentDAL : dals)
+    for(std::pair<DatabaseAbstractionLayerID, DALData*> currentDAL : dals)
     {
-        currentDAL.second->get<0>()->disconnect(); //disconnects the DAL
-        currentDAL.second->get<3>().disconnect(); //disconnects the onSuccess signal connection
-        currentDAL.second->get<4>().disconnect(); //disconnects the onFailure signal connection
+        currentDAL.second->dal->disconnect(); //disconnects the DAL
+        currentDAL.second->onSuccessConnection.disconnect(); //disconnects the onSuccess signal connection
+        currentDAL.second->onFailureConnection.disconnect(); //disconnects the onFailure signal connection
         delete currentDAL.second;
     }
     
-    for(std::pair<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*> currentRequesData : requestsData)
-        delete currentRequesData.second;
+    DatabaseRequest * currentRequest = nullptr;
+    while(newRequests.tryPop(currentRequest))
+        releaseRequest(currentRequest);
+    
+    for(auto currentRequestData : pendingRequests)
+        releaseRequest(currentRequestData.second.request);
     
     dalIDs.clear();
     dals.clear();
-    std::queue<DatabaseRequestID>().swap(newRequests);
     pendingRequests.clear();
-    requestsData.clear();
 }
 
 bool SyncServer_Core::DatabaseManagement::DALQueue::addDAL(DALPtr dal)
@@ -68,12 +75,11 @@ bool SyncServer_Core::DatabaseManagement::DALQueue::addDAL(DALPtr dal)
     {
         boost::signals2::connection onFailreConnection, onSuccessConnection;
         onSuccessConnection = dal->onSuccessEventAttach(boost::bind(&DatabaseManagement::DALQueue::onSuccessHandler, this, _1, _2, _3));
-        onFailreConnection = dal->onFailureEventAttach(boost::bind(&DatabaseManagement::DALQueue::onFailureHandler, this, _1, _2, _3));
+        onFailreConnection = dal->onFailureEventAttach(boost::bind(&DatabaseManagement::DALQueue::onFailureHandler, this, _1, _2, _3, _4));
         
-        tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection> * newDAL = 
-            new tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>(dal, 0, 0, onSuccessConnection, onFailreConnection);
+        DALData * newDAL = new DALData(dal, onSuccessConnection, onFailreConnection);
         dalIDs.push_back(nextDALID);
-        dals.insert(std::pair<DatabaseAbstractionLayerID, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*>(nextDALID, newDAL));
+        dals.insert(std::pair<DatabaseAbstractionLayerID, DALData*>(nextDALID, newDAL));
         dal->setID(nextDALID);
         dal->connect();
         nextDALID++;
@@ -109,9 +115,9 @@ bool SyncServer_Core::DatabaseManagement::DALQueue::removeDAL(const DALPtr dal)
     {
         dalIDs.erase(std::remove(dalIDs.begin(), dalIDs.end(), dalID));
         auto dalData = dals[dalID];
-        dalData->get<0>()->disconnect();//disconnects the DAL
-        dalData->get<3>().disconnect(); //disconnects the onSuccess signal connection
-        dalData->get<4>().disconnect(); //disconnects the onFailure signal connection
+        dalData->dal->disconnect();                 //disconnects the DAL
+        dalData->onSuccessConnection.disconnect();  //disconnects the onSuccess signal connection
+        dalData->onFailureConnection.disconnect();  //disconnects the onFailure signal connection
         delete dals[dalID];
         dals.erase(dalID);
         
@@ -124,6 +130,111 @@ bool SyncServer_Core::DatabaseManagement::DALQueue::removeDAL(const DALPtr dal)
     return result;
 }
 
+unsigned long SyncServer_Core::DatabaseManagement::DALQueue::dropLogsBefore(Timestamp time)
+{
+    if(stopQueue)
+        return 0;
+    
+    std::vector<DALPtr> targetDALs;
+    
+    {//the DALs are called without the data lock, as their responses may need it
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Acquiring data lock.");
+        boost::lock_guard<boost::mutex> dataLock(threadMutex);
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Acquired data lock.");
+        for(auto currentDAL : dals)
+            targetDALs.push_back(currentDAL.second->dal);
+        logMessage(LogSeverity::Debug, "(dropLogsBefore) Data lock released.");
+    }
+    
+    unsigned long droppedLogs = 0;
+    for(DALPtr currentDAL : targetDALs)
+        droppedLogs += currentDAL->dropLogsBefore(time);
+    
+    logMessage(LogSeverity::Info, "(dropLogsBefore) <" + Convert::toString(droppedLogs) + "> log(s) dropped from <" + Convert::toString(targetDALs.size()) + "> DAL(s).");
+    return droppedLogs;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALQueue::replaceDAL(const DALPtr oldDAL, DALPtr newDAL)
+{
+    if(stopQueue)
+        return false;
+    
+    logMessage(LogSeverity::Debug, "(replaceDAL) Acquiring data lock.");
+    boost::lock_guard<boost::mutex> dataLock(threadMutex);
+    logMessage(LogSeverity::Debug, "(replaceDAL) Acquired data lock.");
+    
+    DatabaseAbstractionLayerID oldDALID = oldDAL->getID();
+    auto oldDALData = dals.find(oldDALID);
+    if(oldDALData == dals.end() || oldDALData->second->dal != oldDAL)
+    {
+        logMessage(LogSeverity::Error, "(replaceDAL) The requested DatabaseAbstractionLayer was not found in the DALs table.");
+        return false;
+    }
+    
+    if(oldDALData->second->outstandingRequests > 0)
+    {
+        logMessage(LogSeverity::Error, "(replaceDAL) The requested DatabaseAbstractionLayer has <" 
+                + Convert::toString(oldDALData->second->outstandingRequests) + "> outstanding requests.");
+        return false;
+    }
+    
+    if(newDAL->getType() != queueType)
+    {
+        logMessage(LogSeverity::Error, "(replaceDAL) The new DatabaseAbstractionLayer has an unexpected type <" + Convert::toString(newDAL->getType()) + ">.");
+        return false;
+    }
+    
+    boost::signals2::connection onFailreConnection, onSuccessConnection;
+    onSuccessConnection = newDAL->onSuccessEventAttach(boost::bind(&DatabaseManagement::DALQueue::onSuccessHandler, this, _1, _2, _3));
+    onFailreConnection = newDAL->onFailureEventAttach(boost::bind(&DatabaseManagement::DALQueue::onFailureHandler, this, _1, _2, _3, _4));
+    
+    DALData * newDALData = new DALData(newDAL, onSuccessConnection, onFailreConnection);
+    dals.insert(std::pair<DatabaseAbstractionLayerID, DALData*>(nextDALID, newDALData));
+    std::replace(dalIDs.begin(), dalIDs.end(), oldDALID, nextDALID);
+    newDAL->setID(nextDALID);
+    newDAL->connect();
+    nextDALID++;
+    
+    oldDALData->second->dal->disconnect();                 //disconnects the DAL
+    oldDALData->second->onSuccessConnection.disconnect();  //disconnects the onSuccess signal connection
+    oldDALData->second->onFailureConnection.disconnect();  //disconnects the onFailure signal connection
+    delete oldDALData->second;
+    dals.erase(oldDALData);
+    
+    logMessage(LogSeverity::Debug, "(replaceDAL) DAL <" + Convert::toString(oldDALID) + "> replaced with DAL <" + Convert::toString(newDAL->getID()) + ">.");
+    return true;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALQueue::suspendDispatch(unsigned long timeout)
+{
+    if(stopQueue)
+        return false;
+    
+    dispatchSuspended = true;
+    boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(timeout);
+    
+    while(true)
+    {
+        {
+            boost::lock_guard<boost::mutex> dataLock(threadMutex);
+            if(pendingRequests.empty())
+            {
+                logMessage(LogSeverity::Debug, "(suspendDispatch) Dispatching suspended.");
+                return true;
+            }
+        }
+        
+        if(stopQueue || boost::posix_time::microsec_clock::universal_time() >= deadline)
+            break;
+        
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+    }
+    
+    logMessage(LogSeverity::Error, "(suspendDispatch) Pending requests were not completed in time; dispatching resumed.");
+    resumeDispatch();
+    return false;
+}
+
 bool SyncServer_Core::DatabaseManagement::DALQueue::setParameters(DALQueueParameters parameters)
 {
     if(stopQueue)
@@ -137,6 +248,13 @@ bool SyncServer_Core::DatabaseManagement::DALQueue::setParameters(DALQueueParame
     failureAction = parameters.failureAction;
     maxConsecutiveReadFailures = parameters.maximumReadFailures;
     maxConsecutiveWriteFailures = parameters.maximumWriteFailures;
+    maxBatchSize = parameters.maximumBatchSize;
+    readRoutingPolicy = parameters.readRoutingPolicy;
+    coalesceUpdates = parameters.coalesceUpdates;
+    minReconnectDelay = parameters.minimumReconnectDelay;
+    maxReconnectDelay = parameters.maximumReconnectDelay;
+    maxSkippedWrites = parameters.maximumSkippedWrites;
+    threadLockCondition.notify_all(); //pending reconnect attempts are rescheduled with the new delays on the next attempt
     
     logMessage(LogSeverity::Debug, "(setParameters) > Data lock released.");
     
@@ -145,7 +263,8 @@ bool SyncServer_Core::DatabaseManagement::DALQueue::setParameters(DALQueueParame
 
 SyncServer_Core::DatabaseManagement::DALQueue::DALQueueParameters SyncServer_Core::DatabaseManagement::DALQueue::getParameters()
 {
-    return DALQueueParameters{dbMode, failureAction, maxConsecutiveReadFailures, maxConsecutiveWriteFailures};
+    return DALQueueParameters{dbMode, failureAction, maxConsecutiveReadFailures, maxConsecutiveWriteFailures, maxBatchSize, readRoutingPolicy, coalesceUpdates,
+                              minReconnectDelay, maxReconnectDelay, maxSkippedWrites};
 }
 
 bool SyncServer_Core::DatabaseManagement::DALQueue::setCacheParameters(DatabaseAbstractionLayerID cacheID, DALCache::DALCacheParameters parameters)
@@ -161,7 +280,7 @@ bool SyncServer_Core::DatabaseManagement::DALQueue::setCacheParameters(DatabaseA
     
     if(dals.find(cacheID) != dals.end())
     {
-        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(dals[cacheID]->get<0>());
+        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(dals[cacheID]->dal);
         
         if(cache)
             result = cache->setParameters(parameters);
@@ -189,7 +308,7 @@ DALCache::DALCacheParameters SyncServer_Core::DatabaseManagement::DALQueue::getC
     
     if(dals.find(cacheID) != dals.end())
     {
-        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(dals[cacheID]->get<0>());
+        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(dals[cacheID]->dal);
         
         if(cache)
             result = cache->getParameters();
@@ -207,7 +326,8 @@ DALCache::DALCacheParameters SyncServer_Core::DatabaseManagement::DALQueue::getC
 SyncServer_Core::DatabaseManagement::DALQueue::DALQueueInformation SyncServer_Core::DatabaseManagement::DALQueue::getQueueInformation() const
 {
     return {totalReadFailures, totalWriteFailures, totalReadRequests, totalWriteRequests, queueType, dbMode, failureAction, dalIDs.size(),
-            maxConsecutiveReadFailures, maxConsecutiveWriteFailures, stopQueue, threadRunning, newRequests.size(), pendingRequests.size()};
+            maxConsecutiveReadFailures, maxConsecutiveWriteFailures, stopQueue, threadRunning, newRequests.getSize(), pendingRequests.size(), totalCoalescedRequests,
+            totalExpiredRequests, totalCancelledRequests};
 }
 
 std::vector<SyncServer_Core::DatabaseManagement::DALCache::DALCacheInformation> SyncServer_Core::DatabaseManagement::DALQueue::getCachesInformation() const
@@ -221,7 +341,7 @@ std::vector<SyncServer_Core::DatabaseManagement::DALCache::DALCacheInformation>
     for(DatabaseAbstractionLayerID currentID : dalIDs)
     {
         auto currentDAL = dals.at(currentID);
-        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(currentDAL->get<0>());
+        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(currentDAL->dal);
         
         if(cache)
             result.push_back(cache->getCacheInformation());
@@ -241,31 +361,129 @@ std::vector<SyncServer_Core::DatabaseManagement::DALQueue::DALInformation> SyncS
     for(DatabaseAbstractionLayerID currentID : dalIDs)
     {
         auto currentDAL = dals.at(currentID);
-        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(currentDAL->get<0>());
-        result.push_back(DALInformation(currentID, currentDAL->get<1>(), currentDAL->get<2>(), (bool)cache, queueType, currentDAL->get<0>()->getDatabaseInfo(), nullptr));
+        shared_ptr<DatabaseManagement::DALCache> cache = boost::dynamic_pointer_cast<DatabaseManagement::DALCache>(currentDAL->dal);
+        result.push_back(DALInformation(currentID, currentDAL->readFailures, currentDAL->writeFailures, currentDAL->outstandingRequests,
+                currentDAL->averageReadLatency, currentDAL->breakerState, currentDAL->reconnectAttempts, currentDAL->nextReconnectAttempt,
+                currentDAL->resyncRequired, (bool)cache, queueType, currentDAL->dal->getDatabaseInfo(), nullptr));
     }
     
     return result;
 }
 
-DatabaseRequestID SyncServer_Core::DatabaseManagement::DALQueue::addRequestToQueue(RequestType type, boost::any requestParameter, boost::any additionalParameter)
+DatabaseRequestID SyncServer_Core::DatabaseManagement::DALQueue::addRequestToQueue(DatabaseRequest * request)
 {
     if(stopQueue)
+    {
+        releaseRequest(request);
         return DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+    }
+    
+    DatabaseRequestID requestID = nextRequestID++;
+    request->setID(requestID);
+    
+    unsigned long currentTimeout = requestTimeout;
+    if(request->getDeadline().is_not_a_date_time() && currentTimeout > 0)
+        request->setDeadline(boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(currentTimeout));
+    
+    {
+        boost::lock_guard<boost::mutex> queuedLock(queuedRequestsMutex);
+        queuedRequests.insert(requestID);
+    }
+    
+    if(!newRequests.tryPush(request))
+    {
+        if(boost::this_thread::get_id() == mainThread->get_id())
+        {//the main thread cannot free space in the queue while it is waiting for it
+            logMessage(LogSeverity::Error, "(addRequestToQueue) Requests queue is full; request from main thread rejected.");
+            discardQueuedRequest(request);
+            return DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+        }
+        
+        logMessage(LogSeverity::Debug, "(addRequestToQueue) Requests queue is full; waiting for main thread.");
+        notifyMainThread();
+        
+        bool requestQueued = false;
+        boost::unique_lock<boost::mutex> spaceLock(queueSpaceMutex);
+        ++producersWaiting;
+        while(!stopQueue && !(requestQueued = newRequests.tryPush(request)))
+            queueSpaceCondition.wait(spaceLock);
+        --producersWaiting;
+        spaceLock.unlock();
+        
+        if(!requestQueued)
+        {
+            discardQueuedRequest(request);
+            return DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+        }
+    }
+    
+    //makes the new request visible before checking the state of the main thread
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    
+    if(threadWaiting)
+    {
+        logMessage(LogSeverity::Debug, "(addRequestToQueue) Sending notification to main thread.");
+        notifyMainThread();
+        logMessage(LogSeverity::Debug, "(addRequestToQueue) Notification to main thread sent.");
+    }
+
+    return requestID;
+}
+
+bool SyncServer_Core::DatabaseManagement::DALQueue::cancelRequest(DatabaseRequestID requestID)
+{
+    if(stopQueue || requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID || requestID >= nextRequestID)
+        return false;
     
-    tuple<RequestType, boost::any, boost::any> * data = new tuple<RequestType, boost::any, boost::any>(type, requestParameter, additionalParameter);
-    logMessage(LogSeverity::Debug, "(addRequestToQueue) Entering critical section.");
     boost::lock_guard<boost::mutex> dataLock(threadMutex);
-    logMessage(LogSeverity::Debug, "(addRequestToQueue) Critical section entered.");
-    newRequests.push(nextRequestID);
-    requestsData.insert(std::pair<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*>(nextRequestID, data));
-    nextRequestID++;
     
-    logMessage(LogSeverity::Debug, "(addRequestToQueue) Sending notification to main thread.");
-    threadLockCondition.notify_all();
-    logMessage(LogSeverity::Debug, "(addRequestToQueue) Notification to main thread sent.");
+    auto pendingRequest = pendingRequests.find(requestID);
+    if(pendingRequest != pendingRequests.end())
+    {
+        if(pendingRequest->second.cancelled)
+            return false;
+        
+        pendingRequest->second.cancelled = true;
+        totalCancelledRequests++;
+        logMessage(LogSeverity::Debug, "(cancelRequest) Pending request <" + Convert::toString(requestID) + "> cancelled.");
+        return true;
+    }
+    
+    if(totalCoalescedRequests > 0)
+    {//the request may have been merged into a pending UPDATE; it is completed with that request, unless removed from it
+        for(auto & currentPendingRequest : pendingRequests)
+        {
+            vector<DatabaseRequestID> & coalescedRequests = currentPendingRequest.second.coalescedRequests;
+            auto coalescedRequest = std::find(coalescedRequests.begin(), coalescedRequests.end(), requestID);
+            if(coalescedRequest != coalescedRequests.end())
+            {
+                coalescedRequests.erase(coalescedRequest);
+                totalCancelledRequests++;
+                logMessage(LogSeverity::Debug, "(cancelRequest) Request <" + Convert::toString(requestID) 
+                        + "> merged into pending request <" + Convert::toString(currentPendingRequest.first) + "> cancelled.");
+                return true;
+            }
+        }
+    }
+    
+    //the main thread holds the data lock while moving requests out of the queue, so
+    //a request that is neither pending nor queued has already been completed or merged
+    boost::lock_guard<boost::mutex> queuedLock(queuedRequestsMutex);
+    if(queuedRequests.find(requestID) == queuedRequests.end())
+        return false;
+    
+    return cancelledRequests.insert(requestID).second;
+}
 
-    return (nextRequestID - 1);
+void SyncServer_Core::DatabaseManagement::DALQueue::discardQueuedRequest(DatabaseRequest * request)
+{
+    {
+        boost::lock_guard<boost::mutex> queuedLock(queuedRequestsMutex);
+        queuedRequests.erase(request->getID());
+        cancelledRequests.erase(request->getID());
+    }
+    
+    releaseRequest(request);
 }
 
 void SyncServer_Core::DatabaseManagement::DALQueue::mainQueueThread()
@@ -273,125 +491,168 @@ void SyncServer_Core::DatabaseManagement::DALQueue::mainQueueThread()
     logMessage(LogSeverity::Debug, "(mainQueueThread) Started.");
     threadRunning = true;
     
+    std::vector<DatabaseRequest *> currentRequests;
+    std::vector<DatabaseRequestID> rejectedRequests;
+    std::vector<std::pair<DatabaseAbstractionLayerID, DatabaseRequestID>> rejectedSubmissions;
+    
     while(!stopQueue)
     {
         logMessage(LogSeverity::Debug, "(mainQueueThread) Acquiring data lock.");
         boost::unique_lock<boost::mutex> dataLock(threadMutex);
         logMessage(LogSeverity::Debug, "(mainQueueThread) Data lock acquired.");
         
+        boost::posix_time::ptime nextReconnect = processReconnects();
+        processReplays();
+        
         if(dals.size() == 0)
         {
             logMessage(LogSeverity::Error, "(mainQueueThread) No DALs found; thread will sleep until a DAL is added.");
             logMessage(LogSeverity::Debug, "(mainQueueThread) Waiting on data lock.");
+            threadWaiting = true;
             threadLockCondition.wait(dataLock);
+            threadWaiting = false;
             logMessage(LogSeverity::Debug, "(mainQueueThread) Data lock re-acquired after wait.");
         }
-        else if(newRequests.size() == 0)
+        else if(newRequests.isEmpty() || dispatchSuspended)
         {
-            logMessage(LogSeverity::Debug, "(mainQueueThread) Waiting on data lock.");
-            threadLockCondition.wait(dataLock);
-            logMessage(LogSeverity::Debug, "(mainQueueThread) Data lock re-acquired after wait.");
+            threadWaiting = true;
+            
+            //re-checks the queue after publishing the waiting state, so that a concurrent request is not missed
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if((newRequests.isEmpty() || dispatchSuspended) && !stopQueue)
+            {
+                logMessage(LogSeverity::Debug, "(mainQueueThread) Waiting on data lock.");
+                
+                if(nextReconnect.is_not_a_date_time())
+                    threadLockCondition.wait(dataLock);
+                else
+                    threadLockCondition.timed_wait(dataLock, nextReconnect); //wakes up for the next reconnect attempt
+                
+                logMessage(LogSeverity::Debug, "(mainQueueThread) Data lock re-acquired after wait.");
+            }
+            
+            threadWaiting = false;
         }
         else
         {
             if(newMode != DatabaseManagerOperationMode::INVALID)
                 dbMode = newMode;
             
-            unsigned int numberOfNewRequests = newRequests.size();
-            logMessage(LogSeverity::Debug, "(mainQueueThread) Starting work on <" + Convert::toString(numberOfNewRequests) + "> new requests.");
-            for(unsigned int i = 0; i < numberOfNewRequests; i++)
+            DatabaseRequest * currentRequest = nullptr;
+            boost::posix_time::ptime currentTime = boost::posix_time::microsec_clock::universal_time();
+            bool requestsPopped = false;
+            while((maxBatchSize == 0 || currentRequests.size() < maxBatchSize) && newRequests.tryPop(currentRequest))
+            {
+                requestsPopped = true;
+                
+                bool requestCancelled = false;
+                {
+                    boost::lock_guard<boost::mutex> queuedLock(queuedRequestsMutex);
+                    queuedRequests.erase(currentRequest->getID());
+                    requestCancelled = (!cancelledRequests.empty() && cancelledRequests.erase(currentRequest->getID()) > 0);
+                }
+                
+                if(requestCancelled)
+                {
+                    totalCancelledRequests++;
+                    releaseRequest(currentRequest);
+                }
+                else if(currentRequest->isExpired(currentTime))
+                {//the caller may still be waiting for a response (explicit deadlines)
+                    totalExpiredRequests++;
+                    rejectedRequests.push_back(currentRequest->getID());
+                    releaseRequest(currentRequest);
+                }
+                else
+                    currentRequests.push_back(currentRequest);
+            }
+            
+            if(requestsPopped)
+                notifyWaitingProducers();
+            
+            if(currentRequests.empty() && requestsPopped)
+            {//all requests were dropped
+                if(!rejectedRequests.empty())
+                {
+                    logMessage(LogSeverity::Debug, "(mainQueueThread) <" + Convert::toString(rejectedRequests.size()) + "> expired requests dropped.");
+                    dataLock.unlock();
+                    
+                    for(DatabaseRequestID currentRejectedRequest : rejectedRequests)
+                        onFailure(currentRejectedRequest, Common_Types::INVALID_OBJECT_ID, false);
+                    
+                    rejectedRequests.clear();
+                }
+                
+                continue;
+            }
+            else if(currentRequests.empty())
+            {//a producer has reserved a slot but has not finished writing the request yet
+                dataLock.unlock();
+                boost::this_thread::yield();
+                continue;
+            }
+            
+            unordered_map<DatabaseAbstractionLayerID, vector<const DatabaseRequest *>> batches;
+            unordered_map<DatabaseRequestID, vector<DatabaseRequestID>> coalescedRequests;
+            boost::posix_time::ptime dispatchTime = boost::posix_time::microsec_clock::universal_time();
+            
+            if(coalesceUpdates && currentRequests.size() > 1)
+                coalesceUpdateRequests(currentRequests, coalescedRequests);
+            
+            //DALs with closed breakers receive requests as usual; half-open DALs only receive probes (or their missed writes)
+            vector<DatabaseAbstractionLayerID> availableDALs;
+            vector<DatabaseAbstractionLayerID> probeDALs;
+            for(DatabaseAbstractionLayerID currentDAL : dalIDs)
             {
-                logMessage(LogSeverity::Debug, "(mainQueueThread) Working with request <" + Convert::toString(i) + ">.");
-                DatabaseRequestID currentRequest = newRequests.front();
-                tuple<RequestType, boost::any, boost::any> * currentRequestData = requestsData[currentRequest];
+                DALData * currentDALData = dals[currentDAL];
+                if(currentDALData->breakerState == DALBreakerState::CLOSED)
+                    availableDALs.push_back(currentDAL);
+                else if(currentDALData->breakerState == DALBreakerState::HALF_OPEN
+                        && currentDALData->probeRequest == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID
+                        && currentDALData->skippedWrites.empty() && currentDALData->pendingReplays == 0)
+                    probeDALs.push_back(currentDAL);
+            }
+            
+            logMessage(LogSeverity::Debug, "(mainQueueThread) Starting work on <" + Convert::toString(currentRequests.size()) + "> new requests.");
+            for(DatabaseRequest * currentRequestData : currentRequests)
+            {
+                if(currentRequestData == nullptr) //merged into another request
+                    continue;
+                
+                DatabaseRequestID currentRequest = currentRequestData->getID();
+                logMessage(LogSeverity::Debug, "(mainQueueThread) Working with request <" + Convert::toString(currentRequest) + ">.");
                 vector<DatabaseAbstractionLayerID> pendingDALs;
                 
-                switch(currentRequestData->get<0>())
+                switch(currentRequestData->getType())
                 {
-                    case RequestType::SELECT:
+                    case DatabaseRequestType::SELECT:
                     {
-                        //sends to the first DAL in the queue only
-                        if(dbMode == DatabaseManagerOperationMode::PRCW || dbMode == DatabaseManagerOperationMode::PRPW)
-                        {
-                            //get DAL tuple -> gets the DAL -> calls getObject on the DAL
-                            dals[dalIDs.front()]->get<0>()->getObject(currentRequest, currentRequestData->get<1>(), currentRequestData->get<2>());
-                            pendingDALs.push_back(dalIDs.front());
-                        }
-                        else if(dbMode == DatabaseManagerOperationMode::CRCW) //sends to all DALs in the queue, from first to last
-                        {
-                            for(std::pair<DatabaseAbstractionLayerID, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*> currentDAL : dals)
-                            {
-                                currentDAL.second->get<0>()->getObject(currentRequest, currentRequestData->get<1>(), currentRequestData->get<2>());
-                                pendingDALs.push_back(currentDAL.first);
-                            }
-                        }
+                        if(availableDALs.empty())
+                            break;
+                        
+                        if(dbMode == DatabaseManagerOperationMode::PRPW) //only the first DAL receives writes; reads cannot be sent anywhere else
+                            pendingDALs.push_back(availableDALs.front());
+                        else if(dbMode == DatabaseManagerOperationMode::CRCW && readRoutingPolicy == DatabaseReadRoutingPolicy::FIRST)
+                            pendingDALs.assign(availableDALs.begin(), availableDALs.end()); //sends to all DALs in the queue, from first to last
+                        else if(dbMode == DatabaseManagerOperationMode::PRCW || dbMode == DatabaseManagerOperationMode::CRCW)
+                            pendingDALs.push_back(selectReadDAL(availableDALs)); //all DALs hold the same data; sends to one DAL, based on the routing policy
                         else
-                        {
                             logMessage(LogSeverity::Error, "(mainQueueThread) Unexpected DB operation mode encountered on SELECT request.");
-                        }
                     } break;
                     
-                    case RequestType::INSERT:
+                    case DatabaseRequestType::INSERT:
+                    case DatabaseRequestType::UPDATE:
+                    case DatabaseRequestType::REMOVE:
                     {
-                        if(dbMode == DatabaseManagerOperationMode::PRCW || dbMode == DatabaseManagerOperationMode::CRCW)
-                        {
-                            for(std::pair<DatabaseAbstractionLayerID, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*> currentDAL : dals)
-                            {
-                                currentDAL.second->get<0>()->putObject(currentRequest, boost::any_cast<DataContainerPtr>(currentRequestData->get<1>()));
-                                pendingDALs.push_back(currentDAL.first);
-                            }
-                        }
-                        else if(dbMode == DatabaseManagerOperationMode::PRPW)
-                        {
-                            dals[dalIDs.front()]->get<0>()->putObject(currentRequest, boost::any_cast<DataContainerPtr>(currentRequestData->get<1>()));
-                            pendingDALs.push_back(dalIDs.front());
-                        }
-                        else
-                        {
-                            logMessage(LogSeverity::Error, "(mainQueueThread) Unexpected DB operation mode encountered on INSERT request.");
-                        }
-                    } break;
+                        if(availableDALs.empty())
+                            break;
                         
-                    case RequestType::UPDATE:
-                    {
                         if(dbMode == DatabaseManagerOperationMode::PRCW || dbMode == DatabaseManagerOperationMode::CRCW)
-                        {
-                            for(std::pair<DatabaseAbstractionLayerID, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*> currentDAL : dals)
-                            {
-                                currentDAL.second->get<0>()->updateObject(currentRequest, boost::any_cast<DataContainerPtr>(currentRequestData->get<1>()));
-                                pendingDALs.push_back(currentDAL.first);
-                            }
-                        }
-                        else if(dbMode == DatabaseManagerOperationMode::PRPW)
-                        {
-                            dals[dalIDs.front()]->get<0>()->updateObject(currentRequest, boost::any_cast<DataContainerPtr>(currentRequestData->get<1>()));
-                            pendingDALs.push_back(dalIDs.front());
-                        }
-                        else
-                        {
-                            logMessage(LogSeverity::Error, "(mainQueueThread) Unexpected DB operation mode encountered on UPDATE request.");
-                        }
-                    } break;
-                    
-                    case RequestType::REMOVE:
-                    {
-                        if(dbMode == DatabaseManagerOperationMode::PRCW || dbMode == DatabaseManagerOperationMode::CRCW)
-                        {
-                            for(std::pair<DatabaseAbstractionLayerID, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*> currentDAL : dals)
-                            {
-                                currentDAL.second->get<0>()->removeObject(currentRequest, boost::any_cast<DBObjectID>(currentRequestData->get<1>()));
-                                pendingDALs.push_back(currentDAL.first);
-                            }
-                        }
+                            pendingDALs.assign(availableDALs.begin(), availableDALs.end());
                         else if(dbMode == DatabaseManagerOperationMode::PRPW)
-                        {
-                            dals[dalIDs.front()]->get<0>()->removeObject(currentRequest, boost::any_cast<DBObjectID>(currentRequestData->get<1>()));
-                            pendingDALs.push_back(dalIDs.front());
-                        }
+                            pendingDALs.push_back(availableDALs.front());
                         else
-                        {
-                            logMessage(LogSeverity::Error, "(mainQueueThread) Unexpected DB operation mode encountered on DELETE request.");
-                        }
+                            logMessage(LogSeverity::Error, "(mainQueueThread) Unexpected DB operation mode encountered on INSERT/UPDATE/REMOVE request.");
                     } break;
                     
                     default:
@@ -400,13 +661,112 @@ void SyncServer_Core::DatabaseManagement::DALQueue::mainQueueThread()
                     } break;
                 }
                 
-                pendingRequests.insert(std::pair<DatabaseRequestID, vector<DatabaseAbstractionLayerID>>(currentRequest, pendingDALs));
-                newRequests.pop();
+                //SELECTs are sent to half-open DALs as probes, in addition to the selected DALs (the first successful response is forwarded);
+                //other requests are only used as probes when no other DAL is available
+                if(!probeDALs.empty() && (currentRequestData->getType() == DatabaseRequestType::SELECT || availableDALs.empty()))
+                {
+                    for(DatabaseAbstractionLayerID currentDAL : probeDALs)
+                    {
+                        dals[currentDAL]->probeRequest = currentRequest;
+                        pendingDALs.push_back(currentDAL);
+                        logMessage(LogSeverity::Debug, "(mainQueueThread) Request <" + Convert::toString(currentRequest) 
+                                + "> sent as probe to DAL <" + Convert::toString(currentDAL) + ">.");
+                    }
+                    
+                    probeDALs.clear();
+                }
+                
+                auto currentCoalescedRequests = coalescedRequests.find(currentRequest);
                 
-                logMessage(LogSeverity::Debug, "(mainQueueThread) Done with request <" + Convert::toString(i) + ">.");
+                if(pendingDALs.empty())
+                {
+                    logMessage(LogSeverity::Error, "(mainQueueThread) No DAL is available for request <" + Convert::toString(currentRequest) + ">.");
+                    
+                    rejectedRequests.push_back(currentRequest);
+                    if(currentCoalescedRequests != coalescedRequests.end())
+                        rejectedRequests.insert(rejectedRequests.end(), currentCoalescedRequests->second.begin(), currentCoalescedRequests->second.end());
+                    
+                    releaseRequest(currentRequestData);
+                    continue;
+                }
+                
+                for(DatabaseAbstractionLayerID currentDAL : pendingDALs)
+                {
+                    batches[currentDAL].push_back(currentRequestData);
+                    dals[currentDAL]->outstandingRequests++;
+                }
+                
+                //writes are kept for the DALs that would have received them, if their breakers were closed
+                if(currentRequestData->getType() != DatabaseRequestType::SELECT && failureAction == DatabaseFailureAction::INITIATE_RECONNECT)
+                {
+                    for(DatabaseAbstractionLayerID currentDAL : dalIDs)
+                    {
+                        if(dbMode == DatabaseManagerOperationMode::PRPW && currentDAL != dalIDs.front())
+                            break;
+                        
+                        DALData * currentDALData = dals[currentDAL];
+                        if(currentDALData->breakerState != DALBreakerState::CLOSED && !currentDALData->resyncRequired
+                           && std::find(pendingDALs.begin(), pendingDALs.end(), currentDAL) == pendingDALs.end())
+                        {
+                            currentDALData->skippedWrites.push_back(*currentRequestData);
+                            
+                            if(maxSkippedWrites > 0 && currentDALData->skippedWrites.size() > maxSkippedWrites)
+                                requireResync(currentDAL, currentDALData);
+                        }
+                    }
+                }
+                
+                if(currentRequestData->getType() != DatabaseRequestType::SELECT)
+                    onWriteDispatched(*currentRequestData, pendingDALs);
+                
+                auto newPendingRequest = pendingRequests.insert(std::pair<DatabaseRequestID, PendingRequestData>(
+                        currentRequest, PendingRequestData{currentRequestData, pendingDALs, dispatchTime, false, vector<DatabaseRequestID>(), false, true, false}));
+                
+                if(currentCoalescedRequests != coalescedRequests.end())
+                    newPendingRequest.first->second.coalescedRequests.swap(currentCoalescedRequests->second);
+                
+                logMessage(LogSeverity::Debug, "(mainQueueThread) Done with request <" + Convert::toString(currentRequest) + ">.");
+            }
+            
+            currentRequests.clear();
+            
+            //sends one batch to each affected DAL, in queue order
+            for(DatabaseAbstractionLayerID currentDAL : dalIDs)
+            {
+                auto currentBatch = batches.find(currentDAL);
+                if(currentBatch == batches.end())
+                    continue;
+                
+                logMessage(LogSeverity::Debug, "(mainQueueThread) Sending batch of <" + Convert::toString(currentBatch->second.size()) 
+                        + "> requests to DAL <" + Convert::toString(currentDAL) + ">.");
+                
+                vector<const DatabaseRequest *> rejectedBatchRequests;
+                if(!dals[currentDAL]->dal->processBatch(currentBatch->second, rejectedBatchRequests))
+                {
+                    logMessage(LogSeverity::Error, "(mainQueueThread) <" + Convert::toString(rejectedBatchRequests.size()) 
+                            + "> request(s) in the batch for DAL <" + Convert::toString(currentDAL) + "> could not be submitted.");
+                    
+                    for(const DatabaseRequest * currentRejectedRequest : rejectedBatchRequests)
+                        rejectedSubmissions.push_back(std::pair<DatabaseAbstractionLayerID, DatabaseRequestID>(currentDAL, currentRejectedRequest->getID()));
+                }
             }
             
             logMessage(LogSeverity::Debug, "(mainQueueThread) Work on new requests finished.");
+            
+            if(!rejectedRequests.empty() || !rejectedSubmissions.empty())
+            {//the failures are signalled without holding the data lock
+                dataLock.unlock();
+                
+                for(DatabaseRequestID currentRequest : rejectedRequests)
+                    onFailure(currentRequest, Common_Types::INVALID_OBJECT_ID, false);
+                
+                //requests that were not accepted by a DAL are handled as failures of that DAL
+                for(const std::pair<DatabaseAbstractionLayerID, DatabaseRequestID> & currentSubmission : rejectedSubmissions)
+                    onFailureHandler(currentSubmission.first, currentSubmission.second, Common_Types::INVALID_OBJECT_ID, false);
+                
+                rejectedRequests.clear();
+                rejectedSubmissions.clear();
+            }
         }
         
         logMessage(LogSeverity::Debug, "(mainQueueThread) Data lock released.");
@@ -417,33 +777,372 @@ void SyncServer_Core::DatabaseManagement::DALQueue::mainQueueThread()
     return;
 }
 
-void SyncServer_Core::DatabaseManagement::DALQueue::onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id)
+void SyncServer_Core::DatabaseManagement::DALQueue::coalesceUpdateRequests
+(vector<DatabaseRequest *> & requests, unordered_map<DatabaseRequestID, vector<DatabaseRequestID>> & coalescedRequests)
+{
+    unordered_map<DBObjectID, DatabaseRequest *> mergedUpdates; //object ID -> request all UPDATEs for the object are merged into
+    
+    for(DatabaseRequest * & currentRequest : requests)
+    {
+        switch(currentRequest->getType())
+        {
+            case DatabaseRequestType::UPDATE:
+            {
+                DBObjectID objectID = currentRequest->getContainer()->getContainerID();
+                auto mergedRequest = mergedUpdates.find(objectID);
+                
+                if(mergedRequest == mergedUpdates.end())
+                {
+                    mergedUpdates.insert(std::pair<DBObjectID, DatabaseRequest *>(objectID, currentRequest));
+                }
+                else
+                {//the merged request keeps its ID and position but takes the latest container
+                    DatabaseRequest * targetRequest = mergedRequest->second;
+                    boost::posix_time::ptime targetDeadline = targetRequest->getDeadline();
+                    boost::posix_time::ptime currentDeadline = currentRequest->getDeadline();
+                    *targetRequest = DatabaseRequest(DatabaseRequestType::UPDATE, targetRequest->getID(), currentRequest->getContainer());
+                    
+                    //the merged request completes all callers; it has to meet the earliest deadline
+                    if(targetDeadline.is_not_a_date_time())
+                        targetRequest->setDeadline(currentDeadline);
+                    else if(!currentDeadline.is_not_a_date_time())
+                        targetRequest->setDeadline(std::min(targetDeadline, currentDeadline));
+                    else
+                        targetRequest->setDeadline(targetDeadline);
+                    
+                    coalescedRequests[targetRequest->getID()].push_back(currentRequest->getID());
+                    totalCoalescedRequests++;
+                    
+                    releaseRequest(currentRequest);
+                    currentRequest = nullptr;
+                }
+            } break;
+            
+            //reads may depend on any of the queued UPDATEs; merging past them would let a read see a later value
+            case DatabaseRequestType::SELECT: mergedUpdates.clear(); break;
+            case DatabaseRequestType::INSERT: mergedUpdates.erase(currentRequest->getContainer()->getContainerID()); break;
+            case DatabaseRequestType::REMOVE: mergedUpdates.erase(currentRequest->getObjectID()); break;
+            default: break;
+        }
+    }
+}
+
+DatabaseAbstractionLayerID SyncServer_Core::DatabaseManagement::DALQueue::selectReadDAL(const vector<DatabaseAbstractionLayerID> & candidateDALs)
+{
+    switch(readRoutingPolicy)
+    {
+        case DatabaseReadRoutingPolicy::ROUND_ROBIN:
+        {
+            if(nextReadDALIndex >= candidateDALs.size())
+                nextReadDALIndex = 0;
+            
+            return candidateDALs[nextReadDALIndex++];
+        }
+        
+        case DatabaseReadRoutingPolicy::LEAST_OUTSTANDING:
+        {//ties are resolved in favour of the DAL closest to the front of the queue
+            DatabaseAbstractionLayerID selectedDAL = candidateDALs.front();
+            for(DatabaseAbstractionLayerID currentDAL : candidateDALs)
+            {
+                if(dals[currentDAL]->outstandingRequests < dals[selectedDAL]->outstandingRequests)
+                    selectedDAL = currentDAL;
+            }
+            
+            return selectedDAL;
+        }
+        
+        case DatabaseReadRoutingPolicy::LOWEST_LATENCY:
+        {//the average latency is scaled by the number of outstanding requests to avoid sending a whole batch to the same DAL;
+         //DALs without any latency samples yet are preferred and share the load based on their outstanding requests
+            DatabaseAbstractionLayerID selectedDAL = candidateDALs.front();
+            double selectedCost = dals[selectedDAL]->averageReadLatency * (dals[selectedDAL]->outstandingRequests + 1);
+            for(DatabaseAbstractionLayerID currentDAL : candidateDALs)
+            {
+                double currentCost = dals[currentDAL]->averageReadLatency * (dals[currentDAL]->outstandingRequests + 1);
+                if(currentCost < selectedCost
+                   || (currentCost == selectedCost && dals[currentDAL]->outstandingRequests < dals[selectedDAL]->outstandingRequests))
+                {
+                    selectedDAL = currentDAL;
+                    selectedCost = currentCost;
+                }
+            }
+            
+            return selectedDAL;
+        }
+        
+        case DatabaseReadRoutingPolicy::FIRST: return candidateDALs.front();
+        
+        default:
+        {
+            logMessage(LogSeverity::Error, "(selectReadDAL) Unexpected read routing policy encountered; using first DAL.");
+            return candidateDALs.front();
+        }
+    }
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::openBreaker(DatabaseAbstractionLayerID dalID, DALData * dalData)
+{
+    dalData->breakerState = DALBreakerState::OPEN;
+    dalData->probeRequest = DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+    dalData->readFailures = 0;
+    dalData->writeFailures = 0;
+    dalData->nextReconnectAttempt = boost::posix_time::microsec_clock::universal_time()
+                                    + boost::posix_time::milliseconds(getReconnectDelay(dalData->reconnectAttempts));
+    
+    logMessage(LogSeverity::Warning, "(openBreaker) Breaker opened for DAL <" + Convert::toString(dalID) + ">; reconnect attempt scheduled for <"
+            + boost::posix_time::to_simple_string(dalData->nextReconnectAttempt) + ">.");
+    
+    threadLockCondition.notify_all(); //the main thread recalculates its wakeup time
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::closeBreaker(DatabaseAbstractionLayerID dalID, DALData * dalData)
+{
+    dalData->breakerState = DALBreakerState::CLOSED;
+    dalData->probeRequest = DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+    dalData->reconnectAttempts = 0;
+    logMessage(LogSeverity::Info, "(closeBreaker) Breaker closed for DAL <" + Convert::toString(dalID) + ">.");
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::requireResync(DatabaseAbstractionLayerID dalID, DALData * dalData)
+{
+    dalData->resyncRequired = true;
+    dalData->skippedWrites.clear();
+    dalData->breakerState = DALBreakerState::OPEN;
+    dalData->probeRequest = DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID;
+    dalData->nextReconnectAttempt = boost::posix_time::not_a_date_time;
+    
+    logMessage(LogSeverity::Error, "(requireResync) DAL <" + Convert::toString(dalID) + "> missed more than <" + Convert::toString(maxSkippedWrites)
+            + "> write(s) while its breaker was not closed; the missed writes were dropped and the DAL requires a full resync.");
+}
+
+boost::posix_time::ptime SyncServer_Core::DatabaseManagement::DALQueue::processReconnects()
+{
+    boost::posix_time::ptime nextReconnect(boost::posix_time::not_a_date_time);
+    boost::posix_time::ptime currentTime = boost::posix_time::microsec_clock::universal_time();
+    
+    for(DatabaseAbstractionLayerID currentID : dalIDs)
+    {
+        DALData * currentDAL = dals[currentID];
+        if(currentDAL->breakerState != DALBreakerState::OPEN || currentDAL->resyncRequired)
+            continue;
+        
+        if(currentDAL->nextReconnectAttempt <= currentTime)
+        {
+            if(currentDAL->outstandingRequests > 0)
+            {//the DAL is only reconnected once it has responded to all requests sent before the breaker was opened
+                currentDAL->nextReconnectAttempt = currentTime + boost::posix_time::milliseconds(getReconnectDelay(currentDAL->reconnectAttempts));
+            }
+            else
+            {
+                currentDAL->dal->disconnect();
+                
+                if(currentDAL->dal->connect())
+                {
+                    currentDAL->breakerState = DALBreakerState::HALF_OPEN;
+                    logMessage(LogSeverity::Info, "(processReconnects) DAL <" + Convert::toString(currentID) + "> reconnected; waiting for probe request.");
+                    continue;
+                }
+                
+                currentDAL->reconnectAttempts++;
+                currentDAL->nextReconnectAttempt = currentTime + boost::posix_time::milliseconds(getReconnectDelay(currentDAL->reconnectAttempts));
+                logMessage(LogSeverity::Warning, "(processReconnects) Reconnect attempt <" + Convert::toString(currentDAL->reconnectAttempts) 
+                        + "> failed for DAL <" + Convert::toString(currentID) + ">.");
+            }
+        }
+        
+        if(nextReconnect.is_not_a_date_time() || currentDAL->nextReconnectAttempt < nextReconnect)
+            nextReconnect = currentDAL->nextReconnectAttempt;
+    }
+    
+    return nextReconnect;
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::processReplays()
+{
+    for(DatabaseAbstractionLayerID currentID : dalIDs)
+    {
+        DALData * currentDAL = dals[currentID];
+        if(currentDAL->breakerState != DALBreakerState::HALF_OPEN || currentDAL->skippedWrites.empty()
+           || currentDAL->pendingReplays > 0 || currentDAL->probeRequest != DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
+            continue;
+        
+        logMessage(LogSeverity::Info, "(processReplays) Replaying <" + Convert::toString(currentDAL->skippedWrites.size()) 
+                + "> missed write(s) on DAL <" + Convert::toString(currentID) + ">.");
+        
+        vector<const DatabaseRequest *> replayBatch;
+        boost::posix_time::ptime dispatchTime = boost::posix_time::microsec_clock::universal_time();
+        for(DatabaseRequest & currentWrite : currentDAL->skippedWrites)
+        {
+            DatabaseRequest * request = requestsPool.acquire();
+            *request = currentWrite;
+            request->setID(nextRequestID++);
+            currentWrite.setID(request->getID());
+            
+            pendingRequests.insert(std::pair<DatabaseRequestID, PendingRequestData>(request->getID(), 
+                    PendingRequestData{request, vector<DatabaseAbstractionLayerID>(1, currentID), dispatchTime, false, vector<DatabaseRequestID>(), false, false, true}));
+            
+            replayBatch.push_back(request);
+        }
+        
+        currentDAL->outstandingRequests += replayBatch.size();
+        currentDAL->pendingReplays = replayBatch.size();
+        currentDAL->replayFailed = false;
+        
+        vector<const DatabaseRequest *> rejectedReplays;
+        if(!currentDAL->dal->processBatch(replayBatch, rejectedReplays))
+        {
+            for(const DatabaseRequest * currentRejectedReplay : rejectedReplays)
+            {
+                DatabaseRequestID rejectedID = currentRejectedReplay->getID();
+                auto pendingRequest = pendingRequests.find(rejectedID);
+                updateDALLoad(currentID, pendingRequest->second);
+                releaseRequest(pendingRequest->second.request);
+                pendingRequests.erase(pendingRequest);
+                onReplayCompleted(currentID, rejectedID, false);
+            }
+        }
+    }
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::onReplayCompleted(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, bool successful)
+{
+    auto dalData = dals.find(dalID);
+    if(dalData == dals.end())
+        return;
+    
+    DALData * currentDAL = dalData->second;
+    if(successful)
+    {
+        auto replayedWrite = std::find_if(currentDAL->skippedWrites.begin(), currentDAL->skippedWrites.end(),
+                                          [&](const DatabaseRequest & currentWrite) { return currentWrite.getID() == requestID; });
+        
+        if(replayedWrite != currentDAL->skippedWrites.end())
+            currentDAL->skippedWrites.erase(replayedWrite);
+    }
+    else
+        currentDAL->replayFailed = true;
+    
+    if((currentDAL->pendingReplays > 0 && --currentDAL->pendingReplays > 0) || currentDAL->resyncRequired)
+        return;
+    
+    if(currentDAL->replayFailed)
+    {
+        logMessage(LogSeverity::Warning, "(onReplayCompleted) Replay failed for DAL <" + Convert::toString(dalID) + ">; <" 
+                + Convert::toString(currentDAL->skippedWrites.size()) + "> write(s) kept for the next attempt.");
+        
+        currentDAL->reconnectAttempts++;
+        openBreaker(dalID, currentDAL);
+    }
+    else if(currentDAL->skippedWrites.empty())
+        closeBreaker(dalID, currentDAL);
+    else
+        threadLockCondition.notify_all(); //the writes missed during the replay are sent by the main thread
+}
+
+unsigned long SyncServer_Core::DatabaseManagement::DALQueue::getReconnectDelay(unsigned int attempts) const
+{
+    unsigned long delay = minReconnectDelay;
+    for(unsigned int i = 0; i < attempts && delay < maxReconnectDelay; i++)
+        delay *= 2;
+    
+    return (delay > maxReconnectDelay) ? maxReconnectDelay : delay;
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::updateDALLoad(DatabaseAbstractionLayerID dalID, const PendingRequestData & requestData)
+{
+    auto dalData = dals.find(dalID);
+    if(dalData == dals.end())
+        return;
+    
+    if(dalData->second->outstandingRequests > 0)
+        dalData->second->outstandingRequests--;
+    
+    if(requestData.request->getType() == DatabaseRequestType::SELECT)
+    {
+        double latency = (boost::posix_time::microsec_clock::universal_time() - requestData.dispatchTime).total_microseconds() / 1000.0;
+        
+        if(dalData->second->averageReadLatency == 0.0)
+            dalData->second->averageReadLatency = latency;
+        else
+            dalData->second->averageReadLatency = READ_LATENCY_SMOOTHING_FACTOR * latency
+                                                  + (1.0 - READ_LATENCY_SMOOTHING_FACTOR) * dalData->second->averageReadLatency;
+    }
+}
+
+void SyncServer_Core::DatabaseManagement::DALQueue::onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id, bool notFound)
 {
     if(stopQueue)
         return;
     
     unsigned int readFailures = 0;
     unsigned int writeFailures = 0;
+    bool sendSignal = true;
+    bool cancelled = false;
+    bool dalFailed = true;
+    vector<DatabaseRequestID> coalescedRequests;
     
     {//ensures the locks are released as soon as they are not needed
         logMessage(LogSeverity::Debug, "(onFailureHandler) Entering critical section for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
         boost::lock_guard<boost::mutex> dataLock(threadMutex);
         logMessage(LogSeverity::Debug, "(onFailureHandler) Critical section entered for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
         
-        if(requestsData[requestID]->get<0>() == RequestType::SELECT)
+        auto pendingRequest = pendingRequests.find(requestID);
+        if(pendingRequest == pendingRequests.end())
+        {
+            logMessage(LogSeverity::Error, "(onFailureHandler) Unexpected response received for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
+            return;
+        }
+        
+        updateDALLoad(dalID, pendingRequest->second);
+        
+        if(pendingRequest->second.replay)
+        {
+            releaseRequest(pendingRequest->second.request);
+            pendingRequests.erase(pendingRequest);
+            onReplayCompleted(dalID, requestID, false);
+            return;
+        }
+        
+        if(pendingRequest->second.request->getType() == DatabaseRequestType::SELECT)
         {
             totalReadRequests++;
-            totalReadFailures++;
-            readFailures = ++(dals[dalID]->get<1>());
+            
+            if(notFound)
+            {//the DAL processed the request successfully, so it is not counted as a DAL failure
+                dalFailed = false;
+                dals[dalID]->readFailures = 0;
+            }
+            else
+            {
+                totalReadFailures++;
+                readFailures = ++(dals[dalID]->readFailures);
+                pendingRequest->second.notFound = false;
+            }
         }
         else
         {
             totalWriteRequests++;
             totalWriteFailures++;
-            writeFailures = ++(dals[dalID]->get<2>());
+            writeFailures = ++(dals[dalID]->writeFailures);
+            pendingRequest->second.notFound = false;
+            onWriteCompleted(dalID, requestID, false);
         }
         
-        if((readFailures >= maxConsecutiveReadFailures || writeFailures >= maxConsecutiveWriteFailures) && failureAction != DatabaseFailureAction::IGNORE_FAILURE)
+        DALData * dalData = dals[dalID];
+        if(!dalFailed)
+        {
+            if(dalData->breakerState == DALBreakerState::HALF_OPEN && dalData->probeRequest == requestID)
+                closeBreaker(dalID, dalData);
+        }
+        else if(dalData->breakerState != DALBreakerState::CLOSED)
+        {//failures of requests sent before the breaker was opened are ignored; a failed probe re-opens the breaker
+            if(dalData->breakerState == DALBreakerState::HALF_OPEN && dalData->probeRequest == requestID)
+            {
+                dalData->reconnectAttempts++;
+                openBreaker(dalID, dalData);
+            }
+        }
+        else if((readFailures >= maxConsecutiveReadFailures || writeFailures >= maxConsecutiveWriteFailures) && failureAction != DatabaseFailureAction::IGNORE_FAILURE)
         {
             logMessage(LogSeverity::Debug, "(onFailureHandler) Read/write failure detected during request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
             
@@ -452,8 +1151,8 @@ void SyncServer_Core::DatabaseManagement::DALQueue::onFailureHandler(DatabaseAbs
                 case DatabaseFailureAction::DROP_DAL:
                 {
                     dalIDs.erase(std::remove(dalIDs.begin(), dalIDs.end(), dalID));
-                    dals[dalID]->get<3>().disconnect();
-                    dals[dalID]->get<4>().disconnect();
+                    dals[dalID]->onSuccessConnection.disconnect();
+                    dals[dalID]->onFailureConnection.disconnect();
                     delete dals[dalID];
                     dals.erase(dalID);
                 } break;
@@ -463,8 +1162,8 @@ void SyncServer_Core::DatabaseManagement::DALQueue::onFailureHandler(DatabaseAbs
                     if(dals.size() > 1)
                     {
                         dalIDs.erase(std::remove(dalIDs.begin(), dalIDs.end(), dalID));
-                        dals[dalID]->get<3>().disconnect();
-                        dals[dalID]->get<4>().disconnect();
+                        dals[dalID]->onSuccessConnection.disconnect();
+                        dals[dalID]->onFailureConnection.disconnect();
                         delete dals[dalID];
                         dals.erase(dalID);
                     }
@@ -472,8 +1171,8 @@ void SyncServer_Core::DatabaseManagement::DALQueue::onFailureHandler(DatabaseAbs
 
                 case DatabaseFailureAction::INITIATE_RECONNECT:
                 {
-                    //TODO - implement
-                    logMessage(LogSeverity::Warning, "(onFailureHandler) INITIATE_RECONNECT failure action not implemented; request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
+                    dalData->reconnectAttempts = 0;
+                    openBreaker(dalID, dalData);
                 } break;
 
                 case DatabaseFailureAction::PUSH_TO_BACK:
@@ -492,18 +1191,36 @@ void SyncServer_Core::DatabaseManagement::DALQueue::onFailureHandler(DatabaseAbs
             }
         }
         
-        pendingRequests[requestID].erase(std::remove(pendingRequests[requestID].begin(), pendingRequests[requestID].end(), dalID));
-        if(pendingRequests[requestID].size() == 0)
-            pendingRequests.erase(requestID);
-
-        delete requestsData[requestID];
-        requestsData.erase(requestID);
+        vector<DatabaseAbstractionLayerID> & pendingDALs = pendingRequest->second.pendingDALs;
+        pendingDALs.erase(std::remove(pendingDALs.begin(), pendingDALs.end(), dalID), pendingDALs.end());
+        
+        //a SELECT sent to multiple DALs fails only if all of them fail
+        if(pendingRequest->second.request->getType() == DatabaseRequestType::SELECT)
+            sendSignal = (pendingDALs.size() == 0 && !pendingRequest->second.responseSent);
+        
+        coalescedRequests = pendingRequest->second.coalescedRequests;
+        cancelled = pendingRequest->second.cancelled;
+        notFound = pendingRequest->second.notFound;
+        
+        if(pendingDALs.size() == 0)
+        {//the request is released only after all DALs have responded
+            releaseRequest(pendingRequest->second.request);
+            pendingRequests.erase(pendingRequest);
+        }
         
         logMessage(LogSeverity::Debug, "(onFailureHandler) Exiting critical section for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
     }
     
+    if(!sendSignal)
+        return;
+    
     logMessage(LogSeverity::Debug, "(onFailureHandler) Sending signal for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
-    onFailure(requestID, id);
+    if(!cancelled)
+        onFailure(requestID, id, notFound);
+    
+    for(DatabaseRequestID currentRequest : coalescedRequests)
+        onFailure(currentRequest, id, notFound);
+    
     logMessage(LogSeverity::Debug, "(onFailureHandler) Signal sent for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
 }
 
@@ -512,33 +1229,75 @@ void SyncServer_Core::DatabaseManagement::DALQueue::onSuccessHandler(DatabaseAbs
     if(stopQueue)
         return;
     
+    bool sendSignal = true;
+    bool cancelled = false;
+    vector<DatabaseRequestID> coalescedRequests;
+    
     {
         logMessage(LogSeverity::Debug, "(onFailureHandler) Entering critical section for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
         boost::lock_guard<boost::mutex> dataLock(threadMutex);
         logMessage(LogSeverity::Debug, "(onFailureHandler) Critical section entered for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
         
-        if(requestsData[requestID]->get<0>() == RequestType::SELECT)
+        auto pendingRequest = pendingRequests.find(requestID);
+        if(pendingRequest == pendingRequests.end())
+        {
+            logMessage(LogSeverity::Error, "(onFailureHandler) Unexpected response received for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
+            return;
+        }
+        
+        updateDALLoad(dalID, pendingRequest->second);
+        
+        if(pendingRequest->second.replay)
+        {
+            releaseRequest(pendingRequest->second.request);
+            pendingRequests.erase(pendingRequest);
+            onReplayCompleted(dalID, requestID, true);
+            return;
+        }
+        
+        DALData * dalData = dals[dalID];
+        if(dalData->breakerState == DALBreakerState::HALF_OPEN && dalData->probeRequest == requestID)
+            closeBreaker(dalID, dalData);
+        
+        if(pendingRequest->second.request->getType() == DatabaseRequestType::SELECT)
         {
             totalReadRequests++;
-            dals[dalID]->get<1>() = 0;
+            dals[dalID]->readFailures = 0;
+            
+            //only the first successful response is forwarded for a SELECT sent to multiple DALs
+            sendSignal = !pendingRequest->second.responseSent;
+            pendingRequest->second.responseSent = true;
         }
         else
         {
             totalWriteRequests++;
-            dals[dalID]->get<2>() = 0;
+            dals[dalID]->writeFailures = 0;
+            onWriteCompleted(dalID, requestID, true);
         }
         
-        pendingRequests[requestID].erase(std::remove(pendingRequests[requestID].begin(), pendingRequests[requestID].end(), dalID));
-        if(pendingRequests[requestID].size() == 0)
-            pendingRequests.erase(requestID);
-
-        delete requestsData[requestID];
-        requestsData.erase(requestID);
+        coalescedRequests = pendingRequest->second.coalescedRequests;
+        cancelled = pendingRequest->second.cancelled;
+        
+        vector<DatabaseAbstractionLayerID> & pendingDALs = pendingRequest->second.pendingDALs;
+        pendingDALs.erase(std::remove(pendingDALs.begin(), pendingDALs.end(), dalID), pendingDALs.end());
+        if(pendingDALs.size() == 0)
+        {//the request is released only after all DALs have responded
+            releaseRequest(pendingRequest->second.request);
+            pendingRequests.erase(pendingRequest);
+        }
         
         logMessage(LogSeverity::Debug, "(onFailureHandler) Exiting critical section for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
     }
     
+    if(!sendSignal)
+        return;
+    
     logMessage(LogSeverity::Debug, "(onFailureHandler) Sending signal for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
-    onSuccess(requestID, data);
+    if(!cancelled)
+        onSuccess(requestID, data);
+    
+    for(DatabaseRequestID currentRequest : coalescedRequests)
+        onSuccess(currentRequest, data);
+    
     logMessage(LogSeverity::Debug, "(onFailureHandler) Signal sent for request/DAL <" + Convert::toString(requestID) + "/" + Convert::toString(dalID) + ">.");
 }
\ No newline at end of file
@@ -23,13 +23,18 @@
 #include <vector>
 #include <queue>
 #include <boost/any.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/thread.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 #include "Types/Types.h"
+#include "Types/DatabaseRequest.h"
 #include "../Utilities/Tools.h"
 #include "../Utilities/Strings/Common.h"
 #include "../Utilities/Strings/Database.h"
 #include "../Utilities/FileLogger.h"
+#include "../Utilities/ObjectPool.h"
+#include "../Utilities/BoundedQueue.h"
 #include "Containers/DataContainer.h"
 #include "Interfaces/DatabaseAbstractionLayer.h"
 
@@ -45,11 +50,16 @@ using std::deque;
 using std::queue;
 using std::vector;
 using DatabaseManagement_Interfaces::DALPtr;
+using DatabaseManagement_Interfaces::DatabaseAbstractionLayer;
 
 using Common_Types::DBObjectID;
 using DatabaseManagement_Types::DatabaseManagerOperationMode;
 using DatabaseManagement_Types::DatabaseFailureAction;
+using DatabaseManagement_Types::DatabaseReadRoutingPolicy;
+using DatabaseManagement_Types::DALBreakerState;
 using DatabaseManagement_Types::DatabaseRequestID;
+using DatabaseManagement_Types::DatabaseRequestType;
+using DatabaseManagement_Types::DatabaseRequest;
 using DatabaseManagement_Types::DatabaseAbstractionLayerID;
 using DatabaseManagement_Containers::DataContainerPtr;
 
@@ -61,6 +71,27 @@ namespace SyncServer_Core
     {
         /**
          * Class for managing DALs and database request routing.
+         * 
+         * When the failure action is <code>INITIATE_RECONNECT</code>, each DAL has a circuit breaker:
+         * - CLOSED - the DAL receives requests as usual; once the maximum number of consecutive read or
+         * write failures is reached, the breaker is opened.
+         * - OPEN - no new requests are sent to the DAL; once its outstanding requests are completed, it is
+         * reconnected, after a delay that doubles with each failed attempt (from <code>minimumReconnectDelay</code>
+         * up to <code>maximumReconnectDelay</code>). A successful reconnect moves the breaker to HALF_OPEN.
+         * - HALF_OPEN - a single request (preferably a SELECT) is sent to the DAL as a probe; the breaker is
+         * closed if the probe succeeds or opened again if it fails.
+         * 
+         * While a breaker is not CLOSED, requests are routed to the remaining DALs; requests that
+         * cannot be sent to any DAL fail immediately.
+         * 
+         * Writes that a DAL misses while its breaker is not CLOSED are kept and, once the DAL is
+         * reconnected, they are replayed in order instead of sending a probe. The breaker is closed
+         * only after all missed writes were applied, so that the DAL does not serve reads with stale
+         * data; a failed replay opens the breaker again and the remaining writes are kept for the next attempt.
+         * 
+         * If a DAL misses more than <code>maximumSkippedWrites</code> writes, they are dropped and the DAL is
+         * marked as requiring a full resync; its breaker is kept open, without any reconnect attempts, until
+         * it is replaced (for example, with a DAL resynced by a <code>DALMigrator</code>) or removed.
          */
         class DALQueue
         {
@@ -76,6 +107,18 @@ namespace SyncServer_Core
                     unsigned int maximumReadFailures;
                     /** Maximum number of allowed consecutive write failures. */
                     unsigned int maximumWriteFailures;
+                    /** Maximum number of requests sent to a DAL as a single batch (0 = no limit). */
+                    unsigned int maximumBatchSize;
+                    /** Policy for selecting the DAL that will serve a SELECT request (PRCW/CRCW modes only). */
+                    DatabaseReadRoutingPolicy readRoutingPolicy;
+                    /** Denotes whether UPDATE requests for the same object, waiting for dispatch at the same time, are merged into a single request. */
+                    bool coalesceUpdates;
+                    /** Time to wait before the first reconnect attempt for a failed DAL (in ms; INITIATE_RECONNECT only). */
+                    unsigned long minimumReconnectDelay;
+                    /** Maximum time to wait between reconnect attempts for a failed DAL (in ms; INITIATE_RECONNECT only). */
+                    unsigned long maximumReconnectDelay;
+                    /** Maximum number of missed writes kept for a DAL while its breaker is not closed (0 = no limit; INITIATE_RECONNECT only). */
+                    unsigned long maximumSkippedWrites;
                 };
                 
                 /** Information structure for holding <code>DALQueue</code> data. */
@@ -85,11 +128,14 @@ namespace SyncServer_Core
                     DALQueueInformation(unsigned int readFailures, unsigned int writeFailures, unsigned long readRequests,
                     unsigned long writeRequests, DatabaseObjectType type, DatabaseManagerOperationMode mode, DatabaseFailureAction failureAction,
                     unsigned int dalsNumber, unsigned int maxReadFailures, unsigned int maxWriteFailures, bool stop, bool running,
-                    unsigned long newRequestsNumber, unsigned long pendingRequestsNumber)
+                    unsigned long newRequestsNumber, unsigned long pendingRequestsNumber, unsigned long coalescedRequestsNumber,
+                    unsigned long expiredRequestsNumber, unsigned long cancelledRequestsNumber)
                     : totalReadFailures(readFailures), totalWriteFailures(writeFailures), totalReadRequests(readRequests),
                       totalWriteRequests(writeRequests), queueType(type), dbMode(mode), failureAction(failureAction),
                       dals(dalsNumber), maxConsecutiveReadFailures(maxReadFailures), maxConsecutiveWriteFailures(maxWriteFailures),
-                      stopQueue(stop), threadRunning(running), newRequests(newRequestsNumber), pendingRequests(pendingRequestsNumber)
+                      stopQueue(stop), threadRunning(running), newRequests(newRequestsNumber), pendingRequests(pendingRequestsNumber),
+                      totalCoalescedRequests(coalescedRequestsNumber), totalExpiredRequests(expiredRequestsNumber),
+                      totalCancelledRequests(cancelledRequestsNumber)
                     {}
                     
                     const unsigned int totalReadFailures = 0;
@@ -106,6 +152,9 @@ namespace SyncServer_Core
                     const bool threadRunning = false;
                     const unsigned long newRequests = 0;
                     const unsigned long pendingRequests = 0;
+                    const unsigned long totalCoalescedRequests = 0;
+                    const unsigned long totalExpiredRequests = 0;
+                    const unsigned long totalCancelledRequests = 0;
                 };
                 
                 /** Information structure for holding <code>DatabaseAbstractionLayer</code> data. */
@@ -113,14 +162,23 @@ namespace SyncServer_Core
                 {
                     DALInformation() {}
                     DALInformation(DatabaseAbstractionLayerID id, unsigned int readFailures, unsigned int writeFailures,
-                    bool cache, DatabaseObjectType type, const DatabaseInformationContainer * info, DatabaseSettingsContainer * settings)
-                    : dalID(id), readFailures(readFailures), writeFailures(writeFailures), isCache(cache), dalType(type),
-                      infoData(info), settingsData(settings)
+                    unsigned long outstanding, double readLatency, DALBreakerState breaker, unsigned int reconnects,
+                    boost::posix_time::ptime nextReconnect, bool resync, bool cache, DatabaseObjectType type,
+                    const DatabaseInformationContainer * info, DatabaseSettingsContainer * settings)
+                    : dalID(id), readFailures(readFailures), writeFailures(writeFailures), outstandingRequests(outstanding),
+                      averageReadLatency(readLatency), breakerState(breaker), reconnectAttempts(reconnects), nextReconnectAttempt(nextReconnect),
+                      resyncRequired(resync), isCache(cache), dalType(type), infoData(info), settingsData(settings)
                     {}
                     
                     DatabaseAbstractionLayerID dalID = 0;
                     unsigned int readFailures = 0;
                     unsigned int writeFailures = 0;
+                    unsigned long outstandingRequests = 0;  //requests sent to the DAL that are still waiting for a response
+                    double averageReadLatency = 0.0;        //moving average of the SELECT response time (in ms)
+                    DALBreakerState breakerState = DALBreakerState::INVALID;
+                    unsigned int reconnectAttempts = 0;     //failed reconnect attempts since the breaker was opened
+                    boost::posix_time::ptime nextReconnectAttempt; //time of the next reconnect attempt (OPEN breakers only)
+                    bool resyncRequired = false;            //denotes whether the DAL missed too many writes and needs a full resync
                     bool isCache = false;
                     DatabaseObjectType dalType = DatabaseObjectType::INVALID;
                     const DatabaseInformationContainer * infoData = nullptr;
@@ -152,53 +210,102 @@ namespace SyncServer_Core
                  * 
                  * @param constraintType type of constraint; it must always be selected from the enum subclasses of DatabaseManagement_Types::DatabaseSelectConstraints
                  * @param constraintParameter parameter associated with the constraint (if any)
+                 * @param offset the number of matching objects to skip (paged requests only)
+                 * @param limit the maximum number of objects to retrieve (default is 0; request is not paged)
+                 * @param deadline the time (UTC) after which the request is no longer needed (default is based on the request timeout)
                  * @return the ID assigned to the new request
                  */
-                DatabaseRequestID addSelectRequest(const boost::any constraintType, const boost::any constraintParameter)
+                DatabaseRequestID addSelectRequest(const boost::any constraintType, const boost::any constraintParameter,
+                                                   unsigned long offset = 0, unsigned long limit = 0,
+                                                   boost::posix_time::ptime deadline = boost::posix_time::not_a_date_time)
                 {
-                    return addRequestToQueue(RequestType::SELECT, constraintType, constraintParameter);
+                    DatabaseRequest * request = requestsPool.acquire();
+                    *request = DatabaseRequest(DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, constraintType, constraintParameter, offset, limit);
+                    request->setDeadline(deadline);
+                    return addRequestToQueue(request);
                 }
 
                 /**
                  * Adds a new INSERT request to the queue.
                  * 
                  * @param data the container to be inserted
+                 * @param deadline the time (UTC) after which the request is no longer needed (default is based on the request timeout)
                  * @return the ID assigned to the new request
                  */
-                DatabaseRequestID addInsertRequest(const DataContainerPtr data)
+                DatabaseRequestID addInsertRequest(const DataContainerPtr data, boost::posix_time::ptime deadline = boost::posix_time::not_a_date_time)
                 {
-                    return addRequestToQueue(RequestType::INSERT, data);
+                    DatabaseRequest * request = requestsPool.acquire();
+                    *request = DatabaseRequest(DatabaseRequestType::INSERT, DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, data);
+                    request->setDeadline(deadline);
+                    return addRequestToQueue(request);
                 }
 
                 /**
                  * Adds a new UPDATE request to the queue.
                  * 
                  * @param data the container to be updated
+                 * @param deadline the time (UTC) after which the request is no longer needed (default is based on the request timeout)
                  * @return the ID assigned to the new request
                  */
-                DatabaseRequestID addUpdateRequest(const DataContainerPtr data)
+                DatabaseRequestID addUpdateRequest(const DataContainerPtr data, boost::posix_time::ptime deadline = boost::posix_time::not_a_date_time)
                 {
-                    return addRequestToQueue(RequestType::UPDATE, data);
+                    DatabaseRequest * request = requestsPool.acquire();
+                    *request = DatabaseRequest(DatabaseRequestType::UPDATE, DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, data);
+                    request->setDeadline(deadline);
+                    return addRequestToQueue(request);
                 }
 
                 /**
                  * Adds a new DELETE request to the queue.
                  * 
                  * @param id the ID of the object to be removed
+                 * @param deadline the time (UTC) after which the request is no longer needed (default is based on the request timeout)
                  * @return the ID assigned to the new request
                  */
-                DatabaseRequestID addDeleteRequest(const DBObjectID id)
+                DatabaseRequestID addDeleteRequest(const DBObjectID id, boost::posix_time::ptime deadline = boost::posix_time::not_a_date_time)
                 {
-                    return addRequestToQueue(RequestType::REMOVE, id);
+                    DatabaseRequest * request = requestsPool.acquire();
+                    *request = DatabaseRequest(DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID, id);
+                    request->setDeadline(deadline);
+                    return addRequestToQueue(request);
                 }
+                
+                /**
+                 * Cancels the specified request.
+                 * 
+                 * Requests waiting for dispatch are dropped before they are sent to any DAL. Requests already sent to
+                 * the DALs are still completed by them, but no response is forwarded for them.
+                 * 
+                 * Note: No signal is fired for a cancelled request. UPDATE requests merged into a cancelled request are not affected
+                 * and an UPDATE request merged into another request can be cancelled on its own.
+                 * 
+                 * @param requestID the ID of the request to be cancelled
+                 * @return <code>true</code>, if the request will not be dispatched or its response will not be forwarded;
+                 * <code>false</code>, if the request ID is not valid or the request was already cancelled or completed
+                 */
+                bool cancelRequest(DatabaseRequestID requestID);
+                
+                /**
+                 * Sets the default request timeout.
+                 * 
+                 * Requests added without an explicit deadline get a deadline of (time added + timeout);
+                 * requests whose deadline passes before they are dispatched are dropped and fail.
+                 * 
+                 * @param timeout the request timeout (in ms; 0 = no deadline)
+                 */
+                void setRequestTimeout(unsigned long timeout) { requestTimeout = timeout; }
 
                 /**
                  * Attaches the specified event handler to the "onFailure" event of the queue.
                  * 
+                 * The last handler parameter is <code>true</code> only if a SELECT request was answered
+                 * by all of its DALs with "not found"; it is <code>false</code> for all other failures
+                 * (including rejected, expired and failed requests).
+                 * 
                  * @param function the handler to be attached
                  * @return the associated connection object
                  */
-                boost::signals2::connection onFailureEventAttach(std::function<void(DatabaseRequestID, DBObjectID)> function)
+                boost::signals2::connection onFailureEventAttach(std::function<void(DatabaseRequestID, DBObjectID, bool)> function)
                 {
                     return onFailure.connect(function);
                 }
@@ -213,6 +320,41 @@ namespace SyncServer_Core
                 {
                     return onSuccess.connect(function);
                 }
+                
+                /**
+                 * Attaches the specified event handler to the "onWriteDispatched" event of the queue.
+                 * 
+                 * The event is fired for every INSERT, UPDATE and REMOVE request sent to the DALs,
+                 * in dispatch order, along with the IDs of the DALs the request was sent to, and
+                 * allows changes to the data of the queue to be captured.
+                 * 
+                 * Note: The handler is called by the main queue thread while the data lock is held;
+                 * it must return quickly and must not call any other queue functions.
+                 * 
+                 * @param function the handler to be attached
+                 * @return the associated connection object
+                 */
+                boost::signals2::connection onWriteDispatchedEventAttach(std::function<void(const DatabaseRequest &, const vector<DatabaseAbstractionLayerID> &)> function)
+                {
+                    return onWriteDispatched.connect(function);
+                }
+                
+                /**
+                 * Attaches the specified event handler to the "onWriteCompleted" event of the queue.
+                 * 
+                 * The event is fired once for each DAL that responds to an INSERT, UPDATE or REMOVE request
+                 * (including DALs that did not accept the request), with the ID of the DAL and the result.
+                 * 
+                 * Note: The handler is called while the data lock is held; it must return quickly
+                 * and must not call any other queue functions.
+                 * 
+                 * @param function the handler to be attached
+                 * @return the associated connection object
+                 */
+                boost::signals2::connection onWriteCompletedEventAttach(std::function<void(DatabaseAbstractionLayerID, DatabaseRequestID, bool)> function)
+                {
+                    return onWriteCompleted.connect(function);
+                }
 
                 /**
                  * Adds a new DAL to the queue.
@@ -231,6 +373,53 @@ namespace SyncServer_Core
                  * @return <code>true</code>, if the operation was successful
                  */
                 bool removeDAL(const DALPtr dal);
+                
+                /**
+                 * Replaces a DAL in the queue with a new one.
+                 * 
+                 * The new DAL takes the position of the old DAL in the queue and the old DAL is disconnected.
+                 * 
+                 * Note: Fails if the old DAL has any outstanding requests; the dispatching of new requests
+                 * should be suspended before calling this function.
+                 * 
+                 * @param oldDAL the DAL to be replaced
+                 * @param newDAL the replacement DAL
+                 * 
+                 * @return <code>true</code>, if the operation was successful
+                 */
+                bool replaceDAL(const DALPtr oldDAL, DALPtr newDAL);
+                
+                /**
+                 * Drops the stored event logs that are older than the specified time, in all DALs.
+                 * 
+                 * Note: The DALs are called directly, outside of the request queue.
+                 * 
+                 * @param time the retention limit
+                 * 
+                 * @return the total number of logs dropped
+                 */
+                unsigned long dropLogsBefore(Timestamp time);
+                
+                /**
+                 * Stops the dispatching of new requests to the DALs and waits for all
+                 * pending requests to be completed.
+                 * 
+                 * New requests are still accepted and are kept in the queue until
+                 * dispatching is resumed.
+                 * 
+                 * @param timeout maximum amount of time to wait for pending requests (in ms)
+                 * 
+                 * @return <code>true</code>, if all pending requests were completed in time;
+                 * <code>false</code>, if the timeout expired (dispatching is resumed)
+                 */
+                bool suspendDispatch(unsigned long timeout);
+                
+                /** Resumes the dispatching of new requests to the DALs. */
+                void resumeDispatch()
+                {
+                    dispatchSuspended = false;
+                    notifyMainThread();
+                }
 
                 /**
                  * Sets new queue configuration parameters.
@@ -276,8 +465,16 @@ namespace SyncServer_Core
                 unsigned long getTotalReadRequests()        const { return totalReadRequests; }
                 /** Retrieves the total number of WRITE requests.\n\n@return the number of write requests */
                 unsigned long getTotalWriteRequests()       const { return totalWriteRequests; }
+                /** Retrieves the total number of UPDATE requests merged into other requests.\n\n@return the number of coalesced requests */
+                unsigned long getTotalCoalescedRequests()   const { return totalCoalescedRequests; }
+                /** Retrieves the total number of requests dropped because their deadline had passed.\n\n@return the number of expired requests */
+                unsigned long getTotalExpiredRequests()     const { return totalExpiredRequests; }
+                /** Retrieves the total number of cancelled requests.\n\n@return the number of cancelled requests */
+                unsigned long getTotalCancelledRequests()   const { return totalCancelledRequests; }
+                /** Retrieves the default request timeout.\n\n@return the request timeout (in ms; 0 = no deadline) */
+                unsigned long getRequestTimeout()           const { return requestTimeout; }
                 /** Retrieves the number of currently new requests.\n\n@return the number of new requests */
-                unsigned long getNumberOfNewRequests()      const { return newRequests.size(); }
+                unsigned long getNumberOfNewRequests()      const { return newRequests.getSize(); }
                 /** Retrieves the number of currently pending requests.\n\n@return the number of pending requests */
                 unsigned long getNumberOfPendingRequests()  const { return pendingRequests.size(); }
                 /** Retrieves general information for the queue.\n\n@return the requested information */
@@ -288,13 +485,51 @@ namespace SyncServer_Core
                 std::vector<DALInformation> getDALsInformation() const;
 
             private:
-                enum class RequestType { SELECT, INSERT, UPDATE, REMOVE };
-
+                /** Structure for holding the data associated with a DAL in the queue. */
+                struct DALData
+                {
+                    DALData(DALPtr dalPtr, boost::signals2::connection onSuccess, boost::signals2::connection onFailure)
+                    : dal(dalPtr), onSuccessConnection(onSuccess), onFailureConnection(onFailure)
+                    {}
+                    
+                    DALPtr dal;                                         //the DAL
+                    unsigned int readFailures = 0;                      //number of consecutive read failures
+                    unsigned int writeFailures = 0;                     //number of consecutive write failures
+                    boost::signals2::connection onSuccessConnection;    //DAL "onSuccess" signal connection
+                    boost::signals2::connection onFailureConnection;    //DAL "onFailure" signal connection
+                    unsigned long outstandingRequests = 0;              //number of requests sent to the DAL that are still waiting for a response
+                    double averageReadLatency = 0.0;                    //exponentially weighted moving average of the SELECT response time (in ms)
+                    DALBreakerState breakerState = DALBreakerState::CLOSED; //circuit breaker state
+                    unsigned int reconnectAttempts = 0;                 //number of failed reconnect attempts since the breaker was opened
+                    boost::posix_time::ptime nextReconnectAttempt;      //time of the next reconnect attempt (OPEN only)
+                    DatabaseRequestID probeRequest = DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID; //request sent to the DAL as a probe (HALF_OPEN only)
+                    std::deque<DatabaseRequest> skippedWrites;          //writes missed while the breaker was not CLOSED, oldest first
+                    unsigned long pendingReplays = 0;                   //number of replayed writes still waiting for a response
+                    bool replayFailed = false;                          //denotes whether a write in the current replay failed
+                    bool resyncRequired = false;                        //denotes whether the DAL missed too many writes and needs a full resync
+                };
+                
+                /** Structure for holding the data associated with a request that is being processed by one or more DALs. */
+                struct PendingRequestData
+                {
+                    DatabaseRequest * request;                          //the request
+                    vector<DatabaseAbstractionLayerID> pendingDALs;     //DALs still working on the request
+                    boost::posix_time::ptime dispatchTime;              //time at which the request was sent to the DAL(s)
+                    bool responseSent;                                  //denotes whether a response was already forwarded (for SELECTs sent to multiple DALs)
+                    vector<DatabaseRequestID> coalescedRequests;        //IDs of the UPDATE requests merged into this request
+                    bool cancelled;                                     //denotes whether the request was cancelled after it was dispatched
+                    bool notFound;                                      //denotes whether all failed responses so far were "not found" responses
+                    bool replay;                                        //denotes whether the request is a replay of a write missed by a DAL
+                };
+                
                 //Statistics
                 unsigned int totalReadFailures;     //number of read failures for the queue
                 unsigned int totalWriteFailures;    //number of write failures for the queue
                 unsigned long totalReadRequests;    //number of read requests for the queue
                 unsigned long totalWriteRequests;   //number of write requests for the queue
+                unsigned long totalCoalescedRequests = 0; //number of UPDATE requests merged into other requests
+                unsigned long totalExpiredRequests = 0;   //number of requests dropped because their deadline had passed
+                unsigned long totalCancelledRequests = 0; //number of cancelled requests
 
                 //DALs management
                 DatabaseObjectType queueType;                   //the type of the objects the queue will handle
@@ -303,10 +538,17 @@ namespace SyncServer_Core
                 DatabaseFailureAction failureAction;            //denotes the queue behaviour in case of DAL failure (depending on # of failures for read/write)
                 DatabaseAbstractionLayerID nextDALID = 0;       //ID that will be assigned to the next new DAL
                 deque<DatabaseAbstractionLayerID> dalIDs;       //list of currently active DAL IDs
-                //ID -> <DAL pointer, read fails, write fails, on success connection, on failure connection>
-                unordered_map<DatabaseAbstractionLayerID, tuple<DALPtr, unsigned int, unsigned int, boost::signals2::connection, boost::signals2::connection>*> dals; 
+                unordered_map<DatabaseAbstractionLayerID, DALData*> dals; //ID -> DAL data
                 unsigned int maxConsecutiveReadFailures;        //maximum number of consecutive read failures before a DAL is considered as failed
                 unsigned int maxConsecutiveWriteFailures;       //maximum number of consecutive write failures before a DAL is considered as failed
+                unsigned int maxBatchSize;                      //maximum number of requests sent to a DAL as a single batch (0 = no limit)
+                DatabaseReadRoutingPolicy readRoutingPolicy;    //policy for selecting the DAL that will serve a SELECT request
+                bool coalesceUpdates;                           //denotes whether UPDATE requests for the same object are merged before dispatch
+                std::size_t nextReadDALIndex = 0;               //position in the DALs list of the next DAL to be used for reads (ROUND_ROBIN only)
+                unsigned long minReconnectDelay;                //time to wait before the first reconnect attempt for a failed DAL (in ms)
+                unsigned long maxReconnectDelay;                //maximum time to wait between reconnect attempts for a failed DAL (in ms)
+                unsigned long maxSkippedWrites;                 //maximum number of missed writes kept for a DAL (0 = no limit)
+                static constexpr double READ_LATENCY_SMOOTHING_FACTOR = 0.2; //weight of the most recent sample in the DAL read latency average
 
                 //Thread management
                 Utilities::FileLoggerPtr debugLogger;
@@ -317,31 +559,206 @@ namespace SyncServer_Core
                 std::atomic<bool> threadRunning;                //atomic variable for denoting the state of the main thread
 
                 //Requests management
-                unsigned long nextRequestID = 1;                //ID that will be assigned to the next new request
-                queue<DatabaseRequestID> newRequests;           //list of requests waiting for processing by the queue
-                //request id -> list of DALs working on that request
-                unordered_map<DatabaseRequestID, vector<DatabaseAbstractionLayerID>> pendingRequests; //table of requests waiting for processing by the corresponding DAL(s)
-                //request id -> <type, parameter 1, parameter 2>
-                unordered_map<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*> requestsData; //table of data accompanying each request
-
-                boost::signals2::signal<void (DatabaseRequestID, DBObjectID)> onFailure;
+                static const std::size_t REQUESTS_QUEUE_CAPACITY = 4096;       //maximum number of requests waiting for processing by the queue
+                static const std::size_t REQUESTS_POOL_SIZE = 4096;            //maximum number of free request objects kept for reuse
+                std::atomic<DatabaseRequestID> nextRequestID {1};               //ID that will be assigned to the next new request
+                std::atomic<bool> threadWaiting {false};                        //denotes whether the main thread is waiting for new requests
+                std::atomic<unsigned int> producersWaiting {0};                 //number of callers waiting for free space in the requests queue
+                boost::mutex queueSpaceMutex;                                   //mutex for waiting on free space in the requests queue
+                boost::condition_variable queueSpaceCondition;                  //condition variable for sleeping/notifying callers waiting on a full requests queue
+                std::atomic<bool> dispatchSuspended {false};                    //denotes whether new requests are kept in the queue instead of being dispatched
+                std::atomic<unsigned long> requestTimeout {0};                  //default time between adding a request and its deadline (in ms; 0 = no deadline)
+                boost::mutex queuedRequestsMutex;                               //mutex for accessing the queued and cancelled request IDs
+                boost::unordered_set<DatabaseRequestID> queuedRequests;         //IDs of the requests waiting for dispatch
+                boost::unordered_set<DatabaseRequestID> cancelledRequests;      //cancelled requests still waiting for dispatch
+                Utilities::ObjectPool<DatabaseRequest> requestsPool;            //pool of reusable request objects
+                Utilities::BoundedQueue<DatabaseRequest *> newRequests;         //requests waiting for processing by the queue (multiple producers, single consumer)
+                unordered_map<DatabaseRequestID, PendingRequestData> pendingRequests; //table of requests waiting for processing by the corresponding DAL(s)
+
+                boost::signals2::signal<void (DatabaseRequestID, DBObjectID, bool)> onFailure;
                 boost::signals2::signal<void (DatabaseRequestID, DataContainerPtr)> onSuccess;
+                boost::signals2::signal<void (const DatabaseRequest &, const vector<DatabaseAbstractionLayerID> &)> onWriteDispatched;
+                boost::signals2::signal<void (DatabaseAbstractionLayerID, DatabaseRequestID, bool)> onWriteCompleted;
 
                 /**
-                 * Adds a new request to the queue.
+                 * Assigns a new ID to the specified request and adds it to the queue.
                  * 
                  * Note: Thread-safe.
                  * 
-                 * @param type the type of the request
-                 * @param requestParameter primary request parameter
-                 * @param additionalParameter secondary request parameter (optional)
+                 * Note: The request is owned by the queue after the call and is returned
+                 * to the requests pool once all associated DALs have responded.
+                 * 
+                 * Note: If the requests queue is full, the caller is blocked until the main thread frees space in it;
+                 * requests added by the main thread itself (for example, from an event handler) are rejected instead.
+                 * 
+                 * @param request the request to be added (acquired from the requests pool)
+                 * @return the ID assigned to the new request or <code>INVALID_DATABASE_REQUEST_ID</code>, if it was rejected
+                 */
+                DatabaseRequestID addRequestToQueue(DatabaseRequest * request);
+                
+                /**
+                 * Returns the specified request to the requests pool.
+                 * 
+                 * @param request the request to be released
+                 */
+                void releaseRequest(DatabaseRequest * request)
+                {
+                    request->reset();
+                    requestsPool.release(request);
+                }
+                
+                /**
+                 * Removes the ID of the specified request from the queued requests and returns it to the requests pool.
+                 * 
+                 * Note: Used for requests that were assigned an ID but could not be added to the requests queue.
+                 * 
+                 * @param request the request to be discarded
+                 */
+                void discardQueuedRequest(DatabaseRequest * request);
+                
+                /**
+                 * Wakes up the main thread.
+                 * 
+                 * Note: Acquires the data lock; must not be called while holding it.
                  */
-                DatabaseRequestID addRequestToQueue(RequestType type, boost::any requestParameter, boost::any additionalParameter = 0);
+                void notifyMainThread()
+                {
+                    boost::lock_guard<boost::mutex> dataLock(threadMutex);
+                    threadLockCondition.notify_all();
+                }
+                
+                /**
+                 * Wakes up all callers waiting for free space in the requests queue, if any.
+                 * 
+                 * Note: Acquires the queue space lock; must not be called while holding it.
+                 */
+                void notifyWaitingProducers()
+                {
+                    //makes the freed space visible before checking for waiting callers
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    
+                    if(producersWaiting > 0)
+                    {
+                        boost::lock_guard<boost::mutex> spaceLock(queueSpaceMutex);
+                        queueSpaceCondition.notify_all();
+                    }
+                }
 
+                /**
+                 * Selects the DAL that will serve the next SELECT request, based on the current read routing policy.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @param candidateDALs the DALs that can receive requests (in queue order; must not be empty)
+                 * @return the ID of the selected DAL
+                 */
+                DatabaseAbstractionLayerID selectReadDAL(const vector<DatabaseAbstractionLayerID> & candidateDALs);
+                
+                /**
+                 * Opens the circuit breaker of the specified DAL and schedules its next reconnect attempt.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @param dalID the ID of the DAL
+                 * @param dalData the data associated with the DAL
+                 */
+                void openBreaker(DatabaseAbstractionLayerID dalID, DALData * dalData);
+                
+                /**
+                 * Closes the circuit breaker of the specified DAL, after a successful probe request or replay.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @param dalID the ID of the DAL
+                 * @param dalData the data associated with the DAL
+                 */
+                void closeBreaker(DatabaseAbstractionLayerID dalID, DALData * dalData);
+                
+                /**
+                 * Drops the missed writes of the specified DAL and marks it as requiring a full resync.
+                 * 
+                 * The breaker of the DAL is kept open and no reconnect attempts are made for it.
+                 * 
+                 * Note: Not thread-safe; expects the data lock to be held.
+                 * 
+                 * @param dalID the ID of the DAL
+                 * @param dalData the data of the DAL
+                 */
+                void requireResync(DatabaseAbstractionLayerID dalID, DALData * dalData);
+                
+                /**
+                 * Attempts to reconnect all DALs with open circuit breakers whose reconnect time has been reached.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @return the time of the earliest pending reconnect attempt (<code>not_a_date_time</code>, if there are none)
+                 */
+                boost::posix_time::ptime processReconnects();
+                
+                /**
+                 * Replays the missed writes of all reconnected (HALF_OPEN) DALs that are not already replaying.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 */
+                void processReplays();
+                
+                /**
+                 * Processes the response to a replayed write and closes or re-opens the breaker
+                 * of the DAL, once all writes of the current replay have completed.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @param dalID the ID of the DAL
+                 * @param requestID the ID of the replayed write
+                 * @param successful denotes whether the write was applied
+                 */
+                void onReplayCompleted(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, bool successful);
+                
+                /**
+                 * Calculates the time to wait before the next reconnect attempt (exponential backoff).
+                 * 
+                 * @param attempts the number of failed reconnect attempts so far
+                 * @return the delay (in ms)
+                 */
+                unsigned long getReconnectDelay(unsigned int attempts) const;
+                
+                /**
+                 * Updates the outstanding requests counter and the read latency average of the specified DAL,
+                 * after it has responded to a request.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @param dalID the ID of the DAL that responded
+                 * @param requestData the data associated with the request
+                 */
+                void updateDALLoad(DatabaseAbstractionLayerID dalID, const PendingRequestData & requestData);
+                
+                /**
+                 * Merges UPDATE requests for the same object found in the specified list into a single request.
+                 * 
+                 * The merged request takes the place of the first UPDATE for the object, the container of the
+                 * last one (last writer wins) and the earliest deadline of all merged UPDATEs. All other UPDATEs are
+                 * released, their entries in the list are set to <code>nullptr</code> and their IDs are added to the
+                 * specified table, so that they are completed together with the merged request. An INSERT or a REMOVE
+                 * for the same object, or any SELECT, ends the merging, to preserve the order of operations.
+                 * 
+                 * Note: Expects the data lock to be held by the caller.
+                 * 
+                 * @param requests the requests to be processed
+                 * @param coalescedRequests table to be updated with the IDs of all merged requests (merged request ID -> list of IDs)
+                 */
+                void coalesceUpdateRequests(vector<DatabaseRequest *> & requests, unordered_map<DatabaseRequestID, vector<DatabaseRequestID>> & coalescedRequests);
+                
                 /**
                  * Main queue thread.
                  * 
                  * Deals with all DB requests for a specific logical unit (queue type).
+                 * 
+                 * On each wakeup, up to <code>maxBatchSize</code> new requests are taken from the queue
+                 * and are sent to each affected DAL as a single batch (after merging UPDATEs for the same object,
+                 * if enabled). Producers only wake the thread up when it is waiting for new requests.
+                 * 
+                 * Cancelled requests and requests whose deadline has passed are dropped before dispatch.
                  */
                 void mainQueueThread();
 
@@ -351,8 +768,9 @@ namespace SyncServer_Core
                  * @param dalID the ID of the DAL that fired the event
                  * @param requestID the associated request ID
                  * @param id the associated object ID (if any)
+                 * @param notFound denotes whether a SELECT request completed without finding any objects
                  */
-                void onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id);
+                void onFailureHandler(DatabaseAbstractionLayerID dalID, DatabaseRequestID requestID, DBObjectID id, bool notFound);
 
                 /**
                  * Event handler for "onSuccess" signals coming from the DALs in the queue.
@@ -16,13 +16,22 @@
  */
 
 #include "DebugDAL.h"
+#include <cstdio>
 #include <boost/regex.hpp>
+#include <boost/algorithm/hex.hpp>
 
-DatabaseManagement_DALs::DebugDAL::DebugDAL(std::string logPath, std::string dataPath, DatabaseObjectType dbType)
+const std::string DatabaseManagement_DALs::DebugDAL::DATA_FILE_SIGNATURE = "DEBUGDAL";
+const unsigned int DatabaseManagement_DALs::DebugDAL::DATA_FILE_VERSION = 2;
+
+DatabaseManagement_DALs::DebugDAL::DebugDAL(std::string logPath, std::string dataPath, DatabaseObjectType dbType,
+                                            unsigned long logPartitionLength, unsigned long maxLogPartitions)
     : logger(logPath, 8*1024*1024, Utilities::FileLogSeverity::Debug), dataFilePath(dataPath), dalType(dbType), nextIntID(0)
 {
     info = new DebugDALInformationContainer();
     
+    if(dalType == DatabaseObjectType::LOG)
+        logs = new PartitionedLogStore(logPartitionLength, maxLogPartitions);
+    
     mainThreadObject = new boost::thread(&DatabaseManagement_DALs::DebugDAL::mainThread, this);
 }
 
@@ -40,34 +49,69 @@ DatabaseManagement_DALs::DebugDAL::~DebugDAL()
     mainThreadObject->join();
     delete mainThreadObject;
     
+    delete logs;
     delete info;
 }
 
 bool DatabaseManagement_DALs::DebugDAL::getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue)
 {
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Get Object) > <" + Convert::toString(requestID) + ">.");
-    addRequest(requestID, RequestType::SELECT, constraintType, constraintValue);
+    addRequest(DatabaseRequest(requestID, constraintType, constraintValue));
+    return true;
+}
+
+bool DatabaseManagement_DALs::DebugDAL::getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                                       unsigned long offset, unsigned long limit)
+{
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Get Objects Page) > <" + Convert::toString(requestID) + ">.");
+    addRequest(DatabaseRequest(requestID, constraintType, constraintValue, offset, limit));
     return true;
 }
 
 bool DatabaseManagement_DALs::DebugDAL::putObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
 {
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Insert Object) > <" + Convert::toString(requestID) + ">.");
-    addRequest(requestID, RequestType::INSERT, inputData, 0);
+    addRequest(DatabaseRequest(DatabaseRequestType::INSERT, requestID, inputData));
     return true;
 }
 
 bool DatabaseManagement_DALs::DebugDAL::updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
 {
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Update Object) > <" + Convert::toString(requestID) + ">.");
-    addRequest(requestID, RequestType::UPDATE, inputData, 0);
+    addRequest(DatabaseRequest(DatabaseRequestType::UPDATE, requestID, inputData));
     return true;
 }
 
 bool DatabaseManagement_DALs::DebugDAL::removeObject(DatabaseRequestID requestID, DBObjectID id)
 {
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Remove Object) > <" + Convert::toString(requestID) + ">.");
-    addRequest(requestID, RequestType::REMOVE, id, 0);
+    addRequest(DatabaseRequest(requestID, id));
+    return true;
+}
+
+bool DatabaseManagement_DALs::DebugDAL::processBatch(const std::vector<const DatabaseRequest *> & requests, std::vector<const DatabaseRequest *> & rejectedRequests)
+{
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Process Batch) > <" + Convert::toString(requests.size()) + "> requests.");
+    
+    if(!isConnected)
+    {
+        logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Process Batch) > Failed to add requests; DAL is not connected to DB.");
+        rejectedRequests.insert(rejectedRequests.end(), requests.begin(), requests.end());
+        return false;
+    }
+    
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Process Batch) > Entering critical section.");
+    boost::unique_lock<boost::mutex> requestsLock(mainThreadMutex);
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Process Batch) > Critical section entered.");
+    
+    for(const DatabaseRequest * currentRequest : requests)
+        pendingRequests.push(*currentRequest);
+    
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Process Batch) > Sending notification to requests thread.");
+    mainThreadLockCondition.notify_all();
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Process Batch) > Notification to requests thread sent.");
+    
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Process Batch) > Exiting critical section.");
     return true;
 }
 
@@ -97,6 +141,9 @@ bool DatabaseManagement_DALs::DebugDAL::clearDatabase()
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Clear DB) > Critical section entered.");
 
     data.clear();
+    if(logs != nullptr)
+        logs->clear();
+    
     saveDataFile();
 
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Clear DB) > Exiting critical section.");
@@ -115,7 +162,16 @@ bool DatabaseManagement_DALs::DebugDAL::connect()
     boost::lock_guard<boost::mutex> requestsLock(mainThreadMutex);
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Connect) > Critical section entered.");
 
-    loadDataFile();
+    if(!loadDataFile())
+    {
+        logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Connect) > Data file <" + dataFilePath + "> was rejected.");
+        data.clear();
+        if(logs != nullptr)
+            logs->clear();
+        
+        return false;
+    }
+    
     isConnected = true;
 
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Connect) > Exiting critical section.");
@@ -136,6 +192,9 @@ bool DatabaseManagement_DALs::DebugDAL::disconnect()
 
     saveDataFile();
     data.clear();
+    if(logs != nullptr)
+        logs->clear();
+    
     isConnected = false;
 
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Disconnect) > Exiting critical section.");
@@ -167,11 +226,23 @@ DatabaseAbstractionLayerID DatabaseManagement_DALs::DebugDAL::getID() const
     return dalID;
 }
 
-void DatabaseManagement_DALs::DebugDAL::loadDataFile()
+unsigned long DatabaseManagement_DALs::DebugDAL::dropLogsBefore(Timestamp time)
+{
+    if(logs == nullptr)
+        return 0;
+    
+    boost::lock_guard<boost::mutex> dataLock(mainThreadMutex);
+    unsigned long droppedLogs = logs->dropPartitionsBefore(time);
+    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Drop Logs) > <" + Convert::toString(droppedLogs) + "> log(s) dropped.");
+    return droppedLogs;
+}
+
+bool DatabaseManagement_DALs::DebugDAL::loadDataFile()
 {
     logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Data load requested.");
     
     std::ifstream dataFile(dataFilePath);
+    bool legacyFile = false;
     
     if(dataFile.is_open())
     {
@@ -180,7 +251,31 @@ void DatabaseManagement_DALs::DebugDAL::loadDataFile()
         
         getline(dataFile, entry);
         
-        nextIntID = boost::lexical_cast<unsigned long>(entry);
+        //older versions wrote CSV entries without a signature; they are converted to the current format
+        if(entry != (DATA_FILE_SIGNATURE + " " + Convert::toString(DATA_FILE_VERSION)))
+        {
+            if(entry.compare(0, DATA_FILE_SIGNATURE.size(), DATA_FILE_SIGNATURE) == 0)
+            {
+                logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Unsupported data file format found <"
+                        + dataFilePath + ">; expected version <" + Convert::toString(DATA_FILE_VERSION) + ">.");
+                return false;
+            }
+            
+            logger.logMessage(Utilities::FileLogSeverity::Info, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Legacy data file found <" + dataFilePath + ">.");
+            legacyFile = true;
+        }
+        else
+            getline(dataFile, entry);
+        
+        try
+        {
+            nextIntID = boost::lexical_cast<unsigned long>(entry);
+        }
+        catch(const boost::bad_lexical_cast &)
+        {
+            logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Malformed data file header found <" + dataFilePath + ">.");
+            return false;
+        }
         
         unsigned int i = 1;
         while(getline(dataFile, entry))
@@ -196,13 +291,40 @@ void DatabaseManagement_DALs::DebugDAL::loadDataFile()
             DBObjectID currentID;
             std::string currentStringID = currentMatch[1];
             
-            switch(entry.at(0))
+            try
+            {
+                switch(entry.at(0))
+                {
+                    case 'U': currentID = boost::lexical_cast<boost::uuids::uuid>(currentStringID); break;
+                    default: logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Invalid entry found <" + Convert::toString(i) + ">"); break;
+                }
+                
+                std::string entryData;
+                if(legacyFile)
+                {
+                    DataContainerPtr legacyContainer = LegacyEntryParser::toContainer(currentMatch[2], dalType, currentID);
+                    if(!legacyContainer)
+                        throw std::runtime_error("DebugDAL::loadDataFile() > Unsupported legacy entry type.");
+                    
+                    entryData = ContainerSerializer::serialize(legacyContainer);
+                }
+                else
+                    entryData = boost::algorithm::unhex(std::string(currentMatch[2]));
+                
+                if(logs != nullptr)
+                    logs->insert(boost::dynamic_pointer_cast<DatabaseManagement_Containers::LogDataContainer>(ContainerSerializer::deserialize(entryData)));
+                else
+                    data.insert(std::pair<DBObjectID,std::string>(currentID, entryData));
+            }
+            catch(const boost::algorithm::hex_decode_error &)
             {
-                case 'U': currentID = boost::lexical_cast<boost::uuids::uuid>(currentStringID); break;
-                default: logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Invalid entry found <" + Convert::toString(i) + ">"); break;
+                logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Malformed entry data found <" + Convert::toString(i) + ">");
+            }
+            catch(const std::exception & e)
+            {
+                logger.logMessage(legacyFile ? Utilities::FileLogSeverity::Error : Utilities::FileLogSeverity::Debug,
+                        "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Malformed entry found <" + Convert::toString(i) + ">: [" + e.what() + "]");
             }
-            
-            data.insert(std::pair<DBObjectID,std::string>(currentID, currentMatch[2]));
             
             i++;
         }
@@ -211,21 +333,47 @@ void DatabaseManagement_DALs::DebugDAL::loadDataFile()
         logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Data file is not open <" + dataFilePath + ">.");
     
     dataFile.close();
+    
+    if(legacyFile)
+    {//the original file is kept, in case any of its entries could not be converted
+        std::string legacyFilePath = dataFilePath + ".legacy";
+        if(std::rename(dataFilePath.c_str(), legacyFilePath.c_str()) != 0)
+        {
+            logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Failed to keep legacy data file as <" + legacyFilePath + ">.");
+            return false;
+        }
+        
+        saveDataFile();
+        logger.logMessage(Utilities::FileLogSeverity::Info, "DebugDAL / " + Convert::toString(dalType) + " (Load Data) > Legacy data file converted; original file kept as <" + legacyFilePath + ">.");
+    }
+    
+    return true;
 }
 
 void DatabaseManagement_DALs::DebugDAL::saveDataFile()
 {
     std::ofstream dataFile(dataFilePath, std::ofstream::trunc);
     
+    dataFile << DATA_FILE_SIGNATURE << " " << Convert::toString(DATA_FILE_VERSION) << std::endl;
     dataFile << Convert::toString(nextIntID) << std::endl;
     
     for(std::pair<DBObjectID, std::string> currentEntry : data)
     {
-        std::string entryString = "U," + Convert::toString(currentEntry.first) + ";" + currentEntry.second;
+        std::string entryString = "U," + Convert::toString(currentEntry.first) + ";" + boost::algorithm::hex(currentEntry.second);
         
         dataFile << entryString << std::endl;
     }
     
+    if(logs != nullptr)
+    {
+        for(const LogDataContainerPtr & currentLog : logs->select(DatabaseSelectConstraints::LOGS::GET_ALL, 0))
+        {
+            std::string entryString = "U," + Convert::toString(currentLog->getLogID()) + ";" + boost::algorithm::hex(ContainerSerializer::serialize(currentLog));
+            
+            dataFile << entryString << std::endl;
+        }
+    }
+    
     dataFile.close();
 }
 
@@ -240,6 +388,9 @@ void DatabaseManagement_DALs::DebugDAL::mainThread()
         boost::unique_lock<boost::mutex> dataLock(mainThreadMutex);
         logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Data lock acquired.");
         
+        if(stopDebugger)
+            break; //the stop request may have been made after the loop condition was checked
+        
         if(pendingRequests.size() == 0)
         {
             logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Waiting on data lock.");
@@ -252,163 +403,222 @@ void DatabaseManagement_DALs::DebugDAL::mainThread()
             logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Starting work on <" + Convert::toString(numberOfNewRequests) + "> new request(s).");
             for(unsigned int i = 0; i < numberOfNewRequests; i++)
             {
-                DatabaseRequestID currentRequest = pendingRequests.front();
-                tuple<RequestType, boost::any, boost::any> * currentRequestData = requestsData[currentRequest];
+                DatabaseRequest currentRequestData = std::move(pendingRequests.front());
+                DatabaseRequestID currentRequest = currentRequestData.getID();
+                pendingRequests.pop();
                 logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Working with request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
                 
-                switch(currentRequestData->get<0>())
+                if(logs != nullptr)
                 {
-                    case RequestType::SELECT:
+                    processLogRequest(currentRequestData, dataLock);
+                    logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Done with request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
+                    continue;
+                }
+                
+                //stored entries are decoded on demand; an entry that cannot be decoded only fails the current request
+                try
+                {
+                    switch(currentRequestData.getType())
                     {
-                        DBObjectID objectID = Utilities::Tools::getIDFromConstraint(dalType, currentRequestData->get<1>(), currentRequestData->get<2>());
-                        
-                        if(dalType == DatabaseObjectType::USER 
-                                && boost::any_cast<DatabaseSelectConstraints::USERS>(currentRequestData->get<1>()) == DatabaseSelectConstraints::USERS::LIMIT_BY_NAME)
+                        case DatabaseRequestType::SELECT:
                         {
-                            bool done = false;
+                            DBObjectID objectID = Utilities::Tools::getIDFromConstraint(dalType, currentRequestData.getConstraint().type, currentRequestData.getConstraint().value);
                             
-                            for(const std::pair<DBObjectID, std::string> & currentPair : data)
+                            if(dalType == DatabaseObjectType::USER 
+                                    && boost::any_cast<DatabaseSelectConstraints::USERS>(currentRequestData.getConstraint().type) == DatabaseSelectConstraints::USERS::LIMIT_BY_NAME)
                             {
-                                if(currentPair.second.find(boost::any_cast<std::string>(currentRequestData->get<2>())) != std::string::npos)
+                                bool done = false;
+                                
+                                std::string username = boost::any_cast<std::string>(currentRequestData.getConstraint().value);
+                                for(const std::pair<DBObjectID, std::string> & currentPair : data)
+                                {
+                                    UserDataContainerPtr currentUser = boost::dynamic_pointer_cast<DatabaseManagement_Containers::UserDataContainer>(ContainerSerializer::deserialize(currentPair.second));
+                                    if(currentUser->getUsername() == username)
+                                    {
+                                        dataLock.unlock();
+                                        onSuccess(dalID, currentRequest, currentUser);
+                                        dataLock.lock();
+                                        done = true;
+                                        break;
+                                    }
+                                }
+                                
+                                if(!done)
                                 {
                                     dataLock.unlock();
-                                    onSuccess(dalID, currentRequest, Stringifier::toUser(currentPair.second, currentPair.first));
+                                    onFailure(dalID, currentRequest, objectID, true);
                                     dataLock.lock();
-                                    done = true;
-                                    break;
                                 }
+                                
+                                break;
                             }
                             
-                            if(!done)
+                            if(dalType == DatabaseObjectType::STATISTICS
+                                    && boost::any_cast<DatabaseSelectConstraints::STATISTCS>(currentRequestData.getConstraint().type) == DatabaseSelectConstraints::STATISTCS::LIMIT_BY_TYPE
+                                    && currentRequestData.getConstraint().value.type() == typeid(StatisticType))
                             {
+                                StatisticDataContainerPtr result;
+                                
+                                StatisticType type = boost::any_cast<StatisticType>(currentRequestData.getConstraint().value);
+                                for(const std::pair<DBObjectID, std::string> & currentPair : data)
+                                {
+                                    StatisticDataContainerPtr currentStatistic = boost::dynamic_pointer_cast<DatabaseManagement_Containers::StatisticDataContainer>(ContainerSerializer::deserialize(currentPair.second));
+                                    if(currentStatistic && currentStatistic->getStatisticType() == type)
+                                    {
+                                        result = currentStatistic;
+                                        break;
+                                    }
+                                }
+                                
                                 dataLock.unlock();
-                                onFailure(dalID, currentRequest, objectID);
+                                
+                                if(result)
+                                    onSuccess(dalID, currentRequest, result);
+                                else
+                                    onFailure(dalID, currentRequest, objectID, true);
+                                
                                 dataLock.lock();
+                                break;
+                            }
+                            
+                            if(objectID != Common_Types::INVALID_OBJECT_ID)
+                            {
+                                if(data.find(objectID) != data.end())
+                                {
+                                    dataLock.unlock();
+                                    onSuccess(dalID, currentRequest, ContainerSerializer::deserialize(data[objectID]));
+                                    dataLock.lock();
+                                }
+                                else
+                                {
+                                    dataLock.unlock();
+                                    onFailure(dalID, currentRequest, objectID, true);
+                                    dataLock.lock();
+                                }
+                            }
+                            else //for debugging purposes, always return all objects (no constraint check)
+                            {
+                                const DatabaseManagement_Types::SelectConstraint & constraint = currentRequestData.getConstraint();
+                                VectorDataContainerPtr vect(new DatabaseManagement_Containers::VectorDataContainer());
+                                vect->setOffset(constraint.offset);
+                                
+                                //only the containers in the requested page are built, if the request is paged
+                                unsigned long currentPosition = 0;
+                                for(const std::pair<DBObjectID, std::string> & currentEntry : data)
+                                {
+                                    if(constraint.limit > 0 && vect->size() >= constraint.limit)
+                                        break;
+                                    
+                                    if(currentPosition++ >= constraint.offset)
+                                        vect->addDataContainer(ContainerSerializer::deserialize(currentEntry.second));
+                                }
+                                
+                                if(!vect->isEmpty() || constraint.limit > 0) //an empty page denotes the end of the data
+                                {
+                                    dataLock.unlock();
+                                    onSuccess(dalID, currentRequest, vect);
+                                    dataLock.lock();
+                                }
+                                else
+                                {
+                                    dataLock.unlock();
+                                    onFailure(dalID, currentRequest, objectID, true);
+                                    dataLock.lock();
+                                }
                             }
                             
-                            break;
-                        }
+                        } break;
                         
-                        if(objectID != Common_Types::INVALID_OBJECT_ID)
+                        case DatabaseRequestType::INSERT:
                         {
-                            if(data.find(objectID) != data.end())
+                            bool successful = true;
+                            
+                            DataContainerPtr container = currentRequestData.getContainer();
+                            
+                            if(successful && data.find(container->getContainerID()) == data.end())
+                            {
+                                data.insert(std::pair<DBObjectID, std::string>(container->getContainerID(), ContainerSerializer::serialize(container)));
+                            }
+                            else
+                                logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > INSERT failed for request; object exists <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
+                            
+                            if(successful)
                             {
                                 dataLock.unlock();
-                                onSuccess(dalID, currentRequest, Stringifier::toContainer(data[objectID], dalType, objectID));
+                                onSuccess(dalID, currentRequest, container);
                                 dataLock.lock();
                             }
                             else
                             {
                                 dataLock.unlock();
-                                onFailure(dalID, currentRequest, objectID);
+                                onFailure(dalID, currentRequest, container->getContainerID(), false);
                                 dataLock.lock();
                             }
-                        }
-                        else //for debugging purposes, always return all objects (no constraint check)
+                        } break;
+                            
+                        case DatabaseRequestType::UPDATE:
                         {
-                            VectorDataContainerPtr vect(new DatabaseManagement_Containers::VectorDataContainer());
-                            for(std::pair<DBObjectID, std::string> currentEntry : data)
-                                vect->addDataContainer(Stringifier::toContainer(currentEntry.second, dalType, currentEntry.first));
+                            DataContainerPtr container = currentRequestData.getContainer();
                             
-                            if(!vect->isEmpty())
+                            if(data.find(container->getContainerID()) != data.end())
                             {
+                                data[container->getContainerID()] = ContainerSerializer::serialize(container);
                                 dataLock.unlock();
-                                onSuccess(dalID, currentRequest, vect);
+                                onSuccess(dalID, currentRequest, container);
                                 dataLock.lock();
                             }
                             else
                             {
+                                logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > UPDATE failed for request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
                                 dataLock.unlock();
-                                onFailure(dalID, currentRequest, objectID);
+                                onFailure(dalID, currentRequest, container->getContainerID(), false);
                                 dataLock.lock();
                             }
-                        }
+                        } break;
                         
-                    } break;
-                    
-                    case RequestType::INSERT:
-                    {
-                        bool successful = true;
-                        
-                        DataContainerPtr container = boost::any_cast<DataContainerPtr>(currentRequestData->get<1>());
-                        
-                        if(successful && data.find(container->getContainerID()) == data.end())
+                        case DatabaseRequestType::REMOVE:
                         {
-                            data.insert(std::pair<DBObjectID, std::string>(container->getContainerID(), Stringifier::toString(container)));
-                        }
-                        else
-                            logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > INSERT failed for request; object exists <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
-                        
-                        if(successful)
-                        {
-                            dataLock.unlock();
-                            onSuccess(dalID, currentRequest, container);
-                            dataLock.lock();
-                        }
-                        else
-                        {
-                            dataLock.unlock();
-                            onFailure(dalID, currentRequest, container->getContainerID());
-                            dataLock.lock();
-                        }
-                    } break;
-                        
-                    case RequestType::UPDATE:
-                    {
-                        DataContainerPtr container = boost::any_cast<DataContainerPtr>(currentRequestData->get<1>());
-                        
-                        if(data.find(container->getContainerID()) != data.end())
-                        {
-                            data[container->getContainerID()] = Stringifier::toString(container);
-                            dataLock.unlock();
-                            onSuccess(dalID, currentRequest, container);
-                            dataLock.lock();
-                        }
-                        else
-                        {
-                            logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > UPDATE failed for request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
-                            dataLock.unlock();
-                            onFailure(dalID, currentRequest, container->getContainerID());
-                            dataLock.lock();
-                        }
-                    } break;
-                    
-                    case RequestType::REMOVE:
-                    {
-                        DBObjectID id = boost::any_cast<DBObjectID>(currentRequestData->get<1>());
-                        
-                        auto containerIterator = data.find(id);
+                            DBObjectID id = currentRequestData.getObjectID();
+                            
+                            auto containerIterator = data.find(id);
+                            
+                            if(containerIterator != data.end())
+                            {
+                                DataContainerPtr container = ContainerSerializer::deserialize((*containerIterator).second);
+                                data.erase(containerIterator);
+                                dataLock.unlock();
+                                onSuccess(dalID, currentRequest, container);
+                                dataLock.lock();
+                            }
+                            else
+                            {
+                                logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > REMOVE failed for request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + "/" + Convert::toString(id) + ">.");
+                                dataLock.unlock();
+                                onFailure(dalID, currentRequest, id, false);
+                                dataLock.lock();
+                            }
+                        } break;
                         
-                        if(containerIterator != data.end())
-                        {
-                            DataContainerPtr container = Stringifier::toContainer((*containerIterator).second, dalType, id);
-                            data.erase(containerIterator);
-                            dataLock.unlock();
-                            onSuccess(dalID, currentRequest, container);
-                            dataLock.lock();
-                        }
-                        else
+                        default:
                         {
-                            logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > REMOVE failed for request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + "/" + Convert::toString(id) + ">.");
+                            logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Unexpected request type encountered for new request <" + Convert::toString(currentRequest) + ">.");
                             dataLock.unlock();
-                            onFailure(dalID, currentRequest, id);
+                            onFailure(dalID, currentRequest, DBObjectID(), false);
                             dataLock.lock();
-                        }
-                    } break;
+                        } break;
+                    }
+                }
+                catch(const std::exception & e)
+                {
+                    logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Exception encountered for request <" + Convert::toString(currentRequest) + ">: [" + e.what() + "].");
                     
-                    default:
-                    {
-                        logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Unexpected request type encountered for new request <" + Convert::toString(currentRequest) + ">.");
+                    if(dataLock.owns_lock())
                         dataLock.unlock();
-                        onFailure(dalID, currentRequest, DBObjectID());
-                        dataLock.lock();
-                    } break;
+                    
+                    onFailure(dalID, currentRequest, Common_Types::INVALID_OBJECT_ID, false);
+                    dataLock.lock();
                 }
                 
-                pendingRequests.pop();
-                requestsData.erase(currentRequest);
-                delete currentRequestData;
-                
                 logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL / " + Convert::toString(dalType) + " (Main Thread) > Done with request <#" + Convert::toString(i) + "/" + Convert::toString(currentRequest) + ">.");
             }
             
@@ -423,3 +633,84 @@ void DatabaseManagement_DALs::DebugDAL::mainThread()
     return;
 }
 
+void DatabaseManagement_DALs::DebugDAL::processLogRequest(const DatabaseRequest & request, boost::unique_lock<boost::mutex> & dataLock)
+{
+    DatabaseRequestID requestID = request.getID();
+    DataContainerPtr result;
+    DBObjectID objectID = Common_Types::INVALID_OBJECT_ID;
+    bool notFound = false;
+    
+    try
+    {
+        switch(request.getType())
+        {
+            case DatabaseRequestType::SELECT:
+            {
+                const DatabaseManagement_Types::SelectConstraint & constraint = request.getConstraint();
+                DatabaseSelectConstraints::LOGS constraintType = boost::any_cast<DatabaseSelectConstraints::LOGS>(constraint.type);
+                
+                if(constraintType == DatabaseSelectConstraints::LOGS::LIMIT_BY_ID)
+                {
+                    objectID = boost::any_cast<LogID>(constraint.value);
+                    result = logs->find(objectID);
+                }
+                else
+                {
+                    VectorDataContainerPtr vect(new DatabaseManagement_Containers::VectorDataContainer());
+                    vect->setOffset(constraint.offset);
+                    for(const LogDataContainerPtr & currentLog : logs->select(constraintType, constraint.value, constraint.offset, constraint.limit))
+                        vect->addDataContainer(currentLog);
+                    
+                    if(!vect->isEmpty() || constraint.limit > 0) //an empty page denotes the end of the data
+                        result = vect;
+                }
+                
+                notFound = !result;
+            } break;
+            
+            case DatabaseRequestType::INSERT:
+            {
+                LogDataContainerPtr log = boost::dynamic_pointer_cast<DatabaseManagement_Containers::LogDataContainer>(request.getContainer());
+                objectID = request.getContainer()->getContainerID();
+                
+                if(logs->insert(log))
+                    result = log;
+            } break;
+            
+            case DatabaseRequestType::UPDATE:
+            {
+                LogDataContainerPtr log = boost::dynamic_pointer_cast<DatabaseManagement_Containers::LogDataContainer>(request.getContainer());
+                objectID = request.getContainer()->getContainerID();
+                
+                if(logs->update(log))
+                    result = log;
+            } break;
+            
+            case DatabaseRequestType::REMOVE:
+            {
+                objectID = request.getObjectID();
+                result = logs->remove(objectID);
+            } break;
+            
+            default:
+            {
+                logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Process Log Request) > Unexpected request type encountered for request <" + Convert::toString(requestID) + ">.");
+            } break;
+        }
+    }
+    catch(const std::exception & e)
+    {
+        logger.logMessage(Utilities::FileLogSeverity::Error, "DebugDAL / " + Convert::toString(dalType) + " (Process Log Request) > Exception encountered for request <" + Convert::toString(requestID) + ">: [" + e.what() + "].");
+        result.reset();
+        notFound = false;
+    }
+    
+    dataLock.unlock();
+    
+    if(result)
+        onSuccess(dalID, requestID, result);
+    else
+        onFailure(dalID, requestID, objectID, notFound);
+    
+    dataLock.lock();
+}
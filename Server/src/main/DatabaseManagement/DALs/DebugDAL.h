@@ -24,7 +24,6 @@
 #include <iosfwd>
 #include <boost/any.hpp>
 #include <boost/thread.hpp>
-#include <boost/tuple/tuple.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
@@ -51,6 +50,8 @@
 #include "../Containers/ScheduleDataContainer.h"
 #include "../Containers/SyncDataContainer.h"
 #include "../Containers/VectorDataContainer.h"
+#include "../Containers/ContainerSerializer.h"
+#include "PartitionedLogStore.h"
 #include "../../SecurityManagement/Rules/AuthorizationRules.h"
 #include "../../InstructionManagement/Types/Types.h"
 
@@ -76,6 +77,8 @@ using Common_Types::ScheduleID;
 using DatabaseManagement_Types::DatabaseIDType;
 using DatabaseManagement_Types::DatabaseRequestID;
 using DatabaseManagement_Types::DatabaseObjectType;
+using DatabaseManagement_Types::DatabaseRequestType;
+using DatabaseManagement_Types::DatabaseRequest;
 using DatabaseManagement_Types::DatabaseAbstractionLayerID;
 using DatabaseManagement_Types::DatabaseRequestID;
 using DatabaseManagement_Types::ObjectCacheAge;
@@ -100,11 +103,11 @@ using DatabaseManagement_Containers::SessionDataContainer;
 using DatabaseManagement_Containers::ScheduleDataContainer;
 using DatabaseManagement_Containers::SyncDataContainer;
 using DatabaseManagement_Containers::VectorDataContainer;
+using DatabaseManagement_Containers::ContainerSerializer;
 
 using SecurityManagement_Rules::UserAuthorizationRule;
 using SecurityManagement_Types::PasswordData;
 
-using boost::tuples::tuple;
 using boost::unordered_map;
 
 using std::getline;
@@ -117,13 +120,28 @@ namespace DatabaseManagement_DALs
     class DebugDAL : public DatabaseManagement_Interfaces::DatabaseAbstractionLayer
     {
         public:
-            enum class RequestType { INSERT, UPDATE, REMOVE, SELECT };
-            
             class DebugDALSettingsContainer;
             class DebugDALInformationContainer;
-            class Stringifier;
+            class LegacyEntryParser;
+            
+            /** Data file signature (first line of the file, followed by the file version) */
+            static const std::string DATA_FILE_SIGNATURE;
+            /** Data file version (entries hold hex-encoded <code>ContainerSerializer</code> data) */
+            static const unsigned int DATA_FILE_VERSION;
             
-            DebugDAL(std::string logPath, std::string dataPath, DatabaseObjectType dbType);
+            /**
+             * Creates a new debug DAL.
+             * 
+             * Note: Log DALs keep their data in time partitions (see <code>PartitionedLogStore</code>).
+             * 
+             * @param logPath the DAL log file path
+             * @param dataPath the data file path
+             * @param dbType the DAL type
+             * @param logPartitionLength the time period covered by each log partition (in seconds; log DALs only)
+             * @param maxLogPartitions the maximum number of log partitions to keep (0 = unlimited; log DALs only)
+             */
+            DebugDAL(std::string logPath, std::string dataPath, DatabaseObjectType dbType,
+                     unsigned long logPartitionLength = PartitionedLogStore::DEFAULT_PARTITION_LENGTH, unsigned long maxLogPartitions = 0);
             ~DebugDAL();
             
             DebugDAL() = delete;                            //No default constructor
@@ -131,9 +149,12 @@ namespace DatabaseManagement_DALs
             DebugDAL& operator=(const DebugDAL&) = delete;  //Copy not allowed (pass/access only by reference/pointer)
 
             bool getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue) override;
+            bool getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                unsigned long offset, unsigned long limit) override;
             bool putObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
             bool updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
             bool removeObject(DatabaseRequestID requestID, DBObjectID id) override;
+            bool processBatch(const std::vector<const DatabaseRequest *> & requests, std::vector<const DatabaseRequest *> & rejectedRequests) override;
             
             bool changeDatabaseSettings(const DatabaseSettingsContainer settings) override;
             bool buildDatabase() override;
@@ -146,6 +167,14 @@ namespace DatabaseManagement_DALs
             void setID(DatabaseAbstractionLayerID id) override;
             DatabaseAbstractionLayerID getID() const override;
             
+            /**
+             * Drops all log partitions that only contain entries older than the specified time.
+             * 
+             * @param time the retention limit
+             * @return the number of log entries dropped (always 0 for non-log DALs)
+             */
+            unsigned long dropLogsBefore(Timestamp time) override;
+            
         private:
             //Configuration
             mutable FileLogger logger;
@@ -157,10 +186,10 @@ namespace DatabaseManagement_DALs
             //File management
             unsigned long nextIntID;
             unordered_map<DBObjectID, std::string> data;
+            PartitionedLogStore * logs = nullptr; //log data (log DALs only)
             
             //Requests management
-            std::queue<DatabaseRequestID> pendingRequests;
-            unordered_map<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*> requestsData;
+            std::queue<DatabaseRequest> pendingRequests;
             
             //Thread management
             std::atomic<bool> isConnected {false};
@@ -170,7 +199,7 @@ namespace DatabaseManagement_DALs
             boost::mutex mainThreadMutex;
             boost::condition_variable mainThreadLockCondition;
             
-            void addRequest(DatabaseRequestID requestID, RequestType type, boost::any requestParameter, boost::any additionalParameter)
+            void addRequest(const DatabaseRequest & request)
             {
                 if(!isConnected)
                 {
@@ -178,13 +207,11 @@ namespace DatabaseManagement_DALs
                     return;
                 }
                 
-                tuple<RequestType, boost::any, boost::any> * data = new tuple<RequestType, boost::any, boost::any>(type, requestParameter, additionalParameter);
                 logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Add Request) > Entering critical section.");
                 boost::unique_lock<boost::mutex> requestsLock(mainThreadMutex);
                 logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Add Request) > Critical section entered.");
 
-                pendingRequests.push(requestID);
-                requestsData.insert(std::pair<DatabaseRequestID, tuple<RequestType, boost::any, boost::any>*>(requestID, data));
+                pendingRequests.push(request);
 
                 logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Add Request) > Sending notification to requests thread.");
                 mainThreadLockCondition.notify_all();
@@ -193,10 +220,31 @@ namespace DatabaseManagement_DALs
                 logger.logMessage(Utilities::FileLogSeverity::Debug, "DebugDAL (Add Request) > Exiting critical section.");
             }
             
-            void loadDataFile();
+            /**
+             * Loads the data file (if it exists).
+             * 
+             * Files without a signature hold CSV entries written by older versions; they are converted
+             * and written back in the current format, while the original file is kept with a
+             * <code>.legacy</code> suffix. Files with an unsupported version or a malformed header
+             * are rejected and left unchanged.
+             * 
+             * @return <code>true</code>, if the file was loaded or does not exist
+             */
+            bool loadDataFile();
             void saveDataFile();
             
             void mainThread();
+            
+            /**
+             * Processes the specified request with the log store.
+             * 
+             * Note: Expects the data lock to be held by the caller; the lock is released while
+             * the result event is fired.
+             * 
+             * @param request the request to be processed
+             * @param dataLock the data lock
+             */
+            void processLogRequest(const DatabaseRequest & request, boost::unique_lock<boost::mutex> & dataLock);
     };
     
     class DebugDAL::DebugDALSettingsContainer : public DatabaseSettingsContainer
@@ -216,11 +264,15 @@ namespace DatabaseManagement_DALs
             virtual long getDatabaseSize() const { return 0; }
     };
     
-    //<editor-fold defaultstate="collapsed" desc="Stringifier">
-    class DebugDAL::Stringifier
+    //<editor-fold defaultstate="collapsed" desc="LegacyEntryParser">
+    /**
+     * Parser for the CSV entries of data files written by older versions (without a file signature).
+     * 
+     * Note: Used only for converting legacy data files; new entries are always stored with <code>ContainerSerializer</code>.
+     */
+    class DebugDAL::LegacyEntryParser
     {
         public:
-            //<editor-fold defaultstate="collapsed" desc="To-Container Methods">
             static DeviceDataContainerPtr toDevice(std::string value, DBObjectID id)
             {
                 boost::char_separator<char> separator(",");
@@ -315,6 +367,7 @@ namespace DatabaseManagement_DALs
                 unsigned long length = boost::lexical_cast<unsigned long>(*currentToken);
                 currentToken++;
                 bool runIfMissed = ((*currentToken).compare("TRUE") == 0);
+                currentToken++;
                 bool deleteAfterCompl = ((*currentToken).compare("TRUE") == 0);
 
                 return ScheduleDataContainerPtr(new ScheduleDataContainer(isActive, nextRun, repetitions, type, length, runIfMissed, deleteAfterCompl, id));
@@ -382,7 +435,7 @@ namespace DatabaseManagement_DALs
                     default: actualValue = "UNDEFINED"; break;
                 }
 
-                return StatisticDataContainerPtr(new StatisticDataContainer(type, actualValue));
+                return StatisticDataContainerPtr(new StatisticDataContainer(id, type, actualValue));
             }
 
             static SyncDataContainerPtr toSync(std::string value, DBObjectID id)
@@ -449,7 +502,6 @@ namespace DatabaseManagement_DALs
                 currentToken++; //skips object ID
                 currentToken++; //skips object type
 
-                //SystemDataContainer(SystemParameterType type, boost::any value)
                 SystemParameterType type = Convert::toSystemParameterType(*currentToken);
                 currentToken++;
                 std::string stringValue = *currentToken;
@@ -485,7 +537,7 @@ namespace DatabaseManagement_DALs
                     default: actualValue = "UNDEFINED"; break;
                 }
 
-                return SystemDataContainerPtr(new SystemDataContainer(type, actualValue));
+                return SystemDataContainerPtr(new SystemDataContainer(id, type, actualValue));
             }
 
             static UserDataContainerPtr toUser(std::string value, DBObjectID id)
@@ -529,8 +581,37 @@ namespace DatabaseManagement_DALs
                 return UserDataContainerPtr(new UserDataContainer(id, username, password, level, pwReset, locked, create, login, timestampLastFailedAuth, failedAttempts, rules));
             }
 
+            /**
+             * Converts the specified legacy entry to a container.
+             * 
+             * @param value the CSV entry data
+             * @param type the type of the container
+             * @param id the ID of the container
+             * @throw runtime_error if the entry does not have all fields expected for the container type
+             * @return the container or an empty pointer, if the type is not supported
+             */
             static DataContainerPtr toContainer(std::string value, DatabaseObjectType type, DBObjectID id)
             {
+                boost::char_separator<char> separator(",");
+                boost::tokenizer<boost::char_separator<char>> tokens(value, separator);
+                
+                std::size_t expectedTokens = 2; //object ID and object type
+                switch(type)
+                {
+                    case DatabaseObjectType::DEVICE: expectedTokens += 19; break;
+                    case DatabaseObjectType::LOG: expectedTokens += 4; break;
+                    case DatabaseObjectType::SCHEDULE: expectedTokens += 7; break;
+                    case DatabaseObjectType::SESSION: expectedTokens += 12; break;
+                    case DatabaseObjectType::STATISTICS: expectedTokens += 2; break;
+                    case DatabaseObjectType::SYNC_FILE: expectedTokens += 21; break;
+                    case DatabaseObjectType::SYSTEM_SETTINGS: expectedTokens += 2; break;
+                    case DatabaseObjectType::USER: expectedTokens += 9; break;
+                    default: break;
+                }
+                
+                if(static_cast<std::size_t>(std::distance(tokens.begin(), tokens.end())) < expectedTokens)
+                    throw std::runtime_error("DebugDAL::LegacyEntryParser::toContainer() > Entry has fewer fields than expected.");
+                
                 DataContainerPtr result;
 
                 switch(type)
@@ -548,155 +629,11 @@ namespace DatabaseManagement_DALs
 
                 return result;
             }
-            //</editor-fold>
-
-            //<editor-fold defaultstate="collapsed" desc="To-String Methods">
-            static std::string toString(DataContainerPtr container)
-            {
-                std::string childContainerString;
-
-                switch(container->getDataType())
-                {
-                    case DatabaseObjectType::DEVICE: childContainerString = toString(boost::dynamic_pointer_cast<DeviceDataContainer>(container)); break;
-                    case DatabaseObjectType::LOG: childContainerString = toString(boost::dynamic_pointer_cast<LogDataContainer>(container)); break;
-                    case DatabaseObjectType::SCHEDULE: childContainerString = toString(boost::dynamic_pointer_cast<ScheduleDataContainer>(container)); break;
-                    case DatabaseObjectType::SESSION: childContainerString = toString(boost::dynamic_pointer_cast<SessionDataContainer>(container)); break;
-                    case DatabaseObjectType::STATISTICS: childContainerString = toString(boost::dynamic_pointer_cast<StatisticDataContainer>(container)); break;
-                    case DatabaseObjectType::SYNC_FILE: childContainerString = toString(boost::dynamic_pointer_cast<SyncDataContainer>(container)); break;
-                    case DatabaseObjectType::SYSTEM_SETTINGS: childContainerString = toString(boost::dynamic_pointer_cast<SystemDataContainer>(container)); break;
-                    case DatabaseObjectType::USER: childContainerString = toString(boost::dynamic_pointer_cast<UserDataContainer>(container)); break;
-                    default: childContainerString = "INVALID"; break;
-                }
-
-                return childContainerString;
-            }
-
-            static std::string toString(DeviceDataContainerPtr container)
-            {
-                return container->toString() + "," + Convert::toString(container->getDeviceOwner())
-                       + "," + container->getDeviceCommandAddress() + "," + Convert::toString(container->getDeviceCommandPort())
-                       + "," + container->getDeviceDataAddress() + "," + Convert::toString(container->getDeviceDataPort())
-                       + "," + container->getDeviceInitAddress() + "," + Convert::toString(container->getDeviceInitPort())
-                       + "," + Convert::toString(container->getTransferType()) + "," + container->getDeviceProvidedID() + "," + container->getDeviceName()
-                       + "," + Convert::toString(container->getPasswordData()) + "," + container->getDeviceInfo() + "," + Convert::toString(container->isDeviceLocked()) 
-                       + "," + Convert::toString(container->getLastSuccessfulAuthenticationTimestamp())
-                       + "," + Convert::toString(container->getLastFailedAuthenticationTimestamp())
-                       + "," + Convert::toString(container->getFailedAuthenticationAttempts())
-                       + "," + Convert::toStringFromBytes(container->getRawPublicKey())
-                       + "," + Convert::toString(container->getExpectedKeyExhange())
-                       + "," + Convert::toString(container->getDeviceType());
-            }
-
-            static std::string toString(LogDataContainerPtr container)
-            {
-                return container->toString() + "," + Convert::toString(container->getLogSeverity()) + "," + container->getLogSourceName() + ","
-                       + Convert::toString(container->getLogTimestamp()) + "," + container->getLogMessage();
-            }
-
-            static std::string toString(ScheduleDataContainerPtr container)
-            {
-                return container->toString() + "," + Convert::toString(container->isScheduleActive()) + "," + Convert::toString(container->getNextRun()) + ","
-                       + Convert::toString(container->getNumberOfRepetitions()) + "," + Convert::toString(container->getIntervalType()) + ","
-                       + Convert::toString(container->getIntervalLength()) + "," + Convert::toString(container->runScheduleIfMissed()) + ","
-                       + Convert::toString(container->deleteScheduleAfterCompletion());
-            }
-
-            static std::string toString(SessionDataContainerPtr container)
-            {
-                return container->toString() + "," + Convert::toString(container->getOpenTimestamp()) + "," + Convert::toString(container->getCloseTimestamp()) + ","
-                       + Convert::toString(container->getLastActivityTimestamp()) + "," + Convert::toString(container->getSessionType()) + ","
-                       + Convert::toString(container->getDevice()) + "," + Convert::toString(container->getUser()) + ","+ Convert::toString(container->isSessionPersistent()) + ","
-                       + Convert::toString(container->isSessionActive()) + "," + Convert::toString(container->getDataSent()) + "," + Convert::toString(container->getDataReceived()) + ","
-                       + Convert::toString(container->getCommandsSent()) + "," + Convert::toString(container->getCommandsReceived());
-            }
-
-            static std::string toString(StatisticDataContainerPtr container)
-            {
-                std::string value;
-
-                switch(container->getStatisticType())
-                {
-                    case StatisticType::INSTALL_TIMESTAMP: value = Convert::toString(boost::any_cast<boost::posix_time::ptime>(container->getStatisticValue())); break;
-                    case StatisticType::START_TIMESTAMP: value = Convert::toString(boost::any_cast<boost::posix_time::ptime>(container->getStatisticValue())); break;
-                    case StatisticType::TOTAL_FAILED_TRANSFERS: value = Convert::toString(boost::any_cast<unsigned long>(container->getStatisticValue())); break;
-                    case StatisticType::TOTAL_RETRIED_TRANSFERS: value = Convert::toString(boost::any_cast<unsigned long>(container->getStatisticValue())); break;
-                    case StatisticType::TOTAL_TRANSFERRED_DATA: value = Convert::toString(boost::any_cast<unsigned long>(container->getStatisticValue())); break;
-                    case StatisticType::TOTAL_TRANSFERRED_FILES: value = Convert::toString(boost::any_cast<unsigned long>(container->getStatisticValue())); break;
-                    default: value = "UNDEFINED"; break;
-                }
-
-                return container->toString() + "," + Convert::toString(container->getStatisticType()) + "," + value;
-            }
-
-            static std::string toString(SyncDataContainerPtr container)
-            {
-                return container->toString() + "," + container->getSyncName() + "," + container->getSyncDescription() + "," + container->getSourcePath() + "," 
-                       + container->getDestinationPath() + "," + Convert::toString(container->getSourceDevice()) + "," + Convert::toString(container->getDestinationDevice()) + ","
-                       + Convert::toString(container->isSyncOneWay()) + "," + Convert::toString(container->isSyncOneTime()) + ","
-                       + Convert::toString(container->getDirectoryConflictResolutionRule()) + "," + Convert::toString(container->getFileConflictResolutionRule()) + ","
-                       + Convert::toString(container->isEncryptionEnabled()) + "," + Convert::toString(container->isCompressionEnabled()) + "," + Convert::toString(container->getOwnerID()) + ","
-                       + container->getDestinationPermissions() + "," + Convert::toString(container->isOfflineSyncEnabled()) + "," + Convert::toString(container->isDifferentialSyncEnabled()) + ","
-                       + Convert::toString(container->getNumberOfSyncRetries()) + "," + Convert::toString(container->getFailureAction()) + ","
-                       + Convert::toString(container->getLastAttemptTimestamp()) + "," + Convert::toString(container->getLastResult()) + "," + Convert::toString(container->getLastSessionID());
-            }
-
-            static std::string toString(SystemDataContainerPtr container)
-            {
-                std::string value;
-
-                switch(container->getSystemParameterType())
-                {
-                    //TODO - any_cast to proper types (DataPoolRetention instead of unsigned long)
-                    case SystemParameterType::COMMAND_IP_ADDRESS: value = boost::any_cast<std::string>(container->getSystemParameterValue()); break;
-                    case SystemParameterType::COMMAND_IP_PORT: value = Convert::toString(boost::any_cast<unsigned int>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::COMMAND_RETRIES_MAX: value = Convert::toString(boost::any_cast<unsigned int>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DATA_IP_ADDRESS: value = boost::any_cast<std::string>(container->getSystemParameterValue()); break;
-                    case SystemParameterType::DATA_IP_PORT: value = Convert::toString(boost::any_cast<unsigned int>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DATA_RETRIES_MAX: value = Convert::toString(boost::any_cast<unsigned int>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DB_CACHE_FLUSH_INTERVAL: value = Convert::toString(boost::any_cast<unsigned long>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DB_IMMEDIATE_FLUSH: value = Convert::toString(boost::any_cast<bool>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DB_MAX_READ_RETRIES: value = Convert::toString(boost::any_cast<unsigned int>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DB_MAX_WRITE_RETRIES: value = Convert::toString(boost::any_cast<unsigned int>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::DB_OPERATION_MODE: value = Convert::toString(boost::any_cast<DatabaseManagerOperationMode>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::FORCE_COMMAND_ENCRYPTION: value = Convert::toString(boost::any_cast<bool>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::FORCE_DATA_COMPRESSION: value = Convert::toString(boost::any_cast<bool>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::FORCE_DATA_ENCRYPTION: value = Convert::toString(boost::any_cast<bool>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::IN_MEMORY_POOL_RETENTION: value = Convert::toString(boost::any_cast<unsigned long>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::IN_MEMORY_POOL_SIZE: value = Convert::toString(boost::any_cast<unsigned long>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::MINIMIZE_MEMORY_USAGE: value = Convert::toString(boost::any_cast<bool>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::PENDING_DATA_POOL_PATH: value = boost::any_cast<std::string>(container->getSystemParameterValue()); break;
-                    case SystemParameterType::PENDING_DATA_POOL_SIZE: value = Convert::toString(boost::any_cast<unsigned long>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::PENDING_DATA_RETENTION: value = Convert::toString(boost::any_cast<unsigned long>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::SESSION_KEEP_ALIVE: value = Convert::toString(boost::any_cast<bool>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::SESSION_TIMEOUT: value = Convert::toString(boost::any_cast<unsigned long>(container->getSystemParameterValue())); break;
-                    case SystemParameterType::SUPPORTED_PROTOCOLS: value = boost::any_cast<std::string>(container->getSystemParameterValue()); break;
-                    default: value = "UNDEFINED"; break;
-                }
-
-                return container->toString() + "," + Convert::toString(container->getSystemParameterType()) + "," + value;
-            }
-
-            static std::string toString(UserDataContainerPtr container)
-            {
-                return container->toString() + "," + container->getUsername() + "," + Convert::toString(container->getPasswordData())
-                        + "," + Convert::toString(container->getUserAccessLevel()) + "," + Convert::toString(container->getForcePasswordReset()) 
-                        + "," + Convert::toString(container->isUserLocked()) + "," + Convert::toString(container->getCreationTimestamp()) 
-                        + "," + Convert::toString(container->getLastSuccessfulAuthenticationTimestamp())
-                        + "," + Convert::toString(container->getLastFailedAuthenticationTimestamp())
-                        + "," + Convert::toString(container->getFailedAuthenticationAttempts());
-            }
-
-            static std::string toString(VectorDataContainerPtr container)
-            {
-                return container->toString() + "," + Convert::toString(container->getContainers().size());
-            }
-            //</editor-fold>
 
         private:
-            Stringifier();
+            LegacyEntryParser();
     };
     //</editor-fold>
 }
 
 #endif	/* DEBUGDAL_H */
-
@@ -0,0 +1,260 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PartitionedLogStore.h"
+
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include "../Containers/ContainerSerializer.h"
+
+using DatabaseManagement_Containers::ContainerSerializer;
+using DatabaseManagement_Containers::LogDataContainer;
+
+DatabaseManagement_DALs::PartitionedLogStore::PartitionedLogStore(unsigned long length, unsigned long partitionsLimit)
+: partitionLength(length), maxPartitions(partitionsLimit)
+{
+    if(partitionLength == 0)
+        throw std::invalid_argument("PartitionedLogStore::() > The partition length cannot be 0.");
+}
+
+bool DatabaseManagement_DALs::PartitionedLogStore::insert(const LogDataContainerPtr log)
+{
+    if(!log)
+        return false;
+    
+    PartitionKey key;
+    if(findPartitionKey(log->getLogID(), key))
+        return false;
+    
+    Timestamp time = log->getLogTimestamp();
+    key = getPartitionKey(time);
+    if(!isRetained(key))
+        return false;
+    
+    Partition & partition = partitions[key];
+    
+    partition.entries.insert(std::make_pair(time, Entry{log->getLogID(), log->getLogSeverity(), log->getLogSourceName(), ContainerSerializer::serialize(log)}));
+    partition.ids.insert(std::make_pair(log->getLogID(), time));
+    ++partition.severities[log->getLogSeverity()];
+    ++partition.sources[log->getLogSourceName()];
+    ++entriesNumber;
+    
+    enforceRetention();
+    return true;
+}
+
+bool DatabaseManagement_DALs::PartitionedLogStore::update(const LogDataContainerPtr log)
+{
+    if(!log || !isRetained(getPartitionKey(log->getLogTimestamp())) || !remove(log->getLogID()))
+        return false;
+    
+    return insert(log);
+}
+
+LogDataContainerPtr DatabaseManagement_DALs::PartitionedLogStore::remove(LogID id)
+{
+    std::map<PartitionKey, Partition>::iterator partition;
+    std::multimap<Timestamp, Entry>::iterator entry;
+    if(!findEntry(id, partition, entry))
+        return LogDataContainerPtr();
+    
+    LogDataContainerPtr result = boost::dynamic_pointer_cast<LogDataContainer>(ContainerSerializer::deserialize(entry->second.data));
+    
+    if(--partition->second.severities[entry->second.severity] == 0)
+        partition->second.severities.erase(entry->second.severity);
+    
+    if(--partition->second.sources[entry->second.source] == 0)
+        partition->second.sources.erase(entry->second.source);
+    
+    partition->second.ids.erase(id);
+    partition->second.entries.erase(entry);
+    --entriesNumber;
+    
+    if(partition->second.entries.empty())
+        partitions.erase(partition);
+    
+    return result;
+}
+
+LogDataContainerPtr DatabaseManagement_DALs::PartitionedLogStore::find(LogID id) const
+{
+    PartitionKey key;
+    if(!findPartitionKey(id, key))
+        return LogDataContainerPtr();
+    
+    const Partition & partition = partitions.at(key);
+    auto entries = partition.entries.equal_range(partition.ids.at(id));
+    for(auto currentEntry = entries.first; currentEntry != entries.second; ++currentEntry)
+    {
+        if(currentEntry->second.id == id)
+            return boost::dynamic_pointer_cast<LogDataContainer>(ContainerSerializer::deserialize(currentEntry->second.data));
+    }
+    
+    return LogDataContainerPtr();
+}
+
+std::vector<LogDataContainerPtr> DatabaseManagement_DALs::PartitionedLogStore::select
+(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit) const
+{
+    //selects the partitions and entries to be visited
+    auto firstPartition = partitions.begin();
+    auto lastPartition = partitions.end();
+    Timestamp startTime, endTime;
+    LogSeverity severity = LogSeverity::INVALID;
+    std::string source;
+    
+    switch(constraintType)
+    {
+        case DatabaseSelectConstraints::LOGS::GET_ALL: break;
+        case DatabaseSelectConstraints::LOGS::LIMIT_BY_SEVERITY: severity = boost::any_cast<LogSeverity>(constraintValue); break;
+        case DatabaseSelectConstraints::LOGS::LIMIT_BY_SOURCE: source = boost::any_cast<std::string>(constraintValue); break;
+        case DatabaseSelectConstraints::LOGS::LIMIT_BY_TIME_RANGE:
+        {
+            LogTimeRange range = boost::any_cast<LogTimeRange>(constraintValue);
+            startTime = range.first;
+            endTime = range.second;
+            firstPartition = partitions.lower_bound(getPartitionKey(startTime));
+            lastPartition = partitions.upper_bound(getPartitionKey(endTime));
+        } break;
+        
+        default: throw std::invalid_argument("PartitionedLogStore::select() > Unsupported constraint type encountered.");
+    }
+    
+    std::vector<LogDataContainerPtr> result;
+    unsigned long currentPosition = 0;
+    
+    for(auto currentPartition = firstPartition; currentPartition != lastPartition; ++currentPartition)
+    {
+        const Partition & partition = currentPartition->second;
+        
+        if(severity != LogSeverity::INVALID && partition.severities.find(severity) == partition.severities.end())
+            continue;
+        
+        if(!source.empty() && partition.sources.find(source) == partition.sources.end())
+            continue;
+        
+        auto firstEntry = partition.entries.begin();
+        auto lastEntry = partition.entries.end();
+        
+        if(constraintType == DatabaseSelectConstraints::LOGS::LIMIT_BY_TIME_RANGE)
+        {
+            firstEntry = partition.entries.lower_bound(startTime);
+            lastEntry = partition.entries.lower_bound(endTime);
+        }
+        
+        for(auto currentEntry = firstEntry; currentEntry != lastEntry; ++currentEntry)
+        {
+            if(severity != LogSeverity::INVALID && currentEntry->second.severity != severity)
+                continue;
+            
+            if(!source.empty() && currentEntry->second.source != source)
+                continue;
+            
+            if(currentPosition++ < offset)
+                continue;
+            
+            result.push_back(boost::dynamic_pointer_cast<LogDataContainer>(ContainerSerializer::deserialize(currentEntry->second.data)));
+            
+            if(limit > 0 && result.size() >= limit)
+                return result;
+        }
+    }
+    
+    return result;
+}
+
+unsigned long DatabaseManagement_DALs::PartitionedLogStore::dropPartitionsBefore(Timestamp time)
+{
+    return dropPartitions(partitions.begin(), partitions.lower_bound(getPartitionKey(time)));
+}
+
+void DatabaseManagement_DALs::PartitionedLogStore::clear()
+{
+    partitions.clear();
+    entriesNumber = 0;
+}
+
+DatabaseManagement_DALs::PartitionedLogStore::PartitionKey DatabaseManagement_DALs::PartitionedLogStore::getPartitionKey(Timestamp time) const
+{
+    if(time.is_special())
+        return (time.is_pos_infinity()) ? std::numeric_limits<PartitionKey>::max() : std::numeric_limits<PartitionKey>::min();
+    
+    long long seconds = (time - Timestamp(boost::gregorian::date(1970, 1, 1))).total_seconds();
+    
+    //rounds towards negative infinity, so that times before the epoch get their own partitions
+    return (seconds >= 0) ? (seconds / (long long)partitionLength) : -((-seconds + (long long)partitionLength - 1) / (long long)partitionLength);
+}
+
+bool DatabaseManagement_DALs::PartitionedLogStore::findPartitionKey(LogID id, PartitionKey & key) const
+{
+    //newer entries are more likely to be looked up
+    for(auto currentPartition = partitions.rbegin(); currentPartition != partitions.rend(); ++currentPartition)
+    {
+        if(currentPartition->second.ids.find(id) != currentPartition->second.ids.end())
+        {
+            key = currentPartition->first;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool DatabaseManagement_DALs::PartitionedLogStore::isRetained(PartitionKey key) const
+{
+    if(maxPartitions == 0 || partitions.size() < maxPartitions)
+        return true;
+    
+    return (key >= partitions.begin()->first);
+}
+
+bool DatabaseManagement_DALs::PartitionedLogStore::findEntry
+(LogID id, std::map<PartitionKey, Partition>::iterator & partition, std::multimap<Timestamp, Entry>::iterator & entry)
+{
+    PartitionKey key;
+    if(!findPartitionKey(id, key))
+        return false;
+    
+    partition = partitions.find(key);
+    auto entries = partition->second.entries.equal_range(partition->second.ids.at(id));
+    for(entry = entries.first; entry != entries.second; ++entry)
+    {
+        if(entry->second.id == id)
+            return true;
+    }
+    
+    return false;
+}
+
+unsigned long DatabaseManagement_DALs::PartitionedLogStore::dropPartitions
+(std::map<PartitionKey, Partition>::iterator first, std::map<PartitionKey, Partition>::iterator last)
+{
+    unsigned long droppedEntries = 0;
+    for(auto currentPartition = first; currentPartition != last; ++currentPartition)
+        droppedEntries += currentPartition->second.entries.size();
+    
+    partitions.erase(first, last);
+    entriesNumber -= droppedEntries;
+    return droppedEntries;
+}
+
+void DatabaseManagement_DALs::PartitionedLogStore::enforceRetention()
+{
+    if(maxPartitions > 0 && partitions.size() > maxPartitions)
+        dropPartitions(partitions.begin(), std::next(partitions.begin(), partitions.size() - maxPartitions));
+}
@@ -0,0 +1,220 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARTITIONEDLOGSTORE_H
+#define	PARTITIONEDLOGSTORE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/any.hpp>
+#include <boost/unordered_map.hpp>
+#include "../Types/Types.h"
+#include "../Containers/LogDataContainer.h"
+
+using Common_Types::LogID;
+using Common_Types::LogSeverity;
+using Common_Types::Timestamp;
+using DatabaseManagement_Types::DatabaseSelectConstraints;
+using DatabaseManagement_Types::LogTimeRange;
+using DatabaseManagement_Containers::LogDataContainerPtr;
+
+namespace DatabaseManagement_DALs
+{
+    /**
+     * Class for storing log entries in time partitions.
+     *
+     * Each partition holds the entries with timestamps in a fixed period (one hour, by default),
+     * ordered by time, together with the severities and sources found in it. Time range queries
+     * only visit the partitions in the range and severity/source queries skip all partitions
+     * that do not contain the requested value.
+     *
+     * Each partition keeps its own ID index, so lookups by ID check the partitions (newest first)
+     * and retention works on whole partitions, without visiting their entries.
+     *
+     * Note: Not thread-safe; access is expected to be synchronised by the owner.
+     */
+    class PartitionedLogStore
+    {
+        public:
+            /** Default partition length (in seconds). */
+            static const unsigned long DEFAULT_PARTITION_LENGTH = 3600;
+            
+            /**
+             * Creates a new log store.
+             *
+             * @param partitionLength the time period covered by each partition (in seconds)
+             * @param maxPartitions the maximum number of partitions to keep (0 = unlimited);
+             * the oldest partitions are dropped when the limit is exceeded
+             * @throw invalid_argument if the partition length is 0
+             */
+            PartitionedLogStore(unsigned long partitionLength = DEFAULT_PARTITION_LENGTH, unsigned long maxPartitions = 0);
+            
+            PartitionedLogStore(const PartitionedLogStore&) = delete;               //Copying not allowed (pass/access only by reference/pointer)
+            PartitionedLogStore& operator=(const PartitionedLogStore&) = delete;    //Copying not allowed (pass/access only by reference/pointer)
+            
+            /**
+             * Adds a new log entry.
+             *
+             * Note: Entries that would be placed before all retained partitions, when the partitions
+             * limit is already reached, are rejected instead of being dropped right after they are added.
+             *
+             * @param log the entry to be added
+             * @return <code>true</code>, if the entry was added (<code>false</code>, if it already exists
+             * or is older than the retained partitions)
+             */
+            bool insert(const LogDataContainerPtr log);
+            
+            /**
+             * Replaces an existing log entry.
+             *
+             * @param log the updated entry
+             * @return <code>true</code>, if the entry was replaced (<code>false</code>, if it does not exist
+             * or the updated entry is older than the retained partitions)
+             */
+            bool update(const LogDataContainerPtr log);
+            
+            /**
+             * Removes a log entry.
+             *
+             * @param id the ID of the entry to be removed
+             * @return the removed entry or <code>nullptr</code>, if it was not found
+             */
+            LogDataContainerPtr remove(LogID id);
+            
+            /**
+             * Retrieves a log entry.
+             *
+             * @param id the ID of the entry
+             * @return the entry or <code>nullptr</code>, if it was not found
+             */
+            LogDataContainerPtr find(LogID id) const;
+            
+            /**
+             * Retrieves all log entries matching the specified constraint, ordered by time.
+             *
+             * Supported constraints: <code>GET_ALL</code>, <code>LIMIT_BY_SEVERITY</code> (<code>LogSeverity</code>),
+             * <code>LIMIT_BY_SOURCE</code> (<code>std::string</code>) and <code>LIMIT_BY_TIME_RANGE</code> (<code>LogTimeRange</code>).
+             *
+             * @param constraintType the constraint type
+             * @param constraintValue the constraint value
+             * @param offset the number of matching entries to skip
+             * @param limit the maximum number of entries to retrieve (0 = unlimited)
+             * @throw invalid_argument if the constraint is not supported
+             * @throw bad_any_cast if the constraint value has an unexpected type
+             * @return the matching entries
+             */
+            std::vector<LogDataContainerPtr> select(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue,
+                                                    unsigned long offset = 0, unsigned long limit = 0) const;
+            
+            /**
+             * Drops all partitions that only contain entries older than the specified time.
+             *
+             * @param time the retention limit
+             * @return the number of entries dropped
+             */
+            unsigned long dropPartitionsBefore(Timestamp time);
+            
+            /** Removes all entries. */
+            void clear();
+            
+            /** Retrieves the number of stored entries.\n\n@return the number of entries */
+            unsigned long size() const { return entriesNumber; }
+            /** Retrieves the number of partitions.\n\n@return the number of partitions */
+            unsigned long getPartitionsCount() const { return partitions.size(); }
+            /** Retrieves the partition length.\n\n@return the partition length (in seconds) */
+            unsigned long getPartitionLength() const { return partitionLength; }
+        
+        private:
+            typedef long PartitionKey;
+            
+            /** Stored log entry. */
+            struct Entry
+            {
+                LogID id;
+                LogSeverity severity;
+                std::string source;
+                std::string data;   //serialized container
+            };
+            
+            /** Time partition. */
+            struct Partition
+            {
+                std::multimap<Timestamp, Entry> entries;                    //entries, ordered by time
+                boost::unordered_map<LogID, Timestamp> ids;                 //entry IDs and timestamps
+                std::map<LogSeverity, unsigned long> severities;            //number of entries per severity
+                boost::unordered_map<std::string, unsigned long> sources;   //number of entries per source
+            };
+            
+            unsigned long partitionLength;
+            unsigned long maxPartitions;
+            unsigned long entriesNumber = 0;
+            std::map<PartitionKey, Partition> partitions;
+            
+            /**
+             * Retrieves the key of the partition for the specified time.
+             *
+             * Note: Special time values (such as <code>not_a_date_time</code>) are placed in the first partition.
+             *
+             * @param time the entry time
+             * @return the partition key
+             */
+            PartitionKey getPartitionKey(Timestamp time) const;
+            
+            /**
+             * Finds the partition holding the entry with the specified ID.
+             *
+             * @param id the entry ID
+             * @param key the key of the partition (output)
+             * @return <code>true</code>, if the entry was found
+             */
+            bool findPartitionKey(LogID id, PartitionKey & key) const;
+            
+            /**
+             * Checks if an entry in the specified partition would be kept by the partitions limit.
+             *
+             * @param key the partition key
+             * @return <code>true</code>, if the partition exists or is not older than all retained partitions
+             */
+            bool isRetained(PartitionKey key) const;
+            
+            /**
+             * Finds the partition and entry with the specified ID.
+             *
+             * @param id the entry ID
+             * @param partition the partition holding the entry (output)
+             * @param entry the entry (output)
+             * @return <code>true</code>, if the entry was found
+             */
+            bool findEntry(LogID id, std::map<PartitionKey, Partition>::iterator & partition, std::multimap<Timestamp, Entry>::iterator & entry);
+            
+            /**
+             * Drops the specified partitions.
+             *
+             * @param first the first partition to be dropped
+             * @param last the partition after the last one to be dropped
+             * @return the number of entries dropped
+             */
+            unsigned long dropPartitions(std::map<PartitionKey, Partition>::iterator first, std::map<PartitionKey, Partition>::iterator last);
+            
+            /** Drops the oldest partitions, until the partitions limit is satisfied. */
+            void enforceRetention();
+    };
+}
+
+#endif	/* PARTITIONEDLOGSTORE_H */
+
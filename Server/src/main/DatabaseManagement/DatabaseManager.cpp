@@ -39,6 +39,13 @@ SyncServer_Core::DatabaseManager::DatabaseManager(Utilities::FileLoggerParameter
     internal_Logs       = new DatabaseManager::Functions_Logs(*this);
     internal_Sessions   = new DatabaseManager::Functions_Sessions(*this);
     
+    //the statistics flush interval follows the persisted parameter (set on every reload and change)
+    internal_System->onParameterChangeEventAttach([&](SystemParameterType type, SystemParametersSnapshotPtr snapshot)
+    {
+        if(type == SystemParameterType::DB_CACHE_FLUSH_INTERVAL || type == SystemParameterType::INVALID)
+            internal_Statistics->applyFlushInterval(snapshot);
+    });
+    
     logMessage(LogSeverity::Debug, "() > Creating queues.");
     
     statisticsTableDALs = new DALQueue(DatabaseObjectType::STATISTICS,  debugLogger, defaultQueueParams);
@@ -50,12 +57,16 @@ SyncServer_Core::DatabaseManager::DatabaseManager(Utilities::FileLoggerParameter
     logsTableDALs       = new DALQueue(DatabaseObjectType::LOG, debugLogger, defaultQueueParams);
     sessionsTableDALs   = new DALQueue(DatabaseObjectType::SESSION, debugLogger, defaultQueueParams);
     
+    setQueuesRequestTimeout(functionCallTimeout);
 }
 
 SyncServer_Core::DatabaseManager::~DatabaseManager()
 {
     logMessage(LogSeverity::Debug, "(~) > Destruction initiated.");
     
+    //the final flush of the aggregated statistics needs the queues
+    internal_Statistics->aggregator->stop();
+    
     delete statisticsTableDALs;
     delete systemTableDALs;
     delete syncFilesTableDALs;
@@ -79,17 +90,19 @@ bool SyncServer_Core::DatabaseManager::addDAL(DALPtr dal, bool enableCache)
 {
     DALPtr newDAL;
     
-    boost::lock_guard<boost::mutex> configLock(configMutex);
-    
-    if(enableCache)
-        newDAL = DALPtr(new SyncServer_Core::DatabaseManagement::DALCache(dal, debugLogger, defaultCacheParameters));
-    else
-        newDAL = dal;
+    {
+        boost::lock_guard<boost::mutex> configLock(configMutex);
+        
+        if(enableCache)
+            newDAL = DALPtr(new SyncServer_Core::DatabaseManagement::DALCache(dal, debugLogger, defaultCacheParameters));
+        else
+            newDAL = dal;
+    }
     
     switch(dal->getType())
     {
         case DatabaseObjectType::STATISTICS: return statisticsTableDALs->addDAL(newDAL); break;
-        case DatabaseObjectType::SYSTEM_SETTINGS: return systemTableDALs->addDAL(newDAL); break;
+        case DatabaseObjectType::SYSTEM_SETTINGS: return addSystemDAL(newDAL); break;
         case DatabaseObjectType::SYNC_FILE: return syncFilesTableDALs->addDAL(newDAL); break;
         case DatabaseObjectType::DEVICE: return devicesTableDALs->addDAL(newDAL); break;
         case DatabaseObjectType::SCHEDULE: return schedulesTableDALs->addDAL(newDAL); break;
@@ -111,7 +124,7 @@ bool SyncServer_Core::DatabaseManager::addDAL(DALPtr dal, DALCache::DALCachePara
     switch(dal->getType())
     {
         case DatabaseObjectType::STATISTICS: return statisticsTableDALs->addDAL(newDAL);
-        case DatabaseObjectType::SYSTEM_SETTINGS: return systemTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::SYSTEM_SETTINGS: return addSystemDAL(newDAL);
         case DatabaseObjectType::SYNC_FILE: return syncFilesTableDALs->addDAL(newDAL);
         case DatabaseObjectType::DEVICE: return devicesTableDALs->addDAL(newDAL);
         case DatabaseObjectType::SCHEDULE: return schedulesTableDALs->addDAL(newDAL);
@@ -126,6 +139,41 @@ bool SyncServer_Core::DatabaseManager::addDAL(DALPtr dal, DALCache::DALCachePara
     }
 }
 
+bool SyncServer_Core::DatabaseManager::addDAL(DALPtr dal, DALDistributedCache::DALDistributedCacheParameters cacheParams)
+{
+    DALPtr newDAL(new SyncServer_Core::DatabaseManagement::DALDistributedCache(dal, debugLogger, cacheParams));
+    
+    switch(dal->getType())
+    {
+        case DatabaseObjectType::STATISTICS: return statisticsTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::SYSTEM_SETTINGS: return addSystemDAL(newDAL);
+        case DatabaseObjectType::SYNC_FILE: return syncFilesTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::DEVICE: return devicesTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::SCHEDULE: return schedulesTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::USER: return usersTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::LOG: return logsTableDALs->addDAL(newDAL);
+        case DatabaseObjectType::SESSION: return sessionsTableDALs->addDAL(newDAL);
+        default:
+        {
+            logMessage(LogSeverity::Error, "(addDAL) > Failed to add DAL; unexpected type found <" + Convert::toString(newDAL->getType()) + ">.");
+            return false;
+        }
+    }
+}
+
+bool SyncServer_Core::DatabaseManager::addSystemDAL(DALPtr dal)
+{
+    if(!systemTableDALs->addDAL(dal))
+        return false;
+    
+    //the persisted parameters are applied as soon as they are available (e.g. the statistics flush interval);
+    //if they cannot be loaded now, they are loaded on first use
+    if(!internal_System->reloadSystemParameters())
+        logMessage(LogSeverity::Warning, "(addSystemDAL) > Failed to load the system parameters.");
+    
+    return true;
+}
+
 bool SyncServer_Core::DatabaseManager::removeDAL(const DALPtr dal)
 {
     switch(dal->getType())
@@ -244,6 +292,17 @@ void SyncServer_Core::DatabaseManager::setFunctionCallTimeout(FunctionCallTimeou
 {
     boost::lock_guard<boost::mutex> configLock(configMutex);
     functionCallTimeout = timeout;
+    setQueuesRequestTimeout(timeout);
+}
+
+void SyncServer_Core::DatabaseManager::setQueuesRequestTimeout(FunctionCallTimeoutPeriod timeout)
+{
+    //requests are not needed after the calling function has timed out
+    for(DALQueue * currentQueue : {statisticsTableDALs, systemTableDALs, syncFilesTableDALs, devicesTableDALs,
+                                   schedulesTableDALs, usersTableDALs, logsTableDALs, sessionsTableDALs})
+    {
+        currentQueue->setRequestTimeout(static_cast<unsigned long>(timeout) * 1000);
+    }
 }
 
 DALQueue::DALQueueInformation SyncServer_Core::DatabaseManager::getQueueInformation(DatabaseObjectType queueType)
@@ -309,18 +368,270 @@ std::vector<DALQueue::DALInformation> SyncServer_Core::DatabaseManager::getDALsI
     }
 }
 
+bool SyncServer_Core::DatabaseManager::selectObjectsPage
+(DALQueue * queue, boost::any constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit, vector<DataContainerPtr> & result, unsigned long & resultOffset)
+{
+    std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
+    boost::signals2::connection onFailreConnection, onSuccessConnection;
+    boost::condition_variable resultCondition;
+    boost::mutex resultMutex;
+    std::atomic<bool> resultReceived {false};
+    bool successful = false;
+    VectorDataContainerPtr containersWrapper;
+    
+    std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr data)
+    {
+        boost::lock_guard<boost::mutex> resultLock(resultMutex);
+        while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
+            boost::this_thread::yield();
+        
+        if(id == requestID)
+        {
+            containersWrapper = boost::dynamic_pointer_cast<DatabaseManagement_Containers::VectorDataContainer>(data);
+            successful = true;
+            resultReceived = true;
+            resultCondition.notify_all();
+        }
+    };
+    
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
+    {
+        boost::lock_guard<boost::mutex> resultLock(resultMutex);
+        while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
+            boost::this_thread::yield();
+        
+        if(id == requestID)
+        {
+            resultReceived = true;
+            resultCondition.notify_all();
+        }
+    };
+    
+    onSuccessConnection = queue->onSuccessEventAttach(onSuccessHandler);
+    onFailreConnection = queue->onFailureEventAttach(onFailureHandler);
+    
+    requestID = queue->addSelectRequest(constraintType, constraintValue, offset, limit);
+    
+    {
+        boost::unique_lock<boost::mutex> resultLock(resultMutex);
+        boost::system_time nextWakeup = boost::get_system_time() + boost::posix_time::seconds(functionCallTimeout);
+        while(!resultReceived && resultCondition.timed_wait(resultLock, nextWakeup));
+    }
+    
+    if(!resultReceived)
+        queue->cancelRequest(requestID);
+    
+    onSuccessConnection.disconnect();
+    onFailreConnection.disconnect();
+    
+    if(!resultReceived)
+        logMessage(LogSeverity::Error, "(selectObjectsPage) > Request <" + Convert::toString(requestID) + "> timed out.");
+    
+    resultOffset = 0;
+    if(containersWrapper)
+    {
+        result = containersWrapper->getContainers();
+        resultOffset = containersWrapper->getOffset();
+    }
+    
+    return successful;
+}
+
+template <typename TContainerPtr>
+vector<TContainerPtr> SyncServer_Core::DatabaseManager::getObjectsPage
+(DALQueue * queue, boost::any constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit)
+{
+    vector<DataContainerPtr> containers;
+    vector<TContainerPtr> result;
+    unsigned long resultOffset = 0;
+    
+    if(!selectObjectsPage(queue, constraintType, constraintValue, offset, limit, containers, resultOffset))
+        return result;
+    
+    //DALs that do not support paging return all objects, starting from the first one; the page is taken from the full list
+    std::size_t firstContainer = (offset > resultOffset) ? (offset - resultOffset) : 0;
+    for(std::size_t i = firstContainer; i < containers.size() && result.size() < limit; i++)
+        result.push_back(boost::dynamic_pointer_cast<typename TContainerPtr::element_type>(containers[i]));
+    
+    return result;
+}
+
+template <typename TContainerPtr>
+bool SyncServer_Core::DatabaseManager::streamObjects
+(DALQueue * queue, boost::any constraintType, boost::any constraintValue, unsigned long pageSize, std::function<bool(const vector<TContainerPtr> &)> callback)
+{
+    if(pageSize == 0)
+    {
+        logMessage(LogSeverity::Error, "(streamObjects) > Invalid page size supplied.");
+        return false;
+    }
+    
+    vector<DataContainerPtr> containers;
+    vector<TContainerPtr> currentPage;
+    unsigned long offset = 0;
+    unsigned long resultOffset = 0;
+    
+    while(true)
+    {
+        containers.clear();
+        if(!selectObjectsPage(queue, constraintType, constraintValue, offset, pageSize, containers, resultOffset))
+            return (offset > 0); //DALs may report a failure when there are no more objects
+        
+        if(containers.empty())
+            return true;
+        
+        //DALs that do not support paging ignore the offset and always return all objects;
+        //the remaining objects are taken from the full list and no more requests are made
+        bool offsetIgnored = (resultOffset != offset) || (containers.size() > pageSize);
+        
+        if(offsetIgnored && offset > resultOffset)
+            containers.erase(containers.begin(), containers.begin() + std::min<std::size_t>(offset - resultOffset, containers.size()));
+        
+        for(std::size_t i = 0; i < containers.size(); i += pageSize)
+        {
+            currentPage.clear();
+            for(std::size_t j = i; j < containers.size() && j < i + pageSize; j++)
+                currentPage.push_back(boost::dynamic_pointer_cast<typename TContainerPtr::element_type>(containers[j]));
+            
+            if(!callback(currentPage))
+                return true;
+        }
+        
+        if(offsetIgnored || containers.size() < pageSize)
+            return true;
+        
+        offset += containers.size();
+    }
+}
+
+SyncServer_Core::DatabaseManagement::DALQueue * SyncServer_Core::DatabaseManager::getQueue(DatabaseObjectType queueType) const
+{
+    switch(queueType)
+    {
+        case DatabaseObjectType::STATISTICS: return statisticsTableDALs;
+        case DatabaseObjectType::SYSTEM_SETTINGS: return systemTableDALs;
+        case DatabaseObjectType::SYNC_FILE: return syncFilesTableDALs;
+        case DatabaseObjectType::DEVICE: return devicesTableDALs;
+        case DatabaseObjectType::SCHEDULE: return schedulesTableDALs;
+        case DatabaseObjectType::USER: return usersTableDALs;
+        case DatabaseObjectType::LOG: return logsTableDALs;
+        case DatabaseObjectType::SESSION: return sessionsTableDALs;
+        default: return nullptr;
+    }
+}
+
+bool SyncServer_Core::DatabaseManager::streamAllObjects
+(DatabaseObjectType queueType, unsigned long pageSize, std::function<bool(const vector<DataContainerPtr> &)> callback)
+{
+    boost::any constraintType;
+    switch(queueType)
+    {
+        case DatabaseObjectType::STATISTICS: constraintType = DatabaseSelectConstraints::STATISTCS::GET_ALL; break;
+        case DatabaseObjectType::SYSTEM_SETTINGS: constraintType = DatabaseSelectConstraints::SYSTEM::GET_ALL; break;
+        case DatabaseObjectType::SYNC_FILE: constraintType = DatabaseSelectConstraints::SYNC::GET_ALL; break;
+        case DatabaseObjectType::DEVICE: constraintType = DatabaseSelectConstraints::DEVICES::GET_ALL; break;
+        case DatabaseObjectType::SCHEDULE: constraintType = DatabaseSelectConstraints::SCHEDULES::GET_ALL; break;
+        case DatabaseObjectType::USER: constraintType = DatabaseSelectConstraints::USERS::GET_ALL; break;
+        case DatabaseObjectType::LOG: constraintType = DatabaseSelectConstraints::LOGS::GET_ALL; break;
+        case DatabaseObjectType::SESSION: constraintType = DatabaseSelectConstraints::SESSIONS::GET_ALL; break;
+        default:
+        {
+            logMessage(LogSeverity::Error, "(streamAllObjects) > Unexpected type found <" + Convert::toString(queueType) + ">.");
+            return false;
+        }
+    }
+    
+    //a single page holding all objects is requested, so that DALs report an empty result as a success
+    if(pageSize == 0)
+        pageSize = std::numeric_limits<unsigned long>::max();
+    
+    return streamObjects<DataContainerPtr>(getQueue(queueType), constraintType, 0, pageSize, callback);
+}
+
 //<editor-fold defaultstate="collapsed" desc="Functions_Statistics">
 SyncServer_Core::DatabaseManager::Functions_Statistics::Functions_Statistics(DatabaseManager & parent)
 {
     parentManager = &parent;
+    
+    auto loadFunction = [&](StatisticType type, unsigned long & value)
+    {
+        bool notFound = false;
+        StatisticDataContainerPtr container = getPersistedStatistic(type, notFound);
+        if(!container)
+        {
+            //a statistic that was never stored starts at 0 and is inserted by the first flush
+            value = 0;
+            return notFound;
+        }
+        
+        if(container->getStatisticValue().type() != typeid(unsigned long))
+            return false;
+        
+        value = boost::any_cast<unsigned long>(container->getStatisticValue());
+        return true;
+    };
+    
+    auto storeFunction = [&](StatisticType type, unsigned long value)
+    {
+        return updateStatistic(type, value);
+    };
+    
+    aggregator = new StatisticsAggregator(loadFunction, storeFunction, DEFAULT_FLUSH_INTERVAL);
 }
 
 SyncServer_Core::DatabaseManager::Functions_Statistics::~Functions_Statistics()
 {
+    aggregator->stop();
     releaseLocks = true;
+    delete aggregator;
 }
 
 bool SyncServer_Core::DatabaseManager::Functions_Statistics::updateStatistic(StatisticType type, boost::any value)
+{
+    boost::lock_guard<boost::mutex> updateLock(updateMutex);
+    
+    DBObjectID statisticID = Common_Types::INVALID_OBJECT_ID;
+    bool isKnown = false;
+    
+    {
+        boost::lock_guard<boost::mutex> idsLock(statisticIDsMutex);
+        auto knownID = statisticIDs.find(type);
+        if(knownID != statisticIDs.end())
+        {
+            statisticID = knownID->second;
+            isKnown = true;
+        }
+    }
+    
+    //the stored statistic is updated in place; a new one is inserted only if the database has none
+    if(!isKnown)
+    {
+        bool notFound = false;
+        StatisticDataContainerPtr existingStatistic = getPersistedStatistic(type, notFound);
+        if(existingStatistic)
+            statisticID = existingStatistic->getContainerID();
+        else if(!notFound)
+            return false;
+    }
+    
+    if(statisticID == Common_Types::INVALID_OBJECT_ID)
+    {
+        StatisticDataContainerPtr data(new DatabaseManagement_Containers::StatisticDataContainer(type, value));
+        if(!storeStatistic(data, true))
+            return false;
+        
+        boost::lock_guard<boost::mutex> idsLock(statisticIDsMutex);
+        statisticIDs[type] = data->getContainerID();
+        return true;
+    }
+    else
+    {
+        StatisticDataContainerPtr data(new DatabaseManagement_Containers::StatisticDataContainer(statisticID, type, value));
+        return storeStatistic(data, false);
+    }
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_Statistics::storeStatistic(StatisticDataContainerPtr data, bool insert)
 {
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
     boost::signals2::connection onFailreConnection, onSuccessConnection;
@@ -332,60 +643,65 @@ bool SyncServer_Core::DatabaseManager::Functions_Statistics::updateStatistic(Sta
     std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateStatistic/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <storeStatistic/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
         while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
-            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateStatistic/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateStatistic/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <storeStatistic/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
+        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <storeStatistic/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
         
         if(id == requestID)
         {
-            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateStatistic/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <storeStatistic/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
             
             resultReceived = true;
             successful = true;
             resultCondition.notify_all();
         }
         
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateStatistic/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <storeStatistic/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateStatistic/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <storeStatistic/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
         while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
-            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateStatistic/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateStatistic/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <storeStatistic/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
+        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <storeStatistic/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
         
         if(id == requestID)
         {
-            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateStatistic/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <storeStatistic/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
             
             resultReceived = true;
             successful = false;
             resultCondition.notify_all();
         }
         
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateStatistic/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <storeStatistic/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
     onSuccessConnection = parentManager->statisticsTableDALs->onSuccessEventAttach(onSuccessHandler);
     onFailreConnection = parentManager->statisticsTableDALs->onFailureEventAttach(onFailureHandler);
     
-    StatisticDataContainerPtr data(new DatabaseManagement_Containers::StatisticDataContainer(type, value));
-    requestID = parentManager->statisticsTableDALs->addUpdateRequest(data);
+    if(insert)
+        requestID = parentManager->statisticsTableDALs->addInsertRequest(data);
+    else
+        requestID = parentManager->statisticsTableDALs->addUpdateRequest(data);
     
     {
         boost::unique_lock<boost::mutex> resultLock(resultMutex);
         boost::system_time nextWakeup = boost::get_system_time() + boost::posix_time::seconds(parentManager->functionCallTimeout);
         while(!resultReceived && !releaseLocks && resultCondition.timed_wait(resultLock, nextWakeup))
-            parentManager->logMessage(LogSeverity::Warning, ">>> <updateStatistic/TLOCK> ["+Convert::toString(requestID)+"]");
+            parentManager->logMessage(LogSeverity::Warning, ">>> <storeStatistic/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->statisticsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
-    parentManager->logMessage(LogSeverity::Warning, ">>> <updateStatistic/END> ["+Convert::toString(requestID)+"]");
+    parentManager->logMessage(LogSeverity::Warning, ">>> <storeStatistic/END> ["+Convert::toString(requestID)+"]");
     return successful;
 }
 
@@ -401,25 +717,52 @@ bool SyncServer_Core::DatabaseManager::Functions_Statistics::setSystenStartTimes
 
 bool SyncServer_Core::DatabaseManager::Functions_Statistics::incrementTotalTransferredData(TransferredDataAmount amount)
 {
-    return updateStatistic(StatisticType::TOTAL_TRANSFERRED_DATA, amount);
+    return aggregator->increment(StatisticType::TOTAL_TRANSFERRED_DATA, amount);
 }
 
 bool SyncServer_Core::DatabaseManager::Functions_Statistics::incrementTotalNumberOfTransferredFiles(TransferredFilesAmount amount)
 {
-    return updateStatistic(StatisticType::TOTAL_TRANSFERRED_FILES, amount);
+    return aggregator->increment(StatisticType::TOTAL_TRANSFERRED_FILES, amount);
 }
 
 bool SyncServer_Core::DatabaseManager::Functions_Statistics::incrementTotalNumberOfFailedTransfers(TransferredFilesAmount amount)
 {
-    return updateStatistic(StatisticType::TOTAL_FAILED_TRANSFERS, amount);
+    return aggregator->increment(StatisticType::TOTAL_FAILED_TRANSFERS, amount);
 }
 
 bool SyncServer_Core::DatabaseManager::Functions_Statistics::incrementTotalNumberOfRetriedTransfers(TransferredFilesAmount amount)
 {
-    return updateStatistic(StatisticType::TOTAL_RETRIED_TRANSFERS, amount);
+    return aggregator->increment(StatisticType::TOTAL_RETRIED_TRANSFERS, amount);
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_Statistics::flushStatistics()
+{
+    return aggregator->flush();
+}
+
+void SyncServer_Core::DatabaseManager::Functions_Statistics::applyFlushInterval(SystemParametersSnapshotPtr snapshot)
+{
+    boost::any interval = snapshot->getValue(SystemParameterType::DB_CACHE_FLUSH_INTERVAL);
+    if(interval.type() == typeid(unsigned long))
+        aggregator->setFlushInterval(boost::any_cast<unsigned long>(interval));
 }
 
 StatisticDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Statistics::getStatistic(StatisticType type)
+{
+    bool notFound = false;
+    StatisticDataContainerPtr result = getPersistedStatistic(type, notFound);
+    
+    //aggregated statistics include all increments that are not flushed yet
+    if(result && StatisticsAggregator::isAggregated(type))
+    {
+        result = StatisticDataContainerPtr(
+                new DatabaseManagement_Containers::StatisticDataContainer(result->getContainerID(), type, aggregator->getValue(type)));
+    }
+    
+    return result;
+}
+
+StatisticDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Statistics::getPersistedStatistic(StatisticType type, bool & notFound)
 {
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
     boost::signals2::connection onFailreConnection, onSuccessConnection;
@@ -448,7 +791,7 @@ StatisticDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Statistics
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getStatistic/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool objectNotFound)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getStatistic/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -460,6 +803,7 @@ StatisticDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Statistics
         {
             parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getStatistic/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
             
+            notFound = objectNotFound;
             resultReceived = true;
             resultCondition.notify_all();
         }
@@ -479,10 +823,20 @@ StatisticDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Statistics
             parentManager->logMessage(LogSeverity::Warning, ">>> <getStatistic/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->statisticsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
     parentManager->logMessage(LogSeverity::Warning, ">>> <getStatistic/END> ["+Convert::toString(requestID)+"]");
+    
+    if(result)
+    {
+        boost::lock_guard<boost::mutex> idsLock(statisticIDsMutex);
+        statisticIDs[type] = result->getContainerID();
+    }
+    
     return result;
 }
 
@@ -515,7 +869,7 @@ vector<StatisticDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_St
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getAllStatistics/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getAllStatistics/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -546,6 +900,9 @@ vector<StatisticDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_St
             parentManager->logMessage(LogSeverity::Warning, ">>> <getAllStatistics/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->statisticsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -554,7 +911,18 @@ vector<StatisticDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_St
     if(containersWrapper)
     {
         for(DataContainerPtr currentContainer : containersWrapper->getContainers())
-            result.push_back(boost::dynamic_pointer_cast<DatabaseManagement_Containers::StatisticDataContainer>(currentContainer));
+        {
+            StatisticDataContainerPtr currentStatistic = boost::dynamic_pointer_cast<DatabaseManagement_Containers::StatisticDataContainer>(currentContainer);
+            
+            if(currentStatistic && StatisticsAggregator::isAggregated(currentStatistic->getStatisticType()))
+            {
+                currentStatistic = StatisticDataContainerPtr(
+                        new DatabaseManagement_Containers::StatisticDataContainer(currentStatistic->getContainerID(), currentStatistic->getStatisticType(),
+                                                                                  aggregator->getValue(currentStatistic->getStatisticType())));
+            }
+            
+            result.push_back(currentStatistic);
+        }
     }
     
     parentManager->logMessage(LogSeverity::Warning, ">>> <getAllStatistics/END> ["+Convert::toString(requestID)+"]");
@@ -583,49 +951,34 @@ Timestamp SyncServer_Core::DatabaseManager::Functions_Statistics::getSystemStart
 
 TransferredDataAmount SyncServer_Core::DatabaseManager::Functions_Statistics::getTotalTransferredData()
 {
-    StatisticDataContainerPtr container = getStatistic(StatisticType::TOTAL_TRANSFERRED_DATA);
-    
-    if(container || container->getStatisticType() != StatisticType::TOTAL_TRANSFERRED_DATA)
-        return boost::any_cast<TransferredDataAmount>(container->getStatisticValue());
-    else
-        return Common_Types::INVALID_TRANSFERRED_DATA_AMOUNT;
+    return aggregator->getValue(StatisticType::TOTAL_TRANSFERRED_DATA);
 }
 
 TransferredFilesAmount SyncServer_Core::DatabaseManager::Functions_Statistics::getTotalNumberOfTransferredFiles()
 {
-    StatisticDataContainerPtr container = getStatistic(StatisticType::TOTAL_TRANSFERRED_FILES);
-    
-    if(container || container->getStatisticType() != StatisticType::TOTAL_TRANSFERRED_FILES)
-        return boost::any_cast<TransferredFilesAmount>(container->getStatisticValue());
-    else
-        return Common_Types::INVALID_TRANSFERRED_FILES_AMOUNT;
+    return aggregator->getValue(StatisticType::TOTAL_TRANSFERRED_FILES);
 }
 
 TransferredFilesAmount SyncServer_Core::DatabaseManager::Functions_Statistics::getTotalNumberOfFailedTransfers()
 {
-    StatisticDataContainerPtr container = getStatistic(StatisticType::TOTAL_FAILED_TRANSFERS);
-    
-    if(container || container->getStatisticType() != StatisticType::TOTAL_FAILED_TRANSFERS)
-        return boost::any_cast<TransferredFilesAmount>(container->getStatisticValue());
-    else
-        return Common_Types::INVALID_TRANSFERRED_FILES_AMOUNT;
+    return aggregator->getValue(StatisticType::TOTAL_FAILED_TRANSFERS);
 }
 
 TransferredFilesAmount SyncServer_Core::DatabaseManager::Functions_Statistics::getTotalNumberOfRetriedTransfers()
 {
-    StatisticDataContainerPtr container = getStatistic(StatisticType::TOTAL_RETRIED_TRANSFERS);
-    
-    if(container || container->getStatisticType() != StatisticType::TOTAL_RETRIED_TRANSFERS)
-        return boost::any_cast<TransferredFilesAmount>(container->getStatisticValue());
-    else
-        return Common_Types::INVALID_TRANSFERRED_FILES_AMOUNT;
+    return aggregator->getValue(StatisticType::TOTAL_RETRIED_TRANSFERS);
 }
 //</editor-fold>
 
 //<editor-fold defaultstate="collapsed" desc="Functions_System">
+const unsigned long SyncServer_Core::DatabaseManager::Functions_System::RELOAD_RETRY_INTERVAL = 5;
+
 SyncServer_Core::DatabaseManager::Functions_System::Functions_System(DatabaseManager & parent)
 {
     parentManager = &parent;
+    
+    currentSnapshot = SystemParametersSnapshotPtr(new DatabaseManagement_Types::SystemParametersSnapshot());
+    nextReloadAttempt = boost::posix_time::min_date_time;
 }
 
 SyncServer_Core::DatabaseManager::Functions_System::~Functions_System()
@@ -635,6 +988,17 @@ SyncServer_Core::DatabaseManager::Functions_System::~Functions_System()
 
 bool SyncServer_Core::DatabaseManager::Functions_System::setSystemParameter(SystemParameterType type, boost::any value)
 {
+    //a stored parameter is updated in place (the snapshot holds the IDs of all stored parameters)
+    if(!snapshotLoaded)
+        reloadSystemParameters();
+    
+    SystemDataContainerPtr existingParameter = boost::atomic_load(&currentSnapshot)->getParameter(type);
+    if(!existingParameter && !snapshotLoaded)
+    {
+        parentManager->logMessage(LogSeverity::Error, "(setSystemParameter) > Failed to set parameter; the stored parameters could not be loaded.");
+        return false;
+    }
+    
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
     boost::signals2::connection onFailreConnection, onSuccessConnection;
     boost::condition_variable resultCondition;
@@ -662,7 +1026,7 @@ bool SyncServer_Core::DatabaseManager::Functions_System::setSystemParameter(Syst
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <setSystemParameter/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <setSystemParameter/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -685,8 +1049,17 @@ bool SyncServer_Core::DatabaseManager::Functions_System::setSystemParameter(Syst
     onSuccessConnection = parentManager->systemTableDALs->onSuccessEventAttach(onSuccessHandler);
     onFailreConnection = parentManager->systemTableDALs->onFailureEventAttach(onFailureHandler);
     
-    SystemDataContainerPtr data(new DatabaseManagement_Containers::SystemDataContainer(type, value));
-    requestID = parentManager->systemTableDALs->addUpdateRequest(data);
+    SystemDataContainerPtr data;
+    if(existingParameter)
+    {
+        data = SystemDataContainerPtr(new DatabaseManagement_Containers::SystemDataContainer(existingParameter->getContainerID(), type, value));
+        requestID = parentManager->systemTableDALs->addUpdateRequest(data);
+    }
+    else
+    {
+        data = SystemDataContainerPtr(new DatabaseManagement_Containers::SystemDataContainer(type, value));
+        requestID = parentManager->systemTableDALs->addInsertRequest(data);
+    }
     
     {
         boost::unique_lock<boost::mutex> resultLock(resultMutex);
@@ -695,10 +1068,27 @@ bool SyncServer_Core::DatabaseManager::Functions_System::setSystemParameter(Syst
             parentManager->logMessage(LogSeverity::Warning, ">>> <setSystemParameter/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->systemTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
     parentManager->logMessage(LogSeverity::Warning, ">>> <setSystemParameter/END> ["+Convert::toString(requestID)+"]");
+    
+    if(successful)
+    {
+        SystemParametersSnapshotPtr newSnapshot;
+        
+        {
+            boost::lock_guard<boost::mutex> snapshotLock(snapshotMutex);
+            newSnapshot = boost::atomic_load(&currentSnapshot)->withParameter(data);
+            publishSnapshot(newSnapshot);
+        }
+        
+        onParameterChange(type, newSnapshot);
+    }
+    
     return successful;
 }
 
@@ -804,6 +1194,7 @@ bool SyncServer_Core::DatabaseManager::Functions_System::setDBImmediateLogFlushS
 
 bool SyncServer_Core::DatabaseManager::Functions_System::setDBCacheFlushInterval(unsigned long length)//0=on shutdown
 {
+    //the statistics aggregator is updated by the parameter change handler
     return setSystemParameter(SystemParameterType::DB_CACHE_FLUSH_INTERVAL, length);
 }
 
@@ -812,146 +1203,88 @@ bool SyncServer_Core::DatabaseManager::Functions_System::setDBOperationMode(Data
     return setSystemParameter(SystemParameterType::DB_OPERATION_MODE, mode);
 }
 
-SystemDataContainerPtr SyncServer_Core::DatabaseManager::Functions_System::getSystemParameter(SystemParameterType type)
+SystemParametersSnapshotPtr SyncServer_Core::DatabaseManager::Functions_System::getSystemParametersSnapshot()
 {
-    std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
-    boost::signals2::connection onFailreConnection, onSuccessConnection;
-    boost::condition_variable resultCondition;
-    boost::mutex resultMutex;
-    std::atomic<bool> resultReceived {false};
-    SystemDataContainerPtr result;
-    
-    std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr data)
+    if(!snapshotLoaded)
     {
-        boost::lock_guard<boost::mutex> resultLock(resultMutex);
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSystemParameter/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-        while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
-            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSystemParameter/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSystemParameter/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+        //a failed load is not retried by every read; the next attempt time is also set before loading,
+        //so that concurrent reads do not start several loads
+        bool attemptReload = false;
         
-        if(id == requestID)
         {
-            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSystemParameter/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-            
-            result = boost::dynamic_pointer_cast<DatabaseManagement_Containers::SystemDataContainer>(data);
-            resultReceived = true;
-            resultCondition.notify_all();
-        }
-        
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSystemParameter/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-    };
-    
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
-    {
-        boost::lock_guard<boost::mutex> resultLock(resultMutex);
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSystemParameter/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-        while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
-            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSystemParameter/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSystemParameter/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-        
-        if(id == requestID)
-        {
-            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSystemParameter/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-            
-            resultReceived = true;
-            resultCondition.notify_all();
+            boost::lock_guard<boost::mutex> attemptLock(reloadAttemptMutex);
+            boost::system_time currentTime = boost::get_system_time();
+            if(currentTime >= nextReloadAttempt)
+            {
+                nextReloadAttempt = currentTime + boost::posix_time::seconds(RELOAD_RETRY_INTERVAL);
+                attemptReload = true;
+            }
         }
         
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSystemParameter/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-    };
-    
-    onSuccessConnection = parentManager->systemTableDALs->onSuccessEventAttach(onSuccessHandler);
-    onFailreConnection = parentManager->systemTableDALs->onFailureEventAttach(onFailureHandler);
-    
-    requestID = parentManager->systemTableDALs->addSelectRequest(DatabaseSelectConstraints::SYSTEM::LIMIT_BY_TYPE, type);
-    
-    {
-        boost::unique_lock<boost::mutex> resultLock(resultMutex);
-        boost::system_time nextWakeup = boost::get_system_time() + boost::posix_time::seconds(parentManager->functionCallTimeout);
-        while(!resultReceived && !releaseLocks && resultCondition.timed_wait(resultLock, nextWakeup))
-            parentManager->logMessage(LogSeverity::Warning, ">>> <getSystemParameter/TLOCK> ["+Convert::toString(requestID)+"]");
+        if(attemptReload)
+            reloadSystemParameters();
     }
     
-    onSuccessConnection.disconnect();
-    onFailreConnection.disconnect();
-    
-    parentManager->logMessage(LogSeverity::Warning, ">>> <getSystemParameter/END> ["+Convert::toString(requestID)+"]");
-    return result;
+    return boost::atomic_load(&currentSnapshot);
 }
 
-vector<SystemDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_System::getAllSystemparameters()
+bool SyncServer_Core::DatabaseManager::Functions_System::reloadSystemParameters()
 {
-    std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
-    boost::signals2::connection onFailreConnection, onSuccessConnection;
-    boost::condition_variable resultCondition;
-    boost::mutex resultMutex;
-    std::atomic<bool> resultReceived {false};
-    VectorDataContainerPtr containersWrapper;
+    unsigned long versionBeforeLoad = boost::atomic_load(&currentSnapshot)->getVersion();
+    vector<SystemDataContainerPtr> parameters;
+    bool successful = getPersistedSystemParameters(parameters);
+    SystemParametersSnapshotPtr newSnapshot;
     
-    std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr data)
+    if(!successful)
     {
-        boost::lock_guard<boost::mutex> resultLock(resultMutex);
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getAllSystemparameters/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-        while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
-            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getAllSystemparameters/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getAllSystemparameters/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-        
-        if(id == requestID)
-        {
-            parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getAllSystemparameters/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-            
-            containersWrapper = boost::dynamic_pointer_cast<DatabaseManagement_Containers::VectorDataContainer>(data);
-            resultReceived = true;
-            resultCondition.notify_all();
-        }
-        
-        parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getAllSystemparameters/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-    };
+        //reads do not attempt another load until the retry interval elapses
+        boost::lock_guard<boost::mutex> attemptLock(reloadAttemptMutex);
+        nextReloadAttempt = boost::get_system_time() + boost::posix_time::seconds(RELOAD_RETRY_INTERVAL);
+    }
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
     {
-        boost::lock_guard<boost::mutex> resultLock(resultMutex);
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getAllSystemparameters/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-        while(requestID == DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID)
-            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getAllSystemparameters/SPINLOCK> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");;
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getAllSystemparameters/MID> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
+        boost::lock_guard<boost::mutex> snapshotLock(snapshotMutex);
+        SystemParametersSnapshotPtr current = boost::atomic_load(&currentSnapshot);
         
-        if(id == requestID)
-        {
-            parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getAllSystemparameters/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-            
-            resultReceived = true;
-            resultCondition.notify_all();
-        }
+        //the loaded parameters may be older than a change made during the load;
+        //an empty result is a valid (loaded) snapshot, so that it is not reloaded on every read
+        if(!successful || current->getVersion() != versionBeforeLoad)
+            return false;
         
-        parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getAllSystemparameters/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
-    };
-    
-    onSuccessConnection = parentManager->systemTableDALs->onSuccessEventAttach(onSuccessHandler);
-    onFailreConnection = parentManager->systemTableDALs->onFailureEventAttach(onFailureHandler);
-    
-    requestID = parentManager->systemTableDALs->addSelectRequest(DatabaseSelectConstraints::SYSTEM::GET_ALL, 0);
-    
-    {
-        boost::unique_lock<boost::mutex> resultLock(resultMutex);
-        boost::system_time nextWakeup = boost::get_system_time() + boost::posix_time::seconds(parentManager->functionCallTimeout);
-        while(!resultReceived && !releaseLocks && resultCondition.timed_wait(resultLock, nextWakeup))
-            parentManager->logMessage(LogSeverity::Warning, ">>> <getAllSystemparameters/TLOCK> ["+Convert::toString(requestID)+"]");
-    }
-    
-    onSuccessConnection.disconnect();
-    onFailreConnection.disconnect();
-    
-    vector<SystemDataContainerPtr> result;
-    
-    if(containersWrapper)
-    {
-        for(DataContainerPtr currentContainer : containersWrapper->getContainers())
-            result.push_back(boost::dynamic_pointer_cast<DatabaseManagement_Containers::SystemDataContainer>(currentContainer));
+        newSnapshot = SystemParametersSnapshotPtr(new DatabaseManagement_Types::SystemParametersSnapshot(current->getVersion() + 1, parameters));
+        publishSnapshot(newSnapshot);
+        snapshotLoaded = true;
     }
     
-    parentManager->logMessage(LogSeverity::Warning, ">>> <getAllSystemparameters/END> ["+Convert::toString(requestID)+"]");
-    return result;
+    onParameterChange(SystemParameterType::INVALID, newSnapshot);
+    return true;
+}
+
+void SyncServer_Core::DatabaseManager::Functions_System::publishSnapshot(SystemParametersSnapshotPtr snapshot)
+{
+    boost::atomic_store(&currentSnapshot, snapshot);
+}
+
+SystemDataContainerPtr SyncServer_Core::DatabaseManager::Functions_System::getSystemParameter(SystemParameterType type)
+{
+    return getSystemParametersSnapshot()->getParameter(type);
+}
+
+vector<SystemDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_System::getAllSystemparameters()
+{
+    return getSystemParametersSnapshot()->getParameters();
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_System::getPersistedSystemParameters(vector<SystemDataContainerPtr> & parameters)
+{
+    return parentManager->streamAllObjects(DatabaseObjectType::SYSTEM_SETTINGS, 0,
+        [&](const vector<DataContainerPtr> & page)
+        {
+            for(const DataContainerPtr & currentContainer : page)
+                parameters.push_back(boost::dynamic_pointer_cast<DatabaseManagement_Containers::SystemDataContainer>(currentContainer));
+            
+            return !releaseLocks;
+        });
 }
 
 IPAddress SyncServer_Core::DatabaseManager::Functions_System::getDataIPAddress()
@@ -1206,7 +1539,7 @@ bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::addSync(const SyncDa
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <addSync/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <addSync/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1238,6 +1571,9 @@ bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::addSync(const SyncDa
             parentManager->logMessage(LogSeverity::Warning, ">>> <addSync/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->syncFilesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1274,7 +1610,7 @@ bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::updateSync(const Syn
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateSync/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateSync/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1306,6 +1642,9 @@ bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::updateSync(const Syn
             parentManager->logMessage(LogSeverity::Warning, ">>> <updateSync/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->syncFilesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1342,7 +1681,7 @@ bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::removeSync(SyncID sy
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <removeSync/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <removeSync/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1374,6 +1713,9 @@ bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::removeSync(SyncID sy
             parentManager->logMessage(LogSeverity::Warning, ">>> <removeSync/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->syncFilesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1410,7 +1752,7 @@ SyncDataContainerPtr SyncServer_Core::DatabaseManager::Functions_SyncFiles::getS
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSync/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSync/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1441,6 +1783,9 @@ SyncDataContainerPtr SyncServer_Core::DatabaseManager::Functions_SyncFiles::getS
             parentManager->logMessage(LogSeverity::Warning, ">>> <getSync/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->syncFilesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1477,7 +1822,7 @@ vector<SyncDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_SyncFil
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSyncsByConstraint/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSyncsByConstraint/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1508,6 +1853,9 @@ vector<SyncDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_SyncFil
             parentManager->logMessage(LogSeverity::Warning, ">>> <getSyncsByConstraint/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->syncFilesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1564,6 +1912,18 @@ vector<SyncDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_SyncFil
 {
     return getSyncsByConstraint(DatabaseSelectConstraints::SYNC::LIMIT_BY_DIFFERENTIAL_SYNC, enabled);
 }
+
+vector<SyncDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_SyncFiles::getSyncsPage
+(DatabaseSelectConstraints::SYNC constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit)
+{
+    return parentManager->getObjectsPage<SyncDataContainerPtr>(parentManager->syncFilesTableDALs, constraintType, constraintValue, offset, limit);
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_SyncFiles::streamSyncs
+(DatabaseSelectConstraints::SYNC constraintType, boost::any constraintValue, unsigned long pageSize, std::function<bool(const vector<SyncDataContainerPtr> &)> callback)
+{
+    return parentManager->streamObjects<SyncDataContainerPtr>(parentManager->syncFilesTableDALs, constraintType, constraintValue, pageSize, callback);
+}
 //</editor-fold>
 
 //<editor-fold defaultstate="collapsed" desc="Functions_Devices">
@@ -1605,7 +1965,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::addDevice(const Device
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <addDevice/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <addDevice/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1637,9 +1997,15 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::addDevice(const Device
             parentManager->logMessage(LogSeverity::Warning, ">>> <addDevice/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->devicesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(successful)
+        missingDevices.invalidate(data->getDeviceID());
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <addDevice/END> ["+Convert::toString(requestID)+"]");
     return successful;
 }
@@ -1672,7 +2038,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::updateDevice(const Dev
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateDevice/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateDevice/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1704,9 +2070,15 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::updateDevice(const Dev
             parentManager->logMessage(LogSeverity::Warning, ">>> <updateDevice/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->devicesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(successful)
+        missingDevices.invalidate(data->getDeviceID());
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <updateDevice/END> ["+Convert::toString(requestID)+"]");
     return successful;
 }
@@ -1739,7 +2111,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::removeDevice(DeviceID
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <removeDevice/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <removeDevice/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1771,6 +2143,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::removeDevice(DeviceID
             parentManager->logMessage(LogSeverity::Warning, ">>> <removeDevice/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->devicesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1780,11 +2155,17 @@ bool SyncServer_Core::DatabaseManager::Functions_Devices::removeDevice(DeviceID
 
 DeviceDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Devices::getDevice(DeviceID device)
 {
+    if(missingDevices.contains(device))
+        return DeviceDataContainerPtr();
+    
+    unsigned long cacheGeneration = missingDevices.getGeneration();
+    
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
     boost::signals2::connection onFailreConnection, onSuccessConnection;
     boost::condition_variable resultCondition;
     boost::mutex resultMutex;
     std::atomic<bool> resultReceived {false};
+    bool resultNotFound = false;
     DeviceDataContainerPtr result;
     
     std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr data)
@@ -1807,7 +2188,7 @@ DeviceDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Devices::getD
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getDevice/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool notFound)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getDevice/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1819,6 +2200,7 @@ DeviceDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Devices::getD
         {
             parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getDevice/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
             
+            resultNotFound = notFound;
             resultReceived = true;
             resultCondition.notify_all();
         }
@@ -1838,9 +2220,15 @@ DeviceDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Devices::getD
             parentManager->logMessage(LogSeverity::Warning, ">>> <getDevice/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->devicesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(resultReceived && resultNotFound)
+        missingDevices.add(device, cacheGeneration);
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <getDevice/END> ["+Convert::toString(requestID)+"]");
     return result;
 }
@@ -1874,7 +2262,7 @@ vector<DeviceDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Devic
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getDevicesByConstraint/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getDevicesByConstraint/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -1905,6 +2293,9 @@ vector<DeviceDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Devic
             parentManager->logMessage(LogSeverity::Warning, ">>> <getDevicesByConstraint/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->devicesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -1939,6 +2330,18 @@ vector<DeviceDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Devic
 {
     return getDevicesByConstraint(DatabaseSelectConstraints::DEVICES::LIMIT_BY_ADDRESS, address);
 }
+
+vector<DeviceDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Devices::getDevicesPage
+(DatabaseSelectConstraints::DEVICES constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit)
+{
+    return parentManager->getObjectsPage<DeviceDataContainerPtr>(parentManager->devicesTableDALs, constraintType, constraintValue, offset, limit);
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_Devices::streamDevices
+(DatabaseSelectConstraints::DEVICES constraintType, boost::any constraintValue, unsigned long pageSize, std::function<bool(const vector<DeviceDataContainerPtr> &)> callback)
+{
+    return parentManager->streamObjects<DeviceDataContainerPtr>(parentManager->devicesTableDALs, constraintType, constraintValue, pageSize, callback);
+}
 //</editor-fold>
 
 //<editor-fold defaultstate="collapsed" desc="Functions_Schedules">
@@ -1981,7 +2384,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Schedules::addSchedule(const Sc
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <addSchedule/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <addSchedule/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2013,6 +2416,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Schedules::addSchedule(const Sc
             parentManager->logMessage(LogSeverity::Warning, ">>> <addSchedule/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->schedulesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2049,7 +2455,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Schedules::updateSchedule(const
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateSchedule/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateSchedule/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2081,6 +2487,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Schedules::updateSchedule(const
             parentManager->logMessage(LogSeverity::Warning, ">>> <updateSchedule/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->schedulesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2117,7 +2526,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Schedules::removeSchedule(Sched
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <removeSchedule/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <removeSchedule/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2149,6 +2558,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Schedules::removeSchedule(Sched
             parentManager->logMessage(LogSeverity::Warning, ">>> <removeSchedule/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->schedulesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2185,7 +2597,7 @@ ScheduleDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Schedules::
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSchedule/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSchedule/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2216,6 +2628,9 @@ ScheduleDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Schedules::
             parentManager->logMessage(LogSeverity::Warning, ">>> <getSchedule/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->schedulesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2252,7 +2667,7 @@ vector<ScheduleDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Sch
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSchedulesByConstraint/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSchedulesByConstraint/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2283,6 +2698,9 @@ vector<ScheduleDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Sch
             parentManager->logMessage(LogSeverity::Warning, ">>> <getSchedulesByConstraint/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->schedulesTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2325,6 +2743,20 @@ SyncServer_Core::DatabaseManager::Functions_Users::~Functions_Users()
     releaseLocks = true;
 }
 
+NegativeResultCache<string>::NegativeResultCacheInformation SyncServer_Core::DatabaseManager::Functions_Users::getNegativeCacheInformation()
+{
+    NegativeResultCache<string>::NegativeResultCacheInformation usernamesInfo = missingUsernames.getCacheInformation();
+    NegativeResultCache<UserID>::NegativeResultCacheInformation userIDsInfo = missingUserIDs.getCacheInformation();
+    
+    return NegativeResultCache<string>::NegativeResultCacheInformation
+    {
+        usernamesInfo.size + userIDsInfo.size,
+        usernamesInfo.hits + userIDsInfo.hits,
+        usernamesInfo.misses + userIDsInfo.misses,
+        usernamesInfo.evictions + userIDsInfo.evictions
+    };
+}
+
 bool SyncServer_Core::DatabaseManager::Functions_Users::addUser(const UserDataContainerPtr data)
 {
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
@@ -2354,7 +2786,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::addUser(const UserDataCo
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <addUser/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <addUser/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2386,9 +2818,18 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::addUser(const UserDataCo
             parentManager->logMessage(LogSeverity::Warning, ">>> <addUser/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->usersTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(successful)
+    {
+        missingUsernames.invalidate(data->getUsername());
+        missingUserIDs.invalidate(data->getUserID());
+    }
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <addUser/END> ["+Convert::toString(requestID)+"]");
     return successful;
 }
@@ -2422,7 +2863,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::updateUser(const UserDat
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateUser/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateUser/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2454,9 +2895,18 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::updateUser(const UserDat
             parentManager->logMessage(LogSeverity::Warning, ">>> <updateUser/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->usersTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(successful)
+    {
+        missingUsernames.invalidate(data->getUsername());
+        missingUserIDs.invalidate(data->getUserID());
+    }
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <updateUser/END> ["+Convert::toString(requestID)+"]");
     return successful;
 }
@@ -2490,7 +2940,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::removeUser(UserID user)
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <removeUser_I/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <removeUser_I/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2522,6 +2972,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::removeUser(UserID user)
             parentManager->logMessage(LogSeverity::Warning, ">>> <removeUser_I/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->usersTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2531,11 +2984,17 @@ bool SyncServer_Core::DatabaseManager::Functions_Users::removeUser(UserID user)
 
 UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(string username)
 {
+    if(missingUsernames.contains(username))
+        return UserDataContainerPtr();
+    
+    unsigned long cacheGeneration = missingUsernames.getGeneration();
+    
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
     boost::signals2::connection onFailreConnection, onSuccessConnection;
     boost::condition_variable resultCondition;
     boost::mutex resultMutex;
     std::atomic<bool> resultReceived {false};
+    bool resultNotFound = false;
     UserDataContainerPtr result;
     
     std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr data)
@@ -2558,7 +3017,7 @@ UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getUser_U/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool notFound)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getUser_U/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2570,6 +3029,7 @@ UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(
         {
             parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getUser_U/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
             
+            resultNotFound = notFound;
             resultReceived = true;
             resultCondition.notify_all();
         }
@@ -2589,20 +3049,32 @@ UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(
             parentManager->logMessage(LogSeverity::Warning, ">>> <getUser_U/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->usersTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(resultReceived && resultNotFound)
+        missingUsernames.add(username, cacheGeneration);
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <getUser_U/END> ["+Convert::toString(requestID)+"]");
     return result;
 }
 
 UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(UserID user)
 {
+    if(missingUserIDs.contains(user))
+        return UserDataContainerPtr();
+    
+    unsigned long cacheGeneration = missingUserIDs.getGeneration();
+    
     std::atomic<DatabaseRequestID> requestID {DatabaseManagement_Types::INVALID_DATABASE_REQUEST_ID};
     boost::signals2::connection onFailreConnection, onSuccessConnection;
     boost::condition_variable resultCondition;
     boost::mutex resultMutex;
     std::atomic<bool> resultReceived {false};
+    bool resultNotFound = false;
     UserDataContainerPtr result;
     
     std::function<void(DatabaseRequestID, DataContainerPtr)> onSuccessHandler = [&](DatabaseRequestID id, DataContainerPtr data)
@@ -2625,7 +3097,7 @@ UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getUser_I/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool notFound)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getUser_I/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2637,6 +3109,7 @@ UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(
         {
             parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getUser_I/IN> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
             
+            resultNotFound = notFound;
             resultReceived = true;
             resultCondition.notify_all();
         }
@@ -2656,9 +3129,15 @@ UserDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Users::getUser(
             parentManager->logMessage(LogSeverity::Warning, ">>> <getUser_I/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->usersTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
+    if(resultReceived && resultNotFound)
+        missingUserIDs.add(user, cacheGeneration);
+    
     parentManager->logMessage(LogSeverity::Warning, ">>> <getUser_I/END> ["+Convert::toString(requestID)+"]");
     return result;
 }
@@ -2692,7 +3171,7 @@ vector<UserDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Users::
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getUsersByConstraint/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getUsersByConstraint/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2723,6 +3202,9 @@ vector<UserDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Users::
             parentManager->logMessage(LogSeverity::Warning, ">>> <getUsersByConstraint/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->usersTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2752,6 +3234,18 @@ vector<UserDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Users::
 {
     return getUsersByConstraint(DatabaseSelectConstraints::USERS::LIMIT_BY_LOCKED_STATE, isUserLocked);
 }
+
+vector<UserDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Users::getUsersPage
+(DatabaseSelectConstraints::USERS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit)
+{
+    return parentManager->getObjectsPage<UserDataContainerPtr>(parentManager->usersTableDALs, constraintType, constraintValue, offset, limit);
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_Users::streamUsers
+(DatabaseSelectConstraints::USERS constraintType, boost::any constraintValue, unsigned long pageSize, std::function<bool(const vector<UserDataContainerPtr> &)> callback)
+{
+    return parentManager->streamObjects<UserDataContainerPtr>(parentManager->usersTableDALs, constraintType, constraintValue, pageSize, callback);
+}
 //</editor-fold>
 
 //<editor-fold defaultstate="collapsed" desc="Functions_Logs">
@@ -2793,7 +3287,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Logs::addLog(const LogDataConta
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <addLog/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <addLog/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2824,6 +3318,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Logs::addLog(const LogDataConta
             parentManager->logMessage(LogSeverity::Warning, ">>> <addLog/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->logsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2864,7 +3361,7 @@ LogDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Logs::getLog(Log
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getLog/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getLog/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2894,6 +3391,9 @@ LogDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Logs::getLog(Log
             parentManager->logMessage(LogSeverity::Warning, ">>> <getLog/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->logsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2929,7 +3429,7 @@ vector<LogDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Logs::ge
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getLogsByConstraint/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getLogsByConstraint/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -2960,6 +3460,9 @@ vector<LogDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Logs::ge
             parentManager->logMessage(LogSeverity::Warning, ">>> <getLogsByConstraint/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->logsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -2988,6 +3491,28 @@ vector<LogDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Logs::ge
 {
     return getLogsByConstraint(DatabaseSelectConstraints::LOGS::LIMIT_BY_SOURCE, source);
 }
+
+vector<LogDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Logs::getLogsByTimeRange(Timestamp start, Timestamp end)
+{
+    return getLogsByConstraint(DatabaseSelectConstraints::LOGS::LIMIT_BY_TIME_RANGE, DatabaseManagement_Types::LogTimeRange(start, end));
+}
+
+vector<LogDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Logs::getLogsPage
+(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit)
+{
+    return parentManager->getObjectsPage<LogDataContainerPtr>(parentManager->logsTableDALs, constraintType, constraintValue, offset, limit);
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_Logs::streamLogs
+(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue, unsigned long pageSize, std::function<bool(const vector<LogDataContainerPtr> &)> callback)
+{
+    return parentManager->streamObjects<LogDataContainerPtr>(parentManager->logsTableDALs, constraintType, constraintValue, pageSize, callback);
+}
+
+unsigned long SyncServer_Core::DatabaseManager::Functions_Logs::dropLogsBefore(Timestamp time)
+{
+    return parentManager->logsTableDALs->dropLogsBefore(time);
+}
 //</editor-fold>
 
 //<editor-fold defaultstate="collapsed" desc="Functions_Sessions">
@@ -3029,7 +3554,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Sessions::addSession(const Sess
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <addSession/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <addSession/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -3060,6 +3585,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Sessions::addSession(const Sess
             parentManager->logMessage(LogSeverity::Warning, ">>> <addSession/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->sessionsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -3096,7 +3624,7 @@ bool SyncServer_Core::DatabaseManager::Functions_Sessions::updateSession(const S
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <updateSession/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <updateSession/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -3128,6 +3656,9 @@ bool SyncServer_Core::DatabaseManager::Functions_Sessions::updateSession(const S
             parentManager->logMessage(LogSeverity::Warning, ">>> <updateSession/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->sessionsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -3164,7 +3695,7 @@ SessionDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Sessions::ge
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSession/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSession/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -3195,6 +3726,9 @@ SessionDataContainerPtr SyncServer_Core::DatabaseManager::Functions_Sessions::ge
             parentManager->logMessage(LogSeverity::Warning, ">>> <getSession/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->sessionsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -3231,7 +3765,7 @@ vector<SessionDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Sess
         parentManager->logMessage(LogSeverity::Warning, ">>> onSuccess <getSessionsByConstraint/EXT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
     };
     
-    std::function<void(DatabaseRequestID, DBObjectID)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID)
+    std::function<void(DatabaseRequestID, DBObjectID, bool)> onFailureHandler = [&](DatabaseRequestID id, DBObjectID, bool)
     {
         boost::lock_guard<boost::mutex> resultLock(resultMutex);
         parentManager->logMessage(LogSeverity::Warning, ">>> onFailure <getSessionsByConstraint/OUT> ["+Convert::toString(id)+"]|["+Convert::toString(requestID)+"]");
@@ -3262,6 +3796,9 @@ vector<SessionDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Sess
             parentManager->logMessage(LogSeverity::Warning, ">>> <getSessionsByConstraint/TLOCK> ["+Convert::toString(requestID)+"]");
     }
     
+    if(!resultReceived)
+        parentManager->sessionsTableDALs->cancelRequest(requestID);
+    
     onSuccessConnection.disconnect();
     onFailreConnection.disconnect();
     
@@ -3316,6 +3853,18 @@ vector<SessionDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Sess
 {
     return getSessionsByConstraint(DatabaseSelectConstraints::SESSIONS::LIMIT_BY_PERSISTENCY, false);
 }
+
+vector<SessionDataContainerPtr> SyncServer_Core::DatabaseManager::Functions_Sessions::getSessionsPage
+(DatabaseSelectConstraints::SESSIONS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit)
+{
+    return parentManager->getObjectsPage<SessionDataContainerPtr>(parentManager->sessionsTableDALs, constraintType, constraintValue, offset, limit);
+}
+
+bool SyncServer_Core::DatabaseManager::Functions_Sessions::streamSessions
+(DatabaseSelectConstraints::SESSIONS constraintType, boost::any constraintValue, unsigned long pageSize, std::function<bool(const vector<SessionDataContainerPtr> &)> callback)
+{
+    return parentManager->streamObjects<SessionDataContainerPtr>(parentManager->sessionsTableDALs, constraintType, constraintValue, pageSize, callback);
+}
 //</editor-fold>
 
 bool SyncServer_Core::DatabaseManager::registerInstructionSet(InstructionManagement_Sets::InstructionSetPtr<DatabaseManagerInstructionType> set) const
@@ -19,8 +19,11 @@
 #define	DATABASEMANAGER_H
 
 #include <atomic>
+#include <map>
 #include <vector>
 #include <string>
+#include <functional>
+#include <limits>
 #include <boost/any.hpp>
 #include "Types/Types.h"
 #include "../Utilities/FileLogger.h"
@@ -37,7 +40,11 @@
 #include "Interfaces/DatabaseAbstractionLayer.h"
 
 #include "DALCache.h"
+#include "DALDistributedCache.h"
 #include "DALQueue.h"
+#include "StatisticsAggregator.h"
+#include "NegativeResultCache.h"
+#include "Types/SystemParametersSnapshot.h"
 
 #include "../InstructionManagement/Types/Types.h"
 #include "../InstructionManagement/Sets/InstructionSet.h"
@@ -79,6 +86,7 @@ using DatabaseManagement_Types::DatabaseFailureAction;
 using DatabaseManagement_Types::DatabaseRequestID;
 using DatabaseManagement_Types::DatabaseAbstractionLayerID;
 using DatabaseManagement_Types::FunctionCallTimeoutPeriod;
+using DatabaseManagement_Types::SystemParametersSnapshotPtr;
 
 using DatabaseManagement_Containers::DataContainerPtr;
 using DatabaseManagement_Containers::StatisticDataContainerPtr;
@@ -92,7 +100,10 @@ using DatabaseManagement_Containers::SyncDataContainerPtr;
 using DatabaseManagement_Containers::VectorDataContainerPtr;
 
 using SyncServer_Core::DatabaseManagement::DALCache;
+using SyncServer_Core::DatabaseManagement::DALDistributedCache;
 using SyncServer_Core::DatabaseManagement::DALQueue;
+using SyncServer_Core::DatabaseManagement::StatisticsAggregator;
+using SyncServer_Core::DatabaseManagement::NegativeResultCache;
 
 using InstructionManagement_Sets::InstructionPtr;
 using InstructionManagement_Types::DatabaseManagerInstructionType;
@@ -104,6 +115,8 @@ using InstructionManagement_Types::DatabaseManagerInstructionType;
 // -> Add getters for stats from all DALQueues & the DB manager (such as # of failures, # of requests, etc) (?))
 namespace SyncServer_Core
 {
+    namespace DatabaseManagement { class DALMigrator; }
+    
     /**
      * Class for managing database access and activities.
      */
@@ -163,6 +176,19 @@ namespace SyncServer_Core
              */
             bool addDAL(DALPtr dal, DALCache::DALCacheParameters cacheParams);
             
+            /**
+             * Adds a new DAL with shared memory caching enabled.
+             * 
+             * Note: The cache is shared with all processes on the host that use
+             * the same segment name and configuration.
+             * 
+             * @param dal the DAL to be added
+             * @param cacheParams the shared cache configuration parameters
+             * 
+             * @return <code>true</code>, if the operation was successful
+             */
+            bool addDAL(DALPtr dal, DALDistributedCache::DALDistributedCacheParameters cacheParams);
+            
             /**
              * Removes a DAL.
              * 
@@ -287,6 +313,8 @@ namespace SyncServer_Core
             InstructionManagement_Types::InstructionSetType getType() const override { return InstructionManagement_Types::InstructionSetType::DATABASE_MANAGER; };
             
         private:
+            friend class DatabaseManagement::DALMigrator;
+            
             //File Logger
             Utilities::FileLoggerPtr debugLogger;
 
@@ -315,6 +343,14 @@ namespace SyncServer_Core
             Functions_Logs        *  internal_Logs;
             Functions_Sessions    *  internal_Sessions;
             
+            /**
+             * Adds the specified system settings DAL and loads the system parameters.
+             *
+             * @param dal the DAL to be added
+             * @return <code>true</code>, if the DAL was added
+             */
+            bool addSystemDAL(DALPtr dal);
+            
             /**
              * Logs the specified message, if the log handler is set.
              * 
@@ -328,27 +364,139 @@ namespace SyncServer_Core
                 if(debugLogger)
                     debugLogger->logMessage(Utilities::FileLogSeverity::Debug, "DatabaseManager " + message);
             }
+            
+            /**
+             * Retrieves a single page of the objects matching the specified constraint from the specified queue.
+             * 
+             * Note: DALs that do not support paging return all matching objects; the position of the first
+             * retrieved object in the full list is supplied via <code>resultOffset</code>.
+             * 
+             * @param queue the queue to send the request to
+             * @param constraintType the type of the constraint
+             * @param constraintValue the constraint value (if any)
+             * @param offset the number of matching objects to skip
+             * @param limit the maximum number of objects to retrieve
+             * @param result the list to be filled with the retrieved objects
+             * @param resultOffset set to the offset applied by the DAL (0, if the DAL did not apply the requested offset)
+             * @return true, if the request was successful
+             */
+            bool selectObjectsPage(DALQueue * queue, boost::any constraintType, boost::any constraintValue,
+                                   unsigned long offset, unsigned long limit, vector<DataContainerPtr> & result, unsigned long & resultOffset);
+            
+            /**
+             * Retrieves a single page of the objects matching the specified constraint.
+             * 
+             * @param queue the queue to send the request to
+             * @param constraintType the type of the constraint
+             * @param constraintValue the constraint value (if any)
+             * @param offset the number of matching objects to skip
+             * @param limit the maximum number of objects to retrieve
+             * @return the retrieved objects (an empty list denotes that there are no more objects or that the request failed)
+             */
+            template <typename TContainerPtr>
+            vector<TContainerPtr> getObjectsPage(DALQueue * queue, boost::any constraintType, boost::any constraintValue,
+                                                 unsigned long offset, unsigned long limit);
+            
+            /**
+             * Retrieves all objects matching the specified constraint, one page at a time, and
+             * passes each page to the supplied callback as soon as it is received.
+             * 
+             * At most one page is held in memory at any time, unless the DAL does not support paging.
+             * 
+             * @param queue the queue to send the requests to
+             * @param constraintType the type of the constraint
+             * @param constraintValue the constraint value (if any)
+             * @param pageSize the maximum number of objects in each page
+             * @param callback the function to be called for each page; returning <code>false</code> stops the retrieval
+             * @return true, if all requested pages were retrieved successfully
+             */
+            template <typename TContainerPtr>
+            bool streamObjects(DALQueue * queue, boost::any constraintType, boost::any constraintValue,
+                               unsigned long pageSize, std::function<bool(const vector<TContainerPtr> &)> callback);
+            
+            /**
+             * Retrieves the queue responsible for the specified object type.
+             * 
+             * @param queueType the object type
+             * @return the requested queue or <code>nullptr</code>, if the type is not valid
+             */
+            DALQueue * getQueue(DatabaseObjectType queueType) const;
+            
+            /**
+             * Sets the request timeout of all queues, based on the specified function call timeout.
+             * 
+             * @param timeout the function call timeout (in seconds)
+             */
+            void setQueuesRequestTimeout(FunctionCallTimeoutPeriod timeout);
+            
+            /**
+             * Retrieves all objects of the specified type and passes them to the supplied callback.
+             * 
+             * @param queueType the object type
+             * @param pageSize the maximum number of objects in each page (0 = all objects are retrieved with a single request)
+             * @param callback the function to be called for each page; returning <code>false</code> stops the retrieval
+             * @return true, if all requested objects were retrieved successfully
+             */
+            bool streamAllObjects(DatabaseObjectType queueType, unsigned long pageSize,
+                                  std::function<bool(const vector<DataContainerPtr> &)> callback);
     };
 
     /** Container class for database access functions. */
     class DatabaseManager::Functions_Statistics
     {
         friend class DatabaseManager;
+        friend class DatabaseManager::Functions_System;
 
         private:
             DatabaseManager * parentManager;
             std::atomic<bool> releaseLocks {false};
+            StatisticsAggregator * aggregator;  //in-memory aggregator for the TOTAL_* statistics
+            boost::mutex updateMutex;           //mutex for serialising statistic updates (a missing statistic is inserted only once)
+            boost::mutex statisticIDsMutex;     //mutex for synchronising access to the statistic IDs
+            std::map<StatisticType, DBObjectID> statisticIDs;   //IDs of the statistics stored in the database
 
             Functions_Statistics(DatabaseManager & parent);
             ~Functions_Statistics();
 
+            /**
+             * Retrieves the statistic stored in the database (without any unflushed increments)
+             * and records its ID, so that it can be updated later.
+             *
+             * @param type the statistic type
+             * @param notFound set to <code>true</code>, if the database has no such statistic (output)
+             * @return the statistic or <code>nullptr</code>, if it could not be retrieved
+             */
+            StatisticDataContainerPtr getPersistedStatistic(StatisticType type, bool & notFound);
+            
+            /**
+             * Stores the specified statistic in the database.
+             *
+             * @param data the statistic to be stored
+             * @param insert set to <code>true</code>, if the statistic is new
+             * @return <code>true</code>, if the statistic was stored
+             */
+            bool storeStatistic(StatisticDataContainerPtr data, bool insert);
+            
+            /**
+             * Sets the flush interval of the aggregated statistics from the specified snapshot,
+             * if it holds a <code>DB_CACHE_FLUSH_INTERVAL</code> parameter.
+             *
+             * @param snapshot the system parameters snapshot
+             */
+            void applyFlushInterval(SystemParametersSnapshotPtr snapshot);
+
         public:
+            /** Default time between flushes of aggregated statistics (in seconds). */
+            static const unsigned long DEFAULT_FLUSH_INTERVAL = 30;
+
             bool setSystemInstallTimestamp();   //now
             bool setSystenStartTimestamp();     //now
-            bool incrementTotalTransferredData(TransferredDataAmount amount);           //in MBs
-            bool incrementTotalNumberOfTransferredFiles(TransferredFilesAmount amount);  //
-            bool incrementTotalNumberOfFailedTransfers(TransferredFilesAmount amount);   //
-            bool incrementTotalNumberOfRetriedTransfers(TransferredFilesAmount amount);  //
+            bool incrementTotalTransferredData(TransferredDataAmount amount);           //in MBs; aggregated in memory
+            bool incrementTotalNumberOfTransferredFiles(TransferredFilesAmount amount);  //aggregated in memory
+            bool incrementTotalNumberOfFailedTransfers(TransferredFilesAmount amount);   //aggregated in memory
+            bool incrementTotalNumberOfRetriedTransfers(TransferredFilesAmount amount);  //aggregated in memory
+            bool flushStatistics();                                                     //stores all aggregated statistics now
+            StatisticsAggregator::StatisticsAggregatorInformation getAggregatorInformation() const { return aggregator->getAggregatorInformation(); }
 
             bool updateStatistic(StatisticType type, boost::any value);
             StatisticDataContainerPtr getStatistic(StatisticType type);
@@ -370,10 +518,65 @@ namespace SyncServer_Core
             DatabaseManager * parentManager;
             std::atomic<bool> releaseLocks {false};
 
+            //Parameters snapshot
+            SystemParametersSnapshotPtr currentSnapshot;    //latest snapshot (accessed only with boost::atomic_load/atomic_store)
+            boost::mutex snapshotMutex;                     //mutex for serialising snapshot changes
+            std::atomic<bool> snapshotLoaded {false};       //denotes whether the parameters were loaded from the database
+            boost::mutex reloadAttemptMutex;                //mutex for synchronising access to the next reload attempt time
+            boost::system_time nextReloadAttempt;           //earliest time for loading the parameters on first use (after a failure)
+            boost::signals2::signal<void (SystemParameterType, SystemParametersSnapshotPtr)> onParameterChange;
+            
             Functions_System(DatabaseManager & parent);
             ~Functions_System();
 
+            /**
+             * Retrieves all system parameters from the database.
+             *
+             * @param parameters the vector to receive the parameters
+             * @return <code>true</code>, if the parameters were retrieved (including when there are none)
+             */
+            bool getPersistedSystemParameters(vector<SystemDataContainerPtr> & parameters);
+            
+            /** Makes the specified snapshot current (the snapshot mutex is expected to be held by the caller). */
+            void publishSnapshot(SystemParametersSnapshotPtr snapshot);
+        
         public:
+            /** Minimum time between attempts to load the system parameters on first use (in seconds). */
+            static const unsigned long RELOAD_RETRY_INTERVAL;
+            
+            /**
+             * Retrieves the current system parameters snapshot, without locking (once the parameters are loaded).
+             *
+             * Note: The parameters are loaded from the database on first use; the snapshot
+             * is replaced on every successful parameter change. If the parameters cannot be loaded,
+             * the (empty) current snapshot is returned and the load is not attempted again
+             * for <code>RELOAD_RETRY_INTERVAL</code> seconds.
+             *
+             * @return the current snapshot
+             */
+            SystemParametersSnapshotPtr getSystemParametersSnapshot();
+            
+            /**
+             * Loads all system parameters from the database and replaces the current snapshot.
+             *
+             * @return <code>true</code>, if the parameters were loaded
+             */
+            bool reloadSystemParameters();
+            
+            /**
+             * Attaches the specified handler to the "onParameterChange" event.
+             *
+             * The handler is called with the changed parameter type (<code>INVALID</code>, if all parameters
+             * were reloaded) and the new snapshot, after the snapshot is made current.
+             *
+             * @param function the handler to be attached
+             * @return the associated connection object
+             */
+            boost::signals2::connection onParameterChangeEventAttach(std::function<void(SystemParameterType, SystemParametersSnapshotPtr)> function)
+            {
+                return onParameterChange.connect(function);
+            }
+            
             bool setSystemParameter(SystemParameterType type, boost::any value);
             bool setDataIPAddress(IPAddress address);
             bool setDataPort(IPPort port);
@@ -453,6 +656,9 @@ namespace SyncServer_Core
             vector<SyncDataContainerPtr> getSyncsByCompression(bool enabled);
             vector<SyncDataContainerPtr> getSyncsByOfflineSynchronisation(bool enabled);
             vector<SyncDataContainerPtr> getSyncsByDifferentialSynchronisation(bool enabled);
+            vector<SyncDataContainerPtr> getSyncsPage(DatabaseSelectConstraints::SYNC constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit);
+            bool streamSyncs(DatabaseSelectConstraints::SYNC constraintType, boost::any constraintValue, unsigned long pageSize,
+                             std::function<bool(const vector<SyncDataContainerPtr> &)> callback);
     };
 
     /** Container class for database access functions. */
@@ -464,10 +670,15 @@ namespace SyncServer_Core
             DatabaseManager * parentManager;
             std::atomic<bool> releaseLocks {false};
 
+            NegativeResultCache<DeviceID> missingDevices;    //IDs of devices known to be missing
+
             Functions_Devices(DatabaseManager & parent);
             ~Functions_Devices();
 
         public:
+            /** Retrieves general information for the missing devices cache.\n\n@return the requested information */
+            NegativeResultCache<DeviceID>::NegativeResultCacheInformation getNegativeCacheInformation() { return missingDevices.getCacheInformation(); }
+
             bool addDevice(const DeviceDataContainerPtr data);
             bool updateDevice(const DeviceDataContainerPtr data);
             bool removeDevice(DeviceID device);
@@ -478,6 +689,9 @@ namespace SyncServer_Core
             vector<DeviceDataContainerPtr> getDevicesByTransferType(DataTransferType xferType);
             vector<DeviceDataContainerPtr> getDevicesByOwner(UserID owner);
             vector<DeviceDataContainerPtr> getDevicesByIPAddress(IPAddress address);
+            vector<DeviceDataContainerPtr> getDevicesPage(DatabaseSelectConstraints::DEVICES constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit);
+            bool streamDevices(DatabaseSelectConstraints::DEVICES constraintType, boost::any constraintValue, unsigned long pageSize,
+                               std::function<bool(const vector<DeviceDataContainerPtr> &)> callback);
     };
 
     /** Container class for database access functions. */
@@ -513,10 +727,22 @@ namespace SyncServer_Core
             DatabaseManager * parentManager;
             std::atomic<bool> releaseLocks {false};
 
+            NegativeResultCache<string> missingUsernames;   //names of users known to be missing
+            NegativeResultCache<UserID> missingUserIDs;     //IDs of users known to be missing
+
             Functions_Users(DatabaseManager & parent);
             ~Functions_Users();
 
         public:
+            /**
+             * Retrieves general information for the missing users caches.
+             * 
+             * Note: The data of the usernames and user IDs caches is combined.
+             * 
+             * @return the requested information
+             */
+            NegativeResultCache<string>::NegativeResultCacheInformation getNegativeCacheInformation();
+
             bool addUser(const UserDataContainerPtr data);
             bool updateUser(const UserDataContainerPtr data);
             bool removeUser(UserID user);
@@ -527,6 +753,9 @@ namespace SyncServer_Core
             vector<UserDataContainerPtr> getUsers();
             vector<UserDataContainerPtr> getUsersByAccessLevel(UserAccessLevel level);
             vector<UserDataContainerPtr> getUsersByLockedState(bool isUserLocked);
+            vector<UserDataContainerPtr> getUsersPage(DatabaseSelectConstraints::USERS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit);
+            bool streamUsers(DatabaseSelectConstraints::USERS constraintType, boost::any constraintValue, unsigned long pageSize,
+                             std::function<bool(const vector<UserDataContainerPtr> &)> callback);
     };
 
     /** Container class for database access functions. */
@@ -564,6 +793,49 @@ namespace SyncServer_Core
             vector<LogDataContainerPtr> getLogsByConstraint(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue);
             vector<LogDataContainerPtr> getLogsBySeverity(LogSeverity severity);
             vector<LogDataContainerPtr> getLogsBySource(string source);
+            
+            /**
+             * Retrieves all event logs with timestamps in the specified range.
+             * 
+             * @param start the range start (inclusive)
+             * @param end the range end (exclusive)
+             * @return the requested logs
+             */
+            vector<LogDataContainerPtr> getLogsByTimeRange(Timestamp start, Timestamp end);
+            
+            /**
+             * Retrieves a single page of the event logs matching the specified constraint.
+             * 
+             * @param constraintType the type of the constraint
+             * @param constraintValue the constraint value (if any)
+             * @param offset the number of matching logs to skip
+             * @param limit the maximum number of logs to retrieve
+             * @return the retrieved logs (an empty list denotes that there are no more logs)
+             */
+            vector<LogDataContainerPtr> getLogsPage(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit);
+            
+            /**
+             * Retrieves all event logs matching the specified constraint, one page at a time.
+             * 
+             * @param constraintType the type of the constraint
+             * @param constraintValue the constraint value (if any)
+             * @param pageSize the maximum number of logs in each page
+             * @param callback the function to be called for each page; returning <code>false</code> stops the retrieval
+             * @return true, if all requested pages were retrieved successfully
+             */
+            bool streamLogs(DatabaseSelectConstraints::LOGS constraintType, boost::any constraintValue, unsigned long pageSize,
+                            std::function<bool(const vector<LogDataContainerPtr> &)> callback);
+            
+            /**
+             * Drops the event logs that are older than the specified time, from all log DALs.
+             * 
+             * Note: DALs that drop logs in whole time partitions keep the partition
+             * that contains the specified time.
+             * 
+             * @param time the retention limit
+             * @return the number of logs dropped
+             */
+            unsigned long dropLogsBefore(Timestamp time);
     };
 
     /** Container class for database access functions. */
@@ -592,6 +864,9 @@ namespace SyncServer_Core
             vector<SessionDataContainerPtr> getInactiveSessions();
             vector<SessionDataContainerPtr> getPersistentSessions();
             vector<SessionDataContainerPtr> getTemporarySessions();
+            vector<SessionDataContainerPtr> getSessionsPage(DatabaseSelectConstraints::SESSIONS constraintType, boost::any constraintValue, unsigned long offset, unsigned long limit);
+            bool streamSessions(DatabaseSelectConstraints::SESSIONS constraintType, boost::any constraintValue, unsigned long pageSize,
+                                std::function<bool(const vector<SessionDataContainerPtr> &)> callback);
     };
 }
 #endif	/* DATABASEMANAGER_H */
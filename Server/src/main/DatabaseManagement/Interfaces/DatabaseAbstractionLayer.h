@@ -19,17 +19,22 @@
 #define	DATABASEABSTRACTIONLAYER_H
 
 #include <string>
+#include <vector>
 #include <boost/any.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/signals2/signal.hpp>
 #include "../Types/Types.h"
+#include "../Types/DatabaseRequest.h"
 #include "../Containers/DataContainer.h"
 #include "DatabaseSettingsContainer.h"
 #include "DatabaseInformationContainer.h"
 
 using Common_Types::DBObjectID;
+using Common_Types::Timestamp;
 using DatabaseManagement_Types::DatabaseObjectType;
 using DatabaseManagement_Types::DatabaseRequestID;
+using DatabaseManagement_Types::DatabaseRequestType;
+using DatabaseManagement_Types::DatabaseRequest;
 using DatabaseManagement_Types::DatabaseAbstractionLayerID;
 
 using DatabaseManagement_Containers::DataContainerPtr;
@@ -61,6 +66,30 @@ namespace DatabaseManagement_Interfaces
              */
             virtual bool getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue) = 0;
             
+            /**
+             * Requests the retrieval of a single page of the objects matching the specified constraint.
+             * 
+             * Note: The result will be supplied via an onSuccess/onFailure event, with the given ID;
+             * on success, it is a <code>VectorDataContainer</code> holding at most <code>limit</code> objects
+             * (an empty container denotes that there are no more objects).
+             * 
+             * The default implementation ignores the page and retrieves all matching objects; callers are
+             * expected to handle results larger than the requested page. DALs that can retrieve
+             * objects in pages should override it.
+             * 
+             * @param requestID the ID of the request
+             * @param constraintType the type of the constraint (selected from the enum subclasses of DatabaseManagement_Types::DatabaseSelectConstraints)
+             * @param constraintValue associated constraint value (if any)
+             * @param offset the number of matching objects to skip
+             * @param limit the maximum number of objects to retrieve
+             * @return true, if the request was successful
+             */
+            virtual bool getObjectsPage(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                                        unsigned long offset, unsigned long limit)
+            {
+                return getObject(requestID, constraintType, constraintValue);
+            }
+            
             /**
              * Requests an object insertion.
              * 
@@ -94,6 +123,89 @@ namespace DatabaseManagement_Interfaces
              */
             virtual bool removeObject(DatabaseRequestID requestID, DBObjectID id) = 0;
             
+            /**
+             * Requests the processing of a batch of requests as a single unit.
+             * 
+             * Note: The results will be supplied via onSuccess/onFailure events, one for each request in the batch.
+             * 
+             * Note: The request objects are only valid for the duration of the call;
+             * DALs that process them asynchronously need to keep their own copies.
+             * 
+             * The default implementation forwards each request to the associated single-request method;
+             * DALs that can process multiple requests at once (for example, in a single transaction) should override it.
+             * 
+             * Note: Requests that could not be submitted are added to <code>rejectedRequests</code>;
+             * no onSuccess/onFailure events will be sent for them and the caller is responsible for retrying
+             * or failing them. All other requests in the batch were accepted and will receive a response.
+             * 
+             * @param requests the requests to be processed, in order
+             * @param rejectedRequests container to which all requests that could not be submitted are added
+             * @return true, if all requests were successfully submitted
+             */
+            virtual bool processBatch(const std::vector<const DatabaseRequest *> & requests, std::vector<const DatabaseRequest *> & rejectedRequests)
+            {
+                bool allSubmitted = true;
+                
+                for(const DatabaseRequest * currentRequest : requests)
+                {
+                    bool result = false;
+                    
+                    switch(currentRequest->getType())
+                    {
+                        case DatabaseRequestType::SELECT:
+                        {
+                            const DatabaseManagement_Types::SelectConstraint & constraint = currentRequest->getConstraint();
+                            
+                            if(constraint.limit > 0)
+                                result = getObjectsPage(currentRequest->getID(), constraint.type, constraint.value, constraint.offset, constraint.limit);
+                            else
+                                result = getObject(currentRequest->getID(), constraint.type, constraint.value);
+                        } break;
+                        
+                        case DatabaseRequestType::INSERT:
+                        {
+                            result = putObject(currentRequest->getID(), currentRequest->getContainer());
+                        } break;
+                        
+                        case DatabaseRequestType::UPDATE:
+                        {
+                            result = updateObject(currentRequest->getID(), currentRequest->getContainer());
+                        } break;
+                        
+                        case DatabaseRequestType::REMOVE:
+                        {
+                            result = removeObject(currentRequest->getID(), currentRequest->getObjectID());
+                        } break;
+                        
+                        default: result = false; break;
+                    }
+                    
+                    if(!result)
+                    {
+                        rejectedRequests.push_back(currentRequest);
+                        allSubmitted = false;
+                    }
+                }
+                
+                return allSubmitted;
+            }
+            
+            /**
+             * Drops the stored event logs that are older than the specified time.
+             * 
+             * The default implementation drops nothing; DALs that store logs should override it.
+             * 
+             * Note: DALs may keep some of the older logs (for example, when retention works on
+             * whole time partitions); logs newer than the specified time are never dropped.
+             * 
+             * @param time the retention limit
+             * @return the number of logs dropped
+             */
+            virtual unsigned long dropLogsBefore(Timestamp time)
+            {
+                return 0;
+            }
+            
             /**
              * Updates the DAL's database settings, if applicable.
              * 
@@ -174,10 +286,13 @@ namespace DatabaseManagement_Interfaces
             /**
              * Attaches the specified event handler to the "onFailure" event of the DAL.
              * 
+             * The last handler parameter is <code>true</code> only if a SELECT request completed
+             * without finding any matching objects; it is <code>false</code> for all other failures.
+             * 
              * @param function the handler to be attached
              * @return the associated connection object
              */
-            boost::signals2::connection onFailureEventAttach(std::function<void(DatabaseAbstractionLayerID, DatabaseRequestID, DBObjectID)> function) { return onFailure.connect(function); }
+            boost::signals2::connection onFailureEventAttach(std::function<void(DatabaseAbstractionLayerID, DatabaseRequestID, DBObjectID, bool)> function) { return onFailure.connect(function); }
             
             /**
              * Attaches the specified event handler to the "onSuccess" event of the DAL.
@@ -188,7 +303,7 @@ namespace DatabaseManagement_Interfaces
             boost::signals2::connection onSuccessEventAttach(std::function<void(DatabaseAbstractionLayerID, DatabaseRequestID, DataContainerPtr)> function) { return onSuccess.connect(function); }
             
         protected:
-            boost::signals2::signal<void (DatabaseAbstractionLayerID, DatabaseRequestID, DBObjectID)> onFailure;
+            boost::signals2::signal<void (DatabaseAbstractionLayerID, DatabaseRequestID, DBObjectID, bool)> onFailure; //DAL ID, request ID, object ID, not found
             boost::signals2::signal<void (DatabaseAbstractionLayerID, DatabaseRequestID, DataContainerPtr)> onSuccess;
     };
     
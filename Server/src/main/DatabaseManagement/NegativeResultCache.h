@@ -0,0 +1,200 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEGATIVERESULTCACHE_H
+#define	NEGATIVERESULTCACHE_H
+
+#include <deque>
+#include <atomic>
+#include <utility>
+#include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace SyncServer_Core
+{
+    namespace DatabaseManagement
+    {
+        /**
+         * Bounded cache of keys for which the database returned no object.
+         *
+         * Entries expire after a fixed period; when the cache is full, the oldest entries
+         * are evicted first. Lookups started before an invalidation are not allowed to add
+         * entries after it (see <code>getGeneration()</code>), so that a slow miss cannot
+         * hide an object added in the meantime.
+         *
+         * Note: Thread-safe.
+         *
+         * @param Key the key type (must be hashable with <code>boost::hash</code>)
+         */
+        template <typename Key>
+        class NegativeResultCache
+        {
+            public:
+                /** Information structure for holding <code>NegativeResultCache</code> data. */
+                struct NegativeResultCacheInformation
+                {
+                    std::size_t size;           //number of entries
+                    unsigned long hits;         //number of lookups answered by the cache
+                    unsigned long misses;       //number of lookups not answered by the cache
+                    unsigned long evictions;    //number of entries removed due to the size limit
+                };
+                
+                /** Default maximum number of entries. */
+                static const std::size_t DEFAULT_MAX_ENTRIES = 10000;
+                /** Default time after which entries expire (in seconds). */
+                static const unsigned long DEFAULT_ENTRY_AGE = 30;
+                
+                /**
+                 * Creates a new cache.
+                 *
+                 * @param maxEntries the maximum number of entries (0 = cache disabled)
+                 * @param entryAge the time after which entries expire (in seconds)
+                 */
+                NegativeResultCache(std::size_t maxEntries = DEFAULT_MAX_ENTRIES, unsigned long entryAge = DEFAULT_ENTRY_AGE)
+                : maxSize(maxEntries), maxAge(entryAge)
+                {}
+                
+                NegativeResultCache(const NegativeResultCache&) = delete;               //Copying not allowed (pass/access only by reference/pointer)
+                NegativeResultCache& operator=(const NegativeResultCache&) = delete;    //Copying not allowed (pass/access only by reference/pointer)
+                
+                /**
+                 * Checks if the specified key is known to be missing.
+                 *
+                 * @param key the key to check
+                 * @return <code>true</code>, if the key has an entry that has not expired
+                 */
+                bool contains(const Key & key)
+                {
+                    boost::lock_guard<boost::mutex> cacheLock(cacheMutex);
+                    
+                    auto entry = entries.find(key);
+                    if(entry != entries.end())
+                    {
+                        if(entry->second.first > boost::posix_time::microsec_clock::universal_time())
+                        {
+                            ++hits;
+                            return true;
+                        }
+                        
+                        entries.erase(entry);
+                    }
+                    
+                    ++misses;
+                    return false;
+                }
+                
+                /**
+                 * Retrieves the current cache generation.
+                 *
+                 * Note: Should be retrieved before the database lookup and supplied to <code>add()</code>.
+                 *
+                 * @return the generation
+                 */
+                unsigned long getGeneration() const
+                {
+                    return generation;
+                }
+                
+                /**
+                 * Adds an entry for the specified key, unless an invalidation happened after the lookup started.
+                 *
+                 * @param key the missing key
+                 * @param lookupGeneration the cache generation retrieved before the lookup
+                 */
+                void add(const Key & key, unsigned long lookupGeneration)
+                {
+                    if(maxSize == 0)
+                        return;
+                    
+                    boost::lock_guard<boost::mutex> cacheLock(cacheMutex);
+                    
+                    if(lookupGeneration != generation)
+                        return;
+                    
+                    boost::posix_time::ptime expiration = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::seconds(maxAge);
+                    unsigned long sequence = ++nextSequence;
+                    entries[key] = std::make_pair(expiration, sequence);
+                    insertionOrder.push_back(std::make_pair(key, sequence));
+                    
+                    //removes the oldest entries (and stale order records of re-added or removed keys)
+                    while(entries.size() > maxSize || insertionOrder.size() > 2 * maxSize)
+                    {
+                        const std::pair<Key, unsigned long> & oldest = insertionOrder.front();
+                        auto entry = entries.find(oldest.first);
+                        if(entry != entries.end() && entry->second.second == oldest.second)
+                        {
+                            entries.erase(entry);
+                            ++evictions;
+                        }
+                        
+                        insertionOrder.pop_front();
+                    }
+                }
+                
+                /**
+                 * Removes the entry for the specified key and invalidates all lookups in progress.
+                 *
+                 * @param key the key that now exists
+                 */
+                void invalidate(const Key & key)
+                {
+                    boost::lock_guard<boost::mutex> cacheLock(cacheMutex);
+                    ++generation;
+                    entries.erase(key);
+                }
+                
+                /** Removes all entries and invalidates all lookups in progress. */
+                void clear()
+                {
+                    boost::lock_guard<boost::mutex> cacheLock(cacheMutex);
+                    ++generation;
+                    entries.clear();
+                    insertionOrder.clear();
+                }
+                
+                /**
+                 * Retrieves general information for the cache.
+                 *
+                 * @return the requested information
+                 */
+                NegativeResultCacheInformation getCacheInformation()
+                {
+                    boost::lock_guard<boost::mutex> cacheLock(cacheMutex);
+                    return NegativeResultCacheInformation{entries.size(), hits, misses, evictions};
+                }
+            
+            private:
+                std::size_t maxSize;
+                unsigned long maxAge;
+                
+                boost::mutex cacheMutex;
+                boost::unordered_map<Key, std::pair<boost::posix_time::ptime, unsigned long>> entries;  //expiration time and sequence, by key
+                std::deque<std::pair<Key, unsigned long>> insertionOrder;                               //keys and sequences, oldest first
+                unsigned long nextSequence = 0;
+                std::atomic<unsigned long> generation {0};
+                
+                //Stats
+                unsigned long hits = 0;
+                unsigned long misses = 0;
+                unsigned long evictions = 0;
+        };
+    }
+}
+
+#endif	/* NEGATIVERESULTCACHE_H */
+
@@ -0,0 +1,232 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StatisticsAggregator.h"
+
+#include <boost/functional/hash.hpp>
+
+SyncServer_Core::DatabaseManagement::StatisticsAggregator::StatisticsAggregator
+(LoadFunction loadFunction, StoreFunction storeFunction, unsigned long interval)
+: load(loadFunction), store(storeFunction), flushInterval(interval)
+{
+    flushThreadObject = new boost::thread(&DatabaseManagement::StatisticsAggregator::flushThread, this);
+}
+
+SyncServer_Core::DatabaseManagement::StatisticsAggregator::~StatisticsAggregator()
+{
+    stop();
+}
+
+bool SyncServer_Core::DatabaseManagement::StatisticsAggregator::increment(StatisticType type, unsigned long amount)
+{
+    unsigned int index = getCounterIndex(type);
+    if(index >= COUNTERS_NUMBER)
+        return false;
+    
+    std::size_t shard = boost::hash<boost::thread::id>()(boost::this_thread::get_id()) % SHARDS_NUMBER;
+    counters[index].shards[shard].value.fetch_add(amount, std::memory_order_relaxed);
+    increments.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+unsigned long SyncServer_Core::DatabaseManagement::StatisticsAggregator::getValue(StatisticType type)
+{
+    unsigned int index = getCounterIndex(type);
+    if(index >= COUNTERS_NUMBER)
+        return 0;
+    
+    Counter & counter = counters[index];
+    ensureLoaded(type, counter, false);
+    
+    //flushes move increments into the persisted value while holding the same lock
+    boost::lock_guard<boost::mutex> valuesLock(valuesMutex);
+    
+    unsigned long result = counter.persistedValue;
+    for(const CounterShard & currentShard : counter.shards)
+        result += currentShard.value.load(std::memory_order_relaxed);
+    
+    return result;
+}
+
+bool SyncServer_Core::DatabaseManagement::StatisticsAggregator::flush()
+{
+    boost::lock_guard<boost::mutex> flushLock(flushMutex);
+    bool successful = true;
+    
+    for(unsigned int i = 0; i < COUNTERS_NUMBER; i++)
+    {
+        Counter & counter = counters[i];
+        StatisticType type = getCounterType(i);
+        unsigned long newValue = 0;
+        
+        if(!ensureLoaded(type, counter, true))
+        {
+            successful = false;
+            continue; //increments remain in the shards until the persisted value is available
+        }
+        
+        {
+            boost::lock_guard<boost::mutex> valuesLock(valuesMutex);
+            unsigned long delta = 0;
+            for(CounterShard & currentShard : counter.shards)
+                delta += currentShard.value.exchange(0, std::memory_order_relaxed);
+            
+            if(delta > 0)
+            {
+                counter.persistedValue += delta;
+                counter.isDirty = true;
+            }
+            
+            if(!counter.isDirty)
+                continue;
+            
+            newValue = counter.persistedValue;
+        }
+        
+        if(store(type, newValue))
+        {
+            ++storedValues;
+            
+            boost::lock_guard<boost::mutex> valuesLock(valuesMutex);
+            if(counter.persistedValue == newValue)
+                counter.isDirty = false;
+        }
+        else
+        {
+            ++failedStores;
+            successful = false;
+        }
+    }
+    
+    ++flushes;
+    return successful;
+}
+
+void SyncServer_Core::DatabaseManagement::StatisticsAggregator::stop()
+{
+    {
+        boost::lock_guard<boost::mutex> threadLock(flushThreadMutex);
+        if(stopAggregator)
+            return;
+        
+        stopAggregator = true;
+        flushThreadLockCondition.notify_all();
+    }
+    
+    flushThreadObject->join();
+    delete flushThreadObject;
+    flushThreadObject = nullptr;
+    
+    flush();
+}
+
+void SyncServer_Core::DatabaseManagement::StatisticsAggregator::setFlushInterval(unsigned long interval)
+{
+    boost::lock_guard<boost::mutex> threadLock(flushThreadMutex);
+    flushInterval = interval;
+    flushThreadLockCondition.notify_all();
+}
+
+SyncServer_Core::DatabaseManagement::StatisticsAggregator::StatisticsAggregatorInformation
+SyncServer_Core::DatabaseManagement::StatisticsAggregator::getAggregatorInformation() const
+{
+    return StatisticsAggregatorInformation{flushInterval, increments, flushes, storedValues, failedStores, failedLoads};
+}
+
+void SyncServer_Core::DatabaseManagement::StatisticsAggregator::flushThread()
+{
+    boost::unique_lock<boost::mutex> threadLock(flushThreadMutex);
+    
+    while(!stopAggregator)
+    {
+        unsigned long currentInterval = flushInterval;
+        
+        if(currentInterval == 0)
+        {
+            flushThreadLockCondition.wait(threadLock);
+            continue;
+        }
+        
+        boost::system_time nextFlush = boost::get_system_time() + boost::posix_time::seconds(currentInterval);
+        while(!stopAggregator && flushInterval == currentInterval && flushThreadLockCondition.timed_wait(threadLock, nextFlush));
+        
+        if(stopAggregator || flushInterval != currentInterval)
+            continue; //the final flush is done by stop(); a new interval restarts the wait
+        
+        threadLock.unlock();
+        flush();
+        threadLock.lock();
+    }
+}
+
+bool SyncServer_Core::DatabaseManagement::StatisticsAggregator::ensureLoaded(StatisticType type, Counter & counter, bool retryFailed)
+{
+    {
+        boost::lock_guard<boost::mutex> valuesLock(valuesMutex);
+        if(counter.isLoaded)
+            return true;
+        
+        if(counter.loadFailed && !retryFailed)
+            return false;
+    }
+    
+    //the database is accessed without the lock, so that other statistics can still be read
+    unsigned long value = 0;
+    bool loaded = load(type, value);
+    
+    boost::lock_guard<boost::mutex> valuesLock(valuesMutex);
+    if(counter.isLoaded)
+        return true; //loaded by another caller in the meantime
+    
+    if(loaded)
+    {
+        counter.persistedValue = value;
+        counter.isLoaded = true;
+        counter.loadFailed = false;
+    }
+    else
+    {
+        ++failedLoads;
+        counter.loadFailed = true;
+    }
+    
+    return counter.isLoaded;
+}
+
+unsigned int SyncServer_Core::DatabaseManagement::StatisticsAggregator::getCounterIndex(StatisticType type)
+{
+    switch(type)
+    {
+        case StatisticType::TOTAL_TRANSFERRED_DATA: return 0;
+        case StatisticType::TOTAL_TRANSFERRED_FILES: return 1;
+        case StatisticType::TOTAL_FAILED_TRANSFERS: return 2;
+        case StatisticType::TOTAL_RETRIED_TRANSFERS: return 3;
+        default: return COUNTERS_NUMBER;
+    }
+}
+
+StatisticType SyncServer_Core::DatabaseManagement::StatisticsAggregator::getCounterType(unsigned int index)
+{
+    switch(index)
+    {
+        case 0: return StatisticType::TOTAL_TRANSFERRED_DATA;
+        case 1: return StatisticType::TOTAL_TRANSFERRED_FILES;
+        case 2: return StatisticType::TOTAL_FAILED_TRANSFERS;
+        case 3: return StatisticType::TOTAL_RETRIED_TRANSFERS;
+        default: return StatisticType::INVALID;
+    }
+}
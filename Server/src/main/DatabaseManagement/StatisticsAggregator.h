@@ -0,0 +1,228 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATISTICSAGGREGATOR_H
+#define	STATISTICSAGGREGATOR_H
+
+#include <atomic>
+#include <functional>
+#include <boost/thread.hpp>
+#include "Types/Types.h"
+
+using DatabaseManagement_Types::StatisticType;
+
+namespace SyncServer_Core
+{
+    namespace DatabaseManagement
+    {
+        /**
+         * Class for aggregating counter statistics in memory and periodically
+         * flushing them to the database.
+         *
+         * Increments are added to one of several atomic shards (selected by the calling thread),
+         * so that concurrent increments do not contend on a single value and never wait for the database.
+         * At each flush, the shards are merged into the persisted value, which is then stored.
+         *
+         * Reads always combine the persisted value with all unflushed increments.
+         *
+         * Note: Only the <code>TOTAL_*</code> statistics are aggregated; the persisted value of
+         * a statistic is loaded on first use (without blocking other readers) and increments are kept
+         * in memory until it is available. A failed load is retried only by the next flush.
+         */
+        class StatisticsAggregator
+        {
+            public:
+                /**
+                 * Function for retrieving the persisted value of a statistic.
+                 *
+                 * @param type the statistic type
+                 * @param value the retrieved value (output)
+                 * @return <code>true</code>, if the value was retrieved
+                 */
+                typedef std::function<bool (StatisticType type, unsigned long & value)> LoadFunction;
+                
+                /**
+                 * Function for storing the new value of a statistic.
+                 *
+                 * @param type the statistic type
+                 * @param value the value to be stored
+                 * @return <code>true</code>, if the value was stored
+                 */
+                typedef std::function<bool (StatisticType type, unsigned long value)> StoreFunction;
+                
+                /** Information structure for holding <code>StatisticsAggregator</code> data. */
+                struct StatisticsAggregatorInformation
+                {
+                    unsigned long flushInterval;    //flush interval (in seconds; 0 = only on stop)
+                    unsigned long increments;       //number of increments received
+                    unsigned long flushes;          //number of completed flushes
+                    unsigned long storedValues;     //number of values stored
+                    unsigned long failedStores;     //number of values that could not be stored
+                    unsigned long failedLoads;      //number of values that could not be loaded
+                };
+                
+                /**
+                 * Creates a new aggregator and starts its flush thread.
+                 *
+                 * @param loadFunction the function to use for retrieving persisted values
+                 * @param storeFunction the function to use for storing values
+                 * @param flushInterval the time between flushes (in seconds; 0 = only on stop)
+                 */
+                StatisticsAggregator(LoadFunction loadFunction, StoreFunction storeFunction, unsigned long flushInterval);
+                
+                /**
+                 * Stops the aggregator (see <code>stop()</code>).
+                 */
+                ~StatisticsAggregator();
+                
+                StatisticsAggregator() = delete;                                        //No default constructor
+                StatisticsAggregator(const StatisticsAggregator&) = delete;             //Copying not allowed (pass/access only by reference/pointer)
+                StatisticsAggregator& operator=(const StatisticsAggregator&) = delete;  //Copying not allowed (pass/access only by reference/pointer)
+                
+                /**
+                 * Adds the specified amount to a statistic.
+                 *
+                 * @param type the statistic type
+                 * @param amount the amount to add
+                 * @return <code>true</code>, if the statistic is aggregated and the amount was added
+                 */
+                bool increment(StatisticType type, unsigned long amount);
+                
+                /**
+                 * Retrieves the current value of a statistic (persisted and unflushed).
+                 *
+                 * Note: If the persisted value cannot be loaded, only the unflushed increments are returned;
+                 * a failed load is not retried by subsequent reads.
+                 *
+                 * @param type the statistic type
+                 * @return the statistic value
+                 */
+                unsigned long getValue(StatisticType type);
+                
+                /**
+                 * Merges all unflushed increments and stores the values that have changed.
+                 *
+                 * @return <code>true</code>, if all changed values were stored
+                 */
+                bool flush();
+                
+                /**
+                 * Stops the flush thread and performs a final flush.
+                 *
+                 * Note: Increments received after the aggregator is stopped are not flushed.
+                 */
+                void stop();
+                
+                /**
+                 * Sets a new flush interval.
+                 *
+                 * @param interval the time between flushes (in seconds; 0 = only on stop)
+                 */
+                void setFlushInterval(unsigned long interval);
+                
+                /**
+                 * Retrieves general information for the aggregator.
+                 *
+                 * @return the requested information
+                 */
+                StatisticsAggregatorInformation getAggregatorInformation() const;
+                
+                /**
+                 * Checks if the specified statistic is aggregated.
+                 *
+                 * @param type the statistic type
+                 * @return <code>true</code>, if the statistic is aggregated
+                 */
+                static bool isAggregated(StatisticType type) { return (getCounterIndex(type) < COUNTERS_NUMBER); }
+            
+            private:
+                static const unsigned int COUNTERS_NUMBER = 4;
+                static const unsigned int SHARDS_NUMBER = 16;
+                
+                /** Counter shard, padded to avoid sharing cache lines with other shards. */
+                struct CounterShard
+                {
+                    std::atomic<unsigned long> value {0};
+                    char padding[64 - sizeof(std::atomic<unsigned long>)];
+                };
+                
+                /** Aggregated statistic. */
+                struct Counter
+                {
+                    CounterShard shards[SHARDS_NUMBER]; //unflushed increments
+                    unsigned long persistedValue = 0;   //value merged into the database value (guarded by valuesMutex)
+                    bool isLoaded = false;              //denotes whether the persisted value was loaded (guarded by valuesMutex)
+                    bool isDirty = false;               //denotes whether the persisted value needs to be stored (guarded by valuesMutex)
+                    bool loadFailed = false;            //denotes whether the last load attempt failed (guarded by valuesMutex)
+                };
+                
+                LoadFunction load;
+                StoreFunction store;
+                Counter counters[COUNTERS_NUMBER];
+                
+                //Stats
+                std::atomic<unsigned long> increments {0};
+                std::atomic<unsigned long> flushes {0};
+                std::atomic<unsigned long> storedValues {0};
+                std::atomic<unsigned long> failedStores {0};
+                std::atomic<unsigned long> failedLoads {0};
+                
+                //Thread management
+                std::atomic<unsigned long> flushInterval;               //time between flushes (in seconds)
+                boost::thread * flushThreadObject = nullptr;            //flush thread
+                boost::mutex flushThreadMutex;                          //flush thread mutex
+                boost::condition_variable flushThreadLockCondition;     //flush thread condition variable
+                boost::mutex flushMutex;                                //mutex for serialising flushes
+                boost::mutex valuesMutex;                               //mutex for synchronising access to the persisted values
+                bool stopAggregator = false;                            //denotes whether the aggregator is being stopped (guarded by flushThreadMutex)
+                
+                /** Periodically flushes all statistics, until the aggregator is stopped. */
+                void flushThread();
+                
+                /**
+                 * Loads the persisted value of the specified counter, if it is not loaded yet.
+                 *
+                 * Note: The values mutex must not be held by the caller; it is not held while loading.
+                 *
+                 * @param type the statistic type
+                 * @param counter the counter to be loaded
+                 * @param retryFailed set to <code>true</code>, if the load is to be attempted again after a failure
+                 * @return <code>true</code>, if the persisted value is available
+                 */
+                bool ensureLoaded(StatisticType type, Counter & counter, bool retryFailed);
+                
+                /**
+                 * Retrieves the counter index for the specified statistic.
+                 *
+                 * @param type the statistic type
+                 * @return the counter index or <code>COUNTERS_NUMBER</code>, if the statistic is not aggregated
+                 */
+                static unsigned int getCounterIndex(StatisticType type);
+                
+                /**
+                 * Retrieves the statistic type for the specified counter index.
+                 *
+                 * @param index the counter index
+                 * @return the statistic type
+                 */
+                static StatisticType getCounterType(unsigned int index);
+        };
+    }
+}
+
+#endif	/* STATISTICSAGGREGATOR_H */
+
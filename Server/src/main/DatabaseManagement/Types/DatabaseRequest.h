@@ -0,0 +1,184 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATABASEREQUEST_H
+#define	DATABASEREQUEST_H
+
+#include <boost/any.hpp>
+#include <boost/variant.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "Types.h"
+#include "../../Common/Types.h"
+#include "../Containers/DataContainer.h"
+
+namespace DatabaseManagement_Types
+{
+    /** Structure for holding the constraint of a SELECT request. */
+    struct SelectConstraint
+    {
+        /** Constraint type (one of the <code>DatabaseSelectConstraints</code> enumerations). */
+        boost::any type;
+        /** Constraint value (depends on the constraint type). */
+        boost::any value;
+        /** Number of matching objects to skip (paged requests only). */
+        unsigned long offset;
+        /** Maximum number of objects to retrieve (0 = all objects; request is not paged). */
+        unsigned long limit;
+    };
+
+    /**
+     * Class representing a single database request.
+     *
+     * The request payload depends on the request type:
+     * - SELECT -> <code>SelectConstraint</code>;
+     * - INSERT/UPDATE -> <code>DataContainerPtr</code>;
+     * - REMOVE -> <code>DBObjectID</code>.
+     */
+    class DatabaseRequest
+    {
+        public:
+            /** Creates a new, invalid, request. */
+            DatabaseRequest()
+            : type(DatabaseRequestType::INVALID), id(INVALID_DATABASE_REQUEST_ID), payload(Common_Types::INVALID_OBJECT_ID)
+            {}
+
+            /**
+             * Creates a new SELECT request.
+             *
+             * @param requestID the ID of the request
+             * @param constraintType the constraint type
+             * @param constraintValue the constraint value
+             * @param offset the number of matching objects to skip (default is 0)
+             * @param limit the maximum number of objects to retrieve (default is 0; all objects)
+             */
+            DatabaseRequest(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue,
+                            unsigned long offset = 0, unsigned long limit = 0)
+            : type(DatabaseRequestType::SELECT), id(requestID), payload(SelectConstraint{constraintType, constraintValue, offset, limit})
+            {}
+
+            /**
+             * Creates a new INSERT or UPDATE request.
+             *
+             * @param requestType the type of the request (INSERT or UPDATE)
+             * @param requestID the ID of the request
+             * @param data the container to be stored
+             */
+            DatabaseRequest(DatabaseRequestType requestType, DatabaseRequestID requestID, DatabaseManagement_Containers::DataContainerPtr data)
+            : type(requestType), id(requestID), payload(data)
+            {}
+
+            /**
+             * Creates a new REMOVE request.
+             *
+             * @param requestID the ID of the request
+             * @param objectID the ID of the object to be removed
+             */
+            DatabaseRequest(DatabaseRequestID requestID, Common_Types::DBObjectID objectID)
+            : type(DatabaseRequestType::REMOVE), id(requestID), payload(objectID)
+            {}
+
+            /**
+             * Retrieves the type of the request.
+             *
+             * @return the request type
+             */
+            DatabaseRequestType getType() const { return type; }
+
+            /**
+             * Retrieves the ID of the request.
+             *
+             * @return the request ID
+             */
+            DatabaseRequestID getID() const { return id; }
+
+            /**
+             * Sets a new ID for the request.
+             *
+             * @param requestID the new request ID
+             */
+            void setID(DatabaseRequestID requestID) { id = requestID; }
+
+            /**
+             * Retrieves the deadline of the request.
+             *
+             * @return the time after which the request is no longer needed (<code>not_a_date_time</code>, if there is no deadline)
+             */
+            boost::posix_time::ptime getDeadline() const { return deadline; }
+
+            /**
+             * Sets a new deadline for the request.
+             *
+             * @param requestDeadline the time (UTC) after which the request is no longer needed
+             */
+            void setDeadline(boost::posix_time::ptime requestDeadline) { deadline = requestDeadline; }
+
+            /**
+             * Checks if the deadline of the request has passed.
+             *
+             * @param currentTime the current time (UTC)
+             * @return <code>true</code>, if the request has a deadline and it has passed
+             */
+            bool isExpired(boost::posix_time::ptime currentTime) const { return (!deadline.is_not_a_date_time() && deadline <= currentTime); }
+
+            /**
+             * Retrieves the constraint of a SELECT request.
+             *
+             * Note: Throws <code>boost::bad_get</code> if the request is not a SELECT.
+             *
+             * @return the request constraint
+             */
+            const SelectConstraint & getConstraint() const { return boost::get<SelectConstraint>(payload); }
+
+            /**
+             * Retrieves the container of an INSERT/UPDATE request.
+             *
+             * Note: Throws <code>boost::bad_get</code> if the request is not an INSERT or an UPDATE.
+             *
+             * @return the request container
+             */
+            const DatabaseManagement_Containers::DataContainerPtr & getContainer() const { return boost::get<DatabaseManagement_Containers::DataContainerPtr>(payload); }
+
+            /**
+             * Retrieves the object ID of a REMOVE request.
+             *
+             * Note: Throws <code>boost::bad_get</code> if the request is not a REMOVE.
+             *
+             * @return the ID of the object to be removed
+             */
+            const Common_Types::DBObjectID & getObjectID() const { return boost::get<Common_Types::DBObjectID>(payload); }
+
+            /**
+             * Releases the request payload and sets the request to an invalid state,
+             * allowing the object to be reused.
+             */
+            void reset()
+            {
+                type = DatabaseRequestType::INVALID;
+                id = INVALID_DATABASE_REQUEST_ID;
+                payload = Common_Types::INVALID_OBJECT_ID;
+                deadline = boost::posix_time::not_a_date_time;
+            }
+
+        private:
+            DatabaseRequestType type;
+            DatabaseRequestID id;
+            boost::posix_time::ptime deadline;
+            boost::variant<Common_Types::DBObjectID, SelectConstraint, DatabaseManagement_Containers::DataContainerPtr> payload;
+    };
+}
+
+#endif	/* DATABASEREQUEST_H */
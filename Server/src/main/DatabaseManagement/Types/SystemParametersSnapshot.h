@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYSTEMPARAMETERSSNAPSHOT_H
+#define	SYSTEMPARAMETERSSNAPSHOT_H
+
+#include <map>
+#include <vector>
+#include <boost/any.hpp>
+#include <boost/shared_ptr.hpp>
+#include "Types.h"
+#include "../Containers/SystemDataContainer.h"
+
+namespace DatabaseManagement_Types
+{
+    class SystemParametersSnapshot;
+    typedef boost::shared_ptr<const SystemParametersSnapshot> SystemParametersSnapshotPtr;
+
+    /**
+     * Immutable set of system parameters.
+     *
+     * A new snapshot (with a higher version) is created for every parameter change;
+     * the containers held by a snapshot are never modified or handed out directly.
+     */
+    class SystemParametersSnapshot
+    {
+        public:
+            /** Creates a new, empty, snapshot (version 0). */
+            SystemParametersSnapshot() : version(0) {}
+
+            /**
+             * Creates a new snapshot with the specified parameters.
+             *
+             * @param snapshotVersion the snapshot version
+             * @param parameters the system parameters
+             */
+            SystemParametersSnapshot(unsigned long snapshotVersion, const std::vector<DatabaseManagement_Containers::SystemDataContainerPtr> & parameters)
+            : version(snapshotVersion)
+            {
+                for(const DatabaseManagement_Containers::SystemDataContainerPtr & currentParameter : parameters)
+                {
+                    if(currentParameter)
+                        values[currentParameter->getSystemParameterType()] = copyParameter(currentParameter);
+                }
+            }
+
+            SystemParametersSnapshot(const SystemParametersSnapshot&) = delete;            //Copying not allowed (pass/access only by pointer)
+            SystemParametersSnapshot& operator=(const SystemParametersSnapshot&) = delete; //Copying not allowed (pass/access only by pointer)
+
+            /**
+             * Creates a new snapshot holding all parameters of the current snapshot and the specified parameter.
+             *
+             * @param parameter the new or updated parameter
+             * @return the new snapshot (with the next version)
+             */
+            SystemParametersSnapshotPtr withParameter(const DatabaseManagement_Containers::SystemDataContainerPtr parameter) const
+            {
+                boost::shared_ptr<SystemParametersSnapshot> result(new SystemParametersSnapshot(version + 1, std::vector<DatabaseManagement_Containers::SystemDataContainerPtr>()));
+                result->values = values;
+
+                if(parameter)
+                    result->values[parameter->getSystemParameterType()] = copyParameter(parameter);
+
+                return result;
+            }
+
+            /**
+             * Retrieves a copy of the specified parameter.
+             *
+             * @param type the parameter type
+             * @return the parameter or <code>nullptr</code>, if it is not in the snapshot
+             */
+            DatabaseManagement_Containers::SystemDataContainerPtr getParameter(SystemParameterType type) const
+            {
+                auto parameter = values.find(type);
+                return (parameter != values.end()) ? copyParameter(parameter->second) : DatabaseManagement_Containers::SystemDataContainerPtr();
+            }
+
+            /**
+             * Retrieves the value of the specified parameter.
+             *
+             * @param type the parameter type
+             * @return the parameter value (empty, if the parameter is not in the snapshot)
+             */
+            boost::any getValue(SystemParameterType type) const
+            {
+                auto parameter = values.find(type);
+                return (parameter != values.end()) ? parameter->second->getSystemParameterValue() : boost::any();
+            }
+
+            /**
+             * Retrieves copies of all parameters in the snapshot.
+             *
+             * @return the parameters
+             */
+            std::vector<DatabaseManagement_Containers::SystemDataContainerPtr> getParameters() const
+            {
+                std::vector<DatabaseManagement_Containers::SystemDataContainerPtr> result;
+                for(const auto & currentParameter : values)
+                    result.push_back(copyParameter(currentParameter.second));
+
+                return result;
+            }
+
+            /** Retrieves the snapshot version.\n\n@return the version */
+            unsigned long getVersion() const { return version; }
+            /** Retrieves the number of parameters in the snapshot.\n\n@return the number of parameters */
+            std::size_t size() const { return values.size(); }
+
+        private:
+            unsigned long version;
+            std::map<SystemParameterType, DatabaseManagement_Containers::SystemDataContainerPtr> values;
+
+            static DatabaseManagement_Containers::SystemDataContainerPtr copyParameter(const DatabaseManagement_Containers::SystemDataContainerPtr parameter)
+            {
+                return DatabaseManagement_Containers::SystemDataContainerPtr(new DatabaseManagement_Containers::SystemDataContainer(*parameter));
+            }
+    };
+}
+
+#endif	/* SYSTEMPARAMETERSSNAPSHOT_H */
+
@@ -19,6 +19,7 @@
 #define	DATABASE_MANAGEMENT_TYPES_H
 
 #include <string>
+#include <utility>
 #include "../../Common/Types.h"
 
 namespace DatabaseManagement_Types
@@ -32,10 +33,16 @@ namespace DatabaseManagement_Types
     
     typedef unsigned long DatabaseRequestID;
     const DatabaseRequestID INVALID_DATABASE_REQUEST_ID = 0; //TODO - value?
+    
+    typedef std::pair<Common_Types::Timestamp, Common_Types::Timestamp> LogTimeRange; //[start, end)
         
     enum class DatabaseObjectType { INVALID, VECTOR, STATISTICS, SYSTEM_SETTINGS, SYNC_FILE, DEVICE, SCHEDULE, USER, LOG, SESSION };
     enum class DatabaseManagerOperationMode { INVALID, PRPW, PRCW, CRCW };
     enum class DatabaseFailureAction { INVALID, IGNORE_FAILURE, DROP_IF_NOT_LAST, DROP_DAL, PUSH_TO_BACK, INITIATE_RECONNECT };
+    enum class DatabaseRequestType { INVALID, SELECT, INSERT, UPDATE, REMOVE };
+    enum class DatabaseReadRoutingPolicy { INVALID, FIRST, ROUND_ROBIN, LEAST_OUTSTANDING, LOWEST_LATENCY };
+    enum class DALMigrationPhase { INVALID, PENDING, SNAPSHOT, CATCH_UP, CUTOVER, COMPLETED, FAILED };
+    enum class DALBreakerState { INVALID, CLOSED, OPEN, HALF_OPEN };
     enum class StatisticType { INVALID, INSTALL_TIMESTAMP, START_TIMESTAMP, TOTAL_TRANSFERRED_DATA, TOTAL_TRANSFERRED_FILES, TOTAL_FAILED_TRANSFERS, TOTAL_RETRIED_TRANSFERS };
     enum class SystemParameterType { INVALID, DATA_IP_ADDRESS, DATA_IP_PORT, COMMAND_IP_ADDRESS, COMMAND_IP_PORT, FORCE_COMMAND_ENCRYPTION, FORCE_DATA_ENCRYPTION, 
                                      FORCE_DATA_COMPRESSION, PENDING_DATA_POOL_SIZE, PENDING_DATA_POOL_PATH, PENDING_DATA_RETENTION, IN_MEMORY_POOL_SIZE, 
@@ -62,7 +69,7 @@ namespace DatabaseManagement_Types
             enum class DEVICES { GET_ALL, LIMIT_BY_ID, LIMIT_BY_TRANSFER_TYPE, LIMIT_BY_OWNER, LIMIT_BY_ADDRESS };
             enum class SCHEDULES { GET_ALL, LIMIT_BY_ID, LIMIT_BY_STATE, LIMIT_BY_SYNC };
             enum class USERS { GET_ALL, LIMIT_BY_ID, LIMIT_BY_NAME, LIMIT_BY_ACCESS_LEVEL, LIMIT_BY_LOCKED_STATE };
-            enum class LOGS { GET_ALL, LIMIT_BY_ID, LIMIT_BY_SEVERITY, LIMIT_BY_SOURCE };
+            enum class LOGS { GET_ALL, LIMIT_BY_ID, LIMIT_BY_SEVERITY, LIMIT_BY_SOURCE, LIMIT_BY_TIME_RANGE };
             enum class SESSIONS { GET_ALL, LIMIT_BY_ID, LIMIT_BY_TYPE, LIMIT_BY_DEVICE, LIMIT_BY_USER, LIMIT_BY_STATE, LIMIT_BY_PERSISTENCY };
     };
 }
@@ -195,8 +195,18 @@ void EntityManagement::DatabaseLogger::getLogsByConstraintHandler
 
     if(actualInstruction)
     {
-        resultData = databaseManager.Logs().getLogsByConstraint(actualInstruction->constraintType,
-                                                                actualInstruction->constraintValue);
+        if(actualInstruction->limit > 0)
+        {
+            resultData = databaseManager.Logs().getLogsPage(actualInstruction->constraintType,
+                                                            actualInstruction->constraintValue,
+                                                            actualInstruction->offset,
+                                                            actualInstruction->limit);
+        }
+        else
+        {
+            resultData = databaseManager.Logs().getLogsByConstraint(actualInstruction->constraintType,
+                                                                    actualInstruction->constraintValue);
+        }
     }
 
     auto result = boost::shared_ptr<InstructionResults::GetLogsByConstraint>(
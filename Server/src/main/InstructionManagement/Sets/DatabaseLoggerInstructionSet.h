@@ -57,13 +57,15 @@ namespace InstructionManagement_Sets
         
         struct GetLogsByConstraint : public Instruction<DatabaseLoggerInstructionType>
         {
-            GetLogsByConstraint(DatabaseSelectConstraints::LOGS type, boost::any value)
+            GetLogsByConstraint(DatabaseSelectConstraints::LOGS type, boost::any value, unsigned long offset = 0, unsigned long limit = 0)
             : Instruction(InstructionSetType::DATABASE_LOGGER, DatabaseLoggerInstructionType::GET_LOGS_BY_CONSTRAINT),
-              constraintType(type), constraintValue(value)
+              constraintType(type), constraintValue(value), offset(offset), limit(limit)
             {}
             bool isValid() override { return true; }
             DatabaseSelectConstraints::LOGS constraintType;
             boost::any constraintValue;
+            unsigned long offset;   //number of logs to skip (paged requests only)
+            unsigned long limit;    //maximum number of logs to retrieve (0 = all logs)
         };
         
         struct UpdateSourceLoggingLevel : public Instruction<DatabaseLoggerInstructionType>
@@ -47,6 +47,7 @@ NetworkManagement_Handlers::CommandConnectionsHandler::~CommandConnectionsHandle
     onConnectionEstablished.disconnect_all_slots();
     onConnectionEstablishmentFailed.disconnect_all_slots();
     onCommandDataReceived.disconnect_all_slots();
+    onWriteQueueReady.disconnect_all_slots();
 
     boost::lock_guard<boost::mutex> globalDataLock(connectionDataMutex);
 
@@ -95,13 +96,13 @@ NetworkManagement_Handlers::CommandConnectionsHandler::~CommandConnectionsHandle
         {
             while(currentEstablishedConnection.second->pendingData.size() > 0)
             {
-                delete currentEstablishedConnection.second->pendingData.front();
                 currentEstablishedConnection.second->pendingData.pop();
             }
 
             currentEstablishedConnection.second->onDataReceivedEventConnection.disconnect();
             currentEstablishedConnection.second->onDisconnectEventConnection.disconnect();
             currentEstablishedConnection.second->onWriteResultReceivedEventConnection.disconnect();
+            currentEstablishedConnection.second->onFlowControlEventConnection.disconnect();
             currentEstablishedConnection.second->connection->disconnect();
         }
         
@@ -220,31 +221,40 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::manageRemoteConnecti
     connection->enableDataEvents();
 }
 
-void NetworkManagement_Handlers::CommandConnectionsHandler::sendData
+bool NetworkManagement_Handlers::CommandConnectionsHandler::sendData
 (const DeviceID deviceID, const PlaintextData & plaintextData)
 {
     if(!active)
-        return;
+        return false;
 
     ++sendRequestsMade;
 
     EstablishedConnectionDataPtr connectionData = getEstablishedConnectionData(deviceID);
 
-    CiphertextData * encryptedData = new CiphertextData();
+    boost::shared_ptr<CiphertextData> encryptedData(new CiphertextData());
     boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
     try
     {
         connectionData->cryptoHandler->encryptData(plaintextData, *encryptedData);
-        connectionData->connection->sendData(*encryptedData);
+        if(!connectionData->connection->sendData(encryptedData))
+        {
+            ++sendRequestsRejected;
+            logMessage(LogSeverity::Warning, "(sendData) > Data for device ["
+                    + Convert::toString(deviceID) + "] rejected; the connection's write queue is full.");
+            
+            return false;
+        }
+        
         connectionData->pendingData.push(encryptedData);
         
         logMessage(LogSeverity::Info, "(sendData) > Data sent to device ["
                 + Convert::toString(deviceID) + "].");
+        
+        return true;
     }
     catch(const std::exception & e)
     {
         ++sendRequestsFailed;
-        delete encryptedData;
         logMessage(LogSeverity::Error, "(sendData) >"
                 " Exception encountered: [" + std::string(e.what())
                 + "] while sending data to device [" + Convert::toString(deviceID) + "].");
@@ -255,7 +265,6 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::sendData
     catch(...)
     {
         ++sendRequestsFailed;
-        delete encryptedData;
         logMessage(LogSeverity::Error, "(sendData) >"
                 " Unknown exception encountered while sending data to device ["
                 + Convert::toString(deviceID) + "].");
@@ -800,7 +809,7 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDisconnectHandler_
 }
 
 void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandler_PendingLocalConnections
-(ByteData data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID, ConnectionPtr connection)
+(const BufferView & data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID, ConnectionPtr connection)
 {
     if(!active)
         return;
@@ -840,7 +849,7 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandle
             connectionData->state = ConnectionSetupState::CONNECTION_RESPONSE_RECEIVED;
             delete connectionData->lastPendingData;
             connectionData->lastPendingData = nullptr;
-            verifyConnectionResponseData(data, connectionData);
+            verifyConnectionResponseData(data.toByteData(), connectionData);
             connectionData->state = ConnectionSetupState::COMPLETED;
 
             //builds the established connection data
@@ -887,6 +896,11 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandle
                     boost::bind(&NetworkManagement_Handlers::CommandConnectionsHandler::onWriteResultReceivedHandler_EstablishedConnections,
                                 this, _1, deviceID, connectionID));
         
+        establishedConnectionData->onFlowControlEventConnection =
+                connection->onFlowControlEventAttach(
+                    boost::bind(&NetworkManagement_Handlers::CommandConnectionsHandler::onFlowControlHandler_EstablishedConnections,
+                                this, _1, deviceID, connectionID));
+        
         connection->enableDataEvents();
         
         logMessage(LogSeverity::Info, "(onDataReceivedHandler_PendingLocalConnections) >"
@@ -994,7 +1008,7 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDisconnectHandler_
 }
 
 void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandler_PendingRemoteConnections
-(ByteData data, PacketSize remaining, const ConnectionID connectionID, ConnectionPtr connection)
+(const BufferView & data, PacketSize remaining, const ConnectionID connectionID, ConnectionPtr connection)
 {
     if(!active)
         return;
@@ -1025,7 +1039,7 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandle
     try
     {
         //generates and send a connection response
-        CiphertextData * responseData = generateConnectionResponseDataFromRequest(data, connectionID);
+        CiphertextData * responseData = generateConnectionResponseDataFromRequest(data.toByteData(), connectionID);
         PendingConnectionDataPtr connectionData = getPendingConnectionData(unknownConnectionData->deviceID);
 
         boost::lock_guard<boost::mutex> dataLock(connectionData->connectionDataMutex);
@@ -1150,6 +1164,11 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onWriteResultReceive
                     boost::bind(&NetworkManagement_Handlers::CommandConnectionsHandler::onWriteResultReceivedHandler_EstablishedConnections,
                                 this, _1, unknownConnectionData->deviceID, connectionID));
         
+        establishedConnectionData->onFlowControlEventConnection =
+                unknownConnectionData->connection->onFlowControlEventAttach(
+                    boost::bind(&NetworkManagement_Handlers::CommandConnectionsHandler::onFlowControlHandler_EstablishedConnections,
+                                this, _1, unknownConnectionData->deviceID, connectionID));
+        
         unknownConnectionData->connection->enableDataEvents();
         
         logMessage(LogSeverity::Info, "(onWriteResultReceivedHandler_PendingRemoteConnections) >"
@@ -1195,7 +1214,7 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDisconnectHandler_
 }
 
 void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandler_EstablishedConnections
-(ByteData encryptedData, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
+(const BufferView & encryptedData, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
 {
     if(!active)
         return;
@@ -1217,7 +1236,7 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onDataReceivedHandle
         {
             EstablishedConnectionDataPtr connectionData = getEstablishedConnectionData(deviceID);
             PlaintextData plaintextData;
-            connectionData->cryptoHandler->decryptData(encryptedData, plaintextData);
+            connectionData->cryptoHandler->decryptData(encryptedData.toByteData(), plaintextData);
 
             ++validDataObjectsReceived;
             onCommandDataReceived(deviceID, plaintextData);
@@ -1258,9 +1277,29 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::onWriteResultReceive
     }
 
     boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
-    delete connectionData->pendingData.front();
     connectionData->pendingData.pop();
 }
+
+void NetworkManagement_Handlers::CommandConnectionsHandler::onFlowControlHandler_EstablishedConnections
+(FlowControlEvent event, const DeviceID deviceID, const ConnectionID connectionID)
+{
+    if(!active)
+        return;
+
+    switch(event)
+    {
+        case FlowControlEvent::WRITE_QUEUE_HIGH: ++writeQueueBlocks; break;
+        case FlowControlEvent::READ_QUEUE_HIGH: ++readQueuePauses; break;
+        default: break;
+    }
+
+    logMessage(LogSeverity::Debug, "(onFlowControlHandler_EstablishedConnections) > Event ["
+            + Convert::toString(event) + "] received for device [" + Convert::toString(deviceID)
+            + "] on connection [" + Convert::toString(connectionID) + "].");
+    
+    if(event == FlowControlEvent::WRITE_QUEUE_LOW)
+        onWriteQueueReady(deviceID);
+}
 //</editor-fold>
 
 //<editor-fold defaultstate="collapsed" desc="Cleanup">
@@ -1289,13 +1328,13 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::terminateConnection
         {
             while(establishedConnectionData->second->pendingData.size() > 0)
             {
-                delete establishedConnectionData->second->pendingData.front();
                 establishedConnectionData->second->pendingData.pop();
             }
             
             establishedConnectionData->second->onDataReceivedEventConnection.disconnect();
             establishedConnectionData->second->onDisconnectEventConnection.disconnect();
             establishedConnectionData->second->onWriteResultReceivedEventConnection.disconnect();
+            establishedConnectionData->second->onFlowControlEventConnection.disconnect();
             
             establishedConnections.erase(establishedConnectionData);
         }
@@ -1340,13 +1379,13 @@ void NetworkManagement_Handlers::CommandConnectionsHandler::terminateConnection
     {
         while(establishedConnectionData->second->pendingData.size() > 0)
         {
-            delete establishedConnectionData->second->pendingData.front();
             establishedConnectionData->second->pendingData.pop();
         }
         
         establishedConnectionData->second->onDataReceivedEventConnection.disconnect();
         establishedConnectionData->second->onDisconnectEventConnection.disconnect();
         establishedConnectionData->second->onWriteResultReceivedEventConnection.disconnect();
+        establishedConnectionData->second->onFlowControlEventConnection.disconnect();
         if(establishedConnectionData->second->connection)
             establishedConnectionData->second->connection->disconnect();
         
@@ -57,6 +57,7 @@ using NetworkManagement_Types::RawConnectionID;
 using NetworkManagement_Types::ConnectionID;
 using NetworkManagement_Types::ConnectionSetupState;
 using NetworkManagement_Types::StatCounter;
+using NetworkManagement_Types::FlowControlEvent;
 
 //Common
 using Common_Types::LogSeverity;
@@ -189,10 +190,13 @@ namespace NetworkManagement_Handlers
              * 
              * Note: The caller can safely dispose of the plaintext data after the function returns.
              * 
+             * Note: The data is rejected (and not sent), if the connection's write queue is full.
+             * 
              * @param deviceID the ID of the device to send the data to
              * @param plaintextData the plaintext data to be encrypted and sent
+             * @return <code>true</code>, if the data was queued for sending
              */
-            void sendData(const DeviceID deviceID, const PlaintextData & plaintextData);
+            bool sendData(const DeviceID deviceID, const PlaintextData & plaintextData);
             
             /**
              * Closes the established connection for the specified device.
@@ -265,6 +269,24 @@ namespace NetworkManagement_Handlers
                 return onEstablishedConnectionClosed.connect(function);
             }
             
+            /**
+             * Attaches the supplied handler to the <code>onWriteQueueReady</code> event.
+             * 
+             * Fired when the write queue of an established connection drops back
+             * below its low watermark and can accept data again.
+             * 
+             * @param function the event handler to be attached
+             * @return the resulting signal connection object
+             */
+            boost::signals2::connection onWriteQueueReadyEventAttach(
+                std::function<
+                    void (const DeviceID)
+                >
+                function)
+            {
+                return onWriteQueueReady.connect(function);
+            }
+            
         private:
             /** Structure for holding pending connection data for unknown devices. */
             struct UnknownPendingConnectionData
@@ -341,14 +363,16 @@ namespace NetworkManagement_Handlers
                 ConnectionPtr bridgeTarget;
                 /** Content encryption handler. */
                 SymmetricCryptoHandlerPtr cryptoHandler;
-                /** Queue of pointer to data awaiting to receive send confirmations. */
-                std::queue<const CiphertextData *> pendingData;
+                /** Queue of data awaiting to receive send confirmations. */
+                std::queue<ByteDataPtr> pendingData;
                 /** 'onDataReceived' event handler connection. */
                 boost::signals2::connection onDataReceivedEventConnection;
                 /** 'onDisconnect' event handler connection. */
                 boost::signals2::connection onDisconnectEventConnection;
                 /** 'onWriteResultReceived' event handler connection. */
                 boost::signals2::connection onWriteResultReceivedEventConnection;
+                /** 'onFlowControl' event handler connection. */
+                boost::signals2::connection onFlowControlEventConnection;
                 /** Connection data mutex. */
                 boost::mutex connectionDataMutex;
             };
@@ -382,11 +406,15 @@ namespace NetworkManagement_Handlers
             boost::signals2::signal<void (const DeviceID, const ConnectionID)> onConnectionEstablishmentFailed;
             boost::signals2::signal<void (const DeviceID, const PlaintextData)> onCommandDataReceived;
             boost::signals2::signal<void (const DeviceID, const ConnectionID)> onEstablishedConnectionClosed;
+            boost::signals2::signal<void (const DeviceID)> onWriteQueueReady;
             
             //Stats
             std::atomic<StatCounter> sendRequestsMade{0};           //outgoing data
             std::atomic<StatCounter> sendRequestsConfirmed{0};      //outgoing data
             std::atomic<StatCounter> sendRequestsFailed{0};         //outgoing data
+            std::atomic<StatCounter> sendRequestsRejected{0};       //outgoing data (write queue was full)
+            std::atomic<StatCounter> writeQueueBlocks{0};           //number of times a connection's write queue became full
+            std::atomic<StatCounter> readQueuePauses{0};            //number of times a connection's reading was paused
             std::atomic<StatCounter> totalDataObjectsReceived{0};   //incoming data
             std::atomic<StatCounter> validDataObjectsReceived{0};   //incoming data
             std::atomic<StatCounter> invalidDataObjectsReceived{0}; //incoming data
@@ -514,7 +542,7 @@ namespace NetworkManagement_Handlers
              * @param connection associated connection pointer
              */
             void onDataReceivedHandler_PendingLocalConnections(
-                ByteData data, PacketSize remaining, const DeviceID deviceID,
+                const BufferView & data, PacketSize remaining, const DeviceID deviceID,
                 const ConnectionID connectionID, ConnectionPtr connection);
             
             /**
@@ -547,7 +575,7 @@ namespace NetworkManagement_Handlers
              * @param connection associated connection pointer
              */
             void onDataReceivedHandler_PendingRemoteConnections(
-                ByteData data, PacketSize remaining,
+                const BufferView & data, PacketSize remaining,
                 const ConnectionID connectionID, ConnectionPtr connection);
             
             /**
@@ -578,7 +606,7 @@ namespace NetworkManagement_Handlers
              * @param connectionID associated connection ID
              */
             void onDataReceivedHandler_EstablishedConnections(
-                ByteData encryptedData, PacketSize remaining,
+                const BufferView & encryptedData, PacketSize remaining,
                 const DeviceID deviceID, const ConnectionID connectionID);
             
             /**
@@ -591,6 +619,16 @@ namespace NetworkManagement_Handlers
             void onWriteResultReceivedHandler_EstablishedConnections(
                 bool received, const DeviceID deviceID, const ConnectionID connectionID);
             
+            /**
+             * 'onFlowControl' event handler for established connections.
+             * 
+             * @param event the watermark crossing that occurred
+             * @param deviceID associated device ID
+             * @param connectionID associated connection ID
+             */
+            void onFlowControlHandler_EstablishedConnections(
+                FlowControlEvent event, const DeviceID deviceID, const ConnectionID connectionID);
+            
             /**
              * Terminates the connection for the specified connection ID.
              * 
@@ -0,0 +1,385 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADMISSIONCONTROLLER_H
+#define	ADMISSIONCONTROLLER_H
+
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../Types/Types.h"
+
+using NetworkManagement_Types::AdmissionResult;
+
+namespace NetworkManagement_Connections
+{
+    /**
+     * Class for deciding whether new incoming connections are to be accepted.\n\n
+     * 
+     * Connections are limited by the number of currently active connections and by
+     * their accept rate (with token buckets), on three levels: globally, per remote
+     * address and per remote subnet. The concurrent limits are checked first, followed
+     * by the rate limits (from the most to the least specific), so that a single
+     * flooding address does not use up the tokens of its subnet or of everyone else.
+     * 
+     * Note: Thread-safe.
+     */
+    class AdmissionController
+    {
+        public:
+            /** Parameters structure for holding <code>AdmissionController</code> limits (0 = no limit). */
+            struct AdmissionLimits
+            {
+                /** Maximum number of active connections per remote address. */
+                unsigned int maxConnectionsPerAddress;
+                /** Maximum number of active connections per remote subnet. */
+                unsigned int maxConnectionsPerSubnet;
+                /** Prefix length of IPv4 subnets (0 = 24). */
+                unsigned int ipv4SubnetPrefixLength;
+                /** Prefix length of IPv6 subnets (0 = 64). */
+                unsigned int ipv6SubnetPrefixLength;
+                /** Maximum number of accepted connections per second, for all addresses. */
+                double acceptRate;
+                /** Maximum number of connections accepted at once, for all addresses (0 = same as the rate). */
+                unsigned int acceptBurst;
+                /** Maximum number of accepted connections per second, for each remote address. */
+                double addressAcceptRate;
+                /** Maximum number of connections accepted at once, for each remote address (0 = same as the rate). */
+                unsigned int addressAcceptBurst;
+                /** Maximum number of accepted connections per second, for each remote subnet. */
+                double subnetAcceptRate;
+                /** Maximum number of connections accepted at once, for each remote subnet (0 = same as the rate). */
+                unsigned int subnetAcceptBurst;
+            };
+            
+            /** Number of admission decisions after which idle address and subnet entries are discarded. */
+            static const unsigned int PRUNE_INTERVAL = 1024;
+            
+            /**
+             * Creates a new admission controller with the specified limits.
+             * 
+             * @param maxConnections the maximum number of active connections (0 = no limit)
+             * @param limits the per address/subnet and accept rate limits
+             * @throw invalid_argument if a subnet prefix length or an accept rate is not valid
+             */
+            AdmissionController(unsigned int maxConnections, AdmissionLimits limits)
+            : maxActiveConnections(maxConnections), limits(limits),
+              ipv4Prefix((limits.ipv4SubnetPrefixLength == 0) ? 24 : limits.ipv4SubnetPrefixLength),
+              ipv6Prefix((limits.ipv6SubnetPrefixLength == 0) ? 64 : limits.ipv6SubnetPrefixLength)
+            {
+                if(ipv4Prefix > 32 || ipv6Prefix > 128)
+                    throw std::invalid_argument("AdmissionController::() > Invalid subnet prefix length supplied.");
+                
+                if(limits.acceptRate < 0 || limits.addressAcceptRate < 0 || limits.subnetAcceptRate < 0)
+                    throw std::invalid_argument("AdmissionController::() > Accept rates cannot be negative.");
+            }
+            
+            AdmissionController() = delete;                                         //No default constructor
+            AdmissionController(const AdmissionController&) = delete;              //Copying not allowed (pass/access only by reference/pointer)
+            AdmissionController& operator=(const AdmissionController&) = delete;   //Copying not allowed (pass/access only by reference/pointer)
+            
+            /**
+             * Decides whether a new connection from the specified address can be accepted.
+             * 
+             * If the connection is admitted, it is counted as active until <code>release()</code> is called.
+             * 
+             * @param address the remote address of the connection
+             * @param currentTime the time of the decision (used for the accept rate limits)
+             * @return <code>AdmissionResult::ADMITTED</code> or the reason for the rejection
+             */
+            AdmissionResult admit(const boost::asio::ip::address & address,
+                                  boost::posix_time::ptime currentTime = boost::posix_time::microsec_clock::universal_time())
+            {
+                boost::lock_guard<boost::mutex> dataLock(dataMutex);
+                
+                if(++decisions % PRUNE_INTERVAL == 0)
+                    prune(currentTime);
+                
+                AdmissionResult result = AdmissionResult::ADMITTED;
+                
+                if(maxActiveConnections > 0 && activeConnections >= maxActiveConnections)
+                    result = AdmissionResult::GLOBAL_LIMIT;
+                
+                Entry * addressEntry = nullptr;
+                Entry * subnetEntry = nullptr;
+                
+                if(result == AdmissionResult::ADMITTED)
+                {
+                    addressEntry = &addresses[getAddressKey(address)];
+                    if(limits.maxConnectionsPerAddress > 0 && addressEntry->activeConnections >= limits.maxConnectionsPerAddress)
+                        result = AdmissionResult::ADDRESS_LIMIT;
+                }
+                
+                if(result == AdmissionResult::ADMITTED)
+                {
+                    subnetEntry = &subnets[getSubnetKey(address)];
+                    if(limits.maxConnectionsPerSubnet > 0 && subnetEntry->activeConnections >= limits.maxConnectionsPerSubnet)
+                        result = AdmissionResult::SUBNET_LIMIT;
+                }
+                
+                if(result == AdmissionResult::ADMITTED && !addressEntry->bucket.hasToken(limits.addressAcceptRate, limits.addressAcceptBurst, currentTime))
+                    result = AdmissionResult::ADDRESS_RATE;
+                
+                if(result == AdmissionResult::ADMITTED && !subnetEntry->bucket.hasToken(limits.subnetAcceptRate, limits.subnetAcceptBurst, currentTime))
+                    result = AdmissionResult::SUBNET_RATE;
+                
+                if(result == AdmissionResult::ADMITTED && !globalBucket.hasToken(limits.acceptRate, limits.acceptBurst, currentTime))
+                    result = AdmissionResult::GLOBAL_RATE;
+                
+                if(result != AdmissionResult::ADMITTED)
+                {
+                    ++rejections[static_cast<unsigned int>(result)];
+                    return result;
+                }
+                
+                //the tokens are only taken once all checks have passed
+                addressEntry->bucket.takeToken(limits.addressAcceptRate);
+                subnetEntry->bucket.takeToken(limits.subnetAcceptRate);
+                globalBucket.takeToken(limits.acceptRate);
+                
+                ++addressEntry->activeConnections;
+                ++subnetEntry->activeConnections;
+                ++activeConnections;
+                ++admissions;
+                
+                return result;
+            }
+            
+            /**
+             * Removes a connection previously admitted for the specified address from the active connections.
+             * 
+             * @param address the remote address of the connection
+             */
+            void release(const boost::asio::ip::address & address)
+            {
+                boost::lock_guard<boost::mutex> dataLock(dataMutex);
+                
+                auto addressEntry = addresses.find(getAddressKey(address));
+                if(addressEntry != addresses.end() && addressEntry->second.activeConnections > 0)
+                    --addressEntry->second.activeConnections;
+                
+                auto subnetEntry = subnets.find(getSubnetKey(address));
+                if(subnetEntry != subnets.end() && subnetEntry->second.activeConnections > 0)
+                    --subnetEntry->second.activeConnections;
+                
+                if(activeConnections > 0)
+                    --activeConnections;
+            }
+            
+            /** Retrieves the number of currently active (admitted and not released) connections.\n\n@return the number of active connections */
+            unsigned int getActiveConnectionsCount()    const { boost::lock_guard<boost::mutex> dataLock(dataMutex); return activeConnections; }
+            /** Retrieves the total number of admitted connections.\n\n@return the number of admitted connections */
+            unsigned long long getAdmissionsCount()     const { boost::lock_guard<boost::mutex> dataLock(dataMutex); return admissions; }
+            /** Retrieves the number of tracked addresses and subnets.\n\n@return the number of tracked entries */
+            std::size_t getTrackedEntriesCount()        const { boost::lock_guard<boost::mutex> dataLock(dataMutex); return addresses.size() + subnets.size(); }
+            
+            /**
+             * Retrieves the number of connections rejected for the specified reason.
+             * 
+             * @param reason the rejection reason
+             * @return the number of rejected connections
+             */
+            unsigned long long getRejectionsCount(AdmissionResult reason) const
+            {
+                unsigned int index = static_cast<unsigned int>(reason);
+                if(index >= REASONS_NUMBER)
+                    return 0;
+                
+                boost::lock_guard<boost::mutex> dataLock(dataMutex);
+                return rejections[index];
+            }
+            
+            /**
+             * Retrieves the total number of rejected connections.
+             * 
+             * @return the number of rejected connections
+             */
+            unsigned long long getRejectionsCount() const
+            {
+                boost::lock_guard<boost::mutex> dataLock(dataMutex);
+                
+                unsigned long long result = 0;
+                for(unsigned int i = 0; i < REASONS_NUMBER; i++)
+                    result += rejections[i];
+                
+                return result;
+            }
+        
+        private:
+            /** Token bucket for limiting the accept rate. */
+            struct TokenBucket
+            {
+                double tokens = -1;                 //available tokens (< 0 = not yet filled)
+                boost::posix_time::ptime lastRefill;//time of the last refill
+                
+                /**
+                 * Refills the bucket and checks if it has a token available.
+                 * 
+                 * @param rate the refill rate (tokens per second; 0 = no limit)
+                 * @param burst the bucket capacity (0 = same as the rate, but at least 1)
+                 * @param currentTime the current time
+                 * @return <code>true</code>, if a token is available
+                 */
+                bool hasToken(double rate, unsigned int burst, boost::posix_time::ptime currentTime)
+                {
+                    if(rate <= 0)
+                        return true;
+                    
+                    double capacity = (burst > 0) ? burst : std::max(rate, 1.0);
+                    if(tokens < 0)
+                        tokens = capacity;
+                    else if(currentTime > lastRefill)
+                        tokens = std::min(capacity, tokens + rate * (currentTime - lastRefill).total_microseconds() / 1000000.0);
+                    
+                    lastRefill = currentTime;
+                    return (tokens >= 1);
+                }
+                
+                /**
+                 * Takes a token from the bucket (after a successful <code>hasToken()</code> check).
+                 * 
+                 * @param rate the refill rate (tokens per second; 0 = no limit)
+                 */
+                void takeToken(double rate)
+                {
+                    if(rate > 0)
+                        tokens -= 1;
+                }
+                
+                /**
+                 * Checks if the bucket would be full at the specified time.
+                 * 
+                 * @param rate the refill rate (tokens per second; 0 = no limit)
+                 * @param burst the bucket capacity (0 = same as the rate, but at least 1)
+                 * @param currentTime the current time
+                 * @return <code>true</code>, if the bucket is (or would be) full
+                 */
+                bool isFull(double rate, unsigned int burst, boost::posix_time::ptime currentTime) const
+                {
+                    if(rate <= 0 || tokens < 0)
+                        return true;
+                    
+                    double capacity = (burst > 0) ? burst : std::max(rate, 1.0);
+                    return (tokens + rate * (currentTime - lastRefill).total_microseconds() / 1000000.0) >= capacity;
+                }
+            };
+            
+            /** Structure for holding address/subnet admission data. */
+            struct Entry
+            {
+                unsigned int activeConnections = 0; //number of active connections
+                TokenBucket bucket;                 //accept rate bucket
+            };
+            
+            static const unsigned int REASONS_NUMBER = static_cast<unsigned int>(AdmissionResult::SUBNET_RATE) + 1;
+            
+            mutable boost::mutex dataMutex;         //admission data mutex
+            unsigned int maxActiveConnections;      //maximum number of active connections (0 = no limit)
+            AdmissionLimits limits;                 //per address/subnet and rate limits
+            unsigned int ipv4Prefix;                //IPv4 subnet prefix length
+            unsigned int ipv6Prefix;                //IPv6 subnet prefix length
+            
+            unsigned int activeConnections = 0;     //number of active connections
+            TokenBucket globalBucket;               //global accept rate bucket
+            boost::unordered_map<std::string, Entry> addresses; //admission data for each address
+            boost::unordered_map<std::string, Entry> subnets;   //admission data for each subnet
+            
+            unsigned long long decisions = 0;       //number of admission decisions
+            unsigned long long admissions = 0;      //number of admitted connections
+            unsigned long long rejections[REASONS_NUMBER] = {}; //number of rejected connections, for each reason
+            
+            /**
+             * Discards all address and subnet entries without active connections and with full buckets.
+             * 
+             * Note: Expects the data mutex to be held by the caller.
+             * 
+             * @param currentTime the current time
+             */
+            void prune(boost::posix_time::ptime currentTime)
+            {
+                for(auto currentEntry = addresses.begin(); currentEntry != addresses.end();)
+                {
+                    if(currentEntry->second.activeConnections == 0
+                       && currentEntry->second.bucket.isFull(limits.addressAcceptRate, limits.addressAcceptBurst, currentTime))
+                        currentEntry = addresses.erase(currentEntry);
+                    else
+                        ++currentEntry;
+                }
+                
+                for(auto currentEntry = subnets.begin(); currentEntry != subnets.end();)
+                {
+                    if(currentEntry->second.activeConnections == 0
+                       && currentEntry->second.bucket.isFull(limits.subnetAcceptRate, limits.subnetAcceptBurst, currentTime))
+                        currentEntry = subnets.erase(currentEntry);
+                    else
+                        ++currentEntry;
+                }
+            }
+            
+            /**
+             * Retrieves the raw bytes of the specified address (IPv4-mapped IPv6 addresses are treated as IPv4).
+             * 
+             * @param address the address
+             * @return the address bytes
+             */
+            static std::string getAddressKey(const boost::asio::ip::address & address)
+            {
+                if(address.is_v4())
+                {
+                    auto bytes = address.to_v4().to_bytes();
+                    return std::string(bytes.begin(), bytes.end());
+                }
+                
+                boost::asio::ip::address_v6 v6Address = address.to_v6();
+                if(v6Address.is_v4_mapped())
+                    return getAddressKey(v6Address.to_v4());
+                
+                auto bytes = v6Address.to_bytes();
+                return std::string(bytes.begin(), bytes.end());
+            }
+            
+            /**
+             * Retrieves the subnet bytes of the specified address (the address bytes, with all non-prefix bits cleared).
+             * 
+             * @param address the address
+             * @return the subnet bytes
+             */
+            std::string getSubnetKey(const boost::asio::ip::address & address) const
+            {
+                std::string result = getAddressKey(address);
+                unsigned int prefix = (result.size() == 4) ? ipv4Prefix : ipv6Prefix;
+                
+                for(std::size_t i = 0; i < result.size(); i++)
+                {
+                    unsigned int byteStart = i * 8;
+                    if(byteStart >= prefix)
+                        result[i] = 0;
+                    else if(prefix - byteStart < 8)
+                        result[i] = static_cast<char>(result[i] & (0xFF << (8 - (prefix - byteStart))));
+                }
+                
+                return result;
+            }
+    };
+}
+
+#endif	/* ADMISSIONCONTROLLER_H */
+
@@ -18,47 +18,34 @@
 #include "Connection.h"
 
 NetworkManagement_Connections::Connection::Connection
-(boost::shared_ptr<boost::asio::io_service> service, ConnectionParamters connectionParams, boost::asio::streambuf * externalReadBuffer, Utilities::FileLoggerPtr debugLogger)
-: debugLogger(debugLogger), writeStrand(connectionParams.socket->get_io_service()),
-  readStrand(connectionParams.socket->get_io_service()), networkService(service), socket(connectionParams.socket),
+(boost::shared_ptr<boost::asio::io_service> service, ConnectionParamters connectionParams, Utilities::BufferPoolPtr readBufferPool, Utilities::FileLoggerPtr debugLogger)
+: readBuffers(readBufferPool), maxReadSize(connectionParams.readBufferSize), readWatermarks(connectionParams.readWatermarks),
+  quickAck(connectionParams.quickAck), writeWatermarks(connectionParams.writeWatermarks), debugLogger(debugLogger), writeStrand(connectionParams.socket->get_io_service()),
+  readStrand(connectionParams.socket->get_io_service()), eventsStrand(connectionParams.socket->get_io_service()), networkService(service), socket(connectionParams.socket),
   connectionID(connectionParams.connectionID), localPeerType(connectionParams.localPeerType),
   connectionType(connectionParams.expectedConnection), state(ConnectionState::INVALID),
   lastSubstate(ConnectionSubstate::NONE), initiation(connectionParams.initiation)
 {
-    if(externalReadBuffer != nullptr)
-    {//use an external buffer
-        readBuffer = externalReadBuffer;
-        isExternalReadBufferUsed = true;
-    }
-    else
-    {//use an internal buffer
-        readBuffer = new boost::asio::streambuf(connectionParams.readBufferSize);
-        isExternalReadBufferUsed = false;
-    }
-
-    boost::asio::async_read(*socket, readBuffer->prepare(ConnectionRequest::BYTE_LENGTH),
+    if(!readBuffers)
+        readBuffers = Utilities::BufferPool::create(maxReadSize, 1);
+    
+    payloadBuffer = readBuffers->acquire(ConnectionRequest::BYTE_LENGTH);
+    boost::asio::async_read(*socket, boost::asio::buffer(payloadBuffer->data(), ConnectionRequest::BYTE_LENGTH),
             readStrand.wrap(boost::bind(&NetworkManagement_Connections::Connection::initialReadRequestHandler, this, _1, _2)));
 }
 
 NetworkManagement_Connections::Connection::Connection
 (boost::shared_ptr<boost::asio::io_service> service, ConnectionParamters connectionParams, ConnectionRequest requestParams,
- boost::asio::streambuf * externalReadBuffer, Utilities::FileLoggerPtr debugLogger)
-: debugLogger(debugLogger), writeStrand(connectionParams.socket->get_io_service()),
-  readStrand(connectionParams.socket->get_io_service()), networkService(service), socket(connectionParams.socket),
+ Utilities::BufferPoolPtr readBufferPool, Utilities::FileLoggerPtr debugLogger)
+: readBuffers(readBufferPool), maxReadSize(connectionParams.readBufferSize), readWatermarks(connectionParams.readWatermarks),
+  quickAck(connectionParams.quickAck), writeWatermarks(connectionParams.writeWatermarks), debugLogger(debugLogger), writeStrand(connectionParams.socket->get_io_service()),
+  readStrand(connectionParams.socket->get_io_service()), eventsStrand(connectionParams.socket->get_io_service()), networkService(service), socket(connectionParams.socket),
   connectionID(connectionParams.connectionID), localPeerType(connectionParams.localPeerType),
   connectionType(connectionParams.expectedConnection), state(ConnectionState::INVALID),
   lastSubstate(ConnectionSubstate::NONE), initiation(connectionParams.initiation)
 {
-    if(externalReadBuffer != nullptr)
-    {//use an external buffer
-        readBuffer = externalReadBuffer;
-        isExternalReadBufferUsed = true;
-    }
-    else
-    {//use an internal buffer
-        readBuffer = new boost::asio::streambuf(connectionParams.readBufferSize);
-        isExternalReadBufferUsed = false;
-    }
+    if(!readBuffers)
+        readBuffers = Utilities::BufferPool::create(maxReadSize, 1);
     
     connectionRequest = requestParams;
     boost::asio::async_write(*socket, boost::asio::buffer(connectionRequest.toBytes(), ConnectionRequest::BYTE_LENGTH), 
@@ -78,9 +65,6 @@ NetworkManagement_Connections::Connection::~Connection()
         delete currentEventData.second;
     eventsData.clear();
     
-    if(!isExternalReadBufferUsed)
-        delete readBuffer;
-    
     logMessage(LogSeverity::Debug, "(~) Destruction completed.");
 }
 
@@ -102,26 +86,50 @@ void NetworkManagement_Connections::Connection::disconnect()
     onDisconnectEvent();
     canBeDestroyedEvent();
     
+    //the onDisconnect and canBeDestroyed events are delivered asynchronously, so their handlers are kept attached
     onConnect.disconnect_all_slots();
-    onDisconnect.disconnect_all_slots();
-    onDataReceived.disconnect_all_slots();
-    onWriteResultReceived.disconnect_all_slots();
-    canBeDestroyed.disconnect_all_slots();
+    
+    //data events that were already posted are still delivered; their handlers are detached on the events strand, after them
+    postEvent([&]()
+    {
+        onDataReceived.disconnect_all_slots();
+        onWriteResultReceived.disconnect_all_slots();
+        onFlowControl.disconnect_all_slots();
+    }, true);
     
     logMessage(LogSeverity::Debug, "(disconnect) Disconnected.");
 }
 
-void NetworkManagement_Connections::Connection::sendData(const ByteData & data)
+bool NetworkManagement_Connections::Connection::sendData(ByteDataPtr data)
 {
     if(closeConnection)
-        return;
+        return false;
     
-    boost::lock_guard<boost::mutex> pendingDataLock(writeDataMutex);
-    ++pendingWriteOperations;
-    if(pendingWriteOperations > 1)
-        pendingWritesData.push(&data);
-    else
-        queueNextWrite(data);
+    {
+        boost::lock_guard<boost::mutex> pendingDataLock(writeDataMutex);
+        if(isWriteBlocked)
+        {
+            ++rejectedWrites;
+            return false;
+        }
+        
+        pendingWritesData.push_back(data);
+        pendingWriteBytes += data->size();
+        ++pendingWriteMessages;
+        
+        if(!isWriteActive)
+            queueNextWrite();
+        
+        if(!writeWatermarks.isHigh(pendingWriteBytes, pendingWriteMessages))
+            return true;
+        
+        isWriteBlocked = true;
+        ++writeQueueBlocks;
+    }
+    
+    logMessage(LogSeverity::Debug, "(sendData) Write queue high watermark reached.");
+    onFlowControlEvent(FlowControlEvent::WRITE_QUEUE_HIGH);
+    return true;
 }
 
 void NetworkManagement_Connections::Connection::enableLifecycleEvents()
@@ -148,6 +156,7 @@ void NetworkManagement_Connections::Connection::enableLifecycleEvents()
                 case EventType::CAN_BE_DESTROYED:       eventsToFire.push(EventType::CAN_BE_DESTROYED); break;
                 case EventType::DATA_RECEIVED:          { remainingEvents.push(currentEventID); erase = false; } break;
                 case EventType::WRITE_RESULT_RECEIVED:  { remainingEvents.push(currentEventID); erase = false; } break;
+                case EventType::FLOW_CONTROL:           { remainingEvents.push(currentEventID); erase = false; } break;
                 default:
                 {
                     logMessage(LogSeverity::Debug, "(enableLifecycleEvents) Unexpected event type encountered.");
@@ -216,6 +225,7 @@ void NetworkManagement_Connections::Connection::enableDataEvents()
             {
                 case EventType::DATA_RECEIVED:          eventsToFire.push(currentEventData); break;
                 case EventType::WRITE_RESULT_RECEIVED:  eventsToFire.push(currentEventData); break;
+                case EventType::FLOW_CONTROL:           eventsToFire.push(currentEventData); break;
                 case EventType::CONNECT:                { remainingEvents.push(currentEventID); erase = false; } break;
                 case EventType::DISCONNECT:             { remainingEvents.push(currentEventID); erase = false; } break;
                 case EventType::CAN_BE_DESTROYED:       { remainingEvents.push(currentEventID); erase = false; } break;
@@ -237,9 +247,8 @@ void NetworkManagement_Connections::Connection::enableDataEvents()
         if(remainingEvents.size() > 0)
             events.swap(remainingEvents);
         
-        eventsLock.unlock();
-        
-        //fires all eligible events
+        //queues all eligible events on the events strand, while new events are still held back by the lock,
+        //so that they are delivered before (and in the same order as) any events that follow
         while(eventsToFire.size() > 0)
         {
             boost::tuples::tuple<EventType, boost::any, boost::any> * currentEvent = eventsToFire.front();
@@ -249,13 +258,21 @@ void NetworkManagement_Connections::Connection::enableDataEvents()
             {
                 case EventType::DATA_RECEIVED:
                 {
-                    onDataReceived(boost::any_cast<ByteData>(currentEvent->get<1>()),
-                                   boost::any_cast<PacketSize>(currentEvent->get<2>()));
+                    BufferView data = boost::any_cast<BufferView>(currentEvent->get<1>());
+                    PacketSize remainingData = boost::any_cast<PacketSize>(currentEvent->get<2>());
+                    postEvent([&, data, remainingData]() { deliverReceivedData(data, remainingData); }, true);
                 } break;
                 
                 case EventType::WRITE_RESULT_RECEIVED:
                 {
-                    onWriteResultReceived(boost::any_cast<bool>(currentEvent->get<1>()));
+                    bool writeResult = boost::any_cast<bool>(currentEvent->get<1>());
+                    postEvent([&, writeResult]() { onWriteResultReceived(writeResult); }, true);
+                } break;
+                
+                case EventType::FLOW_CONTROL:
+                {
+                    FlowControlEvent event = boost::any_cast<FlowControlEvent>(currentEvent->get<1>());
+                    postEvent([&, event]() { onFlowControl(event); }, true);
                 } break;
                 
                 default:
@@ -289,18 +306,12 @@ void NetworkManagement_Connections::Connection::initialReadRequestHandler
     {
         try
         {
-            readBuffer->commit(ConnectionRequest::BYTE_LENGTH); //makes the incoming data available
-            boost::asio::streambuf::const_buffers_type rawRequest = readBuffer->data(); //retrieves the incoming data
-            
             ConnectionRequest request =
-                    ConnectionRequest::fromBytes(ByteData(boost::asio::buffers_begin(rawRequest),
-                                                          (boost::asio::buffers_begin(rawRequest)
-                                                           + ConnectionRequest::BYTE_LENGTH)));
+                    ConnectionRequest::fromBytes(BufferView(payloadBuffer, ConnectionRequest::BYTE_LENGTH).toByteData());
             
+            payloadBuffer.reset(); //returns the buffer to the pool
             logMessage(LogSeverity::Debug, "(initialReadRequestHandler) Request data received.");
             
-            readBuffer->consume(ConnectionRequest::BYTE_LENGTH); //removes the incoming data from the buffer
-            
             if(request.connectionType == connectionType)
             {
                 connectionRequest = request;
@@ -372,27 +383,129 @@ void NetworkManagement_Connections::Connection::queueNextRead(BufferSize readSiz
     if(closeConnection)
         return;
     
+    if(quickAck)
+    {//the kernel leaves quick ACK mode on its own, so it is re-enabled before waiting for more data
+#if defined(TCP_QUICKACK)
+        boost::system::error_code optionError;
+        socket->set_option(NetworkManagement_Types::IntegerSocketOption<IPPROTO_TCP, TCP_QUICKACK>(1), optionError);
+#endif
+    }
+    
     ++pendingHandlers;
-    boost::asio::async_read(*socket, readBuffer->prepare(readSize), 
+    boost::asio::async_read(*socket, getNextReadBuffer(readSize), 
             readStrand.wrap(boost::bind(&NetworkManagement_Connections::Connection::readHandler, this, _1, _2)));
 }
 
-void NetworkManagement_Connections::Connection::queueNextWrite(const ByteData & data)
+bool NetworkManagement_Connections::Connection::pauseReadingIfFull(BufferSize nextReadSize)
+{
+    {
+        boost::lock_guard<boost::mutex> readQueueLock(readQueueMutex);
+        if(readPauseHolds == 0 && !readWatermarks.isHigh(pendingReadBytes, pendingReadMessages))
+            return false;
+        
+        isReadPaused = true;
+        pausedReadSize = nextReadSize;
+        ++readPauses;
+    }
+    
+    logMessage(LogSeverity::Debug, "(pauseReadingIfFull) Read queue full or held; reading paused.");
+    onFlowControlEvent(FlowControlEvent::READ_QUEUE_HIGH);
+    return true;
+}
+
+void NetworkManagement_Connections::Connection::holdReceivedData(bool pauseReading)
+{
+    isDeliveredDataHeld = true;
+    
+    if(pauseReading)
+    {
+        boost::lock_guard<boost::mutex> readQueueLock(readQueueMutex);
+        ++readPauseHolds;
+    }
+}
+
+void NetworkManagement_Connections::Connection::deliverReceivedData(const BufferView & data, PacketSize remainingData)
 {
+    isDeliveredDataHeld = false;
+    onDataReceived(data, remainingData);
+    
+    if(!isDeliveredDataHeld)
+        onDataHandled(data.size(), false);
+}
+
+void NetworkManagement_Connections::Connection::onDataHandled(BufferSize dataSize, bool releasePause)
+{
+    {
+        boost::lock_guard<boost::mutex> readQueueLock(readQueueMutex);
+        pendingReadBytes -= dataSize;
+        --pendingReadMessages;
+        
+        if(releasePause)
+            --readPauseHolds;
+        
+        if(!isReadPaused || readPauseHolds > 0 || !readWatermarks.isLow(pendingReadBytes, pendingReadMessages))
+            return;
+        
+        isReadPaused = false;
+    }
+    
     if(closeConnection)
         return;
     
-    lastSubstate = ConnectionSubstate::WRITING;
+    ++pendingHandlers;
+    readStrand.post(boost::bind(&NetworkManagement_Connections::Connection::resumeReading, this));
+    onFlowControlEvent(FlowControlEvent::READ_QUEUE_LOW);
+}
+
+void NetworkManagement_Connections::Connection::resumeReading()
+{
+    logMessage(LogSeverity::Debug, "(resumeReading) Read queue low watermark reached; reading resumed.");
+    queueNextRead(pausedReadSize);
+    --pendingHandlers;
+}
 
-    //creates the header packet and puts it with the data in a new buffer sequence
-    ByteData headerData;
-    HeaderPacket{data.size()}.toNetworkBytes(headerData);
-    std::vector<boost::asio::const_buffer> sendBuffer;
-    sendBuffer.push_back(boost::asio::buffer(headerData, HeaderPacket::BYTE_LENGTH));
-    sendBuffer.push_back(boost::asio::buffer(data, data.size()));
+boost::asio::mutable_buffers_1 NetworkManagement_Connections::Connection::getNextReadBuffer(BufferSize readSize)
+{
+    if(isHeaderExpected)
+        return boost::asio::buffer(headerBuffer, HeaderPacket::BYTE_LENGTH);
+    
+    payloadBuffer = readBuffers->acquire(readSize);
+    return boost::asio::buffer(payloadBuffer->data(), readSize);
+}
+
+void NetworkManagement_Connections::Connection::queueNextWrite()
+{
+    if(closeConnection)
+        return;
+    
+    lastSubstate = ConnectionSubstate::WRITING;
+    isWriteActive = true;
+    
+    //moves as many pending messages as allowed into the next write operation
+    BufferSize batchSize = 0;
+    while(!pendingWritesData.empty() && activeWritesData.size() < MAX_WRITE_BATCH_MESSAGES)
+    {
+        BufferSize nextSize = pendingWritesData.front()->size() + HeaderPacket::BYTE_LENGTH;
+        if(!activeWritesData.empty() && (batchSize + nextSize) > MAX_WRITE_BATCH_SIZE)
+            break;
+        
+        batchSize += nextSize;
+        activeWritesData.push_back(pendingWritesData.front());
+        pendingWritesData.pop_front();
+    }
+    
+    //creates the header packets and puts them with the data in a single buffer sequence
+    activeWritesHeaders.resize(activeWritesData.size() * HeaderPacket::BYTE_LENGTH);
+    for(std::size_t i = 0; i < activeWritesData.size(); i++)
+    {
+        Byte * currentHeader = activeWritesHeaders.data() + (i * HeaderPacket::BYTE_LENGTH);
+        HeaderPacket{activeWritesData[i]->size()}.toNetworkBytes(currentHeader);
+        activeWritesBuffers.push_back(boost::asio::buffer(currentHeader, HeaderPacket::BYTE_LENGTH));
+        activeWritesBuffers.push_back(boost::asio::buffer(*activeWritesData[i]));
+    }
     
     ++pendingHandlers;
-    boost::asio::async_write(*socket, sendBuffer,
+    boost::asio::async_write(*socket, activeWritesBuffers,
             writeStrand.wrap(boost::bind(&NetworkManagement_Connections::Connection::writeHandler, this, _1, _2)));
 }
 
@@ -405,72 +518,43 @@ void NetworkManagement_Connections::Connection::readHandler
         return;
     }
     
-    if(!readError)
+    boost::system::error_code currentError = readError;
+    std::size_t currentBytesRead = bytesRead;
+    unsigned int currentImmediateReads = 0;
+    
+    while(!currentError)
     {
         lastSubstate = ConnectionSubstate::READING;
+        BufferSize nextReadSize = (isHeaderExpected) ? processHeader() : processPayload(currentBytesRead);
+        lastSubstate = ConnectionSubstate::WAITING;
         
-        readBuffer->commit(bytesRead); //makes the incoming data available
-        boost::asio::streambuf::const_buffers_type rawData = readBuffer->data(); //retrieves the incoming data
-        ByteData data(boost::asio::buffers_begin(rawData), boost::asio::buffers_begin(rawData) + bytesRead);
-        readBuffer->consume(bytesRead); //removes the incoming data from the buffer
+        if(closeConnection || pauseReadingIfFull(nextReadSize))
+            break;
         
-        if(isHeaderExpected)
-        {//the incoming data should represent a header
-            HeaderPacket header = HeaderPacket::fromNetworkBytes(data);
-            isHeaderExpected = false;
-            
-            if(header.payloadSize > readBuffer->max_size())
-            {//too much data for the buffer was sent; needs to be split into several reads
-                remainingBytes = header.payloadSize;
-                queueNextRead(readBuffer->max_size());
-            }
-            else if(header.payloadSize == 0)
-            {//empty header was received
-                logMessage(LogSeverity::Debug, "(readHandler) Header with payload size '0' encountered.");
-                isHeaderExpected = true;
-                queueNextRead(HeaderPacket::BYTE_LENGTH);
-            }
-            else
-            {//the data is going to fit in the buffer
-                queueNextRead(header.payloadSize);
-            }
+        //reads the next header/payload immediately, if all of its data is already available
+        std::size_t availableBytes = socket->available(currentError);
+        if(!currentError && availableBytes >= nextReadSize && currentImmediateReads < MAX_IMMEDIATE_READS)
+        {
+            ++currentImmediateReads;
+            ++immediateReads;
+            currentBytesRead = boost::asio::read(*socket, getNextReadBuffer(nextReadSize), currentError);
         }
-        else
-        {//data
-            received += bytesRead;
-            
-            if(remainingBytes > 0)
-            {//expecting more data
-                remainingBytes -= bytesRead;
-                
-                if(remainingBytes > readBuffer->max_size())
-                {//more read operations are needed
-                    queueNextRead(readBuffer->max_size());
-                }
-                else if(remainingBytes == 0)
-                {//no more data to read
-                    isHeaderExpected = true;
-                    queueNextRead(HeaderPacket::BYTE_LENGTH);
-                }
-                else
-                {//last read operation
-                    queueNextRead(remainingBytes);
-                }
-            }
-            else
-            {//all data was read
-                isHeaderExpected = true;
-                queueNextRead(HeaderPacket::BYTE_LENGTH);
-            }
-            
-            onDataReceivedEvent(data, remainingBytes);
+        else if(!currentError)
+        {
+            queueNextRead(nextReadSize);
+            break;
         }
-        
-        lastSubstate = ConnectionSubstate::WAITING;
     }
-    else if(readError == boost::asio::error::eof
-            || readError == boost::asio::error::connection_reset
-            || readError == boost::asio::error::connection_aborted)
+    
+    if(!currentError)
+    {
+        --pendingHandlers;
+        return;
+    }
+    
+    if(currentError == boost::asio::error::eof
+       || currentError == boost::asio::error::connection_reset
+       || currentError == boost::asio::error::connection_aborted)
     {
         logMessage(LogSeverity::Debug, "(readHandler) Connection terminated by remote peer.");
         
@@ -479,7 +563,7 @@ void NetworkManagement_Connections::Connection::readHandler
     }
     else
     {
-        logMessage(LogSeverity::Debug, "(readHandler) Read error encountered: <" + readError.message() + ">.");
+        logMessage(LogSeverity::Debug, "(readHandler) Read error encountered: <" + currentError.message() + ">.");
         lastSubstate = ConnectionSubstate::FAILED;
         disconnect();
     }
@@ -487,6 +571,70 @@ void NetworkManagement_Connections::Connection::readHandler
     --pendingHandlers;
 }
 
+BufferSize NetworkManagement_Connections::Connection::processHeader()
+{
+    HeaderPacket header = HeaderPacket::fromNetworkBytes(headerBuffer, HeaderPacket::BYTE_LENGTH);
+    isHeaderExpected = false;
+    
+    if(header.payloadSize > maxReadSize)
+    {//too much data for a single buffer was sent; needs to be split into several reads
+        remainingBytes = header.payloadSize;
+        return maxReadSize;
+    }
+    else if(header.payloadSize == 0)
+    {//empty header was received
+        logMessage(LogSeverity::Debug, "(processHeader) Header with payload size '0' encountered.");
+        isHeaderExpected = true;
+        return HeaderPacket::BYTE_LENGTH;
+    }
+    else
+    {//the data is going to fit in a single buffer
+        return header.payloadSize;
+    }
+}
+
+BufferSize NetworkManagement_Connections::Connection::processPayload(std::size_t bytesRead)
+{
+    received += bytesRead;
+    BufferSize nextReadSize = HeaderPacket::BYTE_LENGTH;
+    
+    if(remainingBytes > 0)
+    {//expecting more data
+        remainingBytes -= bytesRead;
+        
+        if(remainingBytes > maxReadSize)
+        {//more read operations are needed
+            nextReadSize = maxReadSize;
+        }
+        else if(remainingBytes == 0)
+        {//no more data to read
+            isHeaderExpected = true;
+        }
+        else
+        {//last read operation
+            nextReadSize = remainingBytes;
+        }
+    }
+    else
+    {//all data was read
+        isHeaderExpected = true;
+    }
+    
+    //the event handlers take over the payload buffer; a new one is acquired for the next payload
+    BufferView data(payloadBuffer, bytesRead);
+    payloadBuffer.reset();
+    
+    {
+        boost::lock_guard<boost::mutex> readQueueLock(readQueueMutex);
+        pendingReadBytes += bytesRead;
+        ++pendingReadMessages;
+    }
+    
+    onDataReceivedEvent(data, remainingBytes);
+    
+    return nextReadSize;
+}
+
 void NetworkManagement_Connections::Connection::writeHandler
 (const boost::system::error_code & writeError, std::size_t bytesSent)
 {
@@ -496,38 +644,82 @@ void NetworkManagement_Connections::Connection::writeHandler
         return;
     }
     
-    if(!writeError)
+    std::size_t messagesSent;
+    std::size_t messagesDropped = 0;
+    bool isNextWriteQueued;
+    bool isWriteUnblocked = false;
     {
-        sent += (bytesSent - HeaderPacket::BYTE_LENGTH);
-        onWriteResultReceivedEvent(true);
-        lastSubstate = ConnectionSubstate::WAITING;
+        boost::lock_guard<boost::mutex> pendingDataLock(writeDataMutex);
+        messagesSent = activeWritesData.size();
+        for(const ByteDataPtr & currentData : activeWritesData)
+            pendingWriteBytes -= currentData->size();
         
-        {//checks if there are pending operations and starts the next one
-            boost::lock_guard<boost::mutex> pendingDataLock(writeDataMutex);
-            --pendingWriteOperations;
-            if(pendingWriteOperations > 0)
-            {
-                queueNextWrite(*pendingWritesData.front());
-                pendingWritesData.pop();
-            }
+        pendingWriteMessages -= messagesSent;
+        activeWritesData.clear();
+        activeWritesBuffers.clear();
+        
+        if(writeError)
+        {//the connection is closed, so the messages waiting for the next write will not be sent either
+            messagesDropped = pendingWritesData.size();
+            pendingWritesData.clear();
+            pendingWriteBytes = 0;
+            pendingWriteMessages = 0;
+        }
+        
+        //starts the next write operation, if there are pending messages
+        isNextWriteQueued = (!writeError && !pendingWritesData.empty());
+        if(isNextWriteQueued)
+            queueNextWrite();
+        else
+            isWriteActive = false;
+        
+        //accepts new data again, once the write queue has drained enough
+        if(!writeError && isWriteBlocked && writeWatermarks.isLow(pendingWriteBytes, pendingWriteMessages))
+        {
+            isWriteBlocked = false;
+            isWriteUnblocked = true;
         }
     }
-    else if(writeError == boost::asio::error::eof
-            || writeError == boost::asio::error::connection_reset
-            || writeError == boost::asio::error::connection_aborted)
+    
+    if(isWriteUnblocked)
     {
-        logMessage(LogSeverity::Debug, "(writeHandler) Connection terminated by remote peer (?).");
-        lastSubstate = ConnectionSubstate::DROPPED;
-        onWriteResultReceivedEvent(false);
-        disconnect();
+        logMessage(LogSeverity::Debug, "(writeHandler) Write queue low watermark reached.");
+        onFlowControlEvent(FlowControlEvent::WRITE_QUEUE_LOW);
+    }
+    
+    if(!writeError)
+    {
+        ++writeOperations;
+        sent += (bytesSent - messagesSent * HeaderPacket::BYTE_LENGTH);
+        
+        if(!isNextWriteQueued)
+            lastSubstate = ConnectionSubstate::WAITING;
+        
+        for(std::size_t i = 0; i < messagesSent; i++)
+            onWriteResultReceivedEvent(true);
     }
     else
     {
-        logMessage(LogSeverity::Debug, "(writeHandler) Write error encountered: <" + writeError.message() + ">.");
-        lastSubstate = ConnectionSubstate::FAILED;
-        onWriteResultReceivedEvent(false);
+        if(writeError == boost::asio::error::eof
+           || writeError == boost::asio::error::connection_reset
+           || writeError == boost::asio::error::connection_aborted)
+        {
+            logMessage(LogSeverity::Debug, "(writeHandler) Connection terminated by remote peer (?).");
+            lastSubstate = ConnectionSubstate::DROPPED;
+        }
+        else
+        {
+            logMessage(LogSeverity::Debug, "(writeHandler) Write error encountered: <" + writeError.message() + ">.");
+            lastSubstate = ConnectionSubstate::FAILED;
+        }
+        
+        //every message of the failed write (and every message still queued) is reported as failed;
+        //the results are posted before the disconnect, so they are delivered before the event handlers are detached
+        for(std::size_t i = 0; i < (messagesSent + messagesDropped); i++)
+            onWriteResultReceivedEvent(false);
+        
         disconnect();
     }
     
     --pendingHandlers;
-}
+}
\ No newline at end of file
@@ -20,7 +20,10 @@
 
 #include <string>
 #include <queue>
+#include <deque>
+#include <vector>
 #include <atomic>
+#include <functional>
 #include <boost/any.hpp>
 #include <boost/asio.hpp>
 #include <boost/signals2.hpp>
@@ -29,16 +32,19 @@
 #include <boost/unordered_map.hpp>
 #include "../Types/Types.h"
 #include "../Types/Packets.h"
+#include "../Types/SocketOptions.h"
 
 #include "../../Utilities/Strings/Common.h"
 #include "../../Utilities/Strings/Network.h"
 #include "../../Utilities/FileLogger.h"
+#include "../../Utilities/BufferPool.h"
 #include "../../Common/Types.h"
 
 using Common_Types::Byte;
 using Common_Types::IPAddress;
 using Common_Types::IPPort;
 using Common_Types::ByteData;
+using Common_Types::ByteDataPtr;
 
 using NetworkManagement_Types::PeerType;
 using NetworkManagement_Types::SocketPtr;
@@ -52,8 +58,10 @@ using NetworkManagement_Types::ConnectionEventID;
 using NetworkManagement_Types::ConnectionSubstate;
 using NetworkManagement_Types::RawConnectionID;
 using NetworkManagement_Types::ConnectionInitiation;
+using NetworkManagement_Types::FlowControlEvent;
 using NetworkManagement_Types::OperationTimeoutLength;
 using Common_Types::TransferredDataAmount;
+using Utilities::BufferView;
 
 namespace Convert = Utilities::Strings;
 
@@ -63,11 +71,86 @@ namespace NetworkManagement_Connections
     /**
      * Class representing a TCP connection between two endpoints.\n\n
      * 
+     * Incoming payloads are read directly into pooled buffers and are handed to the
+     * <code>onDataReceived</code> handlers as <code>BufferView</code>s, without being copied.
+     * Data events (received data, write results and flow control) are delivered one at a time,
+     * in the order in which they occurred, even when the network service runs on several threads.
+     * When the next header (and payload) is already available on the socket, it is
+     * read immediately, instead of waiting for another asynchronous read.
+     * 
+     * Outgoing messages are queued and all messages queued while a write is in progress
+     * are sent together by the next write (as a single gathered write), up to
+     * <code>MAX_WRITE_BATCH_SIZE</code> bytes or <code>MAX_WRITE_BATCH_MESSAGES</code> messages.
+     * 
+     * Both directions can be bounded with high/low watermarks (see <code>QueueWatermarks</code>):\n
+     * * once the write queue reaches its high watermark, <code>sendData</code> rejects all new data
+     * until the queue is drained down to its low watermark;\n
+     * * once the received data that is still waiting for (or being processed by) the
+     * <code>onDataReceived</code> handlers reaches its high watermark, reading from the socket is
+     * paused until the handlers catch up, down to the low watermark.\n
+     * Each crossing fires an <code>onFlowControl</code> event.
+     * 
      * Note: A connection object should always be created by a <code>ConnectionManager</code>.
      */
     class Connection 
     {
         public:
+            /**
+             * Structure for holding the high/low watermarks of a connection queue.\n
+             * 
+             * A queue is full when either of its high watermarks is reached and stays full
+             * until all of its set watermarks are at or below their low values. A high
+             * watermark of 0 sets no limit.
+             */
+            struct QueueWatermarks
+            {
+                /** Amount of queued data (in bytes) at which the queue becomes full (0 = no limit). */
+                BufferSize highBytes;
+                
+                /** Amount of queued data (in bytes) at which a full queue becomes available again. */
+                BufferSize lowBytes;
+                
+                /** Number of queued messages at which the queue becomes full (0 = no limit). */
+                std::size_t highMessages;
+                
+                /** Number of queued messages at which a full queue becomes available again. */
+                std::size_t lowMessages;
+                
+                /**
+                 * Validates the watermarks.
+                 * 
+                 * @return <code>true</code>, if each low watermark is below its (set) high watermark
+                 */
+                bool isValid() const
+                {
+                    return (highBytes == 0 || lowBytes < highBytes) && (highMessages == 0 || lowMessages < highMessages);
+                }
+                
+                /**
+                 * Checks whether a queue with the specified contents has reached its high watermarks.
+                 * 
+                 * @param bytes the amount of queued data (in bytes)
+                 * @param messages the number of queued messages
+                 * @return <code>true</code>, if the queue is full
+                 */
+                bool isHigh(BufferSize bytes, std::size_t messages) const
+                {
+                    return (highBytes > 0 && bytes >= highBytes) || (highMessages > 0 && messages >= highMessages);
+                }
+                
+                /**
+                 * Checks whether a full queue with the specified contents has drained to its low watermarks.
+                 * 
+                 * @param bytes the amount of queued data (in bytes)
+                 * @param messages the number of queued messages
+                 * @return <code>true</code>, if the queue is no longer full
+                 */
+                bool isLow(BufferSize bytes, std::size_t messages) const
+                {
+                    return (highBytes == 0 || bytes <= lowBytes) && (highMessages == 0 || messages <= lowMessages);
+                }
+            };
+            
             /** Parameters structure for holding <code>Connection</code> configuration data. */
             struct ConnectionParamters
             {
@@ -86,8 +169,17 @@ namespace NetworkManagement_Connections
                 /** Pointer to a valid socket object. */
                 SocketPtr socket;
                 
-                /** The size of the buffer for incoming data. */
+                /** The maximum amount of incoming data to be read at once (larger payloads are split). */
                 BufferSize readBufferSize;
+                
+                /** Watermarks for the outgoing data waiting to be sent (all 0 = unbounded). */
+                QueueWatermarks writeWatermarks;
+                
+                /** Watermarks for the incoming data waiting to be handled (all 0 = unbounded). */
+                QueueWatermarks readWatermarks;
+                
+                /** Denotes whether <code>TCP_QUICKACK</code> is to be re-enabled before each read (where supported). */
+                bool quickAck;
             };
             
             /**
@@ -96,12 +188,12 @@ namespace NetworkManagement_Connections
              * Note: To be used for incoming connections only.
              * 
              * @param connectionParams connection configuration data
-             * @param externalReadBuffer externally supplied read buffer, if any
+             * @param readBufferPool pool to use for acquiring read buffers, if any (a new one is created otherwise)
              * @param debugLogger logger for debugging, if any
              */
             Connection(boost::shared_ptr<boost::asio::io_service> service,
                        ConnectionParamters connectionParams,
-                       boost::asio::streambuf * externalReadBuffer = nullptr,
+                       Utilities::BufferPoolPtr readBufferPool = Utilities::BufferPoolPtr(),
                        Utilities::FileLoggerPtr debugLogger = Utilities::FileLoggerPtr());
             
             /**
@@ -111,13 +203,13 @@ namespace NetworkManagement_Connections
              * 
              * @param connectionParams connection configuration data
              * @param requestParams request parameters to be sent to the remote peer
-             * @param externalReadBuffer externally supplied read buffer, if any
+             * @param readBufferPool pool to use for acquiring read buffers, if any (a new one is created otherwise)
              * @param debugLogger logger for debugging, if any
              */
             Connection(boost::shared_ptr<boost::asio::io_service> service,
                        ConnectionParamters connectionParams,
                        ConnectionRequest requestParams,
-                       boost::asio::streambuf * externalReadBuffer = nullptr,
+                       Utilities::BufferPoolPtr readBufferPool = Utilities::BufferPoolPtr(),
                        Utilities::FileLoggerPtr debugLogger = Utilities::FileLoggerPtr());
             
             /**
@@ -142,16 +234,35 @@ namespace NetworkManagement_Connections
             /**
              * Sends the supplied data to the associated remote peer.
              * 
-             * Warning: The caller is responsible for retaining the data until
-             * the write operation is complete.
+             * Note: If a write operation is currently running, the data will be
+             * enqueued and sent with the next write operation; otherwise, the write
+             * operation will be started immediately.
+             * 
+             * Note: The connection keeps a reference to the data until the write
+             * operation is complete; the data must not be modified in the meantime.
+             * 
+             * Note: If the write queue is full (see <code>QueueWatermarks</code>), the data is
+             * rejected and no write result is reported for it; the caller should wait for
+             * the <code>WRITE_QUEUE_LOW</code> flow control event before sending more data.
              * 
-             * Note: If a write operation is currently running, the new request
-             * will be enqueued and at a later time; otherwise, the write operation
-             * will be started immediately.
+             * Note: If a write operation fails, the connection is closed and a failed write result
+             * is reported for every message sent by that operation or still waiting to be sent.
              * 
              * @param data the data to be sent
+             * @return <code>true</code>, if the data was queued for sending;
+             * <code>false</code>, if the write queue is full or the connection is closed
              */
-            void sendData(const ByteData & data);
+            bool sendData(ByteDataPtr data);
+            
+            /**
+             * Sends a copy of the supplied data to the associated remote peer.
+             * 
+             * @param data the data to be sent
+             * @return <code>true</code>, if the data was queued for sending
+             * 
+             * @see sendData(ByteDataPtr)
+             */
+            bool sendData(const ByteData & data) { return sendData(ByteDataPtr(new ByteData(data))); }
             
             //Event Management
             /**
@@ -183,7 +294,8 @@ namespace NetworkManagement_Connections
             /**
              * Enables all data events.
              * 
-             * Note: All currently pending events will be fired within this call.
+             * Note: All currently pending events are queued for delivery (before any new events)
+             * within this call; they are fired after it returns.
              */
             void enableDataEvents();
             
@@ -192,6 +304,34 @@ namespace NetworkManagement_Connections
              */
             void disableDataEvents();
             
+            /**
+             * Keeps the data being delivered by the current <code>onDataReceived</code> event
+             * in the read queue, after the event handlers return, until it is released
+             * with <code>releaseReceivedData()</code>.\n\n
+             * 
+             * Held data counts towards the read queue watermarks; if requested, reading is
+             * also paused (after the current read) until the data is released.
+             * 
+             * Note: To be called only from within an <code>onDataReceived</code> event handler.
+             * 
+             * @param pauseReading denotes whether reading is to be paused until the data is released
+             */
+            void holdReceivedData(bool pauseReading);
+            
+            /**
+             * Releases data kept in the read queue with <code>holdReceivedData()</code>,
+             * resuming reading, if it was paused and nothing else keeps it paused.
+             * 
+             * Note: Can be called from any thread.
+             * 
+             * @param dataSize the amount of released data (in bytes)
+             * @param pauseReading the value supplied to <code>holdReceivedData()</code>, when the data was held
+             */
+            void releaseReceivedData(BufferSize dataSize, bool pauseReading)
+            {
+                onDataHandled(dataSize, pauseReading);
+            }
+            
             //Connection Info
             /** Retrieves the internal ID associated with this connection.\n\n@return the connection ID */
             RawConnectionID getID()                     const { return connectionID; }
@@ -203,6 +343,20 @@ namespace NetworkManagement_Connections
             TransferredDataAmount getBytesSent()        const { return sent; }
             /** Retrieves the amount of data received via the connection (in bytes).\n\n@return bytes received */
             TransferredDataAmount getBytesReceived()    const { return received; }
+            /** Retrieves the number of reads done without waiting for an asynchronous read.\n\n@return the number of immediate reads */
+            unsigned long getImmediateReadsCount()      const { return immediateReads; }
+            /** Retrieves the number of write operations done (each possibly sending several messages).\n\n@return the number of writes */
+            unsigned long getWriteOperationsCount()     const { return writeOperations; }
+            /** Retrieves the number of times the write queue reached its high watermark.\n\n@return the number of write queue blocks */
+            unsigned long getWriteQueueBlocksCount()    const { return writeQueueBlocks; }
+            /** Retrieves the number of messages rejected because the write queue was full.\n\n@return the number of rejected writes */
+            unsigned long getRejectedWritesCount()      const { return rejectedWrites; }
+            /** Retrieves the number of times reading was paused because the read queue was full.\n\n@return the number of read pauses */
+            unsigned long getReadPausesCount()          const { return readPauses; }
+            /** Retrieves the state of the write queue.\n\n@return <code>true</code>, if new data is currently rejected */
+            bool isWriteQueueBlocked()                  const { return isWriteBlocked; }
+            /** Retrieves the state of the read queue.\n\n@return <code>true</code>, if reading is currently paused */
+            bool isReadingPaused()                      const { return isReadPaused; }
             /** Retrieves the current connection state.\n\n@return the connection state */
             ConnectionState getState()                  const { return state; }
             /** Retrieves the current connection substate.\n\n@return the connection substate */
@@ -221,6 +375,8 @@ namespace NetworkManagement_Connections
             IPPort getRemotePort()                      const { return socket->remote_endpoint().port(); }
             /** Retrieves the local IP port associated with the connection.\n\n@return the local IP port */
             IPPort getLocalPort()                       const { return socket->local_endpoint().port(); }
+            /** Retrieves the native handle of the connection's socket (for diagnostics only).\n\n@return the socket handle */
+            boost::asio::ip::tcp::socket::native_handle_type getNativeSocketHandle() const { return socket->native_handle(); }
             
             //Signals
             /**
@@ -256,11 +412,14 @@ namespace NetworkManagement_Connections
              * 
              * Note: This is a data event.
              * 
+             * Note: The received data is a view of a pooled buffer; handlers that need
+             * to keep the data should keep the view (or copy it), not a pointer to it.
+             * 
              * @param function the event handler to be attached
              * @return the resulting signal connection object
              */
             boost::signals2::connection onDataReceivedEventAttach
-            (std::function<void(ByteData, PacketSize)> function)
+            (std::function<void(const BufferView &, PacketSize)> function)
             {
                 return onDataReceived.connect(function);
             }
@@ -279,6 +438,22 @@ namespace NetworkManagement_Connections
                 return onWriteResultReceived.connect(function);
             }
             
+            /**
+             * Attaches the supplied handler to the <code>onFlowControl</code> event.
+             * 
+             * Note: This is a data event.
+             * 
+             * Note: The event is fired whenever the write or read queue crosses one of its watermarks.
+             * 
+             * @param function the event handler to be attached
+             * @return the resulting signal connection object
+             */
+            boost::signals2::connection onFlowControlEventAttach
+            (std::function<void(FlowControlEvent)> function)
+            {
+                return onFlowControl.connect(function);
+            }
+            
             /**
              * Attaches the supplied handler to the <code>canBeDestroyed</code> event.
              * 
@@ -299,22 +474,49 @@ namespace NetworkManagement_Connections
             
         private:
             //Data - Reading
-            bool isExternalReadBufferUsed;              //denotes whether an external read buffer is to be used
-            boost::asio::streambuf * readBuffer;        //read buffer pointer (external or internal)
+            static const unsigned int MAX_IMMEDIATE_READS = 16; //maximum number of immediate reads per read handler call
+            Utilities::BufferPoolPtr readBuffers;       //pool of read buffers
+            BufferSize maxReadSize;                     //maximum amount of data to read at once
+            Byte headerBuffer[HeaderPacket::BYTE_LENGTH]; //read buffer for incoming headers
+            Utilities::PooledBufferPtr payloadBuffer;   //read buffer for the current payload (or connection request)
             bool isHeaderExpected;                      //denotes whether the next read operation should expect a header or data
             PacketSize remainingBytes = 0;              //the number of bytes remaining to be read for the current read operation
             TransferredDataAmount received = 0;         //received data (in bytes); Note: header transmission is not included
+            std::atomic<unsigned long> immediateReads{0}; //number of reads done without waiting for an asynchronous read
+            QueueWatermarks readWatermarks;             //watermarks for the data waiting to be handled
+            bool quickAck;                              //denotes whether TCP_QUICKACK is re-enabled before each read
+            boost::mutex readQueueMutex;                //read queue data mutex
+            BufferSize pendingReadBytes = 0;            //amount of received data not yet handled (in bytes)
+            std::size_t pendingReadMessages = 0;        //number of received messages not yet handled
+            std::atomic<bool> isReadPaused{false};      //denotes whether reading is paused until the handlers catch up
+            BufferSize pausedReadSize = 0;              //the amount of data to be read, when reading is resumed
+            std::atomic<unsigned long> readPauses{0};   //number of times reading was paused
+            unsigned int readPauseHolds = 0;            //number of held messages that keep reading paused until they are released
+            bool isDeliveredDataHeld = false;           //denotes whether the data being delivered was held by a handler (events strand only)
             
             //Data - Writing
-            boost::mutex writeDataMutex;                //pending operations data mutex
-            unsigned int pendingWriteOperations = 0;    //number of currently pending write operations
-            std::queue<const ByteData *>  pendingWritesData; //the data for all currently pending write operations
+            static const BufferSize MAX_WRITE_BATCH_SIZE = 256 * 1024; //maximum amount of data sent by a single write operation (unless a message is larger)
+            static const std::size_t MAX_WRITE_BATCH_MESSAGES = 256; //maximum number of messages sent by a single write operation
+            boost::mutex writeDataMutex;                //pending writes data mutex
+            bool isWriteActive = false;                 //denotes whether a write operation is currently running
+            std::deque<ByteDataPtr> pendingWritesData;  //the data waiting for the next write operation
+            std::vector<ByteDataPtr> activeWritesData;  //the data sent by the current write operation
+            std::vector<Byte> activeWritesHeaders;      //the headers sent by the current write operation
+            std::vector<boost::asio::const_buffer> activeWritesBuffers; //the buffer sequence for the current write operation
             TransferredDataAmount sent = 0;             //send data (in bytes); Note: header transmission is not included
+            std::atomic<unsigned long> writeOperations{0}; //number of write operations done
+            QueueWatermarks writeWatermarks;            //watermarks for the data waiting to be sent
+            BufferSize pendingWriteBytes = 0;           //amount of queued data not yet sent (in bytes)
+            std::size_t pendingWriteMessages = 0;       //number of queued messages not yet sent
+            std::atomic<bool> isWriteBlocked{false};    //denotes whether new data is rejected until the write queue is drained
+            std::atomic<unsigned long> writeQueueBlocks{0}; //number of times the write queue became full
+            std::atomic<unsigned long> rejectedWrites{0}; //number of messages rejected due to a full write queue
             
             //Utils
             Utilities::FileLoggerPtr debugLogger;       //debugging logger
             boost::asio::io_service::strand writeStrand;//synchronisation strand for write operations
             boost::asio::io_service::strand readStrand; //synchronisation strand for read operations
+            boost::asio::io_service::strand eventsStrand;//synchronisation strand for data events (keeps them in order)
             
             //Connection
             boost::shared_ptr<boost::asio::io_service> networkService; //socket's parent service
@@ -354,11 +556,71 @@ namespace NetworkManagement_Connections
             void queueNextRead(BufferSize readSize);
             
             /**
-             * Starts the next write operation, with the specified data to send.
+             * Checks the read queue watermarks and pauses reading, if the queue is full.
              * 
-             * @param data the data to be sent
+             * Note: To be called from the read strand only.
+             * 
+             * @param nextReadSize the amount of data to be read, when reading is resumed
+             * @return <code>true</code>, if reading was paused
+             */
+            bool pauseReadingIfFull(BufferSize nextReadSize);
+            
+            /**
+             * Fires the <code>onDataReceived</code> event and removes the data from the
+             * read queue, unless it was held by a handler.
+             * 
+             * Note: To be called from the events strand only.
+             * 
+             * @param data the received data
+             * @param remainingData the number of bytes remaining to be read
+             */
+            void deliverReceivedData(const BufferView & data, PacketSize remainingData);
+            
+            /**
+             * Removes the handled data from the read queue and resumes reading, if it was
+             * paused, no held data keeps it paused and the queue has drained to its low watermarks.
+             * 
+             * @param dataSize the amount of handled data (in bytes)
+             * @param releasePause denotes whether the data was keeping reading paused
+             */
+            void onDataHandled(BufferSize dataSize, bool releasePause);
+            
+            /**
+             * Resumes reading from the socket, after it was paused.
+             * 
+             * Note: To be called from the read strand only.
+             */
+            void resumeReading();
+            
+            /**
+             * Retrieves the buffer for the next read operation (the header buffer or a new payload buffer).
+             * 
+             * @param readSize the amount of data to be read
+             * @return the buffer to read into
+             */
+            boost::asio::mutable_buffers_1 getNextReadBuffer(BufferSize readSize);
+            
+            /**
+             * Processes the header in the header buffer.
+             * 
+             * @return the amount of data to be read next
+             */
+            BufferSize processHeader();
+            
+            /**
+             * Processes the payload in the current payload buffer and fires the <code>onDataReceived</code> event.
+             * 
+             * @param bytesRead the amount of data in the payload buffer
+             * @return the amount of data to be read next
              */
-            void queueNextWrite(const ByteData & data);
+            BufferSize processPayload(std::size_t bytesRead);
+            
+            /**
+             * Starts the next write operation, sending as many of the pending messages as the batch limits allow.
+             * 
+             * Note: Expects the write data mutex to be held by the caller and at least one pending message.
+             */
+            void queueNextWrite();
             
             /**
              * Read handler for all incoming data.
@@ -377,7 +639,7 @@ namespace NetworkManagement_Connections
             void writeHandler(const boost::system::error_code & writeError, std::size_t bytesSent);
             
             //Events
-            enum class EventType { INVALID, CONNECT, DISCONNECT, DATA_RECEIVED, WRITE_RESULT_RECEIVED, CAN_BE_DESTROYED };
+            enum class EventType { INVALID, CONNECT, DISCONNECT, DATA_RECEIVED, WRITE_RESULT_RECEIVED, FLOW_CONTROL, CAN_BE_DESTROYED };
             std::atomic<bool> lifecycleEventsBlocked{true}; //denotes whether life cycle events are blocked
             std::atomic<bool> dataEventsBlocked{true};      //denotes whether data events are blocked
             boost::mutex eventsMutex;                       //events mutex
@@ -387,8 +649,9 @@ namespace NetworkManagement_Connections
             
             boost::signals2::signal<void (RawConnectionID)> onConnect;              //life cycle event
             boost::signals2::signal<void (RawConnectionID)> onDisconnect;           //life cycle event
-            boost::signals2::signal<void (ByteData, PacketSize)> onDataReceived;    //data event
+            boost::signals2::signal<void (const BufferView &, PacketSize)> onDataReceived; //data event
             boost::signals2::signal<void (bool)> onWriteResultReceived;             //data event
+            boost::signals2::signal<void (FlowControlEvent)> onFlowControl;         //data event
             //NOTE: this is used internally and the object can be assumed invalid, after a single handler finishes executing
             boost::signals2::signal<void (RawConnectionID, ConnectionInitiation)> canBeDestroyed; //life cycle event
             
@@ -411,7 +674,7 @@ namespace NetworkManagement_Connections
                 }
                 
                 auto eventTask = [&]() { onConnect(connectionID); };
-                networkService->post(eventTask);
+                postEvent(eventTask, false);
             }
             
             /**
@@ -432,7 +695,7 @@ namespace NetworkManagement_Connections
                 }
                 
                 auto eventTask = [&]() { onDisconnect(connectionID); };
-                networkService->post(eventTask);
+                postEvent(eventTask, false);
             }
             
             /**
@@ -444,7 +707,7 @@ namespace NetworkManagement_Connections
              * @param data the bytes returned by the last read operation
              * @param remainingData the number of bytes remaining to be read
              */
-            void onDataReceivedEvent(ByteData data, PacketSize remainingData)
+            void onDataReceivedEvent(const BufferView & data, PacketSize remainingData)
             {
                 {
                     boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
@@ -455,8 +718,8 @@ namespace NetworkManagement_Connections
                     }
                 }
                 
-                auto eventTask = [&, data, remainingData]() { onDataReceived(data, remainingData); };
-                networkService->post(eventTask);
+                auto eventTask = [&, data, remainingData]() { deliverReceivedData(data, remainingData); };
+                postEvent(eventTask, true);
             }
             
             /**
@@ -479,7 +742,30 @@ namespace NetworkManagement_Connections
                 }
                 
                 auto eventTask = [&, writeResult]() { onWriteResultReceived(writeResult); };
-                networkService->post(eventTask);
+                postEvent(eventTask, true);
+            }
+            
+            /**
+             * Internal <code>onFlowControl</code> event dispatcher function.\n
+             * 
+             * If events are enabled, the <code>onFlowControl</code> event is fired directly;
+             * otherwise, it is enqueued, for later processing.
+             * 
+             * @param event the watermark crossing that occurred
+             */
+            void onFlowControlEvent(FlowControlEvent event)
+            {
+                {
+                    boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                    if(dataEventsBlocked)
+                    {
+                        queueEvent(EventType::FLOW_CONTROL, event);
+                        return;
+                    }
+                }
+                
+                auto eventTask = [&, event]() { onFlowControl(event); };
+                postEvent(eventTask, true);
             }
             
             /**
@@ -500,7 +786,25 @@ namespace NetworkManagement_Connections
                 }
                 
                 auto eventTask = [&]() { canBeDestroyed(connectionID, initiation); };
-                networkService->post(eventTask);
+                postEvent(eventTask, false);
+            }
+            
+            /**
+             * Posts the supplied event task for asynchronous processing; the task
+             * is counted as a pending handler, until it is done.
+             * 
+             * @param eventTask the event task to be processed
+             * @param ordered denotes whether the task is to be processed on the events strand
+             */
+            void postEvent(const std::function<void(void)> & eventTask, bool ordered)
+            {
+                ++pendingHandlers;
+                auto countedTask = [&, eventTask]() { eventTask(); --pendingHandlers; };
+                
+                if(ordered)
+                    eventsStrand.post(countedTask);
+                else
+                    networkService->post(countedTask);
             }
             
             /**
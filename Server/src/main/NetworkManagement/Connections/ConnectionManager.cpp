@@ -18,6 +18,11 @@
 #include "ConnectionManager.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 NetworkManagement_Connections::ConnectionManager::ConnectionManager
 (ConnectionManagerParameters parameters,  Utilities::FileLoggerPtr debugLogger)
 : debugLogger(debugLogger), managerType(parameters.managerType), localPeerType(parameters.localPeerType),
@@ -25,16 +30,48 @@ NetworkManagement_Connections::ConnectionManager::ConnectionManager
   maxActiveConnections(parameters.maxActiveConnections),
   connectionRequestTimeout(parameters.connectionRequestTimeout),
   defaultReadBufferSize(parameters.defaultReadBufferSize),
-  localEndpoint(boost::asio::ip::address::from_string(parameters.listeningAddress), listeningPort), 
-  networkService(new boost::asio::io_service()), connectionAcceptor(*networkService, localEndpoint),
-  disconnectedConnectionsThread(new boost::thread(&NetworkManagement_Connections::ConnectionManager::disconnectedConnectionsThreadHandler, this)),
-  poolWork(new boost::asio::io_service::work(*networkService))
+  readBufferPool(Utilities::BufferPool::create(parameters.defaultReadBufferSize, maxFreeReadBuffers)),
+  writeQueueWatermarks(validateWatermarks(parameters.writeQueueWatermarks)),
+  readQueueWatermarks(validateWatermarks(parameters.readQueueWatermarks)),
+  admissionController(parameters.maxActiveConnections, parameters.admissionLimits),
+  pinReactorThreads(parameters.pinReactorThreads && parameters.reactorsCount > 0),
+  socketOptions(validateSocketOptions(parameters.socketOptions)),
+  localEndpoint(boost::asio::ip::address::from_string(parameters.listeningAddress), listeningPort)
 {
-    for(unsigned long i = 0; i < parameters.initialThreadPoolSize; i++)
-        threadGroup.create_thread(boost::bind(&NetworkManagement_Connections::ConnectionManager::poolThreadHandler, this));
+    bool multiReactor = (parameters.reactorsCount > 0);
+    unsigned int reactorsCount = (multiReactor) ? parameters.reactorsCount : 1;
+    
+    for(unsigned int i = 0; i < reactorsCount; i++)
+    {
+        ReactorPtr newReactor(new Reactor());
+        
+        //in multi-reactor mode, each service is run by a single thread and does not need internal locking
+        newReactor->networkService.reset((multiReactor) ? new boost::asio::io_service(1) : new boost::asio::io_service());
+        createAcceptor(*newReactor, multiReactor);
+        newReactor->poolWork.reset(new boost::asio::io_service::work(*newReactor->networkService));
+        reactors.push_back(newReactor);
+    }
+    
+    disconnectedConnectionsThread.reset(new boost::thread(&NetworkManagement_Connections::ConnectionManager::disconnectedConnectionsThreadHandler, this));
     
-    connectionAcceptor.listen();
-    acceptNewConnection();
+    if(multiReactor)
+    {//each reactor is run by its own thread
+        unsigned int coresCount = boost::thread::hardware_concurrency();
+        
+        for(unsigned int i = 0; i < reactorsCount; i++)
+        {
+            int pinnedCore = (pinReactorThreads && coresCount > 0) ? static_cast<int>(i % coresCount) : -1;
+            threadGroup.create_thread(boost::bind(&NetworkManagement_Connections::ConnectionManager::poolThreadHandler, this, i, pinnedCore));
+        }
+    }
+    else
+    {//the only reactor is shared by the whole thread pool
+        for(unsigned long i = 0; i < parameters.initialThreadPoolSize; i++)
+            threadGroup.create_thread(boost::bind(&NetworkManagement_Connections::ConnectionManager::poolThreadHandler, this, 0, -1));
+    }
+    
+    for(unsigned int i = 0; i < reactorsCount; i++)
+        acceptNewConnection(i);
 }
 
 NetworkManagement_Connections::ConnectionManager::~ConnectionManager()
@@ -42,16 +79,25 @@ NetworkManagement_Connections::ConnectionManager::~ConnectionManager()
     logMessage(LogSeverity::Debug, "(~) Destruction initiated.");
     
     stopManager = true;
-    connectionAcceptor.close();
-    networkService->stop();
     
-    boost::lock_guard<boost::timed_mutex> incomingConnectionDataLock(incomingConnectionDataMutex);
-    incomingConnections.clear();
+    for(const ReactorPtr & currentReactor : reactors)
+    {
+        currentReactor->connectionAcceptor->close();
+        currentReactor->networkService->stop();
+    }
     
-    boost::lock_guard<boost::timed_mutex> outgoingConnectionDataLock(outgoingConnectionDataMutex);
-    outgoingConnections.clear();
+    for(const ReactorPtr & currentReactor : reactors)
+    {
+        boost::lock_guard<boost::timed_mutex> incomingConnectionDataLock(currentReactor->incomingConnectionDataMutex);
+        currentReactor->incomingConnections.clear();
+        currentReactor->incomingConnectionAddresses.clear();
+        
+        boost::lock_guard<boost::timed_mutex> outgoingConnectionDataLock(currentReactor->outgoingConnectionDataMutex);
+        currentReactor->outgoingConnections.clear();
+        
+        currentReactor->poolWork.reset();
+    }
     
-    poolWork.reset();
     logMessage(LogSeverity::Debug, "(~) Waiting for all threads to terminate.");
     
     threadGroup.join_all();
@@ -73,30 +119,158 @@ void NetworkManagement_Connections::ConnectionManager::initiateNewConnection
     
     boost::asio::ip::tcp::endpoint remoteEndpoint(boost::asio::ip::address::from_string(remoteAddress), port);
     
-    SocketPtr newLocalSocket(new boost::asio::ip::tcp::socket(*networkService));
+    //outgoing connections are distributed between the reactors
+    unsigned int reactorIndex = (nextOutgoingReactor++) % reactors.size();
+    SocketPtr newLocalSocket(new boost::asio::ip::tcp::socket(*reactors[reactorIndex]->networkService));
+    
+    if(socketOptions.isSet())
+    {//the options are applied before connecting, so that the receive buffer size affects the TCP window negotiation
+        boost::system::error_code openError;
+        newLocalSocket->open(remoteEndpoint.protocol(), openError);
+        if(!openError)
+            applySocketOptions(*newLocalSocket, INVALID_RAW_CONNECTION_ID);
+    }
     
     newLocalSocket->async_connect(remoteEndpoint, 
             boost::bind(&NetworkManagement_Connections::ConnectionManager::createLocalConnection,
-                        this, _1, newLocalSocket));
+                        this, _1, newLocalSocket, reactorIndex));
+}
+
+void NetworkManagement_Connections::ConnectionManager::createAcceptor(Reactor & reactor, bool reusePort)
+{
+    reactor.connectionAcceptor.reset(new boost::asio::ip::tcp::acceptor(*reactor.networkService));
+    reactor.connectionAcceptor->open(localEndpoint.protocol());
+    reactor.connectionAcceptor->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+    
+    if(reusePort)
+    {
+#if defined(SO_REUSEPORT)
+        reactor.connectionAcceptor->set_option(NetworkManagement_Types::IntegerSocketOption<SOL_SOCKET, SO_REUSEPORT>(1));
+#else
+        throw std::logic_error("ConnectionManager::createAcceptor() > SO_REUSEPORT is not supported; multi-reactor mode is not available.");
+#endif
+    }
+    
+    if(socketOptions.receiveBufferSize > 0)
+    {//accepted sockets inherit the buffer size, which has to be known before the TCP window is negotiated
+        boost::system::error_code optionError;
+        reactor.connectionAcceptor->set_option(
+                boost::asio::socket_base::receive_buffer_size(static_cast<int>(socketOptions.receiveBufferSize)), optionError);
+        
+        if(optionError)
+        {
+            logMessage(LogSeverity::Debug, "(createAcceptor) Failed to set the receive buffer size: ["
+                + optionError.message() + "]");
+        }
+    }
+    
+    reactor.connectionAcceptor->bind(localEndpoint);
+    reactor.connectionAcceptor->listen();
 }
 
-void NetworkManagement_Connections::ConnectionManager::acceptNewConnection()
+void NetworkManagement_Connections::ConnectionManager::applySocketOptions
+(boost::asio::ip::tcp::socket & socket, RawConnectionID connectionID)
+{
+    boost::system::error_code optionError;
+    
+    auto checkOption = [&](const std::string & optionName)
+    {
+        if(optionError)
+        {
+            logMessage(LogSeverity::Debug, "(applySocketOptions) [" + Convert::toString(connectionID)
+                + "] > Failed to set option [" + optionName + "]: [" + optionError.message() + "]");
+            
+            optionError.clear();
+        }
+    };
+    
+    if(socketOptions.noDelay)
+    {
+        socket.set_option(boost::asio::ip::tcp::no_delay(true), optionError);
+        checkOption("TCP_NODELAY");
+    }
+    
+    if(socketOptions.sendBufferSize > 0)
+    {
+        socket.set_option(boost::asio::socket_base::send_buffer_size(static_cast<int>(socketOptions.sendBufferSize)), optionError);
+        checkOption("SO_SNDBUF");
+    }
+    
+    if(socketOptions.receiveBufferSize > 0)
+    {
+        socket.set_option(boost::asio::socket_base::receive_buffer_size(static_cast<int>(socketOptions.receiveBufferSize)), optionError);
+        checkOption("SO_RCVBUF");
+    }
+    
+    if(socketOptions.keepAlive)
+    {
+        socket.set_option(boost::asio::socket_base::keep_alive(true), optionError);
+        checkOption("SO_KEEPALIVE");
+        
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+        if(socketOptions.keepAliveIdle > 0)
+        {
+            socket.set_option(NetworkManagement_Types::IntegerSocketOption<IPPROTO_TCP, TCP_KEEPIDLE>(socketOptions.keepAliveIdle), optionError);
+            checkOption("TCP_KEEPIDLE");
+        }
+        
+        if(socketOptions.keepAliveInterval > 0)
+        {
+            socket.set_option(NetworkManagement_Types::IntegerSocketOption<IPPROTO_TCP, TCP_KEEPINTVL>(socketOptions.keepAliveInterval), optionError);
+            checkOption("TCP_KEEPINTVL");
+        }
+        
+        if(socketOptions.keepAliveProbes > 0)
+        {
+            socket.set_option(NetworkManagement_Types::IntegerSocketOption<IPPROTO_TCP, TCP_KEEPCNT>(socketOptions.keepAliveProbes), optionError);
+            checkOption("TCP_KEEPCNT");
+        }
+#else
+        if(socketOptions.keepAliveIdle > 0 || socketOptions.keepAliveInterval > 0 || socketOptions.keepAliveProbes > 0)
+            logMessage(LogSeverity::Debug, "(applySocketOptions) Keepalive timing options are not supported on this platform.");
+#endif
+    }
+    
+    if(socketOptions.userTimeout > 0)
+    {
+#if defined(TCP_USER_TIMEOUT)
+        socket.set_option(NetworkManagement_Types::IntegerSocketOption<IPPROTO_TCP, TCP_USER_TIMEOUT>(socketOptions.userTimeout), optionError);
+        checkOption("TCP_USER_TIMEOUT");
+#else
+        logMessage(LogSeverity::Debug, "(applySocketOptions) TCP_USER_TIMEOUT is not supported on this platform.");
+#endif
+    }
+    
+    if(socketOptions.quickAck)
+    {
+#if defined(TCP_QUICKACK)
+        socket.set_option(NetworkManagement_Types::IntegerSocketOption<IPPROTO_TCP, TCP_QUICKACK>(1), optionError);
+        checkOption("TCP_QUICKACK");
+#else
+        logMessage(LogSeverity::Debug, "(applySocketOptions) TCP_QUICKACK is not supported on this platform.");
+#endif
+    }
+}
+
+void NetworkManagement_Connections::ConnectionManager::acceptNewConnection(unsigned int reactorIndex)
 {
     if(stopManager)
         return;
     
-    SocketPtr newRemoteSocket(new boost::asio::ip::tcp::socket(*networkService));
-    connectionAcceptor.async_accept(*newRemoteSocket,
+    Reactor & reactor = *reactors[reactorIndex];
+    SocketPtr newRemoteSocket(new boost::asio::ip::tcp::socket(*reactor.networkService));
+    reactor.connectionAcceptor->async_accept(*newRemoteSocket,
             boost::bind(&NetworkManagement_Connections::ConnectionManager::createRemoteConnection,
-                        this, newRemoteSocket));
+                        this, _1, newRemoteSocket, reactorIndex));
 }
 
 void NetworkManagement_Connections::ConnectionManager::createLocalConnection
-(const boost::system::error_code & error, SocketPtr localSocket)
+(const boost::system::error_code & error, SocketPtr localSocket, unsigned int reactorIndex)
 {
     if(stopManager)
         return;
     
+    Reactor & reactor = *reactors[reactorIndex];
     RawConnectionID connectionID = getNewConnectionID();
     
     if(!error)
@@ -107,25 +281,28 @@ void NetworkManagement_Connections::ConnectionManager::createLocalConnection
                                                          ConnectionInitiation::LOCAL,
                                                          connectionID,
                                                          localSocket,
-                                                         defaultReadBufferSize};
+                                                         defaultReadBufferSize,
+                                                         writeQueueWatermarks,
+                                                         readQueueWatermarks,
+                                                         socketOptions.quickAck};
                                                          
         ConnectionRequest requestParams{localPeerType, managerType};
-        ConnectionPtr newConnection(new Connection(networkService, connectionParams, requestParams, nullptr, debugLogger));
+        ConnectionPtr newConnection(new Connection(reactor.networkService, connectionParams, requestParams, readBufferPool, debugLogger));
         
         newConnection->onConnectEventAttach(boost::bind(&NetworkManagement_Connections::ConnectionManager::onConnectHandler,
-                                                        this, _1, ConnectionInitiation::LOCAL));
+                                                        this, _1, ConnectionInitiation::LOCAL, reactorIndex));
         
         newConnection->canBeDestroyedEventAttach(boost::bind(&NetworkManagement_Connections::ConnectionManager::destroyConnection,
-                                                             this, _1, _2));
+                                                             this, _1, _2, reactorIndex));
         
         bool done = false;
         do
         {
-            boost::timed_mutex::scoped_lock connectionDataLock(outgoingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
+            boost::timed_mutex::scoped_lock connectionDataLock(reactor.outgoingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
             
             if(connectionDataLock.owns_lock() && !stopManager)
             {
-                outgoingConnections.insert(std::pair<RawConnectionID, ConnectionPtr>(connectionID, newConnection));
+                reactor.outgoingConnections.insert(std::pair<RawConnectionID, ConnectionPtr>(connectionID, newConnection));
                 done = true;
             }
             else if(stopManager)
@@ -143,37 +320,74 @@ void NetworkManagement_Connections::ConnectionManager::createLocalConnection
     }
 }
 
-void NetworkManagement_Connections::ConnectionManager::createRemoteConnection(SocketPtr remoteSocket)
+void NetworkManagement_Connections::ConnectionManager::createRemoteConnection
+(const boost::system::error_code & error, SocketPtr remoteSocket, unsigned int reactorIndex)
 {
     if(stopManager)
         return;
     
+    Reactor & reactor = *reactors[reactorIndex];
+    boost::system::error_code endpointError;
+    boost::asio::ip::tcp::endpoint remoteEndpoint;
+    
+    if(!error)
+        remoteEndpoint = remoteSocket->remote_endpoint(endpointError);
+    
+    if(error || endpointError)
+    {
+        logMessage(LogSeverity::Debug, "(createRemoteConnection) Failed to accept connection: ["
+            + (error ? error.message() : endpointError.message()) + "]");
+        
+        remoteSocket->close(endpointError);
+        acceptNewConnection(reactorIndex);
+        return;
+    }
+    
+    //rejected connections are closed before any connection data is created
+    AdmissionResult admission = admissionController.admit(remoteEndpoint.address());
+    if(admission != AdmissionResult::ADMITTED)
+    {
+        logMessage(LogSeverity::Debug, "(createRemoteConnection) Connection from ["
+            + remoteEndpoint.address().to_string() + "] rejected: [" + Convert::toString(admission) + "]");
+        
+        remoteSocket->close(endpointError);
+        acceptNewConnection(reactorIndex);
+        return;
+    }
+    
     RawConnectionID connectionID = getNewConnectionID();
     ++acceptedIncomingConnections;
     
+    if(socketOptions.isSet())
+        applySocketOptions(*remoteSocket, connectionID);
+    
     Connection::ConnectionParamters connectionParams{managerType,
                                                      localPeerType,
                                                      ConnectionInitiation::REMOTE,
                                                      connectionID,
                                                      remoteSocket,
-                                                     defaultReadBufferSize};
+                                                     defaultReadBufferSize,
+                                                     writeQueueWatermarks,
+                                                     readQueueWatermarks,
+                                                     socketOptions.quickAck};
     
-    ConnectionPtr newConnection(new Connection(networkService, connectionParams, nullptr, debugLogger));
+    ConnectionPtr newConnection(new Connection(reactor.networkService, connectionParams, readBufferPool, debugLogger));
     
     newConnection->onConnectEventAttach(boost::bind(&NetworkManagement_Connections::ConnectionManager::onConnectHandler,
-                                                    this, _1, ConnectionInitiation::REMOTE));
+                                                    this, _1, ConnectionInitiation::REMOTE, reactorIndex));
     
     newConnection->canBeDestroyedEventAttach(boost::bind(&NetworkManagement_Connections::ConnectionManager::destroyConnection,
-                                                         this, _1, _2));
+                                                         this, _1, _2, reactorIndex));
     
     bool done = false;
     do
     {
-        boost::timed_mutex::scoped_lock connectionDataLock(incomingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
+        boost::timed_mutex::scoped_lock connectionDataLock(reactor.incomingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
 
         if(connectionDataLock.owns_lock() && !stopManager)
         {
-            incomingConnections.insert(std::pair<RawConnectionID, ConnectionPtr>(connectionID, newConnection));
+            reactor.incomingConnections.insert(std::pair<RawConnectionID, ConnectionPtr>(connectionID, newConnection));
+            reactor.incomingConnectionAddresses.insert(std::pair<RawConnectionID, boost::asio::ip::address>(connectionID, remoteEndpoint.address()));
             done = true;
         }
         else if(stopManager)
@@ -182,37 +396,38 @@ void NetworkManagement_Connections::ConnectionManager::createRemoteConnection(So
     
     if(connectionRequestTimeout > 0)
     {//timeout is enabled
-        boost::shared_ptr<boost::asio::deadline_timer> newTimer(new boost::asio::deadline_timer(*networkService));
+        boost::shared_ptr<boost::asio::deadline_timer> newTimer(new boost::asio::deadline_timer(*reactor.networkService));
         
         {
-            boost::lock_guard<boost::mutex> timerLock(deadlineTimerMutex);
+            boost::lock_guard<boost::mutex> timerLock(reactor.deadlineTimerMutex);
             
             auto connectionTimerData = std::pair<ConnectionPtr, boost::shared_ptr<boost::asio::deadline_timer>>
                     (newConnection, newTimer);
             
-            timerData.insert(std::pair<RawConnectionID, std::pair<ConnectionPtr, boost::shared_ptr<boost::asio::deadline_timer>>>
+            reactor.timerData.insert(std::pair<RawConnectionID, std::pair<ConnectionPtr, boost::shared_ptr<boost::asio::deadline_timer>>>
                     (connectionID, connectionTimerData));
         }
         
         newTimer->expires_from_now(boost::posix_time::seconds(connectionRequestTimeout));
         newTimer->async_wait(boost::bind(&NetworkManagement_Connections::ConnectionManager::timeoutConnection,
-                                         this, _1, connectionID));
+                                         this, _1, connectionID, reactorIndex));
     }
     
     newConnection->enableLifecycleEvents();
-    acceptNewConnection();
+    acceptNewConnection(reactorIndex);
 }
 
 void NetworkManagement_Connections::ConnectionManager::timeoutConnection
-(const boost::system::error_code & timeoutError, RawConnectionID connectionID)
+(const boost::system::error_code & timeoutError, RawConnectionID connectionID, unsigned int reactorIndex)
 {
     if(stopManager)
         return;
     
-    boost::lock_guard<boost::mutex> timerLock(deadlineTimerMutex);
-    if(timerData.find(connectionID) != timerData.end())
+    Reactor & reactor = *reactors[reactorIndex];
+    boost::lock_guard<boost::mutex> timerLock(reactor.deadlineTimerMutex);
+    if(reactor.timerData.find(connectionID) != reactor.timerData.end())
     {//the timer has expired
-        auto currentConnectionData = timerData[connectionID];
+        auto currentConnectionData = reactor.timerData[connectionID];
 
         if(!timeoutError)
         {
@@ -227,16 +442,18 @@ void NetworkManagement_Connections::ConnectionManager::timeoutConnection
                 + "] > Timeout error encountered: <" + timeoutError.message() + ">");
         }
 
-        timerData.erase(connectionID);
+        reactor.timerData.erase(connectionID);
     }
 }
 
 void NetworkManagement_Connections::ConnectionManager::destroyConnection
-(RawConnectionID connectionID, ConnectionInitiation initiation)
+(RawConnectionID connectionID, ConnectionInitiation initiation, unsigned int reactorIndex)
 {
     if(stopManager)
         return;
     
+    Reactor & reactor = *reactors[reactorIndex];
+    
     switch(initiation)
     {
         case ConnectionInitiation::LOCAL:
@@ -244,14 +461,14 @@ void NetworkManagement_Connections::ConnectionManager::destroyConnection
             bool done = false;
             do
             {
-                boost::timed_mutex::scoped_lock connectionDataLock(outgoingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
+                boost::timed_mutex::scoped_lock connectionDataLock(reactor.outgoingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
 
                 if(connectionDataLock.owns_lock() && !stopManager)
                 {
-                    if(outgoingConnections.find(connectionID) != outgoingConnections.end())
+                    if(reactor.outgoingConnections.find(connectionID) != reactor.outgoingConnections.end())
                     {
-                        queueConnectionForDestruction(outgoingConnections[connectionID]);
-                        outgoingConnections.erase(connectionID);
+                        queueConnectionForDestruction(reactor.outgoingConnections[connectionID]);
+                        reactor.outgoingConnections.erase(connectionID);
 
                         logMessage(LogSeverity::Debug, "(destroyConnection) Outgoing connection <"
                             + Convert::toString(connectionID) + "> removed.");
@@ -274,14 +491,21 @@ void NetworkManagement_Connections::ConnectionManager::destroyConnection
             bool done = false;
             do
             {
-                boost::timed_mutex::scoped_lock connectionDataLock(incomingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
+                boost::timed_mutex::scoped_lock connectionDataLock(reactor.incomingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
 
                 if(connectionDataLock.owns_lock() && !stopManager)
                 {
-                    if(incomingConnections.find(connectionID) != incomingConnections.end())
+                    if(reactor.incomingConnections.find(connectionID) != reactor.incomingConnections.end())
                     {
-                        queueConnectionForDestruction(incomingConnections[connectionID]);
-                        incomingConnections.erase(connectionID);
+                        queueConnectionForDestruction(reactor.incomingConnections[connectionID]);
+                        reactor.incomingConnections.erase(connectionID);
+                        
+                        auto connectionAddress = reactor.incomingConnectionAddresses.find(connectionID);
+                        if(connectionAddress != reactor.incomingConnectionAddresses.end())
+                        {
+                            admissionController.release(connectionAddress->second);
+                            reactor.incomingConnectionAddresses.erase(connectionAddress);
+                        }
 
                         logMessage(LogSeverity::Debug, "(destroyConnection) Incoming connection <"
                             + Convert::toString(connectionID) + "> removed.");
@@ -308,11 +532,13 @@ void NetworkManagement_Connections::ConnectionManager::destroyConnection
 }
 
 void NetworkManagement_Connections::ConnectionManager::onConnectHandler
-(RawConnectionID connectionID, ConnectionInitiation initiation)
+(RawConnectionID connectionID, ConnectionInitiation initiation, unsigned int reactorIndex)
 {
     if(stopManager)
         return;
     
+    Reactor & reactor = *reactors[reactorIndex];
+    
     switch(initiation)
     {
         case ConnectionInitiation::LOCAL:
@@ -322,11 +548,11 @@ void NetworkManagement_Connections::ConnectionManager::onConnectHandler
             bool done = false;
             do
             {
-                boost::timed_mutex::scoped_lock connectionDataLock(outgoingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
+                boost::timed_mutex::scoped_lock connectionDataLock(reactor.outgoingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
 
                 if(connectionDataLock.owns_lock() && !stopManager)
                 {
-                    currentConnection = outgoingConnections.at(connectionID);
+                    currentConnection = reactor.outgoingConnections.at(connectionID);
                     done = true;
                 }
                 else if(stopManager)
@@ -340,10 +566,10 @@ void NetworkManagement_Connections::ConnectionManager::onConnectHandler
         {
             if(connectionRequestTimeout > 0)
             {
-                boost::lock_guard<boost::mutex> timerLock(deadlineTimerMutex);
-                if(timerData.find(connectionID) != timerData.end())
+                boost::lock_guard<boost::mutex> timerLock(reactor.deadlineTimerMutex);
+                if(reactor.timerData.find(connectionID) != reactor.timerData.end())
                 {//there is a pending timer that has not expired yet
-                    timerData.erase(connectionID);
+                    reactor.timerData.erase(connectionID);
                 }
                 else
                 {//the timer has expired
@@ -359,11 +585,11 @@ void NetworkManagement_Connections::ConnectionManager::onConnectHandler
             bool done = false;
             do
             {
-                boost::timed_mutex::scoped_lock connectionDataLock(incomingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
+                boost::timed_mutex::scoped_lock connectionDataLock(reactor.incomingConnectionDataMutex, boost::get_system_time() + boost::posix_time::milliseconds(mutexWaitInterval));
 
                 if(connectionDataLock.owns_lock() && !stopManager)
                 {
-                    currentConnection = incomingConnections.at(connectionID);
+                    currentConnection = reactor.incomingConnections.at(connectionID);
                     done = true;
                 }
                 else if(stopManager)
@@ -381,13 +607,32 @@ void NetworkManagement_Connections::ConnectionManager::onConnectHandler
     }
 }
 
-void NetworkManagement_Connections::ConnectionManager::poolThreadHandler()
+void NetworkManagement_Connections::ConnectionManager::poolThreadHandler(unsigned int reactorIndex, int pinnedCore)
 {
     if(stopManager)
         return;
     
     logMessage(LogSeverity::Debug, "(poolThreadHandler) Thread <"
-        + Convert::toString(boost::this_thread::get_id()) + "> started.");
+        + Convert::toString(boost::this_thread::get_id()) + "> started for reactor <" + Convert::toString(reactorIndex) + ">.");
+    
+    if(pinnedCore >= 0)
+    {
+#if defined(__linux__)
+        cpu_set_t coreSet;
+        CPU_ZERO(&coreSet);
+        CPU_SET(pinnedCore, &coreSet);
+        
+        if(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &coreSet) != 0)
+        {
+            logMessage(LogSeverity::Debug, "(poolThreadHandler) Failed to pin thread <"
+                + Convert::toString(boost::this_thread::get_id()) + "> to core <" + Convert::toString(pinnedCore) + ">.");
+        }
+#else
+        logMessage(LogSeverity::Debug, "(poolThreadHandler) Thread pinning is not supported on this platform.");
+#endif
+    }
+    
+    boost::shared_ptr<boost::asio::io_service> networkService = reactors[reactorIndex]->networkService;
 
     while(!stopManager)
     {
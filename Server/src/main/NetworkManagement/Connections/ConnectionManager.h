@@ -20,6 +20,8 @@
 
 #include <string>
 #include <atomic>
+#include <vector>
+#include <limits>
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
 #include <boost/signals2/signal.hpp>
@@ -32,7 +34,9 @@
 #include "../../Utilities/FileLogger.h"
 #include "../Types/Types.h"
 #include "../Types/Packets.h"
+#include "../Types/SocketOptions.h"
 #include "Connection.h"
+#include "AdmissionController.h"
 
 using NetworkManagement_Types::PeerType;
 using NetworkManagement_Types::SocketPtr;
@@ -42,6 +46,7 @@ using NetworkManagement_Types::ConnectionInitiation;
 using NetworkManagement_Types::OperationTimeoutLength;
 using NetworkManagement_Types::RawConnectionID;
 using NetworkManagement_Types::INVALID_RAW_CONNECTION_ID;
+using NetworkManagement_Types::AdmissionResult;
 using NetworkManagement_Connections::Connection;
 using NetworkManagement_Connections::ConnectionPtr;
 using Common_Types::IPPort;
@@ -55,7 +60,17 @@ namespace NetworkManagement_Connections
      * Class representing basic TCP connection management.\n\n
      * 
      * * New connections to remote peers are created via <code>initiateNewConnection(IPAddress, IPPort)</code>;\n
-     * * New connections from remote peers are created automatically;\n
+     * * New connections from remote peers are created automatically, if they are
+     * admitted by the manager's <code>AdmissionController</code> (rejected sockets are closed
+     * immediately, before any connection data is allocated);\n
+     * 
+     * * By default, all connections share a single IO service (reactor), run by the
+     * manager's thread pool; in multi-reactor mode, each reactor has its own IO service,
+     * thread and <code>SO_REUSEPORT</code> acceptor, and connections (along with their timers)
+     * remain on the reactor that created them for their whole lifetime;\n
+     * 
+     * * The manager's <code>SocketOptions</code> (TCP options profile) are applied to the
+     * listening sockets and to all new sockets, before connecting or as soon as they are accepted;\n
      * 
      * * <code>onConnectionCreated</code> event is fired when either a local or a remote connection has been
      * successfully created and can be used;\n
@@ -65,6 +80,61 @@ namespace NetworkManagement_Connections
     class ConnectionManager
     {
         public:
+            /**
+             * Structure for holding the TCP socket options applied to all connections of a manager
+             * (0/<code>false</code> = system default).
+             * 
+             * Note: Options that are not supported by the platform are ignored.
+             */
+            struct SocketOptions
+            {
+                /** Denotes whether Nagle's algorithm is to be disabled (<code>TCP_NODELAY</code>). */
+                bool noDelay;
+                /** Socket send buffer size, in bytes (<code>SO_SNDBUF</code>). */
+                BufferSize sendBufferSize;
+                /** Socket receive buffer size, in bytes (<code>SO_RCVBUF</code>); also set on the listening socket, before the TCP window is negotiated. */
+                BufferSize receiveBufferSize;
+                /** Denotes whether TCP keepalive probes are to be sent (<code>SO_KEEPALIVE</code>). */
+                bool keepAlive;
+                /** Idle time before the first keepalive probe, in seconds (<code>TCP_KEEPIDLE</code>). */
+                unsigned int keepAliveIdle;
+                /** Time between keepalive probes, in seconds (<code>TCP_KEEPINTVL</code>). */
+                unsigned int keepAliveInterval;
+                /** Number of unanswered keepalive probes before the connection is dropped (<code>TCP_KEEPCNT</code>). */
+                unsigned int keepAliveProbes;
+                /** Maximum time sent data may remain unacknowledged before the connection is dropped, in milliseconds (<code>TCP_USER_TIMEOUT</code>). */
+                unsigned int userTimeout;
+                /** Denotes whether received data is to be acknowledged immediately (<code>TCP_QUICKACK</code>; re-enabled before each read). */
+                bool quickAck;
+                
+                /**
+                 * Checks if any of the options are set.
+                 * 
+                 * @return <code>true</code>, if at least one option differs from the system default
+                 */
+                bool isSet() const
+                {
+                    return noDelay || sendBufferSize > 0 || receiveBufferSize > 0 || keepAlive
+                            || keepAliveIdle > 0 || keepAliveInterval > 0 || keepAliveProbes > 0
+                            || userTimeout > 0 || quickAck;
+                }
+                
+                /**
+                 * Checks if the options are valid.
+                 * 
+                 * @return <code>true</code>, if the keepalive settings are only supplied with keepalive
+                 * enabled and all values can be passed to the socket
+                 */
+                bool isValid() const
+                {
+                    const std::size_t maxValue = std::numeric_limits<int>::max();
+                    return (keepAlive || (keepAliveIdle == 0 && keepAliveInterval == 0 && keepAliveProbes == 0))
+                            && sendBufferSize <= maxValue && receiveBufferSize <= maxValue
+                            && keepAliveIdle <= maxValue && keepAliveInterval <= maxValue
+                            && keepAliveProbes <= maxValue && userTimeout <= maxValue;
+                }
+            };
+            
             /** Parameters structure for holding <code>ConnectionManager</code> configuration data. */
             struct ConnectionManagerParameters
             {
@@ -76,14 +146,26 @@ namespace NetworkManagement_Connections
                 IPAddress listeningAddress;
                 /** Manager listening port */
                 IPPort listeningPort;
-                /** Maximum number of active connections */
+                /** Maximum number of active incoming connections (0 = unlimited) */
                 unsigned int maxActiveConnections;
-                /** Network IO service thread pool size */
+                /** Network IO service thread pool size (single-reactor mode only) */
                 unsigned int initialThreadPoolSize;
                 /** Connection request timeout (in seconds); set to 0 for no timeout. */
                 OperationTimeoutLength connectionRequestTimeout;
                 /** Default size for connection read buffers (in bytes) */
                 BufferSize defaultReadBufferSize;
+                /** Watermarks for the outgoing data queue of each connection (all 0 = unbounded) */
+                Connection::QueueWatermarks writeQueueWatermarks;
+                /** Watermarks for the incoming data queue of each connection (all 0 = unbounded) */
+                Connection::QueueWatermarks readQueueWatermarks;
+                /** Per address/subnet and accept rate limits for incoming connections (all 0 = unlimited) */
+                AdmissionController::AdmissionLimits admissionLimits;
+                /** Number of reactors, each with its own IO service, thread and acceptor (0 = single reactor, shared by the thread pool) */
+                unsigned int reactorsCount;
+                /** Denotes whether each reactor thread is to be pinned to a separate CPU core (multi-reactor mode only) */
+                bool pinReactorThreads;
+                /** TCP options for the sockets of all connections (all 0 = system defaults) */
+                SocketOptions socketOptions;
             };
             
             /**
@@ -91,6 +173,8 @@ namespace NetworkManagement_Connections
              * 
              * @param parameters manager configuration data
              * @param debugLogger logger for debugging, if any
+             * @throw invalid_argument if any of the queue watermarks, admission limits or socket options are not valid
+             * @throw logic_error if multi-reactor mode is requested but <code>SO_REUSEPORT</code> is not supported
              */
             ConnectionManager(ConnectionManagerParameters parameters, Utilities::FileLoggerPtr debugLogger = Utilities::FileLoggerPtr());
             
@@ -149,10 +233,16 @@ namespace NetworkManagement_Connections
             OperationTimeoutLength getConnectionRequestTimeout()    const { return connectionRequestTimeout; }
             /** Retrieves the default read buffer size for new connections.\n\n@return the default read buffer size (in bytes) */
             BufferSize getDefaultReadBufferSize()                   const { return defaultReadBufferSize; }
-            /** Retrieves the number of currently active incoming connections.\n\n@return the number of incoming connections */
-            unsigned long getIncomingConnectionsCount()             const { return incomingConnections.size(); }
-            /** Retrieves the number of currently active outgoing connections.\n\n@return the number of outgoing connections */
-            unsigned long getOutgoingConnectionsCount()             const { return outgoingConnections.size(); }
+            /** Retrieves the write queue watermarks for new connections.\n\n@return the write queue watermarks */
+            Connection::QueueWatermarks getWriteQueueWatermarks()   const { return writeQueueWatermarks; }
+            /** Retrieves the read queue watermarks for new connections.\n\n@return the read queue watermarks */
+            Connection::QueueWatermarks getReadQueueWatermarks()    const { return readQueueWatermarks; }
+            /** Retrieves the TCP options applied to the sockets of new connections.\n\n@return the socket options */
+            SocketOptions getSocketOptions()                        const { return socketOptions; }
+            /** Retrieves the number of reactors used by the manager.\n\n@return the number of reactors (1 in single-reactor mode) */
+            unsigned int getReactorsCount()                         const { return reactors.size(); }
+            /** Retrieves the reactor threads pinning state.\n\n@return <code>true</code>, if each reactor thread is pinned to a separate CPU core */
+            bool areReactorThreadsPinned()                          const { return pinReactorThreads; }
             /** Retrieves the internal ID of the last connection.\n\n@return the last connection ID */
             RawConnectionID getLastConnectionID()                   const { return newConnectionID; }
             /** Retrieves the number of closed connections waiting to be destroyed.\n\n@return the number of connections pending destruction */
@@ -161,6 +251,59 @@ namespace NetworkManagement_Connections
             unsigned long long getTotalOutgoingConnectionsCount()   const { return initiatedOutgoingConnections; }
             /** Retrieves the total number of incoming connections that have been made.\n\n@return the number of incoming connections */
             unsigned long long getTotalIncomingConnectionsCount()   const { return acceptedIncomingConnections; }
+            /** Retrieves the total number of incoming connections that have been rejected.\n\n@return the number of rejected connections */
+            unsigned long long getTotalRejectedConnectionsCount()   const { return admissionController.getRejectionsCount(); }
+            
+            /**
+             * Retrieves the number of incoming connections that have been rejected for the specified reason.
+             * 
+             * @param reason the rejection reason
+             * @return the number of rejected connections
+             */
+            unsigned long long getTotalRejectedConnectionsCount(AdmissionResult reason) const
+            {
+                return admissionController.getRejectionsCount(reason);
+            }
+            
+            /**
+             * Retrieves the number of currently active incoming connections (on all reactors).
+             * 
+             * @return the number of incoming connections
+             */
+            unsigned long getIncomingConnectionsCount() const
+            {
+                unsigned long result = 0;
+                for(const ReactorPtr & currentReactor : reactors)
+                    result += currentReactor->incomingConnections.size();
+                
+                return result;
+            }
+            
+            /**
+             * Retrieves the number of currently active outgoing connections (on all reactors).
+             * 
+             * @return the number of outgoing connections
+             */
+            unsigned long getOutgoingConnectionsCount() const
+            {
+                unsigned long result = 0;
+                for(const ReactorPtr & currentReactor : reactors)
+                    result += currentReactor->outgoingConnections.size();
+                
+                return result;
+            }
+            
+            /**
+             * Retrieves the number of currently active incoming connections on the specified reactor.
+             * 
+             * @param reactorIndex the index of the reactor
+             * @return the number of incoming connections
+             * @throw out_of_range if the reactor does not exist
+             */
+            unsigned long getIncomingConnectionsCount(unsigned int reactorIndex) const
+            {
+                return reactors.at(reactorIndex)->incomingConnections.size();
+            }
             
         private:
             std::atomic<RawConnectionID> newConnectionID{INVALID_RAW_CONNECTION_ID};
@@ -175,27 +318,51 @@ namespace NetworkManagement_Connections
             PeerType localPeerType;             //local peer type
             IPAddress listeningAddress;         //listening address for the manager
             IPPort listeningPort;               //listening port for the manager
-            unsigned int maxActiveConnections;  //TODO - implement //0 = unlimited
+            unsigned int maxActiveConnections;  //0 = unlimited (incoming connections only)
             OperationTimeoutLength connectionRequestTimeout; //0 = unlimited (in seconds)
             BufferSize defaultReadBufferSize;   //default read buffer size for all new connections
+            std::size_t maxFreeReadBuffers = 64; //maximum number of free read buffers kept for each buffer size
+            Utilities::BufferPoolPtr readBufferPool; //read buffers pool shared by all connections
+            Connection::QueueWatermarks writeQueueWatermarks; //write queue watermarks for all new connections
+            Connection::QueueWatermarks readQueueWatermarks;  //read queue watermarks for all new connections
+            AdmissionController admissionController; //admission control for incoming connections (shared by all reactors)
+            bool pinReactorThreads;             //pin reactor threads to separate CPU cores (multi-reactor mode only)
+            SocketOptions socketOptions;        //TCP options for the sockets of all new connections
             
             unsigned long connectionDestructionInterval = 5; //in seconds
             
-            //Connection Management
-            boost::asio::ip::tcp::endpoint localEndpoint;               //local listening endpoint
-            boost::shared_ptr<boost::asio::io_service> networkService;  //io_service for handling networking
-            boost::asio::ip::tcp::acceptor connectionAcceptor;          //acceptor for incoming connections
+            /**
+             * Networking reactor data.
+             * 
+             * Each reactor owns an IO service and an acceptor, along with the state of all
+             * connections and timers created on it; in single-reactor mode, the only reactor
+             * is run by the whole thread pool.
+             */
+            struct Reactor
+            {
+                boost::shared_ptr<boost::asio::io_service> networkService;      //io_service for handling networking
+                boost::scoped_ptr<boost::asio::ip::tcp::acceptor> connectionAcceptor; //acceptor for incoming connections
+                boost::scoped_ptr<boost::asio::io_service::work> poolWork;      //reactor work object
+                
+                //Deadline timers data
+                boost::mutex deadlineTimerMutex;
+                boost::unordered_map<RawConnectionID, std::pair<ConnectionPtr, boost::shared_ptr<boost::asio::deadline_timer>>> timerData;
+                
+                //Incoming & outgoing connections containers
+                boost::timed_mutex incomingConnectionDataMutex;
+                boost::unordered_map<RawConnectionID, ConnectionPtr> incomingConnections;
+                boost::unordered_map<RawConnectionID, boost::asio::ip::address> incomingConnectionAddresses; //remote addresses of admitted connections
+                boost::timed_mutex outgoingConnectionDataMutex;
+                boost::unordered_map<RawConnectionID, ConnectionPtr> outgoingConnections;
+            };
             
-            //Deadline timers data
-            boost::mutex deadlineTimerMutex;
-            boost::unordered_map<RawConnectionID, std::pair<ConnectionPtr, boost::shared_ptr<boost::asio::deadline_timer>>> timerData;
+            typedef boost::shared_ptr<Reactor> ReactorPtr;
             
-            //Incoming & outgoing connections containers
-            unsigned long mutexWaitInterval = 100; //in milliseconds
-            boost::timed_mutex incomingConnectionDataMutex;
-            boost::unordered_map<RawConnectionID, ConnectionPtr> incomingConnections;
-            boost::timed_mutex outgoingConnectionDataMutex;
-            boost::unordered_map<RawConnectionID, ConnectionPtr> outgoingConnections;
+            //Connection Management
+            boost::asio::ip::tcp::endpoint localEndpoint;   //local listening endpoint
+            std::vector<ReactorPtr> reactors;               //networking reactors (fixed after construction)
+            std::atomic<unsigned int> nextOutgoingReactor{0}; //reactor for the next outgoing connection (round-robin)
+            unsigned long mutexWaitInterval = 100;          //in milliseconds
             
             std::vector<ConnectionPtr> disconnectedConnections; //connections waiting for destruction
             
@@ -205,7 +372,6 @@ namespace NetworkManagement_Connections
             boost::condition_variable timedLockCondition;   //condition variable for performing timed waits
             boost::scoped_ptr<boost::thread> disconnectedConnectionsThread; //thread for handling connection destruction
             
-            boost::scoped_ptr<boost::asio::io_service::work> poolWork; //thread pool work object
             boost::thread_group threadGroup; //thread pool management group
             
             std::atomic<bool> stopManager{false}; //denotes whether the manager is to be stopped or not
@@ -215,24 +381,52 @@ namespace NetworkManagement_Connections
             boost::signals2::signal<void (const boost::system::error_code &)> onConnectionInitiationFailed;
             
             /**
-             * Prepares the manager for accepting a new incoming connection.
+             * Creates a new listening acceptor for the specified reactor.
+             * 
+             * Note: In multi-reactor mode, <code>SO_REUSEPORT</code> is enabled, allowing each
+             * reactor to listen on the same endpoint and the kernel to balance incoming connections.
+             * 
+             * @param reactor the reactor that will own the acceptor
+             * @param reusePort denotes whether <code>SO_REUSEPORT</code> is to be enabled
+             * @throw logic_error if <code>SO_REUSEPORT</code> is required but not supported
              */
-            void acceptNewConnection();
+            void createAcceptor(Reactor & reactor, bool reusePort);
+            
+            /**
+             * Applies the manager's TCP options to the supplied socket.
+             * 
+             * Note: Failures are logged and the remaining options are still applied;
+             * the connection can be used with the system defaults.
+             * 
+             * @param socket the (open) socket to be configured
+             * @param connectionID the ID of the associated connection (for logging)
+             */
+            void applySocketOptions(boost::asio::ip::tcp::socket & socket, RawConnectionID connectionID);
+            
+            /**
+             * Prepares the manager for accepting a new incoming connection on the specified reactor.
+             * 
+             * @param reactorIndex the index of the accepting reactor
+             */
+            void acceptNewConnection(unsigned int reactorIndex);
             
             /**
              * Creates a new local connection with the specified socket.
              * 
              * @param error error encountered during the connection initiation, if any
              * @param localSocket the socket to be used with the new connection
+             * @param reactorIndex the index of the reactor that owns the socket
              */
-            void createLocalConnection(const boost::system::error_code & error,  SocketPtr localSocket);
+            void createLocalConnection(const boost::system::error_code & error,  SocketPtr localSocket, unsigned int reactorIndex);
             
             /**
-             * Creates a new remote connection with the specified socket.
+             * Creates a new remote connection with the specified socket, if it is admitted.
              * 
+             * @param error error encountered while accepting the connection, if any
              * @param remoteSocket the socket to be used with the new connection
+             * @param reactorIndex the index of the reactor that accepted the connection
              */
-            void createRemoteConnection(SocketPtr remoteSocket);
+            void createRemoteConnection(const boost::system::error_code & error, SocketPtr remoteSocket, unsigned int reactorIndex);
             
             /**
              * Connection destruction handler.
@@ -245,8 +439,9 @@ namespace NetworkManagement_Connections
              * 
              * @param connectionID
              * @param initiation
+             * @param reactorIndex the index of the reactor that owns the connection
              */
-            void destroyConnection(RawConnectionID connectionID, ConnectionInitiation initiation);
+            void destroyConnection(RawConnectionID connectionID, ConnectionInitiation initiation, unsigned int reactorIndex);
             
             /**
              * Connection timeout handler.
@@ -256,21 +451,26 @@ namespace NetworkManagement_Connections
              * 
              * @param timeoutError error encountered during the timeout operation, if any
              * @param connectionID the ID of the connection associated with the timeout
+             * @param reactorIndex the index of the reactor that owns the connection
              */
-            void timeoutConnection(const boost::system::error_code & timeoutError, RawConnectionID connectionID);
+            void timeoutConnection(const boost::system::error_code & timeoutError, RawConnectionID connectionID, unsigned int reactorIndex);
             
             /**
              * Handler for <code>onConnect</code> events from new <code>Connection</code> objects.
              * 
              * @param connectionID the ID of the connection
              * @param initiation the connection initiation side
+             * @param reactorIndex the index of the reactor that owns the connection
              */
-            void onConnectHandler(RawConnectionID connectionID, ConnectionInitiation initiation);
+            void onConnectHandler(RawConnectionID connectionID, ConnectionInitiation initiation, unsigned int reactorIndex);
             
             /**
              * IO Service thread handler.
+             * 
+             * @param reactorIndex the index of the reactor to be run by the thread
+             * @param pinnedCore the CPU core the thread is to be pinned to, if any (-1 = not pinned)
              */
-            void poolThreadHandler();
+            void poolThreadHandler(unsigned int reactorIndex, int pinnedCore);
             
             /**
              * Enqueues the supplied connection for destruction.
@@ -296,6 +496,36 @@ namespace NetworkManagement_Connections
                 return ++newConnectionID;
             }
             
+            /**
+             * Validates the supplied queue watermarks.
+             * 
+             * @param watermarks the watermarks to be validated
+             * @return the supplied watermarks
+             * @throw invalid_argument if the watermarks are not valid
+             */
+            static Connection::QueueWatermarks validateWatermarks(const Connection::QueueWatermarks & watermarks)
+            {
+                if(!watermarks.isValid())
+                    throw std::invalid_argument("ConnectionManager::() > Each queue low watermark must be below its high watermark.");
+                
+                return watermarks;
+            }
+            
+            /**
+             * Validates the supplied socket options.
+             * 
+             * @param options the options to be validated
+             * @return the supplied options
+             * @throw invalid_argument if the options are not valid
+             */
+            static SocketOptions validateSocketOptions(const SocketOptions & options)
+            {
+                if(!options.isValid())
+                    throw std::invalid_argument("ConnectionManager::() > Keepalive settings require keepalive to be enabled and all socket option values must fit in an int.");
+                
+                return options;
+            }
+            
             /**
              * Logs the specified message, if the debug log handler is set.
              * 
@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DataPipeline.h"
+
+NetworkManagement_Connections::DataPipeline::DataPipeline
+(unsigned int workersCount, unsigned int maxQueuedTasks, unsigned int maxIncomingTasksPerLane, Utilities::FileLoggerPtr debugLogger)
+: debugLogger(debugLogger), workersCount(workersCount), maxQueuedTasks(maxQueuedTasks), maxIncomingTasksPerLane(maxIncomingTasksPerLane),
+  workers((workersCount > 0 && maxQueuedTasks > 0 && maxIncomingTasksPerLane > 0) ? workersCount : 0)
+{
+    if(workersCount == 0)
+        throw std::invalid_argument("DataPipeline::() > At least one worker thread is required.");
+    
+    if(maxQueuedTasks == 0)
+        throw std::invalid_argument("DataPipeline::() > The maximum number of queued tasks must be larger than 0.");
+    
+    if(maxIncomingTasksPerLane == 0)
+        throw std::invalid_argument("DataPipeline::() > The maximum number of incoming tasks per lane must be larger than 0.");
+}
+
+NetworkManagement_Connections::DataPipeline::~DataPipeline()
+{
+    boost::lock_guard<boost::mutex> lanesLock(lanesMutex);
+    stopping = true;
+    
+    if(!lanes.empty())
+    {
+        logMessage(LogSeverity::Debug, "(~) > Discarding tasks for [" + Convert::toString(lanes.size()) + "] connections.");
+        lanes.clear();
+    }
+}
+
+bool NetworkManagement_Connections::DataPipeline::submitIncoming(const ConnectionID connectionID, Task task)
+{
+    boost::lock_guard<boost::mutex> lanesLock(lanesMutex);
+    
+    if(stopping)
+        return false;
+    
+    ++queuedIncomingTasks;
+    LanePtr lane = queueTask(connectionID, QueuedTask{task, true, boost::posix_time::microsec_clock::universal_time()});
+    
+    if(++lane->incomingTasks == maxIncomingTasksPerLane)
+        ++fullIncomingLanes;
+    
+    return true;
+}
+
+bool NetworkManagement_Connections::DataPipeline::isIncomingLaneFull(const ConnectionID connectionID, unsigned int additionalTasks)
+{
+    boost::lock_guard<boost::mutex> lanesLock(lanesMutex);
+    
+    auto lane = lanes.find(connectionID);
+    unsigned int incomingTasks = (lane != lanes.end()) ? lane->second->incomingTasks : 0;
+    return (incomingTasks + additionalTasks) >= maxIncomingTasksPerLane;
+}
+
+void NetworkManagement_Connections::DataPipeline::recordStageTime
+(DataPipelineStage stage, const boost::posix_time::time_duration & duration)
+{
+    StageStatistics & statistics = stages[static_cast<std::size_t>(stage) % STAGES_COUNT];
+    unsigned long long time = (duration.is_negative()) ? 0 : duration.total_microseconds();
+    
+    ++statistics.operations;
+    statistics.totalTime += time;
+    
+    unsigned long long currentMax = statistics.maxTime;
+    while(time > currentMax && !statistics.maxTime.compare_exchange_weak(currentMax, time))
+    {}
+}
+
+bool NetworkManagement_Connections::DataPipeline::submit
+(const ConnectionID connectionID, Task task, bool bounded)
+{
+    boost::lock_guard<boost::mutex> lanesLock(lanesMutex);
+    
+    if(bounded && queuedOutgoingTasks >= maxQueuedTasks)
+    {
+        ++rejectedTasks;
+        return false;
+    }
+    
+    if(stopping)
+        return false;
+    
+    ++queuedOutgoingTasks;
+    queueTask(connectionID, QueuedTask{task, false, boost::posix_time::microsec_clock::universal_time()});
+    return true;
+}
+
+NetworkManagement_Connections::DataPipeline::LanePtr NetworkManagement_Connections::DataPipeline::queueTask
+(const ConnectionID connectionID, const QueuedTask & task)
+{
+    LanePtr & lane = lanes[connectionID];
+    bool schedule = !lane;
+    if(schedule)
+        lane = LanePtr(new Lane());
+    
+    lane->tasks.push(task);
+    
+    if(schedule)
+    {//the lane was idle
+        workers.assignTask(boost::bind(&NetworkManagement_Connections::DataPipeline::processLane, this, connectionID, lane));
+    }
+    
+    return lane;
+}
+
+void NetworkManagement_Connections::DataPipeline::processLane(const ConnectionID connectionID, LanePtr lane)
+{
+    QueuedTask nextTask;
+    {
+        boost::lock_guard<boost::mutex> lanesLock(lanesMutex);
+        if(stopping || lane->tasks.empty())
+            return;
+        
+        nextTask = lane->tasks.front();
+    }
+    
+    recordStageTime((nextTask.incoming) ? DataPipelineStage::INCOMING_QUEUE : DataPipelineStage::OUTGOING_QUEUE,
+            boost::posix_time::microsec_clock::universal_time() - nextTask.queuedAt);
+    
+    try
+    {
+        nextTask.task();
+        ++processedTasks;
+    }
+    catch(const std::exception & e)
+    {
+        ++failedTasks;
+        logMessage(LogSeverity::Error, "(processLane) > Exception encountered: [" + std::string(e.what())
+                + "] while processing task for connection [" + Convert::toString(connectionID) + "].");
+    }
+    catch(...)
+    {
+        ++failedTasks;
+        logMessage(LogSeverity::Error, "(processLane) > Unknown exception encountered while"
+                " processing task for connection [" + Convert::toString(connectionID) + "].");
+    }
+    
+    boost::lock_guard<boost::mutex> lanesLock(lanesMutex);
+    if(stopping)
+        return;
+    
+    //the task is removed only after it is done, so that new tasks for the lane are not processed in parallel
+    lane->tasks.pop();
+    
+    if(nextTask.incoming)
+    {
+        --queuedIncomingTasks;
+        --lane->incomingTasks;
+    }
+    else
+    {
+        --queuedOutgoingTasks;
+    }
+    
+    if(lane->tasks.empty())
+    {//the lane is idle
+        lanes.erase(connectionID);
+    }
+    else
+    {//the lane goes to the back of the workers' queue, behind the other connections
+        workers.assignTask(boost::bind(&NetworkManagement_Connections::DataPipeline::processLane, this, connectionID, lane));
+    }
+}
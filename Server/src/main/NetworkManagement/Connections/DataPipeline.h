@@ -0,0 +1,371 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATAPIPELINE_H
+#define	DATAPIPELINE_H
+
+#include <queue>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <functional>
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../Types/Types.h"
+#include "../../Utilities/ThreadPool.h"
+#include "../../Utilities/FileLogger.h"
+#include "../../Common/Types.h"
+#include "../../Utilities/Strings/Common.h"
+
+using Common_Types::LogSeverity;
+using NetworkManagement_Types::ConnectionID;
+using NetworkManagement_Types::DataPipelineStage;
+
+namespace Convert = Utilities::Strings;
+
+namespace NetworkManagement_Connections
+{
+    /**
+     * Class for processing connection data (compression, encryption and their
+     * reverse) on a dedicated pool of worker threads, instead of on the network threads.\n\n
+     *
+     * Each connection has its own lane; the tasks in a lane are processed one
+     * at a time, in the order in which they were submitted, while tasks for different
+     * connections are processed in parallel. Lanes are served in turns (one task each),
+     * so that a connection with a lot of queued data does not delay all others.\n\n
+     *
+     * The number of queued outgoing tasks is limited for all connections; outgoing tasks
+     * are rejected when their queue is full. The number of queued incoming tasks is limited
+     * for each lane; as incoming tasks carry data that was already read, they are never rejected
+     * (or blocked) and the caller is expected to stop reading from a connection while its lane
+     * is full (see <code>isIncomingLaneFull()</code>).\n\n
+     *
+     * The time spent by tasks waiting in the queues and in each processing stage
+     * (as reported via <code>StageTimer</code>) is recorded per stage.
+     *
+     * Note: Thread-safe.
+     */
+    class DataPipeline
+    {
+        public:
+            /** Task to be processed by the pipeline. */
+            typedef std::function<void(void)> Task;
+            
+            /**
+             * Class for recording the time spent in a processing stage, from
+             * its creation until its destruction.
+             *
+             * Note: Nothing is recorded if no pipeline is supplied.
+             */
+            class StageTimer
+            {
+                public:
+                    /**
+                     * Starts the timer for the specified stage.
+                     *
+                     * @param pipeline the pipeline to record the time with (can be <code>nullptr</code>)
+                     * @param stage the stage being timed
+                     */
+                    StageTimer(DataPipeline * pipeline, DataPipelineStage stage)
+                    : pipeline(pipeline), stage(stage),
+                      startTime((pipeline != nullptr) ? boost::posix_time::microsec_clock::universal_time() : boost::posix_time::ptime())
+                    {}
+                    
+                    /**
+                     * Stops the timer and records the time spent in the stage.
+                     */
+                    ~StageTimer()
+                    {
+                        if(pipeline != nullptr)
+                            pipeline->recordStageTime(stage, boost::posix_time::microsec_clock::universal_time() - startTime);
+                    }
+                    
+                    StageTimer() = delete;                                  //No default constructor
+                    StageTimer(const StageTimer&) = delete;                 //Copying not allowed (pass/access only by reference/pointer)
+                    StageTimer& operator=(const StageTimer&) = delete;      //Copying not allowed (pass/access only by reference/pointer)
+                
+                private:
+                    DataPipeline * pipeline;
+                    DataPipelineStage stage;
+                    boost::posix_time::ptime startTime;
+            };
+            
+            /**
+             * Creates a new pipeline with the specified number of worker threads.
+             *
+             * @param workersCount the number of worker threads
+             * @param maxQueuedTasks the maximum number of queued outgoing tasks, for all connections
+             * @param maxIncomingTasksPerLane the number of queued incoming tasks at which a lane is full
+             * @param debugLogger pointer to an initialised <code>FileLogger</code> (if any)
+             * @throw invalid_argument if no worker threads or no queued tasks are allowed
+             */
+            DataPipeline(unsigned int workersCount, unsigned int maxQueuedTasks, unsigned int maxIncomingTasksPerLane,
+                         Utilities::FileLoggerPtr debugLogger = Utilities::FileLoggerPtr());
+            
+            /**
+             * Stops the pipeline.
+             *
+             * Note: Tasks being processed are completed; all other queued tasks are discarded.
+             */
+            ~DataPipeline();
+            
+            DataPipeline() = delete;                                    //No default constructor
+            DataPipeline(const DataPipeline&) = delete;                 //Copying not allowed (pass/access only by reference/pointer)
+            DataPipeline& operator=(const DataPipeline&) = delete;      //Copying not allowed (pass/access only by reference/pointer)
+            
+            /**
+             * Queues the supplied outgoing data task in the lane of the specified connection.
+             *
+             * @param connectionID the connection the task belongs to
+             * @param task the task to be processed
+             * @return <code>true</code>, if the task was queued; <code>false</code>,
+             * if the outgoing queue is full or the pipeline is stopping
+             */
+            bool submitOutgoing(const ConnectionID connectionID, Task task)
+            {
+                return submit(connectionID, task, true);
+            }
+            
+            /**
+             * Queues the supplied task, which continues outgoing work that was already
+             * accepted (for example, the next chunks of a data stream), in the lane of
+             * the specified connection.
+             * 
+             * Note: The task is not subject to the outgoing queue limit, as the amount
+             * of such tasks is bounded by the work they continue.
+             * 
+             * @param connectionID the connection the task belongs to
+             * @param task the task to be processed
+             * @return <code>true</code>, if the task was queued; <code>false</code>, if the pipeline is stopping
+             */
+            bool submitContinuation(const ConnectionID connectionID, Task task)
+            {
+                return submit(connectionID, task, false);
+            }
+            
+            /**
+             * Queues the supplied incoming data task in the lane of the specified connection.
+             *
+             * Note: Never blocks and the task is queued even if the lane is full; the caller
+             * is expected to stop supplying incoming data for the connection while its lane
+             * is full (see <code>isIncomingLaneFull()</code>).
+             *
+             * @param connectionID the connection the task belongs to
+             * @param task the task to be processed
+             * @return <code>true</code>, if the task was queued; <code>false</code>, if the pipeline is stopping
+             */
+            bool submitIncoming(const ConnectionID connectionID, Task task);
+            
+            /**
+             * Checks if the lane of the specified connection would be full after queueing
+             * the specified number of additional incoming tasks.
+             *
+             * @param connectionID the connection the lane belongs to
+             * @param additionalTasks the number of incoming tasks about to be queued
+             * @return <code>true</code>, if the lane is (or would become) full
+             */
+            bool isIncomingLaneFull(const ConnectionID connectionID, unsigned int additionalTasks = 0);
+            
+            /**
+             * Records the time spent by a task in the specified stage.
+             *
+             * @param stage the processing stage
+             * @param duration the time spent in the stage
+             */
+            void recordStageTime(DataPipelineStage stage, const boost::posix_time::time_duration & duration);
+            
+            /** Retrieves the number of worker threads.\n\n@return the number of workers */
+            unsigned int getWorkersCount() const { return workersCount; }
+            /** Retrieves the maximum number of queued outgoing tasks, for all connections.\n\n@return the queue capacity */
+            unsigned int getMaxQueuedTasks() const { return maxQueuedTasks; }
+            /** Retrieves the number of queued incoming tasks at which a lane is full.\n\n@return the lane capacity */
+            unsigned int getMaxIncomingTasksPerLane() const { return maxIncomingTasksPerLane; }
+            /** Retrieves the number of queued outgoing tasks.\n\n@return the number of tasks */
+            unsigned int getQueuedOutgoingTasksCount() const { return queuedOutgoingTasks; }
+            /** Retrieves the number of queued incoming tasks, for all connections.\n\n@return the number of tasks */
+            unsigned int getQueuedIncomingTasksCount() const { return queuedIncomingTasks; }
+            /** Retrieves the number of outgoing tasks rejected because their queue was full.\n\n@return the number of tasks */
+            unsigned long long getRejectedTasksCount() const { return rejectedTasks; }
+            /** Retrieves the number of incoming tasks that filled their lane.\n\n@return the number of tasks */
+            unsigned long long getFullIncomingLanesCount() const { return fullIncomingLanes; }
+            /** Retrieves the number of processed tasks.\n\n@return the number of tasks */
+            unsigned long long getProcessedTasksCount() const { return processedTasks; }
+            /** Retrieves the number of tasks that failed with an exception.\n\n@return the number of tasks */
+            unsigned long long getFailedTasksCount() const { return failedTasks; }
+            
+            /**
+             * Retrieves the number of operations recorded for the specified stage.
+             *
+             * @param stage the processing stage
+             * @return the number of operations
+             */
+            unsigned long long getStageOperationsCount(DataPipelineStage stage) const
+            {
+                return getStageStatistics(stage).operations;
+            }
+            
+            /**
+             * Retrieves the total time spent in the specified stage.
+             *
+             * @param stage the processing stage
+             * @return the total time (in microseconds)
+             */
+            unsigned long long getStageTotalTime(DataPipelineStage stage) const
+            {
+                return getStageStatistics(stage).totalTime;
+            }
+            
+            /**
+             * Retrieves the longest time spent by a single operation in the specified stage.
+             *
+             * @param stage the processing stage
+             * @return the longest time (in microseconds)
+             */
+            unsigned long long getStageMaxTime(DataPipelineStage stage) const
+            {
+                return getStageStatistics(stage).maxTime;
+            }
+            
+            /**
+             * Retrieves the average time spent by an operation in the specified stage.
+             *
+             * @param stage the processing stage
+             * @return the average time (in microseconds), or 0 if no operations were recorded
+             */
+            unsigned long long getStageAverageTime(DataPipelineStage stage) const
+            {
+                const StageStatistics & statistics = getStageStatistics(stage);
+                unsigned long long operations = statistics.operations;
+                return (operations > 0) ? (statistics.totalTime / operations) : 0;
+            }
+        
+        private:
+            /** Structure for holding a queued task. */
+            struct QueuedTask
+            {
+                /** The task to be processed. */
+                Task task;
+                /** Denotes whether the task is for incoming data. */
+                bool incoming;
+                /** The time at which the task was queued. */
+                boost::posix_time::ptime queuedAt;
+            };
+            
+            /** Structure for holding the queued tasks of a connection. */
+            struct Lane
+            {
+                /** The queued tasks, in submission order. */
+                std::queue<QueuedTask> tasks;
+                /** The number of queued incoming tasks. */
+                unsigned int incomingTasks = 0;
+            };
+            typedef boost::shared_ptr<Lane> LanePtr;
+            
+            /** Structure for holding the timing statistics of a stage. */
+            struct StageStatistics
+            {
+                std::atomic<unsigned long long> operations{0};  //number of recorded operations
+                std::atomic<unsigned long long> totalTime{0};   //total time (in microseconds)
+                std::atomic<unsigned long long> maxTime{0};     //longest single operation (in microseconds)
+            };
+            
+            static const std::size_t STAGES_COUNT = static_cast<std::size_t>(DataPipelineStage::DELIVER) + 1;
+            
+            Utilities::FileLoggerPtr debugLogger;   //logger for debugging
+            unsigned int workersCount;              //number of worker threads
+            unsigned int maxQueuedTasks;            //maximum number of queued outgoing tasks, for all connections
+            unsigned int maxIncomingTasksPerLane;   //number of queued incoming tasks at which a lane is full
+            
+            boost::mutex lanesMutex;                        //lanes data mutex
+            boost::unordered_map<ConnectionID, LanePtr> lanes; //active lanes; a lane exists only while it has tasks
+            bool stopping = false;                          //denotes whether the pipeline is being stopped
+            std::atomic<unsigned int> queuedOutgoingTasks{0}; //number of queued outgoing tasks
+            std::atomic<unsigned int> queuedIncomingTasks{0}; //number of queued incoming tasks
+            
+            //Stats
+            std::atomic<unsigned long long> rejectedTasks{0};
+            std::atomic<unsigned long long> fullIncomingLanes{0};
+            std::atomic<unsigned long long> processedTasks{0};
+            std::atomic<unsigned long long> failedTasks{0};
+            StageStatistics stages[STAGES_COUNT];
+            
+            Utilities::ThreadPool workers;          //worker threads; destroyed first
+            
+            /**
+             * Queues the supplied outgoing task in the lane of the specified connection.
+             *
+             * @param connectionID the connection the task belongs to
+             * @param task the task to be processed
+             * @param bounded denotes whether the task is subject to the outgoing queue limit
+             * @return <code>true</code>, if the task was queued
+             */
+            bool submit(const ConnectionID connectionID, Task task, bool bounded);
+            
+            /**
+             * Adds the supplied task to the lane of the specified connection and
+             * schedules the lane for processing, if it was empty.
+             *
+             * Note: To be called with the lanes mutex held.
+             *
+             * @param connectionID the connection the task belongs to
+             * @param task the task to be queued
+             * @return the lane the task was added to
+             */
+            LanePtr queueTask(const ConnectionID connectionID, const QueuedTask & task);
+            
+            /**
+             * Processes the next task in the specified lane and schedules the lane
+             * again, if it has more tasks.
+             *
+             * Note: Called by the worker threads only.
+             *
+             * @param connectionID the connection the lane belongs to
+             * @param lane the lane to be processed
+             */
+            void processLane(const ConnectionID connectionID, LanePtr lane);
+            
+            /**
+             * Retrieves the statistics of the specified stage.
+             *
+             * @param stage the processing stage
+             * @return the stage statistics
+             */
+            const StageStatistics & getStageStatistics(DataPipelineStage stage) const
+            {
+                return stages[static_cast<std::size_t>(stage) % STAGES_COUNT];
+            }
+            
+            /**
+             * Logs the specified message, if a debugging file logger is assigned.
+             *
+             * @param severity the severity associated with the message/event
+             * @param message the message to be logged
+             */
+            void logMessage(LogSeverity severity, const std::string & message) const
+            {
+                if(debugLogger)
+                    debugLogger->logMessage(Utilities::FileLogSeverity::Debug, "DataPipeline > " + message);
+            }
+    };
+    
+    typedef boost::shared_ptr<DataPipeline> DataPipelinePtr;
+}
+
+#endif	/* DATAPIPELINE_H */
@@ -34,14 +34,38 @@ NetworkManagement_Handlers::DataConnectionsHandler::DataConnectionsHandler
  std::function<const LocalPeerAuthenticationEntry & (const DeviceID &)> authDataRetrievalHandler,
  Utilities::FileLoggerPtr debugLogger)
 : debugLogger(debugLogger), compressor(params.compressionAccelerationLevel, params.maxDataSize),
+  compressionPolicy(params.compressionSampleSize, params.maxCompressionRatio),
   deviceConfigRetrievalHandler(cfgRetrievalHandler), authenticationDataRetrievalHandler(authDataRetrievalHandler),
-  active(true), localPeerID(params.localPeerID), requestSignatureSize(params.requestSignatureSize), maxDataSize(params.maxDataSize)
-{}
+  active(true), localPeerID(params.localPeerID), requestSignatureSize(params.requestSignatureSize), maxDataSize(params.maxDataSize),
+  streamChunkSize((params.streamChunkSize > 0) ? params.streamChunkSize : (params.maxDataSize / 2)),
+  maxStreamChunksInFlight((params.maxStreamChunksInFlight > 0) ? params.maxStreamChunksInFlight : DEFAULT_MAX_STREAM_CHUNKS_IN_FLIGHT),
+  maxStreamsPerConnection((params.maxStreamsPerConnection > 0) ? params.maxStreamsPerConnection : DEFAULT_MAX_STREAMS_PER_CONNECTION)
+{
+    //leaves room for the chunk header and for the compression and encryption overhead
+    if(streamChunkSize > (maxDataSize / 2))
+    {
+        throw std::invalid_argument("DataConnectionsHandler::() > The stream chunk size ["
+                + Convert::toString(streamChunkSize) + "] cannot be larger than half of the maximum data size ["
+                + Convert::toString(maxDataSize) + "].");
+    }
+
+    if(params.pipelineWorkersCount > 0)
+    {//compression and encryption are moved off the network threads
+        pipeline = DataPipelinePtr(new DataPipeline(
+                params.pipelineWorkersCount,
+                (params.maxPipelineQueuedTasks > 0) ? params.maxPipelineQueuedTasks : DEFAULT_MAX_PIPELINE_QUEUED_TASKS,
+                (params.maxPipelineIncomingTasks > 0) ? params.maxPipelineIncomingTasks : DEFAULT_MAX_PIPELINE_INCOMING_TASKS,
+                debugLogger));
+    }
+}
 
 NetworkManagement_Handlers::DataConnectionsHandler::~DataConnectionsHandler()
 {
     active = false;
 
+    //waits for the tasks being processed and discards all others
+    pipeline.reset();
+
     onConnectionEstablished.disconnect_all_slots();
     onConnectionEstablishmentFailed.disconnect_all_slots();
     onDataReceived.disconnect_all_slots();
@@ -62,10 +86,10 @@ NetworkManagement_Handlers::DataConnectionsHandler::~DataConnectionsHandler()
                 currentActiveConnection.second->onDataReceivedEventConnection.disconnect();
                 currentActiveConnection.second->onDisconnectEventConnection.disconnect();
                 currentActiveConnection.second->onWriteResultReceivedEventConnection.disconnect();
+                currentActiveConnection.second->onFlowControlEventConnection.disconnect();
 
                 while(currentActiveConnection.second->pendingSentData.size() > 0)
                 {
-                    delete currentActiveConnection.second->pendingSentData.front();
                     currentActiveConnection.second->pendingSentData.pop();
                 }
             }
@@ -89,9 +113,9 @@ void NetworkManagement_Handlers::DataConnectionsHandler::manageLocalConnection
     try
     {
         ConnectionDataPtr connectionData = createConnectionData(connectionID, config, connection);
-        CiphertextData * requestData = generateConnectionRequestData(config->data->getDeviceID(), connectionData);
-        connectionData->pendingSentData.push(requestData);
-        connection->sendData(*requestData);
+        ByteDataPtr requestData(generateConnectionRequestData(config->data->getDeviceID(), connectionData));
+        connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(requestData, OutgoingStreamPtr()));
+        connection->sendData(requestData);
         connectionData->state = ConnectionSetupState::CONNECTION_REQUEST_SENT;
 
         //attaches the pending connection event handlers
@@ -167,11 +191,11 @@ void NetworkManagement_Handlers::DataConnectionsHandler::manageRemoteConnection
     connection->enableDataEvents();
 }
 
-void NetworkManagement_Handlers::DataConnectionsHandler::sendData
+bool NetworkManagement_Handlers::DataConnectionsHandler::sendData
 (const DeviceID deviceID, const ConnectionID connectionID, const PlaintextData & plaintextData)
 {
     if(!active)
-        return;
+        return false;
 
     ++sendRequestsMade;
 
@@ -189,70 +213,199 @@ void NetworkManagement_Handlers::DataConnectionsHandler::sendData
     }
 
     ConnectionDataPtr connectionData = getConnectionData(deviceID, connectionID);
-    MixedData * dataToSend = new MixedData();
-    boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
-    try
+
+    if(!pipeline)
+        return processOutgoingData(connectionData, deviceID, connectionID, plaintextData);
+
+    boost::shared_ptr<PlaintextData> pendingData(new PlaintextData(plaintextData));
+    auto processingTask = [this, connectionData, deviceID, connectionID, pendingData]()
     {
-        if(connectionData->encryptionEnabled)
-        {
-            if(connectionData->compressionEnabled)
-            {//compresses and encrypts the data
-                ByteData compressedData;
-                compressor.compressData(plaintextData, compressedData);
-                connectionData->cryptoHandler->encryptData(compressedData, *dataToSend);
-            }
-            else
-            {//only encrypts the data
-                connectionData->cryptoHandler->encryptData(plaintextData, *dataToSend);
-            }
-        }
-        else
-        {
-            if(connectionData->compressionEnabled)
-            {//only compresses the data
-                ByteData compressedData;
-                compressor.compressData(plaintextData, compressedData);
-                dataToSend->assign(compressedData);
-            }
-            else
-            {//data is NOT compressed or encrypted
-                dataToSend->assign(plaintextData);
-            }
-        }
+        processOutgoingData(connectionData, deviceID, connectionID, *pendingData);
+    };
 
-        connectionData->connection->sendData(*dataToSend);
-        connectionData->pendingSentData.push(dataToSend);
-        
-        logMessage(LogSeverity::Info, "(sendData) > Data sent to device ["
+    if(!pipeline->submitOutgoing(connectionID, processingTask))
+    {
+        ++sendRequestsRejected;
+        logMessage(LogSeverity::Warning, "(sendData) > Data for device ["
                 + Convert::toString(deviceID) + "] on connection ["
-                + Convert::toString(connectionID) + "].");
+                + Convert::toString(connectionID) + "] rejected; the pipeline's outgoing queue is full.");
+
+        return false;
     }
-    catch(const std::exception & e)
+
+    logMessage(LogSeverity::Info, "(sendData) > Data queued for processing for device ["
+            + Convert::toString(deviceID) + "] on connection ["
+            + Convert::toString(connectionID) + "].");
+
+    return true;
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::sendStream
+(const DeviceID deviceID, const ConnectionID connectionID, StreamSource source, StreamCompletionHandler completionHandler,
+ const StreamID streamID)
+{
+    if(!active)
+        return false;
+
+    if(streamChunkSize == 0)
     {
-        ++sendRequestsFailed;
-        delete dataToSend;
-        logMessage(LogSeverity::Error, "(sendData) > Exception encountered: ["
-                + std::string(e.what()) + "] while sending data to device ["
-                + Convert::toString(deviceID) + "] on connection ["
-                + Convert::toString(connectionID) + "].");
-        
-        terminateConnection(connectionID, deviceID);
-        connectionData->connection->disconnect();
-        throw;
+        logMessage(LogSeverity::Error, "(sendStream) > Data streams are not supported with maximum data size ["
+                + Convert::toString(maxDataSize) + "].");
+
+        return false;
     }
-    catch(...)
+
+    ConnectionDataPtr connectionData = getConnectionData(deviceID, connectionID);
+    boost::unique_lock<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
+
+    if(connectionData->outgoingStreams.find(streamID) != connectionData->outgoingStreams.end())
     {
-        ++sendRequestsFailed;
-        delete dataToSend;
-        logMessage(LogSeverity::Error, "(sendData) >"
-                " Unknown exception encountered while sending data to device ["
-                + Convert::toString(deviceID) + "] on connection ["
-                + Convert::toString(connectionID) + "].");
-        
-        terminateConnection(connectionID, deviceID);
-        connectionData->connection->disconnect();
-        throw;
+        logMessage(LogSeverity::Warning, "(sendStream) > Stream [" + Convert::toString(streamID)
+                + "] for device [" + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "] rejected; a stream with the same ID is being sent.");
+
+        return false;
+    }
+
+    if(connectionData->outgoingStreams.size() >= maxStreamsPerConnection)
+    {
+        logMessage(LogSeverity::Warning, "(sendStream) > Stream [" + Convert::toString(streamID)
+                + "] for device [" + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "] rejected; too many streams are being sent.");
+
+        return false;
+    }
+
+    //the remote peer may have granted the stream's first credits before it was started
+    StreamCredits initialCredits = 0;
+    auto pendingCredits = connectionData->pendingStreamCredits.find(streamID);
+    if(pendingCredits != connectionData->pendingStreamCredits.end())
+    {
+        initialCredits = pendingCredits->second;
+        connectionData->pendingStreamCredits.erase(pendingCredits);
+    }
+
+    OutgoingStreamPtr newStream(new OutgoingStream{streamID, source, completionHandler, 0, 0, initialCredits, 0, false, false, false, false});
+    newStream->currentChunk.reserve(streamChunkSize);
+    newStream->nextChunk.reserve(streamChunkSize);
+    connectionData->outgoingStreams.insert(std::pair<StreamID, OutgoingStreamPtr>(streamID, newStream));
+
+    if(pipeline && !pipeline->submitOutgoing(connectionID, boost::bind(&DataConnectionsHandler::continueStreams,
+                                                                       this, connectionData, deviceID, connectionID)))
+    {
+        connectionData->outgoingStreams.erase(streamID);
+        logMessage(LogSeverity::Warning, "(sendStream) > Stream [" + Convert::toString(streamID)
+                + "] for device [" + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "] rejected; the pipeline's outgoing queue is full.");
+
+        return false;
+    }
+
+    connectionDataLock.unlock();
+    logMessage(LogSeverity::Info, "(sendStream) > Stream [" + Convert::toString(streamID)
+            + "] accepted for device [" + Convert::toString(deviceID) + "] on connection ["
+            + Convert::toString(connectionID) + "].");
+
+    if(!pipeline)
+        continueStreams(connectionData, deviceID, connectionID);
+
+    return true;
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::sendStream
+(const DeviceID deviceID, const ConnectionID connectionID, PoolInputStreamPtr source, StreamCompletionHandler completionHandler,
+ const StreamID streamID)
+{
+    boost::shared_ptr<StorageManagement_Pools::PoolInputStream> sourceStream(source.release());
+    DataSize remainingBytes = sourceStream->getMaxReadableBytes();
+
+    auto chunkSource = [sourceStream, remainingBytes](Byte * buffer, std::streamsize size) mutable -> std::streamsize
+    {
+        std::streamsize bytesToRead = (remainingBytes < static_cast<DataSize>(size)) ? remainingBytes : size;
+        if(bytesToRead == 0)
+            return 0;
+
+        std::streamsize bytesRead = sourceStream->read(buffer, bytesToRead);
+        if(bytesRead > 0)
+            remainingBytes -= bytesRead;
+
+        return bytesRead;
+    };
+
+    return sendStream(deviceID, connectionID, chunkSource, completionHandler, streamID);
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::receiveStream
+(const DeviceID deviceID, const ConnectionID connectionID, StreamSink sink, DataSize maxSize, StreamCompletionHandler completionHandler,
+ const StreamID streamID)
+{
+    if(!active)
+        return false;
+
+    ConnectionDataPtr connectionData = getConnectionData(deviceID, connectionID);
+    boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
+
+    if(connectionData->incomingStreams.find(streamID) != connectionData->incomingStreams.end())
+    {
+        logMessage(LogSeverity::Warning, "(receiveStream) > Stream [" + Convert::toString(streamID)
+                + "] from device [" + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "] rejected; a stream with the same ID is being received.");
+
+        return false;
     }
+
+    if(connectionData->incomingStreams.size() >= maxStreamsPerConnection)
+    {
+        logMessage(LogSeverity::Warning, "(receiveStream) > Stream [" + Convert::toString(streamID)
+                + "] from device [" + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "] rejected; too many streams are being received.");
+
+        return false;
+    }
+
+    connectionData->incomingStreams.insert(std::pair<StreamID, IncomingStreamPtr>(
+        streamID, IncomingStreamPtr(new IncomingStream{streamID, sink, completionHandler, maxSize, 0, 0, false, false, false, 0})));
+
+    //the remote peer sends no chunks until it is granted the stream's window
+    queueStreamWindowUpdate(connectionData, StreamWindowUpdate{streamID, maxStreamChunksInFlight, StreamWindowUpdate::FLAG_INITIAL});
+
+    logMessage(LogSeverity::Info, "(receiveStream) > Waiting for stream [" + Convert::toString(streamID)
+            + "] from device [" + Convert::toString(deviceID) + "] on connection ["
+            + Convert::toString(connectionID) + "].");
+
+    return true;
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::receiveStream
+(const DeviceID deviceID, const ConnectionID connectionID, PoolOutputStreamPtr target, StreamCompletionHandler completionHandler,
+ const StreamID streamID)
+{
+    boost::shared_ptr<StorageManagement_Pools::PoolOutputStream> targetStream(target.release());
+
+    auto chunkSink = [targetStream](const Byte * data, std::streamsize size) -> std::streamsize
+    {
+        return targetStream->write(data, size);
+    };
+
+    auto streamCompletionHandler = [targetStream, completionHandler](bool successful, DataSize transferredBytes)
+    {
+        if(successful)
+        {
+            try
+            {
+                targetStream->flush();
+            }
+            catch(const std::exception &)
+            {
+                successful = false;
+            }
+        }
+
+        if(completionHandler)
+            completionHandler(successful, transferredBytes);
+    };
+
+    return receiveStream(deviceID, connectionID, chunkSink, targetStream->getMaxWritableBytes(), streamCompletionHandler, streamID);
 }
 
 void NetworkManagement_Handlers::DataConnectionsHandler::closeConnection
@@ -739,7 +892,7 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDisconnectHandler_Pen
 }
 
 void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_PendingLocalConnections
-(ByteData data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
+(const BufferView & data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
 {
     if(!active)
         return;
@@ -782,13 +935,12 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_P
             
             if(connectionData->state == ConnectionSetupState::CONNECTION_REQUEST_SENT)
             {
-                delete connectionData->pendingSentData.front();
                 connectionData->pendingSentData.pop();
             }
             
             connectionData->state = ConnectionSetupState::CONNECTION_RESPONSE_RECEIVED;
             
-            verifyConnectionResponseData(data, connectionData);
+            verifyConnectionResponseData(data.toByteData(), connectionData);
             connectionData->state = ConnectionSetupState::COMPLETED;
 
             //detaches the pending connection handlers
@@ -813,6 +965,11 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_P
                     boost::bind(&NetworkManagement_Handlers::DataConnectionsHandler::onWriteResultReceivedHandler_EstablishedConnections,
                                 this, _1, deviceID, connectionID));
         
+        connectionData->onFlowControlEventConnection =
+                connectionData->connection->onFlowControlEventAttach(
+                    boost::bind(&NetworkManagement_Handlers::DataConnectionsHandler::onFlowControlHandler_EstablishedConnections,
+                                this, _1, deviceID, connectionID));
+        
         connectionData->connection->enableDataEvents();
         
         logMessage(LogSeverity::Info, "(onDataReceivedHandler_PendingLocalConnections) >"
@@ -879,7 +1036,6 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onWriteResultReceivedHa
         boost::lock_guard<boost::mutex> dataLock(connectionData->connectionDataMutex);
         if(connectionData->state == ConnectionSetupState::CONNECTION_REQUEST_SENT)
         {
-            delete connectionData->pendingSentData.front();
             connectionData->pendingSentData.pop();
             connectionData->state = ConnectionSetupState::CONNECTION_REQUEST_SENT_CONFIRMED;
         }
@@ -923,7 +1079,7 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDisconnectHandler_Pen
 }
 
 void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_PendingRemoteConnections
-(ByteData data, PacketSize remaining, const ConnectionID connectionID)
+(const BufferView & data, PacketSize remaining, const ConnectionID connectionID)
 {
     if(!active)
         return;
@@ -954,7 +1110,7 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_P
     try
     {
         //generates and send a connection response
-        CiphertextData * responseData = generateConnectionResponseDataFromRequest(data, connectionID);
+        ByteDataPtr responseData(generateConnectionResponseDataFromRequest(data.toByteData(), connectionID));
 
         boost::lock_guard<boost::mutex> dataLock(connectionData->connectionDataMutex);
         
@@ -963,9 +1119,10 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_P
                     boost::bind(&DataConnectionsHandler::DataConnectionsHandler::onWriteResultReceivedHandler_PendingRemoteConnections,
                                 this, _1, connectionData->deviceData->getDeviceID(), connectionID));
         
-        connectionData->pendingSentData.push(responseData);
-        connectionData->connection->sendData(*responseData);
+        //the state is updated before sending, as the write result can be received before sendData() returns
+        connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(responseData, OutgoingStreamPtr()));
         connectionData->state = ConnectionSetupState::CONNECTION_RESPONSE_SENT;
+        connectionData->connection->sendData(responseData);
     }
     catch(const std::runtime_error & e)
     {
@@ -1041,24 +1198,24 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onWriteResultReceivedHa
 
     try
     {
-        if(connectionData->state != ConnectionSetupState::CONNECTION_RESPONSE_SENT)
-        {
-            logMessage(LogSeverity::Error, "(onWriteResultReceivedHandler_PendingRemoteConnections) >"
-                    " Unexpected connection state encountered [" + Convert::toString(connectionData->state)
-                    + "] for device [" + Convert::toString(deviceID)
-                    + "] on connection [" + Convert::toString(connectionID) + "].");
-            
-            throw std::logic_error("DataConnectionsHandler::onWriteResultReceivedHandler_PendingRemoteConnections() >"
-                    " Unexpected connection state encountered [" + Convert::toString(connectionData->state)
-                    + "] for device [" + Convert::toString(deviceID)
-                    + "] on connection [" + Convert::toString(connectionID) + "].");
-        }
-
         connectionData->connection->disableDataEvents();
 
         {
             boost::lock_guard<boost::mutex> dataLock(connectionData->connectionDataMutex);
-            delete connectionData->pendingSentData.front();
+            
+            if(connectionData->state != ConnectionSetupState::CONNECTION_RESPONSE_SENT)
+            {
+                logMessage(LogSeverity::Error, "(onWriteResultReceivedHandler_PendingRemoteConnections) >"
+                        " Unexpected connection state encountered [" + Convert::toString(connectionData->state)
+                        + "] for device [" + Convert::toString(deviceID)
+                        + "] on connection [" + Convert::toString(connectionID) + "].");
+                
+                throw std::logic_error("DataConnectionsHandler::onWriteResultReceivedHandler_PendingRemoteConnections() >"
+                        " Unexpected connection state encountered [" + Convert::toString(connectionData->state)
+                        + "] for device [" + Convert::toString(deviceID)
+                        + "] on connection [" + Convert::toString(connectionID) + "].");
+            }
+            
             connectionData->pendingSentData.pop();
             connectionData->state = ConnectionSetupState::COMPLETED;
         }
@@ -1084,6 +1241,11 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onWriteResultReceivedHa
                     boost::bind(&NetworkManagement_Handlers::DataConnectionsHandler::onWriteResultReceivedHandler_EstablishedConnections,
                                 this, _1, deviceID, connectionID));
         
+        connectionData->onFlowControlEventConnection =
+                connectionData->connection->onFlowControlEventAttach(
+                    boost::bind(&NetworkManagement_Handlers::DataConnectionsHandler::onFlowControlHandler_EstablishedConnections,
+                                this, _1, deviceID, connectionID));
+        
         connectionData->connection->enableDataEvents();
         
         logMessage(LogSeverity::Info, "(onWriteResultReceivedHandler_PendingRemoteConnections) >"
@@ -1131,7 +1293,7 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDisconnectHandler_Est
 }
 
 void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_EstablishedConnections
-(ByteData data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
+(const BufferView & data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
 {
     if(!active)
         return;
@@ -1141,17 +1303,64 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_E
             " Received data for device [" + Convert::toString(deviceID)
             + "] on connection [" + Convert::toString(connectionID) + "].");
 
+    if(!pipeline)
+    {
+        processReceivedData(data, remaining, deviceID, connectionID);
+        return;
+    }
+    
+    //the data stays in the connection's read queue until a worker processes it;
+    //if it fills the connection's lane, reading is paused until it is processed
+    ConnectionPtr connection = getConnectionData(deviceID, connectionID)->connection;
+    bool pauseReading = pipeline->isIncomingLaneFull(connectionID, 1);
+    connection->holdReceivedData(pauseReading);
+    
+    if(!pipeline->submitIncoming(connectionID, boost::bind(&DataConnectionsHandler::processPipelinedReceivedData,
+                                                           this, data, remaining, deviceID, connectionID, connection, pauseReading)))
+    {//the handler is being destroyed
+        connection->releaseReceivedData(data.size(), pauseReading);
+        ++invalidDataObjectsReceived;
+        logMessage(LogSeverity::Warning, "(onDataReceivedHandler_EstablishedConnections) >"
+                " Data for device [" + Convert::toString(deviceID)
+                + "] on connection [" + Convert::toString(connectionID) + "] discarded; the pipeline is stopping.");
+    }
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::processPipelinedReceivedData
+(const BufferView & data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID,
+ ConnectionPtr connection, bool readingPaused)
+{
+    try
+    {
+        processReceivedData(data, remaining, deviceID, connectionID);
+    }
+    catch(...)
+    {
+        connection->releaseReceivedData(data.size(), readingPaused);
+        throw;
+    }
+    
+    connection->releaseReceivedData(data.size(), readingPaused);
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::processReceivedData
+(const BufferView & data, PacketSize remaining, const DeviceID deviceID, const ConnectionID connectionID)
+{
+    if(!active)
+        return;
+
     ConnectionDataPtr connectionData = getConnectionData(deviceID, connectionID);
-    boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
+    boost::unique_lock<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
 
     if((connectionData->lastPendingReceivedData.size() + data.size() + remaining) > maxDataSize)
     {
         ++invalidDataObjectsReceived;
-        logMessage(LogSeverity::Error, "(onDataReceivedHandler_EstablishedConnections) >"
+        logMessage(LogSeverity::Error, "(processReceivedData) >"
                 " Cannot process data with size ["
                 + Convert::toString(connectionData->lastPendingReceivedData.size() + data.size() + remaining)
                 + "]; maximum is [" + Convert::toString(maxDataSize) + "].");
         
+        connectionDataLock.unlock();
         terminateConnection(connectionID, deviceID);
         return;
     }
@@ -1160,71 +1369,198 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onDataReceivedHandler_E
     {//the handler needs to wait for the rest of the data from the remote peer
         if(connectionData->lastPendingReceivedData.size() > 0)
         {
-            connectionData->lastPendingReceivedData.append(data);
+            data.appendTo(connectionData->lastPendingReceivedData);
         }
         else
         {
-            connectionData->lastPendingReceivedData.assign(data);
+            connectionData->lastPendingReceivedData = data.toByteData();
         }
+
+        return;
+    }
+
+    //the frame is either assembled from the pending data or received with a single read
+    ByteData singleReadFrame;
+    const ByteData * frame = &singleReadFrame;
+    if(connectionData->lastPendingReceivedData.size() > 0)
+    {
+        data.appendTo(connectionData->lastPendingReceivedData);
+        frame = &connectionData->lastPendingReceivedData;
     }
     else
-    {//the handler has all necessary data to continue
+    {
+        singleReadFrame = data.toByteData();
+    }
+
+    if(!frame->empty() && static_cast<DataFrameType>(frame->front()) == DataFrameType::STREAM_CHUNK)
+    {//the data is a chunk of one of the incoming streams
+        IncomingStreamPtr stream;
+
         try
         {
-            PlaintextData receivedData;
-            if(connectionData->lastPendingReceivedData.size() > 0)
-            {
-                connectionData->lastPendingReceivedData.append(data);
+            stream = processStreamChunk(connectionData, *frame);
+        }
+        catch(const std::exception & e)
+        {
+            logMessage(LogSeverity::Error, "(processReceivedData) >"
+                    " Exception encountered: [" + std::string(e.what())
+                    + "] while receiving stream from device [" + Convert::toString(deviceID)
+                    + "] on connection [" + Convert::toString(connectionID) + "].");
+        }
 
-                if(connectionData->encryptionEnabled)
-                {//the data needs to be decrypted
-                    connectionData->cryptoHandler->decryptData(
-                        connectionData->lastPendingReceivedData, receivedData);
-                }
-                else
-                {//the data was sent in plaintext
-                    receivedData = connectionData->lastPendingReceivedData;
-                }
+        connectionData->lastPendingReceivedData.clear();
+
+        if(!stream)
+        {//the chunk cannot be assigned to a stream and is discarded; the other streams are not affected
+            ++invalidDataObjectsReceived;
+        }
+        else if(stream->rejected)
+        {//only the chunk's stream is failed; the remote peer is notified, so that it stops sending it
+            ++invalidDataObjectsReceived;
+            connectionData->incomingStreams.erase(stream->streamID);
+            queueStreamWindowUpdate(connectionData, StreamWindowUpdate{stream->streamID, 0, StreamWindowUpdate::FLAG_REJECTED});
+            connectionDataLock.unlock();
+
+            ++streamsFailed;
+            ++streamsAborted;
+
+            if(stream->completionHandler)
+                stream->completionHandler(false, stream->bytesWritten);
+        }
+        else if(stream->lastChunkReceived || stream->aborted)
+        {
+            ++validDataObjectsReceived;
+            connectionData->incomingStreams.erase(stream->streamID);
+            connectionDataLock.unlock();
 
-                connectionData->lastPendingReceivedData.clear();
+            if(stream->aborted)
+            {
+                ++streamsFailed;
+                ++streamsAborted;
             }
             else
             {
-                if(connectionData->encryptionEnabled)
-                {//the data needs to be decrypted
-                    connectionData->cryptoHandler->decryptData(data, receivedData);
-                }
-                else
-                {//the data was sent in plaintext
-                    receivedData = data;
-                }
+                ++streamsReceived;
             }
 
-            if(connectionData->compressionEnabled)
-            {//the data needs to be decompressed
-                ByteData decompressedData;
-                compressor.decompressData(receivedData, decompressedData);
-                onDataReceived(deviceID, connectionID, decompressedData);
+            if(stream->completionHandler)
+                stream->completionHandler(stream->lastChunkReceived, stream->bytesWritten);
+        }
+        else
+        {
+            ++validDataObjectsReceived;
+
+            //the processed chunks are returned to the remote peer once half of the window is used up
+            if(++stream->processedChunks >= ((maxStreamChunksInFlight + 1) / 2))
+            {
+                queueStreamWindowUpdate(connectionData, StreamWindowUpdate{stream->streamID, stream->processedChunks, 0});
+                stream->processedChunks = 0;
+            }
+        }
+    }
+    else if(!frame->empty() && static_cast<DataFrameType>(frame->front()) == DataFrameType::STREAM_WINDOW_UPDATE)
+    {//the remote peer granted more credits for (or rejected) one of the outgoing streams
+        bool continueOutgoingStreams = false;
+
+        try
+        {
+            std::size_t updateLength = frame->size() - FRAME_TYPE_LENGTH;
+            if(connectionData->encryptionEnabled)
+            {//the frame type and the update are verified before the update is applied
+                if(frame->size() <= STREAM_WINDOW_UPDATE_LENGTH)
+                    throw std::runtime_error("DataConnectionsHandler::processReceivedData() > Unauthenticated stream window update received.");
+                
+                PlaintextData updateData;
+                DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::DECRYPT);
+                connectionData->cryptoHandler->decryptData(
+                    frame->substr(STREAM_WINDOW_UPDATE_LENGTH), frame->substr(0, STREAM_WINDOW_UPDATE_LENGTH), updateData);
+                
+                if(!updateData.empty())
+                    throw std::runtime_error("DataConnectionsHandler::processReceivedData() > Unexpected data received with stream window update.");
+                
+                updateLength = StreamWindowUpdate::BYTE_LENGTH;
+            }
+            
+            continueOutgoingStreams = applyStreamWindowUpdate(connectionData, StreamWindowUpdate::fromNetworkBytes(
+                    reinterpret_cast<const Byte *>(frame->data()) + FRAME_TYPE_LENGTH, updateLength));
+
+            ++validDataObjectsReceived;
+        }
+        catch(const std::exception & e)
+        {
+            ++invalidDataObjectsReceived;
+            logMessage(LogSeverity::Error, "(processReceivedData) >"
+                    " Exception encountered: [" + std::string(e.what())
+                    + "] while processing stream window update from device [" + Convert::toString(deviceID)
+                    + "] on connection [" + Convert::toString(connectionID) + "].");
+        }
+
+        connectionData->lastPendingReceivedData.clear();
+        connectionDataLock.unlock();
+
+        if(continueOutgoingStreams)
+            scheduleStreamsContinuation(connectionData, deviceID, connectionID);
+    }
+    else
+    {//the handler has all necessary data to continue
+        try
+        {
+            if(frame->empty() || static_cast<DataFrameType>(frame->front()) != DataFrameType::DATA)
+                throw std::runtime_error("DataConnectionsHandler::processReceivedData() > Unexpected frame type encountered.");
+
+            PlaintextData receivedData;
+            if(connectionData->encryptionEnabled)
+            {//the data needs to be decrypted and the frame type verified
+                DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::DECRYPT);
+                connectionData->cryptoHandler->decryptData(
+                    frame->substr(FRAME_TYPE_LENGTH), frame->substr(0, FRAME_TYPE_LENGTH), receivedData);
             }
             else
-            {//the data is not compressed
-                onDataReceived(deviceID, connectionID, receivedData);
+            {//the data was sent in plaintext
+                receivedData = frame->substr(FRAME_TYPE_LENGTH);
+            }
+
+            connectionData->lastPendingReceivedData.clear();
+
+            if(connectionData->compressionEnabled)
+            {//the data may need to be decompressed, depending on its marker
+                DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::DECOMPRESS);
+                if(receivedData.empty())
+                    throw std::runtime_error("DataConnectionsHandler::processReceivedData() > The compression marker is missing.");
+
+                char compressionMarker = receivedData.back();
+                receivedData.pop_back();
+
+                if(compressionMarker == COMPRESSION_MARKER_LZ4)
+                {
+                    ByteData decompressedData;
+                    compressor.decompressData(receivedData, decompressedData);
+                    receivedData.swap(decompressedData);
+                }
+                else if(compressionMarker != COMPRESSION_MARKER_NONE)
+                {
+                    throw std::runtime_error("DataConnectionsHandler::processReceivedData() > Unexpected compression marker encountered.");
+                }
             }
 
+            DataPipeline::StageTimer deliveryTimer(pipeline.get(), DataPipelineStage::DELIVER);
+            onDataReceived(deviceID, connectionID, receivedData);
             ++validDataObjectsReceived;
         }
         catch(const std::exception & e)
         {
+            connectionData->lastPendingReceivedData.clear();
             ++invalidDataObjectsReceived;
-            logMessage(LogSeverity::Error, "(onDataReceivedHandler_EstablishedConnections) >"
+            logMessage(LogSeverity::Error, "(processReceivedData) >"
                     " Exception encountered: [" + std::string(e.what())
                     + "] for device [" + Convert::toString(deviceID)
                     + "] on connection [" + Convert::toString(connectionID) + "].");
         }
         catch(...)
         {
+            connectionData->lastPendingReceivedData.clear();
             ++invalidDataObjectsReceived;
-            logMessage(LogSeverity::Error, "(onDataReceivedHandler_EstablishedConnections) >"
+            logMessage(LogSeverity::Error, "(processReceivedData) >"
                     " Unknown exception encountered for device [" + Convert::toString(deviceID)
                     + "] on connection [" + Convert::toString(connectionID) + "].");
         }
@@ -1251,35 +1587,672 @@ void NetworkManagement_Handlers::DataConnectionsHandler::onWriteResultReceivedHa
         ++sendRequestsConfirmed;
     }
 
-    boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
-    delete connectionData->pendingSentData.front();
-    connectionData->pendingSentData.pop();
-}
-//</editor-fold>
-
-//<editor-fold defaultstate="collapsed" desc="Cleanup">
-void NetworkManagement_Handlers::DataConnectionsHandler::terminateConnection
-(const ConnectionID connectionID, const DeviceID remotePeerID)
-{
-    try
+    boost::unique_lock<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
+    OutgoingStreamPtr chunkStream;
+    if(!connectionData->pendingSentData.empty())
     {
-        ConnectionDataPtr connectionData = (remotePeerID == INVALID_DEVICE_ID)
-                ? discardPendingConnectionData(connectionID)
-                : discardConnectionData(remotePeerID, connectionID);
+        chunkStream = connectionData->pendingSentData.front().second;
+        connectionData->pendingSentData.pop();
+    }
+
+    queueBlockedStreamWindowUpdates(connectionData);
+
+    if(connectionData->outgoingStreams.empty())
+        return;
+
+    if(chunkStream)
+    {//the chunk's window slot is released
+        --chunkStream->chunksInFlight;
+        ++streamChunksSent;
+
+        if(!received)
+        {//the remote peer cannot recover from a partial stream; all streams on the connection are failed
+            connectionDataLock.unlock();
+            terminateConnection(connectionID, deviceID);
+            return;
+        }
+    }
+
+    connectionDataLock.unlock();
+    scheduleStreamsContinuation(connectionData, deviceID, connectionID);
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::onFlowControlHandler_EstablishedConnections
+(FlowControlEvent event, const DeviceID deviceID, const ConnectionID connectionID)
+{
+    if(!active)
+        return;
+
+    switch(event)
+    {
+        case FlowControlEvent::WRITE_QUEUE_HIGH: ++writeQueueBlocks; break;
+        case FlowControlEvent::READ_QUEUE_HIGH: ++readQueuePauses; break;
+        default: break;
+    }
+
+    logMessage(LogSeverity::Debug, "(onFlowControlHandler_EstablishedConnections) > Event ["
+            + Convert::toString(event) + "] received for device [" + Convert::toString(deviceID)
+            + "] on connection [" + Convert::toString(connectionID) + "].");
+}
+//</editor-fold>
+
+//<editor-fold defaultstate="collapsed" desc="Data Processing">
+bool NetworkManagement_Handlers::DataConnectionsHandler::compressPayload
+(ConnectionDataPtr connectionData, const ByteData & payload, ByteData & compressedData)
+{
+    if(compressionPolicy.shouldCompress(payload, connectionData->compressionHistory))
+    {
+        compressor.compressData(payload, compressedData);
+        compressionPolicy.recordResult(connectionData->compressionHistory, payload.size(), compressedData.size());
+
+        if(compressedData.size() < payload.size())
+        {
+            compressionSavedBytes += (payload.size() - compressedData.size());
+            return true;
+        }
+
+        compressedData.clear();
+    }
+
+    compressionSkippedBytes += payload.size();
+    return false;
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::processOutgoingData
+(ConnectionDataPtr connectionData, const DeviceID deviceID, const ConnectionID connectionID, const PlaintextData & plaintextData)
+{
+    if(!active)
+        return false;
+
+    //with pipeline workers, the connection's data is processed only in its lane and the mutex is needed only for queueing it
+    boost::unique_lock<boost::mutex> connectionDataLock(connectionData->connectionDataMutex, boost::defer_lock);
+
+    if(!pipeline)
+        connectionDataLock.lock();
+
+    //the frame type is authenticated along with the data
+    boost::shared_ptr<MixedData> dataToSend(new MixedData());
+    dataToSend->push_back(static_cast<char>(DataFrameType::DATA));
+
+    try
+    {
+        const PlaintextData * nextData = &plaintextData;
+        ByteData compressedData;
+
+        if(connectionData->compressionEnabled)
+        {//compresses the data (if it is worth it) and marks the result for the remote peer
+            DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::COMPRESS);
+            if(compressPayload(connectionData, plaintextData, compressedData))
+            {
+                compressedData.push_back(COMPRESSION_MARKER_LZ4);
+            }
+            else
+            {
+                compressedData.reserve(plaintextData.size() + 1);
+                compressedData.assign(plaintextData);
+                compressedData.push_back(COMPRESSION_MARKER_NONE);
+            }
+
+            nextData = &compressedData;
+        }
+
+        if(connectionData->encryptionEnabled)
+        {//encrypts the (compressed) data
+            DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::ENCRYPT);
+            CiphertextData encryptedData;
+            connectionData->cryptoHandler->encryptData(*nextData, *dataToSend, encryptedData);
+            dataToSend->append(encryptedData);
+        }
+        else
+        {//data is NOT encrypted
+            dataToSend->append(*nextData);
+        }
+
+        if(!connectionDataLock.owns_lock())
+            connectionDataLock.lock();
+
+        bool dataQueued;
+        {
+            DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::WRITE);
+            dataQueued = connectionData->connection->sendData(dataToSend);
+        }
+
+        if(!dataQueued)
+        {
+            ++sendRequestsRejected;
+            logMessage(LogSeverity::Warning, "(processOutgoingData) > Data for device ["
+                    + Convert::toString(deviceID) + "] on connection ["
+                    + Convert::toString(connectionID) + "] rejected; the connection's write queue is full.");
+            
+            return false;
+        }
+        
+        connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(dataToSend, OutgoingStreamPtr()));
+        
+        logMessage(LogSeverity::Info, "(processOutgoingData) > Data sent to device ["
+                + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "].");
+        
+        return true;
+    }
+    catch(const std::exception & e)
+    {
+        if(connectionDataLock.owns_lock())
+            connectionDataLock.unlock();
+
+        ++sendRequestsFailed;
+        logMessage(LogSeverity::Error, "(processOutgoingData) > Exception encountered: ["
+                + std::string(e.what()) + "] while sending data to device ["
+                + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "].");
+        
+        terminateConnection(connectionID, deviceID);
+        connectionData->connection->disconnect();
+        throw;
+    }
+    catch(...)
+    {
+        if(connectionDataLock.owns_lock())
+            connectionDataLock.unlock();
+
+        ++sendRequestsFailed;
+        logMessage(LogSeverity::Error, "(processOutgoingData) >"
+                " Unknown exception encountered while sending data to device ["
+                + Convert::toString(deviceID) + "] on connection ["
+                + Convert::toString(connectionID) + "].");
+        
+        terminateConnection(connectionID, deviceID);
+        connectionData->connection->disconnect();
+        throw;
+    }
+}
+//</editor-fold>
+
+//<editor-fold defaultstate="collapsed" desc="Data Streams">
+void NetworkManagement_Handlers::DataConnectionsHandler::continueStreams
+(ConnectionDataPtr connectionData, const DeviceID deviceID, const ConnectionID connectionID)
+{
+    boost::unique_lock<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
+
+    if(connectionData->outgoingStreams.empty())
+        return; //the streams were already completed or failed
+
+    bool connectionFailed = false;
+    bool chunksQueued = queueBlockedStreamChunk(connectionData);
+
+    while(chunksQueued && !connectionFailed)
+    {//one chunk of each stream is queued in every round, so that the streams share the connection fairly
+        chunksQueued = false;
+
+        //the round starts after the stream that was served last
+        std::vector<OutgoingStreamPtr> roundStreams;
+        roundStreams.reserve(connectionData->outgoingStreams.size());
+        auto firstStream = connectionData->outgoingStreams.lower_bound(connectionData->nextOutgoingStreamID);
+        for(auto currentStream = firstStream; currentStream != connectionData->outgoingStreams.end(); ++currentStream)
+            roundStreams.push_back(currentStream->second);
+
+        for(auto currentStream = connectionData->outgoingStreams.begin(); currentStream != firstStream; ++currentStream)
+            roundStreams.push_back(currentStream->second);
+
+        for(const OutgoingStreamPtr & stream : roundStreams)
+        {
+            if(stream->failed || stream->lastChunkQueued || stream->credits == 0 || stream->chunksInFlight >= maxStreamChunksInFlight)
+                continue; //the stream has nothing to send, no credits left or its queue is full
+
+            connectionData->nextOutgoingStreamID = stream->streamID + 1;
+
+            try
+            {
+                if(!queueStreamChunk(connectionData, stream))
+                {//the write queue is full; all streams wait for the blocked chunk to be sent
+                    chunksQueued = false;
+                    break;
+                }
+
+                chunksQueued = true;
+            }
+            catch(const std::exception & e)
+            {
+                stream->failed = true;
+                logMessage(LogSeverity::Error, "(continueStreams) > Exception encountered: ["
+                        + std::string(e.what()) + "] while sending stream [" + Convert::toString(stream->streamID)
+                        + "] to device [" + Convert::toString(deviceID) + "] on connection ["
+                        + Convert::toString(connectionID) + "].");
+
+                if(stream->nextSequence > 0 && !stream->rejected && !queueStreamAbort(connectionData, stream))
+                {//the remote peer cannot recover from a partial stream
+                    connectionFailed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<OutgoingStreamPtr> finishedStreams;
+    for(auto currentStream = connectionData->outgoingStreams.begin(); currentStream != connectionData->outgoingStreams.end();)
+    {
+        OutgoingStreamPtr stream = currentStream->second;
+        if(stream->failed
+           || (stream->lastChunkQueued && stream->chunksInFlight == 0 && connectionData->blockedStreamChunk.second != stream))
+        {
+            finishedStreams.push_back(stream);
+            currentStream = connectionData->outgoingStreams.erase(currentStream);
+        }
+        else
+        {
+            ++currentStream;
+        }
+    }
+
+    connectionDataLock.unlock();
+
+    if(connectionFailed)
+        terminateConnection(connectionID, deviceID); //fails all remaining streams
+
+    for(const OutgoingStreamPtr & stream : finishedStreams)
+    {
+        if(stream->failed)
+        {
+            ++streamsFailed;
+
+            if(stream->nextSequence > 0 && !connectionFailed)
+                ++streamsAborted;
+        }
+        else
+        {
+            ++streamsSent;
+        }
+
+        if(stream->completionHandler)
+            stream->completionHandler(!stream->failed, stream->bytesRead);
+    }
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::scheduleStreamsContinuation
+(ConnectionDataPtr connectionData, const DeviceID deviceID, const ConnectionID connectionID)
+{
+    if(!pipeline)
+    {
+        continueStreams(connectionData, deviceID, connectionID);
+    }
+    else
+    {//the next chunks are processed by the pipeline workers
+        pipeline->submitContinuation(connectionID, boost::bind(&DataConnectionsHandler::continueStreams,
+                                                               this, connectionData, deviceID, connectionID));
+    }
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::queueBlockedStreamChunk(ConnectionDataPtr connectionData)
+{
+    if(!connectionData->blockedStreamChunk.first)
+        return true;
+
+    if(!connectionData->connection->sendData(connectionData->blockedStreamChunk.first))
+        return false;
+
+    connectionData->pendingSentData.push(connectionData->blockedStreamChunk);
+    ++connectionData->blockedStreamChunk.second->chunksInFlight;
+    connectionData->blockedStreamChunk = std::pair<ByteDataPtr, OutgoingStreamPtr>();
+
+    return true;
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::queueStreamChunk
+(ConnectionDataPtr connectionData, OutgoingStreamPtr stream)
+{
+    if(stream->nextSequence == 0)
+    {//no chunks were processed yet; reads ahead the first one
+        readStreamChunk(stream);
+    }
+
+    stream->currentChunk.swap(stream->nextChunk);
+    readStreamChunk(stream); //reads ahead, to find out if the current chunk is the last one
+
+    StreamChunkHeader header{stream->streamID, stream->nextSequence, 0};
+    if(stream->nextChunk.empty())
+        header.flags |= StreamChunkHeader::FLAG_LAST_CHUNK;
+
+    const ByteData * chunkData = &stream->currentChunk;
+    ByteData compressedData;
+    if(connectionData->compressionEnabled && !stream->currentChunk.empty())
+    {
+        DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::COMPRESS);
+        if(compressPayload(connectionData, stream->currentChunk, compressedData))
+        {
+            chunkData = &compressedData;
+            header.flags |= StreamChunkHeader::FLAG_COMPRESSED;
+        }
+    }
+
+    boost::shared_ptr<MixedData> dataToSend(new MixedData());
+    dataToSend->reserve(STREAM_CHUNK_PREFIX_LENGTH + chunkData->size());
+    dataToSend->push_back(static_cast<char>(DataFrameType::STREAM_CHUNK));
+    header.toNetworkBytes(*dataToSend);
+
+    if(connectionData->encryptionEnabled)
+    {//the frame type and the header are authenticated along with the chunk data (if any)
+        DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::ENCRYPT);
+        CiphertextData encryptedData;
+        connectionData->cryptoHandler->encryptData(*chunkData, *dataToSend, encryptedData);
+        dataToSend->append(encryptedData);
+    }
+    else
+    {
+        dataToSend->append(*chunkData);
+    }
+
+    ++stream->nextSequence;
+    --stream->credits;
+    stream->lastChunkQueued = header.isLastChunk();
+
+    bool chunkQueued;
+    {
+        DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::WRITE);
+        chunkQueued = connectionData->connection->sendData(dataToSend);
+    }
+
+    if(!chunkQueued)
+    {//the write queue is full; the chunk is retried after the next write result
+        connectionData->blockedStreamChunk = std::pair<ByteDataPtr, OutgoingStreamPtr>(dataToSend, stream);
+        return false;
+    }
+
+    connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(dataToSend, stream));
+    ++stream->chunksInFlight;
+
+    return true;
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::queueStreamAbort
+(ConnectionDataPtr connectionData, OutgoingStreamPtr stream)
+{
+    boost::shared_ptr<MixedData> dataToSend(new MixedData());
+    dataToSend->reserve(STREAM_CHUNK_PREFIX_LENGTH);
+    dataToSend->push_back(static_cast<char>(DataFrameType::STREAM_CHUNK));
+    StreamChunkHeader{stream->streamID, stream->nextSequence, StreamChunkHeader::FLAG_ABORTED}.toNetworkBytes(*dataToSend);
+
+    if(connectionData->encryptionEnabled)
+    {//the notification has no data; only the frame type and the header are authenticated
+        CiphertextData authenticationData;
+        connectionData->cryptoHandler->encryptData(EMPTY_PLAINTEXT_DATA, *dataToSend, authenticationData);
+        dataToSend->append(authenticationData);
+    }
+    
+    if(!connectionData->connection->sendData(dataToSend))
+        return false;
+
+    //the notification does not take up a slot in the stream's window
+    connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(dataToSend, OutgoingStreamPtr()));
+    return true;
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::queueStreamWindowUpdate
+(ConnectionDataPtr connectionData, const StreamWindowUpdate & update)
+{
+    boost::shared_ptr<MixedData> dataToSend(new MixedData());
+    dataToSend->reserve(STREAM_WINDOW_UPDATE_LENGTH);
+    dataToSend->push_back(static_cast<char>(DataFrameType::STREAM_WINDOW_UPDATE));
+    update.toNetworkBytes(*dataToSend);
+
+    if(connectionData->encryptionEnabled)
+    {//the update has no data; only the frame type and the update itself are authenticated
+        CiphertextData authenticationData;
+        connectionData->cryptoHandler->encryptData(EMPTY_PLAINTEXT_DATA, *dataToSend, authenticationData);
+        dataToSend->append(authenticationData);
+    }
+    
+    ++streamWindowUpdatesSent;
+
+    //the updates are kept in order, behind any blocked ones
+    if(!connectionData->blockedWindowUpdates.empty() || !connectionData->connection->sendData(dataToSend))
+    {//the write queue is full; the update is retried after the next write result
+        connectionData->blockedWindowUpdates.push(dataToSend);
+        return;
+    }
+
+    connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(dataToSend, OutgoingStreamPtr()));
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::queueBlockedStreamWindowUpdates(ConnectionDataPtr connectionData)
+{
+    while(!connectionData->blockedWindowUpdates.empty())
+    {
+        ByteDataPtr nextUpdate = connectionData->blockedWindowUpdates.front();
+        if(!connectionData->connection->sendData(nextUpdate))
+            return;
+
+        connectionData->pendingSentData.push(std::pair<ByteDataPtr, OutgoingStreamPtr>(nextUpdate, OutgoingStreamPtr()));
+        connectionData->blockedWindowUpdates.pop();
+    }
+}
+
+bool NetworkManagement_Handlers::DataConnectionsHandler::applyStreamWindowUpdate
+(ConnectionDataPtr connectionData, const StreamWindowUpdate & update)
+{
+    auto outgoingStream = connectionData->outgoingStreams.find(update.streamID);
+
+    //a stream that has queued its last chunk is finishing; an initial update is for the next stream with the same ID
+    OutgoingStreamPtr stream;
+    if(outgoingStream != connectionData->outgoingStreams.end() && !outgoingStream->second->lastChunkQueued)
+        stream = outgoingStream->second;
+
+    if(update.isRejected())
+    {
+        if(!stream)
+            return false; //the stream has already finished
+
+        stream->failed = true;
+        stream->rejected = true;
+
+        if(connectionData->blockedStreamChunk.second == stream)
+        {//the remote peer no longer expects the stream's chunks
+            connectionData->blockedStreamChunk = std::pair<ByteDataPtr, OutgoingStreamPtr>();
+        }
+
+        logMessage(LogSeverity::Warning, "(applyStreamWindowUpdate) > Stream ["
+                + Convert::toString(update.streamID) + "] was rejected by the remote peer.");
+
+        return true;
+    }
+
+    if(update.isInitial() && (!stream || stream->nextSequence > 0))
+    {//the stream was not started yet (or a stream with the same ID is still being sent)
+        if(connectionData->pendingStreamCredits.size() >= maxStreamsPerConnection
+           && connectionData->pendingStreamCredits.find(update.streamID) == connectionData->pendingStreamCredits.end())
+        {
+            throw std::runtime_error("DataConnectionsHandler::applyStreamWindowUpdate() > Too many streams are"
+                    " expected by the remote peer; credits for stream [" + Convert::toString(update.streamID) + "] discarded.");
+        }
+
+        connectionData->pendingStreamCredits[update.streamID] = update.credits;
+        return false;
+    }
+
+    if(!stream)
+        return false; //the credits are for a stream that has already finished
+
+    stream->credits += update.credits;
+    return true;
+}
+
+void NetworkManagement_Handlers::DataConnectionsHandler::readStreamChunk(OutgoingStreamPtr stream)
+{
+    stream->nextChunk.resize(streamChunkSize);
+    std::size_t chunkSize = 0;
+
+    while(!stream->sourceExhausted && chunkSize < streamChunkSize)
+    {
+        std::streamsize bytesToRead = streamChunkSize - chunkSize;
+        std::streamsize bytesRead = stream->source(reinterpret_cast<Byte *>(&stream->nextChunk[chunkSize]), bytesToRead);
+
+        if(bytesRead < 0 || bytesRead > bytesToRead)
+            throw std::runtime_error("DataConnectionsHandler::readStreamChunk() > Failed to read data from the stream source.");
+        else if(bytesRead == 0)
+            stream->sourceExhausted = true;
+        else
+            chunkSize += bytesRead;
+    }
+
+    stream->nextChunk.resize(chunkSize);
+    stream->bytesRead += chunkSize;
+}
+
+NetworkManagement_Handlers::DataConnectionsHandler::IncomingStreamPtr
+NetworkManagement_Handlers::DataConnectionsHandler::processStreamChunk
+(ConnectionDataPtr connectionData, const ByteData & chunkData)
+{
+    StreamChunkHeader header = StreamChunkHeader::fromNetworkBytes(
+            reinterpret_cast<const Byte *>(chunkData.data()) + FRAME_TYPE_LENGTH, chunkData.size() - FRAME_TYPE_LENGTH);
+
+    auto incomingStream = connectionData->incomingStreams.find(header.streamID);
+    if(incomingStream == connectionData->incomingStreams.end())
+    {//the stream was rejected or was never expected
+        logMessage(LogSeverity::Warning, "(processStreamChunk) > Chunk ["
+                + Convert::toString(header.sequence) + "] received for unexpected stream ["
+                + Convert::toString(header.streamID) + "]; the chunk is discarded.");
+
+        return IncomingStreamPtr();
+    }
+
+    IncomingStreamPtr stream = incomingStream->second;
+
+    try
+    {
+        PlaintextData receivedData;
+        if(connectionData->encryptionEnabled)
+        {//the frame type and header are verified (and the data decrypted) before the chunk is acted upon
+            if(chunkData.size() <= STREAM_CHUNK_PREFIX_LENGTH)
+            {
+                throw std::runtime_error("DataConnectionsHandler::processStreamChunk() > Unauthenticated chunk ["
+                        + Convert::toString(header.sequence) + "] received for stream ["
+                        + Convert::toString(header.streamID) + "].");
+            }
+            
+            DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::DECRYPT);
+            connectionData->cryptoHandler->decryptData(
+                chunkData.substr(STREAM_CHUNK_PREFIX_LENGTH),
+                chunkData.substr(0, STREAM_CHUNK_PREFIX_LENGTH),
+                receivedData);
+        }
+        else if(chunkData.size() > STREAM_CHUNK_PREFIX_LENGTH)
+        {//the data was sent in plaintext
+            receivedData = chunkData.substr(STREAM_CHUNK_PREFIX_LENGTH);
+        }
+        
+        if(header.sequence != stream->nextSequence)
+        {
+            throw std::runtime_error("DataConnectionsHandler::processStreamChunk() > Unexpected chunk ["
+                    + Convert::toString(header.sequence) + "] received for stream ["
+                    + Convert::toString(header.streamID) + "]; expected ["
+                    + Convert::toString(stream->nextSequence) + "].");
+        }
+
+        if(header.isAborted())
+        {//the remote peer abandoned the stream; the connection is not affected
+            if(!receivedData.empty())
+            {
+                throw std::runtime_error("DataConnectionsHandler::processStreamChunk() > Unexpected data received"
+                        " with abort notification for stream [" + Convert::toString(header.streamID) + "].");
+            }
+
+            stream->aborted = true;
+            return stream;
+        }
+
+        if(receivedData.empty())
+        {
+            if(header.sequence > 0 || !header.isLastChunk())
+            {//only empty streams have empty chunks
+                throw std::runtime_error("DataConnectionsHandler::processStreamChunk() > Unexpected empty chunk ["
+                        + Convert::toString(header.sequence) + "] received.");
+            }
+        }
+        else if(header.isCompressed())
+        {//the data needs to be decompressed
+            DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::DECOMPRESS);
+            ByteData decompressedData;
+            compressor.decompressData(receivedData, decompressedData);
+            receivedData.swap(decompressedData);
+        }
+
+        if((stream->bytesWritten + receivedData.size()) > stream->maxSize)
+        {
+            throw std::runtime_error("DataConnectionsHandler::processStreamChunk() > Stream exceeds the maximum size ["
+                    + Convert::toString(stream->maxSize) + "].");
+        }
+
+        if(!receivedData.empty())
+        {
+            DataPipeline::StageTimer timer(pipeline.get(), DataPipelineStage::DELIVER);
+            std::streamsize bytesWritten = stream->sink(reinterpret_cast<const Byte *>(receivedData.data()), receivedData.size());
+            if(bytesWritten != static_cast<std::streamsize>(receivedData.size()))
+                throw std::runtime_error("DataConnectionsHandler::processStreamChunk() > Failed to write data to the stream sink.");
+
+            stream->bytesWritten += bytesWritten;
+        }
+    }
+    catch(const std::exception & e)
+    {//the stream cannot continue; the connection and its other streams are not affected
+        stream->rejected = true;
+        logMessage(LogSeverity::Error, "(processStreamChunk) > Exception encountered: ["
+                + std::string(e.what()) + "] while receiving stream ["
+                + Convert::toString(header.streamID) + "]; the stream is rejected.");
+
+        return stream;
+    }
+
+    ++stream->nextSequence;
+    ++streamChunksReceived;
+    stream->lastChunkReceived = header.isLastChunk();
+
+    return stream;
+}
+//</editor-fold>
+
+//<editor-fold defaultstate="collapsed" desc="Cleanup">
+void NetworkManagement_Handlers::DataConnectionsHandler::terminateConnection
+(const ConnectionID connectionID, const DeviceID remotePeerID)
+{
+    std::map<StreamID, OutgoingStreamPtr> outgoingStreams;
+    boost::unordered_map<StreamID, IncomingStreamPtr> incomingStreams;
+
+    try
+    {
+        ConnectionDataPtr connectionData = (remotePeerID == INVALID_DEVICE_ID)
+                ? discardPendingConnectionData(connectionID)
+                : discardConnectionData(remotePeerID, connectionID);
 
         boost::lock_guard<boost::mutex> connectionDataLock(connectionData->connectionDataMutex);
+        outgoingStreams.swap(connectionData->outgoingStreams);
+        incomingStreams.swap(connectionData->incomingStreams);
+        connectionData->blockedStreamChunk = std::pair<ByteDataPtr, OutgoingStreamPtr>();
         connectionData->onDataReceivedEventConnection.disconnect();
         connectionData->onDisconnectEventConnection.disconnect();
         connectionData->onWriteResultReceivedEventConnection.disconnect();
+        connectionData->onFlowControlEventConnection.disconnect();
         connectionData->connection->disconnect();
 
         while(connectionData->pendingSentData.size() > 0)
         {
-            delete connectionData->pendingSentData.front();
             connectionData->pendingSentData.pop();
         }
     }
     catch(const std::runtime_error &)
     {}
+
+    //any active streams are failed
+    for(auto & outgoingStream : outgoingStreams)
+    {
+        ++streamsFailed;
+        if(outgoingStream.second->completionHandler)
+            outgoingStream.second->completionHandler(false, outgoingStream.second->bytesRead);
+    }
+
+    for(auto & incomingStream : incomingStreams)
+    {
+        ++streamsFailed;
+        if(incomingStream.second->completionHandler)
+            incomingStream.second->completionHandler(false, incomingStream.second->bytesWritten);
+    }
 }
 //</editor-fold>
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <string>
 #include <queue>
+#include <map>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
@@ -30,6 +31,7 @@
 #include "../Common/Types.h"
 #include "../Utilities/FileLogger.h"
 #include "../Utilities/Compression/CompressionHandler.h"
+#include "../Utilities/Compression/AdaptiveCompressionPolicy.h"
 
 #include "../DatabaseManagement/Types/Types.h"
 #include "../DatabaseManagement/Containers/DeviceDataContainer.h"
@@ -42,10 +44,14 @@
 #include "../SecurityManagement/Crypto/Handlers.h"
 
 #include "Connections/Connection.h"
+#include "Connections/DataPipeline.h"
 #include "../EntityManagement/Interfaces/DatabaseLoggingSource.h"
+#include "../StorageManagement/Pools/Streams/PoolStreams.h"
 
 //Networking
 using NetworkManagement_Connections::ConnectionPtr;
+using NetworkManagement_Connections::DataPipeline;
+using NetworkManagement_Connections::DataPipelinePtr;
 using NetworkManagement_Types::RawConnectionID;
 using NetworkManagement_Types::ConnectionID;
 using NetworkManagement_Types::TransientConnectionID;
@@ -53,6 +59,15 @@ using NetworkManagement_Types::ConnectionSetupState;
 using NetworkManagement_Types::PendingDataConnectionConfigPtr;
 using NetworkManagement_Types::INVALID_TRANSIENT_CONNECTION_ID;
 using NetworkManagement_Types::StatCounter;
+using NetworkManagement_Types::FlowControlEvent;
+using NetworkManagement_Types::StreamChunkHeader;
+using NetworkManagement_Types::StreamWindowUpdate;
+using NetworkManagement_Types::StreamCredits;
+using NetworkManagement_Types::StreamChunkSequence;
+using NetworkManagement_Types::StreamID;
+using NetworkManagement_Types::DEFAULT_STREAM_ID;
+using NetworkManagement_Types::DataPipelineStage;
+using NetworkManagement_Types::DataFrameType;
 
 //Common
 using Common_Types::LogSeverity;
@@ -60,6 +75,7 @@ using Common_Types::DeviceID;
 using Common_Types::INVALID_DEVICE_ID;
 using Common_Types::ByteData;
 using Common_Types::EMPTY_BYTE_DATA;
+using Common_Types::Byte;
 
 //Database
 using DatabaseManagement_Containers::DeviceDataContainerPtr;
@@ -78,6 +94,12 @@ using SecurityManagement_Types::LocalPeerAuthenticationEntry;
 
 //Compression
 using Utilities::Compression::CompressionHandler;
+using Utilities::Compression::AdaptiveCompressionPolicy;
+
+//Storage
+using StorageManagement_Pools::PoolInputStreamPtr;
+using StorageManagement_Pools::PoolOutputStreamPtr;
+using StorageManagement_Types::DataSize;
 
 namespace NetworkManagement_Handlers
 {
@@ -87,6 +109,16 @@ namespace NetworkManagement_Handlers
      * <code>onConnectionEstablished</code> event is fired when a connection has successfully completed its setup process.
      * <code>onConnectionEstablishmentFailed</code> event is fired when a connection has failed to complete its establishment process.
      * <code>onDataReceived</code> event is fired when new data is received from a remote peer.
+     * 
+     * Large data can be transferred as a stream of fixed-size chunks (see <code>sendStream()</code>
+     * and <code>receiveStream()</code>); each chunk is compressed and encrypted separately and
+     * only a limited number of chunks is kept in memory at any time. Multiple (logical) streams,
+     * identified by stream IDs, can share a single connection; their chunks are interleaved
+     * in a round-robin manner and each stream has its own flow control window, which is
+     * granted and replenished by the receiving peer (see <code>StreamWindowUpdate</code>).
+     * 
+     * Every message sent on an established connection starts with a <code>DataFrameType</code>
+     * byte, so regular data and stream chunks can be sent on the same connection at the same time.
      */
     class DataConnectionsHandler : public EntityManagement_Interfaces::DatabaseLoggingSource
     {
@@ -102,8 +134,57 @@ namespace NetworkManagement_Handlers
                 BufferSize maxDataSize;
                 /** Compression acceleration level; see <code>Utilities::Compression::CompressionHandler</code> for more details. */
                 int compressionAccelerationLevel;
+                /** Size of the plaintext chunks of outgoing data streams (in bytes); at most half of <code>maxDataSize</code> (0 = half of <code>maxDataSize</code>). */
+                BufferSize streamChunkSize;
+                /** Maximum number of chunks of each data stream that can be in flight on a connection (the window granted for incoming streams and the queue limit for outgoing ones; 0 = default). */
+                unsigned int maxStreamChunksInFlight;
+                /** Number of worker threads for compressing/encrypting and decrypting/decompressing data (0 = done on the network threads). */
+                unsigned int pipelineWorkersCount;
+                /** Maximum number of queued outgoing data objects, for all connections, when the workers are used (0 = default). */
+                unsigned int maxPipelineQueuedTasks;
+                /** Number of bytes sampled from each payload to estimate its compressibility (0 = default). */
+                BufferSize compressionSampleSize;
+                /** Maximum expected compression ratio (compressed / original size), above which payloads are sent uncompressed (0 = default). */
+                double maxCompressionRatio;
+                /** Maximum number of outgoing (and incoming) data streams that can be active on a connection at the same time (0 = default). */
+                unsigned int maxStreamsPerConnection;
+                /** Number of queued incoming data objects of a connection at which reading from it is paused, when the workers are used (0 = default). */
+                unsigned int maxPipelineIncomingTasks;
             };
-
+            
+            /**
+             * Data stream source; reads up to the requested number of bytes into the supplied buffer.
+             * 
+             * Returns the number of bytes read (0 = end of data) or -1, if the read fails.
+             */
+            typedef std::function<std::streamsize (Byte * buffer, std::streamsize size)> StreamSource;
+            
+            /**
+             * Data stream sink; writes the supplied bytes.
+             * 
+             * Returns the number of bytes written or -1, if the write fails.
+             */
+            typedef std::function<std::streamsize (const Byte * data, std::streamsize size)> StreamSink;
+            
+            /**
+             * Data stream completion handler; called once, when the stream transfer is
+             * completed (<code>true</code>) or has failed (<code>false</code>), with the
+             * number of plaintext bytes that were transferred.
+             */
+            typedef std::function<void (bool successful, DataSize transferredBytes)> StreamCompletionHandler;
+            
+            /** Default maximum number of chunks of an outgoing data stream that can be queued on a connection. */
+            static const unsigned int DEFAULT_MAX_STREAM_CHUNKS_IN_FLIGHT = 4;
+            
+            /** Default maximum number of outgoing (and incoming) data streams that can be active on a connection. */
+            static const unsigned int DEFAULT_MAX_STREAMS_PER_CONNECTION = 16;
+            
+            /** Default maximum number of queued outgoing data objects, when the pipeline workers are used. */
+            static const unsigned int DEFAULT_MAX_PIPELINE_QUEUED_TASKS = 1024;
+            
+            /** Default number of queued incoming data objects of a connection at which reading from it is paused. */
+            static const unsigned int DEFAULT_MAX_PIPELINE_INCOMING_TASKS = 16;
+            
             /**
              * Creates a new data connection handler with the specified configuration.
              * 
@@ -111,6 +192,7 @@ namespace NetworkManagement_Handlers
              * @param cfgRetrievalHandler function for retrieving pending device configuration data
              * @param authDataRetrievalHandler function for retrieving local peer authentication data
              * @param debugLogger logger for debugging, if any
+             * @throw invalid_argument if the stream chunk size is larger than half of the maximum data size
              */
             DataConnectionsHandler(
                     const DataConnectionsHandlerParameters & params,
@@ -175,16 +257,123 @@ namespace NetworkManagement_Handlers
              * Notes:
              * - Whether the supplied data is encrypted and/or compressed, depends on the initial connection configuration.
              * - The caller can safely dispose of the plaintext data after the function returns.
+             * - The data is rejected (and not sent), if the connection's write queue is full.
+             * - When pipeline workers are used, the data is compressed/encrypted and queued on the connection
+             * by a worker (in the order in which it was supplied); it is rejected only if the pipeline's outgoing
+             * queue is full and failures after it was accepted are logged and terminate the connection.
+             * - With compression enabled, each payload is compressed only if the compression policy expects it
+             * to shrink (and it actually does); a trailing marker byte tells the remote peer which was done.
              * 
              * @param deviceID the ID of the device to send the data to
              * @param connectionID connection ID
              * @param plaintextData the plaintext data to be encrypted and/or compressed and sent
+             * @return <code>true</code>, if the data was queued for sending (or for processing, when pipeline workers are used)
              * @throw invalid_argument if the supplied plaintext data is larger than the maximum allowed
              */
-            void sendData(
+            bool sendData(
                 const DeviceID deviceID, const ConnectionID connectionID,
                 const PlaintextData & plaintextData);
             
+            /**
+             * Sends all data from the supplied source to the specified device on the specified connection,
+             * as a stream of chunks.
+             * 
+             * Notes:
+             * - Each chunk is compressed and/or encrypted separately (depending on the initial connection
+             * configuration); when encryption is enabled, the chunk header (stream ID, sequence number and
+             * flags) is authenticated together with the chunk data.
+             * - Chunks are sent only while the remote peer has granted credits for the stream (its window)
+             * and up to <code>maxStreamChunksInFlight</code> chunks of the stream are queued on the connection;
+             * the next chunks are read and processed as the previous ones are sent and the remote peer
+             * grants more credits, so memory use does not depend on the size of the stream.
+             * - Up to <code>maxStreamsPerConnection</code> outgoing streams, with different IDs, can be active
+             * on a connection; one chunk of each stream is queued in turn, so that small transfers are not
+             * delayed by large ones.
+             * - The remote peer is expected to be waiting for the stream (see <code>receiveStream()</code>);
+             * no chunks are sent until it grants the stream's first credits.
+             * - Regular data can be sent on the connection while streams are active; it is queued between their chunks.
+             * - If the stream fails after its first chunk was queued, the remote peer is notified that it was
+             * aborted; the connection is terminated only if the notification cannot be queued.
+             * - The stream fails (without affecting the connection) if the remote peer rejects it.
+             * 
+             * @param deviceID the ID of the device to send the data to
+             * @param connectionID connection ID
+             * @param source the source of the data to be sent (read until it returns 0)
+             * @param completionHandler the handler to be called when the stream is completed or fails
+             * @param streamID the ID of the stream, as expected by the remote peer
+             * @return <code>true</code>, if the stream was accepted (the completion handler is called only in this case)
+             */
+            bool sendStream(
+                const DeviceID deviceID, const ConnectionID connectionID,
+                StreamSource source, StreamCompletionHandler completionHandler,
+                const StreamID streamID = DEFAULT_STREAM_ID);
+            
+            /**
+             * Sends all readable data from the supplied pool stream to the specified device on the specified
+             * connection, as a stream of chunks.
+             * 
+             * See <code>sendStream(const DeviceID, const ConnectionID, StreamSource, StreamCompletionHandler, const StreamID)</code>.
+             * 
+             * @param deviceID the ID of the device to send the data to
+             * @param connectionID connection ID
+             * @param source the stream to read the data from (kept until the transfer is completed)
+             * @param completionHandler the handler to be called when the stream is completed or fails
+             * @param streamID the ID of the stream, as expected by the remote peer
+             * @return <code>true</code>, if the stream was accepted (the completion handler is called only in this case)
+             */
+            bool sendStream(
+                const DeviceID deviceID, const ConnectionID connectionID,
+                PoolInputStreamPtr source, StreamCompletionHandler completionHandler,
+                const StreamID streamID = DEFAULT_STREAM_ID);
+            
+            /**
+             * Prepares the specified connection for receiving a stream of chunks from the specified device.
+             * 
+             * Notes:
+             * - The data of each chunk is written directly to the sink of the stream with the chunk's ID
+             * and <code>onDataReceived</code> is not fired for it; regular data received while the stream
+             * is active is delivered as usual.
+             * - Up to <code>maxStreamsPerConnection</code> incoming streams, with different IDs, can be
+             * active on a connection.
+             * - The remote peer is granted <code>maxStreamChunksInFlight</code> credits for the stream, which
+             * are replenished as its chunks are processed.
+             * - The stream fails (without affecting the connection) if the remote peer aborts it or if an invalid
+             * chunk is received for it; in the latter case, the remote peer is notified that the stream was rejected.
+             * - Chunks for unknown streams are discarded.
+             * 
+             * @param deviceID the ID of the device sending the stream
+             * @param connectionID connection ID
+             * @param sink the sink the received data is to be written to
+             * @param maxSize the maximum number of bytes that can be received
+             * @param completionHandler the handler to be called when the stream is completed or fails
+             * @param streamID the ID of the stream, as used by the remote peer
+             * @return <code>true</code>, if the connection is ready to receive the stream
+             */
+            bool receiveStream(
+                const DeviceID deviceID, const ConnectionID connectionID,
+                StreamSink sink, DataSize maxSize, StreamCompletionHandler completionHandler,
+                const StreamID streamID = DEFAULT_STREAM_ID);
+            
+            /**
+             * Prepares the specified connection for receiving a stream of chunks from the specified device
+             * and writing it to the supplied pool stream.
+             * 
+             * See <code>receiveStream(const DeviceID, const ConnectionID, StreamSink, DataSize, StreamCompletionHandler, const StreamID)</code>.
+             * 
+             * Note: The pool stream is flushed before the completion handler is called.
+             * 
+             * @param deviceID the ID of the device sending the stream
+             * @param connectionID connection ID
+             * @param target the stream to write the data to (kept until the transfer is completed)
+             * @param completionHandler the handler to be called when the stream is completed or fails
+             * @param streamID the ID of the stream, as used by the remote peer
+             * @return <code>true</code>, if the connection is ready to receive the stream
+             */
+            bool receiveStream(
+                const DeviceID deviceID, const ConnectionID connectionID,
+                PoolOutputStreamPtr target, StreamCompletionHandler completionHandler,
+                const StreamID streamID = DEFAULT_STREAM_ID);
+            
             /**
              * Closes the specified connection for the specified device.
              * 
@@ -193,6 +382,13 @@ namespace NetworkManagement_Handlers
              */
             void closeConnection(const DeviceID deviceID, const ConnectionID connectionID);
             
+            /**
+             * Retrieves the data processing pipeline (for its queue and stage timing statistics).
+             * 
+             * @return the pipeline, or an empty pointer, if data is processed on the network threads
+             */
+            DataPipelinePtr getDataPipeline() const { return pipeline; }
+            
             /**
              * Attaches the supplied handler to the <code>onConnectionEstablished</code> event.
              * 
@@ -261,6 +457,64 @@ namespace NetworkManagement_Handlers
             }
             
         private:
+            /** Structure for holding outgoing data stream state. */
+            struct OutgoingStream
+            {
+                /** Stream ID. */
+                StreamID streamID;
+                /** Data source. */
+                StreamSource source;
+                /** Completion handler. */
+                StreamCompletionHandler completionHandler;
+                /** Sequence number of the next chunk. */
+                StreamChunkSequence nextSequence;
+                /** Number of chunks queued on the connection. */
+                unsigned int chunksInFlight;
+                /** Number of chunks the remote peer allows to be sent (the stream's window). */
+                StreamCredits credits;
+                /** Number of plaintext bytes read from the source. */
+                DataSize bytesRead;
+                /** Denotes whether the source has no more data. */
+                bool sourceExhausted;
+                /** Denotes whether the last chunk has been queued. */
+                bool lastChunkQueued;
+                /** Denotes whether the stream has failed (no more chunks are queued). */
+                bool failed;
+                /** Denotes whether the stream was rejected by the remote peer (no abort notification is sent). */
+                bool rejected;
+                /** Current plaintext chunk (buffer reused for all chunks). */
+                ByteData currentChunk;
+                /** Next plaintext chunk (read ahead, to detect the end of the stream). */
+                ByteData nextChunk;
+            };
+            typedef boost::shared_ptr<OutgoingStream> OutgoingStreamPtr;
+            
+            /** Structure for holding incoming data stream state. */
+            struct IncomingStream
+            {
+                /** Stream ID. */
+                StreamID streamID;
+                /** Data sink. */
+                StreamSink sink;
+                /** Completion handler. */
+                StreamCompletionHandler completionHandler;
+                /** Maximum number of bytes that can be received. */
+                DataSize maxSize;
+                /** Expected sequence number of the next chunk. */
+                StreamChunkSequence nextSequence;
+                /** Number of plaintext bytes written to the sink. */
+                DataSize bytesWritten;
+                /** Denotes whether the last chunk has been received. */
+                bool lastChunkReceived;
+                /** Denotes whether the stream was aborted by the remote peer. */
+                bool aborted;
+                /** Denotes whether an invalid chunk was received for the stream (the remote peer is notified). */
+                bool rejected;
+                /** Number of chunks processed since the last window update. */
+                StreamCredits processedChunks;
+            };
+            typedef boost::shared_ptr<IncomingStream> IncomingStreamPtr;
+            
             /** Structure for holding connection data. */
             struct ConnectionData
             {
@@ -282,14 +536,30 @@ namespace NetworkManagement_Handlers
                 bool compressionEnabled;
                 /** Pointer to the last pending data received (if any). */
                 ByteData lastPendingReceivedData;
-                /** Queue of pointer to data awaiting to receive send confirmations. */
-                std::queue<const MixedData *> pendingSentData;
+                /** Queue of data awaiting to receive send confirmations (and the stream of each chunk; empty for regular data). */
+                std::queue<std::pair<ByteDataPtr, OutgoingStreamPtr>> pendingSentData;
                 /** 'onDataReceived' event handler connection. */
                 boost::signals2::connection onDataReceivedEventConnection;
                 /** 'onDisconnect' event handler connection. */
                 boost::signals2::connection onDisconnectEventConnection;
                 /** 'onWriteResultReceived' event handler connection. */
                 boost::signals2::connection onWriteResultReceivedEventConnection;
+                /** 'onFlowControl' event handler connection. */
+                boost::signals2::connection onFlowControlEventConnection;
+                /** Outgoing data streams (ordered by ID, for interleaving their chunks). */
+                std::map<StreamID, OutgoingStreamPtr> outgoingStreams;
+                /** ID of the first outgoing stream to be considered in the next chunk interleaving round. */
+                StreamID nextOutgoingStreamID;
+                /** Processed chunk that could not be queued because the connection's write queue was full (and its stream; if any). */
+                std::pair<ByteDataPtr, OutgoingStreamPtr> blockedStreamChunk;
+                /** Incoming data streams. */
+                boost::unordered_map<StreamID, IncomingStreamPtr> incomingStreams;
+                /** Credits granted by the remote peer for outgoing streams that have not been started yet. */
+                boost::unordered_map<StreamID, StreamCredits> pendingStreamCredits;
+                /** Window updates that could not be queued because the connection's write queue was full. */
+                std::queue<ByteDataPtr> blockedWindowUpdates;
+                /** Compression ratios recently achieved on the connection. */
+                AdaptiveCompressionPolicy::History compressionHistory;
                 /** Connection data mutex. */
                 boost::mutex connectionDataMutex;
             };
@@ -298,6 +568,7 @@ namespace NetworkManagement_Handlers
             Utilities::FileLoggerPtr debugLogger;                                //logger for debugging
             std::function<void (LogSeverity, const std::string &)> dbLogHandler; //database log handler
             CompressionHandler compressor;                                       //data compression handler
+            AdaptiveCompressionPolicy compressionPolicy;                         //decides which payloads are compressed
             std::function<PendingDataConnectionConfigPtr (const DeviceID, const TransientConnectionID)> deviceConfigRetrievalHandler;
             std::function<const LocalPeerAuthenticationEntry & (const DeviceID &)> authenticationDataRetrievalHandler;
             
@@ -306,6 +577,10 @@ namespace NetworkManagement_Handlers
             DeviceID localPeerID;                   //default local peer ID
             RandomDataSize requestSignatureSize;    //default connection request signature size (in bytes)
             BufferSize maxDataSize;                 //maximum amount of data that can be processed (sent/received)
+            BufferSize streamChunkSize;             //size of the plaintext chunks of outgoing data streams
+            unsigned int maxStreamChunksInFlight;   //maximum number of queued chunks per outgoing data stream
+            unsigned int maxStreamsPerConnection;   //maximum number of active data streams per connection (in each direction)
+            DataPipelinePtr pipeline;               //data processing workers (if used)
             
             boost::mutex connectionDataMutex;
             boost::unordered_map<DeviceID, boost::unordered_map<ConnectionID, ConnectionDataPtr>> activeConnections;
@@ -321,11 +596,34 @@ namespace NetworkManagement_Handlers
             std::atomic<StatCounter> sendRequestsMade{0};           //outgoing data
             std::atomic<StatCounter> sendRequestsConfirmed{0};      //outgoing data
             std::atomic<StatCounter> sendRequestsFailed{0};         //outgoing data
+            std::atomic<StatCounter> sendRequestsRejected{0};       //outgoing data (write queue was full)
+            std::atomic<StatCounter> writeQueueBlocks{0};           //number of times a connection's write queue became full
+            std::atomic<StatCounter> readQueuePauses{0};            //number of times a connection's reading was paused
             std::atomic<StatCounter> totalDataObjectsReceived{0};   //incoming data
             std::atomic<StatCounter> validDataObjectsReceived{0};   //incoming data
             std::atomic<StatCounter> invalidDataObjectsReceived{0}; //incoming data
             std::atomic<StatCounter> connectionsEstablished{0};     //number of connections successfully established
             std::atomic<StatCounter> connectionsFailed{0};          //number of connections that could not be established
+            std::atomic<StatCounter> streamsSent{0};                //outgoing data streams
+            std::atomic<StatCounter> streamsReceived{0};            //incoming data streams
+            std::atomic<StatCounter> streamsFailed{0};              //outgoing and incoming data streams
+            std::atomic<StatCounter> streamChunksSent{0};           //outgoing data stream chunks
+            std::atomic<StatCounter> streamChunksReceived{0};       //incoming data stream chunks
+            std::atomic<StatCounter> streamsAborted{0};             //outgoing and incoming data streams abandoned without terminating the connection
+            std::atomic<StatCounter> streamWindowUpdatesSent{0};    //credits granted for incoming data streams (and rejections)
+            std::atomic<StatCounter> compressionSkippedBytes{0};    //outgoing data sent uncompressed, with compression enabled
+            std::atomic<StatCounter> compressionSavedBytes{0};      //outgoing data removed by compression
+            
+            /** Trailing byte of payloads sent uncompressed, on connections with compression enabled. */
+            static const char COMPRESSION_MARKER_NONE = 0x00;
+            /** Trailing byte of compressed payloads. */
+            static const char COMPRESSION_MARKER_LZ4 = 0x01;
+            /** Length of the frame type that precedes every message on an established connection. */
+            static const std::size_t FRAME_TYPE_LENGTH = 1;
+            /** Length of the frame type and header that precede the data of every stream chunk. */
+            static const std::size_t STREAM_CHUNK_PREFIX_LENGTH = FRAME_TYPE_LENGTH + StreamChunkHeader::BYTE_LENGTH;
+            /** Length of a stream window update message (frame type and update). */
+            static const std::size_t STREAM_WINDOW_UPDATE_LENGTH = FRAME_TYPE_LENGTH + StreamWindowUpdate::BYTE_LENGTH;
             
             /**
              * Creates a new connection data object based on the supplied data.
@@ -472,7 +770,7 @@ namespace NetworkManagement_Handlers
              * @param connectionID associated connection ID
              */
             void onDataReceivedHandler_PendingLocalConnections(
-                ByteData data, PacketSize remaining, const DeviceID deviceID,
+                const BufferView & data, PacketSize remaining, const DeviceID deviceID,
                 const ConnectionID connectionID);
             
             /**
@@ -502,7 +800,7 @@ namespace NetworkManagement_Handlers
              * @param connectionID associated connection ID
              */
             void onDataReceivedHandler_PendingRemoteConnections(
-                ByteData data, PacketSize remaining, const ConnectionID connectionID);
+                const BufferView & data, PacketSize remaining, const ConnectionID connectionID);
             
             /**
              * 'onWriteResultReceived' event handler for pending remote connections.
@@ -534,9 +832,39 @@ namespace NetworkManagement_Handlers
              * @param connectionID associated connection ID
              */
             void onDataReceivedHandler_EstablishedConnections(
-                ByteData data, PacketSize remaining, const DeviceID deviceID,
+                const BufferView & data, PacketSize remaining, const DeviceID deviceID,
                 const ConnectionID connectionID);
             
+            /**
+             * Processes data received on an established connection (assembles, decrypts and/or
+             * decompresses it and fires <code>onDataReceived</code>, or writes it to the incoming stream).
+             * 
+             * Note: Called by the pipeline workers, if they are used, or by the network threads.
+             * 
+             * @param data received data
+             * @param remaining remaining data
+             * @param deviceID associated device ID
+             * @param connectionID associated connection ID
+             */
+            void processReceivedData(
+                const BufferView & data, PacketSize remaining, const DeviceID deviceID,
+                const ConnectionID connectionID);
+            
+            /**
+             * Processes data received on an established connection, on a pipeline worker,
+             * and releases it from the connection's read queue, when done.
+             * 
+             * @param data received data
+             * @param remaining remaining data
+             * @param deviceID associated device ID
+             * @param connectionID associated connection ID
+             * @param connection the connection the data was received on
+             * @param readingPaused denotes whether the data keeps reading from the connection paused
+             */
+            void processPipelinedReceivedData(
+                const BufferView & data, PacketSize remaining, const DeviceID deviceID,
+                const ConnectionID connectionID, ConnectionPtr connection, bool readingPaused);
+            
             /**
              * 'onWriteResultReceived' event handler for established connections.
              * 
@@ -547,6 +875,161 @@ namespace NetworkManagement_Handlers
             void onWriteResultReceivedHandler_EstablishedConnections(
                 bool received, const DeviceID deviceID, const ConnectionID connectionID);
             
+            /**
+             * 'onFlowControl' event handler for established connections.
+             * 
+             * @param event the watermark crossing that occurred
+             * @param deviceID associated device ID
+             * @param connectionID associated connection ID
+             */
+            void onFlowControlHandler_EstablishedConnections(
+                FlowControlEvent event, const DeviceID deviceID, const ConnectionID connectionID);
+            
+            /**
+             * Compresses and/or encrypts the supplied data and queues it on the specified connection.
+             * 
+             * Note: Called by the pipeline workers, if they are used, or by <code>sendData()</code>.
+             * 
+             * @param connectionData the connection data
+             * @param deviceID the ID of the device to send the data to
+             * @param connectionID connection ID
+             * @param plaintextData the plaintext data to be encrypted and/or compressed and sent
+             * @return <code>true</code>, if the data was queued on the connection
+             */
+            bool processOutgoingData(
+                ConnectionDataPtr connectionData, const DeviceID deviceID, const ConnectionID connectionID,
+                const PlaintextData & plaintextData);
+            
+            /**
+             * Compresses the supplied payload, unless the compression policy advises against it
+             * or the compressed payload is not smaller than the original.
+             * 
+             * Note: Expects the caller to have exclusive access to the connection's compression history.
+             * 
+             * @param connectionData the connection data
+             * @param payload the payload to be compressed
+             * @param compressedData the compressed payload (set only if <code>true</code> is returned)
+             * @return <code>true</code>, if the payload was compressed
+             */
+            bool compressPayload(ConnectionDataPtr connectionData, const ByteData & payload, ByteData & compressedData);
+            
+            /**
+             * Queues the next chunks of the outgoing streams of the supplied connection, one chunk of each
+             * stream at a time, until the streams' windows or the connection's write queue are full, and
+             * completes or fails the streams, when appropriate.
+             * 
+             * Note: Does nothing if there are no active outgoing streams on the connection.
+             * 
+             * @param connectionData the connection data
+             * @param deviceID associated device ID
+             * @param connectionID associated connection ID
+             */
+            void continueStreams(
+                ConnectionDataPtr connectionData, const DeviceID deviceID, const ConnectionID connectionID);
+            
+            /**
+             * Continues the outgoing streams of the supplied connection, on the pipeline
+             * workers (if they are used) or on the calling thread.
+             * 
+             * Note: Expects the connection data mutex to NOT be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @param deviceID associated device ID
+             * @param connectionID associated connection ID
+             */
+            void scheduleStreamsContinuation(
+                ConnectionDataPtr connectionData, const DeviceID deviceID, const ConnectionID connectionID);
+            
+            /**
+             * Queues the stream chunk that was previously rejected by the connection, if any.
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @return <code>true</code>, if there is no blocked chunk left
+             */
+            bool queueBlockedStreamChunk(ConnectionDataPtr connectionData);
+            
+            /**
+             * Reads, processes and queues the next chunk of the supplied outgoing stream (reading
+             * its first chunk, if none was queued yet).
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @param stream the outgoing stream
+             * @return <code>true</code>, if the chunk was queued or <code>false</code>,
+             * if it was blocked because the connection's write queue is full
+             * @throw runtime_error if the stream source fails
+             */
+            bool queueStreamChunk(ConnectionDataPtr connectionData, OutgoingStreamPtr stream);
+            
+            /**
+             * Queues a notification for the remote peer that the supplied outgoing stream was abandoned.
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @param stream the failed outgoing stream
+             * @return <code>true</code>, if the notification was queued
+             */
+            bool queueStreamAbort(ConnectionDataPtr connectionData, OutgoingStreamPtr stream);
+            
+            /**
+             * Queues the supplied window update for the remote peer or keeps it until the
+             * connection's write queue has space.
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @param update the window update to be sent
+             */
+            void queueStreamWindowUpdate(ConnectionDataPtr connectionData, const StreamWindowUpdate & update);
+            
+            /**
+             * Queues the window updates that were previously rejected by the connection, if any.
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             */
+            void queueBlockedStreamWindowUpdates(ConnectionDataPtr connectionData);
+            
+            /**
+             * Applies the supplied window update, received from the remote peer, to the outgoing
+             * stream it is for (or keeps its credits until the stream is started).
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @param update the received window update
+             * @return <code>true</code>, if an active outgoing stream was updated (and needs to be continued)
+             * @throw runtime_error if the remote peer grants credits for too many streams that were not started
+             */
+            bool applyStreamWindowUpdate(ConnectionDataPtr connectionData, const StreamWindowUpdate & update);
+            
+            /**
+             * Reads the next plaintext chunk of the supplied outgoing stream from its source.
+             * 
+             * @param stream the outgoing stream
+             * @throw runtime_error if the stream source fails
+             */
+            void readStreamChunk(OutgoingStreamPtr stream);
+            
+            /**
+             * Verifies, decrypts and/or decompresses the supplied stream chunk and writes its data
+             * to the incoming stream of the supplied connection that has the chunk's stream ID.
+             * 
+             * Note: Expects the connection data mutex to be held by the caller.
+             * 
+             * @param connectionData the connection data
+             * @param chunkData the received chunk (frame type, header and data)
+             * @return the stream the chunk belongs to (with its last chunk, abort or rejection state updated)
+             * or an empty pointer, if the stream is unknown
+             * @throw invalid_argument if the chunk header is not valid
+             */
+            IncomingStreamPtr processStreamChunk(ConnectionDataPtr connectionData, const ByteData & chunkData);
+            
             /**
              * Terminates the specified connection for the specified device and
              * discards all associated data.
@@ -713,7 +713,7 @@ void NetworkManagement_Handlers::InitialConnectionsHandler::onDisconnectHandler_
 }
 
 void NetworkManagement_Handlers::InitialConnectionsHandler::onDataReceivedHandler_PendingLocalConnections
-(ByteData data, PacketSize remaining, const ConnectionID connectionID, const TransientConnectionID transientID)
+(const BufferView & data, PacketSize remaining, const ConnectionID connectionID, const TransientConnectionID transientID)
 {
     if(!active)
         return;
@@ -762,7 +762,7 @@ void NetworkManagement_Handlers::InitialConnectionsHandler::onDataReceivedHandle
 
             connectionData->state = ConnectionSetupState::CONNECTION_RESPONSE_RECEIVED;
 
-            verifyConnectionResponseData(data, connectionData);
+            verifyConnectionResponseData(data.toByteData(), connectionData);
             connectionData->state = ConnectionSetupState::COMPLETED;
         }
 
@@ -892,7 +892,7 @@ void NetworkManagement_Handlers::InitialConnectionsHandler::onDisconnectHandler_
 }
 
 void NetworkManagement_Handlers::InitialConnectionsHandler::onDataReceivedHandler_PendingRemoteConnections
-(ByteData data, PacketSize remaining, const ConnectionID connectionID)
+(const BufferView & data, PacketSize remaining, const ConnectionID connectionID)
 {
     if(!active)
         return;
@@ -911,7 +911,7 @@ void NetworkManagement_Handlers::InitialConnectionsHandler::onDataReceivedHandle
         }
 
         //generates and send a connection response
-        MixedData * responseData = generateConnectionResponseDataFromRequest(data, connectionID);
+        MixedData * responseData = generateConnectionResponseDataFromRequest(data.toByteData(), connectionID);
         UnknownConnectionDataPtr connectionData = getUnknownConnectionData(connectionID);
 
         boost::lock_guard<boost::mutex> dataLock(connectionData->connectionDataMutex);
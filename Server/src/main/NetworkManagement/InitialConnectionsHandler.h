@@ -454,7 +454,7 @@ namespace NetworkManagement_Handlers
              * @param transientID associated transient ID
              */
             void onDataReceivedHandler_PendingLocalConnections(
-                ByteData data, PacketSize remaining, const ConnectionID connectionID,
+                const BufferView & data, PacketSize remaining, const ConnectionID connectionID,
                 const TransientConnectionID transientID);
             
             /**
@@ -486,7 +486,7 @@ namespace NetworkManagement_Handlers
              * @param connectionID associated connection ID
              */
             void onDataReceivedHandler_PendingRemoteConnections(
-                ByteData data, PacketSize remaining, const ConnectionID connectionID);
+                const BufferView & data, PacketSize remaining, const ConnectionID connectionID);
             
             /**
              * 'onWriteResultReceived' event handler for pending remote connections.
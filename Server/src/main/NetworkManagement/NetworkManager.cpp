@@ -74,9 +74,13 @@ SyncServer_Core::NetworkManager::NetworkManager
   pendingConnectionDataDiscardTimeout(params.pendingConnectionDataDiscardTimeout),
   expectedDataConnectionTimeout(params.expectedDataConnectionTimeout),
   expectedInitConnectionTimeout(params.expectedInitConnectionTimeout),
+  commandSocketOptions(params.commandSocketOptions),
+  dataSocketOptions(params.dataSocketOptions),
+  initSocketOptions(params.initSocketOptions),
   dataSent(0),
   dataReceived(0),
   commandsSent(0),
+  commandsRejected(0),
   commandsReceived(0),
   connectionsInitiated(0),
   connectionsReceived(0),
@@ -96,6 +100,9 @@ SyncServer_Core::NetworkManager::NetworkManager
     onCommandConnectionEstablishmentFailedEventConnection =
             commandConnections.onConnectionEstablishmentFailedEventAttach(
                 boost::bind(&NetworkManager::onCommandConnectionEstablishmentFailedHandler, this, _1, _2));
+    onCommandConnectionWriteQueueReadyEventConnection =
+            commandConnections.onWriteQueueReadyEventAttach(
+                boost::bind(&NetworkManager::onCommandConnectionWriteQueueReadyHandler, this, _1));
 
     onDataReceivedEventConnection =
             dataConnections.onDataReceivedEventAttach(
@@ -120,6 +127,7 @@ SyncServer_Core::NetworkManager::~NetworkManager()
     onCommandDataReceivedEventConnection.disconnect();
     onCommandConnectionEstablishedEventConnection.disconnect();
     onCommandConnectionEstablishmentFailedEventConnection.disconnect();
+    onCommandConnectionWriteQueueReadyEventConnection.disconnect();
     onDataReceivedEventConnection.disconnect();
     onDataConnectionEstablishedEventConnection.disconnect();
     onDataConnectionEstablishmentFailedEventConnection.disconnect();
@@ -380,11 +388,12 @@ ConnectionManagerID SyncServer_Core::NetworkManager::startConnectionManager
 {
     boost::lock_guard<boost::mutex> connectionManagementLock(connectionManagementDataMutex);
     boost::unordered_map<ConnectionManagerID, ConnectionManagerPtr> * managers = nullptr;
+    const ConnectionManager::SocketOptions * defaultSocketOptions = nullptr;
     switch(params.managerType)
     {
-        case ConnectionType::COMMAND: managers = &commandConnectionManagers; break;
-        case ConnectionType::DATA: managers = &dataConnectionManagers; break;
-        case ConnectionType::INIT: managers = &initConnectionManagers; break;
+        case ConnectionType::COMMAND: managers = &commandConnectionManagers; defaultSocketOptions = &commandSocketOptions; break;
+        case ConnectionType::DATA: managers = &dataConnectionManagers; defaultSocketOptions = &dataSocketOptions; break;
+        case ConnectionType::INIT: managers = &initConnectionManagers; defaultSocketOptions = &initSocketOptions; break;
         default: throw std::logic_error("NetworkManager::startConnectionManager() >"
                 " Unexpected manager type encountered [" + Convert::toString(params.managerType) + "].");
     }
@@ -401,6 +410,9 @@ ConnectionManagerID SyncServer_Core::NetworkManager::startConnectionManager
         }
     }
 
+    if(!params.socketOptions.isSet())
+        params.socketOptions = *defaultSocketOptions;
+
     ConnectionManagerID managerID = ++lastManagerID;
     ConnectionManagerPtr newManager(new ConnectionManager(params, debugLogger));
     newManager->onConnectionCreatedEventAttach(
@@ -474,7 +486,7 @@ void SyncServer_Core::NetworkManager::stopDataConnectionManager(ConnectionManage
 }
 //</editor-fold>
 
-void SyncServer_Core::NetworkManager::sendInstruction
+bool SyncServer_Core::NetworkManager::sendInstruction
 (const ConnectionManagerID managerID, const DeviceID device, const InstructionBasePtr instruction)
 {
     bool isConnectionAvailable = false;
@@ -483,7 +495,14 @@ void SyncServer_Core::NetworkManager::sendInstruction
     {
         boost::lock_guard<boost::mutex> activeCommandConnectionsLock(activeCommandConnectionsMutex);
         auto activeConnection = activeCommandConnections.find(device);
-        if(activeConnection != activeCommandConnections.end())
+        auto pendingDataQueue = pendingDeviceInstructions.find(device);
+        if(activeConnection != activeCommandConnections.end() && pendingDataQueue != pendingDeviceInstructions.end())
+        {
+            //older commands are still waiting for the write queue to drain; keeps the commands in order
+            pendingDataQueue->second.push_back(instruction);
+            return true;
+        }
+        else if(activeConnection != activeCommandConnections.end())
         {
             boost::lock_guard<boost::mutex> connectionDataLock(activeConnection->second->dataMutex);
             ++activeConnection->second->eventsCounter;
@@ -492,7 +511,6 @@ void SyncServer_Core::NetworkManager::sendInstruction
         }
         else
         {
-            auto pendingDataQueue = pendingDeviceInstructions.find(device);
             if(pendingDataQueue != pendingDeviceInstructions.end())
             {
                 pendingDataQueue->second.push_back(instruction);
@@ -513,7 +531,16 @@ void SyncServer_Core::NetworkManager::sendInstruction
         const CommandConverter::CommandData commandData =
             converter.serializeCommand(instruction, device, newCommandID);
         
-        commandConnections.sendData(device, commandData.serializedData);
+        if(!commandConnections.sendData(device, commandData.serializedData))
+        {
+            ++commandsRejected;
+            logMessage(LogSeverity::Warning, "(sendInstruction) >"
+                    " Command [" + Convert::toString(newCommandID) + "] for device ["
+                    + Convert::toString(device) + "] discarded; the connection's write queue is full.");
+            
+            return false;
+        }
+        
         ++commandsSent;
     }
     else if(!dataStore.isCommandConnectionDataAvailable(device))
@@ -523,6 +550,8 @@ void SyncServer_Core::NetworkManager::sendInstruction
                 boost::bind(&NetworkManager::pendingDeviceInstructionsDiscardTimeoutHandler, this, device),
                 pendingConnectionDataDiscardTimeout);
     }
+    
+    return true;
 }
 
 //<editor-fold defaultstate="collapsed" desc="Handlers - Connection Setup">
@@ -677,7 +706,12 @@ void SyncServer_Core::NetworkManager::enqueueRemoteInstructionResultProcessing
     auto resultProcessingFunction = [this, deviceID, responseSerializationFunction]()
     {
         const PlaintextData responseData = responseSerializationFunction();
-        commandConnections.sendData(deviceID, responseData);
+        if(!commandConnections.sendData(deviceID, responseData))
+        {
+            logMessage(LogSeverity::Warning, "(enqueueRemoteInstructionResultProcessing) >"
+                    " Instruction result for device [" + Convert::toString(deviceID)
+                    + "] discarded; the connection's write queue is full.");
+        }
     };
 
     instructionsThreadPool.assignTask(resultProcessingFunction);
@@ -890,25 +924,55 @@ void SyncServer_Core::NetworkManager::onCommandConnectionEstablishedHandler
                 " Failed to discard pending data for device [" + Convert::toString(deviceID) + "].");
     }
 
+    sendPendingInstructions(deviceID, connectionData);
+}
+
+void SyncServer_Core::NetworkManager::onCommandConnectionWriteQueueReadyHandler
+(const DeviceID deviceID)
+{
+    boost::lock_guard<boost::mutex> activeCommandConnectionsLock(activeCommandConnectionsMutex);
+    auto activeConnection = activeCommandConnections.find(deviceID);
+    if(activeConnection != activeCommandConnections.end())
+        sendPendingInstructions(deviceID, activeConnection->second);
+}
+
+void SyncServer_Core::NetworkManager::sendPendingInstructions
+(const DeviceID deviceID, ActiveConnectionDataPtr connectionData)
+{
     auto pendingInstructions = pendingDeviceInstructions.find(deviceID);
-    if(pendingInstructions != pendingDeviceInstructions.end())
+    if(pendingInstructions == pendingDeviceInstructions.end())
+        return;
+    
+    boost::lock_guard<boost::mutex> connectionDataLock(connectionData->dataMutex);
+    std::deque<InstructionBasePtr> & instructionQueue = pendingInstructions->second;
+    while(!instructionQueue.empty())
     {
-        for(auto currentInstruction : pendingInstructions->second)
+        InstructionBasePtr currentInstruction = instructionQueue.front();
+        CommandID newCommandID = ++connectionData->lastCommandID;
+        
+        const CommandConverter::CommandData commandData =
+            converter.serializeCommand(currentInstruction, deviceID, newCommandID);
+        
+        //the write queue stays full until it is drained, so no other command would be sent either;
+        //the rest are sent when the connection reports that its write queue is low again
+        if(!commandConnections.sendData(deviceID, commandData.serializedData))
         {
-            CommandID newCommandID = ++connectionData->lastCommandID;
+            logMessage(LogSeverity::Debug, "(sendPendingInstructions) >"
+                    " Holding [" + Convert::toString(instructionQueue.size())
+                    + "] pending commands for device [" + Convert::toString(deviceID)
+                    + "]; the connection's write queue is full.");
             
-            const CommandConverter::CommandData commandData =
-                converter.serializeCommand(currentInstruction, deviceID, newCommandID);
-            
-            connectionData->pendingInstructions.insert(
-                std::pair<CommandID, InstructionBasePtr>(newCommandID, currentInstruction));
-            
-            commandConnections.sendData(deviceID, commandData.serializedData);
-            ++commandsSent;
+            return;
         }
-
-        pendingDeviceInstructions.erase(pendingInstructions);
+        
+        connectionData->pendingInstructions.insert(
+            std::pair<CommandID, InstructionBasePtr>(newCommandID, currentInstruction));
+        
+        instructionQueue.pop_front();
+        ++commandsSent;
     }
+    
+    pendingDeviceInstructions.erase(pendingInstructions);
 }
 
 void SyncServer_Core::NetworkManager::onCommandConnectionEstablishmentFailedHandler
@@ -266,6 +266,12 @@ namespace SyncServer_Core
                 Seconds expectedDataConnectionTimeout;
                 /** Time to wait for an 'INIT' connection setup to be initiated (in seconds). */
                 Seconds expectedInitConnectionTimeout;
+                /** Default TCP options for 'COMMAND' connections (all 0 = system defaults). */
+                ConnectionManager::SocketOptions commandSocketOptions;
+                /** Default TCP options for 'DATA' connections (all 0 = system defaults). */
+                ConnectionManager::SocketOptions dataSocketOptions;
+                /** Default TCP options for 'INIT' connections (all 0 = system defaults). */
+                ConnectionManager::SocketOptions initSocketOptions;
             };
             
             /**
@@ -346,6 +352,9 @@ namespace SyncServer_Core
             /**
              * Starts a new connection manager with the supplied parameters.
              * 
+             * Note: If no socket options are supplied, the manager uses the
+             * default options for its connection type.
+             * 
              * @param params the new connection manager configuration
              * @return the ID associated with the new manager
              */
@@ -385,12 +394,17 @@ namespace SyncServer_Core
              * Sends the supplied instruction to the specified device using
              * the specified manager.
              * 
+             * Note: If a command connection is active and its write queue is full,
+             * the instruction is discarded and is not sent.
+             * 
              * @param managerID the manager to use for the connection
              *                  (if no connection is active)
              * @param device the ID of the target device
              * @param instruction the instruction to be sent
+             * @return <code>true</code>, if the instruction was sent or queued until a connection is established;
+             * <code>false</code>, if it was rejected by the command connection
              */
-            void sendInstruction(
+            bool sendInstruction(
                 const ConnectionManagerID managerID, const DeviceID device,
                 const InstructionBasePtr instruction);
             
@@ -426,6 +440,7 @@ namespace SyncServer_Core
             
             StatCounter getCommandsReceived() const         { return commandsReceived; }
             StatCounter getCommandsSent() const             { return commandsSent; }
+            StatCounter getCommandsRejected() const         { return commandsRejected; }
             StatCounter getConnectionsInitiated() const     { return connectionsInitiated; }
             StatCounter getConnectionsReceived() const      { return connectionsReceived; }
             StatCounter getDataReceived() const             { return dataReceived; }
@@ -477,6 +492,7 @@ namespace SyncServer_Core
             boost::signals2::connection onCommandDataReceivedEventConnection;
             boost::signals2::connection onCommandConnectionEstablishedEventConnection;
             boost::signals2::connection onCommandConnectionEstablishmentFailedEventConnection;
+            boost::signals2::connection onCommandConnectionWriteQueueReadyEventConnection;
             boost::signals2::connection onDataReceivedEventConnection;
             boost::signals2::connection onDataConnectionEstablishedEventConnection;
             boost::signals2::connection onDataConnectionEstablishmentFailedEventConnection;
@@ -497,10 +513,16 @@ namespace SyncServer_Core
             Seconds expectedDataConnectionTimeout;
             Seconds expectedInitConnectionTimeout;
             
+            //Socket Settings
+            ConnectionManager::SocketOptions commandSocketOptions;
+            ConnectionManager::SocketOptions dataSocketOptions;
+            ConnectionManager::SocketOptions initSocketOptions;
+            
             //Stats
             std::atomic<StatCounter> dataSent;
             std::atomic<StatCounter> dataReceived;
             std::atomic<StatCounter> commandsSent;
+            std::atomic<StatCounter> commandsRejected;
             std::atomic<StatCounter> commandsReceived;
             std::atomic<StatCounter> connectionsInitiated;
             std::atomic<StatCounter> connectionsReceived;
@@ -701,6 +723,28 @@ namespace SyncServer_Core
             void onCommandConnectionEstablishmentFailedHandler(
                 const DeviceID deviceID, const ConnectionID connectionID);
             
+            /**
+             * Event handler for 'COMMAND' connections whose write queue can accept data again.
+             * 
+             * Sends any pending instructions held back while the write queue was full.
+             * 
+             * @param deviceID the ID of the device associated with the connection
+             */
+            void onCommandConnectionWriteQueueReadyHandler(const DeviceID deviceID);
+            
+            /**
+             * Sends the pending instructions of the specified device over its 'COMMAND' connection,
+             * in order, until they are all sent or the connection's write queue is full.
+             * 
+             * Instructions that cannot be sent are kept for the next attempt.
+             * 
+             * Note: Requires the active command connections mutex to be held by the caller.
+             * 
+             * @param deviceID the ID of the device
+             * @param connectionData the device's active 'COMMAND' connection data
+             */
+            void sendPendingInstructions(const DeviceID deviceID, ActiveConnectionDataPtr connectionData);
+            
             /**
              * Event handler for processing established 'DATA' connections.
              * 
@@ -18,12 +18,16 @@
 #ifndef PACKETS_H
 #define	PACKETS_H
 
+#include <cstring>
 #include <stdexcept>
 #include "Types.h"
 
 using Common_Types::Byte;
 using Common_Types::ByteData;
 using NetworkManagement_Types::PacketSize;
+using NetworkManagement_Types::StreamChunkSequence;
+using NetworkManagement_Types::StreamCredits;
+using NetworkManagement_Types::StreamID;
 
 namespace NetworkManagement_Types
 {
@@ -187,6 +191,30 @@ namespace NetworkManagement_Types
                 
                 return result;
             }
+            
+            /**
+             * Attempts to convert the supplied raw bytes to a <code>HeaderPacket</code> object.
+             * 
+             * Note: Network byte order is expected for the input data.
+             * 
+             * @param data bytes to be converted
+             * @param size the number of bytes to be converted
+             * @return the newly built object
+             * @throws <code>std::invalid_argument</code>, if the supplied data cannot be converted
+             */
+            static HeaderPacket fromNetworkBytes(const Byte * data, std::size_t size)
+            {
+                if(HeaderPacket::BYTE_LENGTH != size)
+                    throw std::invalid_argument("HeaderPacket::fromNetworkBytes() > Unexpected data length encountered.");
+                
+                PacketSize nPayloadSize;
+                std::memcpy(&nPayloadSize, data, HeaderPacket::BYTE_LENGTH);
+                
+                HeaderPacket result;
+                result.payloadSize = ntohl(nPayloadSize);
+                
+                return result;
+            }
 
             /**
              * Converts the header to bytes.
@@ -238,6 +266,201 @@ namespace NetworkManagement_Types
                 
                 assert(target.size() == HeaderPacket::BYTE_LENGTH);
             }
+
+            /**
+             * Converts the header to bytes and places the result in the supplied raw buffer.
+             *
+             * Note: Network byte order is used for the output data.
+             *
+             * @param target the buffer to be used for storing the result (must hold at least <code>BYTE_LENGTH</code> bytes)
+             * @throws <code>std::invalid_argument</code>, if the conversion cannot be done
+             */
+            void toNetworkBytes(Byte * target) const
+            {
+                auto nPayloadSize = htonl(payloadSize);
+
+                if(sizeof nPayloadSize != HeaderPacket::BYTE_LENGTH)
+                    throw std::invalid_argument("HeaderPacket::toNetworkBytes() > The converted payload size does not have the expected byte length.");
+
+                std::memcpy(target, &nPayloadSize, HeaderPacket::BYTE_LENGTH);
+            }
+    };
+    
+    /**
+     * Class for representing data stream chunk information.\n
+     * 
+     * The header is sent at the start of each chunk of a data stream (after the
+     * <code>DataFrameType::STREAM_CHUNK</code> frame type byte) and allows the receiving
+     * endpoint to assign the chunk to its (logical) stream, to verify the order of the
+     * chunks and to detect the end of the stream. When encryption is enabled, the frame
+     * type and the header are authenticated together with the chunk data; chunks without
+     * data (empty last chunks and abort notifications) carry only the authentication data.
+     */
+    class StreamChunkHeader
+    {
+        public:
+            /** Chunk header length, when converted to bytes. */
+            static const std::size_t BYTE_LENGTH = sizeof(StreamID) + sizeof(StreamChunkSequence) + 1;
+            
+            /** Flag denoting that the chunk is the last one in the stream. */
+            static const Byte FLAG_LAST_CHUNK = 0x01;
+            /** Flag denoting that the chunk data is compressed. */
+            static const Byte FLAG_COMPRESSED = 0x02;
+            /** Flag denoting that the sender has abandoned the stream (the chunk has no data). */
+            static const Byte FLAG_ABORTED    = 0x04;
+            
+            /** ID of the stream the chunk belongs to. */
+            StreamID streamID;
+            
+            /** Sequence number of the chunk in the stream (starting at 0). */
+            StreamChunkSequence sequence;
+            
+            /** Chunk flags. */
+            Byte flags;
+            
+            /** Checks if the chunk is the last one in the stream.\n\n@return <code>true</code>, if it is the last chunk */
+            bool isLastChunk()  const { return (flags & FLAG_LAST_CHUNK) != 0; }
+            /** Checks if the chunk data is compressed.\n\n@return <code>true</code>, if the data is compressed */
+            bool isCompressed() const { return (flags & FLAG_COMPRESSED) != 0; }
+            /** Checks if the stream was abandoned by the sender.\n\n@return <code>true</code>, if the stream was aborted */
+            bool isAborted()    const { return (flags & FLAG_ABORTED) != 0; }
+            
+            /**
+             * Attempts to convert the supplied raw bytes to a <code>StreamChunkHeader</code> object.
+             * 
+             * Note: Network byte order is expected for the input data.
+             * 
+             * @param data bytes to be converted
+             * @param size the number of available bytes (must be at least <code>BYTE_LENGTH</code>)
+             * @return the newly built object
+             * @throws <code>std::invalid_argument</code>, if the supplied data cannot be converted
+             */
+            static StreamChunkHeader fromNetworkBytes(const Byte * data, std::size_t size)
+            {
+                if(size < StreamChunkHeader::BYTE_LENGTH)
+                    throw std::invalid_argument("StreamChunkHeader::fromNetworkBytes() > Unexpected data length encountered.");
+                
+                StreamChunkHeader result{0, 0, data[BYTE_LENGTH - 1]};
+                for(std::size_t i = 0; i < sizeof(StreamID); i++)
+                    result.streamID = (result.streamID << 8) | data[i];
+                
+                for(std::size_t i = sizeof(StreamID); i < (BYTE_LENGTH - 1); i++)
+                    result.sequence = (result.sequence << 8) | data[i];
+                
+                if((result.flags & ~(FLAG_LAST_CHUNK | FLAG_COMPRESSED | FLAG_ABORTED)) != 0)
+                    throw std::invalid_argument("StreamChunkHeader::fromNetworkBytes() > Unexpected flags encountered.");
+                
+                if(result.isAborted() && (result.flags != FLAG_ABORTED))
+                    throw std::invalid_argument("StreamChunkHeader::fromNetworkBytes() > Unexpected flags encountered for aborted stream.");
+                
+                return result;
+            }
+            
+            /**
+             * Converts the header to bytes and appends the result to the supplied container.
+             * 
+             * Note: Network byte order is used for the output data.
+             * 
+             * @param target the container to append the result to
+             */
+            void toNetworkBytes(ByteData & target) const
+            {
+                for(std::size_t i = sizeof(StreamID); i > 0; i--)
+                    target.push_back(static_cast<char>((streamID >> (8 * (i - 1))) & 0xFF));
+                
+                for(std::size_t i = sizeof(StreamChunkSequence); i > 0; i--)
+                    target.push_back(static_cast<char>((sequence >> (8 * (i - 1))) & 0xFF));
+                
+                target.push_back(static_cast<char>(flags));
+            }
+    };
+    
+    /**
+     * Class for representing data stream window updates.\n
+     * 
+     * Window updates are sent by the receiving endpoint of a data stream (after the
+     * <code>DataFrameType::STREAM_WINDOW_UPDATE</code> frame type byte) and grant the
+     * sending endpoint the specified number of additional chunks (credits); no chunks
+     * are sent without credits. The first update of a stream is sent when the receiving
+     * endpoint starts waiting for it and the next ones as its chunks are processed. An update
+     * can also reject the stream, when it cannot be received; the sending endpoint then stops
+     * sending it, without affecting the connection or its other streams. When encryption
+     * is enabled, the frame type and the update are authenticated and followed by the
+     * authentication data only (window updates carry no data).
+     */
+    class StreamWindowUpdate
+    {
+        public:
+            /** Window update length, when converted to bytes. */
+            static const std::size_t BYTE_LENGTH = sizeof(StreamID) + sizeof(StreamCredits) + 1;
+            
+            /** Flag denoting that the update opens the window of a new stream (any earlier credits are discarded). */
+            static const Byte FLAG_INITIAL  = 0x01;
+            /** Flag denoting that the receiving endpoint has rejected the stream (the update has no credits). */
+            static const Byte FLAG_REJECTED = 0x02;
+            
+            /** ID of the stream the update is for. */
+            StreamID streamID;
+            
+            /** Number of additional chunks the sending endpoint is allowed to send. */
+            StreamCredits credits;
+            
+            /** Update flags. */
+            Byte flags;
+            
+            /** Checks if the update opens the window of a new stream.\n\n@return <code>true</code>, if it is the initial update */
+            bool isInitial()    const { return (flags & FLAG_INITIAL) != 0; }
+            /** Checks if the stream was rejected by the receiving endpoint.\n\n@return <code>true</code>, if the stream was rejected */
+            bool isRejected()   const { return (flags & FLAG_REJECTED) != 0; }
+            
+            /**
+             * Attempts to convert the supplied raw bytes to a <code>StreamWindowUpdate</code> object.
+             * 
+             * Note: Network byte order is expected for the input data.
+             * 
+             * @param data bytes to be converted
+             * @param size the number of available bytes (must be exactly <code>BYTE_LENGTH</code>)
+             * @return the newly built object
+             * @throws <code>std::invalid_argument</code>, if the supplied data cannot be converted
+             */
+            static StreamWindowUpdate fromNetworkBytes(const Byte * data, std::size_t size)
+            {
+                if(size != StreamWindowUpdate::BYTE_LENGTH)
+                    throw std::invalid_argument("StreamWindowUpdate::fromNetworkBytes() > Unexpected data length encountered.");
+                
+                StreamWindowUpdate result{0, 0, data[BYTE_LENGTH - 1]};
+                for(std::size_t i = 0; i < sizeof(StreamID); i++)
+                    result.streamID = (result.streamID << 8) | data[i];
+                
+                for(std::size_t i = sizeof(StreamID); i < (BYTE_LENGTH - 1); i++)
+                    result.credits = (result.credits << 8) | data[i];
+                
+                if((result.flags & ~(FLAG_INITIAL | FLAG_REJECTED)) != 0)
+                    throw std::invalid_argument("StreamWindowUpdate::fromNetworkBytes() > Unexpected flags encountered.");
+                
+                if(result.isRejected() && (result.flags != FLAG_REJECTED || result.credits != 0))
+                    throw std::invalid_argument("StreamWindowUpdate::fromNetworkBytes() > Unexpected data encountered for rejected stream.");
+                
+                return result;
+            }
+            
+            /**
+             * Converts the update to bytes and appends the result to the supplied container.
+             * 
+             * Note: Network byte order is used for the output data.
+             * 
+             * @param target the container to append the result to
+             */
+            void toNetworkBytes(ByteData & target) const
+            {
+                for(std::size_t i = sizeof(StreamID); i > 0; i--)
+                    target.push_back(static_cast<char>((streamID >> (8 * (i - 1))) & 0xFF));
+                
+                for(std::size_t i = sizeof(StreamCredits); i > 0; i--)
+                    target.push_back(static_cast<char>((credits >> (8 * (i - 1))) & 0xFF));
+                
+                target.push_back(static_cast<char>(flags));
+            }
     };
 }
 
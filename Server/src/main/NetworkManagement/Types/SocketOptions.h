@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2016 https://github.com/sndnv
+ * 
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ * 
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETWORK_MANAGEMENT_SOCKET_OPTIONS_H
+#define	NETWORK_MANAGEMENT_SOCKET_OPTIONS_H
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+namespace NetworkManagement_Types
+{
+    /**
+     * Socket option with an integer value, for the options that have no <code>boost::asio</code> type
+     * (such as <code>SO_REUSEPORT</code> or <code>TCP_KEEPIDLE</code>).\n\n
+     * 
+     * Meets the <code>SettableSocketOption</code> and <code>GettableSocketOption</code> requirements,
+     * so it can be passed to <code>set_option</code>/<code>get_option</code> of any socket or acceptor.
+     * Boolean options are set with a value of 1 (enabled) or 0 (disabled).
+     * 
+     * @param (template) Level the socket option level (for example, <code>SOL_SOCKET</code>)
+     * @param (template) Name the socket option name (for example, <code>SO_REUSEPORT</code>)
+     */
+    template <int Level, int Name>
+    class IntegerSocketOption
+    {
+        public:
+            /** Creates a new option with a value of 0. */
+            IntegerSocketOption() : value(0) {}
+            
+            /**
+             * Creates a new option with the specified value.
+             * 
+             * @param optionValue the option value
+             */
+            explicit IntegerSocketOption(int optionValue) : value(optionValue) {}
+            
+            /** Retrieves the option value.\n\n@return the option value */
+            int getValue() const { return value; }
+            
+            template <typename Protocol> int level(const Protocol &) const { return Level; }
+            template <typename Protocol> int name(const Protocol &) const { return Name; }
+            template <typename Protocol> int * data(const Protocol &) { return &value; }
+            template <typename Protocol> const int * data(const Protocol &) const { return &value; }
+            template <typename Protocol> std::size_t size(const Protocol &) const { return sizeof(value); }
+            
+            template <typename Protocol> void resize(const Protocol &, std::size_t newSize)
+            {
+                if(newSize != sizeof(value))
+                    throw std::length_error("IntegerSocketOption::resize() > Unexpected option size: [" + std::to_string(newSize) + "].");
+            }
+        
+        private:
+            int value;
+    };
+}
+
+#endif	/* NETWORK_MANAGEMENT_SOCKET_OPTIONS_H */
@@ -64,8 +64,19 @@ namespace NetworkManagement_Types
         CONNECTION_RESPONSE_SENT, CONNECTION_RESPONSE_SENT_CONFIRMED, CONNECTION_RESPONSE_RECEIVED,
         FAILED, COMPLETED
     };
+    enum class FlowControlEvent { INVALID, WRITE_QUEUE_HIGH, WRITE_QUEUE_LOW, READ_QUEUE_HIGH, READ_QUEUE_LOW };
+    enum class AdmissionResult { INVALID, ADMITTED, GLOBAL_LIMIT, ADDRESS_LIMIT, SUBNET_LIMIT, GLOBAL_RATE, ADDRESS_RATE, SUBNET_RATE };
+    enum class DataPipelineStage { INVALID, OUTGOING_QUEUE, COMPRESS, ENCRYPT, WRITE, INCOMING_QUEUE, DECRYPT, DECOMPRESS, DELIVER };
+    
+    /** Type of a message sent on an established data connection; sent as the first byte of the message. */
+    enum class DataFrameType : Common_Types::Byte { DATA = 0x00, STREAM_CHUNK = 0x01, STREAM_WINDOW_UPDATE = 0x02 };
     
     typedef std::size_t PacketSize;
+    typedef unsigned long long StreamChunkSequence;
+    typedef unsigned int StreamCredits;
+    
+    typedef unsigned int StreamID;
+    const StreamID DEFAULT_STREAM_ID = 0;
 }
 
 #endif	/* NETWORK_MANAGEMENT_TYPES_H */
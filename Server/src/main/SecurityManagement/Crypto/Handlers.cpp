@@ -20,10 +20,11 @@
 #include <cryptopp/osrng.h>
 #include "KeyGenerator.h"
 
-void SecurityManagement_Crypto::SymmetricCryptoHandler::encryptData(const PlaintextData & plaintext, CiphertextData & ciphertext)
+void SecurityManagement_Crypto::SymmetricCryptoHandler::encryptData
+(const PlaintextData & plaintext, const PlaintextData & associatedData, CiphertextData & ciphertext)
 {
     if(cryptoData->getEncryptor().NeedsPrespecifiedDataLengths())
-        cryptoData->getEncryptor().SpecifyDataLengths(cryptoData->getIVSize(), plaintext.size(), 0);
+        cryptoData->getEncryptor().SpecifyDataLengths(cryptoData->getIVSize() + associatedData.size(), plaintext.size(), 0);
 
     CryptoPP::AutoSeededRandomPool rng;
     IVData nextIV = KeyGenerator::getIV(cryptoData->getIVSize(), rng);
@@ -32,8 +33,9 @@ void SecurityManagement_Crypto::SymmetricCryptoHandler::encryptData(const Plaint
             cryptoData->getEncryptor(),
             nullptr);
 
-    //does authentication on the new IV
+    //does authentication on the new IV and the associated data (if any)
     filter.ChannelPut(CryptoPP::AAD_CHANNEL, nextIV.data(), nextIV.size());
+    filter.ChannelPut(CryptoPP::AAD_CHANNEL, reinterpret_cast<const byte *>(associatedData.data()), associatedData.size());
     filter.ChannelMessageEnd(CryptoPP::AAD_CHANNEL);
     //does encryption + authentication on the plaintext
     filter.ChannelPut(CryptoPP::DEFAULT_CHANNEL, reinterpret_cast<const byte *>(plaintext.data()), plaintext.size());
@@ -47,11 +49,12 @@ void SecurityManagement_Crypto::SymmetricCryptoHandler::encryptData(const Plaint
     appendIVData(ciphertext, nextIV);
 }
 
-void SecurityManagement_Crypto::SymmetricCryptoHandler::decryptData(const CiphertextData & ciphertext, PlaintextData & plaintext)
+void SecurityManagement_Crypto::SymmetricCryptoHandler::decryptData
+(const CiphertextData & ciphertext, const PlaintextData & associatedData, PlaintextData & plaintext)
 {
     if(cryptoData->getDecryptor().NeedsPrespecifiedDataLengths())
     {
-        cryptoData->getDecryptor().SpecifyDataLengths(cryptoData->getIVSize(),
+        cryptoData->getDecryptor().SpecifyDataLengths(cryptoData->getIVSize() + associatedData.size(),
                 (ciphertext.size() - cryptoData->getDecryptor().TagSize() - cryptoData->getIVSize()), 0);
     }
 
@@ -69,12 +72,13 @@ void SecurityManagement_Crypto::SymmetricCryptoHandler::decryptData(const Cipher
             cryptoData->getDecryptor().TagSize());
 
     filter.ChannelPut(CryptoPP::AAD_CHANNEL, nextIV.data(), nextIV.size());
+    filter.ChannelPut(CryptoPP::AAD_CHANNEL, reinterpret_cast<const byte *>(associatedData.data()), associatedData.size());
     filter.ChannelPut(CryptoPP::DEFAULT_CHANNEL, reinterpret_cast<const byte *>(data.data()), data.size());
     filter.ChannelPut(CryptoPP::DEFAULT_CHANNEL, reinterpret_cast<const byte *>(tag.data()), tag.size());
     filter.MessageEnd();
 
-    if(filter.GetLastResult() && filter.MaxRetrievable() > 0)
-    {
+    if(filter.GetLastResult())
+    {//the plaintext is empty when only the associated data was authenticated
         CryptoPP::SecByteBlock rawPlaintext(filter.MaxRetrievable());
         filter.Get(rawPlaintext.data(), filter.MaxRetrievable());
         plaintext.assign(reinterpret_cast<const char *>(rawPlaintext.data()), rawPlaintext.size());
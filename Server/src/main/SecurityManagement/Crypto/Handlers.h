@@ -56,7 +56,23 @@ namespace SecurityManagement_Crypto
              * @param plaintext the input plaintext data
              * @param ciphertext the output ciphertext data
              */
-            void encryptData(const PlaintextData & plaintext, CiphertextData & ciphertext);
+            void encryptData(const PlaintextData & plaintext, CiphertextData & ciphertext)
+            {
+                encryptData(plaintext, SecurityManagement_Types::EMPTY_PLAINTEXT_DATA, ciphertext);
+            }
+            
+            /**
+             * Encrypts the supplied plaintext data and authenticates it together
+             * with the supplied associated data.
+             * 
+             * Note: The associated data is not part of the ciphertext; the same data
+             * needs to be supplied when decrypting.
+             * 
+             * @param plaintext the input plaintext data
+             * @param associatedData the additional data to be authenticated (but not encrypted)
+             * @param ciphertext the output ciphertext data
+             */
+            void encryptData(const PlaintextData & plaintext, const PlaintextData & associatedData, CiphertextData & ciphertext);
             
             /**
              * Decrypts the supplied ciphertext data.
@@ -64,7 +80,21 @@ namespace SecurityManagement_Crypto
              * @param ciphertext the input ciphertext data
              * @param plaintext the output plaintext data
              */
-            void decryptData(const CiphertextData & ciphertext, PlaintextData & plaintext);
+            void decryptData(const CiphertextData & ciphertext, PlaintextData & plaintext)
+            {
+                decryptData(ciphertext, SecurityManagement_Types::EMPTY_PLAINTEXT_DATA, plaintext);
+            }
+            
+            /**
+             * Decrypts the supplied ciphertext data and verifies it together
+             * with the supplied associated data.
+             * 
+             * @param ciphertext the input ciphertext data
+             * @param associatedData the additional data that was authenticated with the ciphertext
+             * @param plaintext the output plaintext data
+             * @throw runtime_error if the data cannot be decrypted or authenticated
+             */
+            void decryptData(const CiphertextData & ciphertext, const PlaintextData & associatedData, PlaintextData & plaintext);
             
             /**
              * Retrieves the crypto data used by the handler.
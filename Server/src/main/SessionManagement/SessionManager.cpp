@@ -911,6 +911,8 @@ void SyncServer_Core::SessionManager::getSessionsByConstraintHandler
 
     if(actualInstruction)
     {
+        //the sessions are taken from the in-memory tables of active sessions (no DB request is made) and
+        //the result is bounded by the number of open sessions, so the instruction is not paged
         boost::lock_guard<boost::mutex> globalSessionDataLock(globalSessionDataMutex);
         
         switch(actualInstruction->constraintType)
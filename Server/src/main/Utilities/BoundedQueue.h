@@ -0,0 +1,195 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOUNDEDQUEUE_H
+#define	BOUNDEDQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace Utilities
+{
+    /**
+     * Lock-free, fixed-capacity FIFO queue (ring buffer) supporting
+     * multiple producers and multiple consumers.
+     *
+     * Each slot carries a sequence number that tells producers and consumers
+     * whether it is free or holds a value; the only contention between threads
+     * is a single compare-and-swap on the enqueue or dequeue position.
+     *
+     * Note: The capacity is rounded up to the next power of two.
+     *
+     * @param T the type of the stored values (must be default constructible and copy assignable)
+     */
+    template <typename T>
+    class BoundedQueue
+    {
+        public:
+            /**
+             * Creates a new queue with (at least) the specified capacity.
+             *
+             * @param capacity the maximum number of values the queue can hold
+             */
+            explicit BoundedQueue(std::size_t capacity)
+            {
+                std::size_t actualCapacity = 2;
+                while(actualCapacity < capacity)
+                    actualCapacity <<= 1;
+
+                mask = actualCapacity - 1;
+                cells = new Cell[actualCapacity];
+
+                for(std::size_t i = 0; i < actualCapacity; i++)
+                    cells[i].sequence.store(i, std::memory_order_relaxed);
+
+                enqueuePosition.store(0, std::memory_order_relaxed);
+                dequeuePosition.store(0, std::memory_order_relaxed);
+            }
+
+            /**
+             * Destroys the queue.
+             *
+             * Note: Any values still in the queue are discarded.
+             */
+            ~BoundedQueue()
+            {
+                delete[] cells;
+            }
+
+            BoundedQueue() = delete;                                    //No default constructor
+            BoundedQueue(const BoundedQueue&) = delete;                 //Copy not allowed (pass/access only by reference/pointer)
+            BoundedQueue& operator=(const BoundedQueue&) = delete;      //Copy not allowed (pass/access only by reference/pointer)
+
+            /**
+             * Attempts to add the specified value at the back of the queue.
+             *
+             * Note: Thread-safe.
+             *
+             * @param value the value to be added
+             * @return true, if the value was added; false, if the queue is full
+             */
+            bool tryPush(const T & value)
+            {
+                Cell * cell;
+                std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+                while(true)
+                {
+                    cell = &cells[position & mask];
+                    std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                    std::ptrdiff_t difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+
+                    if(difference == 0)
+                    {
+                        if(enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if(difference < 0)
+                        return false; //queue is full
+                    else
+                        position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+
+                cell->value = value;
+                cell->sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * Attempts to remove the value at the front of the queue.
+             *
+             * Note: Thread-safe.
+             *
+             * @param value reference to be set to the removed value
+             * @return true, if a value was removed; false, if the queue is empty
+             */
+            bool tryPop(T & value)
+            {
+                Cell * cell;
+                std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+
+                while(true)
+                {
+                    cell = &cells[position & mask];
+                    std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                    std::ptrdiff_t difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1);
+
+                    if(difference == 0)
+                    {
+                        if(dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if(difference < 0)
+                        return false; //queue is empty
+                    else
+                        position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+
+                value = cell->value;
+                cell->value = T();
+                cell->sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * Retrieves the approximate number of values in the queue.
+             *
+             * Note: The result is exact only when no other threads are using the queue.
+             *
+             * @return the number of values in the queue
+             */
+            std::size_t getSize() const
+            {
+                std::size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+                std::size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+                return (enqueued > dequeued) ? (enqueued - dequeued) : 0;
+            }
+
+            /**
+             * Checks whether the queue is (approximately) empty.
+             *
+             * @return true, if there are no values in the queue
+             */
+            bool isEmpty() const { return getSize() == 0; }
+
+            /**
+             * Retrieves the maximum number of values the queue can hold.
+             *
+             * @return the queue capacity
+             */
+            std::size_t getCapacity() const { return mask + 1; }
+
+        private:
+            /** Structure for holding a single queue slot. */
+            struct Cell
+            {
+                std::atomic<std::size_t> sequence;
+                T value;
+            };
+
+            static const std::size_t CACHE_LINE_SIZE = 64;
+
+            Cell * cells;                                               //queue slots
+            std::size_t mask;                                           //capacity - 1
+            char enqueuePadding[CACHE_LINE_SIZE];                       //keeps producers and consumers on separate cache lines
+            std::atomic<std::size_t> enqueuePosition;                   //next slot to be written
+            char dequeuePadding[CACHE_LINE_SIZE];                       //keeps producers and consumers on separate cache lines
+            std::atomic<std::size_t> dequeuePosition;                   //next slot to be read
+    };
+}
+
+#endif	/* BOUNDEDQUEUE_H */
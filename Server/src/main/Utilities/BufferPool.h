@@ -0,0 +1,304 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUFFERPOOL_H
+#define	BUFFERPOOL_H
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <boost/shared_ptr.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include "ObjectPool.h"
+#include "../Common/Types.h"
+
+using Common_Types::Byte;
+using Common_Types::ByteData;
+
+namespace Utilities
+{
+    class BufferPool;
+    class PooledBuffer;
+    typedef boost::shared_ptr<BufferPool> BufferPoolPtr;
+    typedef boost::intrusive_ptr<PooledBuffer> PooledBufferPtr;
+
+    /**
+     * Reference-counted byte buffer, acquired from a <code>BufferPool</code>.
+     *
+     * The buffer is returned to its pool when the last reference to it is dropped.
+     */
+    class PooledBuffer
+    {
+        public:
+            /** Creates a new, empty, buffer (for use by the parent pool only). */
+            PooledBuffer() {}
+
+            PooledBuffer(const PooledBuffer&) = delete;             //Copying not allowed (pass/access only by pointer)
+            PooledBuffer& operator=(const PooledBuffer&) = delete;  //Copying not allowed (pass/access only by pointer)
+
+            /** Retrieves a pointer to the buffer data.\n\n@return the buffer data */
+            Byte * data() { return bytes.data(); }
+            /** Retrieves a pointer to the buffer data.\n\n@return the buffer data */
+            const Byte * data() const { return bytes.data(); }
+            /** Retrieves the size of the buffer (in bytes).\n\n@return the buffer capacity */
+            std::size_t capacity() const { return bytes.size(); }
+
+        private:
+            friend class BufferPool;
+            friend void intrusive_ptr_add_ref(PooledBuffer * buffer);
+            friend void intrusive_ptr_release(PooledBuffer * buffer);
+
+            std::vector<Byte> bytes;                        //buffer data
+            std::atomic<unsigned int> references {0};       //number of references to the buffer
+            std::size_t sizeClass = 0;                      //index of the pool size class the buffer belongs to
+            BufferPoolPtr owner;                            //parent pool (kept alive while the buffer is in use)
+    };
+
+    /**
+     * Pool of reusable byte buffers, grouped in size classes.
+     *
+     * The size classes start at <code>MINIMUM_BUFFER_SIZE</code> and double up to the
+     * maximum buffer size; requests are served from the smallest class that can hold
+     * them. Requests larger than the maximum buffer size are allocated (and freed) directly.
+     *
+     * Note: Must be owned by a <code>BufferPoolPtr</code> (see <code>create()</code>).
+     */
+    class BufferPool : public boost::enable_shared_from_this<BufferPool>
+    {
+        public:
+            /** Size of the smallest size class (in bytes). */
+            static const std::size_t MINIMUM_BUFFER_SIZE = 512;
+
+            /**
+             * Creates a new, empty, buffer pool.
+             *
+             * @param maximumBufferSize the size of the largest pooled buffers (in bytes)
+             * @param maximumFreeBuffers the maximum number of free buffers kept for each size class
+             * @return the new pool
+             */
+            static BufferPoolPtr create(std::size_t maximumBufferSize, std::size_t maximumFreeBuffers)
+            {
+                return BufferPoolPtr(new BufferPool(maximumBufferSize, maximumFreeBuffers));
+            }
+
+            /**
+             * Destroys the pool and all free buffers.
+             */
+            ~BufferPool()
+            {
+                for(ObjectPool<PooledBuffer> * currentPool : pools)
+                    delete currentPool;
+            }
+
+            BufferPool() = delete;                                  //No default constructor
+            BufferPool(const BufferPool&) = delete;                 //Copying not allowed (pass/access only by pointer)
+            BufferPool& operator=(const BufferPool&) = delete;      //Copying not allowed (pass/access only by pointer)
+
+            /**
+             * Retrieves a buffer that can hold at least the specified number of bytes.
+             *
+             * Note: Thread-safe.
+             *
+             * Note: The buffer contents are not cleared.
+             *
+             * @param size the required size (in bytes)
+             * @return the buffer
+             */
+            PooledBufferPtr acquire(std::size_t size)
+            {
+                std::size_t sizeClass = 0;
+                while(sizeClass < classSizes.size() && classSizes[sizeClass] < size)
+                    ++sizeClass;
+
+                PooledBuffer * buffer = nullptr;
+                if(sizeClass < classSizes.size())
+                {
+                    buffer = pools[sizeClass]->acquire();
+                    if(buffer->bytes.size() != classSizes[sizeClass])
+                        buffer->bytes.resize(classSizes[sizeClass]);
+                }
+                else
+                {//too large for the pool
+                    ++unpooledAllocations;
+                    buffer = new PooledBuffer();
+                    buffer->bytes.resize(size);
+                }
+
+                buffer->sizeClass = sizeClass;
+                buffer->owner = shared_from_this();
+                return PooledBufferPtr(buffer);
+            }
+
+            /** Retrieves the number of size classes in the pool.\n\n@return the number of size classes */
+            std::size_t getSizeClassesCount() const { return classSizes.size(); }
+            /** Retrieves the size of the largest pooled buffers (in bytes).\n\n@return the maximum buffer size */
+            std::size_t getMaximumBufferSize() const { return classSizes.back(); }
+
+            /**
+             * Retrieves the number of free buffers currently in the pool.
+             *
+             * @return the number of free buffers
+             */
+            std::size_t getFreeBuffersCount() const
+            {
+                std::size_t result = 0;
+                for(const ObjectPool<PooledBuffer> * currentPool : pools)
+                    result += currentPool->getFreeObjectsCount();
+
+                return result;
+            }
+
+            /**
+             * Retrieves the total number of buffers allocated by the pool (pooled and unpooled).
+             *
+             * @return the number of allocations
+             */
+            unsigned long getTotalAllocations() const
+            {
+                unsigned long result = unpooledAllocations;
+                for(const ObjectPool<PooledBuffer> * currentPool : pools)
+                    result += currentPool->getTotalAllocations();
+
+                return result;
+            }
+
+        private:
+            friend void intrusive_ptr_release(PooledBuffer * buffer);
+
+            std::vector<std::size_t> classSizes;                    //buffer size for each size class
+            std::vector<ObjectPool<PooledBuffer> *> pools;          //free buffers for each size class
+            std::atomic<unsigned long> unpooledAllocations {0};     //number of buffers allocated outside of the size classes
+
+            /**
+             * Creates a new, empty, buffer pool.
+             *
+             * @param maximumBufferSize the size of the largest pooled buffers (in bytes)
+             * @param maximumFreeBuffers the maximum number of free buffers kept for each size class
+             * @throw invalid_argument if the maximum buffer size is 0
+             */
+            BufferPool(std::size_t maximumBufferSize, std::size_t maximumFreeBuffers)
+            {
+                if(maximumBufferSize == 0)
+                    throw std::invalid_argument("BufferPool::() > The maximum buffer size cannot be 0.");
+
+                std::size_t currentSize = MINIMUM_BUFFER_SIZE;
+                while(currentSize < maximumBufferSize)
+                {
+                    classSizes.push_back(currentSize);
+                    currentSize *= 2;
+                }
+
+                classSizes.push_back(maximumBufferSize);
+
+                for(std::size_t i = 0; i < classSizes.size(); i++)
+                    pools.push_back(new ObjectPool<PooledBuffer>(maximumFreeBuffers));
+            }
+
+            /**
+             * Returns the specified buffer to its size class or frees it, if it is not pooled.
+             *
+             * @param buffer the buffer to be released
+             */
+            void release(PooledBuffer * buffer)
+            {
+                if(buffer->sizeClass < pools.size())
+                    pools[buffer->sizeClass]->release(buffer);
+                else
+                    delete buffer;
+            }
+    };
+
+    /** Adds a reference to the specified buffer (for <code>boost::intrusive_ptr</code>). */
+    inline void intrusive_ptr_add_ref(PooledBuffer * buffer)
+    {
+        buffer->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Removes a reference from the specified buffer and returns it to its pool, if it is no longer used. */
+    inline void intrusive_ptr_release(PooledBuffer * buffer)
+    {
+        if(buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            BufferPoolPtr pool;
+            pool.swap(buffer->owner); //the pool may be destroyed when this reference is dropped
+            pool->release(buffer);
+        }
+    }
+
+    /**
+     * Read-only, reference-counted view of (a part of) a pooled buffer.
+     *
+     * Copying a view does not copy the underlying data; the buffer is
+     * kept alive (and out of its pool) until all views of it are destroyed.
+     */
+    class BufferView
+    {
+        public:
+            /** Creates a new, empty, view. */
+            BufferView() : length(0) {}
+
+            /**
+             * Creates a new view of the first bytes of the specified buffer.
+             *
+             * @param buffer the underlying buffer
+             * @param size the number of bytes in the view
+             * @throw invalid_argument if the size exceeds the buffer capacity
+             */
+            BufferView(PooledBufferPtr buffer, std::size_t size)
+            : buffer(buffer), length(size)
+            {
+                if(size > 0 && (!buffer || size > buffer->capacity()))
+                    throw std::invalid_argument("BufferView::() > The view size exceeds the buffer capacity.");
+            }
+
+            /** Retrieves a pointer to the viewed data.\n\n@return the data (or <code>nullptr</code>, if the view is empty) */
+            const Byte * data() const { return (buffer) ? buffer->data() : nullptr; }
+            /** Retrieves the size of the viewed data (in bytes).\n\n@return the data size */
+            std::size_t size() const { return length; }
+            /** Retrieves the state of the view.\n\n@return <code>true</code>, if the view has no data */
+            bool empty() const { return (length == 0); }
+
+            /**
+             * Creates a copy of the viewed data.
+             *
+             * @return the copied data
+             */
+            ByteData toByteData() const
+            {
+                return (length > 0) ? ByteData(reinterpret_cast<const char *>(buffer->data()), length) : ByteData();
+            }
+
+            /**
+             * Appends a copy of the viewed data to the specified container.
+             *
+             * @param target the container to append the data to
+             */
+            void appendTo(ByteData & target) const
+            {
+                if(length > 0)
+                    target.append(reinterpret_cast<const char *>(buffer->data()), length);
+            }
+
+        private:
+            PooledBufferPtr buffer; //underlying buffer
+            std::size_t length;     //number of viewed bytes
+    };
+}
+
+#endif	/* BUFFERPOOL_H */
@@ -0,0 +1,183 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADAPTIVECOMPRESSIONPOLICY_H
+#define	ADAPTIVECOMPRESSIONPOLICY_H
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Common/Types.h"
+
+using Common_Types::ByteData;
+
+namespace Utilities
+{
+    namespace Compression
+    {
+        /**
+         * Class for deciding whether a payload is worth compressing.\n\n
+         *
+         * The decision is based on the compression ratios (compressed size / original size)
+         * recently achieved for the same data source (e.g. a connection) and, when those do not
+         * rule it out, on the byte entropy of a prefix of the payload, which is a cheap estimate
+         * of how well it can be compressed (already compressed or encrypted data is close to
+         * 8 bits per byte).\n\n
+         *
+         * While the history advises against compression, every <code>PROBE_INTERVAL</code>-th
+         * payload is still sampled, so that the policy adapts when the data changes.
+         *
+         * Note: The policy object is immutable and can be shared; the per-source state is kept in
+         * <code>History</code> objects, which are not thread-safe.
+         */
+        class AdaptiveCompressionPolicy
+        {
+            public:
+                /** Structure for holding the compression history of a single data source. */
+                struct History
+                {
+                    /** Moving average of the compression ratios (0 = no history). */
+                    double averageRatio = 0.0;
+                    /** Number of payloads skipped because of the history, since the last sample. */
+                    unsigned int payloadsSinceProbe = 0;
+                };
+                
+                /** Default number of bytes sampled for the entropy estimate. */
+                static const std::size_t DEFAULT_SAMPLE_SIZE = 4096;
+                /** Default maximum expected compression ratio, above which compression is skipped. */
+                static constexpr double DEFAULT_MAX_RATIO = 0.9;
+                /** Payloads smaller than this (in bytes) are never compressed. */
+                static const std::size_t MIN_PAYLOAD_SIZE = 64;
+                /** Number of payloads skipped because of the history, after which the next one is sampled. */
+                static const unsigned int PROBE_INTERVAL = 16;
+                /** Weight of the latest ratio in the moving average. */
+                static constexpr double HISTORY_WEIGHT = 0.25;
+                
+                /**
+                 * Creates a new policy with the specified settings.
+                 *
+                 * @param sampleSize the number of bytes sampled for the entropy estimate (0 = default)
+                 * @param maxRatio the maximum expected compression ratio, above which compression is skipped (0 = default)
+                 * @throw invalid_argument if the maximum ratio is negative
+                 */
+                AdaptiveCompressionPolicy(std::size_t sampleSize, double maxRatio)
+                : sampleSize((sampleSize > 0) ? sampleSize : DEFAULT_SAMPLE_SIZE),
+                  maxRatio((maxRatio > 0) ? maxRatio : DEFAULT_MAX_RATIO)
+                {
+                    if(maxRatio < 0)
+                        throw std::invalid_argument("AdaptiveCompressionPolicy::() > The maximum ratio cannot be negative.");
+                }
+                
+                /**
+                 * Decides whether the supplied payload is to be compressed.
+                 *
+                 * Note: If the payload is skipped because of its entropy, the estimate is added to the history.
+                 *
+                 * @param payload the payload to be sent
+                 * @param history the compression history of the payload's source
+                 * @return <code>true</code>, if the payload is to be compressed
+                 */
+                bool shouldCompress(const ByteData & payload, History & history) const
+                {
+                    if(payload.size() < MIN_PAYLOAD_SIZE)
+                        return false;
+                    
+                    if(history.averageRatio > maxRatio && ++history.payloadsSinceProbe < PROBE_INTERVAL)
+                        return false; //recent payloads did not compress well
+                    
+                    history.payloadsSinceProbe = 0;
+                    
+                    double expectedRatio = estimateRatio(payload, std::min(payload.size(), sampleSize));
+                    if(expectedRatio > maxRatio)
+                    {
+                        recordRatio(history, expectedRatio);
+                        return false;
+                    }
+                    
+                    return true;
+                }
+                
+                /**
+                 * Adds the result of a compression to the supplied history.
+                 *
+                 * @param history the compression history of the payload's source
+                 * @param originalSize the size of the payload (in bytes)
+                 * @param compressedSize the size of the compressed payload (in bytes)
+                 */
+                void recordResult(History & history, std::size_t originalSize, std::size_t compressedSize) const
+                {
+                    if(originalSize > 0)
+                        recordRatio(history, static_cast<double>(compressedSize) / originalSize);
+                }
+                
+                /**
+                 * Estimates the compression ratio of the supplied data, based on the
+                 * (order-0) byte entropy of its first bytes.
+                 *
+                 * @param data the data to be examined
+                 * @param size the number of bytes to examine (from the start of the data)
+                 * @return the expected ratio (entropy / 8 bits), between 0 and 1
+                 */
+                static double estimateRatio(const ByteData & data, std::size_t size)
+                {
+                    size = std::min(size, data.size());
+                    if(size == 0)
+                        return 0.0;
+                    
+                    std::size_t counts[256] = {0};
+                    for(std::size_t i = 0; i < size; i++)
+                        ++counts[static_cast<unsigned char>(data[i])];
+                    
+                    double entropy = 0.0;
+                    for(std::size_t count : counts)
+                    {
+                        if(count > 0)
+                        {
+                            double probability = static_cast<double>(count) / size;
+                            entropy -= probability * std::log2(probability);
+                        }
+                    }
+                    
+                    return entropy / 8.0;
+                }
+                
+                /** Retrieves the number of bytes sampled for the entropy estimate.\n\n@return the sample size */
+                std::size_t getSampleSize() const { return sampleSize; }
+                /** Retrieves the maximum expected compression ratio.\n\n@return the ratio */
+                double getMaxRatio() const { return maxRatio; }
+            
+            private:
+                std::size_t sampleSize; //number of bytes sampled for the entropy estimate
+                double maxRatio;        //maximum expected compression ratio
+                
+                /**
+                 * Adds the supplied ratio to the moving average of the history.
+                 *
+                 * @param history the history to be updated
+                 * @param ratio the new compression ratio
+                 */
+                static void recordRatio(History & history, double ratio)
+                {
+                    history.averageRatio = (history.averageRatio == 0.0)
+                            ? ratio
+                            : (HISTORY_WEIGHT * ratio + (1.0 - HISTORY_WEIGHT) * history.averageRatio);
+                }
+        };
+    }
+}
+
+#endif	/* ADAPTIVECOMPRESSIONPOLICY_H */
@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2014 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTPOOL_H
+#define	OBJECTPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include "BoundedQueue.h"
+
+namespace Utilities
+{
+    /**
+     * Lock-free pool of reusable, heap-allocated objects.
+     *
+     * Objects are created on demand when the pool is empty and are deleted on
+     * release when the pool is full.
+     *
+     * @param T the type of the pooled objects (must be default constructible)
+     */
+    template <typename T>
+    class ObjectPool
+    {
+        public:
+            /**
+             * Creates a new, empty object pool.
+             *
+             * @param maximumSize the maximum number of free objects kept in the pool
+             */
+            explicit ObjectPool(std::size_t maximumSize)
+            : freeObjects(maximumSize)
+            {}
+
+            /**
+             * Destroys the pool and all free objects.
+             *
+             * Note: Objects that have been acquired but not released are not affected.
+             */
+            ~ObjectPool()
+            {
+                T * object = nullptr;
+                while(freeObjects.tryPop(object))
+                    delete object;
+            }
+
+            ObjectPool() = delete;                                  //No default constructor
+            ObjectPool(const ObjectPool&) = delete;                 //Copy not allowed (pass/access only by reference/pointer)
+            ObjectPool& operator=(const ObjectPool&) = delete;      //Copy not allowed (pass/access only by reference/pointer)
+
+            /**
+             * Retrieves a free object from the pool or creates a new one, if none are available.
+             *
+             * Note: Thread-safe.
+             *
+             * @return the object
+             */
+            T * acquire()
+            {
+                T * object = nullptr;
+                if(freeObjects.tryPop(object))
+                    return object;
+
+                ++totalAllocations;
+                return new T();
+            }
+
+            /**
+             * Returns the specified object to the pool.
+             *
+             * Note: Thread-safe.
+             *
+             * Note: The object is not reset; it is the caller's responsibility
+             * to release any resources held by it.
+             *
+             * @param object the object to be returned (must have been acquired from this pool)
+             */
+            void release(T * object)
+            {
+                if(object != nullptr && !freeObjects.tryPush(object))
+                    delete object;
+            }
+
+            /**
+             * Retrieves the number of free objects currently in the pool.
+             *
+             * @return the number of free objects
+             */
+            std::size_t getFreeObjectsCount() const { return freeObjects.getSize(); }
+
+            /**
+             * Retrieves the total number of objects allocated by the pool.
+             *
+             * @return the number of allocations
+             */
+            unsigned long getTotalAllocations() const { return totalAllocations; }
+
+        private:
+            BoundedQueue<T *> freeObjects;                          //objects available for reuse
+            std::atomic<unsigned long> totalAllocations {0};        //number of objects created by the pool
+    };
+}
+
+#endif	/* OBJECTPOOL_H */
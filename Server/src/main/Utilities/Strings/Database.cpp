@@ -26,6 +26,12 @@ struct DatabaseMaps
     static const boost::unordered_map<std::string, DatabaseManagerOperationMode> stringToDatabaseManagerOperationMode;
     static const boost::unordered_map<DatabaseFailureAction, std::string> databaseFailureActionToString;
     static const boost::unordered_map<std::string, DatabaseFailureAction> stringToDatabaseFailureAction;
+    static const boost::unordered_map<DatabaseReadRoutingPolicy, std::string> databaseReadRoutingPolicyToString;
+    static const boost::unordered_map<std::string, DatabaseReadRoutingPolicy> stringToDatabaseReadRoutingPolicy;
+    static const boost::unordered_map<DALMigrationPhase, std::string> dalMigrationPhaseToString;
+    static const boost::unordered_map<std::string, DALMigrationPhase> stringToDALMigrationPhase;
+    static const boost::unordered_map<DALBreakerState, std::string> dalBreakerStateToString;
+    static const boost::unordered_map<std::string, DALBreakerState> stringToDALBreakerState;
     static const boost::unordered_map<StatisticType, std::string> statisticTypeToString;
     static const boost::unordered_map<std::string, StatisticType> stringToStatisticType;
     static const boost::unordered_map<SystemParameterType, std::string> systemParameterTypeToString;
@@ -108,6 +114,62 @@ const boost::unordered_map<std::string, DatabaseFailureAction> Maps::stringToDat
     {"INVALID",             DatabaseFailureAction::INVALID}
 };
 
+const boost::unordered_map<DatabaseReadRoutingPolicy, std::string> Maps::databaseReadRoutingPolicyToString
+{
+    {DatabaseReadRoutingPolicy::FIRST,              "FIRST"},
+    {DatabaseReadRoutingPolicy::ROUND_ROBIN,        "ROUND_ROBIN"},
+    {DatabaseReadRoutingPolicy::LEAST_OUTSTANDING,  "LEAST_OUTSTANDING"},
+    {DatabaseReadRoutingPolicy::LOWEST_LATENCY,     "LOWEST_LATENCY"},
+    {DatabaseReadRoutingPolicy::INVALID,            "INVALID"}
+};
+
+const boost::unordered_map<std::string, DatabaseReadRoutingPolicy> Maps::stringToDatabaseReadRoutingPolicy
+{
+    {"FIRST",               DatabaseReadRoutingPolicy::FIRST},
+    {"ROUND_ROBIN",         DatabaseReadRoutingPolicy::ROUND_ROBIN},
+    {"LEAST_OUTSTANDING",   DatabaseReadRoutingPolicy::LEAST_OUTSTANDING},
+    {"LOWEST_LATENCY",      DatabaseReadRoutingPolicy::LOWEST_LATENCY},
+    {"INVALID",             DatabaseReadRoutingPolicy::INVALID}
+};
+
+const boost::unordered_map<DALMigrationPhase, std::string> Maps::dalMigrationPhaseToString
+{
+    {DALMigrationPhase::PENDING,    "PENDING"},
+    {DALMigrationPhase::SNAPSHOT,   "SNAPSHOT"},
+    {DALMigrationPhase::CATCH_UP,   "CATCH_UP"},
+    {DALMigrationPhase::CUTOVER,    "CUTOVER"},
+    {DALMigrationPhase::COMPLETED,  "COMPLETED"},
+    {DALMigrationPhase::FAILED,     "FAILED"},
+    {DALMigrationPhase::INVALID,    "INVALID"}
+};
+
+const boost::unordered_map<std::string, DALMigrationPhase> Maps::stringToDALMigrationPhase
+{
+    {"PENDING",     DALMigrationPhase::PENDING},
+    {"SNAPSHOT",    DALMigrationPhase::SNAPSHOT},
+    {"CATCH_UP",    DALMigrationPhase::CATCH_UP},
+    {"CUTOVER",     DALMigrationPhase::CUTOVER},
+    {"COMPLETED",   DALMigrationPhase::COMPLETED},
+    {"FAILED",      DALMigrationPhase::FAILED},
+    {"INVALID",     DALMigrationPhase::INVALID}
+};
+
+const boost::unordered_map<DALBreakerState, std::string> Maps::dalBreakerStateToString
+{
+    {DALBreakerState::CLOSED,       "CLOSED"},
+    {DALBreakerState::OPEN,         "OPEN"},
+    {DALBreakerState::HALF_OPEN,    "HALF_OPEN"},
+    {DALBreakerState::INVALID,      "INVALID"}
+};
+
+const boost::unordered_map<std::string, DALBreakerState> Maps::stringToDALBreakerState
+{
+    {"CLOSED",      DALBreakerState::CLOSED},
+    {"OPEN",        DALBreakerState::OPEN},
+    {"HALF_OPEN",   DALBreakerState::HALF_OPEN},
+    {"INVALID",     DALBreakerState::INVALID}
+};
+
 const boost::unordered_map<StatisticType, std::string> Maps::statisticTypeToString
 {
     {StatisticType::INSTALL_TIMESTAMP,          "INSTALL_TIMESTAMP"},
@@ -350,6 +412,54 @@ DatabaseFailureAction Utilities::Strings::toDatabaseFailureAction(std::string va
         return DatabaseFailureAction::INVALID;
 }
 
+std::string Utilities::Strings::toString(DatabaseReadRoutingPolicy var)
+{
+    if(Maps::databaseReadRoutingPolicyToString.find(var) != Maps::databaseReadRoutingPolicyToString.end())
+        return Maps::databaseReadRoutingPolicyToString.at(var);
+    else
+        return "INVALID";
+}
+
+DatabaseReadRoutingPolicy Utilities::Strings::toDatabaseReadRoutingPolicy(std::string var)
+{
+    if(Maps::stringToDatabaseReadRoutingPolicy.find(var) != Maps::stringToDatabaseReadRoutingPolicy.end())
+        return Maps::stringToDatabaseReadRoutingPolicy.at(var);
+    else
+        return DatabaseReadRoutingPolicy::INVALID;
+}
+
+std::string Utilities::Strings::toString(DALMigrationPhase var)
+{
+    if(Maps::dalMigrationPhaseToString.find(var) != Maps::dalMigrationPhaseToString.end())
+        return Maps::dalMigrationPhaseToString.at(var);
+    else
+        return "INVALID";
+}
+
+DALMigrationPhase Utilities::Strings::toDALMigrationPhase(std::string var)
+{
+    if(Maps::stringToDALMigrationPhase.find(var) != Maps::stringToDALMigrationPhase.end())
+        return Maps::stringToDALMigrationPhase.at(var);
+    else
+        return DALMigrationPhase::INVALID;
+}
+
+std::string Utilities::Strings::toString(DALBreakerState var)
+{
+    if(Maps::dalBreakerStateToString.find(var) != Maps::dalBreakerStateToString.end())
+        return Maps::dalBreakerStateToString.at(var);
+    else
+        return "INVALID";
+}
+
+DALBreakerState Utilities::Strings::toDALBreakerState(std::string var)
+{
+    if(Maps::stringToDALBreakerState.find(var) != Maps::stringToDALBreakerState.end())
+        return Maps::stringToDALBreakerState.at(var);
+    else
+        return DALBreakerState::INVALID;
+}
+
 std::string Utilities::Strings::toString(StatisticType var)
 {
     if(Maps::statisticTypeToString.find(var) != Maps::statisticTypeToString.end())
@@ -24,6 +24,9 @@
 using DatabaseManagement_Types::DatabaseObjectType;
 using DatabaseManagement_Types::DatabaseManagerOperationMode;
 using DatabaseManagement_Types::DatabaseFailureAction;
+using DatabaseManagement_Types::DatabaseReadRoutingPolicy;
+using DatabaseManagement_Types::DALMigrationPhase;
+using DatabaseManagement_Types::DALBreakerState;
 using DatabaseManagement_Types::StatisticType;
 using DatabaseManagement_Types::SystemParameterType;
 using DatabaseManagement_Types::DataTransferType;
@@ -41,6 +44,9 @@ namespace Utilities
         std::string toString(DatabaseObjectType var);
         std::string toString(DatabaseManagerOperationMode var);
         std::string toString(DatabaseFailureAction var);
+        std::string toString(DatabaseReadRoutingPolicy var);
+        std::string toString(DALMigrationPhase var);
+        std::string toString(DALBreakerState var);
         std::string toString(StatisticType var);
         std::string toString(SystemParameterType var);
         std::string toString(DataTransferType var);
@@ -53,6 +59,9 @@ namespace Utilities
         DatabaseObjectType toDatabaseObjectType(std::string var);
         DatabaseManagerOperationMode toDatabaseManagerOperationMode(std::string var);
         DatabaseFailureAction toDatabaseFailureAction(std::string var);
+        DatabaseReadRoutingPolicy toDatabaseReadRoutingPolicy(std::string var);
+        DALMigrationPhase toDALMigrationPhase(std::string var);
+        DALBreakerState toDALBreakerState(std::string var);
         StatisticType toStatisticType(std::string var);
         SystemParameterType toSystemParameterType(std::string var);
         DataTransferType toDataTransferType(std::string var);
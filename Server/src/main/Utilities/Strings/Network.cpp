@@ -32,6 +32,12 @@ struct NetworkMaps
     static const boost::unordered_map<std::string, ConnectionInitiation> stringToConnectionInitiation;
     static const boost::unordered_map<ConnectionSetupState, std::string> connectionSetupStateToString;
     static const boost::unordered_map<std::string, ConnectionSetupState> stringToConnectionSetupState;
+    static const boost::unordered_map<FlowControlEvent, std::string> flowControlEventToString;
+    static const boost::unordered_map<std::string, FlowControlEvent> stringToFlowControlEvent;
+    static const boost::unordered_map<AdmissionResult, std::string> admissionResultToString;
+    static const boost::unordered_map<std::string, AdmissionResult> stringToAdmissionResult;
+    static const boost::unordered_map<DataPipelineStage, std::string> dataPipelineStageToString;
+    static const boost::unordered_map<std::string, DataPipelineStage> stringToDataPipelineStage;
 };
 
 using Maps = NetworkMaps;
@@ -139,6 +145,74 @@ const boost::unordered_map<std::string, ConnectionSetupState> Maps::stringToConn
     {"INVALID",                         ConnectionSetupState::INVALID}
 };
 
+const boost::unordered_map<FlowControlEvent, std::string> Maps::flowControlEventToString
+{
+    {FlowControlEvent::WRITE_QUEUE_HIGH,    "WRITE_QUEUE_HIGH"},
+    {FlowControlEvent::WRITE_QUEUE_LOW,     "WRITE_QUEUE_LOW"},
+    {FlowControlEvent::READ_QUEUE_HIGH,     "READ_QUEUE_HIGH"},
+    {FlowControlEvent::READ_QUEUE_LOW,      "READ_QUEUE_LOW"},
+    {FlowControlEvent::INVALID,             "INVALID"}
+};
+
+const boost::unordered_map<std::string, FlowControlEvent> Maps::stringToFlowControlEvent
+{
+    {"WRITE_QUEUE_HIGH",    FlowControlEvent::WRITE_QUEUE_HIGH},
+    {"WRITE_QUEUE_LOW",     FlowControlEvent::WRITE_QUEUE_LOW},
+    {"READ_QUEUE_HIGH",     FlowControlEvent::READ_QUEUE_HIGH},
+    {"READ_QUEUE_LOW",      FlowControlEvent::READ_QUEUE_LOW},
+    {"INVALID",             FlowControlEvent::INVALID}
+};
+
+const boost::unordered_map<AdmissionResult, std::string> Maps::admissionResultToString
+{
+    {AdmissionResult::ADMITTED,     "ADMITTED"},
+    {AdmissionResult::GLOBAL_LIMIT, "GLOBAL_LIMIT"},
+    {AdmissionResult::ADDRESS_LIMIT,"ADDRESS_LIMIT"},
+    {AdmissionResult::SUBNET_LIMIT, "SUBNET_LIMIT"},
+    {AdmissionResult::GLOBAL_RATE,  "GLOBAL_RATE"},
+    {AdmissionResult::ADDRESS_RATE, "ADDRESS_RATE"},
+    {AdmissionResult::SUBNET_RATE,  "SUBNET_RATE"},
+    {AdmissionResult::INVALID,      "INVALID"}
+};
+
+const boost::unordered_map<std::string, AdmissionResult> Maps::stringToAdmissionResult
+{
+    {"ADMITTED",    AdmissionResult::ADMITTED},
+    {"GLOBAL_LIMIT",AdmissionResult::GLOBAL_LIMIT},
+    {"ADDRESS_LIMIT",AdmissionResult::ADDRESS_LIMIT},
+    {"SUBNET_LIMIT",AdmissionResult::SUBNET_LIMIT},
+    {"GLOBAL_RATE", AdmissionResult::GLOBAL_RATE},
+    {"ADDRESS_RATE",AdmissionResult::ADDRESS_RATE},
+    {"SUBNET_RATE", AdmissionResult::SUBNET_RATE},
+    {"INVALID",     AdmissionResult::INVALID}
+};
+
+const boost::unordered_map<DataPipelineStage, std::string> Maps::dataPipelineStageToString
+{
+    {DataPipelineStage::OUTGOING_QUEUE, "OUTGOING_QUEUE"},
+    {DataPipelineStage::COMPRESS,       "COMPRESS"},
+    {DataPipelineStage::ENCRYPT,        "ENCRYPT"},
+    {DataPipelineStage::WRITE,          "WRITE"},
+    {DataPipelineStage::INCOMING_QUEUE, "INCOMING_QUEUE"},
+    {DataPipelineStage::DECRYPT,        "DECRYPT"},
+    {DataPipelineStage::DECOMPRESS,     "DECOMPRESS"},
+    {DataPipelineStage::DELIVER,        "DELIVER"},
+    {DataPipelineStage::INVALID,        "INVALID"}
+};
+
+const boost::unordered_map<std::string, DataPipelineStage> Maps::stringToDataPipelineStage
+{
+    {"OUTGOING_QUEUE",  DataPipelineStage::OUTGOING_QUEUE},
+    {"COMPRESS",        DataPipelineStage::COMPRESS},
+    {"ENCRYPT",         DataPipelineStage::ENCRYPT},
+    {"WRITE",           DataPipelineStage::WRITE},
+    {"INCOMING_QUEUE",  DataPipelineStage::INCOMING_QUEUE},
+    {"DECRYPT",         DataPipelineStage::DECRYPT},
+    {"DECOMPRESS",      DataPipelineStage::DECOMPRESS},
+    {"DELIVER",         DataPipelineStage::DELIVER},
+    {"INVALID",         DataPipelineStage::INVALID}
+};
+
 std::string Utilities::Strings::toString(PeerType var)
 {
     if(Maps::peerTypeToString.find(var) != Maps::peerTypeToString.end())
@@ -233,4 +307,52 @@ ConnectionSetupState Utilities::Strings::toConnectionSetupState(std::string var)
         return Maps::stringToConnectionSetupState.at(var);
     else
         return ConnectionSetupState::INVALID;
-}
\ No newline at end of file
+}
+
+std::string Utilities::Strings::toString(FlowControlEvent var)
+{
+    if(Maps::flowControlEventToString.find(var) != Maps::flowControlEventToString.end())
+        return Maps::flowControlEventToString.at(var);
+    else
+        return "INVALID";
+}
+
+FlowControlEvent Utilities::Strings::toFlowControlEvent(std::string var)
+{
+    if(Maps::stringToFlowControlEvent.find(var) != Maps::stringToFlowControlEvent.end())
+        return Maps::stringToFlowControlEvent.at(var);
+    else
+        return FlowControlEvent::INVALID;
+}
+
+std::string Utilities::Strings::toString(AdmissionResult var)
+{
+    if(Maps::admissionResultToString.find(var) != Maps::admissionResultToString.end())
+        return Maps::admissionResultToString.at(var);
+    else
+        return "INVALID";
+}
+
+AdmissionResult Utilities::Strings::toAdmissionResult(std::string var)
+{
+    if(Maps::stringToAdmissionResult.find(var) != Maps::stringToAdmissionResult.end())
+        return Maps::stringToAdmissionResult.at(var);
+    else
+        return AdmissionResult::INVALID;
+}
+
+std::string Utilities::Strings::toString(DataPipelineStage var)
+{
+    if(Maps::dataPipelineStageToString.find(var) != Maps::dataPipelineStageToString.end())
+        return Maps::dataPipelineStageToString.at(var);
+    else
+        return "INVALID";
+}
+
+DataPipelineStage Utilities::Strings::toDataPipelineStage(std::string var)
+{
+    if(Maps::stringToDataPipelineStage.find(var) != Maps::stringToDataPipelineStage.end())
+        return Maps::stringToDataPipelineStage.at(var);
+    else
+        return DataPipelineStage::INVALID;
+}
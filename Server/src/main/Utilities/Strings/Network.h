@@ -29,6 +29,9 @@ using NetworkManagement_Types::ConnectionType;
 using NetworkManagement_Types::PeerType;
 using NetworkManagement_Types::ConnectionInitiation;
 using NetworkManagement_Types::ConnectionSetupState;
+using NetworkManagement_Types::FlowControlEvent;
+using NetworkManagement_Types::AdmissionResult;
+using NetworkManagement_Types::DataPipelineStage;
 
 namespace Utilities
 {
@@ -40,6 +43,9 @@ namespace Utilities
         std::string toString(ConnectionSubstate var);
         std::string toString(ConnectionInitiation var);
         std::string toString(ConnectionSetupState var);
+        std::string toString(FlowControlEvent var);
+        std::string toString(AdmissionResult var);
+        std::string toString(DataPipelineStage var);
         
         PeerType toPeerType(std::string var);
         ConnectionType toConnectionType(std::string var);
@@ -47,6 +53,9 @@ namespace Utilities
         ConnectionSubstate toConnectionSubstate(std::string var);
         ConnectionInitiation toConnectionInitiation(std::string var);
         ConnectionSetupState toConnectionSetupState(std::string var);
+        FlowControlEvent toFlowControlEvent(std::string var);
+        AdmissionResult toAdmissionResult(std::string var);
+        DataPipelineStage toDataPipelineStage(std::string var);
     }
 }
 
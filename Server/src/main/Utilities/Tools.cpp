@@ -74,8 +74,12 @@ Common_Types::DBObjectID Utilities::Tools::getIDFromConstraint(DatabaseObjectTyp
 
         case DatabaseObjectType::STATISTICS:
         {
-            if(boost::any_cast<DatabaseSelectConstraints::STATISTCS>(constraintType) == DatabaseSelectConstraints::STATISTCS::LIMIT_BY_TYPE)
+            //the objects can also be selected by their type, which does not map to an object ID
+            if(boost::any_cast<DatabaseSelectConstraints::STATISTCS>(constraintType) == DatabaseSelectConstraints::STATISTCS::LIMIT_BY_TYPE
+                    && constraintValue.type() == typeid(boost::uuids::uuid))
+            {
                 objectID = boost::any_cast<boost::uuids::uuid>(constraintValue);
+            }
         } break;
 
         case DatabaseObjectType::SYNC_FILE:
@@ -86,8 +90,12 @@ Common_Types::DBObjectID Utilities::Tools::getIDFromConstraint(DatabaseObjectTyp
 
         case DatabaseObjectType::SYSTEM_SETTINGS:
         {
-            if(boost::any_cast<DatabaseSelectConstraints::SYSTEM>(constraintType) == DatabaseSelectConstraints::SYSTEM::LIMIT_BY_TYPE)
+            //the objects can also be selected by their type, which does not map to an object ID
+            if(boost::any_cast<DatabaseSelectConstraints::SYSTEM>(constraintType) == DatabaseSelectConstraints::SYSTEM::LIMIT_BY_TYPE
+                    && constraintValue.type() == typeid(boost::uuids::uuid))
+            {
                 objectID = boost::any_cast<boost::uuids::uuid>(constraintValue);
+            }
         } break;
 
         case DatabaseObjectType::USER:
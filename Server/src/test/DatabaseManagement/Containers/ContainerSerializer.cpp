@@ -0,0 +1,307 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../BasicSpec.h"
+#include "../../../main/DatabaseManagement/Containers/ContainerSerializer.h"
+#include "../../../main/DatabaseManagement/Containers/DeviceDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/LogDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/ScheduleDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/SessionDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/StatisticDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/SyncDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/SystemDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/UserDataContainer.h"
+#include "../../../main/DatabaseManagement/Containers/VectorDataContainer.h"
+
+using namespace DatabaseManagement_Containers;
+using DatabaseManagement_Types::DatabaseManagerOperationMode;
+using InstructionManagement_Types::InstructionSetType;
+
+namespace
+{
+    /** Decodes the encoded representation of the specified container. */
+    template <typename TContainer>
+    boost::shared_ptr<TContainer> roundTrip(const DataContainerPtr container)
+    {
+        return boost::dynamic_pointer_cast<TContainer>(ContainerSerializer::deserialize(ContainerSerializer::serialize(container)));
+    }
+    
+    PasswordData getTestPassword()
+    {
+        const std::string rawPassword = "test_password_data";
+        return PasswordData(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+    }
+    
+    /** Runs the specified number of encode and decode operations on the container and reports their duration. */
+    void runBenchmark(const std::string & name, const DataContainerPtr container, unsigned int iterations)
+    {
+        std::string encodedData;
+        boost::posix_time::ptime encodeStart = boost::posix_time::microsec_clock::universal_time();
+        for(unsigned int i = 0; i < iterations; i++)
+            encodedData = ContainerSerializer::serialize(container);
+        boost::posix_time::time_duration encodeTime = boost::posix_time::microsec_clock::universal_time() - encodeStart;
+        
+        boost::posix_time::ptime decodeStart = boost::posix_time::microsec_clock::universal_time();
+        for(unsigned int i = 0; i < iterations; i++)
+            ContainerSerializer::deserialize(encodedData);
+        boost::posix_time::time_duration decodeTime = boost::posix_time::microsec_clock::universal_time() - decodeStart;
+        
+        WARN(name << ": size [" << encodedData.size() << " bytes]; "
+             << "encode [" << (encodeTime.total_nanoseconds() / iterations) << " ns/op]; "
+             << "decode [" << (decodeTime.total_nanoseconds() / iterations) << " ns/op]");
+    }
+}
+
+SCENARIO("Data containers are converted to and from their binary representation", "[ContainerSerializer][DatabaseManagement]")
+{
+    GIVEN("a set of data containers")
+    {
+        boost::posix_time::ptime testTime = boost::posix_time::microsec_clock::universal_time();
+        
+        DeviceDataContainerPtr device(new DeviceDataContainer(boost::uuids::random_generator()(), "device_provided_id", "device,name;1", getTestPassword(),
+                                                              boost::uuids::random_generator()(), "127.0.0.1", 9001, "127.0.0.2", 9002, "127.0.0.3", 9003,
+                                                              DataTransferType::PULL, "device info", true, testTime, INVALID_DATE_TIME, 3,
+                                                              std::string("\x00\x01\xFF", 3), KeyExchangeType::EC_DH, PeerType::SERVER));
+        
+        LogDataContainerPtr log(new LogDataContainer(LogSeverity::Warning, "ContainerSerializerTest", testTime, "message, with; separators\nand lines"));
+        
+        ScheduleDataContainerPtr schedule(new ScheduleDataContainer(true, testTime, -1, ScheduleIntervalType::HOURS, 12, false, true,
+                                                                    boost::uuids::random_generator()()));
+        
+        SessionDataContainerPtr session(new SessionDataContainer(boost::uuids::random_generator()(), testTime, boost::posix_time::not_a_date_time,
+                                                                 testTime, SessionType::DATA, boost::uuids::random_generator()(),
+                                                                 boost::uuids::random_generator()(), true, false, 5000000000UL, 42, 7, 8));
+        
+        StatisticDataContainerPtr statistic(new StatisticDataContainer(StatisticType::TOTAL_TRANSFERRED_DATA, 123456789UL));
+        
+        SyncDataContainerPtr sync(new SyncDataContainer("sync_name", "sync description", "/source/path", "/destination/path",
+                                                        boost::uuids::random_generator()(), boost::uuids::random_generator()(), true, false,
+                                                        ConflictResolutionRule_Directory::MERGE, ConflictResolutionRule_File::RENAME_AND_COPY,
+                                                        true, false, boost::uuids::random_generator()(), "rwxr-x---", false, true, 5,
+                                                        SyncFailureAction::RETRY_LATER, testTime, SyncResult::PARTIAL,
+                                                        boost::uuids::random_generator()(), boost::uuids::random_generator()()));
+        
+        SystemDataContainerPtr system(new SystemDataContainer(SystemParameterType::DB_OPERATION_MODE, DatabaseManagerOperationMode::PRCW));
+        
+        std::deque<UserAuthorizationRule> rules;
+        rules.push_back(UserAuthorizationRule(InstructionSetType::TEST));
+        rules.push_back(UserAuthorizationRule(InstructionSetType::DATABASE_LOGGER));
+        UserDataContainerPtr user(new UserDataContainer(boost::uuids::random_generator()(), "test_user", getTestPassword(), UserAccessLevel::ADMIN,
+                                                        true, false, testTime, testTime, INVALID_DATE_TIME, 2, rules));
+        
+        WHEN("they are serialized and deserialized")
+        {
+            auto deviceResult = roundTrip<DeviceDataContainer>(device);
+            auto logResult = roundTrip<LogDataContainer>(log);
+            auto scheduleResult = roundTrip<ScheduleDataContainer>(schedule);
+            auto sessionResult = roundTrip<SessionDataContainer>(session);
+            auto statisticResult = roundTrip<StatisticDataContainer>(statistic);
+            auto syncResult = roundTrip<SyncDataContainer>(sync);
+            auto systemResult = roundTrip<SystemDataContainer>(system);
+            auto userResult = roundTrip<UserDataContainer>(user);
+            
+            THEN("the resulting containers hold the original data")
+            {
+                REQUIRE(deviceResult);
+                CHECK(deviceResult->getDeviceID() == device->getDeviceID());
+                CHECK(deviceResult->getDeviceProvidedID() == device->getDeviceProvidedID());
+                CHECK(deviceResult->getDeviceName() == device->getDeviceName());
+                CHECK(deviceResult->getPasswordData() == device->getPasswordData());
+                CHECK(deviceResult->getDeviceOwner() == device->getDeviceOwner());
+                CHECK(deviceResult->getDeviceCommandAddress() == device->getDeviceCommandAddress());
+                CHECK(deviceResult->getDeviceCommandPort() == device->getDeviceCommandPort());
+                CHECK(deviceResult->getDeviceDataAddress() == device->getDeviceDataAddress());
+                CHECK(deviceResult->getDeviceDataPort() == device->getDeviceDataPort());
+                CHECK(deviceResult->getDeviceInitAddress() == device->getDeviceInitAddress());
+                CHECK(deviceResult->getDeviceInitPort() == device->getDeviceInitPort());
+                CHECK(deviceResult->getTransferType() == device->getTransferType());
+                CHECK(deviceResult->getDeviceInfo() == device->getDeviceInfo());
+                CHECK(deviceResult->isDeviceLocked() == device->isDeviceLocked());
+                CHECK(deviceResult->getLastSuccessfulAuthenticationTimestamp() == device->getLastSuccessfulAuthenticationTimestamp());
+                CHECK(deviceResult->getLastFailedAuthenticationTimestamp() == device->getLastFailedAuthenticationTimestamp());
+                CHECK(deviceResult->getFailedAuthenticationAttempts() == device->getFailedAuthenticationAttempts());
+                CHECK(deviceResult->getRawPublicKey() == device->getRawPublicKey());
+                CHECK(deviceResult->getExpectedKeyExhange() == device->getExpectedKeyExhange());
+                CHECK(deviceResult->getDeviceType() == device->getDeviceType());
+                
+                REQUIRE(logResult);
+                CHECK(logResult->getLogID() == log->getLogID());
+                CHECK(logResult->getLogSeverity() == log->getLogSeverity());
+                CHECK(logResult->getLogSourceName() == log->getLogSourceName());
+                CHECK(logResult->getLogTimestamp() == log->getLogTimestamp());
+                CHECK(logResult->getLogMessage() == log->getLogMessage());
+                
+                REQUIRE(scheduleResult);
+                CHECK(scheduleResult->getContainerID() == schedule->getContainerID());
+                CHECK(scheduleResult->isScheduleActive() == schedule->isScheduleActive());
+                CHECK(scheduleResult->getNextRun() == schedule->getNextRun());
+                CHECK(scheduleResult->getNumberOfRepetitions() == schedule->getNumberOfRepetitions());
+                CHECK(scheduleResult->getIntervalType() == schedule->getIntervalType());
+                CHECK(scheduleResult->getIntervalLength() == schedule->getIntervalLength());
+                CHECK(scheduleResult->runScheduleIfMissed() == schedule->runScheduleIfMissed());
+                CHECK(scheduleResult->deleteScheduleAfterCompletion() == schedule->deleteScheduleAfterCompletion());
+                
+                REQUIRE(sessionResult);
+                CHECK(sessionResult->getContainerID() == session->getContainerID());
+                CHECK(sessionResult->getOpenTimestamp() == session->getOpenTimestamp());
+                CHECK(sessionResult->getCloseTimestamp().is_not_a_date_time());
+                CHECK(sessionResult->getLastActivityTimestamp() == session->getLastActivityTimestamp());
+                CHECK(sessionResult->getSessionType() == session->getSessionType());
+                CHECK(sessionResult->getDevice() == session->getDevice());
+                CHECK(sessionResult->getUser() == session->getUser());
+                CHECK(sessionResult->isSessionPersistent() == session->isSessionPersistent());
+                CHECK(sessionResult->isSessionActive() == session->isSessionActive());
+                CHECK(sessionResult->getDataSent() == session->getDataSent());
+                CHECK(sessionResult->getDataReceived() == session->getDataReceived());
+                CHECK(sessionResult->getCommandsSent() == session->getCommandsSent());
+                CHECK(sessionResult->getCommandsReceived() == session->getCommandsReceived());
+                
+                REQUIRE(statisticResult);
+                CHECK(statisticResult->getContainerID() == statistic->getContainerID());
+                CHECK(statisticResult->getStatisticType() == statistic->getStatisticType());
+                CHECK(boost::any_cast<unsigned long>(statisticResult->getStatisticValue()) == 123456789UL);
+                
+                REQUIRE(syncResult);
+                CHECK(syncResult->getSyncID() == sync->getSyncID());
+                CHECK(syncResult->getSyncName() == sync->getSyncName());
+                CHECK(syncResult->getSyncDescription() == sync->getSyncDescription());
+                CHECK(syncResult->getSourcePath() == sync->getSourcePath());
+                CHECK(syncResult->getDestinationPath() == sync->getDestinationPath());
+                CHECK(syncResult->getSourceDevice() == sync->getSourceDevice());
+                CHECK(syncResult->getDestinationDevice() == sync->getDestinationDevice());
+                CHECK(syncResult->isSyncOneWay() == sync->isSyncOneWay());
+                CHECK(syncResult->isSyncOneTime() == sync->isSyncOneTime());
+                CHECK(syncResult->getDirectoryConflictResolutionRule() == sync->getDirectoryConflictResolutionRule());
+                CHECK(syncResult->getFileConflictResolutionRule() == sync->getFileConflictResolutionRule());
+                CHECK(syncResult->isEncryptionEnabled() == sync->isEncryptionEnabled());
+                CHECK(syncResult->isCompressionEnabled() == sync->isCompressionEnabled());
+                CHECK(syncResult->getOwnerID() == sync->getOwnerID());
+                CHECK(syncResult->getDestinationPermissions() == sync->getDestinationPermissions());
+                CHECK(syncResult->isOfflineSyncEnabled() == sync->isOfflineSyncEnabled());
+                CHECK(syncResult->isDifferentialSyncEnabled() == sync->isDifferentialSyncEnabled());
+                CHECK(syncResult->getNumberOfSyncRetries() == sync->getNumberOfSyncRetries());
+                CHECK(syncResult->getFailureAction() == sync->getFailureAction());
+                CHECK(syncResult->getLastAttemptTimestamp() == sync->getLastAttemptTimestamp());
+                CHECK(syncResult->getLastResult() == sync->getLastResult());
+                CHECK(syncResult->getLastSessionID() == sync->getLastSessionID());
+                
+                REQUIRE(systemResult);
+                CHECK(systemResult->getContainerID() == system->getContainerID());
+                CHECK(systemResult->getSystemParameterType() == system->getSystemParameterType());
+                CHECK(boost::any_cast<DatabaseManagerOperationMode>(systemResult->getSystemParameterValue()) == DatabaseManagerOperationMode::PRCW);
+                
+                REQUIRE(userResult);
+                CHECK(userResult->getUserID() == user->getUserID());
+                CHECK(userResult->getUsername() == user->getUsername());
+                CHECK(userResult->getPasswordData() == user->getPasswordData());
+                CHECK(userResult->getUserAccessLevel() == user->getUserAccessLevel());
+                CHECK(userResult->getForcePasswordReset() == user->getForcePasswordReset());
+                CHECK(userResult->isUserLocked() == user->isUserLocked());
+                CHECK(userResult->getCreationTimestamp() == user->getCreationTimestamp());
+                CHECK(userResult->getLastSuccessfulAuthenticationTimestamp() == user->getLastSuccessfulAuthenticationTimestamp());
+                CHECK(userResult->getLastFailedAuthenticationTimestamp() == user->getLastFailedAuthenticationTimestamp());
+                CHECK(userResult->getFailedAuthenticationAttempts() == user->getFailedAuthenticationAttempts());
+                CHECK(userResult->getAccessRules() == user->getAccessRules());
+            }
+        }
+        
+        WHEN("they are serialized and deserialized as part of a vector container")
+        {
+            VectorDataContainerPtr vector(new VectorDataContainer());
+            vector->addDataContainer(log);
+            vector->addDataContainer(statistic);
+            vector->addDataContainer(sync);
+            
+            auto vectorResult = roundTrip<VectorDataContainer>(vector);
+            
+            THEN("the resulting container holds all children, in order")
+            {
+                REQUIRE(vectorResult);
+                REQUIRE(vectorResult->getContainers().size() == 3);
+                CHECK(vectorResult->getContainers()[0]->getContainerID() == log->getContainerID());
+                CHECK(vectorResult->getContainers()[1]->getDataType() == DatabaseObjectType::STATISTICS);
+                CHECK(boost::dynamic_pointer_cast<SyncDataContainer>(vectorResult->getContainers()[2])->getSyncName() == sync->getSyncName());
+            }
+        }
+        
+        WHEN("malformed data is deserialized")
+        {
+            std::string validData = ContainerSerializer::serialize(log);
+            
+            std::string otherVersion = validData;
+            otherVersion[0] = static_cast<char>(ContainerSerializer::FORMAT_VERSION + 1);
+            
+            THEN("the operation fails")
+            {
+                CHECK_THROWS_AS(ContainerSerializer::deserialize(otherVersion), std::runtime_error);
+                CHECK_THROWS_AS(ContainerSerializer::deserialize(validData.substr(0, validData.size() - 1)), std::runtime_error);
+                CHECK_THROWS_AS(ContainerSerializer::deserialize(validData + "x"), std::runtime_error);
+                CHECK_THROWS_AS(ContainerSerializer::deserialize(std::string()), std::runtime_error);
+                CHECK_THROWS_AS(ContainerSerializer::serialize(DataContainerPtr()), std::invalid_argument);
+            }
+        }
+    }
+}
+
+SCENARIO("Data container serialization performance is measured", "[.][benchmark][ContainerSerializer][DatabaseManagement]")
+{
+    GIVEN("a set of data containers")
+    {
+        boost::posix_time::ptime testTime = boost::posix_time::microsec_clock::universal_time();
+        const unsigned int iterations = 100000;
+        
+        WHEN("they are repeatedly serialized and deserialized")
+        {
+            std::deque<UserAuthorizationRule> rules;
+            rules.push_back(UserAuthorizationRule(InstructionSetType::TEST));
+            
+            runBenchmark("Device", DataContainerPtr(new DeviceDataContainer(boost::uuids::random_generator()(), "device_provided_id", "device_name",
+                                                                            getTestPassword(), boost::uuids::random_generator()(), "127.0.0.1", 9001,
+                                                                            "127.0.0.1", 9002, "127.0.0.1", 9003, DataTransferType::PUSH, "device info",
+                                                                            false, testTime, testTime, 0, "public_key", KeyExchangeType::RSA, PeerType::CLIENT)),
+                         iterations);
+            
+            runBenchmark("Log", DataContainerPtr(new LogDataContainer(LogSeverity::Info, "ContainerSerializerBenchmark", testTime, "test message")), iterations);
+            
+            runBenchmark("Schedule", DataContainerPtr(new ScheduleDataContainer(true, testTime, 10, ScheduleIntervalType::MINUTES, 5, true, false,
+                                                                                boost::uuids::random_generator()())), iterations);
+            
+            runBenchmark("Session", DataContainerPtr(new SessionDataContainer(SessionType::COMMAND, boost::uuids::random_generator()(),
+                                                                              boost::uuids::random_generator()(), false)), iterations);
+            
+            runBenchmark("Statistic", DataContainerPtr(new StatisticDataContainer(StatisticType::START_TIMESTAMP, testTime)), iterations);
+            
+            runBenchmark("Sync", DataContainerPtr(new SyncDataContainer("sync_name", "sync description", "/source/path", "/destination/path",
+                                                                        boost::uuids::random_generator()(), boost::uuids::random_generator()(), true, false,
+                                                                        ConflictResolutionRule_Directory::MERGE, ConflictResolutionRule_File::STOP, false,
+                                                                        true, boost::uuids::random_generator()(), "rwx------", false, false, 3,
+                                                                        SyncFailureAction::SKIP, testTime, SyncResult::SUCCESSFUL,
+                                                                        boost::uuids::random_generator()(), boost::uuids::random_generator()())), iterations);
+            
+            runBenchmark("System", DataContainerPtr(new SystemDataContainer(SystemParameterType::DATA_IP_ADDRESS, std::string("127.0.0.1"))), iterations);
+            
+            runBenchmark("User", DataContainerPtr(new UserDataContainer(boost::uuids::random_generator()(), "test_user", getTestPassword(),
+                                                                        UserAccessLevel::USER, false, false, testTime, testTime, testTime, 0, rules)),
+                         iterations);
+            
+            THEN("the results are reported")
+            {
+                SUCCEED();
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/DatabaseManagement/DALCache.h"
+#include "TestDAL.h"
+
+using SyncServer_Core::DatabaseManagement::DALCache;
+using Testing::TestDAL;
+
+namespace
+{
+    /** Test DAL that does not accept INSERT requests for a specific object, while rejection is enabled. */
+    class RejectingDAL : public TestDAL
+    {
+        public:
+            RejectingDAL(DBObjectID rejectedObject)
+            : TestDAL(true, true, true, true, DatabaseObjectType::USER, false), rejectedObjectID(rejectedObject), putObject_rejected(0)
+            {}
+            
+            bool putObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override
+            {
+                if(rejectionEnabled && inputData->getContainerID() == rejectedObjectID)
+                {
+                    ++putObject_rejected;
+                    return false;
+                }
+                
+                return TestDAL::putObject(requestID, inputData);
+            }
+            
+            DBObjectID rejectedObjectID;
+            std::atomic<bool> rejectionEnabled {true};
+            std::atomic<unsigned int> putObject_rejected;
+    };
+    
+    /** Waits until the cache has the expected number of uncommitted objects (up to 5 seconds). */
+    unsigned long waitForUncommittedObjects(DALCache & cache, unsigned long expectedObjects)
+    {
+        unsigned long currentObjects = cache.getCacheInformation().uncommittedObjects;
+        for(unsigned int i = 0; i < 500 && currentObjects != expectedObjects; i++)
+        {
+            waitFor(0.01);
+            currentObjects = cache.getCacheInformation().uncommittedObjects;
+        }
+        
+        return currentObjects;
+    }
+}
+
+SCENARIO("Only the rejected requests of a cache commit are retried", "[DALCache][DatabaseManagement]")
+{
+    GIVEN("a DALCache with a child DAL that rejects one of the committed objects")
+    {
+        std::string rawPassword = "passw0rd";
+        PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+        UserDataContainerPtr acceptedUser1(new UserDataContainer("user_1", password, UserAccessLevel::USER, false));
+        UserDataContainerPtr acceptedUser2(new UserDataContainer("user_2", password, UserAccessLevel::USER, false));
+        UserDataContainerPtr rejectedUser(new UserDataContainer("user_3", password, UserAccessLevel::USER, false));
+        
+        RejectingDAL * testDAL = new RejectingDAL(rejectedUser->getContainerID());
+        DALCache cache(DALPtr(testDAL), Utilities::FileLoggerPtr(), DALCache::DALCacheParameters
+        {
+            60,     //maxCommitTime
+            100,    //maxCommitUpdates
+            100,    //minCommitUpdates
+            false,  //alwaysEvict
+            false,  //clearObjectAge
+            100     //cacheSize
+        });
+        
+        cache.putObject(1, acceptedUser1);
+        cache.putObject(2, acceptedUser2);
+        cache.putObject(3, rejectedUser);
+        REQUIRE(waitForUncommittedObjects(cache, 3) == 3);
+        
+        WHEN("the cache is committed")
+        {
+            cache.commitCache();
+            
+            THEN("only the rejected object remains uncommitted and the accepted requests are completed")
+            {
+                CHECK(waitForUncommittedObjects(cache, 1) == 1);
+                CHECK(testDAL->putObject_rejected == 1);
+                CHECK(testDAL->putObject_received == 2);
+                CHECK(testDAL->putObject_completed == 2);
+                CHECK(cache.getCacheInformation().pendingCommitRequests == 0);
+            }
+            
+            AND_WHEN("the cache is committed again, after the DAL starts accepting the object")
+            {
+                REQUIRE(waitForUncommittedObjects(cache, 1) == 1);
+                testDAL->rejectionEnabled = false;
+                cache.commitCache();
+                
+                THEN("only the previously rejected object is sent again")
+                {
+                    CHECK(waitForUncommittedObjects(cache, 0) == 0);
+                    CHECK(testDAL->putObject_rejected == 1);
+                    CHECK(testDAL->putObject_received == 3);
+                    CHECK(testDAL->putObject_completed == 3);
+                    CHECK(testDAL->putObject_failed == 0);
+                    CHECK(cache.getCacheInformation().pendingCommitRequests == 0);
+                }
+            }
+        }
+    }
+}
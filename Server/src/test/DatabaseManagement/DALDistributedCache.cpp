@@ -0,0 +1,222 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/DatabaseManagement/DALDistributedCache.h"
+#include "../../main/DatabaseManagement/Containers/LogDataContainer.h"
+#include "../../main/DatabaseManagement/Containers/SystemDataContainer.h"
+#include "TestDAL.h"
+#include <unistd.h>
+#include <sys/wait.h>
+
+using SyncServer_Core::DatabaseManagement::DALDistributedCache;
+using DatabaseManagement_Containers::LogDataContainer;
+using DatabaseManagement_Containers::LogDataContainerPtr;
+using DatabaseManagement_Containers::SystemDataContainer;
+using DatabaseManagement_Containers::SystemDataContainerPtr;
+
+namespace
+{
+    /** Test client holding a TestDAL and a distributed cache attached to it. */
+    struct CacheClient
+    {
+        CacheClient(const DALDistributedCache::DALDistributedCacheParameters & params, DatabaseObjectType type = DatabaseObjectType::LOG)
+        : testDAL(new Testing::TestDAL(true, true, true, true, type, false)),
+          cache(new DALDistributedCache(DALPtr(testDAL), Utilities::FileLoggerPtr(), params))
+        {
+            cache->onSuccessEventAttach([this](DatabaseAbstractionLayerID, DatabaseRequestID, DataContainerPtr data)
+            {
+                boost::lock_guard<boost::mutex> resultLock(resultMutex);
+                result = data;
+                ++responses;
+                resultCondition.notify_all();
+            });
+            
+            cache->onFailureEventAttach([this](DatabaseAbstractionLayerID, DatabaseRequestID, DBObjectID, bool)
+            {
+                boost::lock_guard<boost::mutex> resultLock(resultMutex);
+                result = DataContainerPtr();
+                ++responses;
+                resultCondition.notify_all();
+            });
+        }
+        
+        DataContainerPtr getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue)
+        {
+            boost::unique_lock<boost::mutex> resultLock(resultMutex);
+            unsigned int expectedResponses = responses + 1;
+            cache->getObject(requestID, constraintType, constraintValue);
+            resultCondition.timed_wait(resultLock, boost::posix_time::seconds(5), [&](){ return responses >= expectedResponses; });
+            return result;
+        }
+        
+        bool writeObject(DatabaseRequestID requestID, DataContainerPtr object, bool isUpdate)
+        {
+            boost::unique_lock<boost::mutex> resultLock(resultMutex);
+            unsigned int expectedResponses = responses + 1;
+            
+            if(isUpdate)
+                cache->updateObject(requestID, object);
+            else
+                cache->putObject(requestID, object);
+            
+            resultCondition.timed_wait(resultLock, boost::posix_time::seconds(5), [&](){ return responses >= expectedResponses; });
+            return (result != nullptr);
+        }
+        
+        DataContainerPtr getLog(DatabaseRequestID requestID, Common_Types::LogID id)
+        {
+            return getObject(requestID, DatabaseSelectConstraints::LOGS::LIMIT_BY_ID, id);
+        }
+        
+        bool writeLog(DatabaseRequestID requestID, LogDataContainerPtr log, bool isUpdate)
+        {
+            return writeObject(requestID, log, isUpdate);
+        }
+        
+        Testing::TestDAL * testDAL;
+        boost::shared_ptr<DALDistributedCache> cache;
+        boost::mutex resultMutex;
+        boost::condition_variable resultCondition;
+        DataContainerPtr result;
+        unsigned int responses = 0;
+    };
+    
+    /**
+     * Runs the specified function in a new process.
+     *
+     * @param function the function to run; its result is used as the process exit code
+     * @return the exit code of the process or -1, if it did not exit normally
+     */
+    int runInChildProcess(std::function<int (void)> function)
+    {
+        pid_t child = fork();
+        if(child == 0)
+            _exit(function());
+        
+        int status = 0;
+        waitpid(child, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+}
+
+SCENARIO("Distributed caches share objects and invalidations between processes", "[DALDistributedCache][DatabaseManagement]")
+{
+    GIVEN("a DALDistributedCache holding an object retrieved by another process")
+    {
+        DALDistributedCache::DALDistributedCacheParameters params
+        {
+            "SyncServerTest_" + Convert::toString(getpid()),    //segmentName
+            64,                                                 //slotsNumber
+            2048,                                               //slotDataSize
+            8                                                   //maximumProbes
+        };
+        
+        DALDistributedCache::removeSegment(params.segmentName, DatabaseObjectType::LOG);
+        
+        LogDataContainerPtr testLog(new LogDataContainer(LogSeverity::Info, "DALDistributedCacheTest", boost::posix_time::second_clock::universal_time(), "test_message_1"));
+        
+        //the child writes and reads the log; the object is stored in the shared segment
+        int fillResult = runInChildProcess([&]()
+        {
+            CacheClient client(params);
+            bool written = client.writeLog(1, testLog, false);
+            bool retrieved = (client.getLog(2, testLog->getLogID()) != nullptr);
+            return (written && retrieved && client.cache->getCacheInformation().objectsStored == 1) ? 0 : 1;
+        });
+        
+        CHECK(fillResult == 0);
+        
+        CacheClient client(params);
+        REQUIRE(client.cache->getCacheInformation().cacheEnabled);
+        
+        WHEN("the object is requested by the current process")
+        {
+            auto result = boost::dynamic_pointer_cast<LogDataContainer>(client.getLog(1, testLog->getLogID()));
+            
+            THEN("it is retrieved from the shared segment, without using the DAL")
+            {
+                REQUIRE(result);
+                CHECK(result->getLogMessage() == "test_message_1");
+                CHECK(client.testDAL->getObject_received == 0);
+                CHECK(client.cache->getCacheInformation().cacheHits == 1);
+            }
+        }
+        
+        WHEN("the object is updated by another process")
+        {
+            int updateResult = runInChildProcess([&]()
+            {
+                //each process has its own TestDAL, so the object is added before it is updated
+                CacheClient otherClient(params);
+                bool added = otherClient.writeLog(1, testLog, false);
+                bool updated = otherClient.writeLog(2, testLog, true);
+                return (added && updated) ? 0 : 1;
+            });
+            
+            CHECK(updateResult == 0);
+            client.getLog(1, testLog->getLogID());
+            
+            THEN("the cached object is no longer used by the current process")
+            {
+                CHECK(client.testDAL->getObject_received == 1);
+                CHECK(client.cache->getCacheInformation().cacheMisses == 1);
+                CHECK(client.cache->getCacheInformation().cacheHits == 0);
+            }
+        }
+        
+        DALDistributedCache::removeSegment(params.segmentName, DatabaseObjectType::LOG);
+    }
+}
+
+SCENARIO("System settings are cached by a distributed cache", "[DALDistributedCache][DatabaseManagement]")
+{
+    GIVEN("a DALDistributedCache for system settings holding a parameter")
+    {
+        DALDistributedCache::DALDistributedCacheParameters params
+        {
+            "SyncServerTest_System_" + Convert::toString(getpid()),    //segmentName
+            64,                                                         //slotsNumber
+            2048,                                                       //slotDataSize
+            8                                                           //maximumProbes
+        };
+        
+        DALDistributedCache::removeSegment(params.segmentName, DatabaseObjectType::SYSTEM_SETTINGS);
+        
+        SystemDataContainerPtr testParameter(new SystemDataContainer(SystemParameterType::SESSION_TIMEOUT, 42UL));
+        CacheClient client(params, DatabaseObjectType::SYSTEM_SETTINGS);
+        REQUIRE(client.cache->getCacheInformation().cacheEnabled);
+        REQUIRE(client.writeObject(1, testParameter, false));
+        
+        WHEN("the parameter is requested twice by its ID")
+        {
+            DataContainerPtr firstResult = client.getObject(2, DatabaseSelectConstraints::SYSTEM::LIMIT_BY_TYPE, testParameter->getContainerID());
+            DataContainerPtr secondResult = client.getObject(3, DatabaseSelectConstraints::SYSTEM::LIMIT_BY_TYPE, testParameter->getContainerID());
+            
+            THEN("only the first request is sent to the DAL")
+            {
+                REQUIRE(firstResult);
+                REQUIRE(secondResult);
+                CHECK(secondResult->getContainerID() == testParameter->getContainerID());
+                CHECK(client.testDAL->getObject_received == 1);
+                CHECK(client.cache->getCacheInformation().cacheHits == 1);
+            }
+        }
+        
+        DALDistributedCache::removeSegment(params.segmentName, DatabaseObjectType::SYSTEM_SETTINGS);
+    }
+}
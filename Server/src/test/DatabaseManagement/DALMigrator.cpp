@@ -0,0 +1,269 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "TestDAL.h"
+#include <cstdio>
+#include <fstream>
+#include <boost/unordered_map.hpp>
+#include "../../main/DatabaseManagement/DatabaseManager.h"
+#include "../../main/DatabaseManagement/DALMigrator.h"
+
+using DatabaseManagement_Types::DatabaseManagerOperationMode;
+using DatabaseManagement_Types::DatabaseFailureAction;
+using DatabaseManagement_Types::DatabaseReadRoutingPolicy;
+using DatabaseManagement_Types::DALMigrationPhase;
+using SyncServer_Core::DatabaseManagement::DALMigrator;
+using Testing::TestDAL;
+
+namespace
+{
+    /** Creates a database manager without any DALs. */
+    SyncServer_Core::DatabaseManager * createDatabaseManager()
+    {
+        Utilities::FileLoggerParameters loggerParams
+        {
+            "./DALMigrator_DatabaseManager.log",    //logFilePath
+            32*1024*1024,                           //maximumFileSize
+            Utilities::FileLogSeverity::Error
+        };
+        
+        SyncServer_Core::DatabaseManagement::DALQueue::DALQueueParameters dqParams
+        {
+            DatabaseManagerOperationMode::PRPW,         //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,      //failureAction
+            5,                                          //maximumReadFailures
+            5,                                          //maximumWriteFailures
+            0,                                          //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,           //readRoutingPolicy
+            false,                                      //coalesceUpdates
+            1000,                                       //minimumReconnectDelay
+            30000,                                      //maximumReconnectDelay
+            0                                           //maximumSkippedWrites
+        };
+        
+        SyncServer_Core::DatabaseManagement::DALCache::DALCacheParameters dcParams(10, 5, 0, true, false, 10);
+        
+        return new SyncServer_Core::DatabaseManager(loggerParams, dqParams, dcParams, 5);
+    }
+    
+    /** Creates a new user with the specified name. */
+    UserDataContainerPtr createUser(const std::string & username)
+    {
+        std::string rawPassword = "passw0rd";
+        PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+        return UserDataContainerPtr(new UserDataContainer(username, password, UserAccessLevel::USER, false));
+    }
+    
+    /** Retrieves the phase of the only migration of the supplied migrator. */
+    DALMigrationPhase getMigrationPhase(const DALMigrator & migrator)
+    {
+        std::vector<DALMigrator::MigrationProgress> progress = migrator.getProgress();
+        return (progress.size() == 1) ? progress[0].phase : DALMigrationPhase::INVALID;
+    }
+}
+
+SCENARIO("A DAL is migrated while its data is being modified", "[DALMigrator][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with a source DAL holding twenty users and an empty target DAL")
+    {
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * sourceDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        sourceDAL->enableInjection(TestDAL::TestDALInjectionParameters{500, 0, 0.0, 1});
+        DALPtr sourcePtr(sourceDAL);
+        REQUIRE(manager->addDAL(sourcePtr));
+        
+        TestDAL * targetDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        targetDAL->enableInjection(TestDAL::TestDALInjectionParameters{2000, 0, 0.0, 1});
+        DALPtr targetPtr(targetDAL);
+        
+        std::vector<UserDataContainerPtr> users;
+        boost::unordered_map<DBObjectID, DataContainerPtr> expectedObjects;
+        for(unsigned int i = 0; i < 20; i++)
+        {
+            users.push_back(createUser("user_" + Convert::toString(i)));
+            REQUIRE(manager->Users().addUser(users.back()));
+            expectedObjects[users.back()->getUserID()] = users.back();
+        }
+        
+        WHEN("users are updated, removed and added during the migration")
+        {
+            DALMigrator migrator(*manager, Utilities::FileLoggerPtr(), DALMigrator::DALMigratorParameters{2, 2, 0, 5000, 5, ""});
+            REQUIRE(migrator.addMigration(sourcePtr, targetPtr));
+            REQUIRE(migrator.startMigrations());
+            
+            for(unsigned int i = 0; i < 5; i++)
+            {
+                UserDataContainerPtr updatedUser(new UserDataContainer(*users[i]));
+                updatedUser->setLockedState(true);
+                REQUIRE(manager->Users().updateUser(updatedUser));
+                expectedObjects[updatedUser->getUserID()] = updatedUser;
+            }
+            
+            for(unsigned int i = 5; i < 8; i++)
+            {
+                REQUIRE(manager->Users().removeUser(users[i]->getUserID()));
+                expectedObjects.erase(users[i]->getUserID());
+            }
+            
+            for(unsigned int i = 20; i < 23; i++)
+            {
+                UserDataContainerPtr newUser = createUser("user_" + Convert::toString(i));
+                REQUIRE(manager->Users().addUser(newUser));
+                expectedObjects[newUser->getUserID()] = newUser;
+            }
+            
+            AND_WHEN("writes that the source rejects are sent during the migration")
+            {
+                UserDataContainerPtr duplicateUser(new UserDataContainer(*users[10]));
+                duplicateUser->setLockedState(true);
+                bool duplicateResult = manager->Users().addUser(duplicateUser);
+                bool missingResult = manager->Users().updateUser(createUser("missing_user"));
+                bool migrationResult = migrator.waitForMigrations();
+                
+                THEN("the target holds the latest data confirmed by the source and replaces it")
+                {
+                    CHECK_FALSE(duplicateResult);
+                    CHECK_FALSE(missingResult);
+                    CHECK(migrationResult);
+                    CHECK(getMigrationPhase(migrator) == DALMigrationPhase::COMPLETED);
+                    CHECK(targetDAL->getStoredObjectsCount() == expectedObjects.size());
+                    
+                    for(auto currentObject : expectedObjects)
+                        CHECK(targetDAL->getStoredObject(currentObject.first) == currentObject.second);
+                    
+                    unsigned int sourceWrites = sourceDAL->putObject_received;
+                    REQUIRE(manager->Users().addUser(createUser("user_after_cutover")));
+                    CHECK(sourceDAL->putObject_received == sourceWrites);
+                    CHECK(targetDAL->getStoredObjectsCount() == (expectedObjects.size() + 1));
+                }
+            }
+        }
+        
+        delete manager;
+    }
+}
+
+SCENARIO("A migration fails when the target DAL cannot store the data", "[DALMigrator][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with a source DAL holding five users and a target DAL that rejects all writes")
+    {
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * sourceDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        sourceDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        DALPtr sourcePtr(sourceDAL);
+        REQUIRE(manager->addDAL(sourcePtr));
+        
+        TestDAL * targetDAL = new TestDAL(true, false, false, false, DatabaseObjectType::USER, false);
+        targetDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        DALPtr targetPtr(targetDAL);
+        
+        for(unsigned int i = 0; i < 5; i++)
+            REQUIRE(manager->Users().addUser(createUser("user_" + Convert::toString(i))));
+        
+        WHEN("the migration is run")
+        {
+            DALMigrator migrator(*manager, Utilities::FileLoggerPtr(), DALMigrator::DALMigratorParameters{2, 2, 0, 5000, 5, ""});
+            REQUIRE(migrator.addMigration(sourcePtr, targetPtr));
+            REQUIRE(migrator.startMigrations());
+            bool migrationResult = migrator.waitForMigrations();
+            
+            THEN("it fails and the source DAL remains in use")
+            {
+                CHECK_FALSE(migrationResult);
+                CHECK(getMigrationPhase(migrator) == DALMigrationPhase::FAILED);
+                CHECK(migrator.getProgress()[0].failedWrites == 5);
+                CHECK(targetDAL->getStoredObjectsCount() == 0);
+                
+                unsigned int targetWrites = targetDAL->putObject_received;
+                REQUIRE(manager->Users().addUser(createUser("user_after_failure")));
+                CHECK(sourceDAL->getStoredObjectsCount() == 6);
+                CHECK(targetDAL->putObject_received == targetWrites);
+            }
+        }
+        
+        delete manager;
+    }
+}
+
+SCENARIO("A migration is resumed from a checkpoint file", "[DALMigrator][DatabaseManagement]")
+{
+    GIVEN("a checkpoint file left by an interrupted snapshot and a target DAL holding some of the data")
+    {
+        std::string checkpointFilePath = "./DALMigrator_checkpoint";
+        {
+            std::ofstream checkpointFile(checkpointFilePath, std::ios::trunc);
+            checkpointFile << "USER SNAPSHOT 1" << std::endl;
+        }
+        
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * sourceDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        sourceDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        DALPtr sourcePtr(sourceDAL);
+        REQUIRE(manager->addDAL(sourcePtr));
+        
+        std::vector<UserDataContainerPtr> users;
+        for(unsigned int i = 0; i < 5; i++)
+        {
+            users.push_back(createUser("user_" + Convert::toString(i)));
+            REQUIRE(manager->Users().addUser(users.back()));
+        }
+        
+        TestDAL * targetDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        REQUIRE(targetDAL->putObject(1, users[0])); //responses are synchronous until injection is enabled
+        targetDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        DALPtr targetPtr(targetDAL);
+        
+        WHEN("the migration is run")
+        {
+            DALMigrator migrator(*manager, Utilities::FileLoggerPtr(), DALMigrator::DALMigratorParameters{2, 2, 0, 5000, 5, checkpointFilePath});
+            REQUIRE(migrator.addMigration(sourcePtr, targetPtr));
+            REQUIRE(migrator.startMigrations());
+            bool migrationResult = migrator.waitForMigrations();
+            
+            THEN("objects are updated in the target or inserted, if they are missing, and the checkpoint is completed")
+            {
+                CHECK(migrationResult);
+                CHECK(getMigrationPhase(migrator) == DALMigrationPhase::COMPLETED);
+                CHECK(targetDAL->updateObject_completed == 1);
+                CHECK(targetDAL->updateObject_failed == 4);
+                CHECK(targetDAL->putObject_completed == 5);
+                CHECK(targetDAL->getStoredObjectsCount() == 5);
+                
+                std::ifstream checkpointFile(checkpointFilePath);
+                std::string checkpointLine;
+                REQUIRE(std::getline(checkpointFile, checkpointLine));
+                CHECK(checkpointLine == "USER COMPLETED 5");
+                CHECK_FALSE(std::ifstream(checkpointFilePath + ".tmp").is_open());
+            }
+            
+            AND_WHEN("a new migrator is created with the same checkpoint file")
+            {
+                DALMigrator newMigrator(*manager, Utilities::FileLoggerPtr(), DALMigrator::DALMigratorParameters{2, 2, 0, 5000, 5, checkpointFilePath});
+                REQUIRE(newMigrator.addMigration(targetPtr, sourcePtr));
+                
+                THEN("the completed migration is skipped")
+                {
+                    CHECK(getMigrationPhase(newMigrator) == DALMigrationPhase::COMPLETED);
+                }
+            }
+        }
+        
+        delete manager;
+        std::remove(checkpointFilePath.c_str());
+    }
+}
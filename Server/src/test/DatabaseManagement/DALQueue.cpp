@@ -0,0 +1,700 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/DatabaseManagement/DALQueue.h"
+#include "TestDAL.h"
+
+using SyncServer_Core::DatabaseManagement::DALQueue;
+using Testing::TestDAL;
+
+namespace
+{
+    /** Test client for sending SELECT requests to a queue and waiting for their responses. */
+    struct QueueClient
+    {
+        QueueClient(DALQueue::DALQueueParameters params)
+        : queue(DatabaseObjectType::USER, Utilities::FileLoggerPtr(), params)
+        {
+            queue.onSuccessEventAttach([this](DatabaseRequestID requestID, DataContainerPtr)
+            {
+                boost::lock_guard<boost::mutex> resultLock(resultMutex);
+                successfulRequests.insert(requestID);
+                ++successes;
+                resultCondition.notify_all();
+            });
+            
+            queue.onFailureEventAttach([this](DatabaseRequestID, DBObjectID, bool)
+            {
+                boost::lock_guard<boost::mutex> resultLock(resultMutex);
+                ++failures;
+                resultCondition.notify_all();
+            });
+        }
+        
+        /** Sends the specified number of SELECT requests and waits for all responses. */
+        void select(unsigned int requests)
+        {
+            boost::unique_lock<boost::mutex> resultLock(resultMutex);
+            unsigned int expectedResponses = successes + failures + requests;
+            resultLock.unlock();
+            
+            for(unsigned int i = 0; i < requests; i++)
+                queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+            
+            resultLock.lock();
+            resultCondition.timed_wait(resultLock, boost::posix_time::seconds(5), [&](){ return successes + failures >= expectedResponses; });
+        }
+        
+        /** Waits until the specified total number of responses is received (up to 5 seconds). */
+        void waitForResponses(unsigned int expectedResponses)
+        {
+            boost::unique_lock<boost::mutex> resultLock(resultMutex);
+            resultCondition.timed_wait(resultLock, boost::posix_time::seconds(5), [&](){ return successes + failures >= expectedResponses; });
+        }
+        
+        /** Waits until the breaker of the specified DAL reaches the expected state (up to 5 seconds). */
+        DatabaseManagement_Types::DALBreakerState waitForBreaker(unsigned int dalIndex, DatabaseManagement_Types::DALBreakerState expectedState)
+        {
+            DatabaseManagement_Types::DALBreakerState currentState = queue.getDALsInformation()[dalIndex].breakerState;
+            for(unsigned int i = 0; i < 500 && currentState != expectedState; i++)
+            {
+                boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+                currentState = queue.getDALsInformation()[dalIndex].breakerState;
+            }
+            
+            return currentState;
+        }
+        
+        DALQueue queue;
+        boost::mutex resultMutex;
+        boost::condition_variable resultCondition;
+        unsigned int successes = 0;
+        unsigned int failures = 0;
+        boost::unordered_set<DatabaseRequestID> successfulRequests;
+    };
+    
+    TestDAL::TestDALInjectionParameters injection(double failureRate)
+    {
+        return TestDAL::TestDALInjectionParameters{1000, 0, failureRate, 1};
+    }
+}
+
+SCENARIO("DAL circuit breakers are opened, probed and closed", "[DALQueue][DatabaseManagement]")
+{
+    GIVEN("a DALQueue with INITIATE_RECONNECT failure action, a failing DAL and a healthy DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRCW,             //dbMode
+            DatabaseFailureAction::INITIATE_RECONNECT,      //failureAction
+            2,                                              //maximumReadFailures
+            2,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,               //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            100,                                            //minimumReconnectDelay
+            400,                                            //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * failingDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        TestDAL * healthyDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        failingDAL->enableInjection(injection(1.0));
+        healthyDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(failingDAL));
+        client.queue.addDAL(DALPtr(healthyDAL));
+        
+        WHEN("the maximum number of consecutive failures is reached")
+        {
+            client.select(1);
+            client.select(1);
+            
+            THEN("the breaker of the failing DAL is opened and new requests are rerouted")
+            {
+                CHECK(client.failures == 2);
+                CHECK(client.queue.getDALsInformation()[0].breakerState == DatabaseManagement_Types::DALBreakerState::OPEN);
+                CHECK(client.queue.getDALsInformation()[1].breakerState == DatabaseManagement_Types::DALBreakerState::CLOSED);
+                
+                unsigned int failingDALRequests = failingDAL->getObject_received;
+                client.select(3);
+                CHECK(client.successes == 3);
+                CHECK(failingDAL->getObject_received == failingDALRequests);
+            }
+            
+            THEN("the DAL is reconnected after the backoff delay and its breaker is opened again if the probe fails")
+            {
+                CHECK(client.waitForBreaker(0, DatabaseManagement_Types::DALBreakerState::HALF_OPEN) == DatabaseManagement_Types::DALBreakerState::HALF_OPEN);
+                CHECK(failingDAL->disconnect_calls == 1);
+                CHECK(failingDAL->connect_calls == 2);
+                
+                client.select(1);
+                CHECK(client.successes == 1); //the healthy DAL served the probe request too
+                CHECK(client.waitForBreaker(0, DatabaseManagement_Types::DALBreakerState::OPEN) == DatabaseManagement_Types::DALBreakerState::OPEN);
+                CHECK(client.queue.getDALsInformation()[0].reconnectAttempts == 1);
+            }
+            
+            THEN("the breaker is closed once a probe succeeds")
+            {
+                failingDAL->enableInjection(injection(0.0));
+                CHECK(client.waitForBreaker(0, DatabaseManagement_Types::DALBreakerState::HALF_OPEN) == DatabaseManagement_Types::DALBreakerState::HALF_OPEN);
+                
+                client.select(1);
+                CHECK(client.waitForBreaker(0, DatabaseManagement_Types::DALBreakerState::CLOSED) == DatabaseManagement_Types::DALBreakerState::CLOSED);
+                CHECK(client.queue.getDALsInformation()[0].reconnectAttempts == 0);
+                CHECK(failingDAL->getObject_completed == 1);
+            }
+            
+            THEN("the writes missed while the breaker is open are replayed before it is closed")
+            {
+                std::string rawPassword = "passw0rd";
+                PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+                UserDataContainerPtr user1(new UserDataContainer("user_1", password, UserAccessLevel::USER, false));
+                UserDataContainerPtr user2(new UserDataContainer("user_2", password, UserAccessLevel::USER, false));
+                
+                unsigned int failingDALWrites = failingDAL->putObject_received;
+                client.queue.addInsertRequest(user1);
+                client.queue.addInsertRequest(user2);
+                client.waitForResponses(4);
+                CHECK(client.successes == 2);
+                CHECK(failingDAL->putObject_received == failingDALWrites);
+                CHECK(healthyDAL->getStoredObjectsCount() == 2);
+                
+                failingDAL->enableInjection(injection(0.0));
+                CHECK(client.waitForBreaker(0, DatabaseManagement_Types::DALBreakerState::CLOSED) == DatabaseManagement_Types::DALBreakerState::CLOSED);
+                CHECK(failingDAL->getStoredObjectsCount() == 2);
+                CHECK(failingDAL->getStoredObject(user1->getUserID()));
+                CHECK(failingDAL->getStoredObject(user2->getUserID()));
+                CHECK(failingDAL->getObject_received == 2); //the DAL was not probed with reads before it was resynced
+            }
+        }
+    }
+    
+    GIVEN("a DALQueue with INITIATE_RECONNECT failure action and a single failing DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRPW,             //dbMode
+            DatabaseFailureAction::INITIATE_RECONNECT,      //failureAction
+            1,                                              //maximumReadFailures
+            1,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,               //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            60000,                                          //minimumReconnectDelay
+            60000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * failingDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        failingDAL->enableInjection(injection(1.0));
+        client.queue.addDAL(DALPtr(failingDAL));
+        
+        WHEN("the breaker of the DAL is open")
+        {
+            client.select(1);
+            client.select(2);
+            
+            THEN("new requests fail immediately, without being sent to the DAL")
+            {
+                CHECK(client.failures == 3);
+                CHECK(failingDAL->getObject_received == 1);
+                CHECK(client.queue.getDALsInformation()[0].breakerState == DatabaseManagement_Types::DALBreakerState::OPEN);
+                CHECK_FALSE(client.queue.getDALsInformation()[0].nextReconnectAttempt.is_not_a_date_time());
+            }
+        }
+    }
+    
+    GIVEN("a DALQueue with INITIATE_RECONNECT failure action, a missed writes limit, a failing DAL and a healthy DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRCW,             //dbMode
+            DatabaseFailureAction::INITIATE_RECONNECT,      //failureAction
+            2,                                              //maximumReadFailures
+            2,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,               //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            100,                                            //minimumReconnectDelay
+            400,                                            //maximumReconnectDelay
+            1                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * failingDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        TestDAL * healthyDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        failingDAL->enableInjection(injection(1.0));
+        healthyDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(failingDAL));
+        client.queue.addDAL(DALPtr(healthyDAL));
+        
+        WHEN("the DAL misses more writes than the limit while its breaker is open")
+        {
+            client.select(1);
+            client.select(1);
+            
+            std::string rawPassword = "passw0rd";
+            PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+            client.queue.addInsertRequest(UserDataContainerPtr(new UserDataContainer("user_1", password, UserAccessLevel::USER, false)));
+            client.queue.addInsertRequest(UserDataContainerPtr(new UserDataContainer("user_2", password, UserAccessLevel::USER, false)));
+            client.waitForResponses(4);
+            
+            THEN("the missed writes are dropped and the DAL is kept out of use until it is resynced")
+            {
+                CHECK(client.successes == 2);
+                CHECK(healthyDAL->getStoredObjectsCount() == 2);
+                CHECK(client.queue.getDALsInformation()[0].resyncRequired);
+                CHECK_FALSE(client.queue.getDALsInformation()[1].resyncRequired);
+                CHECK(client.queue.getDALsInformation()[0].breakerState == DatabaseManagement_Types::DALBreakerState::OPEN);
+                CHECK(client.queue.getDALsInformation()[0].nextReconnectAttempt.is_not_a_date_time());
+                
+                unsigned int failingDALConnects = failingDAL->connect_calls;
+                failingDAL->enableInjection(injection(0.0));
+                boost::this_thread::sleep(boost::posix_time::milliseconds(600));
+                CHECK(client.queue.getDALsInformation()[0].breakerState == DatabaseManagement_Types::DALBreakerState::OPEN);
+                CHECK(failingDAL->connect_calls == failingDALConnects);
+                CHECK(failingDAL->putObject_received == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("Expired and cancelled requests are not forwarded", "[DALQueue][DatabaseManagement]")
+{
+    GIVEN("a DALQueue with a single DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRPW,             //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,          //failureAction
+            5,                                              //maximumReadFailures
+            5,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,               //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            1000,                                           //minimumReconnectDelay
+            30000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * testDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        testDAL->enableInjection(TestDAL::TestDALInjectionParameters{200000, 0, 0.0, 1});
+        client.queue.addDAL(DALPtr(testDAL));
+        
+        WHEN("the deadline of a request passes before it is dispatched")
+        {
+            client.queue.suspendDispatch(1000);
+            client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()(), 0, 0,
+                                          boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(10));
+            waitFor(0.1);
+            client.queue.resumeDispatch();
+            waitFor(0.1);
+            
+            THEN("the request is dropped and fails")
+            {
+                CHECK(client.failures == 1);
+                CHECK(testDAL->getObject_received == 0);
+                CHECK(client.queue.getTotalExpiredRequests() == 1);
+            }
+        }
+        
+        WHEN("the request timeout is set")
+        {
+            client.queue.setRequestTimeout(10);
+            client.queue.suspendDispatch(1000);
+            client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+            waitFor(0.1);
+            client.queue.resumeDispatch();
+            waitFor(0.1);
+            
+            THEN("requests without an explicit deadline expire after the timeout")
+            {
+                CHECK(client.failures == 1);
+                CHECK(testDAL->getObject_received == 0);
+                CHECK(client.queue.getQueueInformation().totalExpiredRequests == 1);
+            }
+        }
+        
+        WHEN("a request is cancelled before it is dispatched")
+        {
+            client.queue.suspendDispatch(1000);
+            DatabaseRequestID requestID = client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+            bool cancelResult = client.queue.cancelRequest(requestID);
+            client.queue.resumeDispatch();
+            waitFor(0.5);
+            
+            THEN("the request is not sent to the DAL and no response is forwarded")
+            {
+                CHECK(cancelResult);
+                CHECK(testDAL->getObject_received == 0);
+                CHECK(client.successes + client.failures == 0);
+                CHECK(client.queue.getTotalCancelledRequests() == 1);
+            }
+        }
+        
+        WHEN("a request is cancelled after it is dispatched")
+        {
+            DatabaseRequestID requestID = client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+            waitFor(0.05);
+            bool cancelResult = client.queue.cancelRequest(requestID);
+            bool secondCancelResult = client.queue.cancelRequest(requestID);
+            waitFor(0.5);
+            
+            THEN("the request is completed by the DAL but no response is forwarded")
+            {
+                CHECK(cancelResult);
+                CHECK_FALSE(secondCancelResult);
+                CHECK(testDAL->getObject_completed == 1);
+                CHECK(client.successes + client.failures == 0);
+                CHECK(client.queue.getTotalCancelledRequests() == 1);
+                CHECK(client.queue.getNumberOfPendingRequests() == 0);
+            }
+        }
+        
+        WHEN("a request is cancelled after it is completed")
+        {
+            DatabaseRequestID requestID = client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+            client.waitForResponses(1);
+            bool cancelResult = client.queue.cancelRequest(requestID);
+            
+            THEN("the request is not cancelled")
+            {
+                CHECK_FALSE(cancelResult);
+                CHECK(client.successes + client.failures == 1);
+                CHECK(client.queue.getTotalCancelledRequests() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("Requests added to a full queue wait for free space", "[DALQueue][DatabaseManagement]")
+{
+    GIVEN("a DALQueue with a single DAL and a full requests queue")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRPW,             //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,          //failureAction
+            5,                                              //maximumReadFailures
+            5,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,               //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            1000,                                           //minimumReconnectDelay
+            30000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * testDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        testDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(testDAL));
+        
+        const unsigned int queueCapacity = 4096;
+        client.queue.suspendDispatch(1000);
+        for(unsigned int i = 0; i < queueCapacity; i++)
+            client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+        
+        WHEN("a new request is added")
+        {
+            std::atomic<bool> requestAdded(false);
+            boost::thread producer([&]()
+            {
+                client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+                requestAdded = true;
+            });
+            
+            waitFor(0.2);
+            bool requestAddedWhileFull = requestAdded;
+            client.queue.resumeDispatch();
+            bool producerFinished = producer.timed_join(boost::posix_time::seconds(5));
+            
+            THEN("the caller waits until the main thread frees space and the request is processed")
+            {
+                CHECK_FALSE(requestAddedWhileFull);
+                CHECK(producerFinished);
+                CHECK(requestAdded);
+                
+                for(unsigned int i = 0; i < 500 && testDAL->getObject_completed < (queueCapacity + 1); i++)
+                    waitFor(0.01);
+                
+                CHECK(testDAL->getObject_completed == (queueCapacity + 1));
+            }
+        }
+    }
+}
+
+SCENARIO("Reads are routed based on the read routing policy", "[DALQueue][DatabaseManagement]")
+{
+    GIVEN("a DALQueue with ROUND_ROBIN routing and three healthy DALs")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRCW,             //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,          //failureAction
+            5,                                              //maximumReadFailures
+            5,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::ROUND_ROBIN,         //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            1000,                                           //minimumReconnectDelay
+            30000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        std::vector<TestDAL *> testDALs;
+        for(unsigned int i = 0; i < 3; i++)
+        {
+            TestDAL * testDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+            testDAL->enableInjection(injection(0.0));
+            client.queue.addDAL(DALPtr(testDAL));
+            testDALs.push_back(testDAL);
+        }
+        
+        WHEN("SELECT requests are sent")
+        {
+            client.select(6);
+            
+            THEN("each request is sent to exactly one DAL and the requests are spread evenly")
+            {
+                CHECK(client.successes == 6);
+                CHECK(testDALs[0]->getObject_received == 2);
+                CHECK(testDALs[1]->getObject_received == 2);
+                CHECK(testDALs[2]->getObject_received == 2);
+            }
+        }
+    }
+    
+    GIVEN("a DALQueue with ROUND_ROBIN routing, a failing DAL and a healthy DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRCW,             //dbMode
+            DatabaseFailureAction::INITIATE_RECONNECT,      //failureAction
+            1,                                              //maximumReadFailures
+            1,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::ROUND_ROBIN,         //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            60000,                                          //minimumReconnectDelay
+            60000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * failingDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        TestDAL * healthyDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        failingDAL->enableInjection(injection(1.0));
+        healthyDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(failingDAL));
+        client.queue.addDAL(DALPtr(healthyDAL));
+        
+        WHEN("the breaker of the failing DAL is opened")
+        {
+            client.select(2);
+            REQUIRE(client.waitForBreaker(0, DatabaseManagement_Types::DALBreakerState::OPEN) == DatabaseManagement_Types::DALBreakerState::OPEN);
+            client.select(4);
+            
+            THEN("the unavailable DAL is skipped and all new reads are sent to the healthy DAL")
+            {
+                CHECK(failingDAL->getObject_received == 1);
+                CHECK(healthyDAL->getObject_received == 5);
+                CHECK(client.successes == 5);
+            }
+        }
+    }
+    
+    GIVEN("a DALQueue with LEAST_OUTSTANDING routing, a slow DAL and a fast DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRCW,             //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,          //failureAction
+            5,                                              //maximumReadFailures
+            5,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::LEAST_OUTSTANDING,   //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            1000,                                           //minimumReconnectDelay
+            30000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * slowDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        TestDAL * fastDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        slowDAL->enableInjection(TestDAL::TestDALInjectionParameters{500000, 0, 0.0, 1});
+        fastDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(slowDAL));
+        client.queue.addDAL(DALPtr(fastDAL));
+        
+        WHEN("new reads are sent while the slow DAL still has outstanding requests")
+        {
+            for(unsigned int i = 0; i < 8; i++)
+                client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+            
+            waitFor(0.1);
+            REQUIRE(slowDAL->getObject_received == 4);
+            REQUIRE(fastDAL->getObject_completed == 4);
+            client.select(4);
+            
+            THEN("the new reads are sent to the DAL with the fewest outstanding requests")
+            {
+                CHECK(slowDAL->getObject_received == 4);
+                CHECK(fastDAL->getObject_received == 8);
+            }
+        }
+    }
+    
+    GIVEN("a DALQueue with LOWEST_LATENCY routing, a slow DAL and a fast DAL")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRCW,             //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,          //failureAction
+            5,                                              //maximumReadFailures
+            5,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::LOWEST_LATENCY,      //readRoutingPolicy
+            false,                                          //coalesceUpdates
+            1000,                                           //minimumReconnectDelay
+            30000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * slowDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        TestDAL * fastDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        slowDAL->enableInjection(TestDAL::TestDALInjectionParameters{100000, 0, 0.0, 1});
+        fastDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(slowDAL));
+        client.queue.addDAL(DALPtr(fastDAL));
+        
+        WHEN("reads are sent after both DALs have latency samples")
+        {
+            client.select(2);
+            REQUIRE(slowDAL->getObject_received == 1);
+            REQUIRE(fastDAL->getObject_received == 1);
+            client.select(10);
+            
+            THEN("the new reads are sent to the DAL with the lowest latency")
+            {
+                CHECK(client.successes == 12);
+                CHECK(slowDAL->getObject_received == 1);
+                CHECK(fastDAL->getObject_received == 11);
+            }
+        }
+    }
+}
+
+SCENARIO("Queued UPDATE requests for the same object are coalesced", "[DALQueue][DatabaseManagement]")
+{
+    GIVEN("a DALQueue with UPDATE coalescing enabled and a single DAL holding two users")
+    {
+        QueueClient client(DALQueue::DALQueueParameters
+        {
+            DatabaseManagerOperationMode::PRPW,             //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,          //failureAction
+            5,                                              //maximumReadFailures
+            5,                                              //maximumWriteFailures
+            0,                                              //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,               //readRoutingPolicy
+            true,                                           //coalesceUpdates
+            1000,                                           //minimumReconnectDelay
+            30000,                                          //maximumReconnectDelay
+            0                                               //maximumSkippedWrites
+        });
+        
+        TestDAL * testDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        testDAL->enableInjection(injection(0.0));
+        client.queue.addDAL(DALPtr(testDAL));
+        
+        std::string rawPassword = "passw0rd";
+        PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+        UserDataContainerPtr user1(new UserDataContainer("user_1", password, UserAccessLevel::USER, false));
+        UserDataContainerPtr user2(new UserDataContainer("user_2", password, UserAccessLevel::USER, false));
+        client.queue.addInsertRequest(user1);
+        client.queue.addInsertRequest(user2);
+        client.waitForResponses(2);
+        REQUIRE(testDAL->putObject_completed == 2);
+        
+        WHEN("several UPDATE requests for the same object are queued before dispatch")
+        {
+            std::vector<DatabaseRequestID> updateRequests;
+            client.queue.suspendDispatch(1000);
+            for(unsigned int i = 0; i < 3; i++)
+                updateRequests.push_back(client.queue.addUpdateRequest(UserDataContainerPtr(new UserDataContainer(*user1))));
+            updateRequests.push_back(client.queue.addUpdateRequest(user2));
+            client.queue.resumeDispatch();
+            client.waitForResponses(6);
+            
+            THEN("they are merged into a single DAL request and every caller receives a response")
+            {
+                CHECK(testDAL->updateObject_received == 2);
+                CHECK(testDAL->updateObject_completed == 2);
+                CHECK(client.queue.getTotalCoalescedRequests() == 2);
+                CHECK(client.successes == 6);
+                CHECK(client.failures == 0);
+                
+                for(DatabaseRequestID currentRequest : updateRequests)
+                    CHECK(client.successfulRequests.count(currentRequest) == 1);
+            }
+        }
+        
+        WHEN("a SELECT request for the object is queued between two UPDATE requests")
+        {
+            client.queue.suspendDispatch(1000);
+            client.queue.addUpdateRequest(UserDataContainerPtr(new UserDataContainer(*user1)));
+            client.queue.addSelectRequest(DatabaseSelectConstraints::USERS::LIMIT_BY_ID, user1->getUserID());
+            client.queue.addUpdateRequest(UserDataContainerPtr(new UserDataContainer(*user1)));
+            client.queue.resumeDispatch();
+            client.waitForResponses(5);
+            
+            THEN("the UPDATE requests are not merged")
+            {
+                CHECK(testDAL->updateObject_received == 2);
+                CHECK(testDAL->getObject_received == 1);
+                CHECK(client.queue.getTotalCoalescedRequests() == 0);
+                CHECK(client.successes == 5);
+                CHECK(client.failures == 0);
+            }
+        }
+        
+        WHEN("an UPDATE request merged into another request is cancelled after dispatch")
+        {
+            testDAL->enableInjection(TestDAL::TestDALInjectionParameters{200000, 0, 0.0, 1});
+            client.queue.suspendDispatch(1000);
+            DatabaseRequestID firstRequest = client.queue.addUpdateRequest(UserDataContainerPtr(new UserDataContainer(*user1)));
+            DatabaseRequestID secondRequest = client.queue.addUpdateRequest(UserDataContainerPtr(new UserDataContainer(*user1)));
+            client.queue.resumeDispatch();
+            
+            for(unsigned int i = 0; i < 500 && testDAL->updateObject_received == 0; i++)
+                boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+            
+            REQUIRE(client.queue.getTotalCoalescedRequests() == 1);
+            bool cancelled = client.queue.cancelRequest(secondRequest);
+            client.waitForResponses(3);
+            boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+            
+            THEN("only the remaining caller receives a response")
+            {
+                CHECK(cancelled);
+                CHECK_FALSE(client.queue.cancelRequest(secondRequest));
+                CHECK(testDAL->updateObject_completed == 1);
+                CHECK(client.successes == 3);
+                CHECK(client.successfulRequests.count(firstRequest) == 1);
+                CHECK(client.successfulRequests.count(secondRequest) == 0);
+            }
+        }
+    }
+}
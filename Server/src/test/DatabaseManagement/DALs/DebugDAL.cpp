@@ -0,0 +1,259 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../BasicSpec.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <boost/algorithm/hex.hpp>
+#include "../../../main/DatabaseManagement/DALs/DebugDAL.h"
+
+using DatabaseManagement_DALs::DebugDAL;
+
+namespace
+{
+    /** Collects the responses of a DAL. */
+    struct ResponseCollector
+    {
+        ResponseCollector(DebugDAL & dal)
+        {
+            dal.onSuccessEventAttach([this](DatabaseAbstractionLayerID, DatabaseRequestID requestID, DataContainerPtr data)
+            {
+                boost::lock_guard<boost::mutex> responsesLock(responsesMutex);
+                responses[requestID] = data;
+                responsesCondition.notify_all();
+            });
+            
+            dal.onFailureEventAttach([this](DatabaseAbstractionLayerID, DatabaseRequestID requestID, DBObjectID, bool notFound)
+            {
+                boost::lock_guard<boost::mutex> responsesLock(responsesMutex);
+                responses[requestID] = DataContainerPtr();
+                notFoundResponses[requestID] = notFound;
+                responsesCondition.notify_all();
+            });
+        }
+        
+        /** Waits for the response to the specified request; an empty pointer denotes a failure. */
+        DataContainerPtr waitForResponse(DatabaseRequestID requestID)
+        {
+            boost::unique_lock<boost::mutex> responsesLock(responsesMutex);
+            responsesCondition.timed_wait(responsesLock, boost::posix_time::seconds(5),
+                    [&](){ return responses.find(requestID) != responses.end(); });
+            
+            return responses[requestID];
+        }
+        
+        boost::mutex responsesMutex;
+        boost::condition_variable responsesCondition;
+        boost::unordered_map<DatabaseRequestID, DataContainerPtr> responses;
+        boost::unordered_map<DatabaseRequestID, bool> notFoundResponses;
+    };
+    
+    UserDataContainerPtr createUser(const std::string & username)
+    {
+        std::string rawPassword = "passw0rd";
+        PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+        return UserDataContainerPtr(new UserDataContainer(username, password, UserAccessLevel::USER, false));
+    }
+    
+    std::string readFile(const std::string & path)
+    {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+SCENARIO("Data files written by older versions are converted", "[DebugDAL][DALs][DatabaseManagement]")
+{
+    GIVEN("a data file holding CSV entries")
+    {
+        std::string dataFilePath = "./DebugDAL_legacy.data";
+        std::string legacyFilePath = dataFilePath + ".legacy";
+        std::remove(legacyFilePath.c_str());
+        
+        UserDataContainerPtr legacyUser = createUser("user_1");
+        std::string legacyEntry = legacyUser->toString() + "," + legacyUser->getUsername()
+                + ",7061737377307264," + Convert::toString(legacyUser->getUserAccessLevel())
+                + "," + Convert::toString(legacyUser->getForcePasswordReset()) + "," + Convert::toString(legacyUser->isUserLocked())
+                + "," + Convert::toString(legacyUser->getCreationTimestamp())
+                + "," + Convert::toString(legacyUser->getLastSuccessfulAuthenticationTimestamp())
+                + "," + Convert::toString(legacyUser->getLastFailedAuthenticationTimestamp())
+                + "," + Convert::toString(legacyUser->getFailedAuthenticationAttempts());
+        
+        UserID malformedID = boost::uuids::random_generator()();
+        std::string legacyContent = "1\nU," + Convert::toString(legacyUser->getUserID()) + ";" + legacyEntry + "\n"
+                + "U," + Convert::toString(malformedID) + ";" + Convert::toString(malformedID) + ",USER,user_2\n";
+        
+        {
+            std::ofstream dataFile(dataFilePath, std::ios::trunc);
+            dataFile << legacyContent;
+        }
+        
+        WHEN("a DebugDAL is connected to the file")
+        {
+            DebugDAL dal("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER);
+            ResponseCollector collector(dal);
+            bool connected = dal.connect();
+            dal.getObject(1, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, legacyUser->getUserID());
+            UserDataContainerPtr result = boost::dynamic_pointer_cast<UserDataContainer>(collector.waitForResponse(1));
+            dal.getObject(2, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, malformedID);
+            DataContainerPtr malformedResult = collector.waitForResponse(2);
+            
+            THEN("the valid entries are loaded, the file is written in the current format and the original file is kept")
+            {
+                CHECK(connected);
+                REQUIRE(result);
+                CHECK(result->getUserID() == legacyUser->getUserID());
+                CHECK(result->getUsername() == "user_1");
+                CHECK(result->getUserAccessLevel() == UserAccessLevel::USER);
+                CHECK_FALSE(malformedResult);
+                
+                std::string currentSignature = DebugDAL::DATA_FILE_SIGNATURE + " " + Convert::toString(DebugDAL::DATA_FILE_VERSION);
+                CHECK(readFile(dataFilePath).compare(0, currentSignature.size(), currentSignature) == 0);
+                CHECK(readFile(legacyFilePath) == legacyContent);
+            }
+            
+            AND_WHEN("a new DebugDAL is connected to the converted file")
+            {
+                REQUIRE(dal.disconnect());
+                DebugDAL newDAL("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER);
+                ResponseCollector newCollector(newDAL);
+                REQUIRE(newDAL.connect());
+                newDAL.getObject(1, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, legacyUser->getUserID());
+                UserDataContainerPtr newResult = boost::dynamic_pointer_cast<UserDataContainer>(newCollector.waitForResponse(1));
+                
+                THEN("the converted entries are loaded")
+                {
+                    REQUIRE(newResult);
+                    CHECK(newResult->getUsername() == "user_1");
+                }
+            }
+        }
+        
+        std::remove(dataFilePath.c_str());
+        std::remove(legacyFilePath.c_str());
+    }
+}
+
+SCENARIO("Data files with an unsupported version are rejected", "[DebugDAL][DALs][DatabaseManagement]")
+{
+    GIVEN("a data file with a newer version")
+    {
+        std::string dataFilePath = "./DebugDAL_unsupported.data";
+        std::string unsupportedContent = DebugDAL::DATA_FILE_SIGNATURE + " " + Convert::toString(DebugDAL::DATA_FILE_VERSION + 1) + "\n1\n";
+        
+        {
+            std::ofstream dataFile(dataFilePath, std::ios::trunc);
+            dataFile << unsupportedContent;
+        }
+        
+        WHEN("a DebugDAL is connected to the file")
+        {
+            bool connected = false;
+            
+            {
+                DebugDAL dal("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER);
+                connected = dal.connect();
+            }
+            
+            THEN("the connection fails and the file is left unchanged")
+            {
+                CHECK_FALSE(connected);
+                CHECK(readFile(dataFilePath) == unsupportedContent);
+            }
+        }
+        
+        std::remove(dataFilePath.c_str());
+    }
+}
+
+SCENARIO("Data is stored and loaded by a DebugDAL", "[DebugDAL][DALs][DatabaseManagement]")
+{
+    GIVEN("a DebugDAL that stored a user")
+    {
+        std::string dataFilePath = "./DebugDAL_users.data";
+        std::remove(dataFilePath.c_str());
+        UserDataContainerPtr testUser = createUser("user_1");
+        
+        {
+            DebugDAL dal("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER);
+            ResponseCollector collector(dal);
+            REQUIRE(dal.connect());
+            dal.putObject(1, testUser);
+            REQUIRE(collector.waitForResponse(1));
+            REQUIRE(dal.disconnect());
+        }
+        
+        std::string currentSignature = DebugDAL::DATA_FILE_SIGNATURE + " " + Convert::toString(DebugDAL::DATA_FILE_VERSION);
+        CHECK(readFile(dataFilePath).compare(0, currentSignature.size(), currentSignature) == 0);
+        
+        WHEN("the user is requested from a new DebugDAL using the same file")
+        {
+            DebugDAL dal("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER);
+            ResponseCollector collector(dal);
+            REQUIRE(dal.connect());
+            dal.getObject(1, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, testUser->getUserID());
+            UserDataContainerPtr result = boost::dynamic_pointer_cast<UserDataContainer>(collector.waitForResponse(1));
+            
+            THEN("it is retrieved successfully")
+            {
+                REQUIRE(result);
+                CHECK(result->getUserID() == testUser->getUserID());
+                CHECK(result->getUsername() == "user_1");
+            }
+        }
+        
+        AND_GIVEN("an entry in the file that cannot be decoded")
+        {
+            UserID corruptedID = boost::uuids::random_generator()();
+            
+            {
+                std::ofstream dataFile(dataFilePath, std::ios::app);
+                dataFile << "U," << Convert::toString(corruptedID) << ";" << boost::algorithm::hex(std::string("corrupted")) << std::endl;
+            }
+            
+            WHEN("both users are requested")
+            {
+                DebugDAL dal("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER);
+                ResponseCollector collector(dal);
+                REQUIRE(dal.connect());
+                dal.getObject(1, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, corruptedID);
+                DataContainerPtr corruptedResult = collector.waitForResponse(1);
+                dal.getObject(2, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, testUser->getUserID());
+                DataContainerPtr validResult = collector.waitForResponse(2);
+                dal.getObject(3, DatabaseSelectConstraints::USERS::LIMIT_BY_ID, boost::uuids::random_generator()());
+                DataContainerPtr missingResult = collector.waitForResponse(3);
+                
+                THEN("only the request for the corrupted entry fails and it is not reported as a missing object")
+                {
+                    CHECK_FALSE(corruptedResult);
+                    CHECK(validResult);
+                    CHECK_FALSE(missingResult);
+                    
+                    boost::lock_guard<boost::mutex> responsesLock(collector.responsesMutex);
+                    CHECK(collector.responses.size() == 3);
+                    CHECK_FALSE(collector.notFoundResponses[1]);
+                    CHECK(collector.notFoundResponses[3]);
+                }
+            }
+        }
+        
+        std::remove(dataFilePath.c_str());
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../BasicSpec.h"
+#include "../../../main/DatabaseManagement/DALs/PartitionedLogStore.h"
+
+using DatabaseManagement_DALs::PartitionedLogStore;
+using DatabaseManagement_Containers::LogDataContainer;
+
+namespace
+{
+    Timestamp at(unsigned int hour, unsigned int minute)
+    {
+        return Timestamp(boost::gregorian::date(2015, 1, 1), boost::posix_time::hours(hour) + boost::posix_time::minutes(minute));
+    }
+}
+
+SCENARIO("Log entries are stored in time partitions", "[PartitionedLogStore][DALs][DatabaseManagement]")
+{
+    GIVEN("a PartitionedLogStore with one hour partitions and entries over three hours")
+    {
+        PartitionedLogStore store;
+        
+        LogDataContainerPtr log_1(new LogDataContainer(LogSeverity::Error, "SourceA", at(10, 5), "message_1"));
+        LogDataContainerPtr log_2(new LogDataContainer(LogSeverity::Info, "SourceA", at(10, 30), "message_2"));
+        LogDataContainerPtr log_3(new LogDataContainer(LogSeverity::Info, "SourceB", at(11, 15), "message_3"));
+        LogDataContainerPtr log_4(new LogDataContainer(LogSeverity::Warning, "SourceB", at(12, 45), "message_4"));
+        LogDataContainerPtr log_5(new LogDataContainer(LogSeverity::Error, "SourceA", at(12, 0), "message_5"));
+        
+        CHECK(store.insert(log_4));
+        CHECK(store.insert(log_1));
+        CHECK(store.insert(log_3));
+        CHECK(store.insert(log_2));
+        CHECK(store.insert(log_5));
+        CHECK_FALSE(store.insert(log_1));
+        
+        THEN("they are partitioned and retrieved in time order")
+        {
+            CHECK(store.size() == 5);
+            CHECK(store.getPartitionsCount() == 3);
+            
+            auto allLogs = store.select(DatabaseSelectConstraints::LOGS::GET_ALL, 0);
+            REQUIRE(allLogs.size() == 5);
+            CHECK(allLogs[0]->getLogID() == log_1->getLogID());
+            CHECK(allLogs[1]->getLogID() == log_2->getLogID());
+            CHECK(allLogs[2]->getLogID() == log_3->getLogID());
+            CHECK(allLogs[3]->getLogID() == log_5->getLogID());
+            CHECK(allLogs[4]->getLogID() == log_4->getLogID());
+            CHECK(allLogs[0]->getLogMessage() == "message_1");
+            
+            auto page = store.select(DatabaseSelectConstraints::LOGS::GET_ALL, 0, 3, 10);
+            REQUIRE(page.size() == 2);
+            CHECK(page[0]->getLogID() == log_5->getLogID());
+        }
+        
+        THEN("they can be retrieved by time range, severity and source")
+        {
+            auto rangeLogs = store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_TIME_RANGE, LogTimeRange(at(10, 30), at(12, 0)));
+            REQUIRE(rangeLogs.size() == 2);
+            CHECK(rangeLogs[0]->getLogID() == log_2->getLogID());
+            CHECK(rangeLogs[1]->getLogID() == log_3->getLogID());
+            
+            auto errorLogs = store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_SEVERITY, LogSeverity::Error);
+            REQUIRE(errorLogs.size() == 2);
+            CHECK(errorLogs[1]->getLogID() == log_5->getLogID());
+            
+            CHECK(store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_SOURCE, std::string("SourceB")).size() == 2);
+            CHECK(store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_SOURCE, std::string("SourceC")).empty());
+            CHECK_THROWS_AS(store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_ID, log_1->getLogID()), std::invalid_argument);
+        }
+        
+        WHEN("entries are updated and removed")
+        {
+            LogDataContainerPtr updatedLog(new LogDataContainer(log_3->getLogID(), LogSeverity::Debug, "SourceC", at(9, 0), "message_3_updated"));
+            CHECK(store.update(updatedLog));
+            CHECK(store.remove(log_4->getLogID()));
+            CHECK_FALSE(store.remove(log_4->getLogID()));
+            
+            THEN("the partitions reflect the changes")
+            {
+                CHECK(store.size() == 4);
+                CHECK(store.getPartitionsCount() == 3);
+                CHECK(store.find(log_3->getLogID())->getLogMessage() == "message_3_updated");
+                CHECK_FALSE(store.find(log_4->getLogID()));
+                CHECK(store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_SOURCE, std::string("SourceC")).size() == 1);
+                CHECK(store.select(DatabaseSelectConstraints::LOGS::LIMIT_BY_SEVERITY, LogSeverity::Info).size() == 1);
+            }
+        }
+        
+        WHEN("old partitions are dropped")
+        {
+            unsigned long droppedLogs = store.dropPartitionsBefore(at(11, 30));
+            
+            THEN("only the partitions before the limit are removed")
+            {
+                CHECK(droppedLogs == 2);
+                CHECK(store.size() == 3);
+                CHECK(store.getPartitionsCount() == 2);
+                CHECK_FALSE(store.find(log_1->getLogID()));
+                CHECK(store.find(log_3->getLogID()));
+            }
+            
+            THEN("the dropped entries are removed from the ID index")
+            {
+                CHECK_FALSE(store.update(log_2));
+                CHECK_FALSE(store.remove(log_2->getLogID()));
+                CHECK(store.insert(log_1));
+                CHECK(store.find(log_1->getLogID())->getLogMessage() == "message_1");
+                CHECK(store.size() == 4);
+            }
+        }
+    }
+    
+    GIVEN("a PartitionedLogStore with a partitions limit")
+    {
+        PartitionedLogStore store(PartitionedLogStore::DEFAULT_PARTITION_LENGTH, 2);
+        
+        WHEN("entries for more partitions are added")
+        {
+            LogDataContainerPtr firstLog(new LogDataContainer(LogSeverity::Info, "Source", at(1, 0), "message_1"));
+            store.insert(firstLog);
+            store.insert(LogDataContainerPtr(new LogDataContainer(LogSeverity::Info, "Source", at(2, 0), "message_2")));
+            store.insert(LogDataContainerPtr(new LogDataContainer(LogSeverity::Info, "Source", at(2, 10), "message_3")));
+            store.insert(LogDataContainerPtr(new LogDataContainer(LogSeverity::Info, "Source", at(3, 0), "message_4")));
+            
+            THEN("the oldest partitions are dropped")
+            {
+                CHECK(store.getPartitionsCount() == 2);
+                CHECK(store.size() == 3);
+                CHECK(store.select(DatabaseSelectConstraints::LOGS::GET_ALL, 0)[0]->getLogMessage() == "message_2");
+                CHECK_FALSE(store.find(firstLog->getLogID()));
+            }
+            
+            THEN("entries older than the retained partitions are rejected")
+            {
+                LogDataContainerPtr oldLog(new LogDataContainer(LogSeverity::Info, "Source", at(0, 30), "message_5"));
+                CHECK_FALSE(store.insert(oldLog));
+                CHECK_FALSE(store.insert(firstLog));
+                CHECK_FALSE(store.find(oldLog->getLogID()));
+                CHECK(store.size() == 3);
+                
+                LogDataContainerPtr newLog(new LogDataContainer(LogSeverity::Info, "Source", at(2, 30), "message_6"));
+                CHECK(store.insert(newLog));
+                CHECK(store.size() == 4);
+                
+                LogDataContainerPtr movedLog(new LogDataContainer(newLog->getLogID(), LogSeverity::Info, "Source", at(0, 45), "message_6"));
+                CHECK_FALSE(store.update(movedLog));
+                CHECK(store.find(newLog->getLogID())->getLogMessage() == "message_6");
+            }
+        }
+        
+        THEN("invalid partition lengths are rejected")
+        {
+            CHECK_THROWS_AS(PartitionedLogStore(0), std::invalid_argument);
+        }
+    }
+}
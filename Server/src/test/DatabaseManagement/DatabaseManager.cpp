@@ -0,0 +1,377 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "TestDAL.h"
+#include <boost/unordered_set.hpp>
+#include "../../main/DatabaseManagement/DatabaseManager.h"
+#include "../../main/DatabaseManagement/DALs/DebugDAL.h"
+
+using DatabaseManagement_Types::DatabaseManagerOperationMode;
+using DatabaseManagement_Types::DatabaseFailureAction;
+using DatabaseManagement_Types::DatabaseReadRoutingPolicy;
+using Testing::TestDAL;
+
+namespace
+{
+    /** Creates a database manager without any DALs. */
+    SyncServer_Core::DatabaseManager * createDatabaseManager()
+    {
+        Utilities::FileLoggerParameters loggerParams
+        {
+            "./DatabaseManager.log",            //logFilePath
+            32*1024*1024,                       //maximumFileSize
+            Utilities::FileLogSeverity::Error
+        };
+        
+        SyncServer_Core::DatabaseManagement::DALQueue::DALQueueParameters dqParams
+        {
+            DatabaseManagerOperationMode::PRPW,         //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,      //failureAction
+            5,                                          //maximumReadFailures
+            5,                                          //maximumWriteFailures
+            0,                                          //maximumBatchSize
+            DatabaseReadRoutingPolicy::FIRST,           //readRoutingPolicy
+            false,                                      //coalesceUpdates
+            1000,                                       //minimumReconnectDelay
+            30000,                                      //maximumReconnectDelay
+            0                                           //maximumSkippedWrites
+        };
+        
+        SyncServer_Core::DatabaseManagement::DALCache::DALCacheParameters dcParams(10, 5, 0, true, false, 10);
+        
+        return new SyncServer_Core::DatabaseManager(loggerParams, dqParams, dcParams, 5);
+    }
+    
+    /** Retrieves the IDs of the supplied users. */
+    boost::unordered_set<UserID> getUserIDs(const std::vector<UserDataContainerPtr> & users)
+    {
+        boost::unordered_set<UserID> result;
+        for(const UserDataContainerPtr & currentUser : users)
+            result.insert(currentUser->getUserID());
+        
+        return result;
+    }
+}
+
+SCENARIO("Pages are taken from the full result when a DAL ignores the requested offset", "[DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with a DAL that does not support paging and three users")
+    {
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * testDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        testDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(testDAL));
+        
+        std::string rawPassword = "passw0rd";
+        PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+        for(unsigned int i = 0; i < 3; i++)
+            REQUIRE(manager->Users().addUser(UserDataContainerPtr(new UserDataContainer("user_" + Convert::toString(i), password, UserAccessLevel::USER, false))));
+        
+        std::vector<UserDataContainerPtr> allUsers = manager->Users().getUsersPage(DatabaseSelectConstraints::USERS::GET_ALL, 0, 0, 10);
+        REQUIRE(allUsers.size() == 3);
+        
+        WHEN("pages smaller and larger than the full result are requested with an offset")
+        {
+            std::vector<UserDataContainerPtr> firstPage = manager->Users().getUsersPage(DatabaseSelectConstraints::USERS::GET_ALL, 0, 0, 2);
+            std::vector<UserDataContainerPtr> secondPage = manager->Users().getUsersPage(DatabaseSelectConstraints::USERS::GET_ALL, 0, 2, 2);
+            std::vector<UserDataContainerPtr> largePage = manager->Users().getUsersPage(DatabaseSelectConstraints::USERS::GET_ALL, 0, 1, 10);
+            std::vector<UserDataContainerPtr> emptyPage = manager->Users().getUsersPage(DatabaseSelectConstraints::USERS::GET_ALL, 0, 3, 10);
+            
+            THEN("the offset is applied to the full result")
+            {
+                REQUIRE(firstPage.size() == 2);
+                REQUIRE(secondPage.size() == 1);
+                CHECK(firstPage[0]->getUserID() == allUsers[0]->getUserID());
+                CHECK(firstPage[1]->getUserID() == allUsers[1]->getUserID());
+                CHECK(secondPage[0]->getUserID() == allUsers[2]->getUserID());
+                
+                REQUIRE(largePage.size() == 2);
+                CHECK(largePage[0]->getUserID() == allUsers[1]->getUserID());
+                CHECK(largePage[1]->getUserID() == allUsers[2]->getUserID());
+                
+                CHECK(emptyPage.empty());
+            }
+        }
+        
+        WHEN("all users are streamed in pages")
+        {
+            std::vector<UserDataContainerPtr> streamedUsers;
+            unsigned int pages = 0;
+            bool streamResult = manager->Users().streamUsers(DatabaseSelectConstraints::USERS::GET_ALL, 0, 2,
+                [&](const std::vector<UserDataContainerPtr> & page)
+                {
+                    pages++;
+                    streamedUsers.insert(streamedUsers.end(), page.begin(), page.end());
+                    return true;
+                });
+            
+            THEN("each user is received exactly once")
+            {
+                CHECK(streamResult);
+                CHECK(pages == 2);
+                CHECK(streamedUsers.size() == 3);
+                CHECK(getUserIDs(streamedUsers) == getUserIDs(allUsers));
+            }
+        }
+        
+        delete manager;
+    }
+}
+
+SCENARIO("System parameters are loaded only once, even if none are stored", "[DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with an empty system settings DAL")
+    {
+        std::string dataFilePath = "./DatabaseManager_system.data";
+        std::remove(dataFilePath.c_str());
+        
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        
+        std::atomic<unsigned int> reloads(0);
+        manager->System().onParameterChangeEventAttach([&](SystemParameterType type, SystemParametersSnapshotPtr)
+        {
+            if(type == SystemParameterType::INVALID)
+                ++reloads;
+        });
+        
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(
+            new DatabaseManagement_DALs::DebugDAL("./DebugDAL.log", dataFilePath, DatabaseObjectType::SYSTEM_SETTINGS)));
+        
+        WHEN("the parameters snapshot is retrieved several times")
+        {
+            SystemParametersSnapshotPtr firstSnapshot = manager->System().getSystemParametersSnapshot();
+            SystemParametersSnapshotPtr secondSnapshot = manager->System().getSystemParametersSnapshot();
+            SystemParametersSnapshotPtr thirdSnapshot = manager->System().getSystemParametersSnapshot();
+            
+            THEN("the empty snapshot is loaded from the database only once")
+            {
+                CHECK(reloads == 1);
+                CHECK(firstSnapshot == secondSnapshot);
+                CHECK(secondSnapshot == thirdSnapshot);
+            }
+        }
+        
+        delete manager;
+        std::remove(dataFilePath.c_str());
+    }
+}
+
+SCENARIO("System parameters that cannot be loaded are not reloaded on every read", "[DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with a failing system settings DAL")
+    {
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * systemDAL = new TestDAL(false, false, false, false, DatabaseObjectType::SYSTEM_SETTINGS, false);
+        systemDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(systemDAL));
+        
+        WHEN("the parameters snapshot is retrieved several times")
+        {
+            unsigned int requestsAfterAdd = systemDAL->getObject_received;
+            SystemParametersSnapshotPtr firstSnapshot = manager->System().getSystemParametersSnapshot();
+            SystemParametersSnapshotPtr secondSnapshot = manager->System().getSystemParametersSnapshot();
+            
+            THEN("the failed load is not retried until the retry interval elapses")
+            {
+                CHECK(requestsAfterAdd == 1);
+                CHECK(systemDAL->getObject_received == 1);
+                CHECK(firstSnapshot->size() == 0);
+                CHECK(firstSnapshot == secondSnapshot);
+            }
+        }
+        
+        delete manager;
+    }
+}
+
+SCENARIO("Aggregated statistics and their flush interval are persisted", "[DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with empty statistics and system settings DALs")
+    {
+        std::string statisticsFilePath = "./DatabaseManager_statistics.data";
+        std::string systemFilePath = "./DatabaseManager_system.data";
+        std::remove(statisticsFilePath.c_str());
+        std::remove(systemFilePath.c_str());
+        
+        auto addDALs = [&](SyncServer_Core::DatabaseManager * manager)
+        {
+            manager->addDAL(DatabaseManagement_Interfaces::DALPtr(
+                new DatabaseManagement_DALs::DebugDAL("./DebugDAL.log", statisticsFilePath, DatabaseObjectType::STATISTICS)));
+            manager->addDAL(DatabaseManagement_Interfaces::DALPtr(
+                new DatabaseManagement_DALs::DebugDAL("./DebugDAL.log", systemFilePath, DatabaseObjectType::SYSTEM_SETTINGS)));
+        };
+        
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        addDALs(manager);
+        
+        WHEN("statistics are flushed several times and the flush interval is changed")
+        {
+            manager->Statistics().incrementTotalTransferredData(5);
+            bool firstFlushResult = manager->Statistics().flushStatistics();
+            manager->Statistics().incrementTotalTransferredData(3);
+            bool secondFlushResult = manager->Statistics().flushStatistics();
+            vector<StatisticDataContainerPtr> storedStatistics = manager->Statistics().getAllStatistics();
+            
+            bool intervalResult = manager->System().setDBCacheFlushInterval(120);
+            unsigned long updatedInterval = manager->Statistics().getAggregatorInformation().flushInterval;
+            
+            THEN("the stored statistic is inserted once and then updated")
+            {
+                CHECK(firstFlushResult);
+                CHECK(secondFlushResult);
+                REQUIRE(storedStatistics.size() == 1);
+                CHECK(storedStatistics[0]->getStatisticType() == StatisticType::TOTAL_TRANSFERRED_DATA);
+                CHECK(manager->Statistics().getAggregatorInformation().failedStores == 0);
+                CHECK(intervalResult);
+                CHECK(updatedInterval == 120);
+            }
+            
+            THEN("a new manager uses the persisted values")
+            {
+                delete manager;
+                manager = createDatabaseManager();
+                unsigned long defaultInterval = SyncServer_Core::DatabaseManager::Functions_Statistics::DEFAULT_FLUSH_INTERVAL;
+                CHECK(manager->Statistics().getAggregatorInformation().flushInterval == defaultInterval);
+                
+                addDALs(manager);
+                CHECK(manager->Statistics().getAggregatorInformation().flushInterval == 120);
+                CHECK(manager->Statistics().getTotalTransferredData() == 8);
+                CHECK(manager->Statistics().getTotalNumberOfTransferredFiles() == 0);
+            }
+        }
+        
+        delete manager;
+        std::remove(statisticsFilePath.c_str());
+        std::remove(systemFilePath.c_str());
+    }
+}
+
+SCENARIO("Old logs are dropped through the logs functions", "[DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with a log DAL holding logs over three hours")
+    {
+        std::string dataFilePath = "./DatabaseManager_logs.data";
+        std::remove(dataFilePath.c_str());
+        
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(
+            new DatabaseManagement_DALs::DebugDAL("./DebugDAL.log", dataFilePath, DatabaseObjectType::LOG)));
+        
+        boost::gregorian::date logsDate(2015, 1, 1);
+        LogDataContainerPtr newestLog(new LogDataContainer(LogSeverity::Info, "Source", Timestamp(logsDate, boost::posix_time::hours(12)), "message_3"));
+        CHECK(manager->Logs().addLog(LogDataContainerPtr(new LogDataContainer(LogSeverity::Info, "Source", Timestamp(logsDate, boost::posix_time::hours(10)), "message_1"))));
+        CHECK(manager->Logs().addLog(LogDataContainerPtr(new LogDataContainer(LogSeverity::Info, "Source", Timestamp(logsDate, boost::posix_time::hours(11)), "message_2"))));
+        CHECK(manager->Logs().addLog(newestLog));
+        
+        WHEN("the logs before the newest one are dropped")
+        {
+            unsigned long droppedLogs = manager->Logs().dropLogsBefore(newestLog->getLogTimestamp());
+            vector<LogDataContainerPtr> remainingLogs = manager->Logs().getLogs();
+            
+            THEN("only the newest log is kept")
+            {
+                CHECK(droppedLogs == 2);
+                REQUIRE(remainingLogs.size() == 1);
+                CHECK(remainingLogs[0]->getLogID() == newestLog->getLogID());
+            }
+        }
+        
+        delete manager;
+        std::remove(dataFilePath.c_str());
+    }
+}
+
+SCENARIO("Only missing users are added to the negative cache", "[DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a DatabaseManager with a users DAL that does not hold the requested user")
+    {
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * testDAL = new TestDAL(true, true, true, true, DatabaseObjectType::USER, false);
+        testDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(testDAL));
+        
+        WHEN("the user is requested twice")
+        {
+            UserDataContainerPtr firstResult = manager->Users().getUser("missing_user");
+            UserDataContainerPtr secondResult = manager->Users().getUser("missing_user");
+            
+            THEN("the second request is answered by the negative cache")
+            {
+                CHECK_FALSE(firstResult);
+                CHECK_FALSE(secondResult);
+                CHECK(testDAL->getObject_received == 1);
+            }
+        }
+        
+        delete manager;
+    }
+    
+    GIVEN("a DatabaseManager with an empty users DAL")
+    {
+        std::string dataFilePath = "./DatabaseManager_users.data";
+        std::remove(dataFilePath.c_str());
+        
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(
+            new DatabaseManagement_DALs::DebugDAL("./DebugDAL.log", dataFilePath, DatabaseObjectType::USER)));
+        
+        WHEN("a missing user is requested twice by name and twice by ID")
+        {
+            UserID missingUserID = boost::uuids::random_generator()();
+            manager->Users().getUser("missing_user");
+            manager->Users().getUser("missing_user");
+            manager->Users().getUser(missingUserID);
+            manager->Users().getUser(missingUserID);
+            
+            THEN("the cache information covers both the usernames and the user IDs caches")
+            {
+                auto cacheInfo = manager->Users().getNegativeCacheInformation();
+                CHECK(cacheInfo.size == 2);
+                CHECK(cacheInfo.hits == 2);
+                CHECK(cacheInfo.misses == 2);
+                CHECK(cacheInfo.evictions == 0);
+            }
+        }
+        
+        delete manager;
+        std::remove(dataFilePath.c_str());
+    }
+    
+    GIVEN("a DatabaseManager with a users DAL that fails all requests")
+    {
+        SyncServer_Core::DatabaseManager * manager = createDatabaseManager();
+        TestDAL * testDAL = new TestDAL(false, true, true, true, DatabaseObjectType::USER, false);
+        testDAL->enableInjection(TestDAL::TestDALInjectionParameters{0, 0, 0.0, 1});
+        manager->addDAL(DatabaseManagement_Interfaces::DALPtr(testDAL));
+        
+        WHEN("the user is requested twice")
+        {
+            UserDataContainerPtr firstResult = manager->Users().getUser("missing_user");
+            UserDataContainerPtr secondResult = manager->Users().getUser("missing_user");
+            
+            THEN("the failures are not cached and both requests reach the DAL")
+            {
+                CHECK_FALSE(firstResult);
+                CHECK_FALSE(secondResult);
+                CHECK(testDAL->getObject_received == 2);
+            }
+        }
+        
+        delete manager;
+    }
+}
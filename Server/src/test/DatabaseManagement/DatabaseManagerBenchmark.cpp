@@ -0,0 +1,289 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "TestDAL.h"
+#include <algorithm>
+#include <boost/uuid/uuid_generators.hpp>
+#include "../../main/DatabaseManagement/DatabaseManager.h"
+
+using DatabaseManagement_Types::DatabaseManagerOperationMode;
+using DatabaseManagement_Types::DatabaseFailureAction;
+using DatabaseManagement_Types::DatabaseReadRoutingPolicy;
+using DatabaseManagement_Containers::DeviceDataContainer;
+using DatabaseManagement_Containers::SessionDataContainer;
+using DatabaseManagement_Containers::LogDataContainer;
+using Testing::TestDAL;
+
+namespace
+{
+    /** Benchmark configuration. */
+    struct BenchmarkParameters
+    {
+        unsigned int threads;                                   //number of concurrent callers
+        unsigned int operationsPerThread;                       //number of operations performed by each caller
+        TestDAL::TestDALInjectionParameters injection;          //latency and failure injection for each DAL
+    };
+    
+    /** Benchmark results for a single workload. */
+    struct BenchmarkResult
+    {
+        unsigned long operations;   //number of completed operations
+        unsigned long failures;     //number of operations that returned a failure
+        double operationsPerSecond; //throughput
+        long p50;                   //median latency (in microseconds)
+        long p99;                   //99th percentile latency (in microseconds)
+        long p999;                  //99.9th percentile latency (in microseconds)
+        double averageQueueDepth;   //average number of new and pending requests in the queue
+        unsigned long maxQueueDepth;//maximum number of new and pending requests in the queue
+    };
+    
+    /** Retrieves the specified percentile from a sorted set of latencies. */
+    long getPercentile(const std::vector<long> & sortedLatencies, double percentile)
+    {
+        if(sortedLatencies.empty())
+            return 0;
+        
+        std::size_t index = static_cast<std::size_t>(percentile * (sortedLatencies.size() - 1));
+        return sortedLatencies[index];
+    }
+    
+    /** Creates a database manager with the specified number of TestDALs for each benchmarked table. */
+    SyncServer_Core::DatabaseManager * createDatabaseManager(DatabaseManagerOperationMode mode, unsigned int dalsNumber,
+                                                             const TestDAL::TestDALInjectionParameters & injection)
+    {
+        Utilities::FileLoggerParameters loggerParams
+        {
+            "./DatabaseManagerBenchmark.log",   //logFilePath
+            32*1024*1024,                       //maximumFileSize
+            Utilities::FileLogSeverity::Error
+        };
+        
+        SyncServer_Core::DatabaseManagement::DALQueue::DALQueueParameters dqParams
+        {
+            mode,                                       //dbMode
+            DatabaseFailureAction::IGNORE_FAILURE,      //failureAction
+            5,                                          //maximumReadFailures
+            5,                                          //maximumWriteFailures
+            0,                                          //maximumBatchSize
+            DatabaseReadRoutingPolicy::ROUND_ROBIN,     //readRoutingPolicy
+            true,                                       //coalesceUpdates
+            1000,                                       //minimumReconnectDelay
+            30000,                                      //maximumReconnectDelay
+            0                                           //maximumSkippedWrites
+        };
+        
+        SyncServer_Core::DatabaseManagement::DALCache::DALCacheParameters dcParams(10, 5, 0, true, false, 10);
+        
+        SyncServer_Core::DatabaseManager * manager = new SyncServer_Core::DatabaseManager(loggerParams, dqParams, dcParams, 5);
+        
+        for(DatabaseObjectType currentType : {DatabaseObjectType::USER, DatabaseObjectType::DEVICE, DatabaseObjectType::SESSION, DatabaseObjectType::LOG})
+        {
+            for(unsigned int i = 0; i < dalsNumber; i++)
+            {
+                TestDAL * dal = new TestDAL(true, true, true, true, currentType, false);
+                dal->enableInjection(injection);
+                manager->addDAL(DatabaseManagement_Interfaces::DALPtr(dal));
+            }
+        }
+        
+        return manager;
+    }
+    
+    /**
+     * Runs the specified operation from multiple threads and measures its latency, the
+     * overall throughput and the depth of the associated queue.
+     */
+    BenchmarkResult runWorkload(SyncServer_Core::DatabaseManager & manager, DatabaseObjectType queueType,
+                                const BenchmarkParameters & parameters, std::function<bool(unsigned int, unsigned int)> operation)
+    {
+        std::vector<std::vector<long>> threadLatencies(parameters.threads);
+        std::atomic<unsigned long> failures {0};
+        std::atomic<bool> workloadDone {false};
+        unsigned long depthSamples = 0;
+        unsigned long totalDepth = 0;
+        unsigned long maxDepth = 0;
+        
+        boost::thread depthSampler([&]()
+        {
+            while(!workloadDone)
+            {
+                auto queueInfo = manager.getQueueInformation(queueType);
+                unsigned long currentDepth = queueInfo.newRequests + queueInfo.pendingRequests;
+                totalDepth += currentDepth;
+                maxDepth = std::max(maxDepth, currentDepth);
+                ++depthSamples;
+                boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+            }
+        });
+        
+        boost::posix_time::ptime workloadStart = boost::posix_time::microsec_clock::universal_time();
+        
+        std::vector<boost::thread *> threads;
+        for(unsigned int i = 0; i < parameters.threads; i++)
+        {
+            threads.push_back(new boost::thread([&, i]()
+            {
+                std::vector<long> & latencies = threadLatencies[i];
+                latencies.reserve(parameters.operationsPerThread);
+                
+                for(unsigned int j = 0; j < parameters.operationsPerThread; j++)
+                {
+                    boost::posix_time::ptime operationStart = boost::posix_time::microsec_clock::universal_time();
+                    if(!operation(i, j))
+                        ++failures;
+                    
+                    latencies.push_back((boost::posix_time::microsec_clock::universal_time() - operationStart).total_microseconds());
+                }
+            }));
+        }
+        
+        for(boost::thread * currentThread : threads)
+        {
+            currentThread->join();
+            delete currentThread;
+        }
+        
+        boost::posix_time::time_duration workloadTime = boost::posix_time::microsec_clock::universal_time() - workloadStart;
+        workloadDone = true;
+        depthSampler.join();
+        
+        std::vector<long> latencies;
+        for(const std::vector<long> & currentLatencies : threadLatencies)
+            latencies.insert(latencies.end(), currentLatencies.begin(), currentLatencies.end());
+        
+        std::sort(latencies.begin(), latencies.end());
+        
+        double seconds = std::max(workloadTime.total_microseconds(), (boost::posix_time::time_duration::tick_type)1) / 1000000.0;
+        
+        return BenchmarkResult
+        {
+            latencies.size(),
+            failures,
+            latencies.size() / seconds,
+            getPercentile(latencies, 0.5),
+            getPercentile(latencies, 0.99),
+            getPercentile(latencies, 0.999),
+            (depthSamples > 0) ? (double)totalDepth / depthSamples : 0.0,
+            maxDepth
+        };
+    }
+    
+    /** Reports the specified workload results. */
+    void reportResult(const std::string & workload, DatabaseManagerOperationMode mode, unsigned int dalsNumber, const BenchmarkResult & result)
+    {
+        WARN(workload << " / " << Convert::toString(mode) << " / " << dalsNumber << " DAL(s): "
+             << "ops [" << result.operations << "]; failed [" << result.failures << "]; "
+             << "throughput [" << (unsigned long)result.operationsPerSecond << " ops/s]; "
+             << "latency p50/p99/p999 [" << result.p50 << "/" << result.p99 << "/" << result.p999 << " us]; "
+             << "queue depth avg/max [" << result.averageQueueDepth << "/" << result.maxQueueDepth << "]");
+    }
+}
+
+SCENARIO("DatabaseManager throughput and latency are measured", "[.][benchmark][DatabaseManager][DatabaseManagement]")
+{
+    GIVEN("a set of benchmark parameters")
+    {
+        BenchmarkParameters parameters
+        {
+            8,      //threads
+            250,    //operationsPerThread
+            {
+                200,    //latency
+                100,    //jitter
+                0.01,   //failureRate
+                4       //threads
+            }
+        };
+        
+        std::string rawPassword = "passw0rd";
+        PasswordData password(reinterpret_cast<const unsigned char *>(rawPassword.data()), rawPassword.size());
+        
+        WHEN("the users, devices, sessions and logs functions are driven in each operation mode and with different numbers of DALs")
+        {
+            for(DatabaseManagerOperationMode currentMode : {DatabaseManagerOperationMode::PRPW, DatabaseManagerOperationMode::PRCW, DatabaseManagerOperationMode::CRCW})
+            {
+                for(unsigned int currentDALsNumber : {1, 2, 4})
+                {
+                    SyncServer_Core::DatabaseManager * manager = createDatabaseManager(currentMode, currentDALsNumber, parameters.injection);
+                    std::vector<std::vector<UserID>> userIDs(parameters.threads);
+                    std::vector<std::vector<DeviceID>> deviceIDs(parameters.threads);
+                    std::vector<std::vector<SessionID>> sessionIDs(parameters.threads);
+                    
+                    //even operations add new objects; odd operations retrieve the object added by the previous one
+                    reportResult("Users", currentMode, currentDALsNumber,
+                        runWorkload(*manager, DatabaseObjectType::USER, parameters, [&](unsigned int thread, unsigned int operation)
+                        {
+                            if(operation % 2 == 0)
+                            {
+                                UserDataContainerPtr user(new UserDataContainer("user_" + Convert::toString(thread) + "_" + Convert::toString(operation),
+                                                                                password, UserAccessLevel::USER, false));
+                                userIDs[thread].push_back(user->getUserID());
+                                return manager->Users().addUser(user);
+                            }
+                            else
+                                return (manager->Users().getUser(userIDs[thread].back()) != nullptr);
+                        }));
+                    
+                    reportResult("Devices", currentMode, currentDALsNumber,
+                        runWorkload(*manager, DatabaseObjectType::DEVICE, parameters, [&](unsigned int thread, unsigned int operation)
+                        {
+                            if(operation % 2 == 0)
+                            {
+                                DeviceDataContainerPtr device(new DeviceDataContainer("device_" + Convert::toString(thread) + "_" + Convert::toString(operation),
+                                                                                      password, boost::uuids::random_generator()(),
+                                                                                      DataTransferType::PUSH, PeerType::CLIENT));
+                                deviceIDs[thread].push_back(device->getDeviceID());
+                                return manager->Devices().addDevice(device);
+                            }
+                            else
+                                return (manager->Devices().getDevice(deviceIDs[thread].back()) != nullptr);
+                        }));
+                    
+                    reportResult("Sessions", currentMode, currentDALsNumber,
+                        runWorkload(*manager, DatabaseObjectType::SESSION, parameters, [&](unsigned int thread, unsigned int operation)
+                        {
+                            if(operation % 2 == 0)
+                            {
+                                SessionDataContainerPtr session(new SessionDataContainer(SessionType::COMMAND, boost::uuids::random_generator()(),
+                                                                                         boost::uuids::random_generator()(), false));
+                                sessionIDs[thread].push_back(session->getSessionID());
+                                return manager->Sessions().addSession(session);
+                            }
+                            else
+                                return (manager->Sessions().getSession(sessionIDs[thread].back()) != nullptr);
+                        }));
+                    
+                    reportResult("Logs", currentMode, currentDALsNumber,
+                        runWorkload(*manager, DatabaseObjectType::LOG, parameters, [&](unsigned int thread, unsigned int operation)
+                        {
+                            return manager->Logs().addLog(LogDataContainerPtr(new LogDataContainer(LogSeverity::Info, "DatabaseManagerBenchmark",
+                                                                                                   boost::posix_time::microsec_clock::universal_time(),
+                                                                                                   "message_" + Convert::toString(operation))));
+                        }));
+                    
+                    delete manager;
+                }
+            }
+            
+            THEN("the results are reported")
+            {
+                SUCCEED();
+            }
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/DatabaseManagement/NegativeResultCache.h"
+#include <string>
+
+using SyncServer_Core::DatabaseManagement::NegativeResultCache;
+
+SCENARIO("Missing keys are cached until they expire or are invalidated", "[NegativeResultCache][DatabaseManagement]")
+{
+    GIVEN("a NegativeResultCache with a small size limit")
+    {
+        NegativeResultCache<std::string> cache(100, 60);
+        
+        WHEN("missing keys are added")
+        {
+            cache.add("user_1", cache.getGeneration());
+            cache.add("user_2", cache.getGeneration());
+            
+            THEN("they are found in the cache")
+            {
+                CHECK(cache.contains("user_1"));
+                CHECK(cache.contains("user_2"));
+                CHECK_FALSE(cache.contains("user_3"));
+                CHECK(cache.getCacheInformation().hits == 2);
+                CHECK(cache.getCacheInformation().misses == 1);
+            }
+            
+            AND_WHEN("a key is invalidated")
+            {
+                cache.invalidate("user_1");
+                
+                THEN("only that key is removed")
+                {
+                    CHECK_FALSE(cache.contains("user_1"));
+                    CHECK(cache.contains("user_2"));
+                }
+            }
+        }
+        
+        WHEN("a key is invalidated while its lookup is in progress")
+        {
+            unsigned long lookupGeneration = cache.getGeneration();
+            cache.invalidate("user_1");
+            cache.add("user_1", lookupGeneration);
+            
+            THEN("the stale result is not cached")
+            {
+                CHECK_FALSE(cache.contains("user_1"));
+                CHECK(cache.getCacheInformation().size == 0);
+            }
+        }
+        
+        WHEN("a flood of missing keys is added")
+        {
+            for(unsigned int i = 0; i < 1000; i++)
+                cache.add("unknown_user_" + std::to_string(i), cache.getGeneration());
+            
+            THEN("the size limit is kept by evicting the oldest keys")
+            {
+                CHECK(cache.getCacheInformation().size == 100);
+                CHECK(cache.getCacheInformation().evictions == 900);
+                CHECK_FALSE(cache.contains("unknown_user_0"));
+                CHECK(cache.contains("unknown_user_999"));
+            }
+        }
+    }
+    
+    GIVEN("a NegativeResultCache with a short entry age")
+    {
+        NegativeResultCache<std::string> cache(100, 1);
+        cache.add("user_1", cache.getGeneration());
+        
+        WHEN("the entry age elapses")
+        {
+            waitFor(2);
+            
+            THEN("the key is no longer cached")
+            {
+                CHECK_FALSE(cache.contains("user_1"));
+            }
+        }
+    }
+    
+    GIVEN("a disabled NegativeResultCache")
+    {
+        NegativeResultCache<std::string> cache(0, 60);
+        cache.add("user_1", cache.getGeneration());
+        
+        THEN("no keys are cached")
+        {
+            CHECK_FALSE(cache.contains("user_1"));
+        }
+    }
+}
@@ -0,0 +1,264 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/DatabaseManagement/StatisticsAggregator.h"
+#include <map>
+
+using SyncServer_Core::DatabaseManagement::StatisticsAggregator;
+
+namespace
+{
+    /** Test statistics store, used in place of the database. */
+    struct TestStatisticsStore
+    {
+        boost::mutex storeMutex;
+        std::map<StatisticType, unsigned long> values;
+        unsigned int loads = 0;
+        unsigned int stores = 0;
+        bool failStores = false;
+        
+        bool load(StatisticType type, unsigned long & value)
+        {
+            boost::lock_guard<boost::mutex> storeLock(storeMutex);
+            ++loads;
+            
+            auto currentValue = values.find(type);
+            if(currentValue == values.end())
+                return false;
+            
+            value = currentValue->second;
+            return true;
+        }
+        
+        bool store(StatisticType type, unsigned long value)
+        {
+            boost::lock_guard<boost::mutex> storeLock(storeMutex);
+            if(failStores)
+                return false;
+            
+            ++stores;
+            values[type] = value;
+            return true;
+        }
+    };
+}
+
+SCENARIO("Statistics are aggregated in memory and flushed to the store", "[StatisticsAggregator][DatabaseManagement]")
+{
+    GIVEN("a StatisticsAggregator with persisted statistics and no periodic flushes")
+    {
+        TestStatisticsStore store;
+        store.values[StatisticType::TOTAL_TRANSFERRED_DATA] = 100;
+        store.values[StatisticType::TOTAL_TRANSFERRED_FILES] = 10;
+        store.values[StatisticType::TOTAL_FAILED_TRANSFERS] = 0;
+        store.values[StatisticType::TOTAL_RETRIED_TRANSFERS] = 0;
+        
+        StatisticsAggregator aggregator(
+            [&](StatisticType type, unsigned long & value) { return store.load(type, value); },
+            [&](StatisticType type, unsigned long value) { return store.store(type, value); },
+            0);
+        
+        WHEN("statistics are incremented by multiple threads")
+        {
+            std::vector<boost::thread *> threads;
+            for(unsigned int i = 0; i < 8; i++)
+            {
+                threads.push_back(new boost::thread([&]()
+                {
+                    for(unsigned int j = 0; j < 1000; j++)
+                    {
+                        aggregator.increment(StatisticType::TOTAL_TRANSFERRED_DATA, 2);
+                        aggregator.increment(StatisticType::TOTAL_TRANSFERRED_FILES, 1);
+                    }
+                }));
+            }
+            
+            for(boost::thread * currentThread : threads)
+            {
+                currentThread->join();
+                delete currentThread;
+            }
+            
+            THEN("reads include the unflushed increments, without storing them")
+            {
+                CHECK(aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_DATA) == 16100);
+                CHECK(aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_FILES) == 8010);
+                CHECK(store.stores == 0);
+                CHECK(store.values[StatisticType::TOTAL_TRANSFERRED_DATA] == 100);
+                CHECK(aggregator.getAggregatorInformation().increments == 16000);
+            }
+            
+            THEN("a flush stores only the changed statistics, with their combined values")
+            {
+                CHECK(aggregator.flush());
+                CHECK(store.stores == 2);
+                CHECK(store.values[StatisticType::TOTAL_TRANSFERRED_DATA] == 16100);
+                CHECK(store.values[StatisticType::TOTAL_TRANSFERRED_FILES] == 8010);
+                CHECK(aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_DATA) == 16100);
+                
+                CHECK(aggregator.flush());
+                CHECK(store.stores == 2);
+            }
+        }
+        
+        WHEN("a flush fails to store the statistics")
+        {
+            aggregator.increment(StatisticType::TOTAL_FAILED_TRANSFERS, 3);
+            store.failStores = true;
+            bool failedFlushResult = aggregator.flush();
+            
+            store.failStores = false;
+            aggregator.increment(StatisticType::TOTAL_FAILED_TRANSFERS, 1);
+            
+            THEN("the values are kept and stored by the next flush")
+            {
+                CHECK_FALSE(failedFlushResult);
+                CHECK(aggregator.getValue(StatisticType::TOTAL_FAILED_TRANSFERS) == 4);
+                CHECK(aggregator.flush());
+                CHECK(store.values[StatisticType::TOTAL_FAILED_TRANSFERS] == 4);
+                CHECK(aggregator.getAggregatorInformation().failedStores == 1);
+            }
+        }
+        
+        WHEN("non-counter statistics are incremented")
+        {
+            THEN("they are not aggregated")
+            {
+                CHECK_FALSE(StatisticsAggregator::isAggregated(StatisticType::INSTALL_TIMESTAMP));
+                CHECK_FALSE(aggregator.increment(StatisticType::START_TIMESTAMP, 1));
+                CHECK(StatisticsAggregator::isAggregated(StatisticType::TOTAL_RETRIED_TRANSFERS));
+            }
+        }
+        
+        WHEN("the aggregator is stopped")
+        {
+            aggregator.increment(StatisticType::TOTAL_RETRIED_TRANSFERS, 5);
+            aggregator.stop();
+            
+            THEN("the remaining increments are flushed")
+            {
+                CHECK(store.values[StatisticType::TOTAL_RETRIED_TRANSFERS] == 5);
+            }
+        }
+    }
+    
+    GIVEN("a StatisticsAggregator with a statistic that cannot be loaded")
+    {
+        TestStatisticsStore store;
+        store.values[StatisticType::TOTAL_TRANSFERRED_FILES] = 7;
+        
+        boost::mutex loadMutex;
+        boost::condition_variable loadCondition;
+        bool loadStarted = false;
+        bool releaseLoad = false;
+        
+        StatisticsAggregator aggregator(
+            [&](StatisticType type, unsigned long & value)
+            {
+                if(type == StatisticType::TOTAL_FAILED_TRANSFERS)
+                {
+                    boost::unique_lock<boost::mutex> loadLock(loadMutex);
+                    loadStarted = true;
+                    loadCondition.notify_all();
+                    while(!releaseLoad)
+                        loadCondition.wait(loadLock);
+                }
+                
+                return store.load(type, value);
+            },
+            [&](StatisticType type, unsigned long value) { return store.store(type, value); },
+            0);
+        
+        WHEN("the statistic is read several times")
+        {
+            releaseLoad = true;
+            aggregator.increment(StatisticType::TOTAL_TRANSFERRED_DATA, 3);
+            unsigned long firstValue = aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_DATA);
+            unsigned long secondValue = aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_DATA);
+            unsigned int loadsAfterReads = store.loads;
+            
+            THEN("the failed load is not retried by the reads, but only by the next flush")
+            {
+                CHECK(firstValue == 3);
+                CHECK(secondValue == 3);
+                CHECK(loadsAfterReads == 1);
+                CHECK(aggregator.getAggregatorInformation().failedLoads == 1);
+                
+                store.values[StatisticType::TOTAL_TRANSFERRED_DATA] = 10;
+                aggregator.flush();
+                CHECK(aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_DATA) == 13);
+                CHECK(store.values[StatisticType::TOTAL_TRANSFERRED_DATA] == 13);
+            }
+        }
+        
+        WHEN("another statistic is read while a load is in progress")
+        {
+            boost::thread slowReader([&]() { aggregator.getValue(StatisticType::TOTAL_FAILED_TRANSFERS); });
+            
+            {
+                boost::unique_lock<boost::mutex> loadLock(loadMutex);
+                while(!loadStarted)
+                    loadCondition.wait(loadLock);
+            }
+            
+            unsigned long otherValue = aggregator.getValue(StatisticType::TOTAL_TRANSFERRED_FILES);
+            
+            {
+                boost::lock_guard<boost::mutex> loadLock(loadMutex);
+                releaseLoad = true;
+                loadCondition.notify_all();
+            }
+            
+            slowReader.join();
+            
+            THEN("the read is not blocked by the pending load")
+            {
+                CHECK(otherValue == 7);
+            }
+        }
+        
+        {
+            boost::lock_guard<boost::mutex> loadLock(loadMutex);
+            releaseLoad = true;
+            loadCondition.notify_all();
+        }
+    }
+    
+    GIVEN("a StatisticsAggregator with periodic flushes")
+    {
+        TestStatisticsStore store;
+        store.values[StatisticType::TOTAL_TRANSFERRED_DATA] = 0;
+        
+        StatisticsAggregator aggregator(
+            [&](StatisticType type, unsigned long & value) { return store.load(type, value); },
+            [&](StatisticType type, unsigned long value) { return store.store(type, value); },
+            1);
+        
+        WHEN("a statistic is incremented and the flush interval elapses")
+        {
+            aggregator.increment(StatisticType::TOTAL_TRANSFERRED_DATA, 42);
+            waitFor(2);
+            
+            THEN("the statistic is stored")
+            {
+                boost::lock_guard<boost::mutex> storeLock(store.storeMutex);
+                CHECK(store.values[StatisticType::TOTAL_TRANSFERRED_DATA] == 42);
+            }
+        }
+    }
+}
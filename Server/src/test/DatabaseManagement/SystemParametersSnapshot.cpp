@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include <boost/uuid/uuid_generators.hpp>
+#include "../../main/DatabaseManagement/Types/SystemParametersSnapshot.h"
+
+using DatabaseManagement_Types::SystemParametersSnapshot;
+using DatabaseManagement_Types::SystemParametersSnapshotPtr;
+using DatabaseManagement_Types::SystemParameterType;
+using DatabaseManagement_Containers::SystemDataContainer;
+using DatabaseManagement_Containers::SystemDataContainerPtr;
+
+SCENARIO("System parameter snapshots are immutable", "[SystemParametersSnapshot][DatabaseManagement]")
+{
+    GIVEN("a snapshot with two parameters")
+    {
+        std::vector<SystemDataContainerPtr> parameters;
+        parameters.push_back(SystemDataContainerPtr(new SystemDataContainer(SystemParameterType::SESSION_TIMEOUT, (unsigned long)30)));
+        parameters.push_back(SystemDataContainerPtr(new SystemDataContainer(SystemParameterType::COMMAND_RETRIES_MAX, (unsigned int)3)));
+        
+        SystemParametersSnapshotPtr snapshot(new SystemParametersSnapshot(1, parameters));
+        
+        THEN("it holds copies of the parameters")
+        {
+            CHECK(snapshot->getVersion() == 1);
+            CHECK(snapshot->size() == 2);
+            CHECK(boost::any_cast<unsigned long>(snapshot->getValue(SystemParameterType::SESSION_TIMEOUT)) == 30);
+            CHECK(snapshot->getValue(SystemParameterType::DATA_IP_PORT).empty());
+            CHECK_FALSE(snapshot->getParameter(SystemParameterType::DATA_IP_PORT));
+            CHECK(snapshot->getParameter(SystemParameterType::SESSION_TIMEOUT) != parameters[0]);
+        }
+        
+        WHEN("a parameter is changed")
+        {
+            SystemParametersSnapshotPtr newSnapshot = snapshot->withParameter(
+                SystemDataContainerPtr(new SystemDataContainer(SystemParameterType::SESSION_TIMEOUT, (unsigned long)60)));
+            
+            THEN("a new snapshot is created and the original snapshot is unchanged")
+            {
+                CHECK(newSnapshot->getVersion() == 2);
+                CHECK(newSnapshot->size() == 2);
+                CHECK(boost::any_cast<unsigned long>(newSnapshot->getValue(SystemParameterType::SESSION_TIMEOUT)) == 60);
+                CHECK(boost::any_cast<unsigned int>(newSnapshot->getValue(SystemParameterType::COMMAND_RETRIES_MAX)) == 3);
+                CHECK(boost::any_cast<unsigned long>(snapshot->getValue(SystemParameterType::SESSION_TIMEOUT)) == 30);
+            }
+        }
+        
+        WHEN("a retrieved parameter is modified")
+        {
+            SystemDataContainerPtr parameter = snapshot->getParameter(SystemParameterType::SESSION_TIMEOUT);
+            parameter->setSystemParameterValue((unsigned long)90);
+            parameters[0]->setSystemParameterValue((unsigned long)120);
+            
+            THEN("the snapshot is unchanged")
+            {
+                CHECK(boost::any_cast<unsigned long>(snapshot->getValue(SystemParameterType::SESSION_TIMEOUT)) == 30);
+            }
+        }
+    }
+}
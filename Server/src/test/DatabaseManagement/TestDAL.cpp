@@ -51,6 +51,12 @@ Testing::TestDAL::TestDAL(
 
 Testing::TestDAL::~TestDAL()
 {
+    if(responsePool != nullptr)
+    {
+        responsePool->stopThreadPool();
+        delete responsePool;
+    }
+
     boost::lock_guard<boost::mutex> dataLock(dataMutex);
     if(!data.empty())
     {
@@ -119,9 +125,19 @@ Testing::TestDAL::~TestDAL()
 bool Testing::TestDAL::getObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue)
 {
     ++getObject_received;
+
+    if(responsePool == nullptr)
+        return processGetObject(requestID, constraintType, constraintValue);
+
+    responsePool->assignTimedTask([=]() { processGetObject(requestID, constraintType, constraintValue); }, getResponseTime());
+    return true;
+}
+
+bool Testing::TestDAL::processGetObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue)
+{
     logMessage(LogSeverity::Debug, "(getObject) > Request [" + Convert::toString(requestID) + "].");
 
-    if(getObject_expectedResponse)
+    if(getObject_expectedResponse && !isFailureInjected())
     {
         DBObjectID objectID = Utilities::Tools::getIDFromConstraint(dalType, constraintType, constraintValue);
 
@@ -147,7 +163,7 @@ bool Testing::TestDAL::getObject(DatabaseRequestID requestID, boost::any constra
             if(!done)
             {
                 dataLock.unlock();
-                onFailure(dalID, requestID, Common_Types::INVALID_OBJECT_ID);
+                onFailure(dalID, requestID, Common_Types::INVALID_OBJECT_ID, true);
                 ++getObject_failed;
             }
         }
@@ -177,14 +193,14 @@ bool Testing::TestDAL::getObject(DatabaseRequestID requestID, boost::any constra
                 }
                 else
                 {
-                    onFailure(dalID, requestID, Common_Types::INVALID_OBJECT_ID);
+                    onFailure(dalID, requestID, Common_Types::INVALID_OBJECT_ID, true);
                 }
             }
         }
     }
     else
     {
-        onFailure(dalID, requestID, Common_Types::INVALID_OBJECT_ID);
+        onFailure(dalID, requestID, Common_Types::INVALID_OBJECT_ID, false);
         ++getObject_failed;
     }
 
@@ -194,11 +210,21 @@ bool Testing::TestDAL::getObject(DatabaseRequestID requestID, boost::any constra
 bool Testing::TestDAL::putObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
 {
     ++putObject_received;
+
+    if(responsePool == nullptr)
+        return processPutObject(requestID, inputData);
+
+    responsePool->assignTimedTask([=]() { processPutObject(requestID, inputData); }, getResponseTime());
+    return true;
+}
+
+bool Testing::TestDAL::processPutObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
+{
     logMessage(LogSeverity::Debug, "(putObject) > Request [" + Convert::toString(requestID)
             + "] for container [" + Convert::toString(inputData->getContainerID()) + "].");
 
     boost::unique_lock<boost::mutex> dataLock(dataMutex);
-    if(putObject_expectedResponse && data.find(inputData->getContainerID()) == data.end())
+    if(putObject_expectedResponse && !isFailureInjected() && data.find(inputData->getContainerID()) == data.end())
     {
         data.insert(std::pair<DBObjectID, DataContainerPtr>(inputData->getContainerID(), inputData));
         dataLock.unlock();
@@ -208,7 +234,7 @@ bool Testing::TestDAL::putObject(DatabaseRequestID requestID, const DataContaine
     else
     {
         dataLock.unlock();
-        onFailure(dalID, requestID, inputData->getContainerID());
+        onFailure(dalID, requestID, inputData->getContainerID(), false);
         ++putObject_failed;
     }
 
@@ -218,11 +244,21 @@ bool Testing::TestDAL::putObject(DatabaseRequestID requestID, const DataContaine
 bool Testing::TestDAL::updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
 {
     ++updateObject_received;
+
+    if(responsePool == nullptr)
+        return processUpdateObject(requestID, inputData);
+
+    responsePool->assignTimedTask([=]() { processUpdateObject(requestID, inputData); }, getResponseTime());
+    return true;
+}
+
+bool Testing::TestDAL::processUpdateObject(DatabaseRequestID requestID, const DataContainerPtr inputData)
+{
     logMessage(LogSeverity::Debug, "(updateObject) > Request [" + Convert::toString(requestID)
             + "] for container [" + Convert::toString(inputData->getContainerID()) + "].");
 
     boost::unique_lock<boost::mutex> dataLock(dataMutex);
-    if(updateObject_expectedResponse && data.find(inputData->getContainerID()) != data.end())
+    if(updateObject_expectedResponse && !isFailureInjected() && data.find(inputData->getContainerID()) != data.end())
     {
         data[inputData->getContainerID()] = inputData;
         dataLock.unlock();
@@ -232,7 +268,7 @@ bool Testing::TestDAL::updateObject(DatabaseRequestID requestID, const DataConta
     else
     {
         dataLock.unlock();
-        onFailure(dalID, requestID, inputData->getContainerID());
+        onFailure(dalID, requestID, inputData->getContainerID(), false);
         ++updateObject_failed;
     }
 
@@ -242,11 +278,21 @@ bool Testing::TestDAL::updateObject(DatabaseRequestID requestID, const DataConta
 bool Testing::TestDAL::removeObject(DatabaseRequestID requestID, DBObjectID id)
 {
     ++removeObject_received;
+
+    if(responsePool == nullptr)
+        return processRemoveObject(requestID, id);
+
+    responsePool->assignTimedTask([=]() { processRemoveObject(requestID, id); }, getResponseTime());
+    return true;
+}
+
+bool Testing::TestDAL::processRemoveObject(DatabaseRequestID requestID, DBObjectID id)
+{
     logMessage(LogSeverity::Debug, "(removeObject) > Request [" + Convert::toString(requestID)
             + "] for container [" + Convert::toString(id) + "].");
 
     boost::unique_lock<boost::mutex> dataLock(dataMutex);
-    if(removeObject_expectedResponse && data.find(id) != data.end())
+    if(removeObject_expectedResponse && !isFailureInjected() && data.find(id) != data.end())
     {
         auto result = data[id];
         data.erase(id);
@@ -257,9 +303,39 @@ bool Testing::TestDAL::removeObject(DatabaseRequestID requestID, DBObjectID id)
     else
     {
         dataLock.unlock();
-        onFailure(dalID, requestID, id);
+        onFailure(dalID, requestID, id, false);
         ++removeObject_failed;
     }
 
     return removeObject_expectedResponse;
 }
+
+void Testing::TestDAL::enableInjection(const TestDALInjectionParameters & parameters)
+{
+    boost::lock_guard<boost::mutex> injectionLock(injectionMutex);
+    injectionParameters = parameters;
+    injectionGenerator.seed(parameters.latency + parameters.jitter + parameters.threads);
+
+    if(responsePool == nullptr)
+        responsePool = new Utilities::ThreadPool((parameters.threads > 0) ? parameters.threads : 1, debugLogger);
+}
+
+boost::posix_time::ptime Testing::TestDAL::getResponseTime()
+{
+    boost::lock_guard<boost::mutex> injectionLock(injectionMutex);
+    unsigned long latency = injectionParameters.latency;
+
+    if(injectionParameters.jitter > 0)
+        latency += std::uniform_int_distribution<unsigned long>(0, injectionParameters.jitter)(injectionGenerator);
+
+    return boost::posix_time::microsec_clock::universal_time() + boost::posix_time::microseconds(latency);
+}
+
+bool Testing::TestDAL::isFailureInjected()
+{
+    boost::lock_guard<boost::mutex> injectionLock(injectionMutex);
+    if(injectionParameters.failureRate <= 0.0)
+        return false;
+
+    return std::uniform_real_distribution<double>(0.0, 1.0)(injectionGenerator) < injectionParameters.failureRate;
+}
@@ -19,12 +19,14 @@
 #define TESTDAL_H
 
 #include <atomic>
+#include <random>
 #include <boost/unordered_map.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include "../../main/Utilities/FileLogger.h"
 #include "../../main/Utilities/Tools.h"
+#include "../../main/Utilities/ThreadPool.h"
 #include "../../main/DatabaseManagement/Interfaces/DatabaseAbstractionLayer.h"
 #include "../../main/DatabaseManagement/Interfaces/DatabaseSettingsContainer.h"
 #include "../../main/DatabaseManagement/Interfaces/DatabaseInformationContainer.h"
@@ -54,6 +56,15 @@ namespace Testing
                     virtual long getDatabaseSize() const { return 42; }
             };
             
+            /** Parameters for injecting response latency and failures. */
+            struct TestDALInjectionParameters
+            {
+                unsigned long latency;      //minimum response latency (in microseconds)
+                unsigned long jitter;       //maximum random latency added to each response (in microseconds)
+                double failureRate;         //fraction of requests that fail, regardless of the expected response (0.0 to 1.0)
+                unsigned long threads;      //number of threads delivering responses
+            };
+            
             TestDAL(bool getObjectResponse, bool putObjectResponse,
                     bool updateObjectResponse, bool removeObjectResponse,
                     DatabaseObjectType type, bool enableLogger);
@@ -65,6 +76,31 @@ namespace Testing
             bool updateObject(DatabaseRequestID requestID, const DataContainerPtr inputData) override;
             bool removeObject(DatabaseRequestID requestID, DBObjectID id) override;
             
+            /**
+             * Enables latency and failure injection.
+             * 
+             * Note: Once enabled, all responses are delivered asynchronously, by a separate
+             * thread pool, which allows the DAL to be used behind a <code>DALQueue</code>.
+             * 
+             * @param parameters the injection parameters
+             */
+            void enableInjection(const TestDALInjectionParameters & parameters);
+            
+            /** Retrieves the number of objects currently stored by the DAL. */
+            std::size_t getStoredObjectsCount()
+            {
+                boost::lock_guard<boost::mutex> dataLock(dataMutex);
+                return data.size();
+            }
+            
+            /** Retrieves the stored object with the specified ID (or an empty pointer, if the object is not found). */
+            DataContainerPtr getStoredObject(DBObjectID id)
+            {
+                boost::lock_guard<boost::mutex> dataLock(dataMutex);
+                auto result = data.find(id);
+                return (result != data.end()) ? result->second : DataContainerPtr();
+            }
+            
             bool changeDatabaseSettings(const DatabaseSettingsContainer settings) override
             {
                 ++changeDatabaseSettings_calls;
@@ -170,6 +206,21 @@ namespace Testing
             boost::mutex dataMutex;
             boost::unordered_map<DBObjectID, DataContainerPtr> data;
             
+            Utilities::ThreadPool * responsePool = nullptr;
+            TestDALInjectionParameters injectionParameters {0, 0, 0.0, 0};
+            boost::mutex injectionMutex;
+            std::mt19937 injectionGenerator;
+            
+            /** Calculates the time at which the next response is to be delivered (base latency plus random jitter). */
+            boost::posix_time::ptime getResponseTime();
+            /** Checks if the next request is to fail (based on the configured failure rate). */
+            bool isFailureInjected();
+            
+            bool processGetObject(DatabaseRequestID requestID, boost::any constraintType, boost::any constraintValue);
+            bool processPutObject(DatabaseRequestID requestID, const DataContainerPtr inputData);
+            bool processUpdateObject(DatabaseRequestID requestID, const DataContainerPtr inputData);
+            bool processRemoveObject(DatabaseRequestID requestID, DBObjectID id);
+            
             Utilities::FileLoggerPtr debugLogger;
             void logMessage(LogSeverity severity, const std::string & message) const
             {
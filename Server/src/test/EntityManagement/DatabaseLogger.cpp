@@ -86,7 +86,25 @@ SCENARIO("A database logger is created, registers logging sources and can proces
                 auto logs = dbManager->Logs().getLogsBySource(testSource.getSourceName());
                 CHECK(logs.size() == 5);
             }
-            
+
+            AND_THEN("they can be retrieved in pages")
+            {
+                auto page_1 = dbManager->Logs().getLogsPage(DatabaseSelectConstraints::LOGS::GET_ALL, 0, 0, 2);
+                auto page_2 = dbManager->Logs().getLogsPage(DatabaseSelectConstraints::LOGS::GET_ALL, 0, 4, 2);
+                CHECK(page_1.size() == 2);
+                CHECK(page_2.size() == 1);
+
+                std::vector<std::size_t> streamedPages;
+                CHECK(dbManager->Logs().streamLogs(DatabaseSelectConstraints::LOGS::GET_ALL, 0, 2,
+                    [&streamedPages](const std::vector<LogDataContainerPtr> & page)
+                    {
+                        streamedPages.push_back(page.size());
+                        return true;
+                    }));
+
+                CHECK(streamedPages == std::vector<std::size_t>({2, 2, 1}));
+            }
+
             AND_WHEN("instructions are sent to the DatabaseLogger")
             {
                 CHECK_NOTHROW(testInstructionSource.doInstruction_DebugGetState());
@@ -128,15 +128,15 @@ SCENARIO("A user manager is created and can process instructions",
             auto result_12 = testInstructionSource.doInstruction_AdminAddAuthorizationRule(newUser->getUserID(), newRule_2);
             CHECK(result_12->result);
             
-            //TODO - re-enable -> CHECK(testInstructionSource.doInstruction_AdminGetUser(newUser->getUserID())->result->getAccessRules().size() == 2);
+            CHECK(testInstructionSource.doInstruction_AdminGetUser(newUser->getUserID())->result->getAccessRules().size() == 2);
             
             auto result_13 = testInstructionSource.doInstruction_AdminRemoveAuthorizationRule(newUser->getUserID(), newRule_1);
             CHECK(result_13->result);
-            //TODO - re-enable -> CHECK(testInstructionSource.doInstruction_AdminGetUser(newUser->getUserID())->result->getAccessRules().size() == 1);
+            CHECK(testInstructionSource.doInstruction_AdminGetUser(newUser->getUserID())->result->getAccessRules().size() == 1);
             
             auto result_14 = testInstructionSource.doInstruction_AdminClearAuthorizationRules(newUser->getUserID());
             CHECK(result_14->result);
-            //TODO - re-enable -> CHECK(testInstructionSource.doInstruction_AdminGetUser(newUser->getUserID())->result->getAccessRules().empty());
+            CHECK(testInstructionSource.doInstruction_AdminGetUser(newUser->getUserID())->result->getAccessRules().empty());
             
             auto result_15 = testInstructionSource.doInstruction_AdminRemoveUser(newUser->getUserID());
             CHECK(result_15->result);
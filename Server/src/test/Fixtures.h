@@ -58,7 +58,13 @@ namespace Testing
                     DatabaseManagerOperationMode::PRPW,     //dbMode
                     DatabaseFailureAction::IGNORE_FAILURE,  //failureAction
                     5,                                      //maximumReadFailures
-                    5                                       //maximumWriteFailures
+                    5,                                      //maximumWriteFailures
+                    0,                                      //maximumBatchSize
+                    DatabaseReadRoutingPolicy::FIRST,       //readRoutingPolicy
+                    true,                                   //coalesceUpdates
+                    1000,                                   //minimumReconnectDelay
+                    30000,                                  //maximumReconnectDelay
+                    0                                       //maximumSkippedWrites
                 };
 
                 SyncServer_Core::DatabaseManagement::DALCache::DALCacheParameters dcParams
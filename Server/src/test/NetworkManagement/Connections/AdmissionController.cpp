@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../BasicSpec.h"
+#include "../../../main/NetworkManagement/Connections/AdmissionController.h"
+
+using NetworkManagement_Connections::AdmissionController;
+
+namespace Test_AdmissionController
+{
+    boost::asio::ip::address toAddress(const std::string & address)
+    {
+        return boost::asio::ip::address::from_string(address);
+    }
+}
+
+SCENARIO("Admission controllers enforce concurrent connection limits", "[AdmissionController][ConnectionManager][NetworkManagement]")
+{
+    GIVEN("an AdmissionController with global, per address and per subnet limits")
+    {
+        AdmissionController::AdmissionLimits limits{2, 3, 24, 0, 0, 0, 0, 0, 0, 0};
+        AdmissionController testController(4, limits);
+
+        WHEN("connections are admitted and released")
+        {
+            CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.0.1")) == AdmissionResult::ADMITTED);
+            CHECK(testController.admit(Test_AdmissionController::toAddress("::ffff:10.0.0.1")) == AdmissionResult::ADMITTED);
+            CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.0.1")) == AdmissionResult::ADDRESS_LIMIT);
+            CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.0.2")) == AdmissionResult::ADMITTED);
+            CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.0.3")) == AdmissionResult::SUBNET_LIMIT);
+            CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.1.1")) == AdmissionResult::ADMITTED);
+            CHECK(testController.admit(Test_AdmissionController::toAddress("192.168.0.1")) == AdmissionResult::GLOBAL_LIMIT);
+
+            THEN("the active connections and rejections are counted by reason")
+            {
+                CHECK(testController.getActiveConnectionsCount() == 4);
+                CHECK(testController.getAdmissionsCount() == 4);
+                CHECK(testController.getRejectionsCount() == 3);
+                CHECK(testController.getRejectionsCount(AdmissionResult::ADDRESS_LIMIT) == 1);
+                CHECK(testController.getRejectionsCount(AdmissionResult::SUBNET_LIMIT) == 1);
+                CHECK(testController.getRejectionsCount(AdmissionResult::GLOBAL_LIMIT) == 1);
+                CHECK(testController.getRejectionsCount(AdmissionResult::GLOBAL_RATE) == 0);
+            }
+
+            AND_THEN("released connections make room for new ones")
+            {
+                testController.release(Test_AdmissionController::toAddress("10.0.0.1"));
+                CHECK(testController.getActiveConnectionsCount() == 3);
+                CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.0.3")) == AdmissionResult::ADMITTED);
+                CHECK(testController.admit(Test_AdmissionController::toAddress("10.0.0.1")) == AdmissionResult::GLOBAL_LIMIT);
+            }
+        }
+    }
+
+    GIVEN("invalid admission limits")
+    {
+        THEN("AdmissionControllers cannot be created")
+        {
+            CHECK_THROWS_AS(AdmissionController(0, AdmissionController::AdmissionLimits{0, 0, 33, 0, 0, 0, 0, 0, 0, 0}), std::invalid_argument);
+            CHECK_THROWS_AS(AdmissionController(0, AdmissionController::AdmissionLimits{0, 0, 0, 129, 0, 0, 0, 0, 0, 0}), std::invalid_argument);
+            CHECK_THROWS_AS(AdmissionController(0, AdmissionController::AdmissionLimits{0, 0, 0, 0, -1, 0, 0, 0, 0, 0}), std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("Admission controllers enforce accept rate limits", "[AdmissionController][ConnectionManager][NetworkManagement]")
+{
+    GIVEN("an AdmissionController with global and per address accept rate limits")
+    {
+        AdmissionController::AdmissionLimits limits{0, 0, 0, 0, 10, 3, 1, 2, 0, 0};
+        AdmissionController testController(0, limits);
+        boost::posix_time::ptime startTime = boost::posix_time::microsec_clock::universal_time();
+
+        WHEN("a single address sends a burst of connections")
+        {
+            AdmissionResult first = testController.admit(Test_AdmissionController::toAddress("fd00::1"), startTime);
+            AdmissionResult second = testController.admit(Test_AdmissionController::toAddress("fd00::1"), startTime);
+            AdmissionResult third = testController.admit(Test_AdmissionController::toAddress("fd00::1"), startTime);
+
+            THEN("only the address burst is admitted and the global tokens are not used by the rejections")
+            {
+                CHECK(first == AdmissionResult::ADMITTED);
+                CHECK(second == AdmissionResult::ADMITTED);
+                CHECK(third == AdmissionResult::ADDRESS_RATE);
+                CHECK(testController.admit(Test_AdmissionController::toAddress("fd00::2"), startTime) == AdmissionResult::ADMITTED);
+                CHECK(testController.admit(Test_AdmissionController::toAddress("fd00::3"), startTime) == AdmissionResult::GLOBAL_RATE);
+            }
+
+            AND_THEN("the buckets are refilled over time")
+            {
+                boost::posix_time::ptime laterTime = startTime + boost::posix_time::milliseconds(1000);
+                CHECK(testController.admit(Test_AdmissionController::toAddress("fd00::1"), laterTime) == AdmissionResult::ADMITTED);
+                CHECK(testController.admit(Test_AdmissionController::toAddress("fd00::1"), laterTime) == AdmissionResult::ADDRESS_RATE);
+                CHECK(testController.getRejectionsCount(AdmissionResult::ADDRESS_RATE) == 2);
+            }
+        }
+    }
+}
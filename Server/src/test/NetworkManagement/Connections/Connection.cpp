@@ -0,0 +1,408 @@
+/**
+ * Copyright (C) 2016 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../BasicSpec.h"
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <boost/thread.hpp>
+#include "../../../main/NetworkManagement/Types/Types.h"
+#include "../../../main/NetworkManagement/Connections/Connection.h"
+
+using NetworkManagement_Connections::Connection;
+using NetworkManagement_Connections::ConnectionPtr;
+
+namespace
+{
+    /** Pair of connections over a local socket, with all events collected by the test. */
+    struct ConnectionPair
+    {
+        ConnectionPair(unsigned int networkThreads,
+                       Connection::QueueWatermarks localWriteWatermarks,
+                       Connection::QueueWatermarks remoteReadWatermarks)
+        : networkService(new boost::asio::io_service()), networkWork(new boost::asio::io_service::work(*networkService))
+        {
+            boost::asio::ip::tcp::acceptor acceptor(*networkService,
+                    boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+            
+            SocketPtr localSocket(new boost::asio::ip::tcp::socket(*networkService));
+            SocketPtr remoteSocket(new boost::asio::ip::tcp::socket(*networkService));
+            localSocket->connect(acceptor.local_endpoint());
+            acceptor.accept(*remoteSocket);
+            
+            Connection::QueueWatermarks unbounded{0, 0, 0, 0};
+            local.reset(new Connection(networkService,
+                    Connection::ConnectionParamters{ConnectionType::DATA, PeerType::SERVER, ConnectionInitiation::LOCAL,
+                                                    1, localSocket, 512, localWriteWatermarks, unbounded, false},
+                    ConnectionRequest{PeerType::SERVER, ConnectionType::DATA}));
+            
+            remote.reset(new Connection(networkService,
+                    Connection::ConnectionParamters{ConnectionType::DATA, PeerType::SERVER, ConnectionInitiation::REMOTE,
+                                                    2, remoteSocket, 512, unbounded, remoteReadWatermarks, false}));
+            
+            local->onWriteResultReceivedEventAttach([this](bool result)
+            {
+                boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                writeResults.push_back(result);
+            });
+            
+            local->onFlowControlEventAttach([this](FlowControlEvent event)
+            {
+                boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                localFlowControlEvents.push_back(event);
+            });
+            
+            remote->onDataReceivedEventAttach([this](const BufferView & data, PacketSize)
+            {
+                boost::unique_lock<boost::mutex> eventsLock(eventsMutex);
+                receivedMessages.push_back(data.toByteData());
+                eventsCondition.notify_all();
+                
+                if(keepReceivedData)
+                {
+                    remote->holdReceivedData(pauseWhileKept);
+                    keptDataSizes.push_back(data.size());
+                }
+                
+                eventsCondition.wait(eventsLock, [&](){ return !holdReceivedData; });
+            });
+            
+            remote->onFlowControlEventAttach([this](FlowControlEvent event)
+            {
+                boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                remoteFlowControlEvents.push_back(event);
+            });
+            
+            local->enableDataEvents();
+            remote->enableDataEvents();
+            
+            for(unsigned int i = 0; i < networkThreads; i++)
+                networkThreadGroup.create_thread([this](){ networkService->run(); });
+            
+            for(unsigned int i = 0; i < 500 && !(local->isActive() && remote->isActive()); i++)
+                waitFor(0.01);
+        }
+        
+        ~ConnectionPair()
+        {
+            releaseReceivedData();
+            releaseKeptData();
+            local->disconnect();
+            remote->disconnect();
+            networkWork.reset();
+            networkService->stop();
+            networkThreadGroup.join_all();
+        }
+        
+        /** Sends the specified messages from the local connection, within a single network task, and returns the send results. */
+        std::vector<bool> send(const std::vector<std::string> & messages, bool shutdownAfterFirst = false)
+        {
+            std::vector<bool> results;
+            boost::mutex resultsMutex;
+            boost::condition_variable resultsCondition;
+            
+            networkService->post([&]()
+            {
+                std::vector<bool> sendResults;
+                for(const std::string & currentMessage : messages)
+                {
+                    sendResults.push_back(local->sendData(ByteData(currentMessage)));
+                    
+                    if(shutdownAfterFirst && sendResults.size() == 1)
+                        ::shutdown(local->getNativeSocketHandle(), SHUT_WR);
+                }
+                
+                boost::lock_guard<boost::mutex> resultsLock(resultsMutex);
+                results.swap(sendResults);
+                resultsCondition.notify_all();
+            });
+            
+            boost::unique_lock<boost::mutex> resultsLock(resultsMutex);
+            resultsCondition.timed_wait(resultsLock, boost::posix_time::seconds(5), [&](){ return !results.empty(); });
+            return results;
+        }
+        
+        /** Waits until the specified number of write results is received by the local connection (up to 5 seconds). */
+        void waitForWriteResults(std::size_t expectedResults)
+        {
+            for(unsigned int i = 0; i < 500 && getWriteResults().size() < expectedResults; i++)
+                waitFor(0.01);
+        }
+        
+        /** Waits until the specified number of messages is received by the remote connection (up to 5 seconds). */
+        void waitForMessages(std::size_t expectedMessages)
+        {
+            boost::unique_lock<boost::mutex> eventsLock(eventsMutex);
+            eventsCondition.timed_wait(eventsLock, boost::posix_time::seconds(5),
+                    [&](){ return receivedMessages.size() >= expectedMessages; });
+        }
+        
+        /** Makes the data handler of the remote connection wait until <code>releaseReceivedData</code> is called. */
+        void holdReceivedDataInHandler()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            holdReceivedData = true;
+        }
+        
+        /** Lets the data handler of the remote connection return. */
+        void releaseReceivedData()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            holdReceivedData = false;
+            eventsCondition.notify_all();
+        }
+        
+        /** Makes the data handler of the remote connection keep the received data in the read queue, after it returns. */
+        void keepReceivedDataInQueue(bool pauseReading)
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            keepReceivedData = true;
+            pauseWhileKept = pauseReading;
+        }
+        
+        /** Stops keeping received data and releases all data kept in the read queue of the remote connection. */
+        void releaseKeptData()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            keepReceivedData = false;
+            
+            for(BufferSize currentSize : keptDataSizes)
+                remote->releaseReceivedData(currentSize, pauseWhileKept);
+            
+            keptDataSizes.clear();
+        }
+        
+        std::vector<bool> getWriteResults()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            return writeResults;
+        }
+        
+        std::vector<std::string> getReceivedMessages()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            return receivedMessages;
+        }
+        
+        std::vector<FlowControlEvent> getLocalFlowControlEvents()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            return localFlowControlEvents;
+        }
+        
+        std::vector<FlowControlEvent> getRemoteFlowControlEvents()
+        {
+            boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+            return remoteFlowControlEvents;
+        }
+        
+        boost::shared_ptr<boost::asio::io_service> networkService;
+        boost::shared_ptr<boost::asio::io_service::work> networkWork;
+        boost::thread_group networkThreadGroup;
+        ConnectionPtr local;
+        ConnectionPtr remote;
+        
+        boost::mutex eventsMutex;
+        boost::condition_variable eventsCondition;
+        bool holdReceivedData = false;
+        bool keepReceivedData = false;
+        bool pauseWhileKept = false;
+        std::vector<BufferSize> keptDataSizes;
+        std::vector<bool> writeResults;
+        std::vector<std::string> receivedMessages;
+        std::vector<FlowControlEvent> localFlowControlEvents;
+        std::vector<FlowControlEvent> remoteFlowControlEvents;
+    };
+    
+    std::vector<std::string> createMessages(unsigned int count)
+    {
+        std::vector<std::string> result;
+        for(unsigned int i = 0; i < count; i++)
+            result.push_back("message_" + Convert::toString(i));
+        
+        return result;
+    }
+}
+
+SCENARIO("Messages queued while a write is in progress are sent by a single gathered write", "[Connection][Connections][NetworkManagement]")
+{
+    GIVEN("a pair of connections sharing a single network thread")
+    {
+        Connection::QueueWatermarks unbounded{0, 0, 0, 0};
+        ConnectionPair connections(1, unbounded, unbounded);
+        REQUIRE(connections.local->isActive());
+        REQUIRE(connections.remote->isActive());
+        
+        WHEN("several messages are sent before the first write completes")
+        {
+            std::vector<std::string> messages = createMessages(5);
+            std::vector<bool> sendResults = connections.send(messages);
+            connections.waitForMessages(messages.size());
+            connections.waitForWriteResults(messages.size());
+            
+            THEN("the queued messages are sent together by the next write, in order")
+            {
+                CHECK(sendResults == std::vector<bool>(messages.size(), true));
+                CHECK(connections.local->getWriteOperationsCount() == 2);
+                CHECK(connections.getReceivedMessages() == messages);
+                CHECK(connections.getWriteResults() == std::vector<bool>(messages.size(), true));
+                CHECK(connections.local->getBytesSent() == messages.size() * messages.front().size());
+            }
+        }
+        
+        WHEN("the gathered write fails")
+        {
+            std::vector<std::string> messages = createMessages(5);
+            std::vector<bool> sendResults = connections.send(messages, true);
+            connections.waitForWriteResults(messages.size());
+            
+            THEN("only the first message is sent and every gathered message fails")
+            {
+                std::vector<bool> expectedResults(messages.size(), false);
+                expectedResults[0] = true;
+                
+                CHECK(sendResults == std::vector<bool>(messages.size(), true));
+                CHECK(connections.local->getWriteOperationsCount() == 1);
+                CHECK(connections.getWriteResults() == expectedResults);
+                CHECK_FALSE(connections.local->isActive());
+                CHECK(connections.local->getLastSubstate() == ConnectionSubstate::FAILED);
+            }
+        }
+    }
+}
+
+SCENARIO("Connection queues are bounded by their high/low watermarks", "[Connection][Connections][NetworkManagement]")
+{
+    GIVEN("a pair of connections with a bounded write queue")
+    {
+        Connection::QueueWatermarks unbounded{0, 0, 0, 0};
+        ConnectionPair connections(1, Connection::QueueWatermarks{0, 0, 3, 1}, unbounded);
+        REQUIRE(connections.local->isActive());
+        
+        WHEN("more messages are sent than the write queue can hold")
+        {
+            std::vector<std::string> messages = createMessages(5);
+            std::vector<bool> sendResults = connections.send(messages);
+            connections.waitForMessages(3);
+            connections.waitForWriteResults(3);
+            
+            for(unsigned int i = 0; i < 500 && connections.getLocalFlowControlEvents().size() < 2; i++)
+                waitFor(0.01);
+            
+            THEN("the messages above the high watermark are rejected until the queue drains to its low watermark")
+            {
+                std::vector<bool> expectedResults{true, true, true, false, false};
+                std::vector<std::string> expectedMessages(messages.begin(), messages.begin() + 3);
+                std::vector<FlowControlEvent> expectedEvents{FlowControlEvent::WRITE_QUEUE_HIGH, FlowControlEvent::WRITE_QUEUE_LOW};
+                
+                CHECK(sendResults == expectedResults);
+                CHECK(connections.local->getRejectedWritesCount() == 2);
+                CHECK(connections.local->getWriteQueueBlocksCount() == 1);
+                CHECK(connections.getLocalFlowControlEvents() == expectedEvents);
+                CHECK(connections.getReceivedMessages() == expectedMessages);
+                CHECK(connections.getWriteResults() == std::vector<bool>(3, true));
+                CHECK_FALSE(connections.local->isWriteQueueBlocked());
+                
+                CHECK(connections.send(std::vector<std::string>{"message_5"}) == std::vector<bool>{true});
+                connections.waitForMessages(4);
+                CHECK(connections.getReceivedMessages().back() == "message_5");
+            }
+        }
+    }
+    
+    GIVEN("a pair of connections with a bounded read queue")
+    {
+        Connection::QueueWatermarks unbounded{0, 0, 0, 0};
+        ConnectionPair connections(3, unbounded, Connection::QueueWatermarks{0, 0, 2, 1});
+        REQUIRE(connections.remote->isActive());
+        
+        WHEN("the received messages are not handled")
+        {
+            connections.holdReceivedDataInHandler();
+            std::vector<std::string> messages = createMessages(4);
+            connections.send(messages);
+            
+            for(unsigned int i = 0; i < 500 && !connections.remote->isReadingPaused(); i++)
+                waitFor(0.01);
+            
+            THEN("reading is paused at the high watermark and resumed once the handlers catch up")
+            {
+                //data events are delivered one at a time, so the second message waits for the first one to be handled
+                CHECK(connections.remote->isReadingPaused());
+                CHECK(connections.remote->getReadPausesCount() == 1);
+                CHECK(connections.getReceivedMessages().size() == 1);
+                
+                connections.releaseReceivedData();
+                connections.waitForMessages(messages.size());
+                for(unsigned int i = 0; i < 500 && connections.remote->isReadingPaused(); i++)
+                    waitFor(0.01);
+                
+                for(unsigned int i = 0; i < 500 && connections.getRemoteFlowControlEvents().size() < 2; i++)
+                    waitFor(0.01);
+                
+                std::vector<FlowControlEvent> remoteEvents = connections.getRemoteFlowControlEvents();
+                
+                CHECK(connections.getReceivedMessages() == messages);
+                CHECK_FALSE(connections.remote->isReadingPaused());
+                REQUIRE(remoteEvents.size() >= 2);
+                CHECK(remoteEvents[0] == FlowControlEvent::READ_QUEUE_HIGH);
+                CHECK(remoteEvents[1] == FlowControlEvent::READ_QUEUE_LOW);
+            }
+        }
+    }
+    
+    GIVEN("a pair of connections with an unbounded read queue")
+    {
+        Connection::QueueWatermarks unbounded{0, 0, 0, 0};
+        ConnectionPair connections(3, unbounded, unbounded);
+        REQUIRE(connections.remote->isActive());
+        
+        WHEN("the data handler keeps the received data and asks for reading to be paused")
+        {
+            connections.keepReceivedDataInQueue(true);
+            std::vector<std::string> messages = createMessages(4);
+            connections.send(std::vector<std::string>(messages.begin(), messages.begin() + 1));
+            connections.waitForMessages(1);
+            connections.send(std::vector<std::string>(messages.begin() + 1, messages.end()));
+            
+            for(unsigned int i = 0; i < 500 && !connections.remote->isReadingPaused(); i++)
+                waitFor(0.01);
+            
+            THEN("reading is paused until the kept data is released")
+            {
+                CHECK(connections.remote->isReadingPaused());
+                CHECK(connections.remote->getReadPausesCount() == 1);
+                CHECK(connections.getReceivedMessages().size() == 1);
+                
+                connections.releaseKeptData();
+                connections.waitForMessages(messages.size());
+                
+                for(unsigned int i = 0; i < 500 && connections.getRemoteFlowControlEvents().size() < 2; i++)
+                    waitFor(0.01);
+                
+                std::vector<FlowControlEvent> remoteEvents = connections.getRemoteFlowControlEvents();
+                
+                CHECK(connections.getReceivedMessages() == messages);
+                CHECK_FALSE(connections.remote->isReadingPaused());
+                CHECK(connections.remote->getReadPausesCount() == 1);
+                REQUIRE(remoteEvents.size() == 2);
+                CHECK(remoteEvents[0] == FlowControlEvent::READ_QUEUE_HIGH);
+                CHECK(remoteEvents[1] == FlowControlEvent::READ_QUEUE_LOW);
+            }
+        }
+    }
+}
@@ -18,12 +18,27 @@
 #include "../../BasicSpec.h"
 #include "../../Fixtures.h"
 #include <atomic>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include "../../../main/NetworkManagement/Types/Types.h"
 #include "../../../main/NetworkManagement/Connections/ConnectionManager.h"
 #include "../../../main/Utilities/FileLogger.h"
 
 using NetworkManagement_Connections::ConnectionManager;
 
+namespace
+{
+    /** Retrieves the value of the specified option of the supplied socket (-1 = failed). */
+    int getSocketOption(int socketHandle, int level, int option)
+    {
+        int value = 0;
+        socklen_t valueSize = sizeof(value);
+        return (getsockopt(socketHandle, level, option, &value, &valueSize) == 0) ? value : -1;
+    }
+}
+
 SCENARIO("Connection managers are created and can handle incoming/outgoing connections",
          "[ConnectionManager][Connections][NetworkManagement]")
 {
@@ -90,7 +105,7 @@ SCENARIO("Connection managers are created and can handle incoming/outgoing conne
                 ++dataSentCount;
             };
 
-            auto dataReceivedHandler = [&dataReceivedCount](ByteData data, PacketSize remainingData)
+            auto dataReceivedHandler = [&dataReceivedCount](const BufferView & data, PacketSize remainingData)
             {
                 ++dataReceivedCount;
             };
@@ -132,7 +147,7 @@ SCENARIO("Connection managers are created and can handle incoming/outgoing conne
                 testPool.assignTask(disconnectTask);
             };
 
-            auto dataReceivedHandler = [connection, &dataReceivedCount, &targetToSourceData](ByteData data, PacketSize remainingData)
+            auto dataReceivedHandler = [connection, &dataReceivedCount, &targetToSourceData](const BufferView & data, PacketSize remainingData)
             {
                 connection->sendData(targetToSourceData);
                 ++dataReceivedCount;
@@ -242,4 +257,290 @@ SCENARIO("Connection managers are created and can handle incoming/outgoing conne
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Connection managers can distribute connections between multiple reactors",
+         "[ConnectionManager][Connections][NetworkManagement]")
+{
+    GIVEN("a single-reactor source and a multi-reactor target ConnectionManager")
+    {
+        unsigned int connectionsToRequest = 200;
+        unsigned int maxWaitAttempts = 6;
+        unsigned int defaultWaitTime = 5;
+        unsigned int targetReactors = 4;
+        std::string localAddress = "127.0.0.1";
+        unsigned int localPort = 19011;
+        std::string remoteAddress = "127.0.0.1";
+        unsigned int remotePort = 19012;
+
+        ConnectionManager::ConnectionManagerParameters sourceParameters
+        {
+            ConnectionType::COMMAND,    //ConnectionType managerType;
+            PeerType::SERVER,           //PeerType localPeerType;
+            localAddress,               //IPAddress listeningAddress;
+            localPort,                  //IPPort listeningPort;
+            0,                          //unsigned int maxActiveConnections;
+            2,                          //unsigned int initialThreadPoolSize;
+            0,                          //OperationTimeoutLength connectionRequestTimeout;
+            512                         //BufferSize defaultReadBufferSize;
+        };
+
+        ConnectionManager::ConnectionManagerParameters targetParameters
+        {
+            ConnectionType::COMMAND,    //ConnectionType managerType;
+            PeerType::SERVER,           //PeerType localPeerType;
+            remoteAddress,              //IPAddress listeningAddress;
+            remotePort,                 //IPPort listeningPort;
+            0,                          //unsigned int maxActiveConnections;
+            0,                          //unsigned int initialThreadPoolSize;
+            0,                          //OperationTimeoutLength connectionRequestTimeout;
+            512,                        //BufferSize defaultReadBufferSize;
+            {},                         //Connection::QueueWatermarks writeQueueWatermarks;
+            {},                         //Connection::QueueWatermarks readQueueWatermarks;
+            {},                         //AdmissionController::AdmissionLimits admissionLimits;
+            targetReactors,             //unsigned int reactorsCount;
+            true                        //bool pinReactorThreads;
+        };
+
+        ConnectionManager sourceManager(sourceParameters);
+        ConnectionManager targetManager(targetParameters);
+
+        std::atomic<unsigned int> connectionsInitiated(0);
+        std::atomic<unsigned int> connectionsAccepted(0);
+        std::atomic<unsigned int> dataReceivedCount(0);
+
+        auto sourceSuccessHandler = [&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            ++connectionsInitiated;
+            connection->enableDataEvents();
+            connection->sendData(ByteData("SOURCE->TARGET"));
+        };
+
+        auto targetSuccessHandler = [&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            ++connectionsAccepted;
+
+            auto dataReceivedHandler = [&dataReceivedCount](const BufferView & data, PacketSize remainingData)
+            {
+                ++dataReceivedCount;
+            };
+
+            connection->onDataReceivedEventAttach(dataReceivedHandler);
+            connection->enableDataEvents();
+        };
+
+        sourceManager.onConnectionCreatedEventAttach(sourceSuccessHandler);
+        targetManager.onConnectionCreatedEventAttach(targetSuccessHandler);
+
+        CHECK(sourceManager.getReactorsCount() == 1);
+        CHECK_FALSE(sourceManager.areReactorThreadsPinned());
+        CHECK(targetManager.getReactorsCount() == targetReactors);
+        CHECK(targetManager.areReactorThreadsPinned());
+        CHECK_THROWS_AS(targetManager.getIncomingConnectionsCount(targetReactors), std::out_of_range);
+
+        WHEN("new connections are requested for the multi-reactor target")
+        {
+            for(unsigned int i = 0; i < connectionsToRequest; i++)
+                sourceManager.initiateNewConnection(remoteAddress, remotePort);
+
+            unsigned int currentWaitAttempts = 0;
+            while(dataReceivedCount != connectionsToRequest && maxWaitAttempts != currentWaitAttempts)
+            {
+                ++currentWaitAttempts;
+                waitFor(defaultWaitTime);
+            }
+
+            THEN("they are accepted by all reactors and can receive data")
+            {
+                CHECK(connectionsInitiated == connectionsToRequest);
+                CHECK(connectionsAccepted == connectionsToRequest);
+                CHECK(dataReceivedCount == connectionsToRequest);
+                CHECK(targetManager.getTotalIncomingConnectionsCount() == connectionsToRequest);
+                CHECK(targetManager.getIncomingConnectionsCount() == connectionsToRequest);
+
+                unsigned long reactorConnections = 0;
+                for(unsigned int i = 0; i < targetReactors; i++)
+                {
+                    unsigned long currentReactorConnections = targetManager.getIncomingConnectionsCount(i);
+                    CHECK(currentReactorConnections > 0);
+                    reactorConnections += currentReactorConnections;
+                }
+
+                CHECK(reactorConnections == connectionsToRequest);
+            }
+        }
+    }
+}
+
+SCENARIO("Connection managers apply their TCP options to incoming and outgoing connections",
+         "[ConnectionManager][Connections][NetworkManagement]")
+{
+    GIVEN("a source and a target ConnectionManager with different socket options")
+    {
+        unsigned int connectionsToRequest = 5;
+        unsigned int maxWaitAttempts = 50;
+        std::string localAddress = "127.0.0.1";
+        unsigned int localPort = 19021;
+        std::string remoteAddress = "127.0.0.1";
+        unsigned int remotePort = 19022;
+
+        ConnectionManager::SocketOptions commandOptions
+        {
+            true,       //bool noDelay;
+            0,          //BufferSize sendBufferSize;
+            0,          //BufferSize receiveBufferSize;
+            true,       //bool keepAlive;
+            30,         //unsigned int keepAliveIdle;
+            5,          //unsigned int keepAliveInterval;
+            3,          //unsigned int keepAliveProbes;
+            10000,      //unsigned int userTimeout;
+            true        //bool quickAck;
+        };
+
+        ConnectionManager::SocketOptions dataOptions
+        {
+            false,      //bool noDelay;
+            256*1024,   //BufferSize sendBufferSize;
+            512*1024,   //BufferSize receiveBufferSize;
+            false,      //bool keepAlive;
+            0,          //unsigned int keepAliveIdle;
+            0,          //unsigned int keepAliveInterval;
+            0,          //unsigned int keepAliveProbes;
+            0,          //unsigned int userTimeout;
+            false       //bool quickAck;
+        };
+
+        ConnectionManager::ConnectionManagerParameters sourceParameters
+        {
+            ConnectionType::COMMAND,    //ConnectionType managerType;
+            PeerType::SERVER,           //PeerType localPeerType;
+            localAddress,               //IPAddress listeningAddress;
+            localPort,                  //IPPort listeningPort;
+            0,                          //unsigned int maxActiveConnections;
+            2,                          //unsigned int initialThreadPoolSize;
+            0,                          //OperationTimeoutLength connectionRequestTimeout;
+            512,                        //BufferSize defaultReadBufferSize;
+            {},                         //Connection::QueueWatermarks writeQueueWatermarks;
+            {},                         //Connection::QueueWatermarks readQueueWatermarks;
+            {},                         //AdmissionController::AdmissionLimits admissionLimits;
+            0,                          //unsigned int reactorsCount;
+            false,                      //bool pinReactorThreads;
+            commandOptions              //SocketOptions socketOptions;
+        };
+
+        ConnectionManager::ConnectionManagerParameters targetParameters
+        {
+            ConnectionType::COMMAND,     //ConnectionType managerType;
+            PeerType::SERVER,           //PeerType localPeerType;
+            remoteAddress,              //IPAddress listeningAddress;
+            remotePort,                 //IPPort listeningPort;
+            0,                          //unsigned int maxActiveConnections;
+            2,                          //unsigned int initialThreadPoolSize;
+            0,                          //OperationTimeoutLength connectionRequestTimeout;
+            512,                        //BufferSize defaultReadBufferSize;
+            {},                         //Connection::QueueWatermarks writeQueueWatermarks;
+            {},                         //Connection::QueueWatermarks readQueueWatermarks;
+            {},                         //AdmissionController::AdmissionLimits admissionLimits;
+            0,                          //unsigned int reactorsCount;
+            false,                      //bool pinReactorThreads;
+            dataOptions                 //SocketOptions socketOptions;
+        };
+
+        ConnectionManager sourceManager(sourceParameters);
+        ConnectionManager targetManager(targetParameters);
+
+        boost::mutex connectionsMutex;
+        std::vector<ConnectionPtr> sourceConnections;
+        std::vector<ConnectionPtr> targetConnections;
+
+        sourceManager.onConnectionCreatedEventAttach([&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            boost::lock_guard<boost::mutex> connectionsLock(connectionsMutex);
+            sourceConnections.push_back(connection);
+        });
+
+        targetManager.onConnectionCreatedEventAttach([&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            boost::lock_guard<boost::mutex> connectionsLock(connectionsMutex);
+            targetConnections.push_back(connection);
+        });
+
+        CHECK(sourceManager.getSocketOptions().isSet());
+        CHECK(sourceManager.getSocketOptions().keepAliveIdle == 30);
+        CHECK(targetManager.getSocketOptions().receiveBufferSize == 512*1024);
+
+        WHEN("new connections are made between the managers")
+        {
+            for(unsigned int i = 0; i < connectionsToRequest; i++)
+                sourceManager.initiateNewConnection(remoteAddress, remotePort);
+
+            unsigned int currentWaitAttempts = 0;
+            while(currentWaitAttempts++ < maxWaitAttempts)
+            {
+                {
+                    boost::lock_guard<boost::mutex> connectionsLock(connectionsMutex);
+                    if(sourceConnections.size() == connectionsToRequest && targetConnections.size() == connectionsToRequest)
+                        break;
+                }
+
+                waitFor(0.1);
+            }
+
+            boost::lock_guard<boost::mutex> connectionsLock(connectionsMutex);
+
+            THEN("the outgoing sockets have the source manager's options")
+            {
+                REQUIRE(sourceConnections.size() == connectionsToRequest);
+                for(const ConnectionPtr & currentConnection : sourceConnections)
+                {
+                    int socketHandle = currentConnection->getNativeSocketHandle();
+                    CHECK(getSocketOption(socketHandle, IPPROTO_TCP, TCP_NODELAY) > 0);
+                    CHECK(getSocketOption(socketHandle, SOL_SOCKET, SO_KEEPALIVE) > 0);
+                    CHECK(getSocketOption(socketHandle, IPPROTO_TCP, TCP_KEEPIDLE) == 30);
+                    CHECK(getSocketOption(socketHandle, IPPROTO_TCP, TCP_KEEPINTVL) == 5);
+                    CHECK(getSocketOption(socketHandle, IPPROTO_TCP, TCP_KEEPCNT) == 3);
+                    CHECK(getSocketOption(socketHandle, IPPROTO_TCP, TCP_USER_TIMEOUT) == 10000);
+                }
+            }
+
+            AND_THEN("the incoming sockets have the target manager's options")
+            {
+                REQUIRE(targetConnections.size() == connectionsToRequest);
+                for(const ConnectionPtr & currentConnection : targetConnections)
+                {
+                    int socketHandle = currentConnection->getNativeSocketHandle();
+                    CHECK(getSocketOption(socketHandle, IPPROTO_TCP, TCP_NODELAY) == 0);
+                    CHECK(getSocketOption(socketHandle, SOL_SOCKET, SO_KEEPALIVE) == 0);
+                    CHECK(getSocketOption(socketHandle, SOL_SOCKET, SO_SNDBUF) >= 256*1024); //the kernel may double the value
+                    CHECK(getSocketOption(socketHandle, SOL_SOCKET, SO_RCVBUF) >= 512*1024);
+                }
+            }
+        }
+    }
+
+    GIVEN("invalid socket options")
+    {
+        ConnectionManager::ConnectionManagerParameters invalidParameters
+        {
+            ConnectionType::COMMAND,    //ConnectionType managerType;
+            PeerType::SERVER,           //PeerType localPeerType;
+            "127.0.0.1",                //IPAddress listeningAddress;
+            19023,                      //IPPort listeningPort;
+            0,                          //unsigned int maxActiveConnections;
+            1,                          //unsigned int initialThreadPoolSize;
+            0,                          //OperationTimeoutLength connectionRequestTimeout;
+            512,                        //BufferSize defaultReadBufferSize;
+            {},                         //Connection::QueueWatermarks writeQueueWatermarks;
+            {},                         //Connection::QueueWatermarks readQueueWatermarks;
+            {},                         //AdmissionController::AdmissionLimits admissionLimits;
+            0,                          //unsigned int reactorsCount;
+            false,                      //bool pinReactorThreads;
+            {false, 0, 0, false, 30}    //SocketOptions socketOptions; (keepalive timing without keepalive)
+        };
+
+        THEN("ConnectionManagers cannot be created")
+        {
+            CHECK_THROWS_AS(ConnectionManager(invalidParameters), std::invalid_argument);
+        }
+    }
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (C) 2016 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../BasicSpec.h"
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include "../../../main/NetworkManagement/Types/Types.h"
+#include "../../../main/NetworkManagement/Connections/ConnectionManager.h"
+
+using NetworkManagement_Connections::ConnectionManager;
+
+namespace
+{
+    /** Benchmark results for a single socket options profile. */
+    struct BenchmarkResult
+    {
+        unsigned long messages;     //number of completed messages (or round trips)
+        double messagesPerSecond;   //message throughput
+        double megabytesPerSecond;  //data throughput
+        long p50;                   //median round trip latency (in microseconds; latency workloads only)
+        long p99;                   //99th percentile round trip latency (in microseconds; latency workloads only)
+    };
+
+    /** Retrieves the specified percentile from a sorted set of latencies. */
+    long getPercentile(const std::vector<long> & sortedLatencies, double percentile)
+    {
+        if(sortedLatencies.empty())
+            return 0;
+
+        std::size_t index = static_cast<std::size_t>(percentile * (sortedLatencies.size() - 1));
+        return sortedLatencies[index];
+    }
+
+    /** Creates the parameters for a benchmark manager with the specified socket options. */
+    ConnectionManager::ConnectionManagerParameters createParameters
+    (ConnectionType type, IPPort port, BufferSize readBufferSize, const ConnectionManager::SocketOptions & options)
+    {
+        return ConnectionManager::ConnectionManagerParameters
+        {
+            type,                       //ConnectionType managerType;
+            PeerType::SERVER,           //PeerType localPeerType;
+            "127.0.0.1",                //IPAddress listeningAddress;
+            port,                       //IPPort listeningPort;
+            0,                          //unsigned int maxActiveConnections;
+            2,                          //unsigned int initialThreadPoolSize;
+            0,                          //OperationTimeoutLength connectionRequestTimeout;
+            readBufferSize,             //BufferSize defaultReadBufferSize;
+            {},                         //Connection::QueueWatermarks writeQueueWatermarks;
+            {},                         //Connection::QueueWatermarks readQueueWatermarks;
+            {},                         //AdmissionController::AdmissionLimits admissionLimits;
+            0,                          //unsigned int reactorsCount;
+            false,                      //bool pinReactorThreads;
+            options                     //SocketOptions socketOptions;
+        };
+    }
+
+    /** Waits until the supplied flag is set or the specified number of seconds has passed. */
+    void waitUntilDone(const std::atomic<bool> & done, unsigned int maxSeconds)
+    {
+        for(unsigned int i = 0; i < maxSeconds * 20 && !done; i++)
+            waitFor(0.05);
+    }
+
+    /**
+     * Sends small messages back and forth over a single connection, one at a time,
+     * and measures the round trip latency.
+     */
+    BenchmarkResult runLatencyWorkload(const ConnectionManager::SocketOptions & options, IPPort basePort,
+                                       unsigned int roundTrips, BufferSize messageSize)
+    {
+        ConnectionManager sourceManager(createParameters(ConnectionType::COMMAND, basePort, 512, options));
+        ConnectionManager targetManager(createParameters(ConnectionType::COMMAND, basePort + 1, 512, options));
+
+        ByteData message(messageSize, 'm');
+        std::vector<long> latencies;
+        latencies.reserve(roundTrips);
+        std::atomic<bool> done{false};
+        boost::posix_time::ptime lastSent;
+        boost::posix_time::ptime workloadStart;
+        boost::posix_time::ptime workloadEnd;
+
+        //the target echoes each complete message; the source sends the next one when the echo arrives
+        targetManager.onConnectionCreatedEventAttach([&message](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            Connection * rawConnection = connection.get();
+            connection->onDataReceivedEventAttach([rawConnection, &message](const BufferView & data, PacketSize remainingData)
+            {
+                if(remainingData == 0)
+                    rawConnection->sendData(message);
+            });
+
+            connection->enableDataEvents();
+        });
+
+        sourceManager.onConnectionCreatedEventAttach([&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            Connection * rawConnection = connection.get();
+            connection->onDataReceivedEventAttach([&, rawConnection](const BufferView & data, PacketSize remainingData)
+            {
+                if(remainingData > 0 || done)
+                    return;
+
+                boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+                latencies.push_back((now - lastSent).total_microseconds());
+
+                if(latencies.size() < roundTrips)
+                {
+                    lastSent = now;
+                    rawConnection->sendData(message);
+                }
+                else
+                {
+                    workloadEnd = now;
+                    done = true;
+                }
+            });
+
+            connection->enableDataEvents();
+
+            workloadStart = boost::posix_time::microsec_clock::universal_time();
+            lastSent = workloadStart;
+            connection->sendData(message);
+        });
+
+        sourceManager.initiateNewConnection("127.0.0.1", basePort + 1);
+        waitUntilDone(done, 60);
+
+        if(!done)
+            return BenchmarkResult{0, 0.0, 0.0, 0, 0};
+
+        std::sort(latencies.begin(), latencies.end());
+        double seconds = std::max((workloadEnd - workloadStart).total_microseconds(), (boost::posix_time::time_duration::tick_type)1) / 1000000.0;
+
+        return BenchmarkResult
+        {
+            latencies.size(),
+            latencies.size() / seconds,
+            (2.0 * latencies.size() * messageSize) / seconds / (1024 * 1024),
+            getPercentile(latencies, 0.5),
+            getPercentile(latencies, 0.99)
+        };
+    }
+
+    /**
+     * Sends large messages in one direction over a single connection, as fast
+     * as they can be queued, and measures the throughput.
+     */
+    BenchmarkResult runThroughputWorkload(const ConnectionManager::SocketOptions & options, IPPort basePort,
+                                          unsigned int messagesCount, BufferSize messageSize)
+    {
+        ConnectionManager sourceManager(createParameters(ConnectionType::DATA, basePort, 64 * 1024, options));
+        ConnectionManager targetManager(createParameters(ConnectionType::DATA, basePort + 1, 64 * 1024, options));
+
+        ByteDataPtr message(new ByteData(messageSize, 'd'));
+        std::atomic<unsigned long> messagesReceived{0};
+        std::atomic<bool> done{false};
+        boost::posix_time::ptime workloadStart;
+        boost::posix_time::ptime workloadEnd;
+
+        targetManager.onConnectionCreatedEventAttach([&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            connection->onDataReceivedEventAttach([&](const BufferView & data, PacketSize remainingData)
+            {
+                if(remainingData == 0 && ++messagesReceived == messagesCount)
+                {
+                    workloadEnd = boost::posix_time::microsec_clock::universal_time();
+                    done = true;
+                }
+            });
+
+            connection->enableDataEvents();
+        });
+
+        sourceManager.onConnectionCreatedEventAttach([&](ConnectionPtr connection, ConnectionInitiation init)
+        {
+            connection->enableDataEvents();
+
+            workloadStart = boost::posix_time::microsec_clock::universal_time();
+            for(unsigned int i = 0; i < messagesCount; i++)
+                connection->sendData(message);
+        });
+
+        sourceManager.initiateNewConnection("127.0.0.1", basePort + 1);
+        waitUntilDone(done, 60);
+
+        if(!done)
+            return BenchmarkResult{messagesReceived, 0.0, 0.0, 0, 0};
+
+        double seconds = std::max((workloadEnd - workloadStart).total_microseconds(), (boost::posix_time::time_duration::tick_type)1) / 1000000.0;
+
+        return BenchmarkResult
+        {
+            messagesReceived,
+            messagesReceived / seconds,
+            ((double)messagesReceived * messageSize) / seconds / (1024 * 1024),
+            0,
+            0
+        };
+    }
+
+    /** Reports the specified workload results. */
+    void reportResult(const std::string & workload, const std::string & profile, const BenchmarkResult & result)
+    {
+        WARN(workload << " / " << profile << ": "
+             << "messages [" << result.messages << "]; "
+             << "throughput [" << (unsigned long)result.messagesPerSecond << " msg/s; " << result.megabytesPerSecond << " MB/s]; "
+             << "latency p50/p99 [" << result.p50 << "/" << result.p99 << " us]");
+    }
+}
+
+SCENARIO("TCP socket options affect connection latency and throughput", "[.][benchmark][ConnectionManager][Connections][NetworkManagement]")
+{
+    GIVEN("the default, command and data socket options profiles")
+    {
+        ConnectionManager::SocketOptions defaultProfile{};
+
+        ConnectionManager::SocketOptions commandProfile
+        {
+            true,       //bool noDelay;
+            0,          //BufferSize sendBufferSize;
+            0,          //BufferSize receiveBufferSize;
+            true,       //bool keepAlive;
+            60,         //unsigned int keepAliveIdle;
+            10,         //unsigned int keepAliveInterval;
+            3,          //unsigned int keepAliveProbes;
+            30000,      //unsigned int userTimeout;
+            true        //bool quickAck;
+        };
+
+        ConnectionManager::SocketOptions dataProfile
+        {
+            false,      //bool noDelay;
+            4*1024*1024,//BufferSize sendBufferSize;
+            4*1024*1024,//BufferSize receiveBufferSize;
+            true,       //bool keepAlive;
+            60,         //unsigned int keepAliveIdle;
+            10,         //unsigned int keepAliveInterval;
+            3,          //unsigned int keepAliveProbes;
+            0,          //unsigned int userTimeout;
+            false       //bool quickAck;
+        };
+
+        std::vector<std::pair<std::string, ConnectionManager::SocketOptions>> profiles
+        {
+            {"default", defaultProfile},
+            {"command", commandProfile},
+            {"data", dataProfile}
+        };
+
+        WHEN("request/response and bulk transfer workloads are run with each profile")
+        {
+            IPPort nextPort = 19500;
+
+            for(const std::pair<std::string, ConnectionManager::SocketOptions> & currentProfile : profiles)
+            {
+                reportResult("Latency (2000 x 64B round trips)", currentProfile.first,
+                             runLatencyWorkload(currentProfile.second, nextPort, 2000, 64));
+                nextPort += 2;
+
+                reportResult("Latency (500 x 16KB round trips)", currentProfile.first,
+                             runLatencyWorkload(currentProfile.second, nextPort, 500, 16 * 1024));
+                nextPort += 2;
+
+                reportResult("Throughput (1000 x 256KB)", currentProfile.first,
+                             runThroughputWorkload(currentProfile.second, nextPort, 1000, 256 * 1024));
+                nextPort += 2;
+            }
+
+            THEN("the results are reported")
+            {
+                SUCCEED();
+            }
+        }
+    }
+}
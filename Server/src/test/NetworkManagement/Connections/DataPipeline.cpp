@@ -0,0 +1,216 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "../../BasicSpec.h"
+#include "../../../main/NetworkManagement/Connections/DataPipeline.h"
+
+using NetworkManagement_Connections::DataPipeline;
+
+SCENARIO("Data pipelines process the tasks of each connection in order", "[DataPipeline][DataConnectionsHandler][NetworkManagement]")
+{
+    GIVEN("a DataPipeline with multiple workers")
+    {
+        DataPipeline testPipeline(4, 1000, 10);
+        
+        CHECK(testPipeline.getWorkersCount() == 4);
+        CHECK(testPipeline.getMaxQueuedTasks() == 1000);
+        CHECK(testPipeline.getMaxIncomingTasksPerLane() == 10);
+        
+        WHEN("tasks for multiple connections are submitted")
+        {
+            const unsigned int connectionsCount = 4;
+            const unsigned int tasksCount = 100;
+            boost::mutex resultsMutex;
+            std::vector<std::vector<unsigned int>> results(connectionsCount);
+            std::atomic<unsigned int> activeTasks[connectionsCount];
+            std::atomic<bool> overlapFound{false};
+            
+            for(unsigned int connection = 0; connection < connectionsCount; connection++)
+                activeTasks[connection] = 0;
+            
+            for(unsigned int task = 0; task < tasksCount; task++)
+            {
+                for(unsigned int connection = 0; connection < connectionsCount; connection++)
+                {
+                    auto nextTask = [connection, task, &resultsMutex, &results, &activeTasks, &overlapFound]()
+                    {
+                        if(++activeTasks[connection] > 1)
+                            overlapFound = true;
+                        
+                        {
+                            DataPipeline::StageTimer timer(nullptr, DataPipelineStage::COMPRESS);
+                            boost::lock_guard<boost::mutex> resultsLock(resultsMutex);
+                            results[connection].push_back(task);
+                        }
+                        
+                        --activeTasks[connection];
+                    };
+                    
+                    if(task % 2 == 0)
+                        CHECK(testPipeline.submitOutgoing(connection, nextTask));
+                    else
+                        CHECK(testPipeline.submitIncoming(connection, nextTask));
+                }
+            }
+            
+            unsigned int waits = 0;
+            while(testPipeline.getProcessedTasksCount() < (connectionsCount * tasksCount) && waits++ < 100)
+                waitFor(0.05);
+            
+            THEN("the tasks of each connection are processed one at a time, in submission order")
+            {
+                CHECK(testPipeline.getProcessedTasksCount() == (connectionsCount * tasksCount));
+                CHECK(testPipeline.getFailedTasksCount() == 0);
+                CHECK_FALSE(overlapFound);
+                
+                boost::lock_guard<boost::mutex> resultsLock(resultsMutex);
+                for(unsigned int connection = 0; connection < connectionsCount; connection++)
+                {
+                    REQUIRE(results[connection].size() == tasksCount);
+                    for(unsigned int task = 0; task < tasksCount; task++)
+                        CHECK(results[connection][task] == task);
+                }
+            }
+            
+            AND_THEN("the time spent in the queues is recorded")
+            {
+                CHECK(testPipeline.getStageOperationsCount(DataPipelineStage::OUTGOING_QUEUE) == (connectionsCount * tasksCount / 2));
+                CHECK(testPipeline.getStageOperationsCount(DataPipelineStage::INCOMING_QUEUE) == (connectionsCount * tasksCount / 2));
+                CHECK(testPipeline.getStageOperationsCount(DataPipelineStage::COMPRESS) == 0);
+                CHECK(testPipeline.getQueuedOutgoingTasksCount() == 0);
+                CHECK(testPipeline.getQueuedIncomingTasksCount() == 0);
+            }
+        }
+    }
+    
+    GIVEN("invalid pipeline parameters")
+    {
+        THEN("DataPipelines cannot be created")
+        {
+            CHECK_THROWS_AS(DataPipeline(0, 10, 10), std::invalid_argument);
+            CHECK_THROWS_AS(DataPipeline(1, 0, 10), std::invalid_argument);
+            CHECK_THROWS_AS(DataPipeline(1, 10, 0), std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("Data pipelines limit their queues and record stage timings", "[DataPipeline][DataConnectionsHandler][NetworkManagement]")
+{
+    GIVEN("a DataPipeline with a single worker and small queues")
+    {
+        DataPipeline testPipeline(1, 2, 2);
+        boost::mutex blockingMutex;
+        boost::unique_lock<boost::mutex> blockingLock(blockingMutex);
+        
+        WHEN("the worker is busy and more outgoing tasks are submitted than the queue can hold")
+        {
+            std::atomic<unsigned int> tasksDone{0};
+            auto blockingTask = [&blockingMutex, &tasksDone]()
+            {
+                boost::lock_guard<boost::mutex> lock(blockingMutex);
+                ++tasksDone;
+            };
+            
+            auto timedTask = [&testPipeline, &tasksDone]()
+            {
+                DataPipeline::StageTimer timer(&testPipeline, DataPipelineStage::ENCRYPT);
+                waitFor(0.01);
+                ++tasksDone;
+            };
+            
+            CHECK(testPipeline.submitOutgoing(1, blockingTask));
+            CHECK(testPipeline.submitOutgoing(2, timedTask));
+            bool thirdAccepted = testPipeline.submitOutgoing(3, timedTask);
+            bool continuationAccepted = testPipeline.submitContinuation(3, timedTask);
+            
+            blockingLock.unlock();
+            
+            unsigned int waits = 0;
+            while(tasksDone < 3 && waits++ < 100)
+                waitFor(0.05);
+            
+            THEN("the extra tasks are rejected, except for continuations")
+            {
+                CHECK_FALSE(thirdAccepted);
+                CHECK(continuationAccepted);
+                CHECK(testPipeline.getRejectedTasksCount() == 1);
+                CHECK(tasksDone == 3);
+            }
+            
+            AND_THEN("the time spent in the timed stage is recorded")
+            {
+                CHECK(testPipeline.getStageOperationsCount(DataPipelineStage::ENCRYPT) == 2);
+                CHECK(testPipeline.getStageMaxTime(DataPipelineStage::ENCRYPT) >= 10000);
+                CHECK(testPipeline.getStageTotalTime(DataPipelineStage::ENCRYPT) >= testPipeline.getStageMaxTime(DataPipelineStage::ENCRYPT));
+                CHECK(testPipeline.getStageAverageTime(DataPipelineStage::ENCRYPT) >= 10000);
+                CHECK(testPipeline.getStageAverageTime(DataPipelineStage::DECRYPT) == 0);
+            }
+        }
+        
+        WHEN("the worker is busy and more incoming tasks are submitted for a connection than its lane can hold")
+        {
+            std::atomic<unsigned int> tasksDone{0};
+            auto blockingTask = [&blockingMutex, &tasksDone]()
+            {
+                boost::lock_guard<boost::mutex> lock(blockingMutex);
+                ++tasksDone;
+            };
+            
+            auto task = [&tasksDone]()
+            {
+                ++tasksDone;
+            };
+            
+            bool emptyLaneFull = testPipeline.isIncomingLaneFull(1, 1);
+            CHECK(testPipeline.submitIncoming(1, blockingTask));
+            bool laneFullBeforeLimit = testPipeline.isIncomingLaneFull(1);
+            bool laneFullWithNextTask = testPipeline.isIncomingLaneFull(1, 1);
+            CHECK(testPipeline.submitIncoming(1, task));
+            CHECK(testPipeline.submitIncoming(1, task));
+            bool laneFullAfterLimit = testPipeline.isIncomingLaneFull(1);
+            CHECK(testPipeline.submitIncoming(2, task));
+            bool otherLaneFull = testPipeline.isIncomingLaneFull(2);
+            unsigned int queuedWhileBlocked = testPipeline.getQueuedIncomingTasksCount();
+            
+            blockingLock.unlock();
+            
+            unsigned int waits = 0;
+            while(tasksDone < 4 && waits++ < 100)
+                waitFor(0.05);
+            
+            THEN("the tasks are queued without waiting and the lane is reported as full")
+            {
+                CHECK_FALSE(emptyLaneFull);
+                CHECK_FALSE(laneFullBeforeLimit);
+                CHECK(laneFullWithNextTask);
+                CHECK(laneFullAfterLimit);
+                CHECK_FALSE(otherLaneFull);
+                CHECK(queuedWhileBlocked == 4);
+                CHECK(testPipeline.getFullIncomingLanesCount() == 1);
+                CHECK(testPipeline.getRejectedTasksCount() == 0);
+                CHECK(tasksDone == 4);
+            }
+            
+            AND_THEN("the lane is no longer full, once its tasks are processed")
+            {
+                CHECK_FALSE(testPipeline.isIncomingLaneFull(1));
+                CHECK(testPipeline.getQueuedIncomingTasksCount() == 0);
+            }
+        }
+    }
+}
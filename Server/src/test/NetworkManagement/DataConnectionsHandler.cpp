@@ -0,0 +1,630 @@
+/**
+ * Copyright (C) 2016 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include <string>
+#include <vector>
+#include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
+#include "../../main/NetworkManagement/DataConnectionsHandler.h"
+#include "../../main/SecurityManagement/Crypto/KeyGenerator.h"
+#include "../../main/DatabaseManagement/Containers/DeviceDataContainer.h"
+
+using NetworkManagement_Connections::Connection;
+using NetworkManagement_Handlers::DataConnectionsHandler;
+using NetworkManagement_Types::PendingDataConnectionConfig;
+using SecurityManagement_Crypto::KeyGenerator;
+using DatabaseManagement_Containers::DeviceDataContainer;
+
+namespace
+{
+    /** Result of a data stream, as reported to its completion handler. */
+    struct StreamResult
+    {
+        bool successful;
+        DataSize transferredBytes;
+    };
+    
+    /** Pair of data connections handlers, each managing one end of a local data connection. */
+    struct HandlerPair
+    {
+        HandlerPair(bool encrypt, BufferSize streamChunkSize, unsigned int pipelineWorkers = 0)
+        : networkService(new boost::asio::io_service()), networkWork(new boost::asio::io_service::work(*networkService)),
+          keyGenerator(
+            {PasswordDerivationFunction::PBKDF2_SHA256, 10000, 32, 16, 16},
+            {SymmetricCipherType::AES, AuthenticatedSymmetricCipherModeType::EAX, 12, 32, 32},
+            {1024, 2048, EllipticCurveType::BP_P384R1, AsymmetricKeyValidationLevel::FULL_3}),
+          senderDevice(new DeviceDataContainer("SENDER_DEVICE", PasswordData(), boost::uuids::random_generator()(), DataTransferType::PULL, PeerType::CLIENT)),
+          receiverDevice(new DeviceDataContainer("RECEIVER_DEVICE", PasswordData(), boost::uuids::random_generator()(), DataTransferType::PULL, PeerType::CLIENT))
+        {
+            SymmetricCryptoDataContainerPtr cryptoData = keyGenerator.getSymmetricCryptoData();
+            SymmetricCryptoHandlerPtr senderCrypto(new SymmetricCryptoHandler(cryptoData));
+            SymmetricCryptoHandlerPtr receiverCrypto(new SymmetricCryptoHandler(
+                    keyGenerator.getSymmetricCryptoData(cryptoData->getKey(), cryptoData->getIV())));
+            frameCrypto.reset(new SymmetricCryptoHandler(keyGenerator.getSymmetricCryptoData(cryptoData->getKey(), cryptoData->getIV())));
+            
+            DataConnectionsHandler::DataConnectionsHandlerParameters senderParams{
+                senderDevice->getDeviceID(), 32, 4096, 1, streamChunkSize, 4, pipelineWorkers, 0, 0, 0.0, 0, 1};
+            DataConnectionsHandler::DataConnectionsHandlerParameters receiverParams{
+                receiverDevice->getDeviceID(), 32, 4096, 1, streamChunkSize, 4, pipelineWorkers, 0, 0, 0.0, 0, 1};
+            
+            PendingDataConnectionConfigPtr senderConfig(new PendingDataConnectionConfig{1, receiverDevice, senderCrypto, encrypt, false});
+            PendingDataConnectionConfigPtr receiverConfig(new PendingDataConnectionConfig{1, senderDevice, receiverCrypto, encrypt, false});
+            encryptionEnabled = encrypt;
+            
+            sender.reset(new DataConnectionsHandler(senderParams,
+                    [](const DeviceID, const TransientConnectionID) { return PendingDataConnectionConfigPtr(); },
+                    [this](const DeviceID &) -> const LocalPeerAuthenticationEntry & { return authenticationEntry; }));
+            
+            receiver.reset(new DataConnectionsHandler(receiverParams,
+                    [receiverConfig](const DeviceID, const TransientConnectionID) { return receiverConfig; },
+                    [this](const DeviceID &) -> const LocalPeerAuthenticationEntry & { return authenticationEntry; }));
+            
+            sender->onConnectionEstablishedEventAttach([this](const DeviceID, const ConnectionID, const TransientConnectionID)
+            {
+                boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                ++connectionsEstablished;
+            });
+            
+            receiver->onConnectionEstablishedEventAttach([this](const DeviceID, const ConnectionID, const TransientConnectionID)
+            {
+                boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                ++connectionsEstablished;
+            });
+            
+            receiver->onDataReceivedEventAttach([this](const DeviceID, const ConnectionID, const PlaintextData data)
+            {
+                boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                receivedData.push_back(data);
+            });
+            
+            boost::asio::ip::tcp::acceptor acceptor(*networkService,
+                    boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+            
+            SocketPtr localSocket(new boost::asio::ip::tcp::socket(*networkService));
+            SocketPtr remoteSocket(new boost::asio::ip::tcp::socket(*networkService));
+            localSocket->connect(acceptor.local_endpoint());
+            acceptor.accept(*remoteSocket);
+            
+            Connection::QueueWatermarks unbounded{0, 0, 0, 0};
+            local.reset(new Connection(networkService,
+                    Connection::ConnectionParamters{ConnectionType::DATA, PeerType::CLIENT, ConnectionInitiation::LOCAL,
+                                                    1, localSocket, 512, unbounded, unbounded, false},
+                    ConnectionRequest{PeerType::CLIENT, ConnectionType::DATA}));
+            
+            remote.reset(new Connection(networkService,
+                    Connection::ConnectionParamters{ConnectionType::DATA, PeerType::CLIENT, ConnectionInitiation::REMOTE,
+                                                    2, remoteSocket, 512, unbounded, unbounded, false}));
+            
+            for(unsigned int i = 0; i < 2; i++)
+                networkThreadGroup.create_thread([this](){ networkService->run(); });
+            
+            for(unsigned int i = 0; i < 500 && !(local->isActive() && remote->isActive()); i++)
+                waitFor(0.01);
+            
+            local->enableLifecycleEvents();
+            remote->enableLifecycleEvents();
+            sender->manageLocalConnection(local, SENDER_CONNECTION_ID, senderConfig);
+            receiver->manageRemoteConnection(remote, RECEIVER_CONNECTION_ID);
+            
+            waitUntil([this](){ return connectionsEstablished == 2; });
+        }
+        
+        ~HandlerPair()
+        {
+            sender.reset();
+            receiver.reset();
+            local->disconnect();
+            remote->disconnect();
+            networkWork.reset();
+            networkService->stop();
+            networkThreadGroup.join_all();
+        }
+        
+        /** Waits until the supplied condition is met (up to 5 seconds); expects the events mutex to NOT be held. */
+        void waitUntil(std::function<bool (void)> condition)
+        {
+            for(unsigned int i = 0; i < 500; i++)
+            {
+                {
+                    boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                    if(condition())
+                        return;
+                }
+                
+                waitFor(0.01);
+            }
+        }
+        
+        /** Sends the supplied data as a stream with the specified ID, from the sender to the receiver. */
+        bool sendStream(const std::string & data, StreamID streamID)
+        {
+            boost::shared_ptr<std::size_t> offset(new std::size_t(0));
+            auto source = [data, offset](Byte * buffer, std::streamsize size) -> std::streamsize
+            {
+                std::size_t bytesToRead = std::min(static_cast<std::size_t>(size), data.size() - *offset);
+                std::copy(data.begin() + *offset, data.begin() + *offset + bytesToRead, buffer);
+                *offset += bytesToRead;
+                return bytesToRead;
+            };
+            
+            return sender->sendStream(receiverDevice->getDeviceID(), SENDER_CONNECTION_ID, source,
+                    [this, streamID](bool successful, DataSize transferredBytes)
+                    {
+                        boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                        sentStreams[streamID] = StreamResult{successful, transferredBytes};
+                    },
+                    streamID);
+        }
+        
+        /** Prepares the receiver for the stream with the specified ID. */
+        bool receiveStream(StreamID streamID)
+        {
+            return receiver->receiveStream(senderDevice->getDeviceID(), RECEIVER_CONNECTION_ID,
+                    [this, streamID](const Byte * data, std::streamsize size) -> std::streamsize
+                    {
+                        boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                        receivedStreamData[streamID].append(reinterpret_cast<const char *>(data), size);
+                        return size;
+                    },
+                    1024 * 1024,
+                    [this, streamID](bool successful, DataSize transferredBytes)
+                    {
+                        boost::lock_guard<boost::mutex> eventsLock(eventsMutex);
+                        receivedStreams[streamID] = StreamResult{successful, transferredBytes};
+                    },
+                    streamID);
+        }
+        
+        /** Sends a stream chunk built by the test (with the supplied header and data) directly on the sender's connection. */
+        void sendRawChunk(StreamChunkHeader header, const std::string & data, bool tamper = false)
+        {
+            ByteData frame;
+            frame.push_back(static_cast<char>(DataFrameType::STREAM_CHUNK));
+            header.toNetworkBytes(frame);
+            
+            if(encryptionEnabled)
+            {
+                CiphertextData encryptedData;
+                frameCrypto->encryptData(data, frame, encryptedData);
+                frame.append(encryptedData);
+            }
+            else
+            {
+                frame.append(data);
+            }
+            
+            if(tamper)
+                frame.back() ^= 0x01;
+            
+            local->sendData(frame);
+        }
+        
+        /** Sends a stream chunk header built by the test directly on the sender's connection, without any data or authentication data. */
+        void sendUnauthenticatedChunk(StreamChunkHeader header)
+        {
+            ByteData frame;
+            frame.push_back(static_cast<char>(DataFrameType::STREAM_CHUNK));
+            header.toNetworkBytes(frame);
+            local->sendData(frame);
+        }
+        
+        std::string createData(std::size_t size)
+        {
+            std::string result;
+            for(std::size_t i = 0; i < size; i++)
+                result.push_back(static_cast<char>('a' + (i % 26)));
+            
+            return result;
+        }
+        
+        static const ConnectionID SENDER_CONNECTION_ID = 1;
+        static const ConnectionID RECEIVER_CONNECTION_ID = 2;
+        
+        boost::shared_ptr<boost::asio::io_service> networkService;
+        boost::shared_ptr<boost::asio::io_service::work> networkWork;
+        boost::thread_group networkThreadGroup;
+        KeyGenerator keyGenerator;
+        SymmetricCryptoHandlerPtr frameCrypto;
+        bool encryptionEnabled;
+        LocalPeerAuthenticationEntry authenticationEntry;
+        DeviceDataContainerPtr senderDevice;
+        DeviceDataContainerPtr receiverDevice;
+        boost::shared_ptr<DataConnectionsHandler> sender;
+        boost::shared_ptr<DataConnectionsHandler> receiver;
+        ConnectionPtr local;
+        ConnectionPtr remote;
+        
+        boost::mutex eventsMutex;
+        unsigned int connectionsEstablished = 0;
+        std::vector<PlaintextData> receivedData;
+        boost::unordered_map<StreamID, StreamResult> sentStreams;
+        boost::unordered_map<StreamID, StreamResult> receivedStreams;
+        boost::unordered_map<StreamID, std::string> receivedStreamData;
+    };
+}
+
+SCENARIO("Data streams are sent and received over a data connection", "[DataConnectionsHandler][Handlers][NetworkManagement]")
+{
+    GIVEN("a pair of data connections handlers with an encrypted connection")
+    {
+        HandlerPair handlers(true, 64);
+        REQUIRE(handlers.connectionsEstablished == 2);
+        
+        WHEN("a stream made up of several chunks is sent")
+        {
+            std::string streamData = handlers.createData(64 * 10 + 17);
+            REQUIRE(handlers.receiveStream(1));
+            REQUIRE(handlers.sendStream(streamData, 1));
+            handlers.waitUntil([&](){ return handlers.sentStreams.count(1) > 0 && handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("its chunks are received in order and both ends complete it")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedStreamData[1] == streamData);
+                CHECK(handlers.sentStreams[1].successful);
+                CHECK(handlers.sentStreams[1].transferredBytes == streamData.size());
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].transferredBytes == streamData.size());
+            }
+        }
+        
+        WHEN("an empty stream is sent")
+        {
+            REQUIRE(handlers.receiveStream(1));
+            REQUIRE(handlers.sendStream("", 1));
+            handlers.waitUntil([&](){ return handlers.sentStreams.count(1) > 0 && handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("its authenticated empty chunk completes it on both ends")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK(handlers.sentStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].transferredBytes == 0);
+            }
+        }
+        
+        WHEN("two streams are sent at the same time")
+        {
+            std::string firstStreamData = handlers.createData(64 * 8);
+            std::string secondStreamData = handlers.createData(64 * 3 + 1);
+            REQUIRE(handlers.receiveStream(1));
+            REQUIRE(handlers.receiveStream(2));
+            REQUIRE(handlers.sendStream(firstStreamData, 1));
+            REQUIRE(handlers.sendStream(secondStreamData, 2));
+            handlers.waitUntil([&](){ return handlers.receivedStreams.size() == 2 && handlers.sentStreams.size() == 2; });
+            
+            THEN("the chunks of each stream are delivered to its own sink, in order")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedStreamData[1] == firstStreamData);
+                CHECK(handlers.receivedStreamData[2] == secondStreamData);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[2].successful);
+                CHECK(handlers.sentStreams[1].successful);
+                CHECK(handlers.sentStreams[2].successful);
+            }
+        }
+        
+        WHEN("regular data is sent while a stream is expected and being sent")
+        {
+            std::string streamData = handlers.createData(64 * 6);
+            REQUIRE(handlers.receiveStream(1));
+            CHECK(handlers.sender->sendData(handlers.receiverDevice->getDeviceID(), HandlerPair::SENDER_CONNECTION_ID, "data_1"));
+            REQUIRE(handlers.sendStream(streamData, 1));
+            CHECK(handlers.sender->sendData(handlers.receiverDevice->getDeviceID(), HandlerPair::SENDER_CONNECTION_ID, "data_2"));
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0 && handlers.receivedData.size() == 2; });
+            
+            THEN("the data is delivered as regular data and the stream is not affected")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedData == std::vector<PlaintextData>{"data_1", "data_2"});
+                CHECK(handlers.receivedStreamData[1] == streamData);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.remote->isActive());
+            }
+        }
+    }
+    
+    GIVEN("a pair of data connections handlers with an unencrypted connection")
+    {
+        HandlerPair handlers(false, 64);
+        REQUIRE(handlers.connectionsEstablished == 2);
+        
+        WHEN("a stream and regular data are sent")
+        {
+            std::string streamData = handlers.createData(64 * 5 + 3);
+            REQUIRE(handlers.receiveStream(1));
+            REQUIRE(handlers.sendStream(streamData, 1));
+            CHECK(handlers.sender->sendData(handlers.receiverDevice->getDeviceID(), HandlerPair::SENDER_CONNECTION_ID, "data_1"));
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0 && handlers.receivedData.size() == 1; });
+            
+            THEN("both are received")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedData == std::vector<PlaintextData>{"data_1"});
+                CHECK(handlers.receivedStreamData[1] == streamData);
+                CHECK(handlers.receivedStreams[1].successful);
+            }
+        }
+    }
+}
+
+SCENARIO("Data received over a data connection is processed by the pipeline workers", "[DataConnectionsHandler][Handlers][NetworkManagement]")
+{
+    GIVEN("a pair of data connections handlers with pipeline workers and a single incoming task per connection")
+    {
+        HandlerPair handlers(true, 64, 2);
+        REQUIRE(handlers.connectionsEstablished == 2);
+        REQUIRE(handlers.receiver->getDataPipeline());
+        
+        WHEN("more data is sent than the connection's lane can hold")
+        {
+            std::vector<PlaintextData> sentData;
+            for(unsigned int i = 0; i < 10; i++)
+            {
+                sentData.push_back("data_" + Convert::toString(i));
+                CHECK(handlers.sender->sendData(handlers.receiverDevice->getDeviceID(), HandlerPair::SENDER_CONNECTION_ID, sentData.back()));
+            }
+            
+            handlers.waitUntil([&](){ return handlers.receivedData.size() == sentData.size(); });
+            
+            THEN("all of it is received in order and reading is no longer paused")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedData == sentData);
+                CHECK_FALSE(handlers.remote->isReadingPaused());
+                CHECK(handlers.receiver->getDataPipeline()->getQueuedIncomingTasksCount() == 0);
+                CHECK(handlers.receiver->getDataPipeline()->getFailedTasksCount() == 0);
+            }
+        }
+        
+        WHEN("a stream is sent")
+        {
+            std::string streamData = handlers.createData(64 * 5 + 3);
+            REQUIRE(handlers.receiveStream(1));
+            REQUIRE(handlers.sendStream(streamData, 1));
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0 && handlers.sentStreams.count(1) > 0; });
+            
+            THEN("it is received")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedStreamData[1] == streamData);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.sentStreams[1].successful);
+            }
+        }
+    }
+}
+
+SCENARIO("Data stream windows are granted by the receiver", "[DataConnectionsHandler][Handlers][NetworkManagement]")
+{
+    GIVEN("a pair of data connections handlers with an encrypted connection")
+    {
+        HandlerPair handlers(true, 64);
+        REQUIRE(handlers.connectionsEstablished == 2);
+        
+        WHEN("a stream is sent before the receiver expects it")
+        {
+            std::string streamData = handlers.createData(64 * 10 + 3);
+            REQUIRE(handlers.sendStream(streamData, 1));
+            waitFor(0.3);
+            
+            bool sentEarly;
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                sentEarly = (handlers.sentStreams.count(1) > 0);
+            }
+            
+            REQUIRE(handlers.receiveStream(1));
+            handlers.waitUntil([&](){ return handlers.sentStreams.count(1) > 0 && handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("no chunks are sent until the receiver grants the stream's window")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK_FALSE(sentEarly);
+                CHECK(handlers.sentStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreamData[1] == streamData);
+            }
+        }
+        
+        WHEN("window updates without authentication data are received for a stream")
+        {
+            std::string streamData = handlers.createData(64 * 10 + 3);
+            REQUIRE(handlers.sendStream(streamData, 1));
+            
+            ByteData forgedGrant, forgedRejection;
+            forgedGrant.push_back(static_cast<char>(DataFrameType::STREAM_WINDOW_UPDATE));
+            StreamWindowUpdate{1, 4, StreamWindowUpdate::FLAG_INITIAL}.toNetworkBytes(forgedGrant);
+            forgedRejection.push_back(static_cast<char>(DataFrameType::STREAM_WINDOW_UPDATE));
+            StreamWindowUpdate{1, 0, StreamWindowUpdate::FLAG_REJECTED}.toNetworkBytes(forgedRejection);
+            handlers.remote->sendData(forgedGrant);
+            handlers.remote->sendData(forgedRejection);
+            waitFor(0.3);
+            
+            bool sentEarly;
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                sentEarly = (handlers.sentStreams.count(1) > 0);
+            }
+            
+            REQUIRE(handlers.receiveStream(1));
+            handlers.waitUntil([&](){ return handlers.sentStreams.count(1) > 0 && handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("they are not applied and the stream is sent once the receiver grants its window")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK_FALSE(sentEarly);
+                CHECK(handlers.sentStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreamData[1] == streamData);
+            }
+        }
+        
+        WHEN("the receiver cannot write the stream's data")
+        {
+            REQUIRE(handlers.receiver->receiveStream(handlers.senderDevice->getDeviceID(), HandlerPair::RECEIVER_CONNECTION_ID,
+                    [](const Byte *, std::streamsize) -> std::streamsize { return -1; },
+                    1024 * 1024,
+                    [&handlers](bool successful, DataSize transferredBytes)
+                    {
+                        boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                        handlers.receivedStreams[1] = StreamResult{successful, transferredBytes};
+                    },
+                    1));
+            
+            REQUIRE(handlers.sendStream(handlers.createData(64 * 20), 1));
+            handlers.waitUntil([&](){ return handlers.sentStreams.count(1) > 0 && handlers.receivedStreams.count(1) > 0; });
+            CHECK(handlers.sender->sendData(handlers.receiverDevice->getDeviceID(), HandlerPair::SENDER_CONNECTION_ID, "data_1"));
+            handlers.waitUntil([&](){ return handlers.receivedData.size() == 1; });
+            
+            THEN("the stream is rejected and fails on both ends, without affecting the connection")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.sentStreams.count(1) > 0);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK_FALSE(handlers.sentStreams[1].successful);
+                CHECK_FALSE(handlers.receivedStreams[1].successful);
+                CHECK(handlers.sentStreams[1].transferredBytes < (64 * 20));
+                CHECK(handlers.receivedData == std::vector<PlaintextData>{"data_1"});
+                CHECK(handlers.remote->isActive());
+            }
+        }
+    }
+}
+
+SCENARIO("Invalid data stream chunks fail the stream", "[DataConnectionsHandler][Handlers][NetworkManagement]")
+{
+    GIVEN("a pair of data connections handlers with an encrypted connection and an expected stream")
+    {
+        HandlerPair handlers(true, 64);
+        REQUIRE(handlers.connectionsEstablished == 2);
+        REQUIRE(handlers.receiveStream(1));
+        
+        WHEN("the chunks of the stream are received out of order")
+        {
+            handlers.sendRawChunk(StreamChunkHeader{1, 1, 0}, "chunk_1");
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("the stream fails without writing any data")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK_FALSE(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].transferredBytes == 0);
+                CHECK(handlers.receivedStreamData[1].empty());
+            }
+            
+            AND_THEN("the connection is not affected")
+            {
+                CHECK(handlers.sender->sendData(handlers.receiverDevice->getDeviceID(), HandlerPair::SENDER_CONNECTION_ID, "data_1"));
+                handlers.waitUntil([&](){ return handlers.receivedData.size() == 1; });
+                
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.receivedData == std::vector<PlaintextData>{"data_1"});
+                CHECK(handlers.remote->isActive());
+            }
+        }
+        
+        WHEN("a chunk of the stream was tampered with")
+        {
+            handlers.sendRawChunk(StreamChunkHeader{1, 0, 0}, "chunk_0");
+            handlers.sendRawChunk(StreamChunkHeader{1, 1, StreamChunkHeader::FLAG_LAST_CHUNK}, "chunk_1", true);
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("the stream fails and the tampered data is not written")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK_FALSE(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].transferredBytes == 7);
+                CHECK(handlers.receivedStreamData[1] == "chunk_0");
+            }
+            
+            AND_THEN("a new stream with the same ID can be received on the connection")
+            {
+                std::string streamData = handlers.createData(64 * 5 + 3);
+                {
+                    boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                    handlers.receivedStreams.clear();
+                    handlers.receivedStreamData.clear();
+                }
+                
+                REQUIRE(handlers.receiveStream(1));
+                REQUIRE(handlers.sendStream(streamData, 1));
+                handlers.waitUntil([&](){ return handlers.sentStreams.count(1) > 0 && handlers.receivedStreams.count(1) > 0; });
+                
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                CHECK(handlers.sentStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreamData[1] == streamData);
+            }
+        }
+        
+        WHEN("the last chunk of the stream is received without authentication data")
+        {
+            handlers.sendRawChunk(StreamChunkHeader{1, 0, 0}, "chunk_0");
+            handlers.sendUnauthenticatedChunk(StreamChunkHeader{1, 1, StreamChunkHeader::FLAG_LAST_CHUNK});
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("the stream fails instead of being completed")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK_FALSE(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].transferredBytes == 7);
+                CHECK(handlers.remote->isActive());
+            }
+        }
+        
+        WHEN("a chunk is received for a stream that is not expected")
+        {
+            handlers.sendRawChunk(StreamChunkHeader{7, 0, StreamChunkHeader::FLAG_LAST_CHUNK}, "chunk_7");
+            handlers.sendRawChunk(StreamChunkHeader{1, 0, StreamChunkHeader::FLAG_LAST_CHUNK}, "chunk_0");
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("the chunk is discarded and the expected stream is received")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreamData[1] == "chunk_0");
+                CHECK(handlers.receivedStreams.count(7) == 0);
+                CHECK(handlers.remote->isActive());
+            }
+        }
+        
+        WHEN("the connection is closed before the last chunk of the stream is received")
+        {
+            handlers.sendRawChunk(StreamChunkHeader{1, 0, 0}, "chunk_0");
+            handlers.waitUntil([&](){ return handlers.receivedStreamData[1].size() == 7; });
+            handlers.local->disconnect();
+            handlers.waitUntil([&](){ return handlers.receivedStreams.count(1) > 0; });
+            
+            THEN("the truncated stream fails")
+            {
+                boost::lock_guard<boost::mutex> eventsLock(handlers.eventsMutex);
+                REQUIRE(handlers.receivedStreams.count(1) > 0);
+                CHECK_FALSE(handlers.receivedStreams[1].successful);
+                CHECK(handlers.receivedStreams[1].transferredBytes == 7);
+                CHECK(handlers.receivedStreamData[1] == "chunk_0");
+            }
+        }
+    }
+}
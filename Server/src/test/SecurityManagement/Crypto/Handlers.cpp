@@ -80,6 +80,36 @@ SCENARIO("Crypto handlers can encrypt and decrypt data",
                 CHECK(decryptedData == randomData);
             }
         }
+        
+        AND_THEN("it can authenticate associated data along with the messages")
+        {
+            std::string encryptedData, decryptedData, tamperedData;
+            std::string randomData = SecurityManagement_Crypto::PasswordGenerator::getRandomASCIIPassword(100);
+            std::string associatedData = "chunk #1";
+            
+            testEncryptor.encryptData(randomData, associatedData, encryptedData);
+            CHECK_FALSE(encryptedData.empty());
+            
+            CHECK_THROWS(testDecryptor.decryptData(encryptedData, "chunk #2", tamperedData));
+            CHECK(tamperedData.empty());
+            
+            testDecryptor.decryptData(encryptedData, associatedData, decryptedData);
+            CHECK(decryptedData == randomData);
+        }
+        
+        AND_THEN("it can authenticate associated data without a message")
+        {
+            std::string encryptedData, decryptedData = "unchanged", tamperedData;
+            std::string associatedData = "abort #1";
+            
+            testEncryptor.encryptData("", associatedData, encryptedData);
+            CHECK_FALSE(encryptedData.empty());
+            
+            CHECK_THROWS(testDecryptor.decryptData(encryptedData, "abort #2", tamperedData));
+            
+            testDecryptor.decryptData(encryptedData, associatedData, decryptedData);
+            CHECK(decryptedData.empty());
+        }
     }
     
     GIVEN("An AsymmetricCryptoHandler and crypto data generated for it")
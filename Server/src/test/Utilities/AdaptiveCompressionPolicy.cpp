@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/Utilities/Compression/AdaptiveCompressionPolicy.h"
+
+using Utilities::Compression::AdaptiveCompressionPolicy;
+
+SCENARIO("Adaptive compression policies skip payloads that are not expected to compress", "[AdaptiveCompressionPolicy][Compression][Utilities]")
+{
+    GIVEN("an AdaptiveCompressionPolicy with default settings")
+    {
+        AdaptiveCompressionPolicy testPolicy(0, 0);
+        AdaptiveCompressionPolicy::History testHistory;
+        const std::size_t defaultSampleSize = AdaptiveCompressionPolicy::DEFAULT_SAMPLE_SIZE;
+        const double defaultMaxRatio = AdaptiveCompressionPolicy::DEFAULT_MAX_RATIO;
+
+        CHECK(testPolicy.getSampleSize() == defaultSampleSize);
+        CHECK(testPolicy.getMaxRatio() == defaultMaxRatio);
+
+        ByteData repetitiveData;
+        for(unsigned int i = 0; i < 500; i++)
+            repetitiveData += "test data ";
+
+        ByteData randomData;
+        unsigned int seed = 12345;
+        for(unsigned int i = 0; i < 8192; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            randomData.push_back(static_cast<char>((seed >> 16) & 0xFF));
+        }
+
+        THEN("the estimated ratios reflect the data's entropy")
+        {
+            CHECK(AdaptiveCompressionPolicy::estimateRatio(ByteData(), 100) == 0.0);
+            CHECK(AdaptiveCompressionPolicy::estimateRatio(ByteData(1000, 'a'), 1000) == 0.0);
+            CHECK(AdaptiveCompressionPolicy::estimateRatio(repetitiveData, repetitiveData.size()) < 0.5);
+            CHECK(AdaptiveCompressionPolicy::estimateRatio(randomData, randomData.size()) > 0.95);
+            CHECK(AdaptiveCompressionPolicy::estimateRatio(randomData, randomData.size()) <= 1.0);
+        }
+
+        WHEN("small and compressible payloads are checked")
+        {
+            bool smallPayloadAccepted = testPolicy.shouldCompress(ByteData(10, 'a'), testHistory);
+            bool repetitivePayloadAccepted = testPolicy.shouldCompress(repetitiveData, testHistory);
+
+            THEN("only the large payload is compressed and the history is not affected")
+            {
+                CHECK_FALSE(smallPayloadAccepted);
+                CHECK(repetitivePayloadAccepted);
+                CHECK(testHistory.averageRatio == 0.0);
+            }
+        }
+
+        WHEN("high-entropy payloads are checked")
+        {
+            bool randomPayloadAccepted = testPolicy.shouldCompress(randomData, testHistory);
+
+            THEN("they are skipped and the estimate is recorded")
+            {
+                CHECK_FALSE(randomPayloadAccepted);
+                CHECK(testHistory.averageRatio > defaultMaxRatio);
+            }
+        }
+
+        WHEN("the history advises against compression")
+        {
+            testPolicy.recordResult(testHistory, 1000, 1010);
+            CHECK(testHistory.averageRatio > 1.0);
+
+            unsigned int acceptedBeforeProbe = 0;
+            for(unsigned int i = 1; i < AdaptiveCompressionPolicy::PROBE_INTERVAL; i++)
+            {
+                if(testPolicy.shouldCompress(repetitiveData, testHistory))
+                    ++acceptedBeforeProbe;
+            }
+
+            bool probeAccepted = testPolicy.shouldCompress(repetitiveData, testHistory);
+
+            THEN("payloads are skipped until the next probe, which samples the data again")
+            {
+                CHECK(acceptedBeforeProbe == 0);
+                CHECK(probeAccepted);
+                CHECK(testHistory.payloadsSinceProbe == 0);
+            }
+
+            AND_WHEN("better results are recorded")
+            {
+                for(unsigned int i = 0; i < 10; i++)
+                    testPolicy.recordResult(testHistory, 1000, 100);
+
+                THEN("payloads are compressed again")
+                {
+                    CHECK(testHistory.averageRatio < defaultMaxRatio);
+                    CHECK(testPolicy.shouldCompress(repetitiveData, testHistory));
+                }
+            }
+        }
+    }
+
+    GIVEN("invalid policy parameters")
+    {
+        THEN("AdaptiveCompressionPolicies cannot be created")
+        {
+            CHECK_THROWS_AS(AdaptiveCompressionPolicy(0, -0.5), std::invalid_argument);
+        }
+    }
+}
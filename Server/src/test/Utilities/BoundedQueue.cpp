@@ -0,0 +1,139 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/Utilities/BoundedQueue.h"
+#include "../../main/Utilities/ObjectPool.h"
+#include <atomic>
+#include <vector>
+
+SCENARIO("Bounded queues store values in FIFO order up to their capacity", "[BoundedQueue][Utilities]")
+{
+    GIVEN("a new BoundedQueue")
+    {
+        Utilities::BoundedQueue<unsigned int> testQueue(5);
+
+        CHECK(testQueue.getCapacity() == 8);
+        CHECK(testQueue.isEmpty());
+
+        WHEN("it is filled up")
+        {
+            for(unsigned int i = 0; i < testQueue.getCapacity(); i++)
+                CHECK(testQueue.tryPush(i));
+
+            THEN("no more values can be added")
+            {
+                CHECK(testQueue.getSize() == 8);
+                CHECK_FALSE(testQueue.tryPush(100));
+            }
+
+            AND_THEN("the values are retrieved in the order they were added")
+            {
+                unsigned int value = 0;
+                for(unsigned int i = 0; i < testQueue.getCapacity(); i++)
+                {
+                    CHECK(testQueue.tryPop(value));
+                    CHECK(value == i);
+                }
+
+                CHECK_FALSE(testQueue.tryPop(value));
+                CHECK(testQueue.isEmpty());
+            }
+        }
+    }
+
+    GIVEN("a BoundedQueue shared by multiple producers and a single consumer")
+    {
+        const unsigned int producersNumber = 4;
+        const unsigned int valuesPerProducer = 25000;
+        Utilities::BoundedQueue<unsigned int> testQueue(64);
+        std::vector<unsigned int> receivedValues(producersNumber * valuesPerProducer, 0);
+
+        WHEN("all producers add their values concurrently")
+        {
+            boost::thread_group producers;
+            for(unsigned int p = 0; p < producersNumber; p++)
+            {
+                producers.create_thread([&testQueue, p, valuesPerProducer]()
+                {
+                    for(unsigned int i = 0; i < valuesPerProducer; i++)
+                    {
+                        while(!testQueue.tryPush(p * valuesPerProducer + i))
+                            boost::this_thread::yield();
+                    }
+                });
+            }
+
+            unsigned int totalReceived = 0;
+            unsigned int value = 0;
+            while(totalReceived < producersNumber * valuesPerProducer)
+            {
+                if(testQueue.tryPop(value))
+                {
+                    receivedValues[value]++;
+                    totalReceived++;
+                }
+                else
+                    boost::this_thread::yield();
+            }
+
+            producers.join_all();
+
+            THEN("the consumer receives every value exactly once")
+            {
+                CHECK(std::count(receivedValues.begin(), receivedValues.end(), 1) == (long)(producersNumber * valuesPerProducer));
+                CHECK(testQueue.isEmpty());
+            }
+        }
+    }
+}
+
+SCENARIO("Object pools reuse released objects", "[ObjectPool][Utilities]")
+{
+    GIVEN("a new ObjectPool")
+    {
+        Utilities::ObjectPool<std::vector<int>> testPool(2);
+
+        CHECK(testPool.getFreeObjectsCount() == 0);
+        CHECK(testPool.getTotalAllocations() == 0);
+
+        WHEN("objects are acquired and released")
+        {
+            std::vector<int> * objectA = testPool.acquire();
+            std::vector<int> * objectB = testPool.acquire();
+            std::vector<int> * objectC = testPool.acquire();
+
+            CHECK(testPool.getTotalAllocations() == 3);
+
+            testPool.release(objectA);
+            testPool.release(objectB);
+            testPool.release(objectC); //pool is full; object is deleted
+
+            THEN("up to the maximum number of free objects are kept and reused")
+            {
+                CHECK(testPool.getFreeObjectsCount() == 2);
+
+                std::vector<int> * objectD = testPool.acquire();
+                CHECK((objectD == objectA || objectD == objectB));
+                CHECK(testPool.getTotalAllocations() == 3);
+                CHECK(testPool.getFreeObjectsCount() == 1);
+
+                testPool.release(objectD);
+            }
+        }
+    }
+}
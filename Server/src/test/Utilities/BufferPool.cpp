@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2015 https://github.com/sndnv
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../BasicSpec.h"
+#include "../../main/Utilities/BufferPool.h"
+#include <cstring>
+
+SCENARIO("Buffer pools reuse buffers from the smallest matching size class", "[BufferPool][Utilities]")
+{
+    GIVEN("a new BufferPool")
+    {
+        Utilities::BufferPoolPtr testPool = Utilities::BufferPool::create(3000, 4);
+
+        CHECK(testPool->getSizeClassesCount() == 4);
+        CHECK(testPool->getMaximumBufferSize() == 3000);
+        CHECK(testPool->getFreeBuffersCount() == 0);
+        CHECK_THROWS_AS(Utilities::BufferPool::create(0, 4), std::invalid_argument);
+
+        WHEN("buffers are acquired and released")
+        {
+            Utilities::PooledBufferPtr smallBuffer = testPool->acquire(10);
+            Utilities::PooledBufferPtr mediumBuffer = testPool->acquire(1500);
+            Utilities::PooledBufferPtr largeBuffer = testPool->acquire(2500);
+            Utilities::PooledBufferPtr unpooledBuffer = testPool->acquire(5000);
+
+            THEN("each buffer is taken from the smallest class that can hold the requested size")
+            {
+                CHECK(smallBuffer->capacity() == 512);
+                CHECK(mediumBuffer->capacity() == 2048);
+                CHECK(largeBuffer->capacity() == 3000);
+                CHECK(unpooledBuffer->capacity() == 5000);
+                CHECK(testPool->getTotalAllocations() == 4);
+            }
+
+            AND_THEN("released buffers are reused, except for the unpooled ones")
+            {
+                Byte * smallBufferData = smallBuffer->data();
+                smallBuffer.reset();
+                mediumBuffer.reset();
+                largeBuffer.reset();
+                unpooledBuffer.reset();
+
+                CHECK(testPool->getFreeBuffersCount() == 3);
+
+                Utilities::PooledBufferPtr reusedBuffer = testPool->acquire(100);
+                CHECK(reusedBuffer->data() == smallBufferData);
+                CHECK(testPool->getFreeBuffersCount() == 2);
+                CHECK(testPool->getTotalAllocations() == 4);
+            }
+        }
+
+        WHEN("views of a buffer are created")
+        {
+            Utilities::PooledBufferPtr buffer = testPool->acquire(5);
+            std::memcpy(buffer->data(), "12345", 5);
+
+            Utilities::BufferView firstView(buffer, 5);
+            Utilities::BufferView secondView = firstView;
+            buffer.reset();
+
+            THEN("they share the data and keep the buffer out of the pool until they are destroyed")
+            {
+                CHECK(firstView.data() == secondView.data());
+                CHECK(firstView.toByteData() == "12345");
+                CHECK(testPool->getFreeBuffersCount() == 0);
+
+                ByteData target = "0";
+                secondView.appendTo(target);
+                CHECK(target == "012345");
+
+                firstView = Utilities::BufferView();
+                CHECK(firstView.empty());
+                CHECK(firstView.toByteData().empty());
+                CHECK(testPool->getFreeBuffersCount() == 0);
+
+                secondView = Utilities::BufferView();
+                CHECK(testPool->getFreeBuffersCount() == 1);
+            }
+
+            AND_THEN("views larger than the buffer cannot be created")
+            {
+                CHECK_THROWS_AS(Utilities::BufferView(testPool->acquire(5), 1000), std::invalid_argument);
+            }
+        }
+
+        WHEN("the pool is dropped while buffers are still in use")
+        {
+            Utilities::PooledBufferPtr buffer = testPool->acquire(5);
+            testPool.reset();
+
+            THEN("the buffers remain usable and are freed with the pool, when released")
+            {
+                CHECK(buffer->capacity() == 512);
+                buffer.reset();
+            }
+        }
+    }
+}